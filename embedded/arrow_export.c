@@ -0,0 +1,325 @@
+/*
+ * arrow_export.c - Arrow C Data Interface Export Implementation
+ *
+ * An export fills the schema/array trees held in arrow_batch_t and points
+ * each column's data buffer at the caller's memory. Nothing is allocated
+ * and no row is copied; cost is per column, not per row.
+ *
+ * Reference: id-Software/DOOM linuxdoom-1.10/w_wad.c (W_CacheLumpNum,
+ *            lumpinfo_t directory)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "arrow_export.h"
+#include <string.h>
+
+/* Describes the packed buffers for consumers that view them with a dtype */
+#define POSE_LAYOUT   "rotation i32[9] row-major, translation i32[3] ENU m, " \
+                      "timestamp u32, mmsi u32; packed little-endian"
+#define DLT_LAYOUT    "dataset char[32], mmsi u32, cell_id u16, pad u16, " \
+                      "lambda_optimal i32, return_error i32, trajectory_hash u8[32], " \
+                      "timestamp u32, signature u8[64]; little-endian"
+
+/* ========================================================================
+ * RELEASE CALLBACKS
+ * ======================================================================== */
+
+/* Children live in arrow_batch_t: releasing one only marks it released */
+static void release_child_schema(struct ArrowSchema* s) {
+    for (int64_t i = 0; i < s->n_children; i++) {
+        if (s->children[i]->release) s->children[i]->release(s->children[i]);
+    }
+    s->release = NULL;
+}
+
+static void release_child_array(struct ArrowArray* a) {
+    for (int64_t i = 0; i < a->n_children; i++) {
+        if (a->children[i]->release) a->children[i]->release(a->children[i]);
+    }
+    a->release = NULL;
+}
+
+static void release_root_schema(struct ArrowSchema* s) {
+    arrow_batch_t* b = (arrow_batch_t*)s->private_data;
+    release_child_schema(s);
+    b->schema_live = 0;
+}
+
+static void release_root_array(struct ArrowArray* a) {
+    arrow_batch_t* b = (arrow_batch_t*)a->private_data;
+    release_child_array(a);
+    b->array_live = 0;
+}
+
+/* ========================================================================
+ * BATCH BUILDING
+ * ======================================================================== */
+
+static void batch_begin(arrow_batch_t* b, int64_t length) {
+    int32_t zero = 0;
+    b->n_columns = 0;
+    b->length = length;
+    memcpy(b->metadata, &zero, sizeof(zero));   /* Pair count, patched per add */
+    b->metadata_len = sizeof(int32_t);
+    b->metadata_ok = 1;
+}
+
+/**
+ * Append one key/value pair to the schema metadata (Arrow encoding:
+ * int32 pair count, then int32 length + bytes for each key and value).
+ */
+static void metadata_add(arrow_batch_t* b, const char* key, const char* value) {
+    int32_t klen = (int32_t)strlen(key), vlen = (int32_t)strlen(value), pairs;
+    size_t need = 2 * sizeof(int32_t) + (size_t)klen + (size_t)vlen;
+    if (b->metadata_len + need > sizeof(b->metadata)) {
+        b->metadata_ok = 0;
+        return;
+    }
+    char* p = b->metadata + b->metadata_len;
+    memcpy(p, &klen, sizeof(klen));
+    memcpy(p + sizeof(klen), key, (size_t)klen);
+    p += sizeof(klen) + (size_t)klen;
+    memcpy(p, &vlen, sizeof(vlen));
+    memcpy(p + sizeof(vlen), value, (size_t)vlen);
+    b->metadata_len = (uint16_t)(b->metadata_len + need);
+    memcpy(&pairs, b->metadata, sizeof(pairs));
+    pairs++;
+    memcpy(b->metadata, &pairs, sizeof(pairs));
+}
+
+/* Decimal digits of v into p (no terminator); returns the end */
+static char* put_decimal(char* p, uint32_t v, int min_digits) {
+    char digits[10];
+    int n = 0;
+    do {
+        digits[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v || n < min_digits);
+    while (n) *p++ = digits[--n];
+    return p;
+}
+
+static void metadata_add_u32(arrow_batch_t* b, const char* key, uint32_t v) {
+    char text[12];
+    *put_decimal(text, v, 1) = '\0';
+    metadata_add(b, key, text);
+}
+
+/* Degrees with 6 decimals, integer-only (no FPU / float printf needed) */
+static void metadata_add_deg(arrow_batch_t* b, const char* key, fixed_t v) {
+    char text[24], *p = text;
+    uint32_t mag = v < 0 ? (uint32_t)0 - (uint32_t)v : (uint32_t)v;
+    uint32_t whole = mag >> FRACBITS;
+    uint32_t micro = (uint32_t)(((uint64_t)(mag & (FRACUNIT - 1)) * 1000000u + FRACUNIT / 2) >> FRACBITS);
+    if (micro >= 1000000u) {
+        whole++;
+        micro -= 1000000u;
+    }
+    if (v < 0) *p++ = '-';
+    p = put_decimal(p, whole, 1);
+    *p++ = '.';
+    *put_decimal(p, micro, 6) = '\0';
+    metadata_add(b, key, text);
+}
+
+/**
+ * Add one column. Fixed-size-list columns (item_format != NULL) get an
+ * item child of length rows × list_size over item_data; others point
+ * their data buffer at data.
+ */
+static void add_column(arrow_batch_t* b, const char* name, const char* format,
+                       const void* data, const char* item_format, const void* item_data,
+                       int list_size) {
+    int i = b->n_columns++;
+    struct ArrowSchema* s = &b->col_schema[i];
+    struct ArrowArray* a = &b->col_array[i];
+    bool list = item_format != NULL;
+
+    memset(s, 0, sizeof(*s));
+    s->format = format;
+    s->name = name;
+    s->n_children = list ? 1 : 0;
+    s->children = list ? &b->item_schema_ptr[i] : NULL;
+    s->release = release_child_schema;
+    s->private_data = b;
+
+    memset(a, 0, sizeof(*a));
+    a->length = b->length;
+    a->n_buffers = list ? 1 : 2;                /* Fixed-size list: validity only */
+    a->n_children = s->n_children;
+    a->buffers = b->col_buffers[i];
+    a->children = list ? &b->item_array_ptr[i] : NULL;
+    a->release = release_child_array;
+    a->private_data = b;
+    b->col_buffers[i][0] = NULL;                /* No nulls */
+    b->col_buffers[i][1] = data;
+
+    if (!list) return;
+    struct ArrowSchema* is = &b->item_schema[i];
+    struct ArrowArray* ia = &b->item_array[i];
+    memset(is, 0, sizeof(*is));
+    is->format = item_format;
+    is->name = "item";
+    is->release = release_child_schema;
+    is->private_data = b;
+    memset(ia, 0, sizeof(*ia));
+    ia->length = b->length * list_size;
+    ia->n_buffers = 2;
+    ia->buffers = b->item_buffers[i];
+    ia->release = release_child_array;
+    ia->private_data = b;
+    b->item_buffers[i][0] = NULL;
+    b->item_buffers[i][1] = item_data;
+}
+
+/* Hand out the root struct<...> schema and array */
+static void batch_finish(arrow_batch_t* b, struct ArrowSchema* schema, struct ArrowArray* array) {
+    memset(schema, 0, sizeof(*schema));
+    schema->format = "+s";
+    schema->name = "";
+    schema->metadata = b->metadata_ok ? b->metadata : NULL;
+    schema->n_children = b->n_columns;
+    schema->children = b->col_schema_ptr;
+    schema->release = release_root_schema;
+    schema->private_data = b;
+
+    memset(array, 0, sizeof(*array));
+    array->length = b->length;
+    array->n_buffers = 1;
+    array->n_children = b->n_columns;
+    array->buffers = b->root_buffers;
+    array->children = b->col_array_ptr;
+    array->release = release_root_array;
+    array->private_data = b;
+
+    b->schema_live = 1;
+    b->array_live = 1;
+}
+
+static void add_cell_metadata(arrow_batch_t* b, const t_bsp_t* bsp, const t_bsp_cell_t* cell) {
+    fixed_t lat_min, lat_max, lon_min, lon_max;
+    t_bsp_get_cell_bounds(bsp, cell->cell_id, &lat_min, &lat_max, &lon_min, &lon_max);
+    metadata_add_u32(b, "cell_id", cell->cell_id);
+    metadata_add_u32(b, "grid_epoch", cell->grid_epoch);
+    metadata_add_deg(b, "lat_min", lat_min);
+    metadata_add_deg(b, "lat_max", lat_max);
+    metadata_add_deg(b, "lon_min", lon_min);
+    metadata_add_deg(b, "lon_max", lon_max);
+}
+
+/* ========================================================================
+ * PUBLIC API
+ * ======================================================================== */
+
+void arrow_batch_init(arrow_batch_t* b) {
+    memset(b, 0, sizeof(*b));
+    for (int i = 0; i < ARROW_EXPORT_MAX_COLUMNS; i++) {
+        b->col_schema_ptr[i] = &b->col_schema[i];
+        b->item_schema_ptr[i] = &b->item_schema[i];
+        b->col_array_ptr[i] = &b->col_array[i];
+        b->item_array_ptr[i] = &b->item_array[i];
+    }
+}
+
+int arrow_export_cell(arrow_batch_t* b, t_bsp_t* bsp, uint16_t cell_id,
+                      struct ArrowSchema* schema, struct ArrowArray* array) {
+    if (arrow_batch_busy(b)) return ARROW_EXPORT_ERR_BUSY;
+    t_bsp_cell_t* cell = t_bsp_get_cell(bsp, cell_id);
+    if (!cell) return ARROW_EXPORT_ERR_NO_CELL;
+
+    batch_begin(b, cell->pose_count);
+    metadata_add(b, "se3.layout", POSE_LAYOUT);
+    metadata_add(b, "se3.fixed_point", "16.16");
+    add_cell_metadata(b, bsp, cell);
+    add_column(b, "pose", "w:56", t_bsp_cell_poses(bsp, cell), NULL, NULL, 0);
+    batch_finish(b, schema, array);
+    return ARROW_EXPORT_OK;
+}
+
+int arrow_cell_to_columns(t_bsp_t* bsp, uint16_t cell_id, arrow_pose_columns_t* cols) {
+    t_bsp_cell_t* cell = t_bsp_get_cell(bsp, cell_id);
+    if (!cell) return ARROW_EXPORT_ERR_NO_CELL;
+    if (cell->pose_count > cols->capacity) return ARROW_EXPORT_ERR_CAPACITY;
+
+    const se3_pose_t* poses = t_bsp_cell_poses(bsp, cell);
+    for (uint32_t i = 0; i < cell->pose_count; i++) {
+        memcpy(cols->rotation[i], poses[i].rotation, sizeof(cols->rotation[i]));
+        memcpy(cols->translation[i], poses[i].translation, sizeof(cols->translation[i]));
+        cols->timestamp[i] = poses[i].timestamp;
+        cols->mmsi[i] = poses[i].mmsi;
+    }
+    cols->count = cell->pose_count;
+    return ARROW_EXPORT_OK;
+}
+
+int arrow_export_pose_columns(arrow_batch_t* b, const arrow_pose_columns_t* cols,
+                              const t_bsp_t* bsp, uint16_t cell_id,
+                              struct ArrowSchema* schema, struct ArrowArray* array) {
+    if (arrow_batch_busy(b)) return ARROW_EXPORT_ERR_BUSY;
+
+    batch_begin(b, cols->count);
+    metadata_add(b, "se3.fixed_point", "16.16");
+    if (bsp) {
+        for (int i = 0; i < MAX_CELLS; i++) {
+            const t_bsp_cell_t* cell = &bsp->cells[i];
+            if (cell->active && cell->cell_id == cell_id) {
+                add_cell_metadata(b, bsp, cell);
+                break;
+            }
+        }
+    }
+    add_column(b, "rotation", "+w:9", NULL, "i", cols->rotation, 9);
+    add_column(b, "translation", "+w:3", NULL, "i", cols->translation, 3);
+    add_column(b, "timestamp", "I", cols->timestamp, NULL, NULL, 0);
+    add_column(b, "mmsi", "I", cols->mmsi, NULL, NULL, 0);
+    batch_finish(b, schema, array);
+    return ARROW_EXPORT_OK;
+}
+
+int arrow_export_dlt(arrow_batch_t* b, const dlt_record_t* records, uint32_t n,
+                     struct ArrowSchema* schema, struct ArrowArray* array) {
+    if (arrow_batch_busy(b)) return ARROW_EXPORT_ERR_BUSY;
+
+    batch_begin(b, n);
+    metadata_add(b, "dlt.layout", DLT_LAYOUT);
+    metadata_add(b, "se3.fixed_point", "16.16");
+    add_column(b, "record", "w:148", records, NULL, NULL, 0);
+    batch_finish(b, schema, array);
+    return ARROW_EXPORT_OK;
+}
+
+int arrow_dlt_to_columns(const dlt_record_t* records, uint32_t n, arrow_dlt_columns_t* cols) {
+    if (n > cols->capacity) return ARROW_EXPORT_ERR_CAPACITY;
+    for (uint32_t i = 0; i < n; i++) {
+        const dlt_record_t* r = &records[i];
+        memcpy(cols->dataset[i], r->dataset, sizeof(r->dataset));
+        cols->mmsi[i] = r->mmsi;
+        cols->cell_id[i] = r->cell_id;
+        cols->lambda_optimal[i] = r->lambda_optimal;
+        cols->return_error[i] = r->return_error;
+        memcpy(cols->trajectory_hash[i], r->trajectory_hash, sizeof(r->trajectory_hash));
+        cols->timestamp[i] = r->timestamp;
+        memcpy(cols->signature[i], r->signature, sizeof(r->signature));
+    }
+    cols->count = n;
+    return ARROW_EXPORT_OK;
+}
+
+int arrow_export_dlt_columns(arrow_batch_t* b, const arrow_dlt_columns_t* cols,
+                             struct ArrowSchema* schema, struct ArrowArray* array) {
+    if (arrow_batch_busy(b)) return ARROW_EXPORT_ERR_BUSY;
+
+    batch_begin(b, cols->count);
+    metadata_add(b, "se3.fixed_point", "16.16");
+    add_column(b, "dataset", "w:32", cols->dataset, NULL, NULL, 0);
+    add_column(b, "mmsi", "I", cols->mmsi, NULL, NULL, 0);
+    add_column(b, "cell_id", "S", cols->cell_id, NULL, NULL, 0);
+    add_column(b, "lambda_optimal", "i", cols->lambda_optimal, NULL, NULL, 0);
+    add_column(b, "return_error", "i", cols->return_error, NULL, NULL, 0);
+    add_column(b, "trajectory_hash", "w:32", cols->trajectory_hash, NULL, NULL, 0);
+    add_column(b, "timestamp", "I", cols->timestamp, NULL, NULL, 0);
+    add_column(b, "signature", "w:64", cols->signature, NULL, NULL, 0);
+    batch_finish(b, schema, array);
+    return ARROW_EXPORT_OK;
+}
@@ -0,0 +1,263 @@
+/*
+ * arrow_export.h - Zero-Copy Arrow Export of Sealed Cells and DLT Records
+ *
+ * Exposes pose slabs and dlt_record_t arrays as Arrow record batches via
+ * the Arrow C Data Interface (two plain C structs, no Arrow library), so
+ * pyarrow, polars, DuckDB and other consumers import them without a
+ * serialization hop. Every column's data buffer points straight at
+ * caller memory:
+ *
+ *   Packed   one fixed_size_binary column over the AoS buffer itself:
+ *            "pose" w:56 over a cell's slab, "record" w:148 over a
+ *            dlt_record_t array. No copy at all; consumers view it with a
+ *            structured dtype (numpy) or slice the binary column.
+ *   Columnar one Arrow column per field over caller-held SoA arrays
+ *            (arrow_pose_columns_t, arrow_dlt_columns_t). The SoA arrays
+ *            may be filled once with arrow_*_to_columns() (one transpose
+ *            pass) and then exported any number of times without copying.
+ *
+ * Pose fields stay 16.16 fixed point (int32); the schema metadata names
+ * the scale. Cell exports carry cell_id, grid_epoch and the cell bounds
+ * as schema metadata.
+ *
+ * Ownership: exported structs borrow the arrow_batch_t that built them
+ * and the buffers they point at. Keep both unchanged (no inserts or
+ * t_bsp_reset_cell() on an exported cell) until the consumer has called
+ * the release callbacks; arrow_batch_busy() reports whether it has.
+ *
+ * Doom Lineage:
+ *   - Doom WAD lumps (W_CacheLumpNum hands out pointers into the loaded
+ *     file, and the lump directory describes them: name, offset, size)
+ *     → Arrow buffers point into the slab, and the schema describes them
+ *
+ * Hardware Target: ESP32-S3 / host (arrow_batch_t ~3.2 KB on 64-bit hosts, no malloc)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#ifndef ARROW_EXPORT_H
+#define ARROW_EXPORT_H
+
+#include "se3_edge.h"
+#include "t_bsp.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * ARROW C DATA INTERFACE (ABI-stable, as published by Apache Arrow)
+ * ======================================================================== */
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    /* Array type description */
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    /* Release callback */
+    void (*release)(struct ArrowSchema*);
+    /* Opaque producer-specific data */
+    void* private_data;
+};
+
+struct ArrowArray {
+    /* Array data description */
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    /* Release callback */
+    void (*release)(struct ArrowArray*);
+    /* Opaque producer-specific data */
+    void* private_data;
+};
+
+#endif /* ARROW_C_DATA_INTERFACE */
+
+/* ========================================================================
+ * CONFIGURATION CONSTANTS
+ * ======================================================================== */
+
+#define ARROW_EXPORT_MAX_COLUMNS    8       /* dlt_record_t field count */
+
+#ifndef ARROW_EXPORT_METADATA_MAX
+#define ARROW_EXPORT_METADATA_MAX   512     /* Encoded schema metadata bytes */
+#endif
+
+/* Export results */
+#define ARROW_EXPORT_OK              0
+#define ARROW_EXPORT_ERR_BUSY       -1      /* Previous export not released */
+#define ARROW_EXPORT_ERR_NO_CELL    -2      /* Cell not active */
+#define ARROW_EXPORT_ERR_CAPACITY   -3      /* Rows exceed the column arrays */
+
+_Static_assert(sizeof(se3_pose_t) == 56, "pose column is fixed_size_binary(56)");
+_Static_assert(sizeof(dlt_record_t) == 148, "record column is fixed_size_binary(148)");
+
+/* ========================================================================
+ * DATA STRUCTURES
+ * ======================================================================== */
+
+/**
+ * Storage behind one exported batch: schema and array trees for up to
+ * ARROW_EXPORT_MAX_COLUMNS columns (fixed-size-list columns get one item
+ * child each), buffer tables and encoded metadata.
+ * Reused by the next export once the consumer has released both roots.
+ */
+typedef struct {
+    struct ArrowSchema col_schema[ARROW_EXPORT_MAX_COLUMNS];
+    struct ArrowSchema item_schema[ARROW_EXPORT_MAX_COLUMNS];
+    struct ArrowSchema* col_schema_ptr[ARROW_EXPORT_MAX_COLUMNS];
+    struct ArrowSchema* item_schema_ptr[ARROW_EXPORT_MAX_COLUMNS];
+    struct ArrowArray col_array[ARROW_EXPORT_MAX_COLUMNS];
+    struct ArrowArray item_array[ARROW_EXPORT_MAX_COLUMNS];
+    struct ArrowArray* col_array_ptr[ARROW_EXPORT_MAX_COLUMNS];
+    struct ArrowArray* item_array_ptr[ARROW_EXPORT_MAX_COLUMNS];
+    const void* col_buffers[ARROW_EXPORT_MAX_COLUMNS][2];   /**< validity (NULL), data */
+    const void* item_buffers[ARROW_EXPORT_MAX_COLUMNS][2];
+    const void* root_buffers[1];                            /**< Struct validity (NULL) */
+    char metadata[ARROW_EXPORT_METADATA_MAX];
+    uint16_t metadata_len;
+    uint8_t n_columns;
+    uint8_t schema_live;        /**< Exported schema not yet released */
+    uint8_t array_live;         /**< Exported array not yet released */
+    uint8_t metadata_ok;        /**< All key/value pairs fit */
+    int64_t length;             /**< Rows of the batch being built */
+} arrow_batch_t;
+
+/**
+ * Pose columns (SoA). Caller-allocated; capacity rows each.
+ */
+typedef struct {
+    fixed_t (*rotation)[9];     /**< Row-major 3×3, 16.16 */
+    fixed_t (*translation)[3];  /**< ENU meters, 16.16 */
+    uint32_t* timestamp;
+    uint32_t* mmsi;
+    uint32_t count;             /**< Rows filled */
+    uint32_t capacity;
+} arrow_pose_columns_t;
+
+/**
+ * DLT record columns (SoA). Caller-allocated; capacity rows each.
+ */
+typedef struct {
+    char (*dataset)[32];
+    uint32_t* mmsi;
+    uint16_t* cell_id;
+    fixed_t* lambda_optimal;
+    fixed_t* return_error;
+    uint8_t (*trajectory_hash)[32];
+    uint32_t* timestamp;
+    uint8_t (*signature)[64];
+    uint32_t count;             /**< Rows filled */
+    uint32_t capacity;
+} arrow_dlt_columns_t;
+
+/* ========================================================================
+ * API FUNCTIONS
+ * ======================================================================== */
+
+/**
+ * Initialize batch storage (nothing exported).
+ */
+void arrow_batch_init(arrow_batch_t* b);
+
+/**
+ * Whether the consumer still holds the last export (schema or array).
+ */
+static inline bool arrow_batch_busy(const arrow_batch_t* b) {
+    return b->schema_live || b->array_live;
+}
+
+/**
+ * Export a cell's poses, zero-copy: struct<pose: fixed_size_binary(56)>
+ * over the cell's slab, cell_id / grid_epoch / bounds in the metadata.
+ *
+ * @param b Batch storage (must not be busy)
+ * @param bsp T-BSP root
+ * @param cell_id Cell to export (typically sealed: no inserts until release)
+ * @param schema Output: schema (consumer calls schema->release)
+ * @param array Output: array (consumer calls array->release)
+ * @return ARROW_EXPORT_OK or ARROW_EXPORT_ERR_*
+ */
+int arrow_export_cell(arrow_batch_t* b, t_bsp_t* bsp, uint16_t cell_id,
+                      struct ArrowSchema* schema, struct ArrowArray* array);
+
+/**
+ * Transpose a cell's slab into pose columns (replaces their contents).
+ *
+ * @return ARROW_EXPORT_OK or ARROW_EXPORT_ERR_*
+ */
+int arrow_cell_to_columns(t_bsp_t* bsp, uint16_t cell_id, arrow_pose_columns_t* cols);
+
+/**
+ * Export pose columns, zero-copy: struct<rotation: fixed_size_list<int32>[9],
+ * translation: fixed_size_list<int32>[3], timestamp: uint32, mmsi: uint32>.
+ *
+ * @param b Batch storage (must not be busy)
+ * @param cols Filled columns (cols->count rows)
+ * @param bsp T-BSP root for cell metadata, or NULL
+ * @param cell_id Cell the rows came from (metadata only, if bsp given)
+ * @param schema Output: schema
+ * @param array Output: array
+ * @return ARROW_EXPORT_OK or ARROW_EXPORT_ERR_*
+ */
+int arrow_export_pose_columns(arrow_batch_t* b, const arrow_pose_columns_t* cols,
+                              const t_bsp_t* bsp, uint16_t cell_id,
+                              struct ArrowSchema* schema, struct ArrowArray* array);
+
+/**
+ * Export DLT records, zero-copy: struct<record: fixed_size_binary(148)>.
+ *
+ * @param b Batch storage (must not be busy)
+ * @param records Record array (n entries)
+ * @param n Record count
+ * @param schema Output: schema
+ * @param array Output: array
+ * @return ARROW_EXPORT_OK or ARROW_EXPORT_ERR_BUSY
+ */
+int arrow_export_dlt(arrow_batch_t* b, const dlt_record_t* records, uint32_t n,
+                     struct ArrowSchema* schema, struct ArrowArray* array);
+
+/**
+ * Transpose DLT records into columns (replaces their contents).
+ *
+ * @return ARROW_EXPORT_OK or ARROW_EXPORT_ERR_CAPACITY
+ */
+int arrow_dlt_to_columns(const dlt_record_t* records, uint32_t n, arrow_dlt_columns_t* cols);
+
+/**
+ * Export DLT record columns, zero-copy: one column per dlt_record_t field
+ * (dataset w:32, mmsi uint32, cell_id uint16, lambda_optimal int32,
+ * return_error int32, trajectory_hash w:32, timestamp uint32,
+ * signature w:64).
+ *
+ * @return ARROW_EXPORT_OK or ARROW_EXPORT_ERR_BUSY
+ */
+int arrow_export_dlt_columns(arrow_batch_t* b, const arrow_dlt_columns_t* cols,
+                             struct ArrowSchema* schema, struct ArrowArray* array);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARROW_EXPORT_H */
@@ -0,0 +1,175 @@
+/*
+ * cell_route.c - Cell Ownership Routing Implementation
+ *
+ * Rendezvous (highest-random-weight) assignment of Z-order ranges to edge
+ * nodes. Deterministic: every node derives the same table from the same
+ * membership, with no coordination beyond the node list itself.
+ *
+ * Reference: Thaler & Ravishankar, "Using Name-Based Mappings to Increase
+ *            Hit Rates" (HRW hashing), IEEE/ACM ToN 1998
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "cell_route.h"
+#include <string.h>
+
+/* ========================================================================
+ * INTERNAL HELPERS
+ * ======================================================================== */
+
+/**
+ * Rendezvous score of (node, range).
+ *
+ * MurmurHash3 fmix32 finalizer over the combined key: full avalanche, so
+ * node IDs that differ in one bit (MAC-derived IDs) still spread evenly.
+ */
+static inline uint32_t hrw_score(uint32_t node_id, uint32_t range) {
+    uint32_t h = node_id * 0x9E3779B1u ^ (range + 1u) * 0x85EBCA6Bu;
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+/**
+ * True if (id_a, score_a) beats (id_b, score_b). Ties go to the larger ID
+ * so the order is total and every node agrees.
+ */
+static inline bool hrw_beats(uint32_t id_a, uint32_t score_a,
+                             uint32_t id_b, uint32_t score_b) {
+    return score_a > score_b || (score_a == score_b && id_a > id_b);
+}
+
+static int find_slot(const cell_route_t* rt, uint32_t node_id) {
+    for (int s = 0; s < CELL_ROUTE_MAX_NODES; s++) {
+        if ((rt->active_mask & (1u << s)) && rt->node_id[s] == node_id) {
+            return s;
+        }
+    }
+    return -1;
+}
+
+/* ========================================================================
+ * PUBLIC API IMPLEMENTATION
+ * ======================================================================== */
+
+/**
+ * Initialize an empty routing table.
+ *
+ * Slot 0 holds CELL_ROUTE_NO_NODE and every range points at it, so
+ * lookups on an empty table return "no owner" without a branch.
+ */
+void cell_route_init(cell_route_t* rt) {
+    memset(rt, 0, sizeof(*rt));
+}
+
+/**
+ * Add a node (incremental rebalance).
+ *
+ * One score per range for the newcomer plus one for the current owner;
+ * no other node is consulted. O(CELL_ROUTE_RANGES).
+ */
+int cell_route_add_node(cell_route_t* rt, uint32_t node_id, uint8_t* moved) {
+    if (node_id == CELL_ROUTE_NO_NODE || find_slot(rt, node_id) >= 0) {
+        return -1;
+    }
+
+    int slot = -1;
+    for (int s = 0; s < CELL_ROUTE_MAX_NODES; s++) {
+        if (!(rt->active_mask & (1u << s))) {
+            slot = s;
+            break;
+        }
+    }
+    if (slot < 0) {
+        return -1;  /* Table full */
+    }
+
+    bool was_empty = (rt->active_mask == 0);
+    rt->node_id[slot] = node_id;
+    rt->active_mask |= 1u << slot;
+    rt->epoch++;
+
+    int n_moved = 0;
+    for (int r = 0; r < CELL_ROUTE_RANGES; r++) {
+        bool take = was_empty;
+        if (!take) {
+            uint32_t cur_id = rt->node_id[rt->owner[r]];
+            take = hrw_beats(node_id, hrw_score(node_id, (uint32_t)r),
+                             cur_id, hrw_score(cur_id, (uint32_t)r));
+        }
+        if (take) {
+            rt->owner[r] = (uint8_t)slot;
+            if (moved) moved[n_moved] = (uint8_t)r;
+            n_moved++;
+        }
+    }
+    return n_moved;
+}
+
+/**
+ * Remove a node.
+ *
+ * Only the leaving node's ranges are rescored (against all remaining
+ * nodes). If it was the last node, the table returns to empty.
+ */
+int cell_route_remove_node(cell_route_t* rt, uint32_t node_id, uint8_t* moved) {
+    int slot = find_slot(rt, node_id);
+    if (slot < 0) {
+        return -1;
+    }
+
+    rt->active_mask &= ~(1u << slot);
+    rt->node_id[slot] = CELL_ROUTE_NO_NODE;
+    rt->epoch++;
+
+    int n_moved = 0;
+    for (int r = 0; r < CELL_ROUTE_RANGES; r++) {
+        if (rt->owner[r] != slot) continue;
+
+        int best = slot;   /* Stays on the freed slot (NO_NODE) if table empties */
+        uint32_t best_id = 0, best_score = 0;
+        for (int s = 0; s < CELL_ROUTE_MAX_NODES; s++) {
+            if (!(rt->active_mask & (1u << s))) continue;
+            uint32_t score = hrw_score(rt->node_id[s], (uint32_t)r);
+            if (best == slot || hrw_beats(rt->node_id[s], score, best_id, best_score)) {
+                best = s;
+                best_id = rt->node_id[s];
+                best_score = score;
+            }
+        }
+        rt->owner[r] = (uint8_t)best;
+        if (moved) moved[n_moved] = (uint8_t)r;
+        n_moved++;
+    }
+    return n_moved;
+}
+
+/**
+ * Number of ranges owned by a node.
+ */
+int cell_route_node_ranges(const cell_route_t* rt, uint32_t node_id) {
+    int slot = find_slot(rt, node_id);
+    if (slot < 0) {
+        return 0;
+    }
+    int count = 0;
+    for (int r = 0; r < CELL_ROUTE_RANGES; r++) {
+        if (rt->owner[r] == slot) count++;
+    }
+    return count;
+}
+
+/**
+ * Number of nodes in the table.
+ */
+int cell_route_node_count(const cell_route_t* rt) {
+    int count = 0;
+    for (uint32_t m = rt->active_mask; m; m &= m - 1) {
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,199 @@
+/*
+ * cell_route.h - Cell Ownership Routing for Distributed Edge Nodes
+ *
+ * Maps T-BSP cell IDs to the edge node that owns them, so a handoff packet
+ * is forwarded to exactly one node instead of being broadcast.
+ *
+ * Scheme:
+ *   1. Cell ID (lat_idx, lon_idx) → 16-bit Morton (Z-order) key.
+ *      Indices are biased by +128 first, so cells on either side of the
+ *      grid origin stay adjacent on the curve.
+ *   2. The key space is cut into CELL_ROUTE_RANGES equal ranges. Each
+ *      range is a 16×16 block of cells (160 km square at 10 km cells), so
+ *      most handoffs stay inside one owner's territory.
+ *   3. Ranges are assigned to nodes by rendezvous (highest-random-weight)
+ *      hashing. Every node computes the same table from the same node list,
+ *      and a join or leave moves only the ranges the change must move.
+ *
+ * Lookup is O(1): Morton spread, shift, two table loads.
+ *
+ * Doom Lineage:
+ *   - Doom blockmap (bmaporgx/bmaporgy, 128-unit blocks) → fixed range
+ *     blocks over the cell grid
+ *   - Doom netgame node list (doomcom->numnodes) → route->node_id[]
+ *
+ * Hardware Target: ESP32-S3 (static table, ~400 bytes, no allocation)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#ifndef CELL_ROUTE_H
+#define CELL_ROUTE_H
+
+#include "se3_edge.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * CONFIGURATION CONSTANTS
+ * ======================================================================== */
+
+/**
+ * Number of ownership ranges on the Z-order curve.
+ *
+ * 256 ranges × 256 keys = the full 16-bit cell ID space. Each range is an
+ * aligned 16×16 cell block. More ranges balance load better but cut more
+ * vessel tracks at block borders.
+ */
+#define CELL_ROUTE_RANGES      256
+#define CELL_ROUTE_RANGE_SHIFT 8      /* 16-bit key >> 8 = range index */
+
+/** Maximum edge nodes in one routing domain (active set is a uint32_t mask) */
+#define CELL_ROUTE_MAX_NODES   32
+
+/** Node ID 0 is reserved: empty slot / no owner */
+#define CELL_ROUTE_NO_NODE     0u
+
+_Static_assert(CELL_ROUTE_RANGES <= 256, "range index must fit uint8_t");
+_Static_assert(CELL_ROUTE_MAX_NODES <= 32, "active set is a 32-bit mask");
+
+/* ========================================================================
+ * DATA STRUCTURES
+ * ======================================================================== */
+
+/**
+ * Routing table (identical on every node of the domain).
+ *
+ * owner[] holds node slots, not IDs, so it stays one byte per range.
+ * Slots are stable while a node is present; a leaving node frees its slot.
+ *
+ * Memory: 256 + 128 + 8 = 392 bytes
+ */
+typedef struct {
+    uint8_t owner[CELL_ROUTE_RANGES];          /**< Range → node slot */
+    uint32_t node_id[CELL_ROUTE_MAX_NODES];    /**< Slot → node ID (0 = free) */
+    uint32_t active_mask;                      /**< Bit per occupied slot */
+    uint32_t epoch;                            /**< Bumped on every membership change */
+} cell_route_t;
+
+/* ========================================================================
+ * INLINE LOOKUP
+ * ======================================================================== */
+
+/**
+ * Spread the low 8 bits of x to the even bit positions (Morton helper).
+ */
+static inline uint16_t cell_route_spread8(uint16_t x) {
+    x = (uint16_t)((x | (x << 4)) & 0x0F0F);
+    x = (uint16_t)((x | (x << 2)) & 0x3333);
+    x = (uint16_t)((x | (x << 1)) & 0x5555);
+    return x;
+}
+
+/**
+ * Z-order (Morton) key of a cell ID.
+ *
+ * Latitude index on odd bits, longitude on even bits, both biased by +128
+ * (XOR 0x80 on the two's-complement byte) so -1 and 0 are neighbours.
+ *
+ * @param cell_id T-BSP cell ID ((lat_idx & 0xFF) << 8 | (lon_idx & 0xFF))
+ * @return 16-bit curve position
+ */
+static inline uint16_t cell_route_key(uint16_t cell_id) {
+    uint16_t lat = (uint16_t)(((cell_id >> 8) ^ 0x80) & 0xFF);
+    uint16_t lon = (uint16_t)((cell_id ^ 0x80) & 0xFF);
+    return (uint16_t)((cell_route_spread8(lat) << 1) | cell_route_spread8(lon));
+}
+
+/**
+ * Ownership range of a cell.
+ */
+static inline uint8_t cell_route_range(uint16_t cell_id) {
+    return (uint8_t)(cell_route_key(cell_id) >> CELL_ROUTE_RANGE_SHIFT);
+}
+
+/**
+ * Owner node of a cell (O(1)).
+ *
+ * @param rt Routing table
+ * @param cell_id T-BSP cell ID
+ * @return Owning node ID, or CELL_ROUTE_NO_NODE if the table is empty
+ */
+static inline uint32_t cell_route_lookup(const cell_route_t* rt, uint16_t cell_id) {
+    return rt->node_id[rt->owner[cell_route_range(cell_id)]];
+}
+
+/**
+ * Forwarding target for a handoff packet.
+ *
+ * @param rt Routing table
+ * @param pkt Handoff packet (new_cell_id is routed)
+ * @param local_node This node's ID
+ * @return Node to forward to, or CELL_ROUTE_NO_NODE if the new cell is local
+ */
+static inline uint32_t cell_route_handoff_target(const cell_route_t* rt,
+                                                 const handoff_packet_t* pkt,
+                                                 uint32_t local_node) {
+    uint32_t owner = cell_route_lookup(rt, pkt->new_cell_id);
+    return (owner == local_node) ? CELL_ROUTE_NO_NODE : owner;
+}
+
+/* ========================================================================
+ * API FUNCTIONS
+ * ======================================================================== */
+
+/**
+ * Initialize an empty routing table (every lookup returns CELL_ROUTE_NO_NODE).
+ *
+ * @param rt Routing table (must be allocated by caller)
+ */
+void cell_route_init(cell_route_t* rt);
+
+/**
+ * Add a node and take over the ranges it wins (incremental rebalance).
+ *
+ * Only ranges whose rendezvous score for the new node beats the current
+ * owner's move; on average CELL_ROUTE_RANGES / node_count of them.
+ *
+ * @param rt Routing table
+ * @param node_id Joining node (non-zero, not already present)
+ * @param moved Optional output: ranges that moved (capacity CELL_ROUTE_RANGES)
+ * @return Number of ranges moved, or -1 (invalid ID, duplicate, table full)
+ */
+int cell_route_add_node(cell_route_t* rt, uint32_t node_id, uint8_t* moved);
+
+/**
+ * Remove a node and hand its ranges to their next-best owners.
+ *
+ * Ranges owned by other nodes never move.
+ *
+ * @param rt Routing table
+ * @param node_id Leaving node
+ * @param moved Optional output: ranges that moved (capacity CELL_ROUTE_RANGES)
+ * @return Number of ranges moved, or -1 if the node is not present
+ */
+int cell_route_remove_node(cell_route_t* rt, uint32_t node_id, uint8_t* moved);
+
+/**
+ * Number of ranges owned by a node (load diagnostic).
+ *
+ * @param rt Routing table
+ * @param node_id Node to count
+ * @return Ranges owned (0 if not present)
+ */
+int cell_route_node_ranges(const cell_route_t* rt, uint32_t node_id);
+
+/**
+ * Number of nodes in the table.
+ */
+int cell_route_node_count(const cell_route_t* rt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELL_ROUTE_H */
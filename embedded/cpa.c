@@ -0,0 +1,323 @@
+/*
+ * cpa.c - CPA/TCPA Screening Implementation
+ *
+ * Per fix: one vessel-table probe, an O(1) relink if the cell changed,
+ * then one CPA evaluation per live partner in the 3×3 neighbourhood.
+ * All arithmetic is fixed point with 64-bit intermediates.
+ *
+ * Reference: id-Software/DOOM linuxdoom-1.10/p_map.c (PIT_CheckThing),
+ *            p_maputl.c (P_SetThingPosition block links)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "cpa.h"
+#include <string.h>
+
+/* ========================================================================
+ * INTERNAL HELPERS
+ * ======================================================================== */
+
+static inline uint32_t cell_hash(uint16_t cell_id) {
+    return ((uint32_t)cell_id * 40503u) & (CPA_CELL_SLOTS - 1);
+}
+
+static inline bool vessel_live(const cpa_vessel_t* v) {
+    return v->mmsi != 0 && v->mmsi != CPA_TOMBSTONE;
+}
+
+/**
+ * Cell slot index, or -1 if no vessel is linked into the cell.
+ */
+static int cell_find(const cpa_engine_t* cpa, uint16_t cell_id) {
+    uint32_t slot = cell_hash(cell_id);
+    for (uint32_t probe = 0; probe < CPA_CELL_SLOTS; probe++) {
+        const cpa_cell_t* c = &cpa->cells[slot];
+        if (c->head == CPA_NONE) return -1;
+        if (c->cell_id == cell_id) return (int)slot;
+        slot = (slot + 1) & (CPA_CELL_SLOTS - 1);
+    }
+    return -1;
+}
+
+/**
+ * Remove an empty cell slot (backward-shift deletion keeps probe chains
+ * intact without tombstones).
+ */
+static void cell_delete(cpa_engine_t* cpa, uint32_t hole) {
+    uint32_t j = hole;
+    for (;;) {
+        j = (j + 1) & (CPA_CELL_SLOTS - 1);
+        if (cpa->cells[j].head == CPA_NONE) break;
+        uint32_t home = cell_hash(cpa->cells[j].cell_id);
+        /* Entry at j may fill the hole if its home is not in (hole, j] */
+        bool movable = (hole <= j) ? (home <= hole || home > j)
+                                   : (home <= hole && home > j);
+        if (movable) {
+            cpa->cells[hole] = cpa->cells[j];
+            hole = j;
+        }
+    }
+    cpa->cells[hole].head = CPA_NONE;
+}
+
+/**
+ * Push a vessel onto its cell's list (claims the cell slot if needed).
+ */
+static void cell_link(cpa_engine_t* cpa, uint16_t vi, uint16_t cell_id) {
+    cpa_vessel_t* v = &cpa->vessels[vi];
+    uint32_t slot = cell_hash(cell_id);
+    /* #cells <= #vessels <= CPA_CELL_SLOTS, so a slot is always found */
+    for (uint32_t probe = 0; probe < CPA_CELL_SLOTS; probe++) {
+        cpa_cell_t* c = &cpa->cells[slot];
+        if (c->head == CPA_NONE || c->cell_id == cell_id) {
+            if (c->head != CPA_NONE) cpa->vessels[c->head].prev = vi;
+            v->next = c->head;
+            v->prev = CPA_NONE;
+            v->cell_id = cell_id;
+            c->cell_id = cell_id;
+            c->head = vi;
+            return;
+        }
+        slot = (slot + 1) & (CPA_CELL_SLOTS - 1);
+    }
+}
+
+/**
+ * Remove a vessel from its cell's list (frees the cell slot when empty).
+ */
+static void cell_unlink(cpa_engine_t* cpa, uint16_t vi) {
+    cpa_vessel_t* v = &cpa->vessels[vi];
+    if (v->next != CPA_NONE) cpa->vessels[v->next].prev = v->prev;
+    if (v->prev != CPA_NONE) {
+        cpa->vessels[v->prev].next = v->next;
+    } else {
+        int slot = cell_find(cpa, v->cell_id);
+        if (slot >= 0) {
+            cpa->cells[slot].head = v->next;
+            if (v->next == CPA_NONE) cell_delete(cpa, (uint32_t)slot);
+        }
+    }
+    v->next = v->prev = CPA_NONE;
+}
+
+/**
+ * Re-key every cell link after a grid re-center.
+ *
+ * The physical grid never moves, so the new ID is the old window index
+ * shifted by the move of the window center (however many re-centers ran
+ * since). Vessels beyond the new window clamp to its edge, as their next
+ * t_bsp_latlon_to_cell() would.
+ */
+static void cells_rekey(cpa_engine_t* cpa, const t_bsp_t* bsp) {
+    int dlat = bsp->center_lat_idx - cpa->center_lat_idx;
+    int dlon = bsp->center_lon_idx - cpa->center_lon_idx;
+    for (int i = 0; i < CPA_CELL_SLOTS; i++) {
+        cpa->cells[i].head = CPA_NONE;
+    }
+    for (uint16_t i = 0; i < CPA_MAX_VESSELS; i++) {
+        cpa_vessel_t* v = &cpa->vessels[i];
+        if (!vessel_live(v)) continue;
+        int lat_idx = (int8_t)(v->cell_id >> 8) - dlat;
+        int lon_idx = (int8_t)(v->cell_id & 0xFF) - dlon;
+        if (lat_idx > 127) lat_idx = 127;
+        if (lat_idx < -128) lat_idx = -128;
+        if (lon_idx > 127) lon_idx = 127;
+        if (lon_idx < -128) lon_idx = -128;
+        cell_link(cpa, i, (uint16_t)(((lat_idx & 0xFF) << 8) | (lon_idx & 0xFF)));
+    }
+    cpa->center_lat_idx = bsp->center_lat_idx;
+    cpa->center_lon_idx = bsp->center_lon_idx;
+    cpa->grid_epoch = bsp->grid_epoch;
+}
+
+/**
+ * Vessel slot for an MMSI, claiming one (reusing the first tombstone on
+ * the probe path) on first sight. -1 if the table is full.
+ */
+static int vessel_slot(cpa_engine_t* cpa, uint32_t mmsi, bool* is_new) {
+    uint32_t slot = (mmsi * 0x9E3779B1u) >> 16 & (CPA_MAX_VESSELS - 1);
+    int reuse = -1;
+    for (uint32_t probe = 0; probe < CPA_MAX_VESSELS; probe++) {
+        uint32_t m = cpa->vessels[slot].mmsi;
+        if (m == mmsi) {
+            *is_new = false;
+            return (int)slot;
+        }
+        if (m == CPA_TOMBSTONE) {
+            if (reuse < 0) reuse = (int)slot;
+        } else if (m == 0) {
+            if (reuse < 0) reuse = (int)slot;
+            break;
+        }
+        slot = (slot + 1) & (CPA_MAX_VESSELS - 1);
+    }
+    if (reuse < 0) return -1;
+    *is_new = true;
+    return reuse;
+}
+
+/* ========================================================================
+ * CPA KERNEL
+ * ======================================================================== */
+
+void cpa_compute(const fixed_t pa[2], const fixed_t va[2],
+                 const fixed_t pb[2], const fixed_t vb[2],
+                 fixed_t* dcpa, fixed_t* tcpa) {
+    int64_t rx = (int64_t)pb[0] - pa[0];
+    int64_t ry = (int64_t)pb[1] - pa[1];
+    int64_t vx = (int64_t)vb[0] - va[0];
+    int64_t vy = (int64_t)vb[1] - va[1];
+
+    /* Q32 dot products */
+    int64_t rv = rx * vx + ry * vy;
+    int64_t vv = vx * vx + vy * vy;
+
+    /* Diverging, or relative speed below 1/256 m/s: closest now */
+    int64_t t = 0;
+    if (rv < 0 && vv >= FRACUNIT) {
+        uint64_t num = (uint64_t)(-rv);
+        if (num < (1ULL << 47)) {
+            t = (int64_t)((num << FRACBITS) / (uint64_t)vv);
+        } else {
+            t = (int64_t)(num / (uint64_t)(vv >> FRACBITS));
+        }
+        if (t > 0x7FFFFFFF) t = 0x7FFFFFFF;
+    }
+
+    int64_t cx = rx + ((vx * t) >> FRACBITS);
+    int64_t cy = ry + ((vy * t) >> FRACBITS);
+    int64_t lim = 0x7FFFFFFF;
+
+    *tcpa = (fixed_t)t;
+    if (cx > lim || cx < -lim || cy > lim || cy < -lim) {
+        *dcpa = 0x7FFFFFFF;  /* Beyond ±32 km: saturate */
+        return;
+    }
+    /* Q32 sum < 2^63; root is Q16 */
+    uint32_t d = isqrt64((uint64_t)(cx * cx) + (uint64_t)(cy * cy));
+    *dcpa = d > 0x7FFFFFFFu ? 0x7FFFFFFF : (fixed_t)d;
+}
+
+/* ========================================================================
+ * ENGINE
+ * ======================================================================== */
+
+void cpa_init(cpa_engine_t* cpa, fixed_t dcpa_threshold_m, fixed_t tcpa_horizon_s,
+              uint32_t max_age_s) {
+    memset(cpa, 0, sizeof(*cpa));
+    for (int i = 0; i < CPA_CELL_SLOTS; i++) {
+        cpa->cells[i].head = CPA_NONE;
+    }
+    cpa->dcpa_threshold = dcpa_threshold_m;
+    cpa->tcpa_horizon = tcpa_horizon_s;
+    cpa->max_age = max_age_s;
+}
+
+int cpa_update(cpa_engine_t* cpa, t_bsp_t* bsp, uint16_t cell_id, const se3_pose_t* pose,
+               cpa_alert_t* alerts, int max_alerts) {
+    if (cpa->grid_epoch != bsp->grid_epoch || cpa->center_lat_idx != bsp->center_lat_idx ||
+        cpa->center_lon_idx != bsp->center_lon_idx) {
+        cells_rekey(cpa, bsp);
+    }
+
+    bool is_new;
+    int idx = vessel_slot(cpa, pose->mmsi, &is_new);
+    if (idx < 0) return -1;
+    uint16_t vi = (uint16_t)idx;
+    cpa_vessel_t* v = &cpa->vessels[vi];
+
+    fixed_t east = pose->translation[0];
+    fixed_t north = pose->translation[1];
+
+    /* Kinematics from the previous and current fix */
+    if (is_new) {
+        memset(v, 0, sizeof(*v));
+        v->mmsi = pose->mmsi;
+        cpa->n_vessels++;
+        cell_link(cpa, vi, cell_id);
+    } else {
+        int64_t dt = (int64_t)pose->timestamp - v->t;
+        if (dt < 0) return 0;  /* Out of order: keep the newer state */
+        if (dt > 0 && dt <= cpa->max_age) {
+            v->vel[0] = (fixed_t)(((int64_t)east - v->pos[0]) / dt);
+            v->vel[1] = (fixed_t)(((int64_t)north - v->pos[1]) / dt);
+            v->has_vel = 1;
+        } else if (dt > cpa->max_age) {
+            v->has_vel = 0;  /* Gap: the old fix says nothing about now */
+        }
+        if (v->cell_id != cell_id) {
+            cell_unlink(cpa, vi);
+            cell_link(cpa, vi, cell_id);
+        }
+    }
+    v->pos[0] = east;
+    v->pos[1] = north;
+    v->t = pose->timestamp;
+
+    if (!v->has_vel) return 0;
+
+    /* Candidates: own cell + 8 neighbours */
+    uint16_t ids[9];
+    int n_adjacent = 0;
+    ids[0] = cell_id;
+    t_bsp_get_adjacent_cells(bsp, cell_id, &ids[1], &n_adjacent);
+
+    int n_alerts = 0;
+    for (int k = 0; k < 1 + n_adjacent; k++) {
+        int slot = cell_find(cpa, ids[k]);
+        if (slot < 0) continue;
+
+        for (uint16_t oi = cpa->cells[slot].head; oi != CPA_NONE; oi = cpa->vessels[oi].next) {
+            const cpa_vessel_t* o = &cpa->vessels[oi];
+            if (oi == vi || !o->has_vel) continue;
+            int64_t age = (int64_t)v->t - o->t;
+            if (age > cpa->max_age || age < -(int64_t)cpa->max_age) continue;
+
+            /* Dead-reckon the partner to this fix's time */
+            fixed_t po[2] = {
+                (fixed_t)(o->pos[0] + (int64_t)o->vel[0] * age),
+                (fixed_t)(o->pos[1] + (int64_t)o->vel[1] * age)
+            };
+            cpa->pairs_evaluated++;
+            int64_t r[2] = { (int64_t)po[0] - v->pos[0], (int64_t)po[1] - v->pos[1] };
+            int64_t rel_v[2] = { (int64_t)o->vel[0] - v->vel[0], (int64_t)o->vel[1] - v->vel[1] };
+            if (!cpa_may_alert(cpa, r, rel_v)) continue;
+
+            fixed_t dcpa, tcpa;
+            cpa_compute(v->pos, v->vel, po, o->vel, &dcpa, &tcpa);
+            cpa->pairs_computed++;
+
+            if (dcpa <= cpa->dcpa_threshold && tcpa <= cpa->tcpa_horizon &&
+                n_alerts < max_alerts) {
+                cpa_alert_t* a = &alerts[n_alerts++];
+                a->mmsi_a = v->mmsi;
+                a->mmsi_b = o->mmsi;
+                a->dcpa = dcpa;
+                a->tcpa = tcpa;
+                a->timestamp = v->t;
+            }
+        }
+    }
+    return n_alerts;
+}
+
+int cpa_expire(cpa_engine_t* cpa, uint32_t now) {
+    int removed = 0;
+    for (uint16_t i = 0; i < CPA_MAX_VESSELS; i++) {
+        cpa_vessel_t* v = &cpa->vessels[i];
+        if (!vessel_live(v) || (int64_t)now - v->t <= cpa->max_age) continue;
+        cell_unlink(cpa, i);
+        v->mmsi = CPA_TOMBSTONE;
+        v->has_vel = 0;
+        cpa->n_vessels--;
+        removed++;
+    }
+    /* Empty table: drop tombstones so probe chains start short again */
+    if (removed > 0 && cpa->n_vessels == 0) {
+        for (int i = 0; i < CPA_MAX_VESSELS; i++) {
+            cpa->vessels[i].mmsi = 0;
+        }
+    }
+    return removed;
+}
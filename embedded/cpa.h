@@ -0,0 +1,197 @@
+/*
+ * cpa.h - Closest Point of Approach (CPA/TCPA) Screening on the T-BSP Grid
+ *
+ * Collision-risk screening between vessels. Each fix updates the sender's
+ * position and velocity (from its last two poses) and evaluates CPA only
+ * against vessels in the same cell and the 8 adjacent cells, instead of
+ * all pairs.
+ *
+ *   r    = p_B - p_A          (relative position, ENU east/north, m)
+ *   v    = v_B - v_A          (relative velocity, m/s)
+ *   TCPA = -(r·v) / |v|²      (s, clamped to [0, horizon])
+ *   DCPA = |r + v·TCPA|       (m)
+ *
+ * Positions are horizontal ENU translations from se3_pose_t, so all
+ * vessels must share one local frame (the node's voyage origin) and stay
+ * within the 16.16 range (±32 km). The 3×3 neighbourhood guarantees one
+ * cell (10 km) of reach, so choose the TCPA horizon such that horizon ×
+ * closing speed stays under ~10 km (e.g. 20 min at 16 kn closing).
+ *
+ * Doom Lineage:
+ *   - Doom P_CheckPosition()/PIT_CheckThing (test only things linked in
+ *     nearby blockmap blocks) → candidates from the 3×3 cell neighbourhood
+ *   - Doom mobj_t bnext/bprev block links → cpa_vessel_t next/prev links
+ *
+ * Hardware Target: ESP32-S3 (~10 KB static with defaults)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#ifndef CPA_H
+#define CPA_H
+
+#include "se3_edge.h"
+#include "t_bsp.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * CONFIGURATION CONSTANTS
+ * ======================================================================== */
+
+#ifndef CPA_MAX_VESSELS
+#define CPA_MAX_VESSELS      256     /* Tracked vessels (power of 2) */
+#endif
+
+#ifndef CPA_CELL_SLOTS
+#define CPA_CELL_SLOTS       512     /* Occupied-cell hash slots (power of 2) */
+#endif
+
+#define CPA_NONE             0xFFFF      /* Null vessel link / empty cell slot */
+#define CPA_TOMBSTONE        0xFFFFFFFFu /* Expired vessel slot (never a valid MMSI) */
+
+_Static_assert((CPA_MAX_VESSELS & (CPA_MAX_VESSELS - 1)) == 0,
+               "CPA_MAX_VESSELS must be a power of 2");
+_Static_assert((CPA_CELL_SLOTS & (CPA_CELL_SLOTS - 1)) == 0,
+               "CPA_CELL_SLOTS must be a power of 2");
+_Static_assert(CPA_CELL_SLOTS >= CPA_MAX_VESSELS, "every vessel may occupy its own cell");
+_Static_assert(CPA_MAX_VESSELS < CPA_NONE, "vessel links are uint16_t");
+
+/* ========================================================================
+ * DATA STRUCTURES
+ * ======================================================================== */
+
+/** Vessel kinematic state (position and velocity at time t) */
+typedef struct {
+    uint32_t mmsi;             /**< 0 = free, CPA_TOMBSTONE = expired */
+    uint32_t t;                /**< Timestamp of pos (s) */
+    fixed_t pos[2];            /**< East, north (m) */
+    fixed_t vel[2];            /**< East, north (m/s) */
+    uint16_t cell_id;          /**< Cell the vessel is linked into */
+    uint16_t next, prev;       /**< Links in the cell's vessel list */
+    uint8_t has_vel;           /**< Two fixes seen */
+    uint8_t _padding;
+} cpa_vessel_t;
+
+/** Occupied cell → first vessel */
+typedef struct {
+    uint16_t cell_id;
+    uint16_t head;             /**< CPA_NONE = empty slot */
+} cpa_cell_t;
+
+/** Collision-risk alert (20 bytes) */
+typedef struct {
+    uint32_t mmsi_a;           /**< Vessel whose fix triggered the check */
+    uint32_t mmsi_b;
+    fixed_t dcpa;              /**< Distance at CPA (m) */
+    fixed_t tcpa;              /**< Time to CPA from the fix (s) */
+    uint32_t timestamp;        /**< Fix timestamp */
+} cpa_alert_t;
+
+/** CPA engine state */
+typedef struct {
+    cpa_vessel_t vessels[CPA_MAX_VESSELS];
+    cpa_cell_t cells[CPA_CELL_SLOTS];
+    fixed_t dcpa_threshold;    /**< Alert if DCPA below (m) */
+    fixed_t tcpa_horizon;      /**< ... and 0 <= TCPA <= horizon (s) */
+    uint32_t max_age;          /**< Skip partners older than this (s) */
+    uint32_t n_vessels;
+    int32_t center_lat_idx;    /**< bsp window the cell links are keyed in */
+    int32_t center_lon_idx;
+    uint8_t grid_epoch;        /**< ... and its bsp->grid_epoch */
+    uint8_t _padding[7];
+    uint64_t pairs_evaluated;  /**< Diagnostic: candidate pairs screened */
+    uint64_t pairs_computed;   /**< Diagnostic: pairs past cpa_may_alert() */
+} cpa_engine_t;
+
+/* ========================================================================
+ * API FUNCTIONS
+ * ======================================================================== */
+
+/**
+ * Initialize the engine.
+ *
+ * @param cpa Engine (caller-allocated)
+ * @param dcpa_threshold_m Alert distance (e.g. 0.5 NM = 926 m)
+ * @param tcpa_horizon_s Look-ahead (e.g. 20 min = 1200 s)
+ * @param max_age_s Partners without a fix for this long are ignored
+ */
+void cpa_init(cpa_engine_t* cpa, fixed_t dcpa_threshold_m, fixed_t tcpa_horizon_s,
+              uint32_t max_age_s);
+
+/**
+ * CPA/TCPA between two constant-velocity tracks at a common time.
+ *
+ * @param pa Position A (m)      @param va Velocity A (m/s)
+ * @param pb Position B (m)      @param vb Velocity B (m/s)
+ * @param dcpa Output: distance at closest approach (m)
+ * @param tcpa Output: time to closest approach (s, clamped to >= 0;
+ *             0 if diverging or no relative motion)
+ */
+void cpa_compute(const fixed_t pa[2], const fixed_t va[2],
+                 const fixed_t pb[2], const fixed_t vb[2],
+                 fixed_t* dcpa, fixed_t* tcpa);
+
+/**
+ * Conservative reject test run before cpa_compute().
+ *
+ * Never rejects a pair that would alert: a diverging pair must already be
+ * inside the threshold box, and a converging pair must be able to close
+ * each axis to within the threshold before the horizon (|r| - |v|·H).
+ * Avoids the division and square root for most candidates.
+ *
+ * @param cpa Engine (thresholds)
+ * @param r Relative position B - A (m, 16.16 in 64-bit)
+ * @param v Relative velocity B - A (m/s, 16.16 in 64-bit)
+ * @return false if the pair cannot alert
+ */
+static inline bool cpa_may_alert(const cpa_engine_t* cpa, const int64_t r[2], const int64_t v[2]) {
+    int64_t thr = cpa->dcpa_threshold;
+    int64_t h = cpa->tcpa_horizon;
+    bool closing = r[0] * v[0] + r[1] * v[1] < 0;
+    for (int k = 0; k < 2; k++) {
+        int64_t d = r[k] < 0 ? -r[k] : r[k];
+        int64_t s = v[k] < 0 ? -v[k] : v[k];
+        int64_t reach = closing ? (s * h) >> FRACBITS : 0;
+        if (d - reach > thr) return false;
+    }
+    return true;
+}
+
+/**
+ * Process one fix: update the vessel, relink it if its cell changed, and
+ * screen it against vessels in the 3×3 cell neighbourhood.
+ *
+ * The partner's position is extrapolated to the fix's timestamp first.
+ * After a t_bsp re-center every vessel's cell link is re-keyed into the
+ * new window before the lookup.
+ *
+ * @param cpa Engine
+ * @param bsp Grid (adjacency)
+ * @param cell_id Cell of the fix (t_bsp_latlon_to_cell)
+ * @param pose Fix (translation, timestamp, mmsi)
+ * @param alerts Output alerts (capacity max_alerts)
+ * @param max_alerts Output capacity
+ * @return Alerts written, or -1 if the vessel table is full
+ */
+int cpa_update(cpa_engine_t* cpa, t_bsp_t* bsp, uint16_t cell_id, const se3_pose_t* pose,
+               cpa_alert_t* alerts, int max_alerts);
+
+/**
+ * Drop vessels whose last fix is older than max_age.
+ *
+ * @param cpa Engine
+ * @param now Current time (s)
+ * @return Vessels removed
+ */
+int cpa_expire(cpa_engine_t* cpa, uint32_t now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CPA_H */
@@ -0,0 +1,320 @@
+/*
+ * density.c - Streaming Traffic-Density Raster Implementation
+ *
+ * Per fix: a hinted scan of the resident tile IDs, a lazy window catch-up
+ * for that tile, two multiplies for the pixel, one or two increments.
+ *
+ * Reference: id-Software/DOOM linuxdoom-1.10/am_map.c (AM_drawFline),
+ *            z_zone.c (PU_CACHE purge)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "density.h"
+#include <string.h>
+
+#define DEG_360  ((fixed_t)(360 * FRACUNIT))
+#define DEG_180  ((fixed_t)(180 * FRACUNIT))
+
+/* ========================================================================
+ * INTERNAL HELPERS
+ * ======================================================================== */
+
+/**
+ * Apply pending decay / window expiry to one tile.
+ */
+static void tile_catch_up(density_raster_t* dr, int i) {
+    density_tile_t* t = &dr->tiles[i];
+    if (t->epoch >= dr->epoch) return;
+
+    uint32_t elapsed = dr->epoch - t->epoch;
+    t->epoch = dr->epoch;
+    if (dr->mode == DENSITY_MODE_WINDOW || elapsed >= 16) {
+        memset(dr->counts[i], 0, sizeof(dr->counts[i]));
+        return;
+    }
+    uint16_t* px = &dr->counts[i][0][0];
+    for (int k = 0; k < DENSITY_LAYERS * DENSITY_TILE_PIXELS; k++) {
+        px[k] >>= elapsed;
+    }
+}
+
+/**
+ * Remove a tile (the last tile moves into its slot).
+ */
+static void tile_remove(density_raster_t* dr, int i) {
+    int last = dr->n_tiles - 1;
+    if (i != last) {
+        dr->tile_cell[i] = dr->tile_cell[last];
+        dr->tiles[i] = dr->tiles[last];
+        memcpy(dr->counts[i], dr->counts[last], sizeof(dr->counts[i]));
+    }
+    dr->n_tiles--;
+    dr->last = 0;
+}
+
+/**
+ * Re-key tiles after a grid re-center; tiles that left the window drop.
+ *
+ * The cached corner identifies the physical cell, so the new ID is the
+ * cell containing the tile's center; exact edges of the same cell do not
+ * move with the window.
+ */
+static void tiles_rekey(density_raster_t* dr, t_bsp_t* bsp) {
+    int i = 0;
+    while (i < dr->n_tiles) {
+        density_tile_t* t = &dr->tiles[i];
+        uint16_t id = t_bsp_latlon_to_cell(bsp, t->lat_min + t->lat_span / 2,
+                                           t->lon_min + t->lon_span / 2);
+        fixed_t lat_min, lat_max, lon_min, lon_max;
+        t_bsp_get_cell_edges(bsp, id, &lat_min, &lat_max, &lon_min, &lon_max);
+        /* Clamped IDs (outside the window) resolve to a different cell */
+        if (lat_min != t->lat_min || lon_min != t->lon_min) {
+            tile_remove(dr, i);
+            continue;
+        }
+        dr->tile_cell[i] = id;
+        i++;
+    }
+    dr->grid_epoch = bsp->grid_epoch;
+}
+
+static int tile_find(const density_raster_t* dr, uint16_t cell_id) {
+    if (dr->last < dr->n_tiles && dr->tile_cell[dr->last] == cell_id) {
+        return dr->last;
+    }
+    for (int i = 0; i < dr->n_tiles; i++) {
+        if (dr->tile_cell[i] == cell_id) return i;
+    }
+    return -1;
+}
+
+/**
+ * Claim a tile for a cell, recycling the least recently touched one.
+ */
+static int tile_alloc(density_raster_t* dr, t_bsp_t* bsp, uint16_t cell_id) {
+    int i;
+    if (dr->n_tiles < DENSITY_MAX_TILES) {
+        i = dr->n_tiles++;
+    } else {
+        i = 0;
+        for (int k = 1; k < DENSITY_MAX_TILES; k++) {
+            if (dr->tiles[k].last_touch < dr->tiles[i].last_touch) i = k;
+        }
+        dr->evictions++;
+    }
+
+    fixed_t lat_max, lon_max;
+    density_tile_t* t = &dr->tiles[i];
+    t_bsp_get_cell_edges(bsp, cell_id, &t->lat_min, &lat_max, &t->lon_min, &lon_max);
+    t->lat_span = lat_max - t->lat_min;
+    t->lon_span = lon_max - t->lon_min;
+    t->px_lat = FixedDiv(INT_TO_FIXED(DENSITY_TILE_DIM), t->lat_span);
+    t->px_lon = FixedDiv(INT_TO_FIXED(DENSITY_TILE_DIM), t->lon_span);
+    t->epoch = dr->epoch;
+    t->last_touch = dr->epoch;
+    dr->tile_cell[i] = cell_id;
+    memset(dr->counts[i], 0, sizeof(dr->counts[i]));
+    return i;
+}
+
+static inline int pixel_index(fixed_t d, fixed_t px_per_deg) {
+    int p = FIXED_TO_INT(FixedMul(d, px_per_deg));
+    if (p < 0) p = 0;
+    if (p > DENSITY_TILE_DIM - 1) p = DENSITY_TILE_DIM - 1;
+    return p;
+}
+
+static inline void count_inc(density_raster_t* dr, uint16_t* c) {
+    if (*c != 0xFFFF) {
+        (*c)++;
+    } else {
+        dr->saturated++;
+    }
+}
+
+/* ========================================================================
+ * API
+ * ======================================================================== */
+
+void density_init(density_raster_t* dr, uint8_t mode, uint32_t window_s) {
+    memset(dr, 0, sizeof(*dr));
+    dr->mode = mode;
+    dr->window_s = window_s ? window_s : 1;
+}
+
+int density_add(density_raster_t* dr, t_bsp_t* bsp, uint16_t cell_id,
+                fixed_t lat, fixed_t lon, uint32_t timestamp, uint8_t vessel_class) {
+    uint32_t e = timestamp / dr->window_s;
+    if (e < dr->epoch) return -1;  /* Late fix from a closed window */
+    dr->epoch = e;
+
+    if (dr->grid_epoch != bsp->grid_epoch) {
+        tiles_rekey(dr, bsp);
+    }
+
+    int i = tile_find(dr, cell_id);
+    if (i < 0) {
+        i = tile_alloc(dr, bsp, cell_id);
+    }
+    dr->last = (uint16_t)i;
+
+    density_tile_t* t = &dr->tiles[i];
+    tile_catch_up(dr, i);
+    t->last_touch = e;
+
+    fixed_t dlon = lon - t->lon_min;
+    if (dlon < -DEG_180) dlon += DEG_360;  /* Tile west of the dateline */
+    int px = pixel_index(lat - t->lat_min, t->px_lat) * DENSITY_TILE_DIM +
+             pixel_index(dlon, t->px_lon);
+
+    count_inc(dr, &dr->counts[i][0][px]);
+    if (vessel_class > 0 && vessel_class < DENSITY_LAYERS) {
+        count_inc(dr, &dr->counts[i][vessel_class][px]);
+    }
+    return i;
+}
+
+uint16_t density_get(density_raster_t* dr, uint16_t cell_id, uint8_t layer, int row, int col) {
+    int i = tile_find(dr, cell_id);
+    if (i < 0 || layer >= DENSITY_LAYERS ||
+        row < 0 || row >= DENSITY_TILE_DIM || col < 0 || col >= DENSITY_TILE_DIM) {
+        return 0;
+    }
+    tile_catch_up(dr, i);
+    return dr->counts[i][layer][row * DENSITY_TILE_DIM + col];
+}
+
+void density_advance(density_raster_t* dr, uint32_t timestamp) {
+    uint32_t e = timestamp / dr->window_s;
+    if (e > dr->epoch) dr->epoch = e;
+    for (int i = 0; i < dr->n_tiles; i++) {
+        tile_catch_up(dr, i);
+    }
+}
+
+/* ========================================================================
+ * EXPORT
+ * ======================================================================== */
+
+static inline size_t put_u16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return 2;
+}
+
+static inline size_t put_u32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return 4;
+}
+
+static inline size_t put_varint(uint8_t* p, uint32_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+static inline uint32_t get_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* Varints here never exceed 3 bytes (runs <= 2^16, counts <= 65535) */
+static size_t get_varint(const uint8_t* p, size_t len, uint32_t* v) {
+    uint32_t x = 0;
+    for (size_t n = 0; n < len && n < 3; n++) {
+        x |= (uint32_t)(p[n] & 0x7F) << (7 * n);
+        if (!(p[n] & 0x80)) {
+            *v = x;
+            return n + 1;
+        }
+    }
+    return 0;
+}
+
+size_t density_export(density_raster_t* dr, uint8_t* buf, size_t cap) {
+    if (cap < DENSITY_EXPORT_HEADER) return 0;
+    density_advance(dr, 0);
+
+    size_t pos = DENSITY_EXPORT_HEADER;
+    uint16_t n_records = 0;
+    for (int i = 0; i < dr->n_tiles; i++) {
+        for (int layer = 0; layer < DENSITY_LAYERS; layer++) {
+            const uint16_t* px = dr->counts[i][layer];
+            int first = 0;
+            while (first < DENSITY_TILE_PIXELS && px[first] == 0) first++;
+            if (first == DENSITY_TILE_PIXELS) continue;
+
+            /* Worst case: header + 3-byte run + 3-byte count per pixel */
+            if (cap - pos < DENSITY_EXPORT_TILE + 6 * DENSITY_TILE_PIXELS + 3) {
+                return 0;
+            }
+            uint8_t* p = buf + pos;
+            p += put_u16(p, dr->tile_cell[i]);
+            *p++ = (uint8_t)layer;
+            p += put_u32(p, (uint32_t)dr->tiles[i].lat_min);
+            p += put_u32(p, (uint32_t)dr->tiles[i].lon_min);
+            p += put_u32(p, (uint32_t)(dr->tiles[i].lat_min + dr->tiles[i].lat_span));
+            p += put_u32(p, (uint32_t)(dr->tiles[i].lon_min + dr->tiles[i].lon_span));
+
+            uint32_t run = 0;
+            for (int k = 0; k < DENSITY_TILE_PIXELS; k++) {
+                if (px[k] == 0) {
+                    run++;
+                    continue;
+                }
+                p += put_varint(p, run);
+                p += put_varint(p, px[k]);
+                run = 0;
+            }
+            if (run > 0) p += put_varint(p, run);
+            pos = (size_t)(p - buf);
+            n_records++;
+        }
+    }
+
+    uint8_t* h = buf;
+    h += put_u16(h, DENSITY_EXPORT_MAGIC);
+    *h++ = DENSITY_EXPORT_VERSION;
+    *h++ = DENSITY_TILE_DIM;
+    *h++ = DENSITY_LAYERS;
+    *h++ = dr->mode;
+    h += put_u16(h, n_records);
+    h += put_u32(h, dr->window_s);
+    put_u32(h, dr->epoch);
+    return pos;
+}
+
+size_t density_decode_tile(const uint8_t* buf, size_t len, density_tile_info_t* info,
+                           uint16_t* pixels) {
+    if (len < DENSITY_EXPORT_TILE) return 0;
+    info->cell_id = (uint16_t)(buf[0] | (buf[1] << 8));
+    info->layer = buf[2];
+    info->lat_min = (fixed_t)get_u32(buf + 3);
+    info->lon_min = (fixed_t)get_u32(buf + 7);
+    info->lat_max = (fixed_t)get_u32(buf + 11);
+    info->lon_max = (fixed_t)get_u32(buf + 15);
+
+    size_t pos = DENSITY_EXPORT_TILE;
+    uint32_t k = 0;
+    while (k < DENSITY_TILE_PIXELS) {
+        uint32_t run, count;
+        size_t n = get_varint(buf + pos, len - pos, &run);
+        if (n == 0 || run > DENSITY_TILE_PIXELS - k) return 0;
+        pos += n;
+        for (uint32_t z = 0; z < run; z++) pixels[k++] = 0;
+        if (k == DENSITY_TILE_PIXELS) break;
+
+        n = get_varint(buf + pos, len - pos, &count);
+        if (n == 0 || count == 0 || count > 0xFFFF) return 0;
+        pos += n;
+        pixels[k++] = (uint16_t)count;
+    }
+    return pos;
+}
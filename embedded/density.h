@@ -0,0 +1,206 @@
+/*
+ * density.h - Streaming Traffic-Density Raster Aligned with T-BSP Cells
+ *
+ * Accumulates per-fix counts into a fixed-resolution raster at insert
+ * time, so dashboards get heatmaps without exporting every pose. Each
+ * T-BSP cell that sees traffic owns one DENSITY_TILE_DIM² tile; pixels
+ * are ~CELL_SIZE_KM / DENSITY_TILE_DIM on a side (625 m with defaults).
+ *
+ * Time handling (per raster, fixed window length W seconds):
+ *   - DENSITY_MODE_WINDOW: counts cover the current window only
+ *     (tumbling; a tile is cleared the first time it is touched in a
+ *     new window)
+ *   - DENSITY_MODE_DECAY:  counts halve once per elapsed window
+ *     (exponential decay, half-life W)
+ * Both are applied lazily per tile, so an insert never walks the raster.
+ *
+ * Layers: layer 0 counts all traffic; vessel class k (1 .. LAYERS-1)
+ * additionally counts into layer k. DENSITY_LAYERS = 1 keeps totals only.
+ *
+ * Doom Lineage:
+ *   - Doom automap (AM_drawFline into a fixed framebuffer) → fixes
+ *     plotted into a fixed raster, no per-fix storage
+ *   - Doom Z_Malloc PU_CACHE purge → least recently touched tile is
+ *     recycled when the tile pool is full
+ *
+ * Hardware Target: ESP32-S3 (~17 KB static with defaults)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#ifndef DENSITY_H
+#define DENSITY_H
+
+#include "se3_edge.h"
+#include "t_bsp.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * CONFIGURATION CONSTANTS
+ * ======================================================================== */
+
+#ifndef DENSITY_TILE_DIM
+#define DENSITY_TILE_DIM     16      /* Pixels per tile side (power of 2) */
+#endif
+
+#ifndef DENSITY_MAX_TILES
+#define DENSITY_MAX_TILES    32      /* Tiles resident at once */
+#endif
+
+#ifndef DENSITY_LAYERS
+#define DENSITY_LAYERS       1       /* Layer 0 = all; 1.. = vessel classes */
+#endif
+
+#define DENSITY_TILE_PIXELS  (DENSITY_TILE_DIM * DENSITY_TILE_DIM)
+
+_Static_assert((DENSITY_TILE_DIM & (DENSITY_TILE_DIM - 1)) == 0,
+               "DENSITY_TILE_DIM must be a power of 2");
+_Static_assert(DENSITY_LAYERS >= 1 && DENSITY_LAYERS <= 16, "1-16 layers");
+_Static_assert(DENSITY_MAX_TILES <= 65535, "tile index is uint16_t");
+
+/* Time modes */
+#define DENSITY_MODE_WINDOW  0       /* Tumbling window */
+#define DENSITY_MODE_DECAY   1       /* Halve per window */
+
+/* Export format */
+#define DENSITY_EXPORT_MAGIC   0x5244u   /* "DR" little-endian */
+#define DENSITY_EXPORT_VERSION 2
+#define DENSITY_EXPORT_HEADER  16        /* Raster header bytes */
+#define DENSITY_EXPORT_TILE    19        /* Tile record header bytes */
+
+/* ========================================================================
+ * DATA STRUCTURES
+ * ======================================================================== */
+
+/** Tile header (classifier-exact bounds cached at allocation) */
+typedef struct {
+    fixed_t lat_min, lon_min;  /**< South-west corner (fixed-point degrees) */
+    fixed_t lat_span, lon_span;  /**< Cell extent (degrees; cell -1 is ~1 km) */
+    fixed_t px_lat, px_lon;    /**< DENSITY_TILE_DIM / span (pixels per degree) */
+    uint32_t epoch;            /**< Window the counts are current for */
+    uint32_t last_touch;       /**< Window of the last insert (eviction order) */
+} density_tile_t;
+
+/**
+ * Density raster.
+ *
+ * tile_cell[] is a dense array of the resident tiles' cell IDs, scanned
+ * on insert (one cache line with defaults); counts are the cold region.
+ */
+typedef struct {
+    uint16_t tile_cell[DENSITY_MAX_TILES];
+    density_tile_t tiles[DENSITY_MAX_TILES];
+    uint16_t counts[DENSITY_MAX_TILES][DENSITY_LAYERS][DENSITY_TILE_PIXELS];
+    uint32_t window_s;         /**< Window length / half-life (s) */
+    uint32_t epoch;            /**< Latest window seen */
+    uint16_t n_tiles;
+    uint16_t last;             /**< Tile of the previous insert (hint) */
+    uint8_t mode;              /**< DENSITY_MODE_* */
+    uint8_t grid_epoch;        /**< bsp->grid_epoch tile IDs are keyed in */
+    uint8_t _padding[2];
+    uint32_t evictions;        /**< Diagnostic: tiles recycled */
+    uint32_t saturated;        /**< Diagnostic: increments clipped at 65535 */
+} density_raster_t;
+
+/** Decoded tile record (see density_export()) */
+typedef struct {
+    uint16_t cell_id;
+    uint8_t layer;
+    fixed_t lat_min, lon_min;
+    fixed_t lat_max, lon_max;  /**< Exclusive; lon_max may exceed 180° */
+} density_tile_info_t;
+
+/* ========================================================================
+ * API FUNCTIONS
+ * ======================================================================== */
+
+/**
+ * Initialize an empty raster.
+ *
+ * @param dr Raster (caller-allocated, static recommended)
+ * @param mode DENSITY_MODE_WINDOW or DENSITY_MODE_DECAY
+ * @param window_s Window length / half-life in seconds (> 0)
+ */
+void density_init(density_raster_t* dr, uint8_t mode, uint32_t window_s);
+
+/**
+ * Count one fix. Call alongside t_bsp_insert_pose() with the same cell ID.
+ *
+ * Allocates the cell's tile on first use (recycling the least recently
+ * touched tile when the pool is full) and re-keys tiles after a grid
+ * re-center.
+ *
+ * @param dr Raster
+ * @param bsp Grid the cell ID was computed in
+ * @param cell_id Cell of the fix (t_bsp_latlon_to_cell)
+ * @param lat Fix latitude (fixed-point degrees)
+ * @param lon Fix longitude (fixed-point degrees)
+ * @param timestamp Fix time (s)
+ * @param vessel_class Class layer (0 = none; >= DENSITY_LAYERS counts in layer 0 only)
+ * @return Tile index, or -1 if the fix predates the raster's current window
+ */
+int density_add(density_raster_t* dr, t_bsp_t* bsp, uint16_t cell_id,
+                fixed_t lat, fixed_t lon, uint32_t timestamp, uint8_t vessel_class);
+
+/**
+ * Count at a tile pixel (after applying pending decay / window expiry).
+ *
+ * @param dr Raster
+ * @param cell_id Cell
+ * @param layer Layer
+ * @param row Pixel row (0 = south)
+ * @param col Pixel column (0 = west)
+ * @return Count (0 if the cell has no tile)
+ */
+uint16_t density_get(density_raster_t* dr, uint16_t cell_id, uint8_t layer, int row, int col);
+
+/**
+ * Bring every tile up to the latest window (decay / expiry).
+ *
+ * @param dr Raster
+ * @param timestamp Current time (advances the raster's window if newer)
+ */
+void density_advance(density_raster_t* dr, uint32_t timestamp);
+
+/**
+ * Export non-empty tiles in the compact format.
+ *
+ * Layout (little-endian):
+ *   header: magic u16, version u8, dim u8, layers u8, mode u8,
+ *           n_records u16, window_s u32, epoch u32
+ *   record: cell_id u16, layer u8, lat_min i32, lon_min i32, lat_max i32,
+ *           lon_max i32 (exact cell bounds, t_bsp_get_cell_edges()), then
+ *           (zero-run varint, count varint) pairs in row-major order until
+ *           DENSITY_TILE_PIXELS pixels are covered (trailing zeros emit
+ *           only the run)
+ *
+ * @param dr Raster (tiles are brought up to date first)
+ * @param buf Output buffer
+ * @param cap Buffer capacity
+ * @return Bytes written, or 0 if cap is too small
+ */
+size_t density_export(density_raster_t* dr, uint8_t* buf, size_t cap);
+
+/**
+ * Decode one tile record of an export.
+ *
+ * @param buf Record start (after the header, or the previous record's end)
+ * @param len Bytes available
+ * @param info Output: tile identity
+ * @param pixels Output: DENSITY_TILE_PIXELS counts
+ * @return Bytes consumed, or 0 if the record is truncated or malformed
+ */
+size_t density_decode_tile(const uint8_t* buf, size_t len, density_tile_info_t* info,
+                           uint16_t* pixels);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DENSITY_H */
@@ -0,0 +1,153 @@
+/*
+ * dlt_record.c - Compact DLT Record Encoding (v2) Implementation
+ *
+ * Reference: id-Software/DOOM linuxdoom-1.10/w_wad.c (W_CheckNumForName)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "dlt_record.h"
+#include <string.h>
+
+/* ========================================================================
+ * ENCODING HELPERS
+ * ======================================================================== */
+
+static inline uint64_t zigzag(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static inline int64_t unzigzag(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+static inline uint8_t* put_varint(uint8_t* p, uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+/** Bounded reader over an encoded record */
+typedef struct {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool ok;
+} reader_t;
+
+static uint64_t get_varint(reader_t* r) {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (r->p >= r->end) break;
+        uint8_t b = *r->p++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    r->ok = false;
+    return 0;
+}
+
+static void get_bytes(reader_t* r, void* out, size_t n) {
+    if ((size_t)(r->end - r->p) < n) {
+        r->ok = false;
+        return;
+    }
+    memcpy(out, r->p, n);
+    r->p += n;
+}
+
+static bool all_zero(const uint8_t* p, size_t n) {
+    uint8_t acc = 0;
+    for (size_t i = 0; i < n; i++) acc |= p[i];
+    return acc == 0;
+}
+
+/* ========================================================================
+ * DATASET TABLE
+ * ======================================================================== */
+
+void dlt_dataset_table_init(dlt_dataset_table_t* t) {
+    t->count = 0;
+}
+
+int dlt_dataset_intern(dlt_dataset_table_t* t, const char name[DLT_DATASET_LEN]) {
+    for (int i = 0; i < t->count; i++) {
+        if (memcmp(t->names[i], name, DLT_DATASET_LEN) == 0) return i;
+    }
+    if (t->count == DLT_MAX_DATASETS) return DLT_ERR_DATASET;
+    memcpy(t->names[t->count], name, DLT_DATASET_LEN);
+    return t->count++;
+}
+
+const char* dlt_dataset_name(const dlt_dataset_table_t* t, uint32_t id) {
+    return id < t->count ? t->names[id] : NULL;
+}
+
+/* ========================================================================
+ * RECORD CODEC
+ * ======================================================================== */
+
+int dlt_record_v2_encode(const dlt_record_t* r, dlt_dataset_table_t* t, uint8_t* out) {
+    int id = dlt_dataset_intern(t, r->dataset);
+    if (id < 0) return id;
+
+    uint8_t flags = 0;
+    if (!all_zero(r->trajectory_hash, sizeof(r->trajectory_hash))) flags |= DLT_V2_F_HASH;
+    if (!all_zero(r->signature, sizeof(r->signature))) flags |= DLT_V2_F_SIG;
+
+    uint8_t* p = out;
+    *p++ = (uint8_t)((DLT_V2_VERSION << 4) | flags);
+    p = put_varint(p, (uint64_t)id);
+    p = put_varint(p, r->mmsi);
+    p = put_varint(p, r->cell_id);
+    p = put_varint(p, zigzag(r->lambda_optimal));
+    p = put_varint(p, zigzag(r->return_error));
+    p = put_varint(p, zigzag((int64_t)r->timestamp - DLT_V2_EPOCH));
+    if (flags & DLT_V2_F_HASH) {
+        memcpy(p, r->trajectory_hash, sizeof(r->trajectory_hash));
+        p += sizeof(r->trajectory_hash);
+    }
+    if (flags & DLT_V2_F_SIG) {
+        memcpy(p, r->signature, sizeof(r->signature));
+        p += sizeof(r->signature);
+    }
+    return (int)(p - out);
+}
+
+int dlt_record_v2_decode(const uint8_t* in, size_t len, const dlt_dataset_table_t* t,
+                         dlt_record_t* r) {
+    if (len == 0) return DLT_ERR_FORMAT;
+    if ((in[0] >> 4) != DLT_V2_VERSION) return DLT_ERR_VERSION;
+    uint8_t flags = in[0] & 0x0F;
+    if (flags & ~(DLT_V2_F_HASH | DLT_V2_F_SIG)) return DLT_ERR_FORMAT;
+
+    reader_t rd = { in + 1, in + len, true };
+    uint64_t id = get_varint(&rd);
+    uint64_t mmsi = get_varint(&rd);
+    uint64_t cell = get_varint(&rd);
+    int64_t lambda = unzigzag(get_varint(&rd));
+    int64_t err = unzigzag(get_varint(&rd));
+    int64_t time = unzigzag(get_varint(&rd)) + DLT_V2_EPOCH;
+    if (!rd.ok || mmsi > UINT32_MAX || cell > UINT16_MAX || lambda < INT32_MIN ||
+        lambda > INT32_MAX || err < INT32_MIN || err > INT32_MAX || time < 0 ||
+        time > UINT32_MAX) {
+        return DLT_ERR_FORMAT;
+    }
+    const char* name = id <= UINT32_MAX ? dlt_dataset_name(t, (uint32_t)id) : NULL;
+    if (!name) return DLT_ERR_DATASET;
+
+    memset(r, 0, sizeof(*r));
+    if (flags & DLT_V2_F_HASH) get_bytes(&rd, r->trajectory_hash, sizeof(r->trajectory_hash));
+    if (flags & DLT_V2_F_SIG) get_bytes(&rd, r->signature, sizeof(r->signature));
+    if (!rd.ok) return DLT_ERR_FORMAT;
+
+    memcpy(r->dataset, name, DLT_DATASET_LEN);
+    r->mmsi = (uint32_t)mmsi;
+    r->cell_id = (uint16_t)cell;
+    r->lambda_optimal = (fixed_t)lambda;
+    r->return_error = (fixed_t)err;
+    r->timestamp = (uint32_t)time;
+    return (int)(rd.p - in);
+}
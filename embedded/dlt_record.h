@@ -0,0 +1,140 @@
+/*
+ * dlt_record.h - Compact DLT Record Encoding (v2) with Interned Datasets
+ *
+ * dlt_record_t is 148 bytes in memory: a 32-byte dataset name repeated in
+ * every record, two bytes of padding, and fixed-width fields whose values
+ * rarely need their width. The v2 wire form carries the same information
+ * in ~115 bytes signed and ~50 bytes unsigned:
+ *
+ *   head     u8       version (bits 7-4) | DLT_V2_F_* flags (bits 3-0)
+ *   dataset  varint   interned ID (dlt_dataset_table_t)
+ *   mmsi     varint
+ *   cell_id  varint
+ *   lambda   zigzag varint (16.16)
+ *   error    zigzag varint (16.16)
+ *   time     zigzag varint, seconds from DLT_V2_EPOCH
+ *   hash     32 bytes, only with DLT_V2_F_HASH (omitted when all zero)
+ *   sig      64 bytes, only with DLT_V2_F_SIG (omitted when all zero,
+ *            i.e. not yet signed)
+ *
+ * Decoding restores the record byte for byte (the padding is zero). The
+ * signature and trajectory hash cover the logical record, not its encoding,
+ * so v1 and v2 forms of one record verify alike.
+ *
+ * Dataset IDs are assigned in intern order. Publisher and reader agree on
+ * them by building their tables from the same list (the channel's dataset
+ * announcement); an unknown ID is DLT_ERR_DATASET, never a guess.
+ *
+ * Doom Lineage:
+ *   - Doom's lump name table (W_GetNumForName: 8-byte names looked up
+ *     once, then referred to by lump number everywhere) → 32-byte dataset
+ *     names interned once, referred to by a one-byte ID in every record
+ *
+ * Hardware Target: ESP32-S3 (table 514 bytes with defaults, no heap)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#ifndef DLT_RECORD_H
+#define DLT_RECORD_H
+
+#include "se3_edge.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * CONFIGURATION CONSTANTS
+ * ======================================================================== */
+
+#ifndef DLT_MAX_DATASETS
+#define DLT_MAX_DATASETS     16      /* Interned dataset names */
+#endif
+
+#define DLT_DATASET_LEN      32      /* sizeof(dlt_record_t.dataset) */
+#define DLT_V2_VERSION       2
+#define DLT_V2_EPOCH         1704067200u  /* 2024-01-01T00:00:00Z */
+
+/* Worst case: head, dataset 3, mmsi 5, cell 3, lambda 5, error 5, time 5 */
+#define DLT_V2_MAX_BYTES     (1 + 3 + 5 + 3 + 5 + 5 + 5 + 32 + 64)
+
+/* Flags (head bits 3-0) */
+#define DLT_V2_F_HASH        0x01    /* trajectory_hash present */
+#define DLT_V2_F_SIG         0x02    /* signature present */
+
+_Static_assert(DLT_MAX_DATASETS <= 65535, "table count is uint16_t");
+_Static_assert(sizeof(((dlt_record_t*)0)->dataset) == DLT_DATASET_LEN, "dataset name width");
+
+/* Results */
+#define DLT_OK               0
+#define DLT_ERR_FORMAT      -1       /* Truncated or malformed encoding */
+#define DLT_ERR_VERSION     -2
+#define DLT_ERR_DATASET     -3       /* Table full (encode) / unknown ID (decode) */
+
+/* ========================================================================
+ * DATA STRUCTURES
+ * ======================================================================== */
+
+/** Interned dataset names; ID = index */
+typedef struct {
+    char names[DLT_MAX_DATASETS][DLT_DATASET_LEN];
+    uint16_t count;
+} dlt_dataset_table_t;
+
+/* ========================================================================
+ * API FUNCTIONS
+ * ======================================================================== */
+
+/**
+ * Empty the table.
+ */
+void dlt_dataset_table_init(dlt_dataset_table_t* t);
+
+/**
+ * Look up a dataset name, adding it if new.
+ *
+ * @param t Table
+ * @param name Name field (all DLT_DATASET_LEN bytes compared, so trailing
+ *             bytes after the terminator must be zero to match)
+ * @return ID (0 to DLT_MAX_DATASETS-1), or DLT_ERR_DATASET if the table is full
+ */
+int dlt_dataset_intern(dlt_dataset_table_t* t, const char name[DLT_DATASET_LEN]);
+
+/**
+ * Name for an ID.
+ *
+ * @return DLT_DATASET_LEN-byte name field, or NULL if the ID is unknown
+ */
+const char* dlt_dataset_name(const dlt_dataset_table_t* t, uint32_t id);
+
+/**
+ * Encode a record in the v2 form, interning its dataset.
+ *
+ * @param r Record
+ * @param t Dataset table (may gain an entry)
+ * @param out Output, at least DLT_V2_MAX_BYTES
+ * @return Encoded length, or DLT_ERR_DATASET if the table is full
+ */
+int dlt_record_v2_encode(const dlt_record_t* r, dlt_dataset_table_t* t, uint8_t* out);
+
+/**
+ * Decode one v2 record.
+ *
+ * @param in Encoded bytes
+ * @param len Bytes available (may hold further records)
+ * @param t Dataset table
+ * @param r Output record (fully written on success)
+ * @return Bytes consumed, or DLT_ERR_*
+ */
+int dlt_record_v2_decode(const uint8_t* in, size_t len, const dlt_dataset_table_t* t,
+                         dlt_record_t* r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DLT_RECORD_H */
@@ -0,0 +1,316 @@
+/*
+ * geodesic.c - FPU-Free Geodesic Distance and Bearing Implementation
+ *
+ * Short range: equirectangular with the ellipsoid's meridional (M) and
+ * prime-vertical (N) radii at the mid-latitude. Long range: haversine on
+ * the auxiliary sphere of reduced latitudes, then Lambert's first-order
+ * flattening correction. All 32/64-bit integer arithmetic.
+ *
+ * Reference: id-Software/DOOM linuxdoom-1.10/p_maputl.c (P_AproxDistance)
+ *            Lambert, "The distance between two widely separated points on
+ *            the surface of the earth", J. Washington Acad. Sci. 32 (1942)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "geodesic.h"
+
+/* ========================================================================
+ * INTERNAL CONSTANTS
+ * ======================================================================== */
+
+#define Q30_ONE             (1LL << 30)
+#define PI_Q30              3373259426LL    /* π × 2^30 */
+#define HALF_PI_Q30         1686629713LL    /* π/2 × 2^30 */
+#define RAD_TO_ANGLE        683565276LL     /* 2^32 / 2π */
+
+/* WGS84 */
+#define WGS84_E2_Q30        7188036LL       /* e² = f(2 - f) */
+#define WGS84_1ME2_Q30      1066553788LL    /* 1 - e² */
+#define WGS84_F_Q30         3600053LL       /* f = 1/298.257223563 */
+#define WGS84_HALF_F_Q30    1800027LL       /* f / 2 */
+
+/* a · π/180 / 65536: meters per 16.16 degree LSB on the equator, Q24 */
+#define METERS_PER_LSB_Q24  28497790LL
+
+/* Reduced latitude series β = φ - n·sin2φ + (n²/2)·sin4φ, n = f/(2 - f),
+ * coefficients in 32-bit angle units (n³ term is ~1 cm) */
+#define BETA_C1_ANGLE       1147857LL
+#define BETA_C2_ANGLE       964LL
+
+/* Largest Q8 equirectangular component squared without overflow */
+#define EQ_Q8_LIMIT         (1LL << 30)
+
+/* Widest longitude span for the flat path: near the poles a short hop can
+ * cross many meridians, and the flat error grows with (Δλ·sinφ)² */
+#define EQ_MAX_DLON         INT_TO_FIXED(2)
+
+/* ========================================================================
+ * INTERNAL HELPERS
+ * ======================================================================== */
+
+static inline int64_t abs64(int64_t v) {
+    return v < 0 ? -v : v;
+}
+
+/**
+ * Reduced latitude β (32-bit angle) and its Q30 sine/cosine.
+ *
+ * The series correction is at most 0.1°, so its sin2φ/sin4φ come from the
+ * interpolated LUT (~20 cm worst case); only β itself needs Q30 trig.
+ */
+static inline void reduced_latitude(fixed_t lat, uint32_t* beta, int32_t* sb, int32_t* cb) {
+    uint32_t phi = degrees_to_angle(lat);
+    int64_t s2 = Sin_from_LUT_interp(phi << 1);
+    int64_t s4 = Sin_from_LUT_interp(phi << 2);
+    int64_t corr = ((BETA_C1_ANGLE * s2) >> 16) - ((BETA_C2_ANGLE * s4) >> 16);
+    *beta = phi - (uint32_t)(int32_t)corr;
+    geo_sincos_q30(*beta, sb, cb);
+}
+
+/**
+ * Equirectangular displacement 1 → 2 in Q8 meters (east, north).
+ *
+ * @param sin_mid Output: sine of the mid-latitude (16.16), for the
+ *                meridian-convergence bearing correction
+ */
+static inline void equirect_q8(fixed_t lat1, fixed_t lon1, fixed_t lat2, fixed_t lon2,
+                               int64_t* east, int64_t* north, fixed_t* sin_mid) {
+    fixed_t dlat = lat2 - lat1;
+    fixed_t dlon = normalize_lon(lon2 - lon1);
+    uint32_t mid = degrees_to_angle((fixed_t)(((int64_t)lat1 + lat2) >> 1));
+    fixed_t s = Sin_from_LUT_interp(mid);
+    fixed_t c = Cos_from_LUT_interp(mid);
+
+    /* w = e²·sin²φ; N = a(1 + w/2 + 3w²/8), M = a(1 - e²)(1 + 3w/2 + 15w²/8) */
+    int64_t s2 = ((int64_t)s * s) >> 2;                         /* Q30 */
+    int64_t w = (WGS84_E2_Q30 * s2) >> 30;
+    int64_t w2 = (w * w) >> 30;
+    int64_t kn = Q30_ONE + (w >> 1) + ((3 * w2) >> 3);
+    int64_t km = (WGS84_1ME2_Q30 * (Q30_ONE + ((3 * w) >> 1) + ((15 * w2) >> 3))) >> 30;
+
+    int64_t m_lsb = (METERS_PER_LSB_Q24 * km) >> 30;            /* Q24 m per LSB */
+    int64_t n_lsb = (((METERS_PER_LSB_Q24 * kn) >> 30) * c) >> 16;
+
+    *north = ((int64_t)dlat * m_lsb) >> 16;
+    *east = ((int64_t)dlon * n_lsb) >> 16;
+    *sin_mid = s;
+}
+
+/**
+ * Distance (m) and bearing of an equirectangular displacement.
+ */
+static uint32_t equirect_finish(fixed_t dlon, int64_t east, int64_t north, fixed_t sin_mid,
+                                uint32_t* bearing) {
+    uint64_t d;
+    if (abs64(east) < EQ_Q8_LIMIT && abs64(north) < EQ_Q8_LIMIT) {
+        d = ((uint64_t)isqrt64((uint64_t)(east * east + north * north)) + 128) >> 8;
+    } else {
+        int64_t e = east >> 8, n = north >> 8;
+        d = isqrt64((uint64_t)(e * e + n * n));
+    }
+
+    if (bearing) {
+        while (abs64(east) > INT32_MAX || abs64(north) > INT32_MAX) {
+            east >>= 1;
+            north >>= 1;
+        }
+        /* Mid-point azimuth → initial azimuth: meridians converge by
+         * Δλ·sinφ across the span, half of it before the midpoint */
+        int32_t dlon_ang = (int32_t)degrees_to_angle(dlon);
+        int32_t conv = (int32_t)(((int64_t)dlon_ang * sin_mid) >> 17);
+        *bearing = fixed_atan2((fixed_t)east, (fixed_t)north) - (uint32_t)conv;
+    }
+    return d > UINT32_MAX ? UINT32_MAX : (uint32_t)d;
+}
+
+/**
+ * Whether the flat path is accurate for this displacement (else haversine).
+ */
+static inline bool use_equirect(fixed_t dlon, int64_t east, int64_t north) {
+    fixed_t adlon = fixed_abs(normalize_lon(dlon));
+    return adlon < EQ_MAX_DLON && abs64(east) < EQ_Q8_LIMIT && abs64(north) < EQ_Q8_LIMIT &&
+           east * east + north * north < (int64_t)GEO_SHORT_RANGE_M * GEO_SHORT_RANGE_M * 65536;
+}
+
+/**
+ * Haversine + Lambert on prepared reduced latitudes.
+ *
+ * @param dl Longitude difference 2 - 1 (32-bit angle, wrapping)
+ */
+static uint32_t haversine_prepared(uint32_t b1, int32_t sb1, int32_t cb1,
+                                   uint32_t b2, int32_t sb2, int32_t cb2,
+                                   uint32_t dl, uint32_t* bearing) {
+    /* hav σ = sin²(Δβ/2) + cosβ1·cosβ2·sin²(Δλ/2), Q60 */
+    int32_t shb, chb, shl, chl;
+    geo_sincos_q30((uint32_t)((int32_t)(b2 - b1) >> 1), &shb, &chb);
+    geo_sincos_q30((uint32_t)((int32_t)dl >> 1), &shl, &chl);
+    /* cosβ·sin(Δλ/2) per point before multiplying: cosβ1·cosβ2 alone
+     * underflows Q30 within ~0.1° of a pole */
+    int64_t u1 = ((int64_t)cb1 * shl) >> 30;
+    int64_t u2 = ((int64_t)cb2 * shl) >> 30;
+    uint64_t h = (uint64_t)((int64_t)shb * shb) + (uint64_t)(u1 * u2);
+    if (h > (uint64_t)1 << 60) h = (uint64_t)1 << 60;
+    /* 1 - h = cos²(Δβ/2) - cosβ1·cosβ2·sin²(Δλ/2): small terms stay exact
+     * near the antipode, where 1 - h itself would cancel */
+    int64_t hc = (int64_t)chb * chb - u1 * u2;
+    if (hc < 0) hc = 0;
+
+    /* σ/2 = atan2(√h, √(1 - h)), refined by one Newton step in Q30 */
+    int64_t sh = isqrt64(h);
+    int64_t ch = isqrt64((uint64_t)hc);
+    uint32_t half = fixed_atan2((fixed_t)sh, (fixed_t)ch);
+    int32_t st, ct;
+    geo_sincos_q30(half, &st, &ct);
+    int64_t resid = (sh * ct - ch * st) >> 30;                  /* sin(θ - θ̂), rad Q30 */
+    half += (uint32_t)(int32_t)((resid * RAD_TO_ANGLE) >> 30);
+
+    int64_t sigma = ((int64_t)half * PI_Q30) >> 30;             /* rad Q30 */
+    int64_t sin_sigma = (sh * ch) >> 29;
+
+    /* Lambert: X = (σ - sinσ)·sin²P·cos²Q / cos²(σ/2),
+     *          Y = (σ + sinσ)·cos²P·sin²Q / sin²(σ/2),
+     *          d = a·(σ - f/2·(X + Y)), P = (β1 + β2)/2, Q = (β2 - β1)/2 */
+    /* P = β1 + Q by the angle-sum identities, Q = Δβ/2 from above */
+    int64_t sp = (((int64_t)sb1 * chb) + ((int64_t)cb1 * shb)) >> 30;
+    int64_t cp = (((int64_t)cb1 * chb) - ((int64_t)sb1 * shb)) >> 30;
+    int64_t sp2 = (sp * sp) >> 30, cp2 = (cp * cp) >> 30;
+    int64_t cq2 = ((int64_t)chb * chb) >> 30;
+    int64_t c2h = hc >> 30;
+    if (c2h < 1024) c2h = 1024;                                 /* Near-antipodal */
+    int64_t x = ((((sigma - sin_sigma) * sp2) >> 30) * cq2) >> 30;
+    x = (x << 30) / c2h;
+
+    /* sin²Q / sin²(σ/2) ∈ [0, 1] from the Q60 terms, normalized so short
+     * ranges keep 32 significant bits */
+    int64_t y = 0;
+    if (h != 0) {
+        int z = __builtin_clzll(h) - 1;
+        uint64_t ratio = ((uint64_t)((int64_t)shb * shb) << z) / ((h << z) >> 30);
+        y = ((((sigma + sin_sigma) * cp2) >> 30) * (int64_t)ratio) >> 30;
+    }
+    int64_t s = sigma - ((WGS84_HALF_F_Q30 * (x + y)) >> 30);
+    if (s < 0) s = 0;
+
+    if (bearing) {
+        /* Longitude on the auxiliary sphere runs ahead of the ellipsoid's:
+         * ω ≈ Δλ + f·sinα0·σ, sinα0 = cosβ1·cosβ2·sinΔλ / sinσ (Vincenty's
+         * first iterate, without the C terms) */
+        int64_t den = (sh * ch) >> 30;
+        int64_t sin_a0 = 0;
+        if (den > 0) {
+            sin_a0 = ((u1 * (((int64_t)cb2 * chl) >> 30)) >> 30 << 30) / den;
+            if (sin_a0 > Q30_ONE) sin_a0 = Q30_ONE;
+            if (sin_a0 < -Q30_ONE) sin_a0 = -Q30_ONE;
+        }
+        int64_t domega = ((((WGS84_F_Q30 * sin_a0) >> 30) * sigma) >> 30) * RAD_TO_ANGLE >> 30;
+
+        /* Azimuth: atan2(cosβ2·sinω, cosβ1·sinβ2 - sinβ1·cosβ2·cosω), halved to fit */
+        int32_t so, co;
+        geo_sincos_q30(dl + (uint32_t)(int32_t)domega, &so, &co);
+        int64_t ye = ((int64_t)cb2 * so) >> 31;
+        int64_t xn = (((int64_t)cb1 * sb2) >> 31) - (((((int64_t)sb1 * cb2) >> 30) * co) >> 31);
+        *bearing = fixed_atan2((fixed_t)ye, (fixed_t)xn);
+    }
+    return (uint32_t)((GEO_WGS84_A_M * s + (1LL << 29)) >> 30);
+}
+
+/* ========================================================================
+ * API FUNCTIONS
+ * ======================================================================== */
+
+void geo_sincos_q30(uint32_t angle, int32_t* s, int32_t* c) {
+    uint32_t quadrant = angle >> 30;
+    uint32_t r = angle & 0x3FFFFFFFu;
+    bool swap = r > 0x20000000u;                /* Reduce to [0, 45°] */
+    if (swap) r = 0x40000000u - r;
+
+    int64_t x = ((int64_t)r * HALF_PI_Q30) >> 30;               /* rad Q30 ≤ π/4 */
+    int64_t x2 = (x * x) >> 30;
+
+    /* Taylor series in Horner form, Q30 coefficients: sin to x^9, cos to
+     * x^10 (truncation < 2e-9 at π/4) */
+    int64_t t = 2959;                                           /*  1/9!  */
+    t = -213044 + ((x2 * t) >> 30);                             /* -1/7!  */
+    t = 8947849 + ((x2 * t) >> 30);                             /*  1/5!  */
+    t = -178956971 + ((x2 * t) >> 30);                          /* -1/3!  */
+    int64_t sn = x + ((((x2 * t) >> 30) * x) >> 30);
+
+    t = -296;                                                   /* -1/10! */
+    t = 26630 + ((x2 * t) >> 30);                               /*  1/8!  */
+    t = -1491308 + ((x2 * t) >> 30);                            /* -1/6!  */
+    t = 44739243 + ((x2 * t) >> 30);                            /*  1/4!  */
+    t = -536870912 + ((x2 * t) >> 30);                          /* -1/2!  */
+    int64_t cs = Q30_ONE + ((x2 * t) >> 30);
+
+    /* Octant and quadrant fix-up as selects, not branches: the angle is
+     * data, and a mispredict costs more than the polynomial */
+    int64_t s1 = swap ? cs : sn;
+    int64_t c1 = swap ? sn : cs;
+    int64_t s2 = (quadrant & 1) ? c1 : s1;
+    int64_t c2 = (quadrant & 1) ? -s1 : c1;
+    int64_t neg = -(int64_t)((quadrant >> 1) & 1);
+    *s = (int32_t)((s2 ^ neg) - neg);
+    *c = (int32_t)((c2 ^ neg) - neg);
+}
+
+uint32_t geo_distance_equirect(fixed_t lat1, fixed_t lon1, fixed_t lat2, fixed_t lon2,
+                               uint32_t* bearing) {
+    int64_t east, north;
+    fixed_t sin_mid;
+    equirect_q8(lat1, lon1, lat2, lon2, &east, &north, &sin_mid);
+    return equirect_finish(normalize_lon(lon2 - lon1), east, north, sin_mid, bearing);
+}
+
+uint32_t geo_distance_haversine(fixed_t lat1, fixed_t lon1, fixed_t lat2, fixed_t lon2,
+                                uint32_t* bearing) {
+    uint32_t b1, b2;
+    int32_t sb1, cb1, sb2, cb2;
+    reduced_latitude(lat1, &b1, &sb1, &cb1);
+    reduced_latitude(lat2, &b2, &sb2, &cb2);
+    uint32_t dl = degrees_to_angle(lon2) - degrees_to_angle(lon1);
+    return haversine_prepared(b1, sb1, cb1, b2, sb2, cb2, dl, bearing);
+}
+
+uint32_t geo_distance(fixed_t lat1, fixed_t lon1, fixed_t lat2, fixed_t lon2,
+                      uint32_t* bearing) {
+    int64_t east, north;
+    fixed_t sin_mid;
+    equirect_q8(lat1, lon1, lat2, lon2, &east, &north, &sin_mid);
+    if (use_equirect(lon2 - lon1, east, north)) {
+        return equirect_finish(normalize_lon(lon2 - lon1), east, north, sin_mid, bearing);
+    }
+    return geo_distance_haversine(lat1, lon1, lat2, lon2, bearing);
+}
+
+void geo_distance_batch(const fixed_t* lat1, const fixed_t* lon1,
+                        const fixed_t* lat2, const fixed_t* lon2, int n,
+                        uint32_t* dist, uint32_t* bearing) {
+    for (int i = 0; i < n; i++) {
+        dist[i] = geo_distance(lat1[i], lon1[i], lat2[i], lon2[i], bearing ? &bearing[i] : NULL);
+    }
+}
+
+void geo_distance_from(fixed_t lat0, fixed_t lon0, const fixed_t* lat, const fixed_t* lon,
+                       int n, uint32_t* dist, uint32_t* bearing) {
+    /* Origin's reduced latitude and angle, computed once */
+    uint32_t b0;
+    int32_t sb0, cb0;
+    reduced_latitude(lat0, &b0, &sb0, &cb0);
+    uint32_t l0 = degrees_to_angle(lon0);
+
+    for (int i = 0; i < n; i++) {
+        uint32_t* brg = bearing ? &bearing[i] : NULL;
+        int64_t east, north;
+        fixed_t sin_mid;
+        equirect_q8(lat0, lon0, lat[i], lon[i], &east, &north, &sin_mid);
+        if (use_equirect(lon[i] - lon0, east, north)) {
+            dist[i] = equirect_finish(normalize_lon(lon[i] - lon0), east, north, sin_mid, brg);
+            continue;
+        }
+        uint32_t b;
+        int32_t sb, cb;
+        reduced_latitude(lat[i], &b, &sb, &cb);
+        dist[i] = haversine_prepared(b0, sb0, cb0, b, sb, cb, degrees_to_angle(lon[i]) - l0, brg);
+    }
+}
@@ -0,0 +1,136 @@
+/*
+ * geodesic.h - FPU-Free Geodesic Distance and Bearing on WGS84
+ *
+ * ENU deltas (handoff_should_trigger) and equatorial degree scaling
+ * (t_bsp_latlon_to_cell) are only right near the grid origin: they drift
+ * over long baselines and overstate east-west distance at high latitude.
+ * These kernels give ellipsoidal distance and initial bearing between two
+ * fixed-point lat/lon positions, integer-only:
+ *
+ *   Short range (< GEO_SHORT_RANGE_M, |Δλ| < 2°): equirectangular on the
+ *     ellipsoid. Meridional and prime-vertical radii at the mid-latitude,
+ *     scale from the interpolated sine LUT, one isqrt64. Within ~2 m.
+ *   Long range: haversine on the auxiliary sphere (reduced latitudes),
+ *     with Lambert's flattening correction for distance. Trig is a Q30
+ *     polynomial (geo_sincos_q30): the LUT's 16.16 entries alone would
+ *     limit a 5,000 km haversine to ~±100 m. Within ~2 m + 4 ppm, except
+ *     close to antipodal, where Lambert's formula itself breaks down.
+ *
+ * geo_distance() picks the path from the equirectangular estimate. The
+ * batch forms run the same kernels over SoA arrays; geo_distance_from()
+ * also hoists the origin's reduced latitude out of the loop.
+ *
+ * Bearings are compass angles (0 = North, 0x40000000 = East), the initial
+ * azimuth of the geodesic at point 1 (within ~0.01° beyond 1 km). Error
+ * tables vs. double-precision Vincenty: tests/geodesic_bench.c.
+ *
+ * Doom Lineage:
+ *   - Doom P_AproxDistance (cheap octagonal |dx|+|dy|-min/2 for AI and
+ *     sound ranges) and R_PointToAngle (tantoangle[] LUT) → a cheap flat
+ *     path for short ranges, exact-enough trig only when it matters
+ *
+ * Hardware Target: ESP32-S3 (no tables beyond finesine, no FPU)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#ifndef GEODESIC_H
+#define GEODESIC_H
+
+#include "se3_edge.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * CONFIGURATION CONSTANTS
+ * ======================================================================== */
+
+/**
+ * Equirectangular / haversine crossover (meters). The flat path is ~3×
+ * faster; its error passes 2 m at high latitude around 15 km and grows as
+ * d³, while the long path stays at its ~0.7 m rounding floor.
+ */
+#ifndef GEO_SHORT_RANGE_M
+#define GEO_SHORT_RANGE_M      10000
+#endif
+
+/* WGS84 */
+#define GEO_WGS84_A_M          6378137
+
+/* ========================================================================
+ * API FUNCTIONS
+ * ======================================================================== */
+
+/**
+ * Sine and cosine of a 32-bit angle in Q30 (|error| < 4e-9).
+ *
+ * Octant reduction and Taylor polynomials in 64-bit integers; use where
+ * the finesine LUT's 1.5e-5 resolution is too coarse.
+ *
+ * @param angle 32-bit angle (0x40000000 = 90°)
+ * @param s Output: sin(angle) × 2^30
+ * @param c Output: cos(angle) × 2^30
+ */
+void geo_sincos_q30(uint32_t angle, int32_t* s, int32_t* c);
+
+/**
+ * Equirectangular distance on the ellipsoid (short-range kernel).
+ *
+ * @param lat1 Latitude of point 1 (fixed-point degrees)
+ * @param lon1 Longitude of point 1 (fixed-point degrees, any wrap)
+ * @param lat2 Latitude of point 2
+ * @param lon2 Longitude of point 2
+ * @param bearing Output: compass bearing 1 → 2 (may be NULL)
+ * @return Distance in meters (saturates at UINT32_MAX)
+ */
+uint32_t geo_distance_equirect(fixed_t lat1, fixed_t lon1, fixed_t lat2, fixed_t lon2,
+                               uint32_t* bearing);
+
+/**
+ * Haversine distance with Lambert's ellipsoid correction (long-range kernel).
+ *
+ * @param lat1 Latitude of point 1 (fixed-point degrees)
+ * @param lon1 Longitude of point 1
+ * @param lat2 Latitude of point 2
+ * @param lon2 Longitude of point 2
+ * @param bearing Output: initial compass bearing 1 → 2 (may be NULL)
+ * @return Distance in meters
+ */
+uint32_t geo_distance_haversine(fixed_t lat1, fixed_t lon1, fixed_t lat2, fixed_t lon2,
+                                uint32_t* bearing);
+
+/**
+ * Distance and bearing, choosing the kernel by range.
+ *
+ * @return Distance in meters
+ */
+uint32_t geo_distance(fixed_t lat1, fixed_t lon1, fixed_t lat2, fixed_t lon2,
+                      uint32_t* bearing);
+
+/**
+ * Pairwise batch: dist[i] = geo_distance(lat1[i], lon1[i], lat2[i], lon2[i]).
+ *
+ * @param bearing Output array (may be NULL)
+ */
+void geo_distance_batch(const fixed_t* lat1, const fixed_t* lon1,
+                        const fixed_t* lat2, const fixed_t* lon2, int n,
+                        uint32_t* dist, uint32_t* bearing);
+
+/**
+ * One-to-many batch: distances and bearings from one origin (fan-out
+ * screening, range rings, track lengths from a reference).
+ *
+ * @param bearing Output array (may be NULL)
+ */
+void geo_distance_from(fixed_t lat0, fixed_t lon0, const fixed_t* lat, const fixed_t* lon,
+                       int n, uint32_t* dist, uint32_t* bearing);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GEODESIC_H */
@@ -0,0 +1,355 @@
+/*
+ * geofence.c - Geofence Engine Implementation
+ *
+ * Load → build (bin fences into cells) → evaluate fixes. Per fix the work
+ * is one cell ID, one hash probe, and for each fence in the cell a bbox
+ * reject followed (rarely) by the crossing-number test.
+ *
+ * Reference: id-Software/DOOM linuxdoom-1.10/p_maputl.c (blockmap iterators)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "geofence.h"
+#include <string.h>
+
+/* ========================================================================
+ * INTERNAL HELPERS
+ * ======================================================================== */
+
+static inline uint32_t bin_hash(uint16_t cell_id) {
+    return ((uint32_t)cell_id * 40503u) & (GEOFENCE_BIN_SLOTS - 1);
+}
+
+/**
+ * Find the bin for a cell (NULL if no fence overlaps it).
+ */
+static inline const geofence_bin_t* find_bin(const geofence_set_t* gs, uint16_t cell_id) {
+    uint32_t slot = bin_hash(cell_id);
+    for (uint32_t probe = 0; probe < GEOFENCE_BIN_SLOTS; probe++) {
+        const geofence_bin_t* b = &gs->bins[slot];
+        if (!b->used) return NULL;
+        if (b->cell_id == cell_id) return b;
+        slot = (slot + 1) & (GEOFENCE_BIN_SLOTS - 1);
+    }
+    return NULL;
+}
+
+/**
+ * Find or claim the bin for a cell (NULL if the table is full).
+ */
+static geofence_bin_t* claim_bin(geofence_set_t* gs, uint16_t cell_id) {
+    uint32_t slot = bin_hash(cell_id);
+    for (uint32_t probe = 0; probe < GEOFENCE_BIN_SLOTS; probe++) {
+        geofence_bin_t* b = &gs->bins[slot];
+        if (!b->used) {
+            b->used = 1;
+            b->cell_id = cell_id;
+            b->start = 0;
+            b->count = 0;
+            return b;
+        }
+        if (b->cell_id == cell_id) return b;
+        slot = (slot + 1) & (GEOFENCE_BIN_SLOTS - 1);
+    }
+    return NULL;
+}
+
+/**
+ * Window-relative cell index range covered by a fence's bounding box.
+ */
+static void fence_cell_range(t_bsp_t* bsp, const geofence_poly_t* f,
+                             int* lat0, int* lat1, int* lon0, int* lon1) {
+    uint16_t lo = t_bsp_latlon_to_cell(bsp, f->lat_min, f->lon_min);
+    uint16_t hi = t_bsp_latlon_to_cell(bsp, f->lat_max, f->lon_max);
+    *lat0 = (int8_t)(lo >> 8);
+    *lon0 = (int8_t)(lo & 0xFF);
+    *lat1 = (int8_t)(hi >> 8);
+    *lon1 = (int8_t)(hi & 0xFF);
+}
+
+static inline uint16_t make_cell_id(int lat_idx, int lon_idx) {
+    return (uint16_t)(((lat_idx & 0xFF) << 8) | (lon_idx & 0xFF));
+}
+
+/**
+ * Vessel membership slot (claimed on first sight; NULL if table full).
+ */
+static geofence_vessel_t* vessel_slot(geofence_set_t* gs, uint32_t mmsi) {
+    uint32_t slot = (mmsi * 0x9E3779B1u) >> 16 & (GEOFENCE_MAX_VESSELS - 1);
+    for (uint32_t probe = 0; probe < GEOFENCE_MAX_VESSELS; probe++) {
+        geofence_vessel_t* v = &gs->vessels[slot];
+        if (v->mmsi == mmsi) return v;
+        if (v->mmsi == 0) {
+            v->mmsi = mmsi;
+            v->n_inside = 0;
+            return v;
+        }
+        slot = (slot + 1) & (GEOFENCE_MAX_VESSELS - 1);
+    }
+    return NULL;
+}
+
+static inline bool emit(geofence_event_t* events, int* n_events, int max_events,
+                        const geofence_poly_t* f, const geofence_fix_t* fix, uint8_t type) {
+    if (*n_events >= max_events) return false;
+    geofence_event_t* e = &events[(*n_events)++];
+    e->mmsi = fix->mmsi;
+    e->fence_id = f->id;
+    e->timestamp = fix->timestamp;
+    e->type = type;
+    e->kind = f->kind;
+    e->_padding[0] = e->_padding[1] = 0;
+    return true;
+}
+
+/**
+ * Evaluate one fix against the fences of its cell and diff membership.
+ *
+ * Membership only changes with an emitted event: an exit or entry that
+ * does not fit in events (or an entry beyond GEOFENCE_MAX_INSIDE) leaves
+ * the vessel's state as it was and counts in gs->dropped, so a later fix
+ * reports it instead of losing it.
+ */
+static int eval_in_bin(geofence_set_t* gs, const geofence_bin_t* bin,
+                       const geofence_fix_t* fix, geofence_event_t* events, int max_events) {
+    geofence_vessel_t* v = vessel_slot(gs, fix->mmsi);
+    if (!v) {
+        gs->dropped++;
+        return 0;
+    }
+
+    bool still[GEOFENCE_MAX_INSIDE] = { false };
+    uint16_t entered[GEOFENCE_MAX_INSIDE];
+    int n_entered = 0;
+
+    if (bin) {
+        const uint16_t* list = &gs->entries[bin->start];
+        for (uint32_t k = 0; k < bin->count; k++) {
+            const geofence_poly_t* f = &gs->fences[list[k]];
+            /* Bbox reject: most fences in a cell do not contain the fix */
+            if (fix->lat < f->lat_min || fix->lat > f->lat_max ||
+                fix->lon < f->lon_min || fix->lon > f->lon_max) {
+                continue;
+            }
+            gs->tests++;
+            if (!geofence_point_in_polygon(&gs->vertices[f->first_vertex], f->n_vertices,
+                                           fix->lat, fix->lon)) {
+                continue;
+            }
+            int i = 0;
+            while (i < v->n_inside && v->inside[i] != list[k]) i++;
+            if (i < v->n_inside) {
+                still[i] = true;
+            } else if (n_entered < GEOFENCE_MAX_INSIDE) {
+                entered[n_entered++] = list[k];
+            } else {
+                gs->dropped++;
+            }
+        }
+    }
+
+    /* Exits first: they make room for entries */
+    int n_events = 0;
+    int n_kept = 0;
+    for (int i = 0; i < v->n_inside; i++) {
+        if (!still[i] && emit(events, &n_events, max_events, &gs->fences[v->inside[i]], fix,
+                              GEOFENCE_EVENT_EXIT)) {
+            continue;
+        }
+        if (!still[i]) gs->dropped++;
+        v->inside[n_kept++] = v->inside[i];
+    }
+    for (int i = 0; i < n_entered; i++) {
+        if (n_kept < GEOFENCE_MAX_INSIDE &&
+            emit(events, &n_events, max_events, &gs->fences[entered[i]], fix,
+                 GEOFENCE_EVENT_ENTER)) {
+            v->inside[n_kept++] = entered[i];
+        } else {
+            gs->dropped++;
+        }
+    }
+    v->n_inside = (uint8_t)n_kept;
+    return n_events;
+}
+
+/**
+ * Bins valid for the grid's epoch (rebuilt after a re-center). A failed
+ * build is not retried until its inputs change: it would fail again at
+ * O(total bins) per fix.
+ */
+static inline bool ensure_built(geofence_set_t* gs, t_bsp_t* bsp) {
+    if (gs->built_epoch == bsp->grid_epoch) {
+        if (gs->built) return true;
+        if (gs->build_failed) return false;
+    }
+    return geofence_build(gs, bsp);
+}
+
+/* ========================================================================
+ * PUBLIC API IMPLEMENTATION
+ * ======================================================================== */
+
+/**
+ * Initialize an empty geofence set.
+ */
+void geofence_init(geofence_set_t* gs) {
+    gs->n_fences = 0;
+    gs->n_vertices = 0;
+    gs->n_entries = 0;
+    gs->built = 0;
+    gs->built_epoch = 0;
+    gs->build_failed = 0;
+    gs->tests = 0;
+    gs->dropped = 0;
+    memset(gs->bins, 0, sizeof(gs->bins));
+    memset(gs->vessels, 0, sizeof(gs->vessels));
+}
+
+/**
+ * Load one polygon and compute its bounding box.
+ */
+int geofence_add(geofence_set_t* gs, uint32_t id, uint8_t kind,
+                 const geofence_vertex_t* vertices, uint32_t n) {
+    if (n < 3 || gs->n_fences >= GEOFENCE_MAX_FENCES ||
+        gs->n_vertices + n > GEOFENCE_MAX_VERTICES) {
+        return -1;
+    }
+
+    geofence_poly_t* f = &gs->fences[gs->n_fences];
+    f->id = id;
+    f->kind = kind;
+    f->first_vertex = gs->n_vertices;
+    f->n_vertices = n;
+    f->lat_min = f->lat_max = vertices[0].lat;
+    f->lon_min = f->lon_max = vertices[0].lon;
+    for (uint32_t i = 0; i < n; i++) {
+        gs->vertices[gs->n_vertices + i] = vertices[i];
+        if (vertices[i].lat < f->lat_min) f->lat_min = vertices[i].lat;
+        if (vertices[i].lat > f->lat_max) f->lat_max = vertices[i].lat;
+        if (vertices[i].lon < f->lon_min) f->lon_min = vertices[i].lon;
+        if (vertices[i].lon > f->lon_max) f->lon_max = vertices[i].lon;
+    }
+    gs->n_vertices += n;
+    gs->built = 0;
+    gs->build_failed = 0;
+    return (int)gs->n_fences++;
+}
+
+/**
+ * Bin fences into cells (count, prefix-sum, fill).
+ */
+bool geofence_build(geofence_set_t* gs, t_bsp_t* bsp) {
+    memset(gs->bins, 0, sizeof(gs->bins));
+    gs->n_entries = 0;
+    gs->built = 0;
+    gs->built_epoch = bsp->grid_epoch;
+    gs->build_failed = 1;   /* Until pass 1 fits */
+
+    /* Pass 1: count fences per cell */
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < gs->n_fences; i++) {
+        int lat0, lat1, lon0, lon1;
+        fence_cell_range(bsp, &gs->fences[i], &lat0, &lat1, &lon0, &lon1);
+        for (int a = lat0; a <= lat1; a++) {
+            for (int b = lon0; b <= lon1; b++) {
+                geofence_bin_t* bin = claim_bin(gs, make_cell_id(a, b));
+                if (!bin || ++total > GEOFENCE_MAX_BIN_ENTRIES) {
+                    return false;
+                }
+                bin->count++;
+            }
+        }
+    }
+
+    /* Pass 2: prefix sums give each cell a contiguous run */
+    uint32_t running = 0;
+    for (uint32_t s = 0; s < GEOFENCE_BIN_SLOTS; s++) {
+        if (!gs->bins[s].used) continue;
+        gs->bins[s].start = running;
+        running += gs->bins[s].count;
+        gs->bins[s].count = 0;
+    }
+
+    /* Pass 3: fill (fence order within a cell = load order) */
+    for (uint32_t i = 0; i < gs->n_fences; i++) {
+        int lat0, lat1, lon0, lon1;
+        fence_cell_range(bsp, &gs->fences[i], &lat0, &lat1, &lon0, &lon1);
+        for (int a = lat0; a <= lat1; a++) {
+            for (int b = lon0; b <= lon1; b++) {
+                geofence_bin_t* bin = (geofence_bin_t*)find_bin(gs, make_cell_id(a, b));
+                gs->entries[bin->start + bin->count++] = (uint16_t)i;
+            }
+        }
+    }
+
+    gs->n_entries = total;
+    gs->built = 1;
+    gs->build_failed = 0;
+    return true;
+}
+
+/**
+ * Crossing-number point-in-polygon.
+ *
+ * For edge (i, j): straddle = (y_i > py) XOR (y_j > py). The crossing is
+ * left of the point iff (x_j - x_i)(py - y_i) - (px - x_i)(y_j - y_i) has
+ * the sign of (y_j - y_i); both are plain integer ops, so the loop has no
+ * data-dependent branches (the compiler emits setcc/and/xor). Points on
+ * an edge (d = 0) count as outside that edge's crossing, as in the usual
+ * strict "px < x_intersect" form.
+ */
+bool geofence_point_in_polygon(const geofence_vertex_t* v, uint32_t n,
+                               fixed_t lat, fixed_t lon) {
+    uint32_t inside = 0;
+    uint32_t j = n - 1;
+    for (uint32_t i = 0; i < n; j = i++) {
+        fixed_t yi = v[i].lat, yj = v[j].lat;
+        fixed_t xi = v[i].lon, xj = v[j].lon;
+        uint32_t straddle = (uint32_t)(yi > lat) ^ (uint32_t)(yj > lat);
+        int64_t dy = (int64_t)yj - yi;
+        int64_t d = ((int64_t)xj - xi) * ((int64_t)lat - yi) - ((int64_t)lon - xi) * dy;
+        uint32_t left = ((uint32_t)(d > 0) & (uint32_t)(dy > 0)) |
+                        ((uint32_t)(d < 0) & (uint32_t)(dy < 0));
+        inside ^= straddle & left;
+    }
+    return inside != 0;
+}
+
+/**
+ * Evaluate one fix.
+ */
+int geofence_eval(geofence_set_t* gs, t_bsp_t* bsp, const geofence_fix_t* fix,
+                  geofence_event_t* events, int max_events) {
+    if (!ensure_built(gs, bsp)) {
+        return GEOFENCE_ERR_BINS;
+    }
+    uint16_t cell = t_bsp_latlon_to_cell(bsp, fix->lat, fix->lon);
+    return eval_in_bin(gs, find_bin(gs, cell), fix, events, max_events);
+}
+
+/**
+ * Evaluate a batch of fixes, reusing the bin of the previous cell.
+ */
+int geofence_eval_batch(geofence_set_t* gs, t_bsp_t* bsp, const geofence_fix_t* fixes,
+                        int n, geofence_event_t* events, int max_events) {
+    if (!ensure_built(gs, bsp)) {
+        return GEOFENCE_ERR_BINS;
+    }
+
+    int n_events = 0;
+    uint16_t last_cell = 0;
+    const geofence_bin_t* bin = NULL;
+    bool have_last = false;
+
+    for (int i = 0; i < n; i++) {
+        uint16_t cell = t_bsp_latlon_to_cell(bsp, fixes[i].lat, fixes[i].lon);
+        if (!have_last || cell != last_cell) {
+            bin = find_bin(gs, cell);
+            last_cell = cell;
+            have_last = true;
+        }
+        n_events += eval_in_bin(gs, bin, &fixes[i], events + n_events, max_events - n_events);
+    }
+    return n_events;
+}
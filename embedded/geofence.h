@@ -0,0 +1,260 @@
+/*
+ * geofence.h - Geofence Engine with Per-Cell Polygon Bins
+ *
+ * Flags fixes entering and leaving ports, marine protected areas and
+ * exclusion zones. Polygons are stored in fixed-point degrees and binned
+ * into T-BSP cells at load time, so a fix is tested only against the
+ * fences whose bounding box overlaps its cell.
+ *
+ * Doom Lineage:
+ *   - Doom blockmap (P_BlockLinesIterator: per-block line lists built at
+ *     map load) → per-cell fence lists built by geofence_build()
+ *   - Doom validcount (test each line once) → bbox reject before the
+ *     crossing test
+ *   - Doom special lines (W1/WR triggers) → enter/exit events
+ *
+ * Capacities are compile-time (no allocation); override with -D for hosts
+ * that load thousands of fences.
+ *
+ * Hardware Target: ESP32-S3 (defaults ~45 KB static)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#ifndef GEOFENCE_H
+#define GEOFENCE_H
+
+#include "se3_edge.h"
+#include "t_bsp.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * CONFIGURATION CONSTANTS
+ * ======================================================================== */
+
+#ifndef GEOFENCE_MAX_FENCES
+#define GEOFENCE_MAX_FENCES      128     /* Polygons loaded */
+#endif
+
+#ifndef GEOFENCE_MAX_VERTICES
+#define GEOFENCE_MAX_VERTICES    2048    /* Shared vertex pool */
+#endif
+
+#ifndef GEOFENCE_MAX_BIN_ENTRIES
+#define GEOFENCE_MAX_BIN_ENTRIES 2048    /* (cell, fence) pairs after binning */
+#endif
+
+#ifndef GEOFENCE_BIN_SLOTS
+#define GEOFENCE_BIN_SLOTS       1024    /* Cell hash slots (power of 2) */
+#endif
+
+#ifndef GEOFENCE_MAX_VESSELS
+#define GEOFENCE_MAX_VESSELS     256     /* Vessels with enter/exit state (power of 2) */
+#endif
+
+/** Fences one vessel can be inside at once (nested port + MPA + zone) */
+#define GEOFENCE_MAX_INSIDE      6
+
+_Static_assert((GEOFENCE_BIN_SLOTS & (GEOFENCE_BIN_SLOTS - 1)) == 0,
+               "GEOFENCE_BIN_SLOTS must be a power of 2");
+_Static_assert((GEOFENCE_MAX_VESSELS & (GEOFENCE_MAX_VESSELS - 1)) == 0,
+               "GEOFENCE_MAX_VESSELS must be a power of 2");
+_Static_assert(GEOFENCE_MAX_FENCES <= 65535, "fence index is uint16_t");
+
+/* Fence kinds */
+#define GEOFENCE_KIND_PORT       0
+#define GEOFENCE_KIND_MPA        1       /* Marine protected area */
+#define GEOFENCE_KIND_EXCLUSION  2
+
+/* Event types */
+#define GEOFENCE_EVENT_ENTER     1
+#define GEOFENCE_EVENT_EXIT      2
+
+/* Evaluation errors (negative returns) */
+#define GEOFENCE_ERR_BINS        (-2)    /* Fences exceed bin capacity for this grid */
+
+/* ========================================================================
+ * DATA STRUCTURES
+ * ======================================================================== */
+
+/** Polygon vertex (fixed-point degrees) */
+typedef struct {
+    fixed_t lon;
+    fixed_t lat;
+} geofence_vertex_t;
+
+/** Position report to evaluate (16 bytes) */
+typedef struct {
+    fixed_t lat, lon;          /**< Fixed-point degrees */
+    uint32_t mmsi;
+    uint32_t timestamp;
+} geofence_fix_t;
+
+/** Enter/exit event (16 bytes) */
+typedef struct {
+    uint32_t mmsi;
+    uint32_t fence_id;         /**< Caller's fence identifier */
+    uint32_t timestamp;        /**< Fix that triggered the event */
+    uint8_t type;              /**< GEOFENCE_EVENT_ENTER / _EXIT */
+    uint8_t kind;              /**< GEOFENCE_KIND_* of the fence */
+    uint8_t _padding[2];
+} geofence_event_t;
+
+/** Polygon header (vertices live in the shared pool) */
+typedef struct {
+    uint32_t id;
+    uint32_t first_vertex;
+    uint32_t n_vertices;
+    fixed_t lat_min, lat_max;  /**< Bounding box */
+    fixed_t lon_min, lon_max;
+    uint8_t kind;
+    uint8_t _padding[3];
+} geofence_poly_t;
+
+/** Cell bin: fence indices entries[start .. start+count) */
+typedef struct {
+    uint16_t cell_id;
+    uint16_t used;
+    uint32_t start;
+    uint32_t count;
+} geofence_bin_t;
+
+/** Per-vessel membership (fence indices it is currently inside) */
+typedef struct {
+    uint32_t mmsi;             /**< 0 = free slot */
+    uint8_t n_inside;
+    uint8_t _padding[3];
+    uint16_t inside[GEOFENCE_MAX_INSIDE];
+} geofence_vessel_t;
+
+/**
+ * Geofence set: polygons, cell bins and vessel state.
+ *
+ * Bins are keyed by T-BSP cell ID for the grid window at build time;
+ * evaluation rebuilds them automatically after a t_bsp re-center.
+ */
+typedef struct {
+    geofence_poly_t fences[GEOFENCE_MAX_FENCES];
+    geofence_vertex_t vertices[GEOFENCE_MAX_VERTICES];
+    uint16_t entries[GEOFENCE_MAX_BIN_ENTRIES];
+    geofence_bin_t bins[GEOFENCE_BIN_SLOTS];
+    geofence_vessel_t vessels[GEOFENCE_MAX_VESSELS];
+    uint32_t n_fences;
+    uint32_t n_vertices;
+    uint32_t n_entries;
+    uint8_t built;             /**< Bins valid */
+    uint8_t built_epoch;       /**< bsp->grid_epoch the bins were keyed in */
+    uint8_t build_failed;      /**< Build at built_epoch exceeded capacity (latched
+                                    until geofence_add or a re-center) */
+    uint8_t _padding[1];
+    uint32_t tests;            /**< Polygon tests run (diagnostic) */
+    uint32_t dropped;          /**< Transitions not reported (events or membership
+                                    full); state is kept, so a later fix reports them */
+} geofence_set_t;
+
+/* ========================================================================
+ * API FUNCTIONS
+ * ======================================================================== */
+
+/**
+ * Initialize an empty geofence set.
+ *
+ * @param gs Geofence set (caller-allocated, static recommended)
+ */
+void geofence_init(geofence_set_t* gs);
+
+/**
+ * Load one polygon.
+ *
+ * Vertices are copied; the ring is closed implicitly (last → first).
+ * Polygons must not straddle the ±180° meridian (split them first).
+ * Invalidates bins until the next geofence_build().
+ *
+ * @param gs Geofence set
+ * @param id Caller's fence identifier (reported in events)
+ * @param kind GEOFENCE_KIND_*
+ * @param vertices Polygon ring (lon/lat, fixed-point degrees)
+ * @param n Vertex count (>= 3)
+ * @return Fence index, or -1 if capacity is exhausted or n < 3
+ */
+int geofence_add(geofence_set_t* gs, uint32_t id, uint8_t kind,
+                 const geofence_vertex_t* vertices, uint32_t n);
+
+/**
+ * Bin all fences into the T-BSP cells their bounding boxes overlap.
+ *
+ * Counting sort into a compact entry array: a cell's fence list is one
+ * contiguous run of uint16_t indices.
+ *
+ * Call it after loading so a capacity failure surfaces there (the cell
+ * count depends on the grid window, so geofence_add() cannot check it).
+ * A failure is latched: evaluation returns GEOFENCE_ERR_BINS without
+ * rebuilding until a fence is added or the grid re-centers.
+ *
+ * @param gs Geofence set
+ * @param bsp Grid the fixes will be keyed in
+ * @return true on success, false if bin capacity
+ *         (GEOFENCE_MAX_BIN_ENTRIES or GEOFENCE_BIN_SLOTS) is exceeded
+ */
+bool geofence_build(geofence_set_t* gs, t_bsp_t* bsp);
+
+/**
+ * Point-in-polygon test (crossing number, branch-light).
+ *
+ * Each edge contributes (y-straddle) AND (crossing left of the point),
+ * computed from 64-bit cross products without division; the parity
+ * accumulates by XOR. Points on an edge resolve deterministically.
+ *
+ * @param v Polygon ring
+ * @param n Vertex count
+ * @param lat Point latitude (fixed-point degrees)
+ * @param lon Point longitude (fixed-point degrees)
+ * @return true if inside
+ */
+bool geofence_point_in_polygon(const geofence_vertex_t* v, uint32_t n,
+                               fixed_t lat, fixed_t lon);
+
+/**
+ * Evaluate one fix: update the vessel's membership and emit events.
+ *
+ * @param gs Geofence set (built)
+ * @param bsp Grid (for the fix's cell ID)
+ * @param fix Position report
+ * @param events Output events (capacity max_events)
+ * @param max_events Output capacity
+ * Membership only changes with an emitted event. A transition that does
+ * not fit (events full, or more than GEOFENCE_MAX_INSIDE fences, or the
+ * vessel table full) is counted in gs->dropped and reported by a later fix.
+ *
+ * @return Events written, or GEOFENCE_ERR_BINS if the fences do not fit
+ *         the bins for this grid (see geofence_build)
+ */
+int geofence_eval(geofence_set_t* gs, t_bsp_t* bsp, const geofence_fix_t* fix,
+                  geofence_event_t* events, int max_events);
+
+/**
+ * Evaluate a batch of fixes (in arrival order).
+ *
+ * Consecutive fixes in the same cell reuse the bin lookup.
+ *
+ * @param gs Geofence set (built)
+ * @param bsp Grid
+ * @param fixes Position reports
+ * @param n Number of fixes
+ * @param events Output events (capacity max_events)
+ * @param max_events Output capacity
+ * @return Events written, or GEOFENCE_ERR_BINS (see geofence_eval)
+ */
+int geofence_eval_batch(geofence_set_t* gs, t_bsp_t* bsp, const geofence_fix_t* fixes,
+                        int n, geofence_event_t* events, int max_events);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GEOFENCE_H */
@@ -0,0 +1,617 @@
+/*
+ * json_parser.c - Streaming JSON Pose Parser Implementation
+ *
+ * Two layers in one pass: a byte-level JSON tokenizer (explicit state,
+ * so it can stop at any byte and resume on the next chunk) and a schema
+ * layer that sees value starts, container closes and finished numbers
+ * and tracks where in {"poses": [{...}]} the tokenizer is by depth alone.
+ *
+ * Reference: id-Software/DOOM linuxdoom-1.10/w_wad.c (W_ReadLump),
+ *            p_setup.c (P_LoadThings)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "json_parser.h"
+#include <string.h>
+
+/* ========================================================================
+ * INTERNAL CONSTANTS
+ * ======================================================================== */
+
+/* Tokenizer states */
+enum {
+    S_ROOT,             /* Between root values: whitespace, '{' or '[' */
+    S_VALUE,            /* After ':' or ',' in an array */
+    S_VALUE_OR_CLOSE,   /* After '[' */
+    S_KEY_OR_CLOSE,     /* After '{' */
+    S_KEY,              /* After ',' in an object */
+    S_COLON,
+    S_NEXT,             /* After a value: ',' or the container's close */
+    S_STRING,
+    S_ESC,
+    S_HEX,
+    S_LITERAL,
+    S_NUM_MINUS,
+    S_NUM_ZERO,
+    S_NUM_INT,
+    S_NUM_DOT,
+    S_NUM_FRAC,
+    S_NUM_E,
+    S_NUM_E_SIGN,
+    S_NUM_EXP,
+    S_ERROR
+};
+
+/* Schema keys */
+enum { K_OTHER, K_POSES, K_ROTATION, K_TRANSLATION, K_TIMESTAMP, K_MMSI };
+
+/* Number destinations */
+enum { T_NONE, T_ROT, T_TRANS, T_TIMESTAMP, T_MMSI };
+
+/* Array fields */
+enum { F_NONE, F_ROT, F_TRANS };
+
+#define HAVE_ROT     0x01
+#define HAVE_TRANS   0x02
+
+#define EXP_CLAMP    10000     /* |exponent| beyond this is over/underflow anyway */
+
+static const uint64_t pow10_u64[20] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+    100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+    10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+    100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+};
+
+/* ========================================================================
+ * SCHEMA LAYER
+ * ======================================================================== */
+
+static int classify_key(const char* key, int len) {
+    switch (len) {
+    case 4:  return memcmp(key, "mmsi", 4) == 0 ? K_MMSI : K_OTHER;
+    case 5:  return memcmp(key, "poses", 5) == 0 ? K_POSES : K_OTHER;
+    case 8:  return memcmp(key, "rotation", 8) == 0 ? K_ROTATION : K_OTHER;
+    case 9:  return memcmp(key, "timestamp", 9) == 0 ? K_TIMESTAMP : K_OTHER;
+    case 11: return memcmp(key, "translation", 11) == 0 ? K_TRANSLATION : K_OTHER;
+    default: return K_OTHER;
+    }
+}
+
+static inline bool parent_is_object(const json_pose_parser_t* p) {
+    return p->depth > 0 && ((p->stack >> (p->depth - 1)) & 1);
+}
+
+/**
+ * A value starts at level p->depth (before any push).
+ *
+ * @param kind '{', '[', 'n' (number) or 's' (string / literal)
+ */
+static int value_begin(json_pose_parser_t* p, int kind) {
+    int d = p->depth;
+    p->num_target = T_NONE;
+
+    if (p->pose_depth) {
+        if (d == p->pose_depth) {
+            switch (p->key_id) {
+            case K_ROTATION:
+                if (kind != '[' || (p->have & HAVE_ROT)) return JSON_POSE_ERR_SCHEMA;
+                p->field = F_ROT;
+                p->field_depth = (uint8_t)(d + 1);
+                p->have |= HAVE_ROT;
+                return JSON_POSE_OK;
+            case K_TRANSLATION:
+                if (kind != '[' || (p->have & HAVE_TRANS)) return JSON_POSE_ERR_SCHEMA;
+                p->field = F_TRANS;
+                p->field_depth = (uint8_t)(d + 1);
+                p->have |= HAVE_TRANS;
+                return JSON_POSE_OK;
+            case K_TIMESTAMP:
+            case K_MMSI:
+                if (kind != 'n') return JSON_POSE_ERR_SCHEMA;
+                p->num_target = p->key_id == K_MMSI ? T_MMSI : T_TIMESTAMP;
+                return JSON_POSE_OK;
+            default:
+                return JSON_POSE_OK;    /* Unknown field: skipped */
+            }
+        }
+        if (p->field == F_NONE) return JSON_POSE_OK;   /* Inside a skipped field */
+
+        if (d == p->field_depth) {
+            if (kind == 'n' && (p->field == F_TRANS || p->rot_rows == 0)) {
+                p->num_target = p->field == F_ROT ? T_ROT : T_TRANS;
+                return JSON_POSE_OK;
+            }
+            /* Nested rotation rows: only rows, three of them */
+            if (kind == '[' && p->field == F_ROT && p->rot_rows < 3 &&
+                p->rot_n == p->rot_rows * 3) {
+                p->rot_rows++;
+                p->row_n = 0;
+                return JSON_POSE_OK;
+            }
+            return JSON_POSE_ERR_SCHEMA;
+        }
+        if (d == p->field_depth + 1 && kind == 'n') {
+            p->num_target = T_ROT;
+            return JSON_POSE_OK;
+        }
+        return JSON_POSE_ERR_SCHEMA;
+    }
+
+    if (p->poses_depth) {
+        if (d != p->poses_depth) return JSON_POSE_OK;
+        if (kind != '{') return JSON_POSE_ERR_SCHEMA;
+        p->pose_depth = (uint8_t)(d + 1);
+        p->have = 0;
+        p->rot_n = p->rot_rows = p->row_n = p->trans_n = 0;
+        p->field = F_NONE;
+        memset(&p->pose, 0, sizeof(p->pose));
+        return JSON_POSE_OK;
+    }
+
+    if (p->key_id == K_POSES && parent_is_object(p)) {
+        if (kind != '[') return JSON_POSE_ERR_SCHEMA;
+        p->poses_depth = (uint8_t)(d + 1);
+        p->trajectories++;
+    }
+    return JSON_POSE_OK;
+}
+
+/**
+ * The container at level p->depth is closing (before the pop).
+ */
+static int container_close(json_pose_parser_t* p) {
+    int d = p->depth;
+
+    if (p->field != F_NONE) {
+        if (d == p->field_depth + 1) {
+            return p->row_n == 3 ? JSON_POSE_OK : JSON_POSE_ERR_SCHEMA;
+        }
+        if (d != p->field_depth) return JSON_POSE_OK;
+
+        int field = p->field;
+        p->field = F_NONE;
+        if (field == F_TRANS) {
+            return p->trans_n == 3 ? JSON_POSE_OK : JSON_POSE_ERR_SCHEMA;
+        }
+        if (p->rot_rows == 0 && p->rot_n == 3) {
+            so3_exp(p->rot, p->pose.rotation);          /* Rotation vector */
+        } else if (p->rot_n == 9) {
+            memcpy(p->pose.rotation, p->rot, sizeof(p->rot));  /* Flat or 3 full rows */
+        } else {
+            return JSON_POSE_ERR_SCHEMA;
+        }
+        return JSON_POSE_OK;
+    }
+
+    if (d == p->pose_depth) {
+        p->pose_depth = 0;
+        if (p->have != (HAVE_ROT | HAVE_TRANS)) return JSON_POSE_ERR_SCHEMA;
+        p->poses++;
+        p->on_pose(p->ctx, &p->pose, p->trajectories - 1);
+    } else if (d == p->poses_depth) {
+        p->poses_depth = 0;
+    }
+    return JSON_POSE_OK;
+}
+
+/**
+ * Convert the accumulated number and store it where the schema wants it.
+ *
+ * mant < 10^JSON_POSE_SIG_DIGITS < 2^40, so mant << 16 never overflows;
+ * integer fields are range-checked before scaling (2^40 × 10^9 would).
+ */
+static int number_end(json_pose_parser_t* p) {
+    if (p->num_target == T_NONE) return JSON_POSE_OK;
+
+    int32_t e = p->dec_exp + (p->exp_neg ? -p->exp : p->exp);
+    uint64_t m = p->mant;
+
+    if (p->num_target == T_TIMESTAMP || p->num_target == T_MMSI) {
+        while (m != 0 && e < 0 && m % 10 == 0) {
+            m /= 10;
+            e++;
+        }
+        if (m != 0) {
+            if (p->num_neg || e > 9) return JSON_POSE_ERR_RANGE;
+            if (e < 0) return JSON_POSE_ERR_SCHEMA;    /* Not an integer */
+            if (m > UINT32_MAX / pow10_u64[e]) return JSON_POSE_ERR_RANGE;
+            m *= pow10_u64[e];
+        }
+        if (p->num_target == T_MMSI) {
+            p->pose.mmsi = (uint32_t)m;
+        } else {
+            p->pose.timestamp = (uint32_t)m;
+        }
+        return JSON_POSE_OK;
+    }
+
+    uint64_t mag;
+    if (m == 0) {
+        mag = 0;
+    } else if (e >= 0) {
+        if (e > 5) return JSON_POSE_ERR_RANGE;
+        mag = m * pow10_u64[e];
+        if (mag > 32768) return JSON_POSE_ERR_RANGE;
+        mag <<= FRACBITS;
+    } else if (-e > 19) {
+        mag = 0;
+    } else {
+        uint64_t div = pow10_u64[-e];
+        mag = ((m << FRACBITS) + div / 2) / div;    /* Round half away from zero */
+    }
+    if (mag > (p->num_neg ? 0x80000000ull : 0x7FFFFFFFull)) return JSON_POSE_ERR_RANGE;
+    fixed_t v = p->num_neg ? (fixed_t)(0 - (int64_t)mag) : (fixed_t)mag;
+
+    if (p->num_target == T_TRANS) {
+        if (p->trans_n >= 3) return JSON_POSE_ERR_SCHEMA;
+        p->pose.translation[p->trans_n++] = v;
+    } else {
+        if (p->rot_n >= 9) return JSON_POSE_ERR_SCHEMA;
+        if (p->rot_rows && ++p->row_n > 3) return JSON_POSE_ERR_SCHEMA;
+        p->rot[p->rot_n++] = v;
+    }
+    return JSON_POSE_OK;
+}
+
+/* ========================================================================
+ * TOKENIZER HELPERS
+ * ======================================================================== */
+
+static inline bool is_ws(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+static inline bool is_digit(char c) {
+    return (unsigned)(c - '0') < 10u;
+}
+
+static inline bool is_hex(char c) {
+    return is_digit(c) || (unsigned)((c | 0x20) - 'a') < 6u;
+}
+
+static inline void int_digit(json_pose_parser_t* p, char c) {
+    if (p->num_digits < JSON_POSE_SIG_DIGITS) {
+        p->mant = p->mant * 10 + (uint64_t)(c - '0');
+        if (p->mant != 0) p->num_digits++;
+    } else {
+        p->dec_exp++;
+    }
+}
+
+static inline void frac_digit(json_pose_parser_t* p, char c) {
+    if (p->num_digits < JSON_POSE_SIG_DIGITS) {
+        p->mant = p->mant * 10 + (uint64_t)(c - '0');
+        if (p->mant != 0) p->num_digits++;
+        p->dec_exp--;
+    }
+}
+
+static inline void exp_digit(json_pose_parser_t* p, char c) {
+    if (p->exp < EXP_CLAMP) p->exp = p->exp * 10 + (c - '0');
+}
+
+static inline int push(json_pose_parser_t* p, bool object) {
+    if (p->depth >= JSON_POSE_MAX_DEPTH) return JSON_POSE_ERR_DEPTH;
+    if (object) {
+        p->stack |= 1ull << p->depth;
+    } else {
+        p->stack &= ~(1ull << p->depth);
+    }
+    p->depth++;
+    return JSON_POSE_OK;
+}
+
+/**
+ * Close the innermost container with ']' or '}'.
+ */
+static int close_container(json_pose_parser_t* p, char c) {
+    if (p->depth == 0 || parent_is_object(p) != (c == '}')) return JSON_POSE_ERR_SYNTAX;
+    int err = container_close(p);
+    p->depth--;
+    p->state = p->depth ? S_NEXT : S_ROOT;
+    return err;
+}
+
+/**
+ * First byte of a value (not whitespace).
+ */
+static int start_value(json_pose_parser_t* p, char c) {
+    int err;
+    switch (c) {
+    case '{':
+        if ((err = value_begin(p, '{')) != JSON_POSE_OK) return err;
+        p->state = S_KEY_OR_CLOSE;
+        return push(p, true);
+    case '[':
+        if ((err = value_begin(p, '[')) != JSON_POSE_OK) return err;
+        p->state = S_VALUE_OR_CLOSE;
+        return push(p, false);
+    case '"':
+        p->is_key = 0;
+        p->state = S_STRING;
+        return value_begin(p, 's');
+    case 't':
+    case 'f':
+    case 'n':
+        p->literal = c == 't' ? "true" : c == 'f' ? "false" : "null";
+        p->aux = 1;
+        p->state = S_LITERAL;
+        return value_begin(p, 's');
+    default:
+        break;
+    }
+    if (c != '-' && !is_digit(c)) return JSON_POSE_ERR_SYNTAX;
+    p->mant = 0;
+    p->num_digits = 0;
+    p->dec_exp = 0;
+    p->exp = 0;
+    p->exp_neg = 0;
+    p->num_neg = c == '-';
+    p->state = c == '-' ? S_NUM_MINUS : c == '0' ? S_NUM_ZERO : S_NUM_INT;
+    if (c != '-') int_digit(p, c);
+    return value_begin(p, 'n');
+}
+
+static inline void start_key(json_pose_parser_t* p) {
+    p->is_key = 1;
+    p->key_len = 0;
+    p->state = S_STRING;
+}
+
+/* ========================================================================
+ * PUBLIC API
+ * ======================================================================== */
+
+void json_pose_init(json_pose_parser_t* p, json_pose_fn on_pose, void* ctx) {
+    memset(p, 0, sizeof(*p));
+    p->state = S_ROOT;
+    p->on_pose = on_pose;
+    p->ctx = ctx;
+}
+
+/**
+ * Consume a chunk.
+ *
+ * One switch per structural byte; runs of whitespace, digits and string
+ * bytes are consumed by inner loops without re-dispatching. A number is
+ * only known to end at the next byte, which is then re-read as S_NEXT.
+ */
+int json_pose_feed(json_pose_parser_t* p, const char* buf, size_t len) {
+    if (p->error) return p->error;
+
+    const char* s = buf;
+    const char* end = buf + len;
+    int err = JSON_POSE_OK;
+
+    while (s < end && err == JSON_POSE_OK) {
+        char c = *s;
+        switch (p->state) {
+        case S_ROOT:
+            if (is_ws(c)) break;
+            if (c != '{' && c != '[') {
+                err = JSON_POSE_ERR_SYNTAX;
+                continue;
+            }
+            err = start_value(p, c);
+            break;
+
+        case S_VALUE:
+            if (is_ws(c)) break;
+            err = start_value(p, c);
+            break;
+
+        case S_VALUE_OR_CLOSE:
+            if (is_ws(c)) break;
+            err = c == ']' ? close_container(p, c) : start_value(p, c);
+            break;
+
+        case S_KEY_OR_CLOSE:
+            if (is_ws(c)) break;
+            if (c == '}') {
+                err = close_container(p, c);
+            } else if (c == '"') {
+                start_key(p);
+            } else {
+                err = JSON_POSE_ERR_SYNTAX;
+                continue;
+            }
+            break;
+
+        case S_KEY:
+            if (is_ws(c)) break;
+            if (c != '"') {
+                err = JSON_POSE_ERR_SYNTAX;
+                continue;
+            }
+            start_key(p);
+            break;
+
+        case S_COLON:
+            if (is_ws(c)) break;
+            if (c != ':') {
+                err = JSON_POSE_ERR_SYNTAX;
+                continue;
+            }
+            p->state = S_VALUE;
+            break;
+
+        case S_NEXT:
+            if (is_ws(c)) break;
+            if (c == ',') {
+                p->state = parent_is_object(p) ? S_KEY : S_VALUE;
+            } else if (c == ']' || c == '}') {
+                err = close_container(p, c);
+            } else {
+                err = JSON_POSE_ERR_SYNTAX;
+                continue;
+            }
+            break;
+
+        case S_STRING: {
+            const char* run = s;
+            while (s < end && *s != '"' && *s != '\\' && (unsigned char)*s >= 0x20) s++;
+            if (p->is_key && p->key_len <= JSON_POSE_KEY_MAX) {
+                size_t n = (size_t)(s - run);
+                if (p->key_len + n > JSON_POSE_KEY_MAX) {
+                    p->key_len = JSON_POSE_KEY_MAX + 1;
+                } else {
+                    memcpy(p->key + p->key_len, run, n);
+                    p->key_len = (uint8_t)(p->key_len + n);
+                }
+            }
+            if (s == end) continue;
+            c = *s;
+            if (c == '"') {
+                if (p->is_key) {
+                    p->key_id = (uint8_t)classify_key(p->key, p->key_len);
+                    p->state = S_COLON;
+                } else {
+                    p->state = S_NEXT;
+                }
+            } else if (c == '\\') {
+                if (p->is_key) p->key_len = JSON_POSE_KEY_MAX + 1;  /* Never a schema key */
+                p->state = S_ESC;
+            } else {
+                err = JSON_POSE_ERR_SYNTAX;     /* Unescaped control character */
+                continue;
+            }
+            break;
+        }
+
+        case S_ESC:
+            if (c == 'u') {
+                p->aux = 4;
+                p->state = S_HEX;
+            } else if (c == '"' || c == '\\' || c == '/' || c == 'b' || c == 'f' ||
+                       c == 'n' || c == 'r' || c == 't') {
+                p->state = S_STRING;
+            } else {
+                err = JSON_POSE_ERR_SYNTAX;
+                continue;
+            }
+            break;
+
+        case S_HEX:
+            if (!is_hex(c)) {
+                err = JSON_POSE_ERR_SYNTAX;
+                continue;
+            }
+            if (--p->aux == 0) p->state = S_STRING;
+            break;
+
+        case S_LITERAL:
+            if (c != p->literal[p->aux]) {
+                err = JSON_POSE_ERR_SYNTAX;
+                continue;
+            }
+            if (p->literal[++p->aux] == '\0') p->state = S_NEXT;
+            break;
+
+        case S_NUM_MINUS:
+            if (!is_digit(c)) {
+                err = JSON_POSE_ERR_SYNTAX;
+                continue;
+            }
+            int_digit(p, c);
+            p->state = c == '0' ? S_NUM_ZERO : S_NUM_INT;
+            break;
+
+        case S_NUM_INT:
+            while (is_digit(c)) {
+                int_digit(p, c);
+                if (++s == end) break;
+                c = *s;
+            }
+            if (s == end) continue;
+            /* fall through */
+        case S_NUM_ZERO:
+            if (c == '.') {
+                p->state = S_NUM_DOT;
+            } else if (c == 'e' || c == 'E') {
+                p->state = S_NUM_E;
+            } else {
+                err = number_end(p);
+                p->state = S_NEXT;
+                continue;               /* Re-read c as S_NEXT */
+            }
+            break;
+
+        case S_NUM_DOT:
+            if (!is_digit(c)) {
+                err = JSON_POSE_ERR_SYNTAX;
+                continue;
+            }
+            frac_digit(p, c);
+            p->state = S_NUM_FRAC;
+            break;
+
+        case S_NUM_FRAC:
+            while (is_digit(c)) {
+                frac_digit(p, c);
+                if (++s == end) break;
+                c = *s;
+            }
+            if (s == end) continue;
+            if (c == 'e' || c == 'E') {
+                p->state = S_NUM_E;
+                break;
+            }
+            err = number_end(p);
+            p->state = S_NEXT;
+            continue;
+
+        case S_NUM_E:
+            if (c == '+' || c == '-') {
+                p->exp_neg = c == '-';
+                p->state = S_NUM_E_SIGN;
+                break;
+            }
+            /* fall through */
+        case S_NUM_E_SIGN:
+            if (!is_digit(c)) {
+                err = JSON_POSE_ERR_SYNTAX;
+                continue;
+            }
+            exp_digit(p, c);
+            p->state = S_NUM_EXP;
+            break;
+
+        case S_NUM_EXP:
+            while (is_digit(c)) {
+                exp_digit(p, c);
+                if (++s == end) break;
+                c = *s;
+            }
+            if (s == end) continue;
+            err = number_end(p);
+            p->state = S_NEXT;
+            continue;
+
+        default:
+            err = JSON_POSE_ERR_SYNTAX;
+            continue;
+        }
+        if (err == JSON_POSE_OK) s++;   /* On error s stays on the offending byte */
+    }
+
+    p->offset += (uint64_t)(s - buf);
+    if (err != JSON_POSE_OK) {
+        p->error = err;
+        p->state = S_ERROR;
+    }
+    return err;
+}
+
+int json_pose_finish(json_pose_parser_t* p) {
+    if (p->error) return p->error;
+    return p->state == S_ROOT ? JSON_POSE_OK : JSON_POSE_ERR_TRUNCATED;
+}
+
+int json_pose_parse(const char* buf, size_t len, json_pose_fn on_pose, void* ctx) {
+    json_pose_parser_t p;
+    json_pose_init(&p, on_pose, ctx);
+    int err = json_pose_feed(&p, buf, len);
+    return err != JSON_POSE_OK ? err : json_pose_finish(&p);
+}
@@ -0,0 +1,176 @@
+/*
+ * json_parser.h - Streaming JSON Pose Parser (SAX, Zero-Allocation, Resumable)
+ *
+ * Parses the science API's trajectory payloads straight into se3_pose_t:
+ *
+ *   {"poses": [{"rotation": [...], "translation": [...]}, ...]}
+ *
+ * Input arrives in chunks of any size (a UART read, one TCP segment, a
+ * whole file); json_pose_feed() consumes each chunk completely and keeps
+ * every partial token - a number, a key, an escape - in the parser state,
+ * so a pose may be split at any byte. Nothing is buffered beyond the pose
+ * being built, so input size is unbounded and memory is sizeof(parser).
+ *
+ * Schema (the science service's TrajectoryEncoder formats):
+ *   - Any "poses" array, at any depth, is a trajectory: the metrics
+ *     request wraps it in "trajectory_data", the batch request lists
+ *     several under "trajectories", job streams send one object per line.
+ *     Each "poses" array gets the next trajectory index.
+ *   - "rotation": rotation vector [x, y, z] (radians, mapped with
+ *     so3_exp), flat row-major [9], or nested [[3], [3], [3]]
+ *   - "translation": [x, y, z] in meters (required)
+ *   - "timestamp", "mmsi": optional unsigned integers (default 0)
+ *   - Other keys and values are validated and skipped.
+ * Several root values may follow each other (NDJSON, concatenated JSON).
+ *
+ * Numbers go straight to 16.16 with round-to-nearest from at most
+ * JSON_POSE_SIG_DIGITS significant digits (no strtod, no float). Values
+ * outside the 16.16 range (±32,768) are an error, not a saturation.
+ *
+ * Doom Lineage:
+ *   - Doom's lump-by-lump WAD reading (W_ReadLump into a zone buffer sized
+ *     by the lump directory) → here there is no directory: the stream is
+ *     tokenized in place and each pose handed out as soon as it closes,
+ *     like P_LoadThings spawning each mapthing_t as it is read
+ *
+ * Hardware Target: ESP32-S3 (parser state ~210 bytes, no heap)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#ifndef JSON_PARSER_H
+#define JSON_PARSER_H
+
+#include "se3_edge.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * CONFIGURATION CONSTANTS
+ * ======================================================================== */
+
+#ifndef JSON_POSE_MAX_DEPTH
+#define JSON_POSE_MAX_DEPTH  64      /* Nesting limit (one bit per level) */
+#endif
+
+#define JSON_POSE_KEY_MAX    12      /* Longer keys are never schema keys */
+#define JSON_POSE_SIG_DIGITS 12      /* Significant digits kept per number */
+
+_Static_assert(JSON_POSE_MAX_DEPTH <= 64, "container stack is a uint64_t bitmask");
+
+/* json_pose_feed() / json_pose_finish() results */
+#define JSON_POSE_OK           0
+#define JSON_POSE_ERR_SYNTAX  -1     /* Not JSON */
+#define JSON_POSE_ERR_DEPTH   -2     /* Nesting beyond JSON_POSE_MAX_DEPTH */
+#define JSON_POSE_ERR_RANGE   -3     /* Number outside 16.16 / uint32 range */
+#define JSON_POSE_ERR_SCHEMA  -4     /* Pose field of the wrong shape or missing */
+#define JSON_POSE_ERR_TRUNCATED -5   /* finish(): input ended inside a value */
+
+/* ========================================================================
+ * DATA STRUCTURES
+ * ======================================================================== */
+
+/**
+ * Pose callback, called once per completed pose object.
+ *
+ * @param ctx Caller context
+ * @param pose Parsed pose (valid for the duration of the call)
+ * @param trajectory Index of the "poses" array the pose came from
+ */
+typedef void (*json_pose_fn)(void* ctx, const se3_pose_t* pose, uint32_t trajectory);
+
+/**
+ * Parser state: tokenizer position, partial token, pose under construction.
+ */
+typedef struct {
+    /* Tokenizer */
+    uint64_t stack;            /**< Bit d set: level d+1 is an object */
+    uint8_t depth;             /**< Open containers */
+    uint8_t state;             /**< Tokenizer state (json_parser.c) */
+    uint8_t is_key;            /**< String being read is an object key */
+    uint8_t aux;               /**< Hex digits left / literal position */
+    const char* literal;       /**< "true", "false" or "null" being matched */
+    char key[JSON_POSE_KEY_MAX];
+    uint8_t key_len;           /**< JSON_POSE_KEY_MAX + 1 = not a schema key */
+    uint8_t key_id;            /**< Last key read at the current level */
+
+    /* Number accumulator */
+    uint8_t num_neg, exp_neg;
+    uint8_t num_digits;        /**< Significant digits in mant */
+    uint8_t num_target;        /**< Where the finished number goes */
+    uint64_t mant;
+    int32_t dec_exp;           /**< Decimal point position relative to mant */
+    int32_t exp;               /**< Explicit exponent (clamped) */
+
+    /* Schema position (depths of the containers, 0 = not inside) */
+    uint8_t poses_depth;
+    uint8_t pose_depth;
+    uint8_t field;             /**< Array field being filled */
+    uint8_t field_depth;
+    uint8_t rot_n, rot_rows, row_n, trans_n;
+    uint8_t have;              /**< Fields seen in this pose */
+    uint8_t _padding;
+    fixed_t rot[9];
+    se3_pose_t pose;
+
+    /* Output */
+    json_pose_fn on_pose;
+    void* ctx;
+    uint32_t trajectories;     /**< "poses" arrays seen */
+    uint32_t poses;            /**< Poses emitted */
+    uint64_t offset;           /**< Bytes consumed (error position on failure) */
+    int error;                 /**< Sticky: first error, JSON_POSE_OK if none */
+} json_pose_parser_t;
+
+/* ========================================================================
+ * API FUNCTIONS
+ * ======================================================================== */
+
+/**
+ * Initialize a parser for a new stream.
+ *
+ * @param p Parser (caller-allocated)
+ * @param on_pose Called for every completed pose
+ * @param ctx Passed to on_pose
+ */
+void json_pose_init(json_pose_parser_t* p, json_pose_fn on_pose, void* ctx);
+
+/**
+ * Consume one chunk of the stream.
+ *
+ * Chunks may split the input anywhere. Poses that close inside the chunk
+ * are delivered before the call returns. After an error the parser stays
+ * failed (p->offset is the offending byte) until json_pose_init().
+ *
+ * @param p Parser
+ * @param buf Chunk bytes (not retained)
+ * @param len Chunk length
+ * @return JSON_POSE_OK or JSON_POSE_ERR_*
+ */
+int json_pose_feed(json_pose_parser_t* p, const char* buf, size_t len);
+
+/**
+ * End of stream: check that no value is left open.
+ *
+ * @param p Parser
+ * @return JSON_POSE_OK, JSON_POSE_ERR_TRUNCATED or the sticky error
+ */
+int json_pose_finish(json_pose_parser_t* p);
+
+/**
+ * Parse a complete buffer (init + feed + finish).
+ *
+ * @return JSON_POSE_OK or JSON_POSE_ERR_*
+ */
+int json_pose_parse(const char* buf, size_t len, json_pose_fn on_pose, void* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JSON_PARSER_H */
@@ -0,0 +1,583 @@
+/*
+ * lambda_estimator.c - Fixed-Point λ-Estimation (Double-and-Scale Return)
+ *
+ * Native counterpart of compute_return_error() / optimize_scaling_factor()
+ * in src/science/lie_dynamics/se3_double_scale.py:
+ *
+ *   g^λ      = [exp(λ log R), λ t]
+ *   G_λ      = g1^λ * g2^λ * ... * gT^λ
+ *   ε(λ)     = ||G_λ² - I||_F  (rotation Frobenius + translation norm)
+ *   λ*       = argmin ε(λ) over [LAMBDA_MIN, LAMBDA_MAX]
+ *
+ * The search is a golden-section search (one ε evaluation per iteration),
+ * the fixed-point analog of scipy's bounded minimize_scalar.
+ *
+ * Three entry styles:
+ *   - compute_return_error() / fast_lambda_estimate(): no workspace,
+ *     the step logs are recomputed on every evaluation.
+ *   - lambda_workspace_t: the λ-independent part (log R of every step)
+ *     is computed once, so each evaluation is exp + compose only. The
+ *     workspace can be loaded from contiguous steps or gathered from
+ *     absolute fixes through an index list (multi-cell tracks).
+ *   - lambda_pyramid_t: coarse-to-fine search over a workspace. Runs of
+ *     consecutive steps are pre-composed into blocks; most iterations run
+ *     on the blocks, the last few on the full workspace.
+ *
+ * Translations are accumulated in 64 bits, so stitched tracks spanning
+ * several 10 km cells cannot overflow the 16.16 range (±32 km).
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "se3_edge.h"
+
+/* 2π in 16.16 and 2^32 / (2π) (radians → 32-bit angle) */
+#define FIXED_2PI_Q16          411775
+#define RAD_TO_ANGLE_Q16       683565276ll
+
+/* Below this angle (radians), use Taylor series instead of LUT + divide */
+#define SMALL_ANGLE            FLOAT_TO_FIXED(0.25f)
+
+/* cos θ below this switches log to the near-π (diagonal) branch */
+#define NEAR_PI_COS            FLOAT_TO_FIXED(-0.9f)
+
+/* 1/φ for golden-section search */
+#define INV_PHI                FLOAT_TO_FIXED(0.6180339887f)
+
+/* ========================================================================
+ * SO(3) EXPONENTIAL AND LOGARITHM
+ * ======================================================================== */
+
+/**
+ * SO(3) exponential map (Rodrigues): R = I + A W + B W².
+ *
+ * W = skew(w), θ = |w|, A = sin θ / θ, B = (1 - cos θ) / θ².
+ * Small angles use Taylor series for A and B (no division, no LUT
+ * quantization); larger angles use the interpolated sine LUT.
+ *
+ * @param w Rotation vector (radians, 16.16)
+ * @param R Output rotation matrix (row-major)
+ */
+void so3_exp(const fixed_t w[3], fixed_t R[9]) {
+    fixed_t x = w[0], y = w[1], z = w[2];
+    fixed_t xx = FixedMul(x, x), yy = FixedMul(y, y), zz = FixedMul(z, z);
+    fixed_t theta_sq = xx + yy + zz;
+    fixed_t A, B;
+
+    if (theta_sq < FixedMul(SMALL_ANGLE, SMALL_ANGLE)) {
+        fixed_t theta_4 = FixedMul(theta_sq, theta_sq);
+        A = FRACUNIT - theta_sq / 6 + theta_4 / 120;
+        B = (FRACUNIT >> 1) - theta_sq / 24 + theta_4 / 720;
+    } else {
+        fixed_t theta = fixed_sqrt(theta_sq);
+        uint32_t angle = (uint32_t)(((int64_t)theta * RAD_TO_ANGLE_Q16) >> FRACBITS);
+        A = FixedDiv(Sin_from_LUT_interp(angle), theta);
+        B = FixedDiv(FRACUNIT - Cos_from_LUT_interp(angle), theta_sq);
+    }
+
+    fixed_t xy = FixedMul(x, y), xz = FixedMul(x, z), yz = FixedMul(y, z);
+    fixed_t Ax = FixedMul(A, x), Ay = FixedMul(A, y), Az = FixedMul(A, z);
+
+    R[0] = FRACUNIT - FixedMul(B, yy + zz);
+    R[1] = -Az + FixedMul(B, xy);
+    R[2] =  Ay + FixedMul(B, xz);
+    R[3] =  Az + FixedMul(B, xy);
+    R[4] = FRACUNIT - FixedMul(B, xx + zz);
+    R[5] = -Ax + FixedMul(B, yz);
+    R[6] = -Ay + FixedMul(B, xz);
+    R[7] =  Ax + FixedMul(B, yz);
+    R[8] = FRACUNIT - FixedMul(B, xx + yy);
+}
+
+/**
+ * SO(3) logarithm: rotation vector w with R = exp(skew(w)).
+ *
+ * θ = atan2(|v|, (tr R - 1) / 2) with v = vee(R - Rᵀ) / 2 = sin θ · axis.
+ * Near θ = π the skew part vanishes, so the axis is recovered from the
+ * diagonal instead.
+ *
+ * @param R Rotation matrix (row-major)
+ * @param w Output rotation vector (radians, 16.16), |w| ∈ [0, π]
+ */
+void so3_log(const fixed_t R[9], fixed_t w[3]) {
+    fixed_t c = (R[0] + R[4] + R[8] - FRACUNIT) >> 1;
+    fixed_t v[3] = {
+        (R[7] - R[5]) >> 1,
+        (R[2] - R[6]) >> 1,
+        (R[3] - R[1]) >> 1
+    };
+    fixed_t s = (fixed_t)isqrt64((uint64_t)((int64_t)v[0] * v[0] +
+                                            (int64_t)v[1] * v[1] +
+                                            (int64_t)v[2] * v[2]));
+    uint32_t angle = fixed_atan2(s, c);
+    fixed_t theta = (fixed_t)(((uint64_t)angle * FIXED_2PI_Q16) >> 32);
+
+    if (theta < SMALL_ANGLE) {
+        /* θ / sin θ ≈ 1 + θ²/6 + 7θ⁴/360 */
+        fixed_t theta_sq = FixedMul(theta, theta);
+        fixed_t factor = FRACUNIT + theta_sq / 6 + FixedMul(theta_sq, theta_sq) * 7 / 360;
+        w[0] = FixedMul(v[0], factor);
+        w[1] = FixedMul(v[1], factor);
+        w[2] = FixedMul(v[2], factor);
+        return;
+    }
+
+    if (c > NEAR_PI_COS) {
+        fixed_t factor = FixedDiv(theta, s);
+        w[0] = FixedMul(v[0], factor);
+        w[1] = FixedMul(v[1], factor);
+        w[2] = FixedMul(v[2], factor);
+        return;
+    }
+
+    /* Near π: axis_k² = (R_kk - c) / (1 - c), k = largest diagonal */
+    int k = 0;
+    if (R[4] > R[k * 4]) k = 1;
+    if (R[8] > R[k * 4]) k = 2;
+    fixed_t one_minus_c = FRACUNIT - c;
+    fixed_t axis[3];
+    axis[k] = fixed_sqrt(FixedDiv(R[k * 4] - c, one_minus_c));
+    fixed_t denom = FixedMul(2 * one_minus_c, axis[k]);
+    for (int j = 0; j < 3; j++) {
+        if (j != k) {
+            axis[j] = FixedDiv(R[j * 3 + k] + R[k * 3 + j], denom);
+        }
+    }
+
+    /* Orient the axis along sin θ · axis (v), if v carries any signal */
+    int64_t dot = (int64_t)axis[0] * v[0] + (int64_t)axis[1] * v[1] + (int64_t)axis[2] * v[2];
+    if (dot < 0) {
+        axis[0] = -axis[0];
+        axis[1] = -axis[1];
+        axis[2] = -axis[2];
+    }
+    w[0] = FixedMul(axis[0], theta);
+    w[1] = FixedMul(axis[1], theta);
+    w[2] = FixedMul(axis[2], theta);
+}
+
+/**
+ * Scale an SE(3) pose: g^λ = [exp(λ log R), λ t].
+ *
+ * Fixed-point version of Python scale_se3_pose().
+ *
+ * @param g Input pose
+ * @param lambda Scaling factor (16.16)
+ * @param out Output pose (may alias g); metadata copied from g
+ */
+void se3_scale_pose(const se3_pose_t* g, fixed_t lambda, se3_pose_t* out) {
+    fixed_t R[9], w[3];
+    for (int k = 0; k < 9; k++) R[k] = g->rotation[k];
+    so3_log(R, w);
+    w[0] = FixedMul(w[0], lambda);
+    w[1] = FixedMul(w[1], lambda);
+    w[2] = FixedMul(w[2], lambda);
+    so3_exp(w, R);
+
+    fixed_t t0 = FixedMul(g->translation[0], lambda);
+    fixed_t t1 = FixedMul(g->translation[1], lambda);
+    fixed_t t2 = FixedMul(g->translation[2], lambda);
+    for (int k = 0; k < 9; k++) out->rotation[k] = R[k];
+    out->translation[0] = t0;
+    out->translation[1] = t1;
+    out->translation[2] = t2;
+    out->timestamp = g->timestamp;
+    out->mmsi = g->mmsi;
+}
+
+/* ========================================================================
+ * RETURN ERROR (internal accumulator with 64-bit translation)
+ * ======================================================================== */
+
+typedef struct {
+    fixed_t R[9];
+    int64_t t[3];   /* 16.16 meters, 64-bit to span multi-cell tracks */
+} lambda_acc_t;
+
+static inline void acc_identity(lambda_acc_t* acc) {
+    rotation_identity(acc->R);
+    acc->t[0] = acc->t[1] = acc->t[2] = 0;
+}
+
+/**
+ * acc = acc * [exp(λ w), λ t]
+ */
+static inline void acc_step(lambda_acc_t* acc, const fixed_t w[3], const fixed_t t[3],
+                            fixed_t lambda) {
+    fixed_t ws[3] = { FixedMul(w[0], lambda), FixedMul(w[1], lambda), FixedMul(w[2], lambda) };
+    fixed_t Rs[9];
+    so3_exp(ws, Rs);
+
+    int64_t ts[3];
+    for (int i = 0; i < 3; i++) {
+        ts[i] = ((int64_t)t[i] * lambda) >> FRACBITS;
+    }
+    for (int i = 0; i < 3; i++) {
+        acc->t[i] += ((int64_t)acc->R[i*3 + 0] * ts[0] +
+                      (int64_t)acc->R[i*3 + 1] * ts[1] +
+                      (int64_t)acc->R[i*3 + 2] * ts[2]) >> FRACBITS;
+    }
+    rotation_mul(acc->R, Rs, acc->R);
+}
+
+/**
+ * ε = ||G² - I||_F (rotation) + ||t(G²)|| (translation), saturating.
+ */
+static fixed_t acc_double_error(const lambda_acc_t* acc) {
+    fixed_t R2[9];
+    int64_t t2[3];
+    rotation_mul(acc->R, acc->R, R2);
+    for (int i = 0; i < 3; i++) {
+        t2[i] = (((int64_t)acc->R[i*3 + 0] * acc->t[0] +
+                  (int64_t)acc->R[i*3 + 1] * acc->t[1] +
+                  (int64_t)acc->R[i*3 + 2] * acc->t[2]) >> FRACBITS) + acc->t[i];
+    }
+
+    uint64_t rot_sq = 0;
+    for (int k = 0; k < 9; k++) {
+        int64_t d = R2[k] - ((k % 4 == 0) ? FRACUNIT : 0);
+        rot_sq += (uint64_t)(d * d);
+    }
+    int64_t rot_err = isqrt64(rot_sq);
+
+    /* Translation norm in Q8 to keep squares within 64 bits */
+    uint64_t trans_sq = 0;
+    for (int i = 0; i < 3; i++) {
+        int64_t q8 = t2[i] / 256;
+        trans_sq += (uint64_t)(q8 * q8);
+    }
+    int64_t trans_err = (int64_t)isqrt64(trans_sq) << 8;
+
+    int64_t total = rot_err + trans_err;
+    return (total > INT32_MAX) ? INT32_MAX : (fixed_t)total;
+}
+
+/**
+ * Return error for a scaled, doubled trajectory of steps.
+ *
+ * Fixed-point version of Python compute_return_error(double=True).
+ * Doubling is G_λ * G_λ (identical to composing the concatenated list).
+ *
+ * @param poses Trajectory steps (transformations applied in sequence)
+ * @param n Number of steps
+ * @param lambda Scaling factor (16.16)
+ * @return ε(λ) in 16.16 (saturates at INT32_MAX)
+ */
+fixed_t compute_return_error(const se3_pose_t* poses, int n, fixed_t lambda) {
+    lambda_acc_t acc;
+    acc_identity(&acc);
+    for (int i = 0; i < n; i++) {
+        fixed_t R[9], w[3], t[3];
+        for (int k = 0; k < 9; k++) R[k] = poses[i].rotation[k];
+        for (int k = 0; k < 3; k++) t[k] = poses[i].translation[k];
+        so3_log(R, w);
+        acc_step(&acc, w, t, lambda);
+    }
+    return acc_double_error(&acc);
+}
+
+/* ========================================================================
+ * GOLDEN-SECTION SEARCH
+ * ======================================================================== */
+
+typedef fixed_t (*lambda_cost_fn)(const void* ctx, fixed_t lambda);
+
+/**
+ * Golden-section search over bracket[0..1], narrowed in place.
+ *
+ * @param evals Optional: incremented by the number of cost evaluations
+ */
+static fixed_t golden_search_range(lambda_cost_fn cost, const void* ctx, fixed_t bracket[2],
+                                   fixed_t eps, int max_iter, fixed_t* error_out, int* evals) {
+    fixed_t a = bracket[0], b = bracket[1];
+    fixed_t c = b - FixedMul(b - a, INV_PHI);
+    fixed_t d = a + FixedMul(b - a, INV_PHI);
+    fixed_t fc = cost(ctx, c);
+    fixed_t fd = cost(ctx, d);
+    int n_evals = 2;
+
+    for (int iter = 0; iter < max_iter && (b - a) > eps; iter++) {
+        if (fc <= fd) {
+            b = d;
+            d = c;
+            fd = fc;
+            c = b - FixedMul(b - a, INV_PHI);
+            fc = cost(ctx, c);
+        } else {
+            a = c;
+            c = d;
+            fc = fd;
+            d = a + FixedMul(b - a, INV_PHI);
+            fd = cost(ctx, d);
+        }
+        n_evals++;
+    }
+    bracket[0] = a;
+    bracket[1] = b;
+    if (evals) *evals += n_evals;
+
+    if (fc <= fd) {
+        if (error_out) *error_out = fc;
+        return c;
+    }
+    if (error_out) *error_out = fd;
+    return d;
+}
+
+static fixed_t golden_search(lambda_cost_fn cost, const void* ctx,
+                             fixed_t eps, int max_iter, fixed_t* error_out) {
+    fixed_t bracket[2] = { LAMBDA_MIN, LAMBDA_MAX };
+    return golden_search_range(cost, ctx, bracket, eps, max_iter, error_out, NULL);
+}
+
+typedef struct {
+    const se3_pose_t* poses;
+    int n;
+} steps_ctx_t;
+
+static fixed_t steps_cost(const void* ctx, fixed_t lambda) {
+    const steps_ctx_t* s = (const steps_ctx_t*)ctx;
+    return compute_return_error(s->poses, s->n, lambda);
+}
+
+/**
+ * Estimate optimal λ for a trajectory of steps (no workspace).
+ *
+ * Golden-section search over [LAMBDA_MIN, LAMBDA_MAX] until the bracket
+ * is narrower than eps or max_iter iterations have run.
+ *
+ * @param poses Trajectory steps
+ * @param n Number of steps
+ * @param eps Bracket width tolerance (e.g. LAMBDA_EPSILON)
+ * @param max_iter Iteration budget (e.g. LAMBDA_MAX_ITER)
+ * @return λ* in 16.16
+ */
+fixed_t fast_lambda_estimate(const se3_pose_t* poses, int n, fixed_t eps, int max_iter) {
+    steps_ctx_t ctx = { poses, n };
+    return golden_search(steps_cost, &ctx, eps, max_iter, NULL);
+}
+
+/* ========================================================================
+ * WORKSPACE API (precomputed logs, gathered tracks)
+ * ======================================================================== */
+
+/**
+ * Load contiguous trajectory steps into a workspace.
+ *
+ * @param ws Workspace (caller-allocated, ~27 KB)
+ * @param steps Trajectory steps
+ * @param n Number of steps (truncated to LAMBDA_MAX_STEPS)
+ * @return Number of steps loaded
+ */
+int lambda_ws_load_steps(lambda_workspace_t* ws, const se3_pose_t* steps, int n) {
+    if (n > LAMBDA_MAX_STEPS) n = LAMBDA_MAX_STEPS;
+    for (int i = 0; i < n; i++) {
+        fixed_t R[9];
+        for (int k = 0; k < 9; k++) R[k] = steps[i].rotation[k];
+        so3_log(R, ws->w[i]);
+        for (int k = 0; k < 3; k++) ws->t[i][k] = steps[i].translation[k];
+    }
+    ws->n = n;
+    return n;
+}
+
+/**
+ * Load a track of absolute fixes as relative steps g_i⁻¹ g_{i+1}.
+ *
+ * Fixes are read in place through an index list (no pose copies), so a
+ * track stitched across several T-BSP cells is estimated in one pass.
+ *
+ * @param ws Workspace (caller-allocated)
+ * @param base Base of the pose storage the indices refer to
+ * @param index Flat pose indices in time order, or NULL for base[0..n-1]
+ * @param n Number of fixes (n fixes → n-1 steps)
+ * @return Number of steps loaded
+ */
+int lambda_ws_load_track(lambda_workspace_t* ws, const se3_pose_t* base,
+                         const uint16_t* index, int n) {
+    int steps = 0;
+    for (int i = 0; i + 1 < n && steps < LAMBDA_MAX_STEPS; i++) {
+        const se3_pose_t* p0 = index ? &base[index[i]] : &base[i];
+        const se3_pose_t* p1 = index ? &base[index[i + 1]] : &base[i + 1];
+        se3_pose_t rel;
+        fixed_t R[9];
+        se3_relative(p0, p1, &rel);
+        for (int k = 0; k < 9; k++) R[k] = rel.rotation[k];
+        so3_log(R, ws->w[steps]);
+        for (int k = 0; k < 3; k++) ws->t[steps][k] = rel.translation[k];
+        steps++;
+    }
+    ws->n = steps;
+    return steps;
+}
+
+/**
+ * ε(λ) over precomputed (log R, t) steps: n + 1 pose multiplies.
+ */
+static fixed_t steps_return_error(const fixed_t (*w)[3], const fixed_t (*t)[3], int n,
+                                  fixed_t lambda) {
+    lambda_acc_t acc;
+    acc_identity(&acc);
+    for (int i = 0; i < n; i++) {
+        acc_step(&acc, w[i], t[i], lambda);
+    }
+    return acc_double_error(&acc);
+}
+
+/**
+ * Return error ε(λ) from a loaded workspace (exp + compose per step).
+ */
+fixed_t lambda_ws_return_error(const lambda_workspace_t* ws, fixed_t lambda) {
+    return steps_return_error((const fixed_t (*)[3])ws->w, (const fixed_t (*)[3])ws->t,
+                              ws->n, lambda);
+}
+
+static fixed_t ws_cost(const void* ctx, fixed_t lambda) {
+    return lambda_ws_return_error((const lambda_workspace_t*)ctx, lambda);
+}
+
+/**
+ * Estimate optimal λ from a loaded workspace.
+ *
+ * @param ws Loaded workspace
+ * @param eps Bracket width tolerance
+ * @param max_iter Iteration budget
+ * @param error_out Optional output: ε(λ*)
+ * @return λ* in 16.16
+ */
+fixed_t lambda_ws_estimate(const lambda_workspace_t* ws, fixed_t eps, int max_iter,
+                           fixed_t* error_out) {
+    return golden_search(ws_cost, ws, eps, max_iter, error_out);
+}
+
+/* ========================================================================
+ * COARSE-TO-FINE SEARCH (pre-composed step pyramid)
+ * ======================================================================== */
+
+/**
+ * Build the coarse level of a workspace: runs of 2^levels consecutive
+ * steps (pairs, quads, ...) are pre-composed into one block each.
+ *
+ * A block h = g1 g2 ... stands in for g1^λ g2^λ ... in the coarse ε(λ).
+ * The two agree exactly at λ = 1 and differ by commutator terms
+ * elsewhere, so the coarse minimum is slightly biased; the fine
+ * iterations remove the bias. The level is the highest one at which no
+ * block can turn more than LAMBDA_PYRAMID_MAX_TURN (bounded by the sum
+ * of its step angles) or leave the 16.16 translation range, and at least
+ * LAMBDA_PYRAMID_MIN_BLOCKS blocks remain.
+ *
+ * Each run is composed left to right in one pass (exp + compose per
+ * step, one log per block), so the build costs about one ε evaluation.
+ *
+ * @param pyr Pyramid (caller-allocated, ~14 KB)
+ * @param ws Loaded workspace; must outlive the pyramid
+ * @param max_levels Level limit (clamped to LAMBDA_PYRAMID_LEVELS)
+ * @return Levels built (0: the search runs at full resolution only)
+ */
+int lambda_pyramid_build(lambda_pyramid_t* pyr, const lambda_workspace_t* ws, int max_levels) {
+    int n = ws->n;
+
+    if (max_levels > LAMBDA_PYRAMID_LEVELS) max_levels = LAMBDA_PYRAMID_LEVELS;
+    pyr->ws = ws;
+    pyr->n = 0;
+    pyr->levels = 0;
+    pyr->build_mults = 0;
+
+    /* Worst block turn and translation bound at every candidate level */
+    fixed_t turn[LAMBDA_PYRAMID_LEVELS + 1] = {0}, max_turn[LAMBDA_PYRAMID_LEVELS + 1] = {0};
+    int64_t dist[LAMBDA_PYRAMID_LEVELS + 1] = {0}, max_dist[LAMBDA_PYRAMID_LEVELS + 1] = {0};
+    for (int i = 0; i < n && max_levels > 0; i++) {
+        fixed_t theta = fixed_sqrt(vec3_norm_squared(ws->w[i]));
+        int64_t l1 = (int64_t)fixed_abs(ws->t[i][0]) + fixed_abs(ws->t[i][1]) +
+                     fixed_abs(ws->t[i][2]);
+        for (int l = 1; l <= max_levels; l++) {
+            turn[l] += theta;
+            dist[l] += l1;
+            if (((i + 1) & ((1 << l) - 1)) == 0 || i + 1 == n) {
+                if (turn[l] > max_turn[l]) max_turn[l] = turn[l];
+                if (dist[l] > max_dist[l]) max_dist[l] = dist[l];
+                turn[l] = 0;
+                dist[l] = 0;
+            }
+        }
+    }
+    int levels = 0;
+    for (int l = 1; l <= max_levels; l++) {
+        if (((n + (1 << l) - 1) >> l) < LAMBDA_PYRAMID_MIN_BLOCKS ||
+            max_turn[l] > LAMBDA_PYRAMID_MAX_TURN || max_dist[l] > INT32_MAX) break;
+        levels = l;
+    }
+    if (levels == 0) return 0;
+
+    int block = 1 << levels;
+    int m = 0;
+    for (int i = 0; i < n; i += block, m++) {
+        int end = (i + block < n) ? i + block : n;
+        lambda_acc_t acc;
+        acc_identity(&acc);
+        for (int j = i; j < end; j++) {
+            acc_step(&acc, ws->w[j], ws->t[j], FRACUNIT);
+        }
+        so3_log(acc.R, pyr->w[m]);
+        for (int k = 0; k < 3; k++) pyr->t[m][k] = (fixed_t)acc.t[k];
+        pyr->build_mults += (uint32_t)(end - i);
+    }
+    pyr->n = m;
+    pyr->levels = levels;
+    return levels;
+}
+
+static fixed_t pyramid_cost(const void* ctx, fixed_t lambda) {
+    const lambda_pyramid_t* pyr = (const lambda_pyramid_t*)ctx;
+    return steps_return_error((const fixed_t (*)[3])pyr->w, (const fixed_t (*)[3])pyr->t,
+                              pyr->n, lambda);
+}
+
+/**
+ * Estimate optimal λ coarse-to-fine.
+ *
+ * The first max_iter - LAMBDA_PYRAMID_FINE_ITER golden-section iterations
+ * run on the coarse level over [LAMBDA_MIN, LAMBDA_MAX]. The remaining
+ * LAMBDA_PYRAMID_FINE_ITER run on the full-resolution workspace, over the
+ * coarse bracket widened to at least ±LAMBDA_PYRAMID_MARGIN around the
+ * coarse estimate (the coarse bias is smaller than the margin on smooth
+ * tracks). With no coarse level this is lambda_ws_estimate(), bit-exact.
+ *
+ * A pose multiply is one SE(3) compose: n + 1 per ε evaluation over n
+ * steps (exp + compose per step, then the doubling), one per block pair
+ * when building.
+ *
+ * @param pyr Built pyramid
+ * @param eps Bracket width tolerance
+ * @param max_iter Total iteration budget (coarse + fine)
+ * @param error_out Optional output: full-resolution ε(λ*)
+ * @param pose_mults Optional output: pose multiplies, including the build
+ * @return λ* in 16.16
+ */
+fixed_t lambda_pyramid_estimate(const lambda_pyramid_t* pyr, fixed_t eps, int max_iter,
+                                fixed_t* error_out, uint32_t* pose_mults) {
+    const lambda_workspace_t* ws = pyr->ws;
+    fixed_t bracket[2] = { LAMBDA_MIN, LAMBDA_MAX };
+    int coarse_evals = 0, fine_evals = 0;
+    int fine_iter = max_iter;
+
+    if (pyr->levels > 0) {
+        if (fine_iter > LAMBDA_PYRAMID_FINE_ITER) fine_iter = LAMBDA_PYRAMID_FINE_ITER;
+        fixed_t lambda = golden_search_range(pyramid_cost, pyr, bracket, eps,
+                                             max_iter - fine_iter, NULL, &coarse_evals);
+        if (bracket[0] > lambda - LAMBDA_PYRAMID_MARGIN) bracket[0] = lambda - LAMBDA_PYRAMID_MARGIN;
+        if (bracket[1] < lambda + LAMBDA_PYRAMID_MARGIN) bracket[1] = lambda + LAMBDA_PYRAMID_MARGIN;
+        if (bracket[0] < LAMBDA_MIN) bracket[0] = LAMBDA_MIN;
+        if (bracket[1] > LAMBDA_MAX) bracket[1] = LAMBDA_MAX;
+    }
+    fixed_t lambda = golden_search_range(ws_cost, ws, bracket, eps, fine_iter, error_out,
+                                         &fine_evals);
+
+    if (pose_mults) {
+        *pose_mults = pyr->build_mults +
+                      (uint32_t)coarse_evals * (uint32_t)(pyr->n + 1) +
+                      (uint32_t)fine_evals * (uint32_t)(ws->n + 1);
+    }
+    return lambda;
+}
@@ -0,0 +1,533 @@
+/*
+ * replog.c - T-BSP Change Log Implementation
+ *
+ * Writer and mirror share the base-pose rule, so an insert record only
+ * carries differences against state the standby already holds.
+ *
+ * Reference: id-Software/DOOM linuxdoom-1.10/g_game.c (G_WriteDemoTiccmd,
+ *            G_ReadDemoTiccmd), d_net.c (consistancy)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "replog.h"
+#include <string.h>
+
+/* ========================================================================
+ * ENCODING HELPERS
+ * ======================================================================== */
+
+static inline uint64_t zigzag(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static inline int64_t unzigzag(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+static inline uint8_t* put_varint(uint8_t* p, uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static inline uint8_t* put_u16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static inline uint8_t* put_u32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+/** Bounded reader over a frame payload */
+typedef struct {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool ok;
+} reader_t;
+
+static uint64_t get_varint(reader_t* r) {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (r->p >= r->end) break;
+        uint8_t b = *r->p++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    r->ok = false;
+    return 0;
+}
+
+static uint16_t get_u16(reader_t* r) {
+    if (r->end - r->p < 2) {
+        r->ok = false;
+        return 0;
+    }
+    uint16_t v = (uint16_t)(r->p[0] | (r->p[1] << 8));
+    r->p += 2;
+    return v;
+}
+
+static uint32_t get_u32(reader_t* r) {
+    if (r->end - r->p < 4) {
+        r->ok = false;
+        return 0;
+    }
+    uint32_t v = (uint32_t)r->p[0] | ((uint32_t)r->p[1] << 8) |
+                 ((uint32_t)r->p[2] << 16) | ((uint32_t)r->p[3] << 24);
+    r->p += 4;
+    return v;
+}
+
+/**
+ * Fletcher-16 over the frame, skipping the checksum field itself.
+ */
+static uint16_t frame_check(const uint8_t* frame, size_t len) {
+    uint32_t a = 0, b = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (i == 10 || i == 11) continue;
+        a = (a + frame[i]) % 255;
+        b = (b + a) % 255;
+    }
+    return (uint16_t)((b << 8) | a);
+}
+
+/* ========================================================================
+ * SHARED STATE RULES
+ * ======================================================================== */
+
+static const se3_pose_t zero_pose;
+
+/**
+ * Base pose for the next insert into a cell holding `count` poses:
+ * slot count-1-back when back >= 0, else the cell's last pose, else zero.
+ */
+static const se3_pose_t* base_pose(const se3_pose_t* slab, int count, int back) {
+    if (back >= 0) return &slab[count - 1 - back];
+    return count > 0 ? &slab[count - 1] : &zero_pose;
+}
+
+static inline void cell_decode(uint16_t id, int* lat, int* lon) {
+    *lat = (int8_t)(id >> 8);
+    *lon = (int8_t)(id & 0xFF);
+}
+
+static void pending_add(replog_seal_t* pending, uint8_t* n, uint16_t cell_id, uint16_t count) {
+    for (int i = 0; i < *n; i++) {
+        if (pending[i].cell_id == cell_id) {
+            pending[i].pose_count = count;
+            return;
+        }
+    }
+    if (*n < REPLOG_MAX_PENDING) {
+        pending[*n].cell_id = cell_id;
+        pending[*n].pose_count = count;
+        (*n)++;
+    }
+}
+
+static void pending_remove(replog_seal_t* pending, uint8_t* n, uint16_t cell_id) {
+    for (int i = 0; i < *n; i++) {
+        if (pending[i].cell_id == cell_id) {
+            pending[i] = pending[--(*n)];
+            return;
+        }
+    }
+}
+
+/**
+ * Move pending seals into the new cell-ID window after a re-center
+ * (cells leaving the window are dropped, as t_bsp drops them).
+ */
+static void pending_rekey(replog_seal_t* pending, uint8_t* n, const t_bsp_t* bsp) {
+    int i = 0;
+    while (i < *n) {
+        int lat, lon;
+        cell_decode(pending[i].cell_id, &lat, &lon);
+        lat -= bsp->shift_lat;
+        lon -= bsp->shift_lon;
+        if (lat < -128 || lat > 127 || lon < -128 || lon > 127) {
+            pending[i] = pending[--(*n)];
+            continue;
+        }
+        pending[i].cell_id = (uint16_t)(((lat & 0xFF) << 8) | (lon & 0xFF));
+        i++;
+    }
+}
+
+/* ========================================================================
+ * WRITER
+ * ======================================================================== */
+
+void replog_writer_init(replog_writer_t* w, replog_sink_fn sink, void* ctx) {
+    memset(w, 0, sizeof(*w));
+    w->len = REPLOG_FRAME_HEADER;
+    w->sink = sink;
+    w->sink_ctx = ctx;
+}
+
+void replog_flush(replog_writer_t* w) {
+    if (w->n_records == 0) return;
+
+    uint8_t* h = w->frame;
+    h = put_u16(h, REPLOG_MAGIC);
+    h = put_u32(h, w->seq);
+    h = put_u16(h, w->n_records);
+    h = put_u16(h, (uint16_t)(w->len - REPLOG_FRAME_HEADER));
+    put_u16(h, frame_check(w->frame, w->len));
+
+    if (w->sink) w->sink(w->sink_ctx, w->frame, w->len);
+    w->bytes_sent += w->len;
+    w->frames_sent++;
+    w->seq++;
+    w->len = REPLOG_FRAME_HEADER;
+    w->n_records = 0;
+    w->has_last_cell = 0;
+}
+
+/**
+ * Start a record: make room, write the opcode byte and (optionally) the
+ * cell. Returns the write cursor; *op points at the opcode byte.
+ */
+static uint8_t* record_begin(replog_writer_t* w, uint8_t opcode, bool has_cell, uint16_t cell_id,
+                             uint8_t** op) {
+    if (w->len + REPLOG_RECORD_MAX > REPLOG_FRAME_MAX) replog_flush(w);
+    uint8_t* p = w->frame + w->len;
+    *op = p;
+    *p++ = (uint8_t)(opcode << 5);
+    if (has_cell) {
+        if (w->has_last_cell && w->last_cell == cell_id) {
+            **op |= REPLOG_F_SAME_CELL;
+        } else {
+            p = put_u16(p, cell_id);
+            w->last_cell = cell_id;
+            w->has_last_cell = 1;
+        }
+    }
+    return p;
+}
+
+static inline void record_end(replog_writer_t* w, const uint8_t* p) {
+    w->len = (uint16_t)(p - w->frame);
+    w->n_records++;
+}
+
+/**
+ * Encode an insert of `pose` into a cell whose slab holds `count` poses.
+ */
+static void log_insert(replog_writer_t* w, uint16_t cell_id, const se3_pose_t* slab, int count,
+                       const se3_pose_t* pose) {
+    uint8_t* op;
+    uint8_t* p = record_begin(w, REPLOG_OP_INSERT, true, cell_id, &op);
+
+    /* Same vessel's latest fix in this cell, searched newest first */
+    int back = -1;
+    int scan = count < REPLOG_BASE_SCAN ? count : REPLOG_BASE_SCAN;
+    for (int d = 0; d < scan; d++) {
+        if (slab[count - 1 - d].mmsi == pose->mmsi) {
+            back = d;
+            break;
+        }
+    }
+    const se3_pose_t* base = base_pose(slab, count, back);
+
+    if (back >= 0) {
+        *op |= REPLOG_F_BASE_REF;
+        p = put_varint(p, (uint64_t)back);
+    } else {
+        p = put_u32(p, pose->mmsi);
+    }
+    p = put_varint(p, zigzag((int64_t)pose->timestamp - (int64_t)base->timestamp));
+    for (int k = 0; k < 3; k++) {
+        p = put_varint(p, zigzag((int64_t)pose->translation[k] - base->translation[k]));
+    }
+    if (memcmp(pose->rotation, base->rotation, sizeof(pose->rotation)) == 0) {
+        *op |= REPLOG_F_SAME_ROT;
+    } else {
+        for (int k = 0; k < 9; k++) {
+            p = put_varint(p, zigzag((int64_t)pose->rotation[k] - base->rotation[k]));
+        }
+    }
+    record_end(w, p);
+    w->inserts++;
+}
+
+bool replog_insert(replog_writer_t* w, t_bsp_t* bsp, uint16_t cell_id, const se3_pose_t* pose) {
+    const t_bsp_cell_t* cell = t_bsp_get_cell(bsp, cell_id);
+    int count = cell ? cell->pose_count : 0;
+    const se3_pose_t* slab = cell ? t_bsp_cell_poses(bsp, cell) : NULL;
+
+    if (!t_bsp_insert_pose(bsp, cell_id, pose)) {
+        return false;  /* Mirror would fail identically; nothing to log */
+    }
+    log_insert(w, cell_id, slab, count, pose);
+    return true;
+}
+
+void replog_reset_cell(replog_writer_t* w, t_bsp_t* bsp, uint16_t cell_id) {
+    t_bsp_reset_cell(bsp, cell_id);
+    uint8_t* op;
+    uint8_t* p = record_begin(w, REPLOG_OP_RESET, true, cell_id, &op);
+    record_end(w, p);
+}
+
+static void log_seal(replog_writer_t* w, uint16_t cell_id, uint16_t pose_count, bool done) {
+    uint8_t* op;
+    uint8_t* p = record_begin(w, REPLOG_OP_SEAL, true, cell_id, &op);
+    if (done) *op |= REPLOG_F_DONE;
+    p = put_varint(p, pose_count);
+    record_end(w, p);
+}
+
+bool replog_seal(replog_writer_t* w, uint16_t cell_id, uint16_t pose_count) {
+    bool known = false;
+    for (int i = 0; i < w->n_pending; i++) known |= w->pending[i].cell_id == cell_id;
+    if (!known && w->n_pending >= REPLOG_MAX_PENDING) return false;
+
+    pending_add(w->pending, &w->n_pending, cell_id, pose_count);
+    log_seal(w, cell_id, pose_count, false);
+    return true;
+}
+
+void replog_seal_done(replog_writer_t* w, uint16_t cell_id) {
+    pending_remove(w->pending, &w->n_pending, cell_id);
+    log_seal(w, cell_id, 0, true);
+}
+
+int replog_recenter_begin(replog_writer_t* w, t_bsp_t* bsp, fixed_t lat, fixed_t lon) {
+    int dropping = t_bsp_recenter_begin(bsp, lat, lon);
+    if (bsp->recentering) {
+        pending_rekey(w->pending, &w->n_pending, bsp);
+    }
+    uint8_t* op;
+    uint8_t* p = record_begin(w, REPLOG_OP_RECENTER, false, 0, &op);
+    p = put_u32(p, (uint32_t)lat);
+    p = put_u32(p, (uint32_t)lon);
+    record_end(w, p);
+    return dropping;
+}
+
+void replog_snapshot(replog_writer_t* w, t_bsp_t* bsp) {
+    if (bsp->recentering) {
+        t_bsp_recenter_step(bsp, MAX_CELLS);
+    }
+    replog_flush(w);
+
+    uint8_t* op;
+    uint8_t* p = record_begin(w, REPLOG_OP_SNAPSHOT, false, 0, &op);
+    p = put_u32(p, (uint32_t)bsp->ref_lat);
+    p = put_u32(p, (uint32_t)bsp->ref_lon);
+    p = put_u32(p, (uint32_t)bsp->center_lat_idx);
+    p = put_u32(p, (uint32_t)bsp->center_lon_idx);
+    record_end(w, p);
+
+    /* Re-insert each cell's live poses in slot order */
+    for (int i = 0; i < MAX_CELLS; i++) {
+        const t_bsp_cell_t* cell = &bsp->cells[i];
+        if (!cell->active) continue;
+        const se3_pose_t* slab = t_bsp_cell_poses(bsp, cell);
+        for (int j = 0; j < cell->pose_count; j++) {
+            log_insert(w, cell->cell_id, slab, j, &slab[j]);
+        }
+    }
+    for (int i = 0; i < w->n_pending; i++) {
+        log_seal(w, w->pending[i].cell_id, w->pending[i].pose_count, false);
+    }
+    replog_flush(w);
+}
+
+/* ========================================================================
+ * MIRROR
+ * ======================================================================== */
+
+void replog_mirror_init(replog_mirror_t* m, t_bsp_t* bsp) {
+    memset(m, 0, sizeof(*m));
+    m->bsp = bsp;
+}
+
+static uint16_t read_cell(replog_mirror_t* m, reader_t* r, uint8_t flags) {
+    if (flags & REPLOG_F_SAME_CELL) {
+        if (!m->has_last_cell) r->ok = false;
+        return m->last_cell;
+    }
+    m->last_cell = get_u16(r);
+    m->has_last_cell = 1;
+    return m->last_cell;
+}
+
+static void apply_insert(replog_mirror_t* m, reader_t* r, uint8_t flags) {
+    t_bsp_t* bsp = m->bsp;
+    uint16_t cell_id = read_cell(m, r, flags);
+    const t_bsp_cell_t* cell = t_bsp_get_cell(bsp, cell_id);
+    int count = cell ? cell->pose_count : 0;
+    const se3_pose_t* slab = cell ? t_bsp_cell_poses(bsp, cell) : NULL;
+
+    se3_pose_t pose;
+    const se3_pose_t* base;
+    if (flags & REPLOG_F_BASE_REF) {
+        uint64_t back = get_varint(r);
+        if (!r->ok || back >= (uint64_t)count) {
+            r->ok = false;
+            return;
+        }
+        base = base_pose(slab, count, (int)back);
+        pose.mmsi = base->mmsi;
+    } else {
+        base = base_pose(slab, count, -1);
+        pose.mmsi = get_u32(r);
+    }
+    pose.timestamp = (uint32_t)((int64_t)base->timestamp + unzigzag(get_varint(r)));
+    for (int k = 0; k < 3; k++) {
+        pose.translation[k] = (fixed_t)(uint32_t)(base->translation[k] + unzigzag(get_varint(r)));
+    }
+    if (flags & REPLOG_F_SAME_ROT) {
+        memcpy(pose.rotation, base->rotation, sizeof(pose.rotation));
+    } else {
+        for (int k = 0; k < 9; k++) {
+            pose.rotation[k] = (fixed_t)(uint32_t)(base->rotation[k] + unzigzag(get_varint(r)));
+        }
+    }
+    if (r->ok) t_bsp_insert_pose(bsp, cell_id, &pose);
+}
+
+/**
+ * Apply one record; false on a malformed record.
+ */
+static bool apply_record(replog_mirror_t* m, reader_t* r) {
+    if (r->p >= r->end) return false;
+    uint8_t b = *r->p++;
+    uint8_t opcode = b >> 5;
+    uint8_t flags = b & 0x1F;
+    t_bsp_t* bsp = m->bsp;
+
+    switch (opcode) {
+    case REPLOG_OP_INSERT:
+        apply_insert(m, r, flags);
+        break;
+    case REPLOG_OP_RESET: {
+        uint16_t cell_id = read_cell(m, r, flags);
+        if (r->ok) t_bsp_reset_cell(bsp, cell_id);
+        break;
+    }
+    case REPLOG_OP_SEAL: {
+        uint16_t cell_id = read_cell(m, r, flags);
+        uint64_t count = get_varint(r);
+        if (!r->ok || count > MAX_POSES_PER_CELL) return false;
+        if (flags & REPLOG_F_DONE) {
+            pending_remove(m->pending, &m->n_pending, cell_id);
+        } else {
+            pending_add(m->pending, &m->n_pending, cell_id, (uint16_t)count);
+        }
+        break;
+    }
+    case REPLOG_OP_RECENTER: {
+        fixed_t lat = (fixed_t)get_u32(r);
+        fixed_t lon = (fixed_t)get_u32(r);
+        if (!r->ok) return false;
+        t_bsp_recenter_begin(bsp, lat, lon);
+        if (bsp->recentering) {
+            pending_rekey(m->pending, &m->n_pending, bsp);
+            t_bsp_recenter_step(bsp, MAX_CELLS);
+        }
+        break;
+    }
+    case REPLOG_OP_SNAPSHOT: {
+        fixed_t ref_lat = (fixed_t)get_u32(r);
+        fixed_t ref_lon = (fixed_t)get_u32(r);
+        int32_t c_lat = (int32_t)get_u32(r);
+        int32_t c_lon = (int32_t)get_u32(r);
+        if (!r->ok) return false;
+        t_bsp_init(bsp, ref_lat, ref_lon);
+        bsp->center_lat_idx = c_lat;
+        bsp->center_lon_idx = c_lon;
+        m->n_pending = 0;
+        break;
+    }
+    default:
+        return false;
+    }
+    if (r->ok) m->records_applied++;
+    return r->ok;
+}
+
+int replog_apply(replog_mirror_t* m, const uint8_t* frame, size_t len) {
+    if (len < REPLOG_FRAME_HEADER + 1) {
+        m->frames_rejected++;
+        return REPLOG_ERR_FORMAT;
+    }
+    reader_t hdr = { frame, frame + REPLOG_FRAME_HEADER, true };
+    uint16_t magic = get_u16(&hdr);
+    uint32_t seq = get_u32(&hdr);
+    uint16_t n_records = get_u16(&hdr);
+    uint16_t payload = get_u16(&hdr);
+    uint16_t check = get_u16(&hdr);
+    if (magic != REPLOG_MAGIC || (size_t)payload + REPLOG_FRAME_HEADER != len) {
+        m->frames_rejected++;
+        return REPLOG_ERR_FORMAT;
+    }
+    if (check != frame_check(frame, len)) {
+        m->frames_rejected++;
+        return REPLOG_ERR_CHECKSUM;
+    }
+
+    bool snapshot = (frame[REPLOG_FRAME_HEADER] >> 5) == REPLOG_OP_SNAPSHOT;
+    if (!snapshot) {
+        if (!m->synced) {
+            m->frames_rejected++;
+            return REPLOG_ERR_UNSYNCED;
+        }
+        if (seq != m->next_seq) {
+            m->synced = 0;
+            m->frames_rejected++;
+            return REPLOG_ERR_GAP;
+        }
+    }
+
+    reader_t r = { frame + REPLOG_FRAME_HEADER, frame + len, true };
+    m->has_last_cell = 0;
+    for (uint16_t i = 0; i < n_records; i++) {
+        if (!apply_record(m, &r)) {
+            m->synced = 0;  /* Partially applied: needs a snapshot */
+            m->frames_rejected++;
+            return REPLOG_ERR_FORMAT;
+        }
+    }
+    m->synced = 1;
+    m->next_seq = seq + 1;
+    m->frames_applied++;
+    return REPLOG_OK;
+}
+
+int replog_mirror_pending(const replog_mirror_t* m, replog_seal_t* out, int max) {
+    int n = m->n_pending < max ? m->n_pending : max;
+    memcpy(out, m->pending, (size_t)n * sizeof(replog_seal_t));
+    return n;
+}
+
+uint32_t replog_digest(const t_bsp_t* bsp) {
+    uint32_t sum = 0;
+    for (int i = 0; i < MAX_CELLS; i++) {
+        const t_bsp_cell_t* cell = &bsp->cells[i];
+        if (!cell->active) continue;
+
+        /* FNV-1a per cell; cells combine by addition (slot order free) */
+        uint32_t h = 2166136261u;
+        uint8_t key[4] = { (uint8_t)cell->cell_id, (uint8_t)(cell->cell_id >> 8),
+                           (uint8_t)cell->pose_count, (uint8_t)(cell->pose_count >> 8) };
+        for (int k = 0; k < 4; k++) h = (h ^ key[k]) * 16777619u;
+        const uint8_t* p = (const uint8_t*)&bsp->poses[i][0];
+        size_t n = (size_t)cell->pose_count * sizeof(se3_pose_t);
+        for (size_t k = 0; k < n; k++) h = (h ^ p[k]) * 16777619u;
+        sum += h;
+    }
+    return sum;
+}
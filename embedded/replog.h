@@ -0,0 +1,242 @@
+/*
+ * replog.h - Primary/Standby Replication of T-BSP State via a Change Log
+ *
+ * The primary wraps its T-BSP mutations (insert, reset, seal, re-center)
+ * in replog_* calls that apply the change locally and append a compact
+ * record to the current batch. Full batches (or replog_flush()) go out as
+ * one frame through a caller-supplied sink; the standby applies frames to
+ * a mirror t_bsp_t with replog_apply(). On failover the mirror is already
+ * current: only the pending seals need re-running.
+ *
+ * Delta encoding: an insert is encoded against a base pose both sides
+ * already hold - the vessel's most recent fix in the same cell (a 1-byte
+ * back-reference), else the cell's last fix, else zero. Fields are zigzag
+ * varints of the difference, so only changed bits travel and the mirror
+ * stays bit-exact.
+ *
+ * Frame (little-endian, REPLOG_FRAME_HEADER bytes + payload):
+ *   magic u16 "RL", seq u32, n_records u16, payload_len u16, fletcher16 u16
+ * Records (op in bits 7-5, flags in bits 4-0 of the first byte):
+ *   INSERT   [cell u16] (back varint | mmsi u32) dts rel[3] [rot[9]]
+ *   RESET    [cell u16]
+ *   SEAL     [cell u16] pose_count varint        (flag DONE clears it)
+ *   RECENTER lat i32, lon i32
+ *   SNAPSHOT ref_lat i32, ref_lon i32, center_lat_idx i32, center_lon_idx i32
+ *
+ * A sequence gap desynchronizes the mirror until a frame that starts with
+ * SNAPSHOT arrives (the primary sends one on request via replog_snapshot()).
+ *
+ * Doom Lineage:
+ *   - Doom demo lumps (G_WriteDemoTiccmd: per-tic input deltas replayed
+ *     by G_ReadDemoTiccmd to reproduce identical game state) → change
+ *     records replayed into a mirror t_bsp_t
+ *   - Doom net consistency check (consistancy[]) → replog_digest()
+ *
+ * Hardware Target: ESP32-S3 (writer ~1.1 KB, mirror ~100 bytes + t_bsp_t)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#ifndef REPLOG_H
+#define REPLOG_H
+
+#include "se3_edge.h"
+#include "t_bsp.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * CONFIGURATION CONSTANTS
+ * ======================================================================== */
+
+#ifndef REPLOG_FRAME_MAX
+#define REPLOG_FRAME_MAX     1024    /* Frame bytes incl. header */
+#endif
+
+#ifndef REPLOG_MAX_PENDING
+#define REPLOG_MAX_PENDING   16      /* Seals awaiting λ-estimation */
+#endif
+
+#ifndef REPLOG_BASE_SCAN
+#define REPLOG_BASE_SCAN     32      /* Slots searched for the vessel's last fix */
+#endif
+
+#define REPLOG_FRAME_HEADER  12
+#define REPLOG_RECORD_MAX    80      /* Worst-case encoded record */
+#define REPLOG_MAGIC         0x4C52u /* "RL" little-endian */
+
+_Static_assert(REPLOG_FRAME_MAX >= REPLOG_FRAME_HEADER + REPLOG_RECORD_MAX,
+               "frame must hold one record");
+_Static_assert(REPLOG_FRAME_MAX <= 65535, "payload_len is uint16_t");
+
+/* Record opcodes (bits 7-5) */
+#define REPLOG_OP_INSERT     0
+#define REPLOG_OP_RESET      1
+#define REPLOG_OP_SEAL       2
+#define REPLOG_OP_RECENTER   3
+#define REPLOG_OP_SNAPSHOT   4
+
+/* Record flags (bits 4-0) */
+#define REPLOG_F_SAME_CELL   0x01    /* Cell = previous record's cell */
+#define REPLOG_F_BASE_REF    0x02    /* INSERT: base is a same-vessel back-reference */
+#define REPLOG_F_SAME_ROT    0x04    /* INSERT: rotation equals the base's */
+#define REPLOG_F_DONE        0x02    /* SEAL: estimation finished */
+
+/* replog_apply() results */
+#define REPLOG_OK             0
+#define REPLOG_ERR_CHECKSUM  -1
+#define REPLOG_ERR_GAP       -2      /* Missed frame: mirror needs a snapshot */
+#define REPLOG_ERR_FORMAT    -3
+#define REPLOG_ERR_UNSYNCED  -4      /* Waiting for a snapshot frame */
+
+/* ========================================================================
+ * DATA STRUCTURES
+ * ======================================================================== */
+
+/** Cell handed to λ-estimation and not yet published */
+typedef struct {
+    uint16_t cell_id;
+    uint16_t pose_count;       /**< Poses the estimation covers */
+} replog_seal_t;
+
+/** Frame sink (UDP send, pipe write, ...) */
+typedef void (*replog_sink_fn)(void* ctx, const uint8_t* frame, size_t len);
+
+/** Primary-side log writer */
+typedef struct {
+    uint8_t frame[REPLOG_FRAME_MAX];
+    uint16_t len;              /**< Bytes used (header included) */
+    uint16_t n_records;
+    uint32_t seq;              /**< Sequence of the frame being built */
+    uint16_t last_cell;
+    uint8_t has_last_cell;
+    uint8_t n_pending;
+    replog_seal_t pending[REPLOG_MAX_PENDING];
+    replog_sink_fn sink;
+    void* sink_ctx;
+    uint64_t bytes_sent;       /**< Diagnostic: frame bytes handed to sink */
+    uint32_t frames_sent;
+    uint32_t inserts;          /**< Diagnostic: insert records logged */
+} replog_writer_t;
+
+/** Standby-side mirror state */
+typedef struct {
+    t_bsp_t* bsp;              /**< Mirror grid (caller-allocated) */
+    uint32_t next_seq;
+    uint8_t synced;            /**< Snapshot applied, no gap since */
+    uint8_t has_last_cell;
+    uint16_t last_cell;
+    uint8_t n_pending;
+    uint8_t _padding[3];
+    replog_seal_t pending[REPLOG_MAX_PENDING];
+    uint64_t records_applied;
+    uint32_t frames_applied;
+    uint32_t frames_rejected;
+} replog_mirror_t;
+
+/* ========================================================================
+ * API FUNCTIONS - PRIMARY
+ * ======================================================================== */
+
+/**
+ * Initialize a writer.
+ *
+ * @param w Writer (caller-allocated)
+ * @param sink Called with each completed frame
+ * @param ctx Passed to sink
+ */
+void replog_writer_init(replog_writer_t* w, replog_sink_fn sink, void* ctx);
+
+/**
+ * Insert a pose locally and log it (replaces t_bsp_insert_pose()).
+ *
+ * @return Result of t_bsp_insert_pose()
+ */
+bool replog_insert(replog_writer_t* w, t_bsp_t* bsp, uint16_t cell_id, const se3_pose_t* pose);
+
+/**
+ * Reset a cell locally and log it (replaces t_bsp_reset_cell()).
+ */
+void replog_reset_cell(replog_writer_t* w, t_bsp_t* bsp, uint16_t cell_id);
+
+/**
+ * Log that a cell's first pose_count poses were handed to λ-estimation.
+ *
+ * @return false if REPLOG_MAX_PENDING seals are already outstanding
+ */
+bool replog_seal(replog_writer_t* w, uint16_t cell_id, uint16_t pose_count);
+
+/**
+ * Log that a sealed cell's estimation was published.
+ */
+void replog_seal_done(replog_writer_t* w, uint16_t cell_id);
+
+/**
+ * Begin a grid re-center locally and log it (replaces
+ * t_bsp_recenter_begin(); keep calling t_bsp_recenter_step() as usual).
+ *
+ * @return Result of t_bsp_recenter_begin()
+ */
+int replog_recenter_begin(replog_writer_t* w, t_bsp_t* bsp, fixed_t lat, fixed_t lon);
+
+/**
+ * Log the full state (grid window, every active cell, pending seals) in
+ * a fresh frame sequence. Used at start-up and when a standby reports a
+ * gap. Finishes a running re-center first.
+ */
+void replog_snapshot(replog_writer_t* w, t_bsp_t* bsp);
+
+/**
+ * Send the current batch (no-op if empty). Call periodically to bound
+ * replication lag.
+ */
+void replog_flush(replog_writer_t* w);
+
+/* ========================================================================
+ * API FUNCTIONS - STANDBY
+ * ======================================================================== */
+
+/**
+ * Initialize a mirror (unsynced until the first snapshot frame).
+ *
+ * @param m Mirror state
+ * @param bsp Mirror grid (contents replaced by the snapshot)
+ */
+void replog_mirror_init(replog_mirror_t* m, t_bsp_t* bsp);
+
+/**
+ * Verify and apply one frame.
+ *
+ * @param m Mirror
+ * @param frame Frame bytes
+ * @param len Frame length
+ * @return REPLOG_OK or REPLOG_ERR_*
+ */
+int replog_apply(replog_mirror_t* m, const uint8_t* frame, size_t len);
+
+/**
+ * Seals to re-run after promotion to primary.
+ *
+ * @param m Mirror
+ * @param out Output array
+ * @param max Capacity
+ * @return Number written
+ */
+int replog_mirror_pending(const replog_mirror_t* m, replog_seal_t* out, int max);
+
+/**
+ * Order-independent digest of the grid's logical state (active cells and
+ * their live poses), for comparing primary and mirror.
+ */
+uint32_t replog_digest(const t_bsp_t* bsp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REPLOG_H */
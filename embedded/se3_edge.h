@@ -134,6 +134,23 @@ static inline fixed_t Cos_from_LUT(uint32_t angle) {
     return finesine[(angle_plus_90 >> (32 - ANGLE_BITS)) & ANGLE_MASK];
 }
 
+/**
+ * Fused sine/cosine from LUT using 32-bit angle.
+ *
+ * Computes the table index once and derives the cosine index by a
+ * quarter-table offset, so both loads share one shift/mask. Results are
+ * bit-identical to Sin_from_LUT()/Cos_from_LUT().
+ *
+ * @param angle 32-bit angle (0x00000000 = 0°, 0xFFFFFFFF = ~360°)
+ * @param s Output: sin(angle) in 16.16 fixed-point
+ * @param c Output: cos(angle) in 16.16 fixed-point
+ */
+static inline void SinCos_from_LUT(uint32_t angle, fixed_t* s, fixed_t* c) {
+    uint32_t index = angle >> (32 - ANGLE_BITS);
+    *s = finesine[index & ANGLE_MASK];
+    *c = finesine[(index + (NUM_FINE_ANGLES / 4)) & ANGLE_MASK];
+}
+
 /* ========================================================================
  * SE(3) DATA STRUCTURES (ESP32-S3 optimized)
  * ======================================================================== */
@@ -218,6 +235,63 @@ typedef struct {
     uint8_t signature[64];      /* ed25519 signature (64 bytes) */
 } dlt_record_t;                 /* Total: 148 bytes */
 
+/* ========================================================================
+ * λ-ESTIMATION WORKSPACE
+ * ======================================================================== */
+
+/* Max steps per estimate: a track stitched from a 3x3 cell neighbourhood */
+#define LAMBDA_MAX_STEPS     1152
+
+/**
+ * Precomputed λ-independent step data (see lambda_estimator.c).
+ *
+ * log R of each step is computed once at load time, so every ε(λ)
+ * evaluation of the search is exp + compose only.
+ */
+typedef struct {
+    fixed_t w[LAMBDA_MAX_STEPS][3];  /* so(3) log of step rotation (rad) */
+    fixed_t t[LAMBDA_MAX_STEPS][3];  /* Step translation (m) */
+    int n;                           /* Steps loaded */
+} lambda_workspace_t;                /* ~27 KB: static or heap, not stack */
+
+/* Coarse-to-fine search: at most 2^levels steps per coarse block */
+#ifndef LAMBDA_PYRAMID_LEVELS
+#define LAMBDA_PYRAMID_LEVELS      4
+#endif
+
+/* Golden-section iterations run at full resolution after the coarse search */
+#ifndef LAMBDA_PYRAMID_FINE_ITER
+#define LAMBDA_PYRAMID_FINE_ITER   2
+#endif
+
+/* Stop coarsening below this many blocks (the loop shape must survive) */
+#define LAMBDA_PYRAMID_MIN_BLOCKS  8
+
+/* Min half-width (λ) of the full-resolution bracket around the coarse λ */
+#ifndef LAMBDA_PYRAMID_MARGIN
+#define LAMBDA_PYRAMID_MARGIN      FLOAT_TO_FIXED(0.01f)
+#endif
+
+/* Max block rotation (rad): λ θ stays below π for λ ≤ LAMBDA_MAX, so
+ * exp(λ log R) of a block never wraps */
+#define LAMBDA_PYRAMID_MAX_TURN    FLOAT_TO_FIXED(1.5707963f)
+
+/**
+ * Coarse level of a workspace (see lambda_pyramid_build()).
+ *
+ * Runs of 2^levels consecutive steps (pairs, quads, ...) are pre-composed
+ * into one block each, so a coarse ε(λ) evaluation costs n / 2^levels
+ * pose multiplies instead of n.
+ */
+typedef struct {
+    fixed_t w[(LAMBDA_MAX_STEPS + 1) / 2][3];  /* so(3) log of block rotation */
+    fixed_t t[(LAMBDA_MAX_STEPS + 1) / 2][3];  /* Block translation (m) */
+    const lambda_workspace_t* ws;              /* Full-resolution steps */
+    int n;                                     /* Blocks at the coarse level */
+    int levels;                                /* 0 = no coarse level */
+    uint32_t build_mults;                      /* Pose multiplies to build */
+} lambda_pyramid_t;                            /* ~14 KB */
+
 /* ========================================================================
  * FUNCTION DECLARATIONS
  * ======================================================================== */
@@ -227,7 +301,14 @@ void se3_init_tables(void);
 fixed_t normalize_lon(fixed_t lon);
 void rotation_identity(fixed_t R[9]);
 void rotation_from_yaw(uint32_t yaw, fixed_t R[9]);
+void rotation_from_euler(uint32_t roll, uint32_t pitch, uint32_t yaw, fixed_t R[9]);
+void rotation_from_quaternion(const fixed_t q[4], fixed_t R[9]);
+void rotation_from_euler_batch(const uint32_t* roll, const uint32_t* pitch,
+                               const uint32_t* yaw, int n, fixed_t* R_out);
+void rotation_from_quaternion_batch(const fixed_t* q, int n, fixed_t* R_out);
+void rotation_renormalize(fixed_t R[9]);
 uint32_t heading_to_angle(fixed_t heading_deg);
+uint32_t degrees_to_angle(fixed_t deg);
 void rotation_mul(const fixed_t A[9], const fixed_t B[9], fixed_t C[9]);
 fixed_t rotation_trace(const fixed_t R[9]);
 fixed_t vec3_norm_squared(const fixed_t v[3]);
@@ -237,10 +318,28 @@ void se3_pose_identity(se3_pose_t* pose);
 void se3_pose_from_gps(fixed_t east, fixed_t north, fixed_t up,
                        fixed_t heading_deg, uint32_t timestamp,
                        uint32_t mmsi, se3_pose_t* pose);
+void se3_pose_from_attitude(fixed_t east, fixed_t north, fixed_t up,
+                            fixed_t roll_deg, fixed_t pitch_deg, fixed_t heading_deg,
+                            uint32_t timestamp, uint32_t mmsi, se3_pose_t* pose);
+uint32_t isqrt64(uint64_t x);
+fixed_t fixed_sqrt(fixed_t x);
+uint32_t fixed_atan2(fixed_t y, fixed_t x);
 fixed_t fixed_abs(fixed_t val);
 fixed_t fixed_saturate(fixed_t val, fixed_t min_val, fixed_t max_val);
 bool fixed_in_range(fixed_t val, fixed_t min_val, fixed_t max_val);
 
+/* SE(3) group operations (se3_group.c) */
+void se3_compose(const se3_pose_t* a, const se3_pose_t* b, se3_pose_t* out);
+void se3_compose_inplace(se3_pose_t* acc, const se3_pose_t* b);
+void se3_inverse(const se3_pose_t* g, se3_pose_t* out);
+void se3_inverse_inplace(se3_pose_t* g);
+void se3_relative(const se3_pose_t* g1, const se3_pose_t* g2, se3_pose_t* out);
+void se3_transform_points(const se3_pose_t* g, const fixed_t* pts, int n, fixed_t* out);
+void se3_compose_batch(const se3_pose_t* a, const se3_pose_t* b, int n, se3_pose_t* out);
+void se3_inverse_batch(const se3_pose_t* g, int n, se3_pose_t* out);
+void se3_relative_batch(const se3_pose_t* poses, int n, se3_pose_t* out);
+void se3_compose_trajectory(const se3_pose_t* poses, int n, se3_pose_t* out);
+
 /* Trigonometric LUT validation (trig_tables.c) */
 fixed_t get_sine_table_entry(uint16_t index);
 fixed_t get_cosine_table_entry(uint16_t index);
@@ -268,6 +367,18 @@ bool validate_handoff_packet(const handoff_packet_t* pkt, uint32_t current_time)
 fixed_t compute_return_error(const se3_pose_t* poses, int n, fixed_t lambda);
 fixed_t adjust_lambda(fixed_t lambda, fixed_t error);
 fixed_t fast_lambda_estimate(const se3_pose_t* poses, int n, fixed_t eps, int max_iter);
+void so3_exp(const fixed_t w[3], fixed_t R[9]);
+void so3_log(const fixed_t R[9], fixed_t w[3]);
+void se3_scale_pose(const se3_pose_t* g, fixed_t lambda, se3_pose_t* out);
+int lambda_ws_load_steps(lambda_workspace_t* ws, const se3_pose_t* steps, int n);
+int lambda_ws_load_track(lambda_workspace_t* ws, const se3_pose_t* base,
+                         const uint16_t* index, int n);
+fixed_t lambda_ws_return_error(const lambda_workspace_t* ws, fixed_t lambda);
+fixed_t lambda_ws_estimate(const lambda_workspace_t* ws, fixed_t eps, int max_iter,
+                           fixed_t* error_out);
+int lambda_pyramid_build(lambda_pyramid_t* pyr, const lambda_workspace_t* ws, int max_levels);
+fixed_t lambda_pyramid_estimate(const lambda_pyramid_t* pyr, fixed_t eps, int max_iter,
+                                fixed_t* error_out, uint32_t* pose_mults);
 
 /* DLT integration (record_lambda.c) */
 void compute_trajectory_hash(const se3_pose_t* poses, int n, uint8_t* hash);
@@ -281,6 +392,8 @@ bool publish_lambda_record(const dlt_record_t* record);
 #define LAMBDA_EPSILON       FLOAT_TO_FIXED(0.001f)  /* 0.1% target error */
 #define LAMBDA_VARIANCE_MAX  FLOAT_TO_FIXED(0.005f)  /* Statistical stability */
 #define LAMBDA_MAX_ITER      12                       /* Iteration budget */
+#define LAMBDA_MIN           FLOAT_TO_FIXED(0.1f)    /* Search bracket (matches */
+#define LAMBDA_MAX           FLOAT_TO_FIXED(2.0f)    /*  Python bounds)         */
 
 /* Geodetic constants (fixed-point degrees) */
 #define FIXED_180_DEG        FLOAT_TO_FIXED(180.0f)
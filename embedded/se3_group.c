@@ -0,0 +1,284 @@
+/*
+ * se3_group.c - Fixed-Point SE(3) Group Operations
+ *
+ * Native compose / inverse / relative-pose / point-transform for
+ * se3_pose_t, mirroring the Python reference (compose_se3,
+ * compose_trajectory in src/science/lie_dynamics/se3_double_scale.py).
+ *
+ * Every output element is a single 64-bit dot product followed by one
+ * >> FRACBITS, exactly like rotation_mul() and mat3_mul_vec3(), so the
+ * results are bit-identical to composing those primitives by hand, but
+ * without the intermediate temporaries and memcpy round trips.
+ *
+ * Homogeneous form: g = [R t; 0 1]
+ *   compose:   g1 * g2   = [R1 R2,  R1 t2 + t1]
+ *   inverse:   g^-1      = [R^T,   -(R^T t)]
+ *   relative:  g1^-1 g2  = [R1^T R2, R1^T (t2 - t1)]
+ *
+ * Metadata (timestamp, mmsi) of every result is taken from the
+ * right-hand operand (the later pose in a trajectory).
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "se3_edge.h"
+
+/* ========================================================================
+ * INTERNAL HELPERS
+ * ======================================================================== */
+
+/* Row i of A times column j of B (A, B row-major 3x3) */
+#define DOT_RC(A, B, i, j) \
+    (((int64_t)(A)[(i)*3 + 0] * (B)[0*3 + (j)] + \
+      (int64_t)(A)[(i)*3 + 1] * (B)[1*3 + (j)] + \
+      (int64_t)(A)[(i)*3 + 2] * (B)[2*3 + (j)]) >> FRACBITS)
+
+/* Column i of A times column j of B, i.e. (A^T B)[i][j] */
+#define DOT_CC(A, B, i, j) \
+    (((int64_t)(A)[0*3 + (i)] * (B)[0*3 + (j)] + \
+      (int64_t)(A)[1*3 + (i)] * (B)[1*3 + (j)] + \
+      (int64_t)(A)[2*3 + (i)] * (B)[2*3 + (j)]) >> FRACBITS)
+
+/* Row i of R times vector v */
+#define DOT_RV(R, v, i) \
+    (((int64_t)(R)[(i)*3 + 0] * (v)[0] + \
+      (int64_t)(R)[(i)*3 + 1] * (v)[1] + \
+      (int64_t)(R)[(i)*3 + 2] * (v)[2]) >> FRACBITS)
+
+/* Column i of R times vector v, i.e. (R^T v)[i] */
+#define DOT_CV(R, v, i) \
+    (((int64_t)(R)[0*3 + (i)] * (v)[0] + \
+      (int64_t)(R)[1*3 + (i)] * (v)[1] + \
+      (int64_t)(R)[2*3 + (i)] * (v)[2]) >> FRACBITS)
+
+/**
+ * Core compose into local registers, then a single store.
+ *
+ * Operands are copied to locals first so that out may alias a or b and
+ * so the packed struct is read once per element.
+ */
+static inline void compose_core(const se3_pose_t* a, const se3_pose_t* b,
+                                se3_pose_t* out) {
+    fixed_t Ra[9], Rb[9], ta[3], tb[3];
+    for (int k = 0; k < 9; k++) { Ra[k] = a->rotation[k]; Rb[k] = b->rotation[k]; }
+    for (int k = 0; k < 3; k++) { ta[k] = a->translation[k]; tb[k] = b->translation[k]; }
+    uint32_t timestamp = b->timestamp;
+    uint32_t mmsi = b->mmsi;
+
+    fixed_t R[9], t[3];
+    R[0] = (fixed_t)DOT_RC(Ra, Rb, 0, 0);
+    R[1] = (fixed_t)DOT_RC(Ra, Rb, 0, 1);
+    R[2] = (fixed_t)DOT_RC(Ra, Rb, 0, 2);
+    R[3] = (fixed_t)DOT_RC(Ra, Rb, 1, 0);
+    R[4] = (fixed_t)DOT_RC(Ra, Rb, 1, 1);
+    R[5] = (fixed_t)DOT_RC(Ra, Rb, 1, 2);
+    R[6] = (fixed_t)DOT_RC(Ra, Rb, 2, 0);
+    R[7] = (fixed_t)DOT_RC(Ra, Rb, 2, 1);
+    R[8] = (fixed_t)DOT_RC(Ra, Rb, 2, 2);
+
+    t[0] = (fixed_t)DOT_RV(Ra, tb, 0) + ta[0];
+    t[1] = (fixed_t)DOT_RV(Ra, tb, 1) + ta[1];
+    t[2] = (fixed_t)DOT_RV(Ra, tb, 2) + ta[2];
+
+    for (int k = 0; k < 9; k++) out->rotation[k] = R[k];
+    for (int k = 0; k < 3; k++) out->translation[k] = t[k];
+    out->timestamp = timestamp;
+    out->mmsi = mmsi;
+}
+
+/* ========================================================================
+ * SINGLE-POSE OPERATIONS
+ * ======================================================================== */
+
+/**
+ * Compose two poses: out = a * b (apply b in a's frame).
+ *
+ * Performance: 36 multiplies, 12 shifts (27 + 9, no temporaries beyond
+ * registers/stack locals).
+ *
+ * @param a Left pose (global frame)
+ * @param b Right pose (local frame)
+ * @param out Output pose (may alias a or b)
+ */
+void se3_compose(const se3_pose_t* a, const se3_pose_t* b, se3_pose_t* out) {
+    compose_core(a, b, out);
+}
+
+/**
+ * In-place accumulate: acc = acc * b.
+ *
+ * The inner step of trajectory composition (G = g1 * g2 * ... * gT).
+ *
+ * @param acc Accumulator pose (modified)
+ * @param b Next pose
+ */
+void se3_compose_inplace(se3_pose_t* acc, const se3_pose_t* b) {
+    compose_core(acc, b, acc);
+}
+
+/**
+ * Invert a pose: out = g^-1 = [R^T, -(R^T t)].
+ *
+ * Exact transpose for the rotation; one rounding per translation element.
+ *
+ * @param g Input pose
+ * @param out Output pose (may alias g)
+ */
+void se3_inverse(const se3_pose_t* g, se3_pose_t* out) {
+    fixed_t R[9], t[3];
+    for (int k = 0; k < 9; k++) R[k] = g->rotation[k];
+    for (int k = 0; k < 3; k++) t[k] = g->translation[k];
+
+    fixed_t ti0 = -(fixed_t)DOT_CV(R, t, 0);
+    fixed_t ti1 = -(fixed_t)DOT_CV(R, t, 1);
+    fixed_t ti2 = -(fixed_t)DOT_CV(R, t, 2);
+
+    out->rotation[0] = R[0]; out->rotation[1] = R[3]; out->rotation[2] = R[6];
+    out->rotation[3] = R[1]; out->rotation[4] = R[4]; out->rotation[5] = R[7];
+    out->rotation[6] = R[2]; out->rotation[7] = R[5]; out->rotation[8] = R[8];
+    out->translation[0] = ti0;
+    out->translation[1] = ti1;
+    out->translation[2] = ti2;
+    out->timestamp = g->timestamp;
+    out->mmsi = g->mmsi;
+}
+
+/**
+ * In-place inverse: g = g^-1.
+ *
+ * @param g Pose to invert (modified)
+ */
+void se3_inverse_inplace(se3_pose_t* g) {
+    se3_inverse(g, g);
+}
+
+/**
+ * Relative pose: out = g1^-1 * g2 = [R1^T R2, R1^T (t2 - t1)].
+ *
+ * Computed directly from the transposed rotation, so it rounds once per
+ * element instead of twice (inverse, then compose).
+ *
+ * @param g1 Reference pose
+ * @param g2 Target pose
+ * @param out Output pose (may alias g1 or g2)
+ */
+void se3_relative(const se3_pose_t* g1, const se3_pose_t* g2, se3_pose_t* out) {
+    fixed_t R1[9], R2[9], d[3];
+    for (int k = 0; k < 9; k++) { R1[k] = g1->rotation[k]; R2[k] = g2->rotation[k]; }
+    for (int k = 0; k < 3; k++) d[k] = g2->translation[k] - g1->translation[k];
+    uint32_t timestamp = g2->timestamp;
+    uint32_t mmsi = g2->mmsi;
+
+    fixed_t R[9], t[3];
+    R[0] = (fixed_t)DOT_CC(R1, R2, 0, 0);
+    R[1] = (fixed_t)DOT_CC(R1, R2, 0, 1);
+    R[2] = (fixed_t)DOT_CC(R1, R2, 0, 2);
+    R[3] = (fixed_t)DOT_CC(R1, R2, 1, 0);
+    R[4] = (fixed_t)DOT_CC(R1, R2, 1, 1);
+    R[5] = (fixed_t)DOT_CC(R1, R2, 1, 2);
+    R[6] = (fixed_t)DOT_CC(R1, R2, 2, 0);
+    R[7] = (fixed_t)DOT_CC(R1, R2, 2, 1);
+    R[8] = (fixed_t)DOT_CC(R1, R2, 2, 2);
+
+    t[0] = (fixed_t)DOT_CV(R1, d, 0);
+    t[1] = (fixed_t)DOT_CV(R1, d, 1);
+    t[2] = (fixed_t)DOT_CV(R1, d, 2);
+
+    for (int k = 0; k < 9; k++) out->rotation[k] = R[k];
+    for (int k = 0; k < 3; k++) out->translation[k] = t[k];
+    out->timestamp = timestamp;
+    out->mmsi = mmsi;
+}
+
+/**
+ * Transform points: out[i] = R * pts[i] + t.
+ *
+ * Rotation and translation are loaded once for the whole batch.
+ *
+ * @param g Pose
+ * @param pts Input points (n × 3 fixed_t, xyz interleaved)
+ * @param n Number of points
+ * @param out Output points (n × 3 fixed_t, may alias pts)
+ */
+void se3_transform_points(const se3_pose_t* g, const fixed_t* pts, int n, fixed_t* out) {
+    fixed_t R[9], t[3];
+    for (int k = 0; k < 9; k++) R[k] = g->rotation[k];
+    for (int k = 0; k < 3; k++) t[k] = g->translation[k];
+
+    for (int i = 0; i < n; i++) {
+        const fixed_t* p = &pts[i * 3];
+        fixed_t x = (fixed_t)DOT_RV(R, p, 0) + t[0];
+        fixed_t y = (fixed_t)DOT_RV(R, p, 1) + t[1];
+        fixed_t z = (fixed_t)DOT_RV(R, p, 2) + t[2];
+        out[i * 3 + 0] = x;
+        out[i * 3 + 1] = y;
+        out[i * 3 + 2] = z;
+    }
+}
+
+/* ========================================================================
+ * BATCH ARRAY OPERATIONS
+ * ======================================================================== */
+
+/**
+ * Element-wise compose: out[i] = a[i] * b[i].
+ *
+ * @param a Left poses (n)
+ * @param b Right poses (n)
+ * @param n Number of poses
+ * @param out Output poses (n, may alias a or b)
+ */
+void se3_compose_batch(const se3_pose_t* a, const se3_pose_t* b, int n, se3_pose_t* out) {
+    for (int i = 0; i < n; i++) {
+        compose_core(&a[i], &b[i], &out[i]);
+    }
+}
+
+/**
+ * Element-wise inverse: out[i] = g[i]^-1.
+ *
+ * @param g Input poses (n)
+ * @param n Number of poses
+ * @param out Output poses (n, may alias g)
+ */
+void se3_inverse_batch(const se3_pose_t* g, int n, se3_pose_t* out) {
+    for (int i = 0; i < n; i++) {
+        se3_inverse(&g[i], &out[i]);
+    }
+}
+
+/**
+ * Consecutive relative poses (odometry increments):
+ *   out[i] = poses[i]^-1 * poses[i+1],  i = 0 .. n-2
+ *
+ * @param poses Absolute poses in time order (n)
+ * @param n Number of poses (n >= 2 produces n-1 outputs)
+ * @param out Output relative poses (n-1, must not alias poses)
+ */
+void se3_relative_batch(const se3_pose_t* poses, int n, se3_pose_t* out) {
+    for (int i = 0; i + 1 < n; i++) {
+        se3_relative(&poses[i], &poses[i + 1], &out[i]);
+    }
+}
+
+/**
+ * Compose a whole trajectory: out = g[0] * g[1] * ... * g[n-1].
+ *
+ * Native counterpart of Python compose_trajectory(). n == 0 yields the
+ * identity pose.
+ *
+ * @param poses Trajectory (n)
+ * @param n Number of poses
+ * @param out Output total transformation
+ */
+void se3_compose_trajectory(const se3_pose_t* poses, int n, se3_pose_t* out) {
+    if (n <= 0) {
+        se3_pose_identity(out);
+        return;
+    }
+    *out = poses[0];
+    for (int i = 1; i < n; i++) {
+        compose_core(out, &poses[i], out);
+    }
+}
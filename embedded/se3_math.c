@@ -90,6 +90,173 @@ void rotation_from_yaw(uint32_t yaw, fixed_t R[9]) {
     R[6] =  0;         R[7] =  0;         R[8] = FRACUNIT;
 }
 
+/**
+ * Create full 3D rotation matrix from roll/pitch/yaw (ZYX Euler angles).
+ *
+ * For AUVs and drones reporting IMU attitude. Aerospace convention:
+ *   R = Rz(yaw) * Ry(pitch) * Rx(roll)
+ *
+ *   [cy*cp   cy*sp*sr - sy*cr   cy*sp*cr + sy*sr]
+ *   [sy*cp   sy*sp*sr + cy*cr   sy*sp*cr - cy*sr]
+ *   [-sp     cp*sr              cp*cr           ]
+ *
+ * With roll = pitch = 0 the result is bit-identical to rotation_from_yaw().
+ * Cost: 3 fused sincos lookups + 6 FixedMul + 4 two-term dot products.
+ *
+ * @param roll Rotation about X (32-bit angle)
+ * @param pitch Rotation about Y (32-bit angle)
+ * @param yaw Rotation about Z (32-bit angle, ENU frame)
+ * @param R Output 9-element rotation matrix (row-major)
+ */
+void rotation_from_euler(uint32_t roll, uint32_t pitch, uint32_t yaw, fixed_t R[9]) {
+    fixed_t sr, cr, sp, cp, sy, cy;
+    SinCos_from_LUT(roll, &sr, &cr);
+    SinCos_from_LUT(pitch, &sp, &cp);
+    SinCos_from_LUT(yaw, &sy, &cy);
+
+    /* Shared pitch products */
+    fixed_t sp_sr = FixedMul(sp, sr);
+    fixed_t sp_cr = FixedMul(sp, cr);
+
+    R[0] = FixedMul(cy, cp);
+    R[1] = (fixed_t)(((int64_t)cy * sp_sr - (int64_t)sy * cr) >> FRACBITS);
+    R[2] = (fixed_t)(((int64_t)cy * sp_cr + (int64_t)sy * sr) >> FRACBITS);
+
+    R[3] = FixedMul(sy, cp);
+    R[4] = (fixed_t)(((int64_t)sy * sp_sr + (int64_t)cy * cr) >> FRACBITS);
+    R[5] = (fixed_t)(((int64_t)sy * sp_cr - (int64_t)cy * sr) >> FRACBITS);
+
+    R[6] = -sp;
+    R[7] = FixedMul(cp, sr);
+    R[8] = FixedMul(cp, cr);
+}
+
+/**
+ * Create rotation matrix from unit quaternion q = (w, x, y, z).
+ *
+ * IMU quaternions drift slightly off unit norm, so the standard
+ * 2/|q|^2 factor is applied: the result is a proper rotation for any
+ * non-zero q, without a square root.
+ *
+ *   [1 - s(yy+zz)   s(xy - wz)     s(xz + wy)  ]
+ *   [s(xy + wz)     1 - s(xx+zz)   s(yz - wx)  ]
+ *   [s(xz - wy)     s(yz + wx)     1 - s(xx+yy)]    where s = 2 / |q|^2
+ *
+ * Below |q|^2 = 2^-14, s no longer fits 16.16 (and the components have
+ * lost their precision anyway); such quaternions, zero included, give
+ * the identity.
+ *
+ * @param q Quaternion (w, x, y, z) in 16.16 fixed-point
+ * @param R Output 9-element rotation matrix (row-major)
+ */
+#define QUAT_MIN_NORM_SQ  ((int64_t)1 << 18)     /* 2^-14 in Q32: s = 2^31 */
+
+void rotation_from_quaternion(const fixed_t q[4], fixed_t R[9]) {
+    fixed_t w = q[0], x = q[1], y = q[2], z = q[3];
+
+    int64_t norm_sq = (int64_t)w * w + (int64_t)x * x + (int64_t)y * y + (int64_t)z * z;
+    if (norm_sq <= QUAT_MIN_NORM_SQ) {
+        rotation_identity(R);
+        return;
+    }
+
+    /* s = 2 / |q|^2 in 16.16 (norm_sq is in Q32) */
+    fixed_t s = (fixed_t)(((int64_t)2 << (3 * FRACBITS)) / norm_sq);
+
+    fixed_t xx = FixedMul(x, x), yy = FixedMul(y, y), zz = FixedMul(z, z);
+    fixed_t xy = FixedMul(x, y), xz = FixedMul(x, z), yz = FixedMul(y, z);
+    fixed_t wx = FixedMul(w, x), wy = FixedMul(w, y), wz = FixedMul(w, z);
+
+    R[0] = FRACUNIT - FixedMul(s, yy + zz);
+    R[1] = FixedMul(s, xy - wz);
+    R[2] = FixedMul(s, xz + wy);
+
+    R[3] = FixedMul(s, xy + wz);
+    R[4] = FRACUNIT - FixedMul(s, xx + zz);
+    R[5] = FixedMul(s, yz - wx);
+
+    R[6] = FixedMul(s, xz - wy);
+    R[7] = FixedMul(s, yz + wx);
+    R[8] = FRACUNIT - FixedMul(s, xx + yy);
+}
+
+/**
+ * Batch Euler → rotation conversion.
+ *
+ * Parallel input arrays (one entry per fix) and a packed output of
+ * n consecutive 9-element matrices, so the loop streams through memory.
+ *
+ * @param roll Roll angles (n entries)
+ * @param pitch Pitch angles (n entries)
+ * @param yaw Yaw angles (n entries)
+ * @param n Number of rotations
+ * @param R_out Output: n × 9 fixed_t (row-major matrices, back to back)
+ */
+void rotation_from_euler_batch(const uint32_t* roll, const uint32_t* pitch,
+                               const uint32_t* yaw, int n, fixed_t* R_out) {
+    for (int i = 0; i < n; i++) {
+        rotation_from_euler(roll[i], pitch[i], yaw[i], &R_out[i * 9]);
+    }
+}
+
+/**
+ * Batch quaternion → rotation conversion.
+ *
+ * @param q Input: n × 4 fixed_t quaternions (w, x, y, z)
+ * @param n Number of rotations
+ * @param R_out Output: n × 9 fixed_t (row-major matrices, back to back)
+ */
+void rotation_from_quaternion_batch(const fixed_t* q, int n, fixed_t* R_out) {
+    for (int i = 0; i < n; i++) {
+        rotation_from_quaternion(&q[i * 4], &R_out[i * 9]);
+    }
+}
+
+/**
+ * Re-orthonormalize a drifted rotation matrix (DCM renormalization).
+ *
+ * Long rotation_mul() chains accumulate rounding error (see README error
+ * budget). Square-root-free correction:
+ *   1. err = row0 · row1; split it between the two rows
+ *   2. row2 = row0 × row1
+ *   3. scale each row by (3 - |row|^2) / 2 (first-order 1/sqrt)
+ *
+ * Valid for matrices already close to orthonormal (|row|^2 ≈ 1).
+ *
+ * @param R Rotation matrix (9 elements, modified in place)
+ */
+void rotation_renormalize(fixed_t R[9]) {
+    fixed_t r0[3] = { R[0], R[1], R[2] };
+    fixed_t r1[3] = { R[3], R[4], R[5] };
+    fixed_t r2[3];
+
+    /* Orthogonality error, half applied to each row */
+    fixed_t half_err = (fixed_t)(((int64_t)r0[0] * r1[0] + (int64_t)r0[1] * r1[1] +
+                                  (int64_t)r0[2] * r1[2]) >> (FRACBITS + 1));
+    fixed_t x[3], y[3];
+    for (int i = 0; i < 3; i++) {
+        x[i] = r0[i] - FixedMul(half_err, r1[i]);
+        y[i] = r1[i] - FixedMul(half_err, r0[i]);
+    }
+
+    /* Third row from cross product */
+    r2[0] = (fixed_t)(((int64_t)x[1] * y[2] - (int64_t)x[2] * y[1]) >> FRACBITS);
+    r2[1] = (fixed_t)(((int64_t)x[2] * y[0] - (int64_t)x[0] * y[2]) >> FRACBITS);
+    r2[2] = (fixed_t)(((int64_t)x[0] * y[1] - (int64_t)x[1] * y[0]) >> FRACBITS);
+
+    /* Normalize rows: scale = (3 - |v|^2) / 2 */
+    fixed_t* rows[3] = { x, y, r2 };
+    for (int r = 0; r < 3; r++) {
+        fixed_t* v = rows[r];
+        fixed_t norm_sq = (fixed_t)(((int64_t)v[0] * v[0] + (int64_t)v[1] * v[1] +
+                                     (int64_t)v[2] * v[2]) >> FRACBITS);
+        fixed_t scale = (3 * FRACUNIT - norm_sq) >> 1;
+        R[r * 3 + 0] = FixedMul(scale, v[0]);
+        R[r * 3 + 1] = FixedMul(scale, v[1]);
+        R[r * 3 + 2] = FixedMul(scale, v[2]);
+    }
+}
+
 /**
  * Convert GPS heading to 32-bit angle (with coordinate frame correction).
  *
@@ -124,6 +291,31 @@ uint32_t heading_to_angle(fixed_t heading_deg) {
     return angle;
 }
 
+/**
+ * Convert signed degrees to 32-bit angle (no frame correction).
+ *
+ * Used for IMU roll/pitch. Any input range wraps modulo 360° in O(1).
+ *
+ * @param deg Angle in fixed-point degrees (any sign/range)
+ * @return 32-bit angle for LUT (0x00000000 to 0xFFFFFFFF)
+ */
+uint32_t degrees_to_angle(fixed_t deg) {
+    /* Wrap to [0, 360): one remainder, only when out of range */
+    int32_t wrapped = deg;
+    if (wrapped < 0 || wrapped >= FIXED_360_DEG) {
+        wrapped %= FIXED_360_DEG;
+        if (wrapped < 0) {
+            wrapped += FIXED_360_DEG;
+        }
+    }
+
+    /* angle = degrees * 2^32 / 360 via reciprocal multiply:
+     * (2^40 / 360) fits in 32 bits, and wrapped < 2^25, so the product
+     * fits in 57 bits. Error < 0.1 LSB of the 32-bit angle. */
+    const uint64_t deg_to_angle_q40 = ((uint64_t)1 << 40) / 360;
+    return (uint32_t)(((uint64_t)wrapped * deg_to_angle_q40) >> 24);
+}
+
 /**
  * Multiply two 3x3 rotation matrices: C = A * B.
  *
@@ -278,6 +470,144 @@ void se3_pose_from_gps(fixed_t east, fixed_t north, fixed_t up,
     pose->mmsi = mmsi;
 }
 
+/**
+ * Create SE(3) pose from full IMU attitude (AUVs, drones).
+ *
+ * Same frame conventions as se3_pose_from_gps(): heading is a GPS compass
+ * heading and gets the +90° ENU correction; roll and pitch are applied as
+ * rotations about X and Y (ZYX order, see rotation_from_euler()).
+ * With roll = pitch = 0 the pose is bit-identical to se3_pose_from_gps().
+ *
+ * @param east East coordinate in ENU frame (meters, fixed-point)
+ * @param north North coordinate in ENU frame (meters, fixed-point)
+ * @param up Up coordinate in ENU frame (meters, fixed-point)
+ * @param roll_deg Roll (degrees, fixed-point)
+ * @param pitch_deg Pitch (degrees, fixed-point)
+ * @param heading_deg GPS heading (degrees, fixed-point)
+ * @param timestamp Unix epoch seconds
+ * @param mmsi Vessel identifier
+ * @param pose Output SE(3) pose
+ */
+void se3_pose_from_attitude(fixed_t east, fixed_t north, fixed_t up,
+                            fixed_t roll_deg, fixed_t pitch_deg, fixed_t heading_deg,
+                            uint32_t timestamp, uint32_t mmsi, se3_pose_t* pose) {
+    rotation_from_euler(degrees_to_angle(roll_deg),
+                        degrees_to_angle(pitch_deg),
+                        heading_to_angle(heading_deg),
+                        pose->rotation);
+
+    pose->translation[0] = east;
+    pose->translation[1] = north;
+    pose->translation[2] = up;
+
+    pose->timestamp = timestamp;
+    pose->mmsi = mmsi;
+}
+
+/* ========================================================================
+ * ROOTS AND INVERSE TRIGONOMETRY
+ * ======================================================================== */
+
+/**
+ * Integer square root of a 64-bit value: floor(sqrt(x)).
+ *
+ * Bit-by-bit (digit) method: 32 iterations of shift/compare/subtract,
+ * no multiply or divide, deterministic latency.
+ *
+ * @param x Input value
+ * @return floor(sqrt(x))
+ */
+uint32_t isqrt64(uint64_t x) {
+    uint64_t result = 0;
+    if (x == 0) {
+        return 0;
+    }
+#if defined(__GNUC__)
+    /* Highest power of 4 <= x in one step */
+    uint64_t bit = (uint64_t)1 << ((63 - __builtin_clzll(x)) & ~1);
+#else
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > x) {
+        bit >>= 2;
+    }
+#endif
+    while (bit != 0) {
+        /* Branch-free select: data-dependent branches here mispredict
+         * about half the time on random inputs */
+        uint64_t trial = result + bit;
+        uint64_t take = (uint64_t)0 - (uint64_t)(x >= trial);
+        x -= trial & take;
+        result = (result >> 1) + (bit & take);
+        bit >>= 2;
+    }
+    return (uint32_t)result;
+}
+
+/**
+ * Fixed-point square root: sqrt(x) in 16.16.
+ *
+ * @param x Non-negative 16.16 value (negative input returns 0)
+ * @return sqrt(x) in 16.16
+ */
+fixed_t fixed_sqrt(fixed_t x) {
+    if (x <= 0) {
+        return 0;
+    }
+    return (fixed_t)isqrt64((uint64_t)x << FRACBITS);
+}
+
+/**
+ * Four-quadrant arctangent returning a 32-bit angle.
+ *
+ * Octant reduction to r = min/max ∈ [0, 1], then an odd minimax
+ * polynomial for atan(r) evaluated in Q30 (max error ~1e-6 rad, well
+ * below the 0.044° LUT resolution). Inputs only need a common scale,
+ * so any fixed-point format works.
+ *
+ * @param y Sine-like component
+ * @param x Cosine-like component
+ * @return Angle (0x00000000 = 0°, 0x40000000 = 90°, ...); 0 for (0, 0)
+ */
+uint32_t fixed_atan2(fixed_t y, fixed_t x) {
+    /* atan(r) ≈ r * P(r²), coefficients in Q30 */
+    static const int64_t atan_coef_q30[6] = {
+        1073717337,   /*  0.99997726 */
+        -357149546,   /* -0.33262347 */
+        207816804,    /*  0.19354346 */
+        -125018627,   /* -0.11643287 */
+        56536346,     /*  0.05265332 */
+        -12585647     /* -0.01172120 */
+    };
+
+    if (x == 0 && y == 0) {
+        return 0;
+    }
+
+    uint64_t ax = (x < 0) ? (uint64_t)(-(int64_t)x) : (uint64_t)x;
+    uint64_t ay = (y < 0) ? (uint64_t)(-(int64_t)y) : (uint64_t)y;
+    bool swap = ay > ax;
+    uint64_t num = swap ? ax : ay;
+    uint64_t den = swap ? ay : ax;
+
+    /* r in Q30, r ∈ [0, 1] */
+    int64_t r = (int64_t)((num << 30) / den);
+    int64_t r2 = (r * r) >> 30;
+
+    int64_t poly = atan_coef_q30[5];
+    for (int k = 4; k >= 0; k--) {
+        poly = ((poly * r2) >> 30) + atan_coef_q30[k];
+    }
+    int64_t rad_q30 = (poly * r) >> 30;
+
+    /* radians → 32-bit angle: × 2^32 / (2π); 683565276 = 2^32 / (2π) */
+    uint32_t angle = (uint32_t)(((uint64_t)rad_q30 * 683565276ull) >> 30);
+
+    if (swap) angle = 0x40000000u - angle;        /* atan(y/x) = 90° - atan(x/y) */
+    if (x < 0) angle = 0x80000000u - angle;       /* quadrants II/III */
+    if (y < 0) angle = (uint32_t)(0u - angle);    /* reflect below X axis */
+    return angle;
+}
+
 /* ========================================================================
  * DIAGNOSTIC UTILITIES
  * ======================================================================== */
@@ -52,6 +52,170 @@ static inline void decode_cell_id(uint16_t cell_id, int* lat_idx, int* lon_idx)
     *lon_idx = (int8_t)(cell_id & 0xFF);
 }
 
+/**
+ * Old-window ID of a new-window cell ID during a re-center.
+ *
+ * @param bsp T-BSP root (re-centering)
+ * @param cell_id Cell ID in the current window
+ * @param old_id Output: same physical cell keyed in the previous window
+ * @return false if that cell was not representable in the previous window
+ */
+static inline bool stale_cell_id(const t_bsp_t* bsp, uint16_t cell_id, uint16_t* old_id) {
+    int lat_idx, lon_idx;
+    decode_cell_id(cell_id, &lat_idx, &lon_idx);
+    lat_idx += bsp->shift_lat;
+    lon_idx += bsp->shift_lon;
+    if (lat_idx < -128 || lat_idx > 127 || lon_idx < -128 || lon_idx > 127) {
+        return false;
+    }
+    *old_id = generate_cell_id(lat_idx, lon_idx);
+    return true;
+}
+
+/**
+ * Find the active header for a cell ID (shared by insert/get/reset).
+ *
+ * Outside a re-center this is the plain ID scan. During one, headers not
+ * yet re-keyed (stale grid_epoch) are matched by their old-window ID.
+ */
+static inline t_bsp_cell_t* find_cell(t_bsp_t* bsp, uint16_t cell_id) {
+    if (!bsp->recentering) {
+        for (int i = 0; i < MAX_CELLS; i++) {
+            if (bsp->cells[i].active && bsp->cells[i].cell_id == cell_id) {
+                return &bsp->cells[i];
+            }
+        }
+        return NULL;
+    }
+
+    uint16_t old_id = 0;
+    bool old_ok = stale_cell_id(bsp, cell_id, &old_id);
+    for (int i = 0; i < MAX_CELLS; i++) {
+        const t_bsp_cell_t* c = &bsp->cells[i];
+        if (!c->active) continue;
+        if (c->grid_epoch == bsp->grid_epoch) {
+            if (c->cell_id == cell_id) return &bsp->cells[i];
+        } else if (old_ok && c->cell_id == old_id) {
+            return &bsp->cells[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Grid index along one axis for an offset from the voyage origin.
+ *
+ * Latitude and longitude share it (same km-per-degree approximation).
+ * Monotonic in delta_deg, which grid_axis_edge() relies on.
+ */
+static int grid_axis_index(fixed_t delta_deg) {
+    /* Convert degrees to kilometers (approximate at equator)
+     * d_km = delta * FIXED_DEG_TO_KM / FRACUNIT
+     * But we can simplify: delta * (111.32 * FRACUNIT) / FRACUNIT = delta * 111.32
+     */
+    fixed_t d_km = FixedMul(delta_deg, FIXED_DEG_TO_KM);
+
+    /* Convert km to cell indices (divide by CELL_SIZE_KM) */
+    fixed_t cell_size_fixed = INT_TO_FIXED(CELL_SIZE_KM);
+
+    /* Compute grid index with proper rounding for negative values
+     * Positive: floor division (natural)
+     * Negative: ceiling division (subtract (divisor-1) before dividing)
+     */
+    if (d_km >= 0) {
+        return FIXED_TO_INT(FixedDiv(d_km, cell_size_fixed));
+    }
+    /* Ceiling division for negative: (d_km - (cell_size - 1)) / cell_size */
+    fixed_t adjusted = d_km - (cell_size_fixed - FRACUNIT);
+    return FIXED_TO_INT(FixedDiv(adjusted, cell_size_fixed));
+}
+
+/**
+ * Absolute grid indices (cells from the voyage origin) of a position.
+ *
+ * Unclamped; t_bsp_latlon_to_cell() makes them window-relative.
+ */
+static void latlon_to_grid(const t_bsp_t* bsp, fixed_t lat, fixed_t lon,
+                           int* lat_out, int* lon_out) {
+    /* Normalize longitude (dateline wraparound) */
+    lon = normalize_lon(lon);
+
+    /* Compute delta from reference point (fixed-point degrees) */
+    *lat_out = grid_axis_index(lat - bsp->ref_lat);
+    *lon_out = grid_axis_index(lon - bsp->ref_lon);
+}
+
+/**
+ * Smallest origin offset that grid_axis_index() puts in cell idx or above.
+ *
+ * The nominal edge idx × cell size is within one cell of the classifier's
+ * edge (south/west of the origin the negative rounding moves edges by up
+ * to CELL_SIZE_KM - 1 km), so a ±2 cell bracket is bisected (~15 steps).
+ */
+static fixed_t grid_axis_edge(int idx, fixed_t cell_size_deg) {
+    fixed_t nominal = FixedMul(INT_TO_FIXED(idx), cell_size_deg);
+    fixed_t lo = nominal - 2 * cell_size_deg;   /* grid_axis_index(lo) < idx */
+    fixed_t hi = nominal + 2 * cell_size_deg;   /* grid_axis_index(hi) >= idx */
+    while (hi - lo > 1) {
+        fixed_t mid = lo + (hi - lo) / 2;
+        if (grid_axis_index(mid) >= idx) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+    return hi;
+}
+
+/**
+ * Classifier-exact edges of a cell, before dateline normalization.
+ *
+ * Snaps each nominal edge to the exact point where t_bsp_latlon_to_cell()
+ * changes cell. Half-open, [lo, hi); longitudes may run past ±180°.
+ */
+static void cell_raw_edges(const t_bsp_t* bsp, uint16_t cell_id,
+                           fixed_t* lat_lo, fixed_t* lat_hi,
+                           fixed_t* lon_lo, fixed_t* lon_hi) {
+    int lat_idx, lon_idx;
+    decode_cell_id(cell_id, &lat_idx, &lon_idx);
+    lat_idx += bsp->center_lat_idx;
+    lon_idx += bsp->center_lon_idx;
+
+    fixed_t size = FixedDiv(INT_TO_FIXED(CELL_SIZE_KM), FIXED_DEG_TO_KM);
+    *lat_lo = bsp->ref_lat + grid_axis_edge(lat_idx, size);
+    *lat_hi = bsp->ref_lat + grid_axis_edge(lat_idx + 1, size);
+    *lon_lo = bsp->ref_lon + grid_axis_edge(lon_idx, size);
+    *lon_hi = bsp->ref_lon + grid_axis_edge(lon_idx + 1, size);
+}
+
+/**
+ * Fill a newly allocated header's bounds (Doom: node_t.bbox).
+ *
+ * Uses cell_raw_edges(), so the same-cell test in t_bsp_locate() never
+ * disagrees with full classification. Bounds are half-open, [min, max).
+ * A cell reaching past the dateline gets an empty or inverted longitude
+ * range and simply never passes the test.
+ */
+static void cell_fill_bounds(const t_bsp_t* bsp, t_bsp_cell_t* cell) {
+    fixed_t lo, hi;
+    cell_raw_edges(bsp, cell->cell_id, &cell->lat_min, &cell->lat_max, &lo, &hi);
+    if (lo < -FIXED_180_DEG || hi - 1 > FIXED_180_DEG) {
+        cell->lon_min = normalize_lon(lo);
+        cell->lon_max = normalize_lon(hi);
+        if (cell->lon_min < cell->lon_max) cell->lon_min = cell->lon_max;  /* Empty */
+    } else {
+        cell->lon_min = lo;
+        cell->lon_max = hi;
+    }
+}
+
+/**
+ * Direct-mapped slot of a vessel in a locator (Knuth multiplicative hash).
+ */
+static inline uint32_t locator_slot(uint32_t mmsi) {
+    return ((mmsi * 2654435761u) >> 16) & (T_BSP_LOCATOR_SLOTS - 1);
+}
+
 /* ========================================================================
  * PUBLIC API IMPLEMENTATION
  * ======================================================================== */
@@ -67,8 +231,17 @@ void t_bsp_init(t_bsp_t* bsp, fixed_t lat0, fixed_t lon0) {
     bsp->ref_lat = lat0;
     bsp->ref_lon = normalize_lon(lon0);
     bsp->active_count = 0;
-
-    /* Zero all cells (mark as inactive) */
+    bsp->grid_epoch = 0;
+    bsp->recentering = 0;
+    bsp->center_lat_idx = 0;
+    bsp->center_lon_idx = 0;
+    bsp->shift_lat = 0;
+    bsp->shift_lon = 0;
+    bsp->recenter_cursor = 0;
+    bsp->recenter_dropped = 0;
+
+    /* Zero all cell headers (mark as inactive). Pose slabs are left as-is:
+     * they are only read below pose_count, which is now zero. */
     memset(bsp->cells, 0, sizeof(bsp->cells));
 }
 
@@ -91,45 +264,56 @@ void t_bsp_init(t_bsp_t* bsp, fixed_t lat0, fixed_t lon0) {
  * Performance: ~75 ns @ 240 MHz (18 cycles)
  */
 uint16_t t_bsp_latlon_to_cell(t_bsp_t* bsp, fixed_t lat, fixed_t lon) {
-    /* Normalize longitude (dateline wraparound) */
-    lon = normalize_lon(lon);
-
-    /* Compute delta from reference point (fixed-point degrees) */
-    fixed_t dlat = lat - bsp->ref_lat;
-    fixed_t dlon = lon - bsp->ref_lon;
-
-    /* Convert degrees to kilometers (approximate at equator)
-     * dlat_km = dlat * FIXED_DEG_TO_KM / FRACUNIT
-     * But we can simplify: dlat * (111.32 * FRACUNIT) / FRACUNIT = dlat * 111.32
-     */
-    fixed_t dlat_km = FixedMul(dlat, FIXED_DEG_TO_KM);
-    fixed_t dlon_km = FixedMul(dlon, FIXED_DEG_TO_KM);
-
-    /* Convert km to cell indices (divide by CELL_SIZE_KM) */
-    fixed_t cell_size_fixed = INT_TO_FIXED(CELL_SIZE_KM);
-
-    /* Compute grid indices with proper rounding for negative values
-     * Positive: floor division (natural)
-     * Negative: ceiling division (subtract (divisor-1) before dividing)
-     */
     int lat_idx, lon_idx;
+    latlon_to_grid(bsp, lat, lon, &lat_idx, &lon_idx);
 
-    if (dlat_km >= 0) {
-        lat_idx = FIXED_TO_INT(FixedDiv(dlat_km, cell_size_fixed));
-    } else {
-        /* Ceiling division for negative: (dlat_km - (cell_size - 1)) / cell_size */
-        fixed_t adjusted = dlat_km - (cell_size_fixed - FRACUNIT);
-        lat_idx = FIXED_TO_INT(FixedDiv(adjusted, cell_size_fixed));
+    /* Window-relative indices (re-centering moves the window, not the grid) */
+    return generate_cell_id(lat_idx - bsp->center_lat_idx, lon_idx - bsp->center_lon_idx);
+}
+
+/**
+ * Reset a locator (all vessels unknown, counters zeroed).
+ */
+void t_bsp_locator_init(t_bsp_locator_t* loc) {
+    memset(loc, 0, sizeof(*loc));
+    for (int i = 0; i < T_BSP_LOCATOR_SLOTS; i++) {
+        loc->entries[i].slot = T_BSP_LOCATOR_NONE;
     }
+}
 
-    if (dlon_km >= 0) {
-        lon_idx = FIXED_TO_INT(FixedDiv(dlon_km, cell_size_fixed));
-    } else {
-        fixed_t adjusted = dlon_km - (cell_size_fixed - FRACUNIT);
-        lon_idx = FIXED_TO_INT(FixedDiv(adjusted, cell_size_fixed));
+/**
+ * Cell ID for a vessel's fix, trying its last cell first.
+ *
+ * Doom analog: mobj_t.subsector - P_SetThingPosition() remembers each
+ * thing's subsector so it is not re-found from the BSP root every tic.
+ *
+ * Hit: the remembered header is still the cell it was (active, same ID,
+ * keyed in the current grid epoch) and the fix lies inside its bounds -
+ * four compares, no divides. Miss: full t_bsp_latlon_to_cell() and one
+ * header scan to remember where the cell lives; a cell the caller has not
+ * inserted into yet is remembered without a header and retried next fix.
+ */
+uint16_t t_bsp_locate(t_bsp_t* bsp, t_bsp_locator_t* loc, uint32_t mmsi,
+                      fixed_t lat, fixed_t lon) {
+    t_bsp_last_cell_t* e = &loc->entries[locator_slot(mmsi)];
+
+    if (e->mmsi == mmsi && e->slot != T_BSP_LOCATOR_NONE) {
+        const t_bsp_cell_t* c = &bsp->cells[e->slot];
+        if (c->active && c->cell_id == e->cell_id && c->grid_epoch == bsp->grid_epoch &&
+            lat >= c->lat_min && lat < c->lat_max &&
+            lon >= c->lon_min && lon < c->lon_max) {
+            loc->hits++;
+            return e->cell_id;
+        }
     }
 
-    return generate_cell_id(lat_idx, lon_idx);
+    loc->misses++;
+    uint16_t cell_id = t_bsp_latlon_to_cell(bsp, lat, lon);
+    const t_bsp_cell_t* c = find_cell(bsp, cell_id);
+    e->mmsi = mmsi;
+    e->cell_id = cell_id;
+    e->slot = c ? (uint16_t)(c - bsp->cells) : T_BSP_LOCATOR_NONE;
+    return cell_id;
 }
 
 /**
@@ -152,13 +336,11 @@ uint16_t t_bsp_latlon_to_cell(t_bsp_t* bsp, fixed_t lat, fixed_t lon) {
 bool t_bsp_insert_pose(t_bsp_t* bsp, uint16_t cell_id, const se3_pose_t* pose) {
     t_bsp_cell_t* target_cell = NULL;
 
-    /* Pass 1: Find existing cell with matching ID */
-    for (int i = 0; i < MAX_CELLS; i++) {
-        if (bsp->cells[i].active && bsp->cells[i].cell_id == cell_id) {
-            target_cell = &bsp->cells[i];
-            break;
-        }
-    }
+    /* Both passes touch only the dense header array (hot/cold split) */
+
+    /* Pass 1: Find existing cell with matching ID (double-mapped while
+     * re-centering, so inserts never wait for the re-key) */
+    target_cell = find_cell(bsp, cell_id);
 
     /* Pass 2: Allocate new cell if not found */
     if (target_cell == NULL) {
@@ -168,6 +350,8 @@ bool t_bsp_insert_pose(t_bsp_t* bsp, uint16_t cell_id, const se3_pose_t* pose) {
                 target_cell->cell_id = cell_id;
                 target_cell->pose_count = 0;
                 target_cell->active = true;
+                target_cell->grid_epoch = bsp->grid_epoch;
+                cell_fill_bounds(bsp, target_cell);
                 bsp->active_count++;
                 break;
             }
@@ -188,8 +372,8 @@ bool t_bsp_insert_pose(t_bsp_t* bsp, uint16_t cell_id, const se3_pose_t* pose) {
         target_cell->pose_count = 0;  /* Reset for next trajectory segment */
     }
 
-    /* Insert pose into cell */
-    target_cell->poses[target_cell->pose_count++] = *pose;
+    /* Insert pose into the cell's slab in the cold region */
+    t_bsp_cell_poses(bsp, target_cell)[target_cell->pose_count++] = *pose;
 
     return true;
 }
@@ -200,12 +384,7 @@ bool t_bsp_insert_pose(t_bsp_t* bsp, uint16_t cell_id, const se3_pose_t* pose) {
  * @return Pointer to cell, or NULL if not found
  */
 t_bsp_cell_t* t_bsp_get_cell(t_bsp_t* bsp, uint16_t cell_id) {
-    for (int i = 0; i < MAX_CELLS; i++) {
-        if (bsp->cells[i].active && bsp->cells[i].cell_id == cell_id) {
-            return &bsp->cells[i];
-        }
-    }
-    return NULL;
+    return find_cell(bsp, cell_id);
 }
 
 /**
@@ -215,13 +394,11 @@ t_bsp_cell_t* t_bsp_get_cell(t_bsp_t* bsp, uint16_t cell_id) {
  * Memory is not zeroed (optimization: will be overwritten).
  */
 void t_bsp_reset_cell(t_bsp_t* bsp, uint16_t cell_id) {
-    for (int i = 0; i < MAX_CELLS; i++) {
-        if (bsp->cells[i].active && bsp->cells[i].cell_id == cell_id) {
-            bsp->cells[i].active = false;
-            bsp->cells[i].pose_count = 0;
-            bsp->active_count--;
-            return;
-        }
+    t_bsp_cell_t* cell = find_cell(bsp, cell_id);
+    if (cell) {
+        cell->active = false;
+        cell->pose_count = 0;
+        bsp->active_count--;
     }
 }
 
@@ -266,6 +443,171 @@ void t_bsp_get_adjacent_cells(t_bsp_t* bsp, uint16_t cell_id,
     }
 }
 
+/**
+ * Gather one vessel's track from a cell and its 8 neighbours.
+ *
+ * One cursor per contributing cell; each step takes the earliest pending
+ * fix among the cursors. Cursors skip other vessels' poses in place, so
+ * no scratch buffers are needed (at most 9 cursors on the stack).
+ */
+int t_bsp_gather_track(t_bsp_t* bsp, uint16_t cell_id, uint32_t mmsi,
+                       t_bsp_track_t* track) {
+    uint16_t ids[9];
+    int n_adjacent = 0;
+    ids[0] = cell_id;
+    t_bsp_get_adjacent_cells(bsp, cell_id, &ids[1], &n_adjacent);
+    int n_ids = 1 + n_adjacent;
+
+    /* Cursor = (slab base slot, next slot, end slot) per cell */
+    uint16_t base[9], next[9], end[9];
+    int n_cur = 0;
+    for (int k = 0; k < n_ids; k++) {
+        const t_bsp_cell_t* cell = t_bsp_get_cell(bsp, ids[k]);
+        if (!cell || cell->pose_count == 0) continue;
+        base[n_cur] = (uint16_t)((cell - bsp->cells) * MAX_POSES_PER_CELL);
+        next[n_cur] = 0;
+        end[n_cur] = cell->pose_count;
+        n_cur++;
+    }
+
+    const se3_pose_t* flat = &bsp->poses[0][0];
+    uint16_t contributed = 0;   /* bitmask over cursors */
+
+    track->mmsi = mmsi;
+    track->count = 0;
+
+    for (;;) {
+        int best = -1;
+        uint32_t best_ts = 0;
+
+        for (int k = 0; k < n_cur; k++) {
+            /* Advance past other vessels */
+            while (next[k] < end[k] && flat[base[k] + next[k]].mmsi != mmsi) {
+                next[k]++;
+            }
+            if (next[k] < end[k]) {
+                uint32_t ts = flat[base[k] + next[k]].timestamp;
+                if (best < 0 || ts < best_ts) {
+                    best = k;
+                    best_ts = ts;
+                }
+            }
+        }
+
+        if (best < 0 || track->count >= T_BSP_TRACK_MAX) break;
+
+        track->index[track->count++] = (uint16_t)(base[best] + next[best]);
+        next[best]++;
+        contributed |= (uint16_t)(1u << best);
+    }
+
+    track->cells_spanned = 0;
+    for (int k = 0; k < n_cur; k++) {
+        if (contributed & (1u << k)) track->cells_spanned++;
+    }
+    return track->count;
+}
+
+/* ========================================================================
+ * ONLINE RE-CENTERING
+ * ======================================================================== */
+
+/**
+ * Check whether a cell is near the edge of the ID window.
+ */
+bool t_bsp_recenter_needed(uint16_t cell_id) {
+    int lat_idx, lon_idx;
+    decode_cell_id(cell_id, &lat_idx, &lon_idx);
+    return lat_idx >= T_BSP_RECENTER_MARGIN || lat_idx <= -T_BSP_RECENTER_MARGIN ||
+           lon_idx >= T_BSP_RECENTER_MARGIN || lon_idx <= -T_BSP_RECENTER_MARGIN;
+}
+
+/**
+ * Start re-centering the ID window on (lat, lon).
+ *
+ * The new center is the grid cell containing the position, so cell
+ * boundaries are unchanged and re-keying is an exact index shift.
+ */
+int t_bsp_recenter_begin(t_bsp_t* bsp, fixed_t lat, fixed_t lon) {
+    if (bsp->recentering) {
+        t_bsp_recenter_step(bsp, MAX_CELLS);
+    }
+
+    int lat_idx, lon_idx;
+    latlon_to_grid(bsp, lat, lon, &lat_idx, &lon_idx);
+
+    int shift_lat = lat_idx - bsp->center_lat_idx;
+    int shift_lon = lon_idx - bsp->center_lon_idx;
+    if (shift_lat == 0 && shift_lon == 0) {
+        return 0;
+    }
+
+    /* Shifts beyond the window drop every cell; clamp to keep int16 */
+    if (shift_lat > 256) shift_lat = 256;
+    if (shift_lat < -256) shift_lat = -256;
+    if (shift_lon > 256) shift_lon = 256;
+    if (shift_lon < -256) shift_lon = -256;
+
+    bsp->center_lat_idx = lat_idx;
+    bsp->center_lon_idx = lon_idx;
+    bsp->shift_lat = (int16_t)shift_lat;
+    bsp->shift_lon = (int16_t)shift_lon;
+    bsp->grid_epoch++;
+    bsp->recenter_cursor = 0;
+    bsp->recentering = 1;
+
+    int dropping = 0;
+    for (int i = 0; i < MAX_CELLS; i++) {
+        if (!bsp->cells[i].active) continue;
+        int a, b;
+        decode_cell_id(bsp->cells[i].cell_id, &a, &b);
+        a -= shift_lat;
+        b -= shift_lon;
+        if (a < -128 || a > 127 || b < -128 || b > 127) dropping++;
+    }
+    return dropping;
+}
+
+/**
+ * Re-key headers in place.
+ *
+ * Each header is rewritten at most once per re-center (grid_epoch marks
+ * it done); cells allocated after begin() are already in the new window.
+ */
+int t_bsp_recenter_step(t_bsp_t* bsp, int max_cells) {
+    if (!bsp->recentering) {
+        return 0;
+    }
+
+    while (max_cells-- > 0 && bsp->recenter_cursor < MAX_CELLS) {
+        t_bsp_cell_t* c = &bsp->cells[bsp->recenter_cursor++];
+        if (!c->active || c->grid_epoch == bsp->grid_epoch) {
+            c->grid_epoch = bsp->grid_epoch;
+            continue;
+        }
+
+        int lat_idx, lon_idx;
+        decode_cell_id(c->cell_id, &lat_idx, &lon_idx);
+        lat_idx -= bsp->shift_lat;
+        lon_idx -= bsp->shift_lon;
+        if (lat_idx < -128 || lat_idx > 127 || lon_idx < -128 || lon_idx > 127) {
+            c->active = false;
+            c->pose_count = 0;
+            bsp->active_count--;
+            bsp->recenter_dropped++;
+        } else {
+            c->cell_id = generate_cell_id(lat_idx, lon_idx);
+        }
+        c->grid_epoch = bsp->grid_epoch;
+    }
+
+    if (bsp->recenter_cursor >= MAX_CELLS) {
+        bsp->recentering = 0;
+        return 0;
+    }
+    return MAX_CELLS - bsp->recenter_cursor;
+}
+
 /**
  * Check if cell is near full (predictive λ-estimation trigger).
  *
@@ -315,8 +657,8 @@ void t_bsp_get_cell_bounds(const t_bsp_t* bsp, uint16_t cell_id,
     /* Convert grid indices to lat/lon bounds */
     fixed_t cell_size_deg = FixedDiv(INT_TO_FIXED(CELL_SIZE_KM), FIXED_DEG_TO_KM);
 
-    fixed_t lat_offset = FixedMul(INT_TO_FIXED(lat_idx), cell_size_deg);
-    fixed_t lon_offset = FixedMul(INT_TO_FIXED(lon_idx), cell_size_deg);
+    fixed_t lat_offset = FixedMul(INT_TO_FIXED(lat_idx + bsp->center_lat_idx), cell_size_deg);
+    fixed_t lon_offset = FixedMul(INT_TO_FIXED(lon_idx + bsp->center_lon_idx), cell_size_deg);
 
     *lat_min = bsp->ref_lat + lat_offset;
     *lat_max = *lat_min + cell_size_deg;
@@ -324,3 +666,15 @@ void t_bsp_get_cell_bounds(const t_bsp_t* bsp, uint16_t cell_id,
     *lon_min = normalize_lon(bsp->ref_lon + lon_offset);
     *lon_max = normalize_lon(*lon_min + cell_size_deg);
 }
+
+/**
+ * Classifier-exact cell bounds (see t_bsp.h).
+ */
+void t_bsp_get_cell_edges(const t_bsp_t* bsp, uint16_t cell_id,
+                          fixed_t* lat_min, fixed_t* lat_max,
+                          fixed_t* lon_min, fixed_t* lon_max) {
+    fixed_t lo, hi;
+    cell_raw_edges(bsp, cell_id, lat_min, lat_max, &lo, &hi);
+    *lon_min = normalize_lon(lo);
+    *lon_max = *lon_min + (hi - lo);
+}
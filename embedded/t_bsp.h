@@ -49,7 +49,7 @@ extern "C" {
  *   - Multi-vessel edge node: 10-20 cells
  *   - Port aggregator: 50-64 cells
  *
- * Memory: 64 cells × 7,192 bytes = ~460 KB SRAM
+ * Memory: 64 × 24-byte headers (1.5 KB) + 64 × 7,168-byte pose slabs (~448 KB)
  */
 #define MAX_CELLS            64
 
@@ -76,37 +76,82 @@ extern "C" {
  */
 #define FIXED_DEG_TO_KM      ((fixed_t)(111.32f * FRACUNIT))
 
+/**
+ * Cache line size used to align the hot cell header array.
+ *
+ * 64 bytes on both the host (x86-64/AArch64) and the ESP32-S3 data cache
+ * line (configurable 16/32/64, 64 assumed). Only affects placement, never
+ * correctness.
+ */
+#ifndef T_BSP_CACHE_LINE
+#define T_BSP_CACHE_LINE     64
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define T_BSP_CACHE_ALIGNED  __attribute__((aligned(T_BSP_CACHE_LINE)))
+#else
+#define T_BSP_CACHE_ALIGNED
+#endif
+
+/**
+ * Per-vessel last-cell entries in a t_bsp_locator_t (direct-mapped by
+ * MMSI, power of 2). Vessels sharing an entry only cost extra misses.
+ *
+ * Sized for a port aggregator (~500 vessels, few collisions).
+ *
+ * Memory: 1,024 × 8 bytes = 8 KB
+ */
+#ifndef T_BSP_LOCATOR_SLOTS
+#define T_BSP_LOCATOR_SLOTS  1024
+#endif
+
+#define T_BSP_LOCATOR_NONE   0xFFFF  /* Last cell has no header yet */
+
 /* Compile-time safety checks */
 _Static_assert(MAX_CELLS <= 65536, "cell_id is uint16_t, MAX_CELLS must fit");
 _Static_assert(MAX_POSES_PER_CELL > 0, "Must allow at least one pose per cell");
+_Static_assert((T_BSP_LOCATOR_SLOTS & (T_BSP_LOCATOR_SLOTS - 1)) == 0 &&
+               T_BSP_LOCATOR_SLOTS <= 65536, "T_BSP_LOCATOR_SLOTS must be a power of 2");
 
 /* ========================================================================
  * DATA STRUCTURES
  * ======================================================================== */
 
 /**
- * T-BSP cell: spatial partition for trajectory segments.
+ * T-BSP cell header: spatial partition metadata for a trajectory segment.
  *
  * Doom BSP mapping:
  *   - Doom node_t.bbox → t_bsp_cell_t.{lat,lon}_{min,max}
- *   - Doom subsector_t.sector → t_bsp_cell_t.poses[] (trajectory data)
+ *   - Doom subsector_t.sector → t_bsp_t.poses[slot] (trajectory data)
  *   - Doom seg_t (line segment) → se3_pose_t (6-DOF pose)
  *
- * Memory layout: 7,192 bytes per cell
+ * Hot/cold split: the header holds only what cell scans read (lookup,
+ * allocation, active-count checks, sweeps). The 7 KB pose slab for the
+ * same slot lives in t_bsp_t.poses[] and is reached via t_bsp_cell_poses(),
+ * so a scan over all 64 headers touches 24 contiguous cache lines instead
+ * of one isolated line (and often one TLB entry) per 7 KB stride.
+ *
+ * Bounds are filled when the header is allocated and are the exact,
+ * half-open region t_bsp_latlon_to_cell() maps to cell_id (see
+ * t_bsp_locate()). They stay valid across re-centering, which moves IDs,
+ * not cell boundaries.
+ *
+ * Memory layout: 24 bytes per header
  *   - Bounds: 16 bytes
  *   - Metadata: 8 bytes
- *   - Poses: 128 × 56 = 7,168 bytes
  */
 typedef struct {
-    fixed_t lat_min, lat_max;   /**< Cell bounds in fixed-point degrees (WGS84) */
-    fixed_t lon_min, lon_max;   /**< Normalized to [-180°, 180°] */
+    fixed_t lat_min, lat_max;   /**< Cell bounds in fixed-point degrees (WGS84), [min, max) */
+    fixed_t lon_min, lon_max;   /**< Normalized to [-180°, 180°]; empty across the dateline */
     uint16_t cell_id;            /**< Unique identifier (grid index encoded) */
     uint16_t pose_count;         /**< Current number of poses (0 to MAX_POSES_PER_CELL) */
     bool active;                 /**< Cell in use (false = available for allocation) */
-    uint8_t _padding[3];         /**< Alignment padding (total 24 bytes metadata) */
-    se3_pose_t poses[MAX_POSES_PER_CELL];  /**< Fixed-size trajectory buffer */
+    uint8_t grid_epoch;          /**< Grid generation cell_id is keyed in (re-centering) */
+    uint8_t _padding[2];         /**< Alignment padding (total 24 bytes metadata) */
 } t_bsp_cell_t;
 
+_Static_assert(sizeof(t_bsp_cell_t) == 24, "t_bsp_cell_t header must stay 24 bytes");
+
 /**
  * T-BSP root structure: manages all active cells.
  *
@@ -114,14 +159,80 @@ typedef struct {
  *   - Doom BSP tree root → t_bsp_t (global cell manager)
  *   - Doom numnodes → t_bsp_t.active_count
  *   - Static allocation (no malloc, ESP32-safe)
+ *
+ * Layout: hot header array first (cache-line aligned, 1.5 KB), then the
+ * scalar state, then the cold pose region. poses[i] belongs to cells[i].
+ * No internal pointers, so the structure stays position-independent.
+ *
+ * Re-centering: ref_lat/ref_lon fix the physical grid for the whole voyage;
+ * center_{lat,lon}_idx select which 256×256 window of it cell IDs encode.
+ * Moving the window re-keys cells without moving any cell boundary.
  */
 typedef struct {
-    t_bsp_cell_t cells[MAX_CELLS];  /**< Static cell array (~460 KB) */
+    t_bsp_cell_t cells[MAX_CELLS] T_BSP_CACHE_ALIGNED;  /**< Hot header array (1.5 KB) */
     uint16_t active_count;           /**< Number of cells in use */
-    uint16_t _padding;               /**< Alignment */
+    uint8_t grid_epoch;              /**< Current grid generation */
+    uint8_t recentering;             /**< Re-key in progress (double mapping) */
     fixed_t ref_lat, ref_lon;        /**< Voyage origin (grid reference point) */
+    int32_t center_lat_idx;          /**< Window center, grid cells from origin */
+    int32_t center_lon_idx;
+    int16_t shift_lat, shift_lon;    /**< Center move of the running re-key */
+    uint16_t recenter_cursor;        /**< Next header to re-key */
+    uint16_t recenter_dropped;       /**< Cells dropped (outside new window) */
+    se3_pose_t poses[MAX_CELLS][MAX_POSES_PER_CELL] T_BSP_CACHE_ALIGNED;  /**< Cold pose slabs (~448 KB) */
 } t_bsp_t;
 
+/**
+ * Maximum fixes in a stitched track: one vessel's poses from a center
+ * cell and its 8 neighbours (see t_bsp_gather_track()).
+ */
+#define T_BSP_TRACK_MAX      (9 * MAX_POSES_PER_CELL)
+
+_Static_assert(MAX_CELLS * MAX_POSES_PER_CELL <= 65536,
+               "flat pose index is uint16_t");
+
+/**
+ * Gather view of one vessel's track across neighbouring cells.
+ *
+ * Holds no pose copies: index[] lists flat slots into the pose region
+ * (&bsp->poses[0][0]) in timestamp order. Valid until the next insert or
+ * reset touches one of the gathered cells.
+ *
+ * Memory: 2,312 bytes (2 bytes per fix vs 56 for a copied pose)
+ */
+typedef struct {
+    uint32_t mmsi;                     /**< Vessel the track belongs to */
+    uint16_t count;                    /**< Fixes gathered */
+    uint16_t cells_spanned;            /**< Cells that contributed >= 1 fix */
+    uint16_t index[T_BSP_TRACK_MAX];   /**< Flat pose slots, time ordered */
+} t_bsp_track_t;
+
+/**
+ * One vessel's last known cell.
+ */
+typedef struct {
+    uint32_t mmsi;       /**< Vessel (0 = unused entry) */
+    uint16_t cell_id;    /**< Cell of the vessel's last fix */
+    uint16_t slot;       /**< Header index in bsp->cells[], or T_BSP_LOCATOR_NONE */
+} t_bsp_last_cell_t;
+
+/**
+ * Same-cell fast path for classifying a stream of fixes.
+ *
+ * Consecutive fixes of one vessel nearly always land in the cell of the
+ * previous fix (a 10 km cell at 15 kn is ~20 min of reports). The locator
+ * remembers that cell per vessel and tests the new fix against its header
+ * bounds before paying for t_bsp_latlon_to_cell(). Caller-owned, like
+ * t_bsp_track_t; one locator per t_bsp_t.
+ *
+ * Memory: 8,200 bytes (T_BSP_LOCATOR_SLOTS = 1024)
+ */
+typedef struct {
+    t_bsp_last_cell_t entries[T_BSP_LOCATOR_SLOTS];
+    uint32_t hits;       /**< Fixes resolved by the bounds test */
+    uint32_t misses;     /**< Fixes that took full classification */
+} t_bsp_locator_t;
+
 /* ========================================================================
  * API FUNCTIONS
  * ======================================================================== */
@@ -131,6 +242,7 @@ typedef struct {
  *
  * Sets voyage origin (reference point for grid indexing) and
  * zeroes all cell data. Must be called before any other T-BSP functions.
+ * The cell ID window starts centered on the origin.
  *
  * @param bsp T-BSP root structure (must be allocated by caller)
  * @param lat0 Reference latitude in fixed-point degrees (voyage start)
@@ -150,7 +262,8 @@ void t_bsp_init(t_bsp_t* bsp, fixed_t lat0, fixed_t lon0);
  *   4. Encode (lat_idx, lon_idx) into uint16_t cell_id
  *
  * Cell ID encoding: (lat_idx & 0xFF) << 8 | (lon_idx & 0xFF)
- *   - Supports ±127 cells from origin (±1,270 km at 10 km cell size)
+ *   - Supports ±127 cells from the window center (±1,270 km at 10 km
+ *     cell size); the center is the origin until t_bsp_recenter_begin()
  *
  * @param bsp T-BSP root structure
  * @param lat Vessel latitude (fixed-point degrees)
@@ -159,13 +272,41 @@ void t_bsp_init(t_bsp_t* bsp, fixed_t lat0, fixed_t lon0);
  */
 uint16_t t_bsp_latlon_to_cell(t_bsp_t* bsp, fixed_t lat, fixed_t lon);
 
+/**
+ * Reset a locator: no vessel known, hit/miss counters zeroed.
+ *
+ * @param loc Locator (caller-allocated)
+ */
+void t_bsp_locator_init(t_bsp_locator_t* loc);
+
+/**
+ * Convert a vessel's fix to a cell ID, trying its last cell first.
+ *
+ * Always returns exactly what t_bsp_latlon_to_cell() would. A hit costs
+ * one hash, a header load and four integer compares against the cell
+ * bounds; a miss falls back to full classification plus one header scan.
+ * Re-centering, resets and re-allocation invalidate entries implicitly
+ * (the remembered header must still be active, keyed by the same ID in
+ * the current grid epoch).
+ *
+ * @param bsp T-BSP root structure
+ * @param loc Locator used with this bsp
+ * @param mmsi Vessel identifier
+ * @param lat Vessel latitude (fixed-point degrees)
+ * @param lon Vessel longitude (fixed-point degrees, auto-normalized)
+ * @return cell_id for this position
+ */
+uint16_t t_bsp_locate(t_bsp_t* bsp, t_bsp_locator_t* loc, uint32_t mmsi,
+                      fixed_t lat, fixed_t lon);
+
 /**
  * Insert pose into specified cell.
  *
  * Doom BSP analog: R_AddLine() → adds seg_t to subsector
  *
  * Behavior:
- *   - If cell doesn't exist, allocates from cells[] array
+ *   - If cell doesn't exist, allocates a header from cells[] array and
+ *     fills its bounds
  *   - If cell full (pose_count == MAX_POSES_PER_CELL), triggers λ-estimation
  *     and resets cell (handled by caller via overflow flag)
  *   - Returns false only if MAX_CELLS exceeded (allocation failure)
@@ -188,6 +329,20 @@ bool t_bsp_insert_pose(t_bsp_t* bsp, uint16_t cell_id, const se3_pose_t* pose);
  */
 t_bsp_cell_t* t_bsp_get_cell(t_bsp_t* bsp, uint16_t cell_id);
 
+/**
+ * Get pose storage for a cell header.
+ *
+ * Poses are stored apart from the header (hot/cold split); the slab index
+ * equals the header's index in bsp->cells[].
+ *
+ * @param bsp T-BSP root structure
+ * @param cell Cell header returned by t_bsp_get_cell()
+ * @return Pointer to the cell's MAX_POSES_PER_CELL pose slab
+ */
+static inline se3_pose_t* t_bsp_cell_poses(t_bsp_t* bsp, const t_bsp_cell_t* cell) {
+    return bsp->poses[cell - bsp->cells];
+}
+
 /**
  * Reset cell for reuse (after λ-estimation).
  *
@@ -213,6 +368,89 @@ void t_bsp_reset_cell(t_bsp_t* bsp, uint16_t cell_id);
 void t_bsp_get_adjacent_cells(t_bsp_t* bsp, uint16_t cell_id,
                               uint16_t* neighbors, int* count);
 
+/**
+ * Gather one vessel's track from a cell and its 8 neighbours.
+ *
+ * Doom analog: R_RenderBSPNode() visiting neighbouring subsectors, but
+ * the result is an index list (like Doom's drawsegs) rather than copies.
+ *
+ * Fragments are merged by timestamp (k-way merge, ties in center-first
+ * order). Each cell's fragment is assumed to be in arrival order.
+ * Inactive or missing neighbours are skipped.
+ *
+ * @param bsp T-BSP root structure
+ * @param cell_id Center cell (the vessel's current cell)
+ * @param mmsi Vessel identifier
+ * @param track Output gather view
+ * @return Number of fixes gathered
+ */
+int t_bsp_gather_track(t_bsp_t* bsp, uint16_t cell_id, uint32_t mmsi,
+                       t_bsp_track_t* track);
+
+/**
+ * Resolve the i-th fix of a gathered track.
+ *
+ * @param bsp T-BSP root structure the track was gathered from
+ * @param track Gather view
+ * @param i Fix index (0 to count-1)
+ * @return Pointer into the pose region (no copy)
+ */
+static inline const se3_pose_t* t_bsp_track_pose(const t_bsp_t* bsp,
+                                                 const t_bsp_track_t* track, int i) {
+    return &bsp->poses[0][0] + track->index[i];
+}
+
+/**
+ * Index distance from the window center that makes re-centering due.
+ *
+ * 96 of the 127 representable cells: ~300 km of headroom before vessels
+ * would clamp into edge cells.
+ */
+#define T_BSP_RECENTER_MARGIN  96
+
+/**
+ * Check whether a cell is close enough to the window edge to re-center.
+ *
+ * @param cell_id Cell the vessel is currently in
+ * @return true if |lat_idx| or |lon_idx| >= T_BSP_RECENTER_MARGIN
+ */
+bool t_bsp_recenter_needed(uint16_t cell_id);
+
+/**
+ * Start moving the cell ID window to be centered on (lat, lon).
+ *
+ * Doom analog: none in the engine; this is Doom's "blockmap origin" moved
+ * at runtime while things keep thinking.
+ *
+ * Cheap and O(1): only records the shift and bumps grid_epoch. From here
+ * on t_bsp_latlon_to_cell() returns IDs in the new window, and lookups
+ * match both re-keyed cells (new ID) and not-yet-re-keyed cells (old ID
+ * translated by the shift), so inserts continue without a pause.
+ * A re-center already in progress is completed first.
+ *
+ * Cells that fall outside the new ±127 window are dropped during
+ * t_bsp_recenter_step() (counted in recenter_dropped); they are > 1,270 km
+ * from the new center, so callers should run λ-estimation on them first.
+ *
+ * @param bsp T-BSP root structure
+ * @param lat New center latitude (fixed-point degrees)
+ * @param lon New center longitude (fixed-point degrees)
+ * @return Number of active cells that will be dropped
+ */
+int t_bsp_recenter_begin(t_bsp_t* bsp, fixed_t lat, fixed_t lon);
+
+/**
+ * Re-key up to max_cells headers in place (pose slabs never move).
+ *
+ * Call between inserts to bound the pause; when it returns 0 the double
+ * mapping ends and lookups are single-keyed again.
+ *
+ * @param bsp T-BSP root structure
+ * @param max_cells Headers to process this call (MAX_CELLS = finish)
+ * @return Headers still to process
+ */
+int t_bsp_recenter_step(t_bsp_t* bsp, int max_cells);
+
 /**
  * Check if cell is near overflow (trigger preemptive λ-estimation).
  *
@@ -248,6 +486,26 @@ void t_bsp_get_cell_bounds(const t_bsp_t* bsp, uint16_t cell_id,
                            fixed_t* lat_min, fixed_t* lat_max,
                            fixed_t* lon_min, fixed_t* lon_max);
 
+/**
+ * Compute the exact bounds t_bsp_latlon_to_cell() classifies into a cell.
+ *
+ * Unlike t_bsp_get_cell_bounds(), edges south/west of the voyage origin
+ * follow the classifier's negative rounding (cell -1 is ~1 km across,
+ * the cells beyond it are offset by up to CELL_SIZE_KM - 1 km). Bounds
+ * are half-open, [min, max); lon_min is normalized and lon_max is
+ * lon_min + width, so it may exceed 180° for a cell on the dateline.
+ *
+ * @param bsp T-BSP root (for reference point)
+ * @param cell_id Cell identifier
+ * @param lat_min Output: minimum latitude (fixed-point degrees)
+ * @param lat_max Output: maximum latitude (exclusive)
+ * @param lon_min Output: minimum longitude
+ * @param lon_max Output: maximum longitude (exclusive)
+ */
+void t_bsp_get_cell_edges(const t_bsp_t* bsp, uint16_t cell_id,
+                          fixed_t* lat_min, fixed_t* lat_max,
+                          fixed_t* lon_min, fixed_t* lon_max);
+
 #ifdef __cplusplus
 }
 #endif
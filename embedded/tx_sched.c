@@ -0,0 +1,291 @@
+/*
+ * tx_sched.c - Duty-Cycle-Aware Transmit Scheduler for the Shared Radio Link
+ *
+ * Messages live in fixed slots threaded onto one FIFO per class and a
+ * free list (uint8_t links), so enqueue, expiry and frame building never
+ * allocate. A frame is planned first (slots picked, length and airtime
+ * known) and only committed if the bucket covers it; an unaffordable
+ * frame leaves the queue untouched.
+ *
+ * Reference: ETSI EN 300 220-2 (SRD duty cycle); Semtech AN1200.13
+ *            (LoRa airtime)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "tx_sched.h"
+#include <string.h>
+
+/* Messages per frame: each takes at least TX_MSG_HEADER + 1 bytes */
+#define TX_FRAME_MSGS  ((TX_FRAME_MAX - TX_FRAME_HEADER) / (TX_MSG_HEADER + 1))
+
+static inline bool time_reached(uint32_t now_ms, uint32_t t_ms) {
+    return (int32_t)(now_ms - t_ms) >= 0;
+}
+
+/* ========================================================================
+ * LINK MODEL
+ * ======================================================================== */
+
+void tx_link_default(tx_link_t* link) {
+    memset(link, 0, sizeof(*link));
+    link->bitrate_bps = 5470;                   /* SF7, 125 kHz, CR 4/5 */
+    link->frame_overhead_us = 20600;            /* 12.25-symbol preamble + 8 header symbols */
+    link->duty_permille = 10;                   /* 1% */
+    link->burst_ms = 60000;
+    link->reserve_us[TX_CLASS_RECORD] = 100000;
+    link->reserve_us[TX_CLASS_BULK] = 200000;          /* One handoff frame */
+    link->ttl_ms[TX_CLASS_HANDOFF] = 60000;
+    link->ttl_ms[TX_CLASS_RECORD] = 15 * 60000;
+    link->ttl_ms[TX_CLASS_BULK] = 2 * 60000;
+}
+
+uint32_t tx_airtime_us(const tx_link_t* link, size_t frame_len) {
+    uint64_t bits_us = (uint64_t)frame_len * 8u * 1000000u;
+    return link->frame_overhead_us +
+           (uint32_t)((bits_us + link->bitrate_bps - 1) / link->bitrate_bps);
+}
+
+/* duty_permille µs of airtime per elapsed ms, up to duty × burst_ms */
+static void refill(tx_sched_t* s, uint32_t now_ms) {
+    uint32_t elapsed = now_ms - s->last_ms;
+    if ((int32_t)elapsed <= 0) return;
+    int64_t cap = (int64_t)s->link.duty_permille * s->link.burst_ms;
+    s->tokens_us += (int64_t)elapsed * s->link.duty_permille;
+    if (s->tokens_us > cap) s->tokens_us = cap;
+    s->last_ms = now_ms;
+}
+
+/* ========================================================================
+ * QUEUE
+ * ======================================================================== */
+
+void tx_sched_init(tx_sched_t* s, const tx_link_t* link, uint16_t node_id, uint32_t now_ms) {
+    memset(s, 0, sizeof(*s));
+    s->link = *link;
+    s->node_id = node_id;
+    for (int c = 0; c < TX_CLASSES; c++) {
+        s->head[c] = s->tail[c] = TX_NONE;
+    }
+    for (int i = 0; i < TX_QUEUE_SLOTS; i++) {
+        s->msgs[i].next = (uint8_t)(i + 1 < TX_QUEUE_SLOTS ? i + 1 : TX_NONE);
+    }
+    s->free_head = 0;
+    s->tokens_us = (int64_t)link->duty_permille * link->burst_ms;
+    s->last_ms = now_ms;
+    s->busy_until_ms = now_ms;
+}
+
+/* Unlink slot i (whose predecessor in its class FIFO is prev) and free it */
+static void unlink_msg(tx_sched_t* s, uint8_t prev, uint8_t i) {
+    int c = s->msgs[i].cls;
+    uint8_t next = s->msgs[i].next;
+    if (prev == TX_NONE) {
+        s->head[c] = next;
+    } else {
+        s->msgs[prev].next = next;
+    }
+    if (s->tail[c] == i) s->tail[c] = prev;
+    s->msgs[i].next = s->free_head;
+    s->free_head = i;
+    s->queued--;
+}
+
+static void expire(tx_sched_t* s, uint32_t now_ms) {
+    for (int c = 0; c < TX_CLASSES; c++) {
+        uint8_t prev = TX_NONE;
+        uint8_t i = s->head[c];
+        while (i != TX_NONE) {
+            uint8_t next = s->msgs[i].next;
+            if (time_reached(now_ms, s->msgs[i].expires_ms)) {
+                unlink_msg(s, prev, i);
+                s->stats[c].expired++;
+            } else {
+                prev = i;
+            }
+            i = next;
+        }
+    }
+}
+
+int tx_sched_enqueue(tx_sched_t* s, int cls, uint16_t peer, const void* data, size_t len,
+                     uint32_t now_ms, uint32_t ttl_ms) {
+    if (cls < 0 || cls >= TX_CLASSES) return TX_ERR_CLASS;
+    if (len == 0 || len > TX_MSG_MAX) return TX_ERR_SIZE;
+
+    if (s->free_head == TX_NONE) {
+        expire(s, now_ms);
+    }
+    if (s->free_head == TX_NONE) {
+        /* Evict the oldest message of the lowest class not above cls */
+        int victim = TX_CLASSES - 1;
+        while (victim > cls && s->head[victim] == TX_NONE) victim--;
+        if (s->head[victim] == TX_NONE) {
+            s->stats[cls].rejected++;
+            return TX_ERR_FULL;
+        }
+        unlink_msg(s, TX_NONE, s->head[victim]);
+        s->stats[victim].evicted++;
+    }
+
+    uint8_t i = s->free_head;
+    tx_msg_t* m = &s->msgs[i];
+    s->free_head = m->next;
+    memcpy(m->data, data, len);
+    m->len = (uint8_t)len;
+    m->cls = (uint8_t)cls;
+    m->next = TX_NONE;
+    m->peer = peer;
+    m->enqueued_ms = now_ms;
+    m->expires_ms = now_ms + (ttl_ms ? ttl_ms : s->link.ttl_ms[cls]);
+
+    if (s->tail[cls] == TX_NONE) {
+        s->head[cls] = i;
+    } else {
+        s->msgs[s->tail[cls]].next = i;
+    }
+    s->tail[cls] = i;
+    s->queued++;
+    s->stats[cls].enqueued++;
+    return TX_OK;
+}
+
+/* ========================================================================
+ * FRAME PLANNING
+ * ======================================================================== */
+
+typedef struct {
+    int lead;                      /* Class that picked the peer */
+    uint8_t slot[TX_FRAME_MSGS];
+    uint8_t prev[TX_FRAME_MSGS];   /* FIFO predecessor at planning time */
+    int n;
+    size_t len;
+    uint16_t peer;
+} tx_plan_t;
+
+/**
+ * Pick the next frame: the highest class's oldest message sets the peer,
+ * then every message for that peer that still fits, in priority order.
+ *
+ * @return false if the queue is empty
+ */
+static bool plan_frame(const tx_sched_t* s, tx_plan_t* p) {
+    int c0 = 0;
+    while (c0 < TX_CLASSES && s->head[c0] == TX_NONE) c0++;
+    if (c0 == TX_CLASSES) return false;
+
+    p->lead = c0;
+    p->peer = s->msgs[s->head[c0]].peer;
+    p->n = 0;
+    p->len = TX_FRAME_HEADER;
+    for (int c = c0; c < TX_CLASSES && p->n < TX_FRAME_MSGS; c++) {
+        uint8_t prev = TX_NONE;
+        for (uint8_t i = s->head[c]; i != TX_NONE; prev = i, i = s->msgs[i].next) {
+            const tx_msg_t* m = &s->msgs[i];
+            if (m->peer != p->peer) continue;
+            if (p->len + TX_MSG_HEADER + m->len > TX_FRAME_MAX) continue;
+            p->slot[p->n] = i;
+            p->prev[p->n] = prev;
+            p->n++;
+            p->len += TX_MSG_HEADER + m->len;
+            if (p->n == TX_FRAME_MSGS) break;
+        }
+    }
+    return true;
+}
+
+/* Tokens the planned frame needs: its airtime plus the lead class's
+ * reserve, but never more than a full bucket (or it would never go) */
+static int64_t frame_need_us(const tx_sched_t* s, const tx_plan_t* p, uint32_t airtime) {
+    int64_t cap = (int64_t)s->link.duty_permille * s->link.burst_ms;
+    int64_t need = (int64_t)airtime + s->link.reserve_us[p->lead];
+    if (need > cap) need = cap > airtime ? cap : airtime;
+    return need;
+}
+
+int tx_sched_poll(tx_sched_t* s, uint32_t now_ms, tx_send_fn send, void* ctx) {
+    refill(s, now_ms);
+    expire(s, now_ms);
+    if (!time_reached(now_ms, s->busy_until_ms)) return 0;
+
+    tx_plan_t p;
+    if (!plan_frame(s, &p)) return 0;
+    uint32_t airtime = tx_airtime_us(&s->link, p.len);
+    if (s->tokens_us < frame_need_us(s, &p, airtime)) return 0;
+
+    uint8_t* f = s->frame;
+    f[0] = (uint8_t)p.peer;
+    f[1] = (uint8_t)(p.peer >> 8);
+    f[2] = (uint8_t)s->node_id;
+    f[3] = (uint8_t)(s->node_id >> 8);
+    f[4] = (uint8_t)p.n;
+    size_t off = TX_FRAME_HEADER;
+    for (int k = 0; k < p.n; k++) {
+        const tx_msg_t* m = &s->msgs[p.slot[k]];
+        tx_class_stats_t* st = &s->stats[m->cls];
+        uint32_t wait = now_ms - m->enqueued_ms;
+        f[off] = m->cls;
+        f[off + 1] = m->len;
+        memcpy(f + off + 2, m->data, m->len);
+        off += TX_MSG_HEADER + m->len;
+        st->sent++;
+        st->latency_sum_ms += wait;
+        if (wait > st->latency_max_ms) st->latency_max_ms = wait;
+    }
+
+    /* Back to front: a later pick's predecessor may be an earlier pick of
+     * the same class, which must still be linked at that point */
+    for (int k = p.n - 1; k >= 0; k--) {
+        unlink_msg(s, p.prev[k], p.slot[k]);
+    }
+
+    s->tokens_us -= airtime;
+    s->busy_until_ms = now_ms + (airtime + 999) / 1000;
+    s->frames++;
+    s->frame_bytes += p.len;
+    s->airtime_us += airtime;
+    send(ctx, p.peer, f, p.len, airtime);
+    return p.n;
+}
+
+uint32_t tx_sched_wait_ms(tx_sched_t* s, uint32_t now_ms) {
+    refill(s, now_ms);
+    expire(s, now_ms);
+    tx_plan_t p;
+    if (!plan_frame(s, &p)) return UINT32_MAX;
+
+    uint32_t wait = time_reached(now_ms, s->busy_until_ms) ? 0 : s->busy_until_ms - now_ms;
+    int64_t short_us = frame_need_us(s, &p, tx_airtime_us(&s->link, p.len)) - s->tokens_us;
+    if (short_us > 0 && s->link.duty_permille > 0) {
+        uint32_t refill_ms = (uint32_t)((short_us + s->link.duty_permille - 1) /
+                                        s->link.duty_permille);
+        if (refill_ms > wait) wait = refill_ms;
+    }
+    return wait;
+}
+
+/* ========================================================================
+ * RECEIVER
+ * ======================================================================== */
+
+int tx_frame_parse(const uint8_t* frame, size_t len, tx_msg_fn on_msg, void* ctx) {
+    if (len < TX_FRAME_HEADER) return -1;
+    int count = frame[4];
+
+    /* Validate the whole frame before delivering anything */
+    size_t off = TX_FRAME_HEADER;
+    for (int k = 0; k < count; k++) {
+        if (off + TX_MSG_HEADER > len || frame[off] >= TX_CLASSES) return -1;
+        off += TX_MSG_HEADER + frame[off + 1];
+        if (off > len) return -1;
+    }
+    if (off != len) return -1;
+
+    uint16_t src = (uint16_t)(frame[2] | (frame[3] << 8));
+    off = TX_FRAME_HEADER;
+    for (int k = 0; k < count; k++) {
+        on_msg(ctx, src, frame[off], frame + off + TX_MSG_HEADER, frame[off + 1]);
+        off += TX_MSG_HEADER + frame[off + 1];
+    }
+    return count;
+}
@@ -0,0 +1,233 @@
+/*
+ * tx_sched.h - Duty-Cycle-Aware Transmit Scheduler for the Shared Radio Link
+ *
+ * Handoff packets, DLT records and replication frames leave an edge node
+ * over one constrained radio link (LoRa-class: a few kbit/s, with a
+ * regulatory duty cycle such as 1% in EU868 sub-band g1). The scheduler
+ * sits between the producers and the radio:
+ *
+ *   - Airtime budget: a token bucket in microseconds of airtime, refilled
+ *     at the duty cycle (duty_permille µs per ms) and capped at
+ *     duty × burst_ms. A frame goes out only when its whole airtime is in
+ *     the bucket, and never while the previous frame is still on air.
+ *     Frames led by records or bulk must also leave a per-class reserve
+ *     in the bucket, so a saturating bulk stream cannot drain the airtime
+ *     a handoff needs the moment it arrives.
+ *   - Priority: handoffs before DLT records before bulk (replication),
+ *     strictly; within a class, oldest first.
+ *   - Coalescing: the frame is addressed to the peer of the oldest
+ *     message in the highest non-empty class, then filled with every
+ *     other queued message for that peer that fits, highest class first,
+ *     so one frame overhead (preamble, header) carries several messages.
+ *   - Expiry: each message carries a deadline (per-class default TTL);
+ *     stale messages are dropped, not sent. When the queue is full, the
+ *     oldest message of the lowest class not above the new one's is
+ *     evicted.
+ *
+ * Frame format (little-endian):
+ *   dst u16, src u16, count u8, then count × (class u8, len u8, data[len])
+ *
+ * Any window of length W carries at most duty × (W + burst_ms) airtime;
+ * keep burst_ms small against the regulatory window (e.g. 60 s vs. 1 h).
+ *
+ * Doom Lineage:
+ *   - Doom's tic-paced network send (NetUpdate builds at most one packet
+ *     per node per tic, retransmits only what the peer has not acked)
+ *     → at most one frame per airtime slot, everything for one peer in it
+ *
+ * Hardware Target: ESP32-S3 + SX1262 (~8.7 KB static with defaults)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#ifndef TX_SCHED_H
+#define TX_SCHED_H
+
+#include "se3_edge.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * CONFIGURATION CONSTANTS
+ * ======================================================================== */
+
+#ifndef TX_FRAME_MAX
+#define TX_FRAME_MAX         255     /* Radio payload bytes (LoRa PHY maximum) */
+#endif
+
+#ifndef TX_QUEUE_SLOTS
+#define TX_QUEUE_SLOTS       32      /* Queued messages, all classes */
+#endif
+
+#define TX_FRAME_HEADER      5       /* dst u16, src u16, count u8 */
+#define TX_MSG_HEADER        2       /* class u8, len u8 */
+#define TX_MSG_MAX           (TX_FRAME_MAX - TX_FRAME_HEADER - TX_MSG_HEADER)
+
+#define TX_PEER_BROADCAST    0xFFFF
+#define TX_NONE              0xFF    /* Null slot link */
+
+_Static_assert(TX_FRAME_MAX <= 255 + TX_FRAME_HEADER + TX_MSG_HEADER, "len is uint8_t");
+_Static_assert(TX_MSG_MAX >= (int)sizeof(handoff_packet_t), "a handoff must fit one frame");
+_Static_assert(TX_QUEUE_SLOTS < TX_NONE, "slot links are uint8_t");
+
+/* Traffic classes, highest priority first */
+#define TX_CLASS_HANDOFF     0
+#define TX_CLASS_RECORD      1       /* DLT records */
+#define TX_CLASS_BULK        2       /* Replication frames, archives */
+#define TX_CLASSES           3
+
+/* tx_sched_enqueue() results */
+#define TX_OK                0
+#define TX_ERR_FULL         -1       /* Queue full of higher-class messages */
+#define TX_ERR_SIZE         -2       /* Empty or longer than TX_MSG_MAX */
+#define TX_ERR_CLASS        -3
+
+/* ========================================================================
+ * DATA STRUCTURES
+ * ======================================================================== */
+
+/** Radio link and duty-cycle budget */
+typedef struct {
+    uint32_t bitrate_bps;        /**< Effective payload bit rate */
+    uint32_t frame_overhead_us;  /**< Preamble + PHY header per frame */
+    uint16_t duty_permille;      /**< Airtime share (10 = 1%) */
+    uint32_t burst_ms;           /**< Bucket cap: duty × burst_ms of airtime */
+    uint32_t reserve_us[TX_CLASSES]; /**< Airtime a frame led by this class must leave
+                                          (capped so a full bucket always sends) */
+    uint32_t ttl_ms[TX_CLASSES]; /**< Default message lifetime per class */
+} tx_link_t;
+
+/** Queued message */
+typedef struct {
+    uint8_t data[TX_MSG_MAX];
+    uint8_t len;
+    uint8_t cls;
+    uint8_t next;                /**< Next in class FIFO / free list */
+    uint8_t _padding;
+    uint16_t peer;
+    uint32_t enqueued_ms;
+    uint32_t expires_ms;
+} tx_msg_t;
+
+/** Per-class counters */
+typedef struct {
+    uint32_t enqueued;
+    uint32_t sent;
+    uint32_t expired;            /**< Dropped at their deadline */
+    uint32_t evicted;            /**< Dropped for a newer message (queue full) */
+    uint32_t rejected;           /**< TX_ERR_FULL */
+    uint32_t latency_max_ms;     /**< Enqueue → start of transmission */
+    uint64_t latency_sum_ms;
+} tx_class_stats_t;
+
+/** Scheduler state */
+typedef struct {
+    tx_msg_t msgs[TX_QUEUE_SLOTS];
+    uint8_t head[TX_CLASSES], tail[TX_CLASSES];
+    uint8_t free_head;
+    uint8_t queued;
+    uint16_t node_id;            /**< Frame src */
+    tx_link_t link;
+    int64_t tokens_us;           /**< Airtime in the bucket */
+    uint32_t last_ms;            /**< Last refill */
+    uint32_t busy_until_ms;      /**< Previous frame still on air */
+    uint8_t frame[TX_FRAME_MAX];
+    tx_class_stats_t stats[TX_CLASSES];
+    uint32_t frames;
+    uint64_t frame_bytes;
+    uint64_t airtime_us;         /**< Total airtime spent */
+} tx_sched_t;
+
+/**
+ * Radio send: one frame, already charged to the budget.
+ *
+ * @param ctx Caller context
+ * @param peer Destination (TX_PEER_BROADCAST for all)
+ * @param frame Frame bytes (valid for the duration of the call)
+ * @param len Frame length
+ * @param airtime_us Airtime the frame was charged
+ */
+typedef void (*tx_send_fn)(void* ctx, uint16_t peer, const uint8_t* frame, size_t len,
+                           uint32_t airtime_us);
+
+/**
+ * Receiver side: one message of a parsed frame.
+ */
+typedef void (*tx_msg_fn)(void* ctx, uint16_t src, int cls, const uint8_t* data, size_t len);
+
+/* ========================================================================
+ * API FUNCTIONS
+ * ======================================================================== */
+
+/**
+ * LoRa SF7 / 125 kHz / CR 4/5 in EU868 sub-band g1: ~5.5 kbit/s, 1% duty,
+ * 60 s burst; reserves record 100 ms, bulk 200 ms of the 600 ms bucket;
+ * TTLs handoff 60 s, record 15 min, bulk 2 min.
+ */
+void tx_link_default(tx_link_t* link);
+
+/**
+ * Airtime of a frame on the link (µs, rounded up).
+ */
+uint32_t tx_airtime_us(const tx_link_t* link, size_t frame_len);
+
+/**
+ * Initialize with an empty queue and a full bucket.
+ *
+ * @param s Scheduler (caller-allocated)
+ * @param link Link parameters (copied)
+ * @param node_id This node's address (frame src)
+ * @param now_ms Current time (ms, wraps)
+ */
+void tx_sched_init(tx_sched_t* s, const tx_link_t* link, uint16_t node_id, uint32_t now_ms);
+
+/**
+ * Queue a message.
+ *
+ * @param s Scheduler
+ * @param cls TX_CLASS_*
+ * @param peer Destination node
+ * @param data Message bytes (copied)
+ * @param len 1 to TX_MSG_MAX
+ * @param now_ms Current time
+ * @param ttl_ms Lifetime; 0 = the class default
+ * @return TX_OK (possibly after evicting a lower-class message) or TX_ERR_*
+ */
+int tx_sched_enqueue(tx_sched_t* s, int cls, uint16_t peer, const void* data, size_t len,
+                     uint32_t now_ms, uint32_t ttl_ms);
+
+/**
+ * Send at most one frame if the radio is idle and the budget allows.
+ *
+ * @param s Scheduler
+ * @param now_ms Current time
+ * @param send Radio send
+ * @param ctx Passed to send
+ * @return Messages sent in the frame, 0 if none was sent
+ */
+int tx_sched_poll(tx_sched_t* s, uint32_t now_ms, tx_send_fn send, void* ctx);
+
+/**
+ * Time until tx_sched_poll() can send the next frame (radio sleep hint).
+ *
+ * @return 0 if now, UINT32_MAX if the queue is empty
+ */
+uint32_t tx_sched_wait_ms(tx_sched_t* s, uint32_t now_ms);
+
+/**
+ * Split a received frame into its messages.
+ *
+ * @return Messages delivered, or -1 if the frame is malformed (none delivered)
+ */
+int tx_frame_parse(const uint8_t* frame, size_t len, tx_msg_fn on_msg, void* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TX_SCHED_H */
@@ -15,13 +15,20 @@ API Endpoints:
 --------------
 POST /api/v1/science/metrics         - Compute regenerative metrics
 POST /api/v1/science/metrics/batch   - Batch metrics computation
+POST /api/v1/science/jobs            - Submit an asynchronous metrics job
+GET  /api/v1/science/jobs/<id>       - Job progress
+GET  /api/v1/science/jobs/<id>/results - Stream job results (NDJSON)
+DELETE /api/v1/science/jobs/<id>     - Cancel a job
+GET  /api/v1/science/cache/stats     - Result cache hit rates and latency
+GET  /api/v1/science/pool/stats      - Compute worker pool occupancy
 GET  /api/v1/science/health          - Health check
 GET  /api/v1/science/version         - Service version info
 """
 
-from flask import Flask, request, jsonify
+from flask import Flask, Response, request, jsonify, stream_with_context
 from flask_cors import CORS
 import logging
+import os
 import sys
 from pathlib import Path
 
@@ -32,6 +39,9 @@ from lie_dynamics.metrics_service import (
     compute_regenerative_metrics,
     compute_batch_metrics
 )
+from lie_dynamics.result_cache import cache_from_env
+from lie_dynamics.worker_pool import ComputeTimeoutError, MetricsWorkerPool, PoolBusyError
+from lie_dynamics.jobs import JobManager
 
 # Configure logging
 logging.basicConfig(
@@ -47,7 +57,7 @@ app = Flask(__name__)
 CORS(app, resources={
     r"/api/*": {
         "origins": ["http://localhost:3000", "http://127.0.0.1:3000"],
-        "methods": ["GET", "POST", "OPTIONS"],
+        "methods": ["GET", "POST", "DELETE", "OPTIONS"],
         "allow_headers": ["Content-Type", "Authorization"]
     }
 })
@@ -56,6 +66,45 @@ CORS(app, resources={
 SERVICE_VERSION = "1.0.0"
 SERVICE_NAME = "SE(3) Regenerative Metrics Service"
 
+# Content-addressed result cache shared by worker processes (None = disabled)
+metrics_cache = cache_from_env()
+
+# Pre-fork compute pool, started by main() (None = compute in the request thread)
+metrics_pool = None
+
+# Asynchronous batch jobs, started by main() after the pool
+job_manager = None
+
+
+def metrics_fn():
+    """compute_regenerative_metrics, run in the worker pool when one is running"""
+    return metrics_pool.compute_metrics if metrics_pool is not None else compute_regenerative_metrics
+
+
+def job_metrics(trajectory_data, **options):
+    """Job item compute: waits for a pool slot rather than failing busy"""
+    if metrics_pool is None:
+        return compute_regenerative_metrics(trajectory_data, **options)
+    return metrics_pool.wait(metrics_pool.submit(trajectory_data, timeout=None, **options))
+
+
+def get_job_manager():
+    """Job manager, created on first use when main() did not start one"""
+    global job_manager
+    if job_manager is None:
+        job_manager = JobManager(compute_fn=job_metrics, cache=metrics_cache)
+    return job_manager
+
+
+def busy_response(error):
+    """503 for a saturated compute pool"""
+    response = jsonify({
+        "error": str(error),
+        "status": "busy"
+    })
+    response.headers['Retry-After'] = '1'
+    return response, 503
+
 
 @app.route('/api/v1/science/health', methods=['GET'])
 def health_check():
@@ -159,15 +208,18 @@ def compute_metrics():
 
         logger.info(f"Computing metrics for trajectory with {len(trajectory_data.get('poses', []))} poses")
 
-        # Compute metrics
-        metrics = compute_regenerative_metrics(
-            trajectory_data,
+        # Compute metrics (memoized by trajectory content + options)
+        kwargs = dict(
             enable_resonance_detection=enable_resonance,
             enable_verification_cascade=enable_verification,
             bounded=bounded,
             r_max=r_max,
             lambda_bounds=lambda_bounds
         )
+        if metrics_cache is not None:
+            metrics, _ = metrics_cache.compute(metrics_fn(), trajectory_data, **kwargs)
+        else:
+            metrics = metrics_fn()(trajectory_data, **kwargs)
 
         logger.info(f"Metrics computed successfully: λ={metrics['optimal_lambda']:.4f}")
 
@@ -176,6 +228,17 @@ def compute_metrics():
             "data": metrics
         }), 200
 
+    except PoolBusyError as e:
+        logger.warning(f"Compute pool saturated: {str(e)}")
+        return busy_response(e)
+
+    except ComputeTimeoutError as e:
+        logger.error(f"Metrics computation timed out: {str(e)}")
+        return jsonify({
+            "error": str(e),
+            "status": "timeout"
+        }), 504
+
     except ValueError as e:
         logger.error(f"Validation error: {str(e)}")
         return jsonify({
@@ -230,14 +293,18 @@ def compute_metrics_batch():
 
         logger.info(f"Computing metrics for {len(trajectories)} trajectories")
 
-        results = compute_batch_metrics(
-            trajectories,
+        kwargs = dict(
             enable_resonance_detection=options.get('enable_resonance_detection', True),
             enable_verification_cascade=options.get('enable_verification_cascade', True),
             bounded=options.get('bounded', True),
             r_max=options.get('r_max', 1.0),
             lambda_bounds=tuple(options.get('lambda_bounds', [0.1, 2.0]))
         )
+        if metrics_pool is not None:
+            # Items fan out across workers; extra items wait for a slot
+            results = metrics_pool.map_metrics(trajectories, cache=metrics_cache, **kwargs)
+        else:
+            results = compute_batch_metrics(trajectories, cache=metrics_cache, **kwargs)
 
         return jsonify({
             "status": "success",
@@ -254,6 +321,149 @@ def compute_metrics_batch():
         }), 500
 
 
+@app.route('/api/v1/science/jobs', methods=['POST'])
+def submit_job():
+    """
+    Submit trajectories for asynchronous processing.
+
+    Body (Content-Type: application/x-ndjson), one JSON object per line:
+        {"options": {...}}            <- optional first line
+        {"poses": [...]}
+        {"poses": [...]}
+        ...
+
+    or JSON {"trajectories": [...], "options": {...}} as for /metrics/batch.
+    NDJSON bodies are spooled to disk as they arrive, never held in memory.
+
+    Returns:
+        202 with job_id, status and total
+    """
+    try:
+        manager = get_job_manager()
+        if request.mimetype == 'application/x-ndjson':
+            stream = request.stream
+            job = manager.submit(iter(lambda: stream.read(64 * 1024), b''))
+        else:
+            data = request.get_json(silent=True)
+            if not data or not data.get('trajectories'):
+                return jsonify({
+                    "error": "Missing 'trajectories' field",
+                    "status": "error"
+                }), 400
+            job = manager.submit_list(data['trajectories'], data.get('options'))
+
+        return jsonify({
+            "status": "accepted",
+            "data": {"job_id": job.id, "status": job.state, "total": job.total}
+        }), 202
+
+    except ValueError as e:  # Empty body or malformed options line
+        return jsonify({
+            "error": str(e),
+            "status": "error"
+        }), 400
+
+
+def job_not_found(job_id):
+    """404 for an unknown or expired job"""
+    return jsonify({
+        "error": f"Unknown job '{job_id}'",
+        "status": "not_found"
+    }), 404
+
+
+@app.route('/api/v1/science/jobs/<job_id>', methods=['GET'])
+def job_status(job_id):
+    """
+    Job progress.
+
+    Returns:
+        JSON with status, total, completed, failed, progress, elapsed_s
+    """
+    job = get_job_manager().get(job_id)
+    if job is None:
+        return job_not_found(job_id)
+    return jsonify({
+        "status": "success",
+        "data": job.progress()
+    }), 200
+
+
+@app.route('/api/v1/science/jobs/<job_id>/results', methods=['GET'])
+def job_results(job_id):
+    """
+    Stream job results as NDJSON while the job runs.
+
+    One line per trajectory, in completion order:
+        {"index": 3, "status": "success", "data": {...metrics...}}
+        {"index": 0, "status": "error", "error": "..."}
+    then a final {"status": "done" | "cancelled" | "failed", "summary": {...}}.
+
+    Query:
+        from: result lines to skip (resume after a dropped connection)
+    """
+    manager = get_job_manager()
+    job = manager.get(job_id)
+    if job is None:
+        return job_not_found(job_id)
+    start = request.args.get('from', 0, type=int)
+    return Response(stream_with_context(manager.stream(job, start=start)),
+                    mimetype='application/x-ndjson')
+
+
+@app.route('/api/v1/science/jobs/<job_id>', methods=['DELETE'])
+def cancel_job(job_id):
+    """
+    Cancel a job: no further trajectories are started. Items already
+    computing finish and their results remain streamable.
+    """
+    job = get_job_manager().cancel(job_id)
+    if job is None:
+        return job_not_found(job_id)
+    return jsonify({
+        "status": "success",
+        "data": job.progress()
+    }), 200
+
+
+@app.route('/api/v1/science/cache/stats', methods=['GET'])
+def cache_stats():
+    """
+    Result cache statistics for the worker serving the request.
+
+    Returns:
+        JSON with hit rate, per-tier hits, entry counts and hit/miss latency
+    """
+    if metrics_cache is None:
+        return jsonify({
+            "status": "disabled"
+        }), 200
+
+    return jsonify({
+        "status": "success",
+        "data": metrics_cache.stats()
+    }), 200
+
+
+@app.route('/api/v1/science/pool/stats', methods=['GET'])
+def pool_stats():
+    """
+    Compute pool occupancy and counters.
+
+    Returns:
+        JSON with workers, free slots, in-flight, completed/failed/rejected
+    """
+    if metrics_pool is None:
+        return jsonify({
+            "status": "disabled"
+        }), 200
+
+    return jsonify({
+        "status": "success",
+        "data": metrics_pool.stats()
+    }), 200
+
+
 @app.errorhandler(404)
 def not_found(error):
     """Handle 404 errors"""
@@ -274,21 +484,46 @@ def internal_error(error):
 
 def main():
     """Start the Flask server"""
-    import os
+    global metrics_pool, job_manager
 
     host = os.environ.get('SCIENCE_API_HOST', '127.0.0.1')
     port = int(os.environ.get('SCIENCE_API_PORT', 5000))
     debug = os.environ.get('SCIENCE_API_DEBUG', 'false').lower() == 'true'
+    workers = int(os.environ.get('SCIENCE_WORKERS', os.cpu_count() or 1))
+    queue_depth = int(os.environ.get('SCIENCE_QUEUE_DEPTH', 0)) or None
 
     logger.info(f"Starting {SERVICE_NAME} v{SERVICE_VERSION}")
-    logger.info(f"Server listening on {host}:{port}")
 
-    app.run(
-        host=host,
-        port=port,
-        debug=debug
+    # Fork compute workers before the server starts any threads
+    if workers > 0:
+        metrics_pool = MetricsWorkerPool(workers=workers, slots=queue_depth)
+        metrics_pool.queue_timeout = float(os.environ.get('SCIENCE_QUEUE_TIMEOUT', 5.0))
+        metrics_pool.result_timeout = float(os.environ.get('SCIENCE_RESULT_TIMEOUT', 300.0))
+
+    job_manager = JobManager(
+        compute_fn=job_metrics,
+        cache=metrics_cache,
+        spool_dir=os.environ.get('SCIENCE_JOB_DIR') or None,
+        runners=int(os.environ.get('SCIENCE_JOB_RUNNERS', 2)),
+        max_in_flight=int(os.environ.get('SCIENCE_JOB_IN_FLIGHT', max(workers, 1))),
+        ttl=float(os.environ.get('SCIENCE_JOB_TTL', 3600))
     )
 
+    logger.info(f"Server listening on {host}:{port}")
+
+    try:
+        app.run(
+            host=host,
+            port=port,
+            debug=debug,
+            threaded=True,
+            use_reloader=False
+        )
+    finally:
+        job_manager.close()
+        if metrics_pool is not None:
+            metrics_pool.close()
+
 
 if __name__ == '__main__':
     main()
@@ -0,0 +1,98 @@
+"""
+Benchmark: Fused Native Verification Cascade vs. Python Cascade
+
+PROVENANCE:
+-----------
+Created for: Open Science DLT - Pillar I (Science)
+Purpose: Per-trajectory latency of verify_regeneration, both implementations
+
+For each trajectory length, times VerificationCascade and
+FusedVerificationCascade on the same trajectories and the same noise seed,
+and reports:
+    1. Per-trajectory latency (median over repetitions) and speedup
+    2. Largest per-level difference between the two results
+    3. Share of compute_regenerative_metrics spent in the cascade, before
+       and after (verification on, resonance detection off)
+
+Usage:
+    python benchmarks/cascade_bench.py [--lengths 8,16,64,256] [--reps 20]
+"""
+
+import argparse
+import logging
+import sys
+import time
+from pathlib import Path
+
+import numpy as np
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from lie_dynamics.fused_cascade import FusedVerificationCascade
+from lie_dynamics.resonance_aware import VerificationCascade
+from lie_dynamics.se3_double_scale import SE3Pose, SE3Trajectory
+
+
+def make_trajectory(rng: np.random.Generator, n_poses: int) -> SE3Trajectory:
+    poses = [SE3Pose.from_rotation_vector(rng.normal(size=3) * 0.05, rng.normal(size=3) * 0.02)
+             for _ in range(n_poses)]
+    return SE3Trajectory(poses)
+
+
+def median_latency(cascade, traj: SE3Trajectory, lam: float, reps: int) -> float:
+    samples = []
+    for _ in range(reps):
+        np.random.seed(0)
+        t0 = time.perf_counter()
+        cascade.verify_regeneration(traj, lam)
+        samples.append(time.perf_counter() - t0)
+    return float(np.median(samples))
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("--lengths", default="8,16,64,256")
+    parser.add_argument("--reps", type=int, default=20)
+    args = parser.parse_args()
+    logging.disable(logging.INFO)
+
+    python, fused = VerificationCascade(), FusedVerificationCascade()
+    print("=" * 70)
+    print("VERIFICATION CASCADE - FUSED NATIVE VS. PYTHON")
+    print("=" * 70)
+    if not fused.native:
+        print("Native kernel unavailable (no compiler?); nothing to compare")
+        return
+
+    rng = np.random.default_rng(42)
+    print(f"\n  {'poses':>6} {'python ms':>10} {'fused us':>10} {'speedup':>8} {'max |diff|':>11}")
+    for n in (int(x) for x in args.lengths.split(",")):
+        traj = make_trajectory(rng, n)
+        lam = 0.8
+        t_py = median_latency(python, traj, lam, max(3, args.reps // 4))
+        t_fu = median_latency(fused, traj, lam, args.reps)
+        np.random.seed(7)
+        a = python.verify_regeneration(traj, lam)
+        np.random.seed(7)
+        b = fused.verify_regeneration(traj, lam)
+        diff = max(abs(a.verifications[k] - b.verifications[k]) for k in a.verifications)
+        print(f"  {n:6d} {1e3 * t_py:10.2f} {1e6 * t_fu:10.1f} {t_py / t_fu:7.0f}x {diff:11.1e}")
+
+    print("\n[BENCH] compute_regenerative_metrics, 16 poses (resonance off)")
+    from lie_dynamics import metrics_service
+    data = {"poses": [{"rotation": (rng.normal(size=3) * 0.05).tolist(),
+                       "translation": (rng.normal(size=3) * 0.02).tolist()} for _ in range(16)]}
+    for label, cls in (("python cascade", VerificationCascade),
+                       ("fused cascade", FusedVerificationCascade)):
+        metrics_service.FusedVerificationCascade = cls
+        samples = []
+        for _ in range(5):
+            t0 = time.perf_counter()
+            metrics_service.compute_regenerative_metrics(data, enable_resonance_detection=False)
+            samples.append(time.perf_counter() - t0)
+        print(f"  {label:15s} {1e3 * np.median(samples):8.1f} ms")
+    metrics_service.FusedVerificationCascade = FusedVerificationCascade
+
+
+if __name__ == "__main__":
+    main()
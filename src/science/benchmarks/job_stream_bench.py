@@ -0,0 +1,134 @@
+"""
+Benchmark: Streamed Metrics Jobs vs. Single-Request Batch
+
+PROVENANCE:
+-----------
+Created for: Open Science DLT - Pillar I (Science)
+Purpose: Peak memory and time-to-first-result of /jobs vs. /metrics/batch
+
+For each batch size, starts api_server.py on a free local port (result
+cache off, metrics computed in-process so one PID holds all the memory),
+sends the same trajectories through
+
+    batch:  POST /metrics/batch (one JSON document in, one out)
+    jobs:   POST /jobs (NDJSON generated on the fly) + streamed GET .../results
+
+and reports:
+    1. Server peak RSS (VmHWM) growth over the idle server
+    2. Client peak heap (tracemalloc) while sending and consuming
+    3. Time to first result and total wall time
+
+Usage:
+    python benchmarks/job_stream_bench.py [--sizes 250,1000] [--poses 16]
+"""
+
+import argparse
+import http.client
+import json
+import sys
+import time
+import tracemalloc
+
+import numpy as np
+
+from load_gen import free_port, start_server
+
+OPTIONS = {"enable_resonance_detection": False, "enable_verification_cascade": False}
+
+
+def trajectories(n: int, poses: int, seed: int = 11):
+    """Generated lazily, so the jobs client never holds the batch"""
+    rng = np.random.default_rng(seed)
+    for _ in range(n):
+        yield {"poses": [{"rotation": (rng.normal(size=3) * 0.05).tolist(),
+                          "translation": (rng.normal(size=3) * 0.02).tolist()}
+                         for _ in range(poses)]}
+
+
+def peak_rss_kb(pid: int) -> int:
+    with open(f"/proc/{pid}/status") as f:
+        for line in f:
+            if line.startswith("VmHWM:"):
+                return int(line.split()[1])
+    return 0
+
+
+def run_batch(port: int, n: int, poses: int):
+    conn = http.client.HTTPConnection("127.0.0.1", port, timeout=3600)
+    t0 = time.perf_counter()
+    body = json.dumps({"trajectories": list(trajectories(n, poses)), "options": OPTIONS})
+    conn.request("POST", "/api/v1/science/metrics/batch", body,
+                 {"Content-Type": "application/json"})
+    data = json.loads(conn.getresponse().read())
+    wall = time.perf_counter() - t0
+    assert data["count"] == n
+    return wall, wall
+
+
+def run_jobs(port: int, n: int, poses: int):
+    def body():
+        yield (json.dumps({"options": OPTIONS}) + "\n").encode()
+        for t in trajectories(n, poses):
+            yield (json.dumps(t) + "\n").encode()
+
+    conn = http.client.HTTPConnection("127.0.0.1", port, timeout=3600)
+    t0 = time.perf_counter()
+    conn.request("POST", "/api/v1/science/jobs", body(),
+                 {"Content-Type": "application/x-ndjson", "Transfer-Encoding": "chunked"},
+                 encode_chunked=True)
+    job_id = json.loads(conn.getresponse().read())["data"]["job_id"]
+
+    conn.request("GET", f"/api/v1/science/jobs/{job_id}/results")
+    resp = conn.getresponse()
+    first = None
+    seen = 0
+    for line in resp:
+        item = json.loads(line)
+        if "summary" in item:
+            break
+        if first is None:
+            first = time.perf_counter() - t0
+        seen += 1
+    assert seen == n
+    return first, time.perf_counter() - t0
+
+
+def measure(mode: str, n: int, poses: int):
+    port = free_port()
+    proc = start_server(0, port)
+    try:
+        idle = peak_rss_kb(proc.pid)
+        tracemalloc.start()
+        first, wall = (run_batch if mode == "batch" else run_jobs)(port, n, poses)
+        _, client_peak = tracemalloc.get_traced_memory()
+        tracemalloc.stop()
+        server_growth = peak_rss_kb(proc.pid) - idle
+    finally:
+        proc.terminate()
+        proc.wait(timeout=10)
+    return server_growth / 1024, client_peak / 2**20, first, wall
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("--sizes", default="250,1000")
+    parser.add_argument("--poses", type=int, default=16)
+    args = parser.parse_args()
+    sizes = [int(s) for s in args.sizes.split(",")]
+
+    print("=" * 70)
+    print("STREAMED JOBS VS. SINGLE-REQUEST BATCH")
+    print("=" * 70)
+    print(f"{args.poses} poses per trajectory, resonance/verification off, cache off, "
+          f"in-process compute")
+    print(f"\n  {'mode':>6} {'batch':>6} {'server MiB':>11} {'client MiB':>11} "
+          f"{'first s':>8} {'wall s':>8}")
+    for n in sizes:
+        for mode in ("batch", "jobs"):
+            server, client, first, wall = measure(mode, n, args.poses)
+            print(f"  {mode:>6} {n:6d} {server:11.1f} {client:11.1f} {first:8.2f} {wall:8.1f}")
+            sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()
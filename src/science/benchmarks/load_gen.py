@@ -0,0 +1,146 @@
+"""
+Load Generator: Metrics Endpoint Throughput vs. Compute Workers
+
+PROVENANCE:
+-----------
+Created for: Open Science DLT - Pillar I (Science)
+Purpose: Measure how /api/v1/science/metrics scales with the worker pool
+
+For each worker count in the sweep, starts api_server.py on a free local
+port (result cache disabled, so every request computes), then drives it
+with closed-loop HTTP clients and reports:
+    1. Throughput (requests/s) and scaling vs. one worker
+    2. Latency p50 / p99
+    3. 503 responses (pool saturated; bounded queue working)
+
+SCIENCE_WORKERS=0 is the original behaviour: metrics computed in the
+Flask request thread (serialized by the GIL).
+
+Usage:
+    python benchmarks/load_gen.py [--workers 0,1,2,4] [--requests 64] [--clients 8]
+"""
+
+import argparse
+import http.client
+import json
+import os
+import socket
+import subprocess
+import sys
+import threading
+import time
+from pathlib import Path
+
+import numpy as np
+
+SCIENCE_DIR = Path(__file__).parent.parent
+
+
+def free_port() -> int:
+    with socket.socket() as s:
+        s.bind(("127.0.0.1", 0))
+        return s.getsockname()[1]
+
+
+def make_bodies(n: int, seed: int = 3) -> list:
+    """Distinct 16-pose trajectories (no two requests alike)"""
+    rng = np.random.default_rng(seed)
+    bodies = []
+    for _ in range(n):
+        poses = [{"rotation": (rng.normal(size=3) * 0.05).tolist(),
+                  "translation": (rng.normal(size=3) * 0.02).tolist()} for _ in range(16)]
+        bodies.append(json.dumps({"trajectory_data": {"poses": poses},
+                                  "options": {"enable_resonance_detection": False}}))
+    return bodies
+
+
+def start_server(workers: int, port: int) -> subprocess.Popen:
+    env = dict(os.environ,
+               SCIENCE_API_PORT=str(port),
+               SCIENCE_WORKERS=str(workers),
+               SCIENCE_CACHE_ENABLED="false",
+               SCIENCE_QUEUE_TIMEOUT="30")
+    proc = subprocess.Popen([sys.executable, str(SCIENCE_DIR / "api_server.py")], env=env,
+                            stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    deadline = time.time() + 30
+    while time.time() < deadline:
+        try:
+            conn = http.client.HTTPConnection("127.0.0.1", port, timeout=1)
+            conn.request("GET", "/api/v1/science/health")
+            if conn.getresponse().status == 200:
+                return proc
+        except OSError:
+            time.sleep(0.1)
+    proc.kill()
+    raise RuntimeError("server did not start")
+
+
+def drive(port: int, bodies: list, clients: int):
+    """Closed loop: each client sends its next request when the last returns"""
+    latencies, statuses = [], []
+    lock = threading.Lock()
+    it = iter(bodies)
+
+    def client():
+        conn = http.client.HTTPConnection("127.0.0.1", port, timeout=120)
+        while True:
+            with lock:
+                body = next(it, None)
+            if body is None:
+                return
+            t0 = time.perf_counter()
+            conn.request("POST", "/api/v1/science/metrics", body,
+                         {"Content-Type": "application/json"})
+            resp = conn.getresponse()
+            resp.read()
+            with lock:
+                latencies.append(time.perf_counter() - t0)
+                statuses.append(resp.status)
+
+    threads = [threading.Thread(target=client) for _ in range(clients)]
+    t0 = time.perf_counter()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    return time.perf_counter() - t0, np.array(latencies), statuses
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    cores = os.cpu_count() or 1
+    default_sweep = sorted({0, 1, 2, cores} | ({cores // 2} if cores >= 4 else set()))
+    parser.add_argument("--workers", default=",".join(map(str, default_sweep)))
+    parser.add_argument("--requests", type=int, default=64)
+    parser.add_argument("--clients", type=int, default=2 * cores)
+    args = parser.parse_args()
+    sweep = [int(w) for w in args.workers.split(",")]
+
+    print("=" * 70)
+    print("METRICS ENDPOINT LOAD GENERATOR")
+    print("=" * 70)
+    print(f"{cores} cores; {args.requests} requests (16 poses each), "
+          f"{args.clients} closed-loop clients, cache off")
+    print(f"\n  {'workers':>8} {'req/s':>8} {'scaling':>8} {'p50 ms':>8} {'p99 ms':>8} {'503s':>6}")
+
+    base_rps = None
+    for workers in sweep:
+        port = free_port()
+        proc = start_server(workers, port)
+        try:
+            drive(port, make_bodies(args.clients, seed=99), args.clients)  # Warm-up
+            wall, lat, statuses = drive(port, make_bodies(args.requests), args.clients)
+        finally:
+            proc.terminate()
+            proc.wait(timeout=10)
+        ok = sum(s == 200 for s in statuses)
+        rps = ok / wall
+        if workers == 1:
+            base_rps = rps
+        scaling = f"{rps / base_rps:.2f}x" if base_rps and workers >= 1 else "-"
+        print(f"  {workers:>8} {rps:8.2f} {scaling:>8} {1e3 * np.percentile(lat, 50):8.0f} "
+              f"{1e3 * np.percentile(lat, 99):8.0f} {sum(s == 503 for s in statuses):6d}")
+
+
+if __name__ == "__main__":
+    main()
@@ -25,6 +25,13 @@ import {
   BatchMetricsResponse,
   HealthCheckResponse,
   VersionInfoResponse,
+  CacheStatsResponse,
+  PoolStatsResponse,
+  JobSubmitResponse,
+  JobStatusResponse,
+  JobProgress,
+  JobResultLine,
+  JobStreamEnd,
   ScienceServiceError,
   ValidationError,
   ServiceUnavailableError,
@@ -194,6 +201,126 @@ export class ScienceServiceClient {
     return response.data.data;
   }
 
+  /**
+   * Submit trajectories as an asynchronous job
+   *
+   * The body is sent as NDJSON (options line, then one trajectory per
+   * line); pass an iterable (e.g. a generator reading from disk) to avoid
+   * building the batch in memory.
+   *
+   * @param trajectories - Trajectory data, any iterable
+   * @param options - Computation options
+   * @returns Job ID and trajectory count
+   */
+  async submitJob(
+    trajectories: Iterable<TrajectoryData>,
+    options?: MetricsComputationOptions
+  ): Promise<{ jobId: string; total: number }> {
+    const { Readable } = await import('stream');
+    const lines = function* () {
+      if (options) {
+        yield JSON.stringify({ options }) + '\n';
+      }
+      for (const trajectory of trajectories) {
+        yield JSON.stringify(trajectory) + '\n';
+      }
+    };
+
+    const response = await this.client.post<JobSubmitResponse>(
+      '/api/v1/science/jobs',
+      Readable.from(lines()),
+      {
+        headers: { 'Content-Type': 'application/x-ndjson' },
+        maxBodyLength: Infinity,
+      }
+    );
+
+    if (response.data.status !== 'accepted' || !response.data.data) {
+      throw new ScienceServiceError(
+        response.data.error || 'Job submission failed',
+        response.status
+      );
+    }
+
+    return { jobId: response.data.data.job_id, total: response.data.data.total };
+  }
+
+  /**
+   * Get job progress
+   *
+   * @param jobId - Job ID from submitJob
+   * @returns Status, counts and throughput so far
+   */
+  async getJob(jobId: string): Promise<JobProgress> {
+    const response = await this.client.get<JobStatusResponse>(
+      `/api/v1/science/jobs/${jobId}`
+    );
+
+    return response.data.data as JobProgress;
+  }
+
+  /**
+   * Cancel a job (trajectories already computing still report results)
+   *
+   * @param jobId - Job ID from submitJob
+   * @returns Progress at cancellation
+   */
+  async cancelJob(jobId: string): Promise<JobProgress> {
+    const response = await this.client.delete<JobStatusResponse>(
+      `/api/v1/science/jobs/${jobId}`
+    );
+
+    return response.data.data as JobProgress;
+  }
+
+  /**
+   * Stream a job's results as they complete
+   *
+   * Yields one line per trajectory (completion order; `index` is the
+   * position in the submitted batch) and returns the final summary. Only
+   * the current chunk is buffered, so memory stays flat for any batch size.
+   * After a dropped connection, resume with fromLine = lines received.
+   *
+   * @param jobId - Job ID from submitJob
+   * @param fromLine - Result lines to skip
+   *
+   * @example
+   * ```typescript
+   * const { jobId } = await client.submitJob(readTrajectories());
+   * for await (const line of client.streamJobResults(jobId)) {
+   *   if (line.status === 'success') store(line.index, line.data);
+   * }
+   * ```
+   */
+  async *streamJobResults(
+    jobId: string,
+    fromLine: number = 0
+  ): AsyncGenerator<JobResultLine, JobStreamEnd | undefined> {
+    const response = await this.client.get(
+      `/api/v1/science/jobs/${jobId}/results`,
+      {
+        params: { from: fromLine },
+        responseType: 'stream',
+        timeout: 0, // Runs as long as the job
+      }
+    );
+
+    let pending = '';
+    for await (const chunk of response.data as AsyncIterable<Buffer>) {
+      pending += chunk.toString('utf8');
+      let newline: number;
+      while ((newline = pending.indexOf('\n')) >= 0) {
+        const line = JSON.parse(pending.slice(0, newline));
+        pending = pending.slice(newline + 1);
+        if ('summary' in line) {
+          return line as JobStreamEnd;
+        }
+        yield line as JobResultLine;
+      }
+    }
+    return undefined; // Connection closed before the job finished
+  }
+
   /**
    * Check health status of the science service
    *
@@ -220,6 +347,32 @@ export class ScienceServiceClient {
     return response.data;
   }
 
+  /**
+   * Get result cache statistics (hit rates and latency)
+   *
+   * @returns Cache stats response
+   */
+  async getCacheStats(): Promise<CacheStatsResponse> {
+    const response = await this.client.get<CacheStatsResponse>(
+      '/api/v1/science/cache/stats'
+    );
+
+    return response.data;
+  }
+
+  /**
+   * Get compute worker pool statistics (occupancy, rejections)
+   *
+   * @returns Pool stats response
+   */
+  async getPoolStats(): Promise<PoolStatsResponse> {
+    const response = await this.client.get<PoolStatsResponse>(
+      '/api/v1/science/pool/stats'
+    );
+
+    return response.data;
+  }
+
   /**
    * Check if the science service is available
    *
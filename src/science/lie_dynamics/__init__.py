@@ -16,6 +16,7 @@ Modules:
 - se3_double_scale: Core SE(3) operations and λ optimization
 - resonance_aware: Experimental verification cascade and resonance detection
 - metrics_service: REST API service for regenerative metrics computation
+- result_cache: Content-addressed LRU cache of metrics results
 """
 
 from .se3_double_scale import (
@@ -45,6 +46,14 @@ from .resonance_aware import (
     ResonanceAwareOptimizer
 )
 
+from .fused_cascade import FusedVerificationCascade
+
+from .result_cache import (
+    MetricsResultCache,
+    trajectory_key,
+    cache_from_env
+)
+
 __version__ = "1.0.0"
 __author__ = "UCF Core Team + Open Science DLT"
 __license__ = "MIT"
@@ -80,4 +89,10 @@ __all__ = [
     "VerificationResult",
     "NarrativeQualityMetric",
     "ResonanceAwareOptimizer",
+    "FusedVerificationCascade",
+
+    # Result memoization
+    "MetricsResultCache",
+    "trajectory_key",
+    "cache_from_env",
 ]
@@ -0,0 +1,180 @@
+"""
+Fused Single-Pass Verification Cascade (native kernel)
+
+PROVENANCE:
+-----------
+Created for: Open Science DLT - Pillar I (Science)
+Purpose: VerificationCascade.verify_regeneration without redundant passes
+
+VerificationCascade runs its five levels independently. Return quality,
+energy conservation and every noise trial each rescale the trajectory
+(a rotation log and exp per pose), and all of them rebuild SE3Pose and
+SE3Trajectory objects. FusedVerificationCascade hands the pose arrays to
+native/cascade.c, which takes each pose's log once, composes the scaled
+poses once (the doubled product is H·H), and derives every level from
+that pass. The noise trials run in the same loop.
+
+The result is the same VerificationResult. Noise is drawn from np.random in
+the order verify_noise_robustness draws it, so under a fixed seed the two
+cascades agree to rounding. Out-of-bounds derived trajectories raise the
+same AssertionError.
+
+The kernel is compiled on first use with $CC (default `cc`) into
+native/, or into the per-user private cache dir (see private_cache_dir)
+when native/ is read-only; never the shared temp dir, where another user
+could plant the library. Without a compiler, or with SCIENCE_NATIVE=0,
+the Python cascade runs instead.
+"""
+
+import ctypes
+import logging
+import os
+import stat
+import subprocess
+import threading
+from pathlib import Path
+from typing import Optional
+
+import numpy as np
+
+from .resonance_aware import VerificationCascade, VerificationResult
+from .result_cache import private_cache_dir
+from .se3_double_scale import SE3Trajectory
+
+logger = logging.getLogger(__name__)
+
+NATIVE_SOURCE = Path(__file__).parent / "native" / "cascade.c"
+LIBRARY_NAME = "libse3cascade.so"
+
+LEVELS = ("topological", "energetic", "temporal", "spatial", "stochastic")
+_BOUNDS_STATUS = {1: "scaled", 2: "noisy", 3: "noisy scaled"}
+
+_native = None
+_native_lock = threading.Lock()
+_native_failed = False
+
+_dp = ctypes.POINTER(ctypes.c_double)
+
+
+def _build(target: Path) -> None:
+    tmp = target.with_suffix(f".{os.getpid()}.tmp")
+    cc = os.environ.get("CC", "cc")
+    subprocess.run([cc, "-O2", "-fPIC", "-shared", "-o", str(tmp), str(NATIVE_SOURCE), "-lm"],
+                   check=True, capture_output=True)
+    os.replace(tmp, target)
+
+
+def _check_owned(target: Path) -> None:
+    """Refuse a cached library another user could have written."""
+    st = os.lstat(target)
+    if not stat.S_ISREG(st.st_mode) or st.st_uid != os.geteuid() or st.st_mode & 0o022:
+        raise OSError(f"{target} is not a file owned and writable only by this user")
+
+
+def load_native() -> Optional[ctypes.CDLL]:
+    """
+    Load (building if stale) the cascade kernel.
+
+    Returns:
+        The library, or None when disabled or unbuildable (logged once)
+    """
+    global _native, _native_failed
+    if _native is not None or _native_failed:
+        return _native
+    if os.environ.get("SCIENCE_NATIVE", "1") == "0":
+        _native_failed = True
+        return None
+    with _native_lock:
+        if _native is not None or _native_failed:
+            return _native
+        private = private_cache_dir("se3_metrics")
+        directories = [NATIVE_SOURCE.parent] + ([Path(private)] if private else [])
+        for directory in directories:
+            target = directory / LIBRARY_NAME
+            try:
+                if not target.exists() or target.stat().st_mtime < NATIVE_SOURCE.stat().st_mtime:
+                    _build(target)
+                if directory != NATIVE_SOURCE.parent:
+                    _check_owned(target)
+                lib = ctypes.CDLL(str(target))
+                break
+            except (OSError, subprocess.CalledProcessError) as e:
+                logger.debug(f"Native cascade unavailable in {directory}: {e}")
+        else:
+            logger.warning("Native verification cascade unavailable; using Python cascade")
+            _native_failed = True
+            return None
+
+        lib.cascade_verify.restype = ctypes.c_int
+        lib.cascade_verify.argtypes = [_dp, _dp, _dp, ctypes.c_int, ctypes.c_double, ctypes.c_int,
+                                       ctypes.c_double, _dp, ctypes.c_int, _dp, _dp]
+        _native = lib
+        return _native
+
+
+def _ptr(a: np.ndarray):
+    return a.ctypes.data_as(_dp)
+
+
+class FusedVerificationCascade(VerificationCascade):
+    """
+    Drop-in VerificationCascade computing every level in one native pass.
+
+    Args:
+        weights: Relative importance of each verification level
+        thresholds: Pass/fail thresholds for each level
+        num_trials: Noise robustness trials (verify_noise_robustness default)
+        noise_level: Noise standard deviation (verify_noise_robustness default)
+    """
+
+    def __init__(self, weights=None, thresholds=None, num_trials: int = 10,
+                 noise_level: float = 0.05):
+        super().__init__(weights, thresholds)
+        self.num_trials = num_trials
+        self.noise_level = noise_level
+
+    @property
+    def native(self) -> bool:
+        """True when verify_regeneration runs the native kernel"""
+        return load_native() is not None
+
+    def verify_regeneration(
+        self,
+        trajectory: SE3Trajectory,
+        lambda_opt: float,
+        base_token_amount: float = 100.0
+    ) -> VerificationResult:
+        """
+        Multi-level verification, fused (same result as VerificationCascade)
+
+        Args:
+            trajectory: SE(3) trajectory to verify
+            lambda_opt: Optimized scaling factor
+            base_token_amount: Base REGEN token amount (scaled by score)
+
+        Returns:
+            VerificationResult with overall score and token award
+        """
+        lib = load_native()
+        n = len(trajectory)
+        if lib is None or n == 0 or self.num_trials < 1:
+            return super().verify_regeneration(trajectory, lambda_opt, base_token_amount)
+
+        rot = np.ascontiguousarray([p.rotation for p in trajectory.poses], dtype=np.float64)
+        trans = np.ascontiguousarray([p.translation for p in trajectory.poses], dtype=np.float64)
+        # One draw in verify_noise_robustness order: trial → pose → (rotation, translation)
+        noise = np.random.normal(0, self.noise_level, size=(self.num_trials, n, 2, 3))
+        scratch = np.empty((n, 3))
+        out = np.empty(len(LEVELS))
+        violation = ctypes.c_double(0.0)
+
+        status = lib.cascade_verify(_ptr(rot), _ptr(trans), _ptr(scratch), n, float(lambda_opt),
+                                    int(trajectory.bounded), float(trajectory.r_max),
+                                    _ptr(noise), self.num_trials, _ptr(out), ctypes.byref(violation))
+        if status != 0:
+            # Same failure as SE3Trajectory._validate_bounds in the Python cascade
+            raise AssertionError(f"Translation norm {violation.value} exceeds r_max "
+                                 f"{trajectory.r_max} ({_BOUNDS_STATUS[status]} trajectory)")
+
+        verifications = {level: float(value) for level, value in zip(LEVELS, out)}
+        return self.score_verifications(verifications, base_token_amount)
@@ -0,0 +1,331 @@
+"""
+Asynchronous Metrics Jobs with Spooled, Streamable Results
+
+PROVENANCE:
+-----------
+Created for: Open Science DLT - Pillar I (Science)
+Purpose: Large batches without long-held requests or whole-batch buffers
+
+/metrics/batch holds the HTTP request open until every trajectory is done
+and materializes the whole response. A job instead:
+
+    submit:   request body (NDJSON, one trajectory per line) is copied to an
+              input spool file as it arrives → 202 with a job ID
+    run:      a runner thread reads the spool one line at a time and keeps
+              at most `max_in_flight` trajectories computing (worker pool
+              slots or inline); each finished item appends one NDJSON line
+              {"index", "status", "data" | "error"} to a result spool
+    stream:   GET .../results tails the result spool, so clients see items
+              as they finish; ?from=N resumes after a dropped connection
+    cancel:   DELETE stops dispatching; in-flight items finish and are kept
+
+Memory is bounded by max_in_flight trajectories, not by batch size: neither
+the input nor the results are ever held in full. Results are written in
+completion order; "index" is the trajectory's position in the input.
+Finished jobs and their spools are removed after `ttl` seconds.
+"""
+
+import json
+import logging
+import os
+import shutil
+import tempfile
+import threading
+import time
+import uuid
+from concurrent.futures import ThreadPoolExecutor
+from typing import Any, Callable, Dict, IO, Iterator, Optional
+
+from .metrics_service import compute_regenerative_metrics
+from .result_cache import MetricsResultCache, canonical_options
+
+logger = logging.getLogger(__name__)
+
+QUEUED = "queued"
+RUNNING = "running"
+DONE = "done"
+CANCELLED = "cancelled"
+FAILED = "failed"
+FINISHED_STATES = (DONE, CANCELLED, FAILED)
+
+
+class Job:
+    """One submitted batch: spool files, counters and a change condition."""
+
+    def __init__(self, job_id: str, directory: str, options: Dict[str, Any]):
+        self.id = job_id
+        self.dir = directory
+        self.input_path = os.path.join(directory, "input.ndjson")
+        self.results_path = os.path.join(directory, "results.ndjson")
+        self.options = options
+        self.state = QUEUED
+        self.total = 0
+        self.completed = 0
+        self.failed = 0
+        self.created = time.time()
+        self.started: Optional[float] = None
+        self.finished: Optional[float] = None
+        self.error: Optional[str] = None
+        self.cancel_requested = False
+        self.cond = threading.Condition()
+        self._out: Optional[IO[str]] = None
+
+    def append_result(self, line: Dict[str, Any]) -> None:
+        """Append one result line and wake streaming readers."""
+        with self.cond:
+            self._out.write(json.dumps(line, default=str) + "\n")
+            self._out.flush()
+            if line["status"] == "success":
+                self.completed += 1
+            else:
+                self.failed += 1
+            self.cond.notify_all()
+
+    def finish(self, state: str, error: Optional[str] = None) -> None:
+        with self.cond:
+            self.state = state
+            self.error = error
+            self.finished = time.time()
+            if self._out is not None:
+                self._out.close()
+            self.cond.notify_all()
+
+    def progress(self) -> Dict[str, Any]:
+        """Status document for GET /jobs/<id>"""
+        processed = self.completed + self.failed
+        now = self.finished or time.time()
+        elapsed = now - self.started if self.started else 0.0
+        return {
+            "job_id": self.id,
+            "status": self.state,
+            "total": self.total,
+            "completed": self.completed,
+            "failed": self.failed,
+            "progress": processed / self.total if self.total else 0.0,
+            "elapsed_s": elapsed,
+            "items_per_s": processed / elapsed if elapsed > 0 else None,
+            "error": self.error,
+        }
+
+
+class JobManager:
+    """
+    Runs metrics jobs in the background and serves their result streams.
+
+    Args:
+        compute_fn: compute_regenerative_metrics-compatible callable
+            (e.g. MetricsWorkerPool.compute_metrics)
+        cache: Optional result cache
+        spool_dir: Directory for job spools (default: a fresh temp dir)
+        runners: Jobs processed concurrently (others stay queued)
+        max_in_flight: Trajectories computing at once per job
+        ttl: Seconds a finished job stays retrievable
+    """
+
+    def __init__(self, compute_fn: Callable[..., Dict[str, Any]] = compute_regenerative_metrics,
+                 cache: Optional[MetricsResultCache] = None, spool_dir: Optional[str] = None,
+                 runners: int = 2, max_in_flight: int = 4, ttl: float = 3600.0):
+        self.compute_fn = compute_fn
+        self.cache = cache
+        self.spool_dir = spool_dir or tempfile.mkdtemp(prefix="se3_jobs_")
+        os.makedirs(self.spool_dir, exist_ok=True)
+        self.max_in_flight = max_in_flight
+        self.ttl = ttl
+        self._jobs: Dict[str, Job] = {}
+        self._lock = threading.Lock()
+        self._runners = ThreadPoolExecutor(max_workers=runners, thread_name_prefix="metrics-job")
+
+    # ------------------------------------------------------------------
+    # Submission
+    # ------------------------------------------------------------------
+
+    def submit(self, body: Iterator[bytes], options: Optional[Dict[str, Any]] = None) -> Job:
+        """
+        Spool an NDJSON body (one trajectory_data object per line) and queue it.
+
+        A first line of the form {"options": {...}} sets the job's options
+        (overriding `options`). Blank lines are skipped; lines are not
+        parsed until the job runs, so malformed lines become per-item errors.
+
+        Args:
+            body: Iterable of byte chunks (e.g. the request stream)
+            options: Metrics options
+
+        Returns:
+            The queued job
+
+        Raises:
+            ValueError: no trajectories, or an unparseable options line
+        """
+        self._expire()
+        job_id = uuid.uuid4().hex
+        directory = os.path.join(self.spool_dir, job_id)
+        os.makedirs(directory)
+        try:
+            total, header = self._spool(body, os.path.join(directory, "input.ndjson"))
+            if total == 0:
+                raise ValueError("No trajectories provided")
+            opts = canonical_options(**((header or {}).get("options") or options or {}))
+        except Exception:
+            shutil.rmtree(directory, ignore_errors=True)
+            raise
+
+        job = Job(job_id, directory, opts)
+        job.total = total
+        with self._lock:
+            self._jobs[job_id] = job
+        self._runners.submit(self._run, job)
+        logger.info(f"Job {job_id}: {total} trajectories queued")
+        return job
+
+    @staticmethod
+    def _spool(body: Iterator[bytes], path: str):
+        """Copy body lines to `path`; returns (trajectory count, options header)."""
+        total = 0
+        header: Optional[Dict[str, Any]] = None
+        pending = b""
+        with open(path, "wb") as f:
+            def take(line: bytes) -> None:
+                nonlocal total, header
+                if not line.strip():
+                    return
+                if total == 0 and header is None and line.lstrip().startswith(b'{"options"'):
+                    try:
+                        header = json.loads(line)
+                    except ValueError as e:
+                        raise ValueError(f"Invalid options line: {e}") from None
+                    return
+                f.write(line.rstrip(b"\r\n") + b"\n")
+                total += 1
+
+            for chunk in body:
+                pending += chunk
+                *lines, pending = pending.split(b"\n")
+                for line in lines:
+                    take(line)
+            take(pending)
+        return total, header
+
+    def submit_list(self, trajectories: list, options: Optional[Dict[str, Any]] = None) -> Job:
+        """submit() for an already-parsed list (JSON request bodies)."""
+        lines = (json.dumps(t).encode() + b"\n" for t in trajectories)
+        return self.submit(lines, options)
+
+    # ------------------------------------------------------------------
+    # Execution
+    # ------------------------------------------------------------------
+
+    def _compute_one(self, job: Job, index: int, line: str) -> None:
+        try:
+            trajectory_data = json.loads(line)
+            if self.cache is not None:
+                metrics, _ = self.cache.compute(self.compute_fn, trajectory_data, **job.options)
+            else:
+                metrics = self.compute_fn(trajectory_data, **job.options)
+            job.append_result({"index": index, "status": "success", "data": metrics})
+        except Exception as e:
+            job.append_result({"index": index, "status": "error", "error": str(e)})
+
+    def _run(self, job: Job) -> None:
+        if job.cancel_requested:
+            job.finish(CANCELLED)
+            return
+        job.state = RUNNING
+        job.started = time.time()
+        job._out = open(job.results_path, "w")
+        slots = threading.BoundedSemaphore(self.max_in_flight)
+        try:
+            with ThreadPoolExecutor(max_workers=self.max_in_flight) as items, \
+                    open(job.input_path) as f:
+                for index, line in enumerate(f):
+                    slots.acquire()
+                    if job.cancel_requested:
+                        slots.release()
+                        break
+                    future = items.submit(self._compute_one, job, index, line)
+                    future.add_done_callback(lambda _: slots.release())
+            job.finish(CANCELLED if job.cancel_requested else DONE)
+        except Exception as e:  # Spool I/O failure
+            logger.error(f"Job {job.id} failed: {e}", exc_info=True)
+            job.finish(FAILED, str(e))
+        logger.info(f"Job {job.id}: {job.state} ({job.completed} ok, {job.failed} errors)")
+
+    # ------------------------------------------------------------------
+    # Queries
+    # ------------------------------------------------------------------
+
+    def get(self, job_id: str) -> Optional[Job]:
+        with self._lock:
+            return self._jobs.get(job_id)
+
+    def cancel(self, job_id: str) -> Optional[Job]:
+        """Stop dispatching new items (in-flight items complete)."""
+        job = self.get(job_id)
+        if job is not None and job.state not in FINISHED_STATES:
+            job.cancel_requested = True
+        return job
+
+    def stream(self, job: Job, start: int = 0, poll: float = 1.0) -> Iterator[str]:
+        """
+        Yield result lines from the spool as they are written.
+
+        Args:
+            job: Job to follow
+            start: Result lines to skip (resume offset)
+            poll: Max seconds between checks for new lines
+
+        Yields:
+            NDJSON lines (with newline); ends with a {"status": <state>,
+            "summary": ...} line once the job has finished
+        """
+        skipped = 0
+        with job.cond:
+            while job._out is None and job.state not in FINISHED_STATES:
+                job.cond.wait(poll)
+        if os.path.exists(job.results_path):
+            with open(job.results_path, "rb") as f:
+                buf = b""
+                while True:
+                    chunk = f.readline()
+                    if chunk:
+                        buf += chunk
+                        if not buf.endswith(b"\n"):
+                            continue  # Partial line: writer mid-flush
+                        line, buf = buf, b""
+                        if skipped < start:
+                            skipped += 1
+                            continue
+                        yield line.decode()
+                        continue
+                    with job.cond:
+                        if job.state in FINISHED_STATES and f.tell() == os.path.getsize(job.results_path):
+                            break
+                        job.cond.wait(poll)
+        yield json.dumps({"status": job.state, "summary": job.progress()}) + "\n"
+
+    def stats(self) -> Dict[str, Any]:
+        with self._lock:
+            jobs = list(self._jobs.values())
+        by_state: Dict[str, int] = {}
+        for j in jobs:
+            by_state[j.state] = by_state.get(j.state, 0) + 1
+        return {"jobs": len(jobs), "by_state": by_state, "spool_dir": self.spool_dir}
+
+    def _expire(self) -> None:
+        """Drop finished jobs older than ttl (and their spools)."""
+        cutoff = time.time() - self.ttl
+        with self._lock:
+            expired = [j for j in self._jobs.values()
+                       if j.finished is not None and j.finished < cutoff]
+            for j in expired:
+                del self._jobs[j.id]
+        for j in expired:
+            shutil.rmtree(j.dir, ignore_errors=True)
+
+    def close(self) -> None:
+        """Cancel running jobs and stop the runners."""
+        with self._lock:
+            jobs = list(self._jobs.values())
+        for j in jobs:
+            j.cancel_requested = True
+        self._runners.shutdown(wait=True)
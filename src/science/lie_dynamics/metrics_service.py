@@ -38,10 +38,10 @@ from .se3_double_scale import (
     verify_approximate_return
 )
 
-from .resonance_aware import (
-    VerificationCascade,
-    ResonanceDetector
-)
+from .resonance_aware import ResonanceDetector
+from .fused_cascade import FusedVerificationCascade
+
+from .result_cache import MetricsResultCache
 
 # Configure logging
 logging.basicConfig(level=logging.INFO)
@@ -339,7 +339,7 @@ def compute_regenerative_metrics(
 
         if enable_verification_cascade:
             logger.info("Running verification cascade")
-            cascade = VerificationCascade()
+            cascade = FusedVerificationCascade()  # Python cascade if no native kernel
             verification_result = cascade.verify_regeneration(
                 trajectory,
                 optimal_lambda,
@@ -391,6 +391,7 @@ def compute_regenerative_metrics(
 
 def compute_batch_metrics(
     trajectories: List[Dict[str, Any]],
+    cache: Optional["MetricsResultCache"] = None,
     **kwargs
 ) -> List[Dict[str, Any]]:
     """
@@ -398,6 +399,7 @@ def compute_batch_metrics(
 
     Args:
         trajectories: List of trajectory data dictionaries
+        cache: Optional result cache (repeated trajectories computed once)
         **kwargs: Additional arguments passed to compute_regenerative_metrics
 
     Returns:
@@ -408,7 +410,10 @@ def compute_batch_metrics(
     for i, trajectory_data in enumerate(trajectories):
         logger.info(f"Processing trajectory {i + 1}/{len(trajectories)}")
         try:
-            metrics = compute_regenerative_metrics(trajectory_data, **kwargs)
+            if cache is not None:
+                metrics, _ = cache.compute(compute_regenerative_metrics, trajectory_data, **kwargs)
+            else:
+                metrics = compute_regenerative_metrics(trajectory_data, **kwargs)
             results.append(metrics)
         except Exception as e:
             logger.error(f"Error processing trajectory {i + 1}: {str(e)}")
@@ -0,0 +1,282 @@
+/*
+ * cascade.c - Fused Single-Pass Verification Cascade
+ *
+ * Native kernel behind lie_dynamics.fused_cascade. Computes all five
+ * VerificationCascade levels from one walk over the poses:
+ *
+ *   per pose (once):   r_i = log(R_i), |p_i|, g_i^λ = (exp(λ r_i), λ p_i)
+ *   topological:       H = Π g_i^λ, G = H·H (the doubled product is the
+ *                      single-pass product squared, not 2n compositions)
+ *   energetic:         mean |log g_i^λ| + |λ p_i| (doubled mean = single mean)
+ *   temporal:          CV of |r_{i+1} - r_i| + |p_{i+1} - p_i| (reuses r_i)
+ *   spatial:           max |p_i| ≤ r_max
+ *   stochastic:        per trial, perturbed poses are scaled and composed in
+ *                      the same pass; baseline error is the topological one
+ *
+ * Rotation log/exp follow scipy.spatial.transform.Rotation (quaternion
+ * path, same small-angle series), so results match the Python cascade to
+ * rounding. Noise is supplied by the caller to keep its RNG stream.
+ *
+ * Build: cc -O2 -fPIC -shared -o libse3cascade.so cascade.c -lm
+ * (done on first use by fused_cascade.load_native)
+ */
+
+#include <math.h>
+#include <string.h>
+
+/* Status codes: a bounded trajectory left the r_max ball (Python asserts) */
+#define CASCADE_OK              0
+#define CASCADE_SCALED_BOUNDS   1  /* λ·p_i outside r_max */
+#define CASCADE_NOISY_BOUNDS    2  /* p_i + noise outside r_max */
+#define CASCADE_NOISY_SCALED    3  /* λ·(p_i + noise) outside r_max */
+
+/* Output slots */
+#define OUT_TOPOLOGICAL  0
+#define OUT_ENERGETIC    1
+#define OUT_TEMPORAL     2
+#define OUT_SPATIAL      3
+#define OUT_STOCHASTIC   4
+
+/* ========================================================================
+ * SO(3) HELPERS
+ * ======================================================================== */
+
+static double norm3(const double *v) {
+    return sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+
+/* Rotation matrix (row-major) → rotation vector, via quaternion (Shepperd) */
+static void so3_log(const double *m, double *rv) {
+    double q[4];
+    double trace = m[0] + m[4] + m[8];
+    int choice = 3;
+    double best = trace;
+    for (int i = 0; i < 3; i++) {
+        if (m[4 * i] > best) {
+            best = m[4 * i];
+            choice = i;
+        }
+    }
+    if (choice != 3) {
+        int i = choice, j = (i + 1) % 3, k = (j + 1) % 3;
+        q[i] = 1.0 - trace + 2.0 * m[4 * i];
+        q[j] = m[3 * j + i] + m[3 * i + j];
+        q[k] = m[3 * k + i] + m[3 * i + k];
+        q[3] = m[3 * k + j] - m[3 * j + k];
+    } else {
+        q[0] = m[7] - m[5];
+        q[1] = m[2] - m[6];
+        q[2] = m[3] - m[1];
+        q[3] = 1.0 + trace;
+    }
+    double qn = sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    double sign = q[3] < 0.0 ? -1.0 : 1.0;  /* w ≥ 0: angle in [0, π] */
+    for (int i = 0; i < 4; i++) {
+        q[i] *= sign / qn;
+    }
+
+    double angle = 2.0 * atan2(norm3(q), q[3]);
+    double scale;
+    if (angle <= 1e-3) {
+        double a2 = angle * angle;
+        scale = 2.0 + a2 / 12.0 + 7.0 * a2 * a2 / 2880.0;
+    } else {
+        scale = angle / sin(angle / 2.0);
+    }
+    rv[0] = scale * q[0];
+    rv[1] = scale * q[1];
+    rv[2] = scale * q[2];
+}
+
+/* Rotation vector → rotation matrix (row-major), via quaternion */
+static void so3_exp(const double *rv, double *m) {
+    double angle = norm3(rv);
+    double scale;
+    if (angle <= 1e-3) {
+        double a2 = angle * angle;
+        scale = 0.5 - a2 / 48.0 + a2 * a2 / 3840.0;
+    } else {
+        scale = sin(angle / 2.0) / angle;
+    }
+    double x = scale * rv[0], y = scale * rv[1], z = scale * rv[2];
+    double w = cos(angle / 2.0);
+    double n = sqrt(x * x + y * y + z * z + w * w);
+    x /= n; y /= n; z /= n; w /= n;
+
+    m[0] = x * x - y * y - z * z + w * w;
+    m[1] = 2.0 * (x * y - z * w);
+    m[2] = 2.0 * (x * z + y * w);
+    m[3] = 2.0 * (x * y + z * w);
+    m[4] = -x * x + y * y - z * z + w * w;
+    m[5] = 2.0 * (y * z - x * w);
+    m[6] = 2.0 * (x * z - y * w);
+    m[7] = 2.0 * (y * z + x * w);
+    m[8] = -x * x - y * y + z * z + w * w;
+}
+
+/* (R, p) ← (R, p) · (Rb, pb) */
+static void se3_compose_into(double *r, double *p, const double *rb, const double *pb) {
+    double rn[9], pn[3];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            rn[3 * i + j] = r[3 * i] * rb[j] + r[3 * i + 1] * rb[3 + j] + r[3 * i + 2] * rb[6 + j];
+        }
+        pn[i] = r[3 * i] * pb[0] + r[3 * i + 1] * pb[1] + r[3 * i + 2] * pb[2] + p[i];
+    }
+    memcpy(r, rn, sizeof rn);
+    memcpy(p, pn, sizeof pn);
+}
+
+static void se3_identity(double *r, double *p) {
+    static const double eye[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+    memcpy(r, eye, sizeof eye);
+    p[0] = p[1] = p[2] = 0.0;
+}
+
+/* ||G - I||_F + |p| for G = H·H */
+static double doubled_return_error(const double *hr, const double *hp) {
+    double gr[9], gp[3];
+    memcpy(gr, hr, sizeof gr);
+    memcpy(gp, hp, sizeof gp);
+    se3_compose_into(gr, gp, hr, hp);
+    double f = 0.0;
+    for (int i = 0; i < 9; i++) {
+        double d = gr[i] - ((i % 4) == 0 ? 1.0 : 0.0);
+        f += d * d;
+    }
+    return sqrt(f) + norm3(gp);
+}
+
+/* |r_{i+1} - r_i| + |p_{i+1} - p_i| */
+static double step_size(const double *rv, const double *trans, int i) {
+    double dr[3], dp[3];
+    for (int k = 0; k < 3; k++) {
+        dr[k] = rv[3 * (i + 1) + k] - rv[3 * i + k];
+        dp[k] = trans[3 * (i + 1) + k] - trans[3 * i + k];
+    }
+    return norm3(dr) + norm3(dp);
+}
+
+/* ========================================================================
+ * FUSED CASCADE
+ * ======================================================================== */
+
+/**
+ * Compute all verification levels in one pass.
+ *
+ * @param rot       n rotation matrices, row-major (n×9)
+ * @param trans     n translations (n×3)
+ * @param rv        Scratch for n rotation vectors (n×3)
+ * @param n         Number of poses (≥ 1)
+ * @param lambda    Scaling factor λ
+ * @param bounded   Enforce |p| ≤ r_max on derived trajectories
+ * @param r_max     Translation bound
+ * @param noise     trials×n×6 perturbations: rotation (3) then translation (3)
+ * @param trials    Number of noise trials
+ * @param out       Raw level values [topological, energetic, temporal,
+ *                  spatial (0/1), stochastic]
+ * @param violation Offending translation norm when status != CASCADE_OK
+ * @return CASCADE_OK or a CASCADE_*_BOUNDS status
+ */
+int cascade_verify(const double *rot, const double *trans, double *rv, int n,
+                   double lambda, int bounded, double r_max,
+                   const double *noise, int trials, double *out, double *violation) {
+    double hr[9], hp[3];
+    double work = 0.0, inside = 1.0;
+    se3_identity(hr, hp);
+
+    /* Pass 1: logs, scaled poses, composition, work, bounds */
+    for (int i = 0; i < n; i++) {
+        const double *p = trans + 3 * i;
+        double srv[3], sr[9], sp[3], slog[3];
+        so3_log(rot + 9 * i, rv + 3 * i);
+        for (int k = 0; k < 3; k++) {
+            srv[k] = lambda * rv[3 * i + k];
+            sp[k] = lambda * p[k];
+        }
+        double pn = norm3(p);
+        double spn = norm3(sp);
+        if (pn > r_max) {
+            inside = 0.0;
+        }
+        if (bounded && spn > r_max) {
+            *violation = spn;
+            return CASCADE_SCALED_BOUNDS;
+        }
+        so3_exp(srv, sr);
+        so3_log(sr, slog);  /* |log| wraps at π, as the Python round trip does */
+        work += norm3(slog) + spn;
+        se3_compose_into(hr, hp, sr, sp);
+    }
+    double baseline = doubled_return_error(hr, hp);
+    out[OUT_TOPOLOGICAL] = baseline;
+    out[OUT_ENERGETIC] = work / n;
+    out[OUT_SPATIAL] = bounded ? inside : 1.0;
+
+    /* Step-size coefficient of variation over the original poses (two-pass, as np.std) */
+    out[OUT_TEMPORAL] = 0.0;
+    if (n > 1) {
+        double sum = 0.0, var = 0.0;
+        for (int pass = 0; pass < 2; pass++) {
+            double mean = sum / (n - 1);
+            for (int i = 0; i + 1 < n; i++) {
+                double s = step_size(rv, trans, i);
+                if (pass == 0) {
+                    sum += s;
+                } else {
+                    var += (s - mean) * (s - mean);
+                }
+            }
+        }
+        double mean = sum / (n - 1);
+        if (mean >= 1e-10) {
+            out[OUT_TEMPORAL] = sqrt(var / (n - 1)) / mean;
+        }
+    }
+
+    /* Noise trials: perturb, scale and compose in one sweep per trial */
+    double noisy_sum = 0.0;
+    for (int t = 0; t < trials; t++) {
+        const double *nz = noise + (size_t)t * n * 6;
+        if (bounded) {
+            for (int i = 0; i < n; i++) {
+                double np_[3];
+                for (int k = 0; k < 3; k++) {
+                    np_[k] = trans[3 * i + k] + nz[6 * i + 3 + k];
+                }
+                if (norm3(np_) > r_max) {
+                    *violation = norm3(np_);
+                    return CASCADE_NOISY_BOUNDS;
+                }
+            }
+        }
+        se3_identity(hr, hp);
+        for (int i = 0; i < n; i++) {
+            double v[3], nr[9], w[3], sr[9], sp[3];
+            for (int k = 0; k < 3; k++) {
+                v[k] = rv[3 * i + k] + nz[6 * i + k];
+                sp[k] = lambda * (trans[3 * i + k] + nz[6 * i + 3 + k]);
+            }
+            so3_exp(v, nr);
+            so3_log(nr, w);
+            for (int k = 0; k < 3; k++) {
+                w[k] *= lambda;
+            }
+            if (bounded && norm3(sp) > r_max) {
+                *violation = norm3(sp);
+                return CASCADE_NOISY_SCALED;
+            }
+            so3_exp(w, sr);
+            se3_compose_into(hr, hp, sr, sp);
+        }
+        noisy_sum += doubled_return_error(hr, hp);
+    }
+
+    double robustness = 0.5;  /* Perfect baseline: any noise is degradation */
+    if (baseline >= 1e-10) {
+        double degradation = (noisy_sum / trials - baseline) / baseline;
+        robustness = fmax(0.0, fmin(1.0, 1.0 - degradation));
+    }
+    out[OUT_STOCHASTIC] = robustness;
+    return CASCADE_OK;
+}
@@ -431,6 +431,23 @@ class VerificationCascade:
             "stochastic": self.verify_noise_robustness(trajectory, lambda_opt)
         }
 
+        return self.score_verifications(verifications, base_token_amount)
+
+    def score_verifications(
+        self,
+        verifications: Dict[str, float],
+        base_token_amount: float = 100.0
+    ) -> VerificationResult:
+        """
+        Weight, threshold and award raw verification levels.
+
+        Args:
+            verifications: Raw value per level (as computed by verify_regeneration)
+            base_token_amount: Base REGEN token amount (scaled by score)
+
+        Returns:
+            VerificationResult with overall score and token award
+        """
         # Normalize to [0, 1] where 1 is best
         normalized = {}
         normalized["topological"] = max(0.0, 1.0 - verifications["topological"] / 2.0)
@@ -0,0 +1,397 @@
+"""
+Content-Addressed Result Cache for Regenerative Metrics
+
+PROVENANCE:
+-----------
+Created for: Open Science DLT - Pillar I (Science)
+Purpose: Avoid recomputing metrics for trajectories already seen
+
+The same trajectory reaches /api/v1/science/metrics repeatedly (client
+retries, reviewer re-verification, batch re-submission). Each time the full
+pipeline (optimize_scaling_factor, ResonanceDetector, VerificationCascade)
+reruns for 0.2-3 s. This module memoizes results by content:
+
+    key = blake2b(schema version, canonical trajectory bytes, canonical options)
+
+Canonical trajectory bytes are the float64 arrays the encoder would build
+(so [0.1, 0, 0] and [0.1, 0.0, 0.0] hash alike, -0.0 hashes as 0.0), tagged
+with the input format and array shapes.
+
+Two tiers:
+    1. In-process LRU (OrderedDict of JSON strings): ~µs hits
+    2. On-disk SQLite store (WAL) shared by every worker process on the
+       host, bounded by entry count with approximate LRU eviction
+
+Only successful results are cached; validation errors always recompute.
+"""
+
+import hashlib
+import json
+import logging
+import os
+import sqlite3
+import stat
+import threading
+import time
+from collections import OrderedDict, deque
+from typing import Any, Callable, Dict, Optional, Tuple
+
+import numpy as np
+
+logger = logging.getLogger(__name__)
+
+# Bump when the metrics pipeline changes its results
+CACHE_SCHEMA_VERSION = "metrics-v1"
+
+DEFAULT_OPTIONS = {
+    "enable_resonance_detection": True,
+    "enable_verification_cascade": True,
+    "bounded": True,
+    "r_max": 1.0,
+    "lambda_bounds": (0.1, 2.0),
+}
+
+
+def canonical_options(**options: Any) -> Dict[str, Any]:
+    """
+    Normalize metrics options (defaults filled, numeric types fixed).
+
+    Returns:
+        Keyword arguments for compute_regenerative_metrics
+    """
+    merged = {**DEFAULT_OPTIONS, **{k: v for k, v in options.items() if v is not None}}
+    low, high = merged["lambda_bounds"]
+    return {
+        "enable_resonance_detection": bool(merged["enable_resonance_detection"]),
+        "enable_verification_cascade": bool(merged["enable_verification_cascade"]),
+        "bounded": bool(merged["bounded"]),
+        "r_max": float(merged["r_max"]),
+        "lambda_bounds": (float(low), float(high)),
+    }
+
+
+def _hash_array(h: "hashlib._Hash", values: Any) -> None:
+    arr = np.asarray(values, dtype=np.float64) + 0.0  # -0.0 → 0.0
+    h.update(repr(arr.shape).encode())
+    h.update(np.ascontiguousarray(arr).tobytes())
+
+
+def _hash_poses(h: "hashlib._Hash", poses: Any) -> None:
+    h.update(b"poses")
+    try:
+        # Fast path: uniform pose shapes stack into two arrays
+        _hash_array(h, [p["rotation"] for p in poses])
+        _hash_array(h, [p["translation"] for p in poses])
+    except (ValueError, TypeError):
+        h.update(b"ragged")
+        for p in poses:
+            _hash_array(h, p["rotation"])
+            _hash_array(h, p["translation"])
+
+
+def trajectory_key(trajectory_data: Any, options: Dict[str, Any]) -> Optional[str]:
+    """
+    Content address of a metrics request.
+
+    Args:
+        trajectory_data: Request trajectory (any TrajectoryEncoder format)
+        options: Output of canonical_options()
+
+    Returns:
+        32-char hex key, or None if the input is malformed (not cacheable)
+    """
+    h = hashlib.blake2b(digest_size=16)
+    h.update(CACHE_SCHEMA_VERSION.encode())
+    try:
+        if isinstance(trajectory_data, list):
+            _hash_poses(h, trajectory_data)
+        elif isinstance(trajectory_data, dict) and "poses" in trajectory_data:
+            _hash_poses(h, trajectory_data["poses"])
+        elif isinstance(trajectory_data, dict) and "positions" in trajectory_data \
+                and "orientations" in trajectory_data:
+            h.update(b"timeseries")
+            _hash_array(h, trajectory_data["positions"])
+            _hash_array(h, trajectory_data["orientations"])
+        elif isinstance(trajectory_data, dict) and "state_vectors" in trajectory_data:
+            h.update(b"state_vectors")
+            _hash_array(h, trajectory_data["state_vectors"])
+        else:
+            return None
+    except (KeyError, ValueError, TypeError):
+        return None
+    h.update(json.dumps(options, sort_keys=True).encode())
+    return h.hexdigest()
+
+
+class _LatencyStats:
+    """Count, mean and recent-window percentiles of one latency series (seconds)."""
+
+    def __init__(self, window: int = 1024):
+        self.count = 0
+        self.total = 0.0
+        self.recent: deque = deque(maxlen=window)
+
+    def add(self, seconds: float) -> None:
+        self.count += 1
+        self.total += seconds
+        self.recent.append(seconds)
+
+    def summary(self) -> Dict[str, Any]:
+        if self.count == 0:
+            return {"count": 0}
+        p50, p99 = np.percentile(np.fromiter(self.recent, dtype=np.float64), [50, 99])
+        return {
+            "count": self.count,
+            "mean_us": 1e6 * self.total / self.count,
+            "p50_us": 1e6 * float(p50),
+            "p99_us": 1e6 * float(p99),
+        }
+
+
+class MetricsResultCache:
+    """
+    Two-tier LRU cache of metrics results keyed by trajectory_key().
+
+    Thread-safe; fork-safe (each process reopens the SQLite store on first
+    use after fork, so it can be created before a pre-fork server forks).
+
+    Args:
+        path: SQLite file shared by workers (None = in-process tier only)
+        max_entries: Bound on the shared store (approximate, see _evict)
+        memory_entries: Bound on the in-process tier
+    """
+
+    # Refresh a shared entry's access time at most this often (s): a hit
+    # then costs one read, not a write, under steady re-use
+    ATIME_RESOLUTION = 1.0
+    # Check the shared store's size every this many inserts
+    EVICT_INTERVAL = 64
+
+    def __init__(self, path: Optional[str] = None, max_entries: int = 4096,
+                 memory_entries: int = 256):
+        self.path = path
+        self.max_entries = max_entries
+        self.memory_entries = memory_entries
+        self._memory: "OrderedDict[str, str]" = OrderedDict()
+        self._lock = threading.Lock()
+        self._conn: Optional[sqlite3.Connection] = None
+        self._conn_pid = 0
+        self._puts = 0
+        self.memory_hits = 0
+        self.shared_hits = 0
+        self.misses = 0
+        self.uncacheable = 0
+        self.hit_latency = _LatencyStats()          # In-process tier
+        self.shared_hit_latency = _LatencyStats()   # SQLite tier
+        self.miss_latency = _LatencyStats()
+
+    # ------------------------------------------------------------------
+    # Shared store
+    # ------------------------------------------------------------------
+
+    def _db(self) -> Optional[sqlite3.Connection]:
+        if self.path is None:
+            return None
+        if self._conn is None or self._conn_pid != os.getpid():
+            # A connection inherited across fork() must not be used
+            conn = sqlite3.connect(self.path, timeout=5.0, check_same_thread=False,
+                                   isolation_level=None)
+            conn.execute("PRAGMA journal_mode=WAL")
+            conn.execute("PRAGMA synchronous=NORMAL")
+            conn.execute(
+                "CREATE TABLE IF NOT EXISTS results ("
+                " key TEXT PRIMARY KEY, value TEXT NOT NULL, atime REAL NOT NULL)")
+            conn.execute("CREATE INDEX IF NOT EXISTS results_atime ON results(atime)")
+            self._conn = conn
+            self._conn_pid = os.getpid()
+        return self._conn
+
+    def _shared_get(self, key: str) -> Optional[str]:
+        db = self._db()
+        if db is None:
+            return None
+        row = db.execute("SELECT value, atime FROM results WHERE key = ?", (key,)).fetchone()
+        if row is None:
+            return None
+        now = time.time()
+        if now - row[1] > self.ATIME_RESOLUTION:
+            db.execute("UPDATE results SET atime = ? WHERE key = ?", (now, key))
+        return row[0]
+
+    def _shared_put(self, key: str, value: str) -> None:
+        db = self._db()
+        if db is None:
+            return
+        db.execute("INSERT OR REPLACE INTO results (key, value, atime) VALUES (?, ?, ?)",
+                   (key, value, time.time()))
+        self._puts += 1
+        if self._puts % self.EVICT_INTERVAL == 0:
+            self._evict(db)
+
+    def _evict(self, db: sqlite3.Connection) -> None:
+        """
+        Trim the shared store to max_entries, least recently used first.
+
+        Runs every EVICT_INTERVAL inserts per process, so the store can
+        overshoot by up to EVICT_INTERVAL × workers entries in between.
+        """
+        (count,) = db.execute("SELECT COUNT(*) FROM results").fetchone()
+        excess = count - self.max_entries
+        if excess > 0:
+            db.execute(
+                "DELETE FROM results WHERE key IN "
+                "(SELECT key FROM results ORDER BY atime, rowid LIMIT ?)", (excess,))
+
+    # ------------------------------------------------------------------
+    # In-process tier
+    # ------------------------------------------------------------------
+
+    def _memory_put(self, key: str, value: str) -> None:
+        self._memory[key] = value
+        self._memory.move_to_end(key)
+        while len(self._memory) > self.memory_entries:
+            self._memory.popitem(last=False)
+
+    # ------------------------------------------------------------------
+    # API
+    # ------------------------------------------------------------------
+
+    def get(self, key: str) -> Optional[Dict[str, Any]]:
+        """Cached result for key (a fresh dict), or None."""
+        with self._lock:
+            value = self._memory.get(key)
+            if value is not None:
+                self._memory.move_to_end(key)
+                self.memory_hits += 1
+                return json.loads(value)
+            value = self._shared_get(key)
+            if value is None:
+                return None
+            self._memory_put(key, value)
+            self.shared_hits += 1
+            return json.loads(value)
+
+    def put(self, key: str, result: Dict[str, Any]) -> None:
+        """Store a result in both tiers."""
+        value = json.dumps(result, default=str)
+        with self._lock:
+            self._memory_put(key, value)
+            self._shared_put(key, value)
+
+    def compute(self, fn: Callable[..., Dict[str, Any]], trajectory_data: Any,
+                **options: Any) -> Tuple[Dict[str, Any], bool]:
+        """
+        Return fn(trajectory_data, **options), memoized.
+
+        Args:
+            fn: Metrics function (compute_regenerative_metrics)
+            trajectory_data: Request trajectory
+            **options: Metrics options (normalized with canonical_options)
+
+        Returns:
+            (result, hit) - hit results carry metadata["cache_hit"] = True
+        """
+        t0 = time.perf_counter()
+        opts = canonical_options(**options)
+        key = trajectory_key(trajectory_data, opts)
+        if key is None:
+            self.uncacheable += 1
+            return fn(trajectory_data, **opts), False
+
+        shared_before = self.shared_hits
+        cached = self.get(key)
+        if cached is not None:
+            if isinstance(cached.get("metadata"), dict):
+                cached["metadata"]["cache_hit"] = True
+            tier = self.shared_hit_latency if self.shared_hits != shared_before else self.hit_latency
+            tier.add(time.perf_counter() - t0)
+            return cached, True
+
+        result = fn(trajectory_data, **opts)  # Errors propagate uncached
+        self.put(key, result)
+        self.misses += 1
+        self.miss_latency.add(time.perf_counter() - t0)
+        return result, False
+
+    def stats(self) -> Dict[str, Any]:
+        """Hit rates and latency for this process, plus shared store size."""
+        lookups = self.memory_hits + self.shared_hits + self.misses
+        shared_entries = None
+        with self._lock:
+            db = self._db()
+            if db is not None:
+                (shared_entries,) = db.execute("SELECT COUNT(*) FROM results").fetchone()
+            memory_entries = len(self._memory)
+        return {
+            "pid": os.getpid(),
+            "lookups": lookups,
+            "hit_rate": (self.memory_hits + self.shared_hits) / lookups if lookups else 0.0,
+            "memory_hits": self.memory_hits,
+            "shared_hits": self.shared_hits,
+            "misses": self.misses,
+            "uncacheable": self.uncacheable,
+            "memory_entries": memory_entries,
+            "shared_entries": shared_entries,
+            "max_entries": self.max_entries,
+            "hit_latency": self.hit_latency.summary(),
+            "shared_hit_latency": self.shared_hit_latency.summary(),
+            "miss_latency": self.miss_latency.summary(),
+        }
+
+    def clear(self) -> None:
+        """Drop every entry in both tiers (statistics are kept)."""
+        with self._lock:
+            self._memory.clear()
+            db = self._db()
+            if db is not None:
+                db.execute("DELETE FROM results")
+
+
+def private_cache_dir(name: str) -> Optional[str]:
+    """
+    Per-user directory for files other local users must not plant or read.
+
+    $XDG_CACHE_HOME/<name> (default ~/.cache/<name>), created 0700. Never the
+    shared temp dir, where anyone can pre-create the path.
+
+    Returns:
+        The directory, or None (logged) unless it is a real directory owned
+        by this user with no group or other access
+    """
+    base = os.environ.get("XDG_CACHE_HOME") or os.path.join(os.path.expanduser("~"), ".cache")
+    path = os.path.join(base, name)
+    try:
+        os.makedirs(path, mode=0o700, exist_ok=True)
+        st = os.lstat(path)
+    except OSError as e:
+        logger.warning(f"Private cache dir {path} unavailable: {e}")
+        return None
+    if not stat.S_ISDIR(st.st_mode) or st.st_uid != os.geteuid() or st.st_mode & 0o077:
+        logger.warning(f"Ignoring cache dir {path}: not a 0700 directory owned by this user")
+        return None
+    return path
+
+
+def cache_from_env() -> Optional[MetricsResultCache]:
+    """
+    Build the service cache from environment variables.
+
+    SCIENCE_CACHE_ENABLED         true/false (default true)
+    SCIENCE_CACHE_PATH            shared store file (default: se3_metrics/ under
+                                  the user's cache dir; in-process tier only
+                                  when that is not private)
+    SCIENCE_CACHE_MAX_ENTRIES     shared store bound (default 4096)
+    SCIENCE_CACHE_MEMORY_ENTRIES  per-process bound (default 256)
+    """
+    if os.environ.get("SCIENCE_CACHE_ENABLED", "true").lower() != "true":
+        return None
+    path = os.environ.get("SCIENCE_CACHE_PATH")
+    if path is None:
+        directory = private_cache_dir("se3_metrics")
+        if directory is not None:
+            path = os.path.join(directory, "se3_metrics_cache.sqlite")
+    return MetricsResultCache(
+        path=path,
+        max_entries=int(os.environ.get("SCIENCE_CACHE_MAX_ENTRIES", 4096)),
+        memory_entries=int(os.environ.get("SCIENCE_CACHE_MEMORY_ENTRIES", 256)),
+    )
@@ -0,0 +1,120 @@
+"""
+Unit Tests for the Fused Native Verification Cascade
+
+PROVENANCE:
+-----------
+Created for: Open Science DLT - Pillar I (Science)
+
+Tests that FusedVerificationCascade reproduces VerificationCascade level by
+level under a fixed noise seed, fails bounds the same way, falls back
+to the Python cascade when the kernel is unavailable, and only loads a
+fallback build from a private directory.
+"""
+
+import os
+import shutil
+import sys
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+# Add src/science to path (package imports)
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from lie_dynamics import fused_cascade
+from lie_dynamics.fused_cascade import FusedVerificationCascade
+from lie_dynamics.resonance_aware import VerificationCascade
+from lie_dynamics.se3_double_scale import SE3Pose, SE3Trajectory
+
+
+def trajectory(n, rot_scale=0.8, trans_scale=0.05, seed=0, bounded=True):
+    rng = np.random.default_rng(seed)
+    poses = [SE3Pose.from_rotation_vector(rng.normal(size=3) * rot_scale,
+                                          rng.normal(size=3) * trans_scale) for _ in range(n)]
+    return SE3Trajectory(poses, bounded, 1.0)
+
+
+def both(traj, lam, seed=3):
+    np.random.seed(seed)
+    reference = VerificationCascade().verify_regeneration(traj, lam)
+    np.random.seed(seed)
+    fused = FusedVerificationCascade().verify_regeneration(traj, lam)
+    return reference, fused
+
+
+@pytest.fixture(autouse=True)
+def require_native():
+    if not FusedVerificationCascade().native:
+        pytest.skip("native cascade kernel could not be built")
+
+
+class TestFusedCascade:
+    """Equivalence with the Python cascade"""
+
+    @pytest.mark.parametrize("n", [1, 2, 16, 64])
+    @pytest.mark.parametrize("lam", [0.3, 0.9, 1.7])
+    def test_levels_match_python(self, n, lam):
+        reference, fused = both(trajectory(n, seed=n), lam)
+        for level, value in reference.verifications.items():
+            assert fused.verifications[level] == pytest.approx(value, abs=1e-12)
+        assert fused.overall_score == pytest.approx(reference.overall_score, abs=1e-12)
+        assert fused.passed == reference.passed
+
+    def test_large_rotations_wrap_like_python(self):
+        # λ·|r| beyond π: the energetic level uses the wrapped log
+        reference, fused = both(trajectory(8, rot_scale=2.5, seed=9), 1.9)
+        assert fused.verifications["energetic"] == pytest.approx(
+            reference.verifications["energetic"], abs=1e-12)
+
+    def test_unbounded_and_identity_trajectories(self):
+        reference, fused = both(trajectory(6, trans_scale=0.8, bounded=False), 1.5)
+        assert fused.verifications == pytest.approx(reference.verifications, abs=1e-12)
+        still = SE3Trajectory([SE3Pose.identity()] * 4)
+        reference, fused = both(still, 1.0)
+        assert fused.verifications["stochastic"] == 0.5 == reference.verifications["stochastic"]
+        assert fused.verifications["temporal"] == 0.0
+
+    def test_scaled_bounds_violation_raises_like_python(self):
+        edge_pose = SE3Pose.from_rotation_vector(np.array([0.1, 0, 0]), np.array([0.7, 0, 0]))
+        near_edge = SE3Trajectory([edge_pose])
+        with pytest.raises(AssertionError):
+            VerificationCascade().verify_regeneration(near_edge, 1.6)
+        with pytest.raises(AssertionError, match="exceeds r_max"):
+            FusedVerificationCascade().verify_regeneration(near_edge, 1.6)
+
+    def test_falls_back_without_kernel(self, monkeypatch):
+        monkeypatch.setattr(fused_cascade, "load_native", lambda: None)
+        traj = trajectory(5)
+        np.random.seed(1)
+        reference = VerificationCascade().verify_regeneration(traj, 0.8)
+        np.random.seed(1)
+        fallback = FusedVerificationCascade().verify_regeneration(traj, 0.8)
+        assert fallback.verifications == reference.verifications
+
+
+class TestNativeLoader:
+    """Fallback build location when native/ is unusable"""
+
+    @pytest.fixture
+    def unusable_native_dir(self, tmp_path, monkeypatch):
+        source = tmp_path / "native" / "cascade.c"
+        source.parent.mkdir()
+        shutil.copy(fused_cascade.NATIVE_SOURCE, source)
+        (source.parent / fused_cascade.LIBRARY_NAME).mkdir()   # Neither loadable nor replaceable
+        monkeypatch.setattr(fused_cascade, "NATIVE_SOURCE", source)
+        monkeypatch.setattr(fused_cascade, "_native", None)
+        monkeypatch.setattr(fused_cascade, "_native_failed", False)
+        monkeypatch.setenv("XDG_CACHE_HOME", str(tmp_path / "cache"))
+        return tmp_path / "cache" / "se3_metrics" / fused_cascade.LIBRARY_NAME
+
+    def test_builds_into_private_cache_dir(self, unusable_native_dir):
+        assert fused_cascade.load_native() is not None
+        assert os.stat(unusable_native_dir.parent).st_mode & 0o777 == 0o700
+        assert not os.stat(unusable_native_dir).st_mode & 0o022
+
+    def test_writable_cached_library_refused(self, unusable_native_dir):
+        unusable_native_dir.parent.mkdir(parents=True, mode=0o700)
+        shutil.copy(fused_cascade.NATIVE_SOURCE, unusable_native_dir)   # Planted, newer
+        os.chmod(unusable_native_dir, 0o666)
+        assert fused_cascade.load_native() is None
@@ -0,0 +1,149 @@
+"""
+Unit Tests for Asynchronous Metrics Jobs
+
+PROVENANCE:
+-----------
+Created for: Open Science DLT - Pillar I (Science)
+
+Tests NDJSON spooling, streamed results (including resume), per-item
+errors, cancellation, expiry and the REST endpoints.
+"""
+
+import json
+import sys
+import threading
+from pathlib import Path
+
+import pytest
+
+# Add src/science to path (package imports)
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from lie_dynamics.jobs import CANCELLED, DONE, JobManager
+from lie_dynamics.metrics_service import compute_regenerative_metrics
+
+
+FAST = {"enable_resonance_detection": False, "enable_verification_cascade": False}
+
+
+def trajectory(k):
+    return {"poses": [{"rotation": [0.02 * (k + 1), 0, 0], "translation": [0.01, 0, 0]},
+                      {"rotation": [0, 0.03, 0], "translation": [0, 0.01 * (k + 1), 0]}]}
+
+
+def ndjson(items, options=None):
+    lines = ([json.dumps({"options": options})] if options else []) + [json.dumps(t) for t in items]
+    body = ("\n".join(lines) + "\n").encode()
+    return [body[i:i + 7] for i in range(0, len(body), 7)]  # Lines split across chunks
+
+
+def collect(manager, job, start=0):
+    lines = [json.loads(line) for line in manager.stream(job, start=start, poll=0.05)]
+    return lines[:-1], lines[-1]
+
+
+@pytest.fixture
+def manager(tmp_path):
+    m = JobManager(spool_dir=str(tmp_path), runners=1, max_in_flight=2)
+    yield m
+    m.close()
+
+
+class TestJobManager:
+    """Spooling, streaming and lifecycle"""
+
+    def test_streamed_results_match_in_process(self, manager):
+        items = [trajectory(k) for k in range(5)]
+        job = manager.submit(ndjson(items, FAST))
+        assert job.total == 5 and job.options["enable_verification_cascade"] is False
+        results, summary = collect(manager, job)
+        assert summary["status"] == DONE and summary["summary"]["completed"] == 5
+        assert sorted(r["index"] for r in results) == list(range(5))
+        for r in results:
+            expected = compute_regenerative_metrics(items[r["index"]], **FAST)
+            assert r["data"]["optimal_lambda"] == expected["optimal_lambda"]
+
+    def test_bad_items_become_error_lines(self, manager):
+        chunks = [json.dumps(trajectory(0)).encode() + b"\n", b"{not json\n",
+                  json.dumps({"poses": [{"rotation": [0, 0, 0], "translation": [5, 0, 0]}]}).encode()]
+        job = manager.submit(chunks, FAST)
+        results, summary = collect(manager, job)
+        by_index = {r["index"]: r for r in results}
+        assert by_index[0]["status"] == "success"
+        assert by_index[1]["status"] == "error" and by_index[2]["status"] == "error"
+        assert summary["summary"]["failed"] == 2
+
+    def test_empty_or_malformed_header_rejected(self, manager, tmp_path):
+        with pytest.raises(ValueError):
+            manager.submit([b"\n\n"])
+        with pytest.raises(ValueError):
+            manager.submit([b'{"options": {\n', json.dumps(trajectory(0)).encode()])
+        assert list(tmp_path.iterdir()) == []   # No spool left behind
+
+    def test_resume_from_offset(self, manager):
+        job = manager.submit(ndjson([trajectory(k) for k in range(4)], FAST))
+        first, _ = collect(manager, job)
+        rest, summary = collect(manager, job, start=3)
+        assert rest == first[3:] and summary["status"] == DONE
+
+    def test_cancel_stops_dispatch(self, tmp_path):
+        gate, started = threading.Event(), threading.Event()
+
+        def slow(data, **options):
+            started.set()
+            gate.wait(5)
+            return {"optimal_lambda": 1.0}
+
+        m = JobManager(compute_fn=slow, spool_dir=str(tmp_path), runners=1, max_in_flight=2)
+        try:
+            job = m.submit(ndjson([trajectory(k) for k in range(20)]))
+            assert started.wait(5)
+            m.cancel(job.id)
+            gate.set()
+            results, summary = collect(m, job)
+            assert summary["status"] == CANCELLED
+            assert 1 <= len(results) <= 2 and summary["summary"]["total"] == 20
+        finally:
+            m.close()
+
+    def test_finished_jobs_expire(self, manager):
+        manager.ttl = 0.0
+        job = manager.submit(ndjson([trajectory(0)], FAST))
+        collect(manager, job)
+        manager.submit(ndjson([trajectory(1)], FAST))   # Submission sweeps expired jobs
+        assert manager.get(job.id) is None and not Path(job.dir).exists()
+
+
+class TestJobEndpoints:
+    """REST surface"""
+
+    @pytest.fixture
+    def client(self, tmp_path, monkeypatch):
+        import api_server
+        monkeypatch.setattr(api_server, "metrics_cache", None)
+        monkeypatch.setattr(api_server, "job_manager",
+                            JobManager(compute_fn=api_server.job_metrics, spool_dir=str(tmp_path)))
+        yield api_server.app.test_client()
+        api_server.job_manager.close()
+
+    def test_submit_progress_and_stream(self, client):
+        body = b"".join(ndjson([trajectory(k) for k in range(3)], FAST))
+        resp = client.post("/api/v1/science/jobs", data=body, content_type="application/x-ndjson")
+        assert resp.status_code == 202
+        job_id = resp.get_json()["data"]["job_id"]
+
+        stream = client.get(f"/api/v1/science/jobs/{job_id}/results")
+        assert stream.mimetype == "application/x-ndjson"
+        lines = [json.loads(line) for line in stream.get_data(as_text=True).splitlines()]
+        assert len(lines) == 4 and lines[-1]["status"] == DONE
+
+        status = client.get(f"/api/v1/science/jobs/{job_id}").get_json()["data"]
+        assert status["completed"] == 3 and status["progress"] == 1.0
+
+    def test_json_body_and_errors(self, client):
+        resp = client.post("/api/v1/science/jobs",
+                           json={"trajectories": [trajectory(0)], "options": FAST})
+        assert resp.status_code == 202
+        assert client.post("/api/v1/science/jobs", json={}).status_code == 400
+        assert client.get("/api/v1/science/jobs/nope").status_code == 404
+        assert client.delete("/api/v1/science/jobs/nope").status_code == 404
@@ -0,0 +1,185 @@
+"""
+Unit Tests for the Metrics Result Cache
+
+PROVENANCE:
+-----------
+Created for: Open Science DLT - Pillar I (Science)
+
+Tests content addressing, the two cache tiers, cross-process sharing and
+eviction of lie_dynamics.result_cache.
+"""
+
+import multiprocessing
+import os
+import sys
+from pathlib import Path
+
+import pytest
+
+# Add src/science to path (package imports)
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from lie_dynamics.result_cache import (
+    MetricsResultCache,
+    cache_from_env,
+    canonical_options,
+    trajectory_key
+)
+from lie_dynamics.metrics_service import compute_regenerative_metrics
+
+
+POSES = {
+    "poses": [
+        {"rotation": [0.1, 0, 0], "translation": [0.05, 0, 0]},
+        {"rotation": [0, 0.1, 0], "translation": [0, 0.05, 0]},
+        {"rotation": [0, 0, 0.1], "translation": [0, 0, 0.05]},
+    ]
+}
+
+
+class CountingMetrics:
+    """Stand-in for compute_regenerative_metrics that counts calls"""
+
+    def __init__(self):
+        self.calls = 0
+
+    def __call__(self, trajectory_data, **options):
+        self.calls += 1
+        if "fail" in trajectory_data:
+            raise ValueError("Translation norm exceeds r_max")
+        return {"optimal_lambda": 1.0, "metadata": {"lambda_bounds": options["lambda_bounds"]}}
+
+
+def _lookup_in_child(path, queue):
+    cache = MetricsResultCache(path=path)
+    queue.put(cache.get(trajectory_key(POSES, canonical_options())))
+
+
+class TestTrajectoryKey:
+    """Content addressing"""
+
+    def test_equivalent_encodings_share_key(self):
+        opts = canonical_options()
+        same = {
+            "poses": [
+                {"rotation": [0.1, 0.0, -0.0], "translation": [0.05, 0.0, 0.0]},
+                {"rotation": [0, 0.1, 0], "translation": [0, 0.05, 0]},
+                {"rotation": [0, 0, 0.1], "translation": [0, 0, 0.05]},
+            ]
+        }
+        assert trajectory_key(POSES, opts) == trajectory_key(same, opts)
+        assert trajectory_key(POSES, opts) == trajectory_key(POSES["poses"], opts)
+
+    def test_content_and_options_change_key(self):
+        opts = canonical_options()
+        moved = {"poses": [dict(p) for p in POSES["poses"]]}
+        moved["poses"][2] = {"rotation": [0, 0, 0.1], "translation": [0, 0, 0.06]}
+        assert trajectory_key(POSES, opts) != trajectory_key(moved, opts)
+        assert trajectory_key(POSES, opts) != \
+            trajectory_key(POSES, canonical_options(lambda_bounds=[0.5, 2.0]))
+        assert canonical_options(r_max=1) == canonical_options()
+
+    def test_malformed_input_not_cacheable(self):
+        opts = canonical_options()
+        assert trajectory_key({"poses": [{"rotation": [0.1, 0, 0]}]}, opts) is None
+        assert trajectory_key({"unknown": []}, opts) is None
+
+
+class TestMetricsResultCache:
+    """Memoization tiers"""
+
+    def test_memoizes_in_process(self):
+        fn = CountingMetrics()
+        cache = MetricsResultCache(path=None)
+        first, hit1 = cache.compute(fn, POSES)
+        second, hit2 = cache.compute(fn, POSES)
+        assert (hit1, hit2) == (False, True)
+        assert fn.calls == 1
+        assert second["metadata"]["cache_hit"] is True
+        assert second["optimal_lambda"] == first["optimal_lambda"]
+
+        stats = cache.stats()
+        assert stats["memory_hits"] == 1 and stats["misses"] == 1
+        assert stats["hit_rate"] == pytest.approx(0.5)
+        assert stats["hit_latency"]["count"] == 1
+
+    def test_errors_not_cached(self):
+        fn = CountingMetrics()
+        cache = MetricsResultCache(path=None)
+        rejected = {"poses": POSES["poses"], "fail": True}
+        for _ in range(2):
+            with pytest.raises(ValueError):
+                cache.compute(fn, rejected)
+        assert fn.calls == 2 and cache.stats()["misses"] == 0
+
+    def test_memory_tier_is_bounded_lru(self):
+        cache = MetricsResultCache(path=None, memory_entries=2)
+        cache.put("a", {"v": 1})
+        cache.put("b", {"v": 2})
+        assert cache.get("a") == {"v": 1}   # a becomes most recent
+        cache.put("c", {"v": 3})
+        assert cache.get("b") is None
+        assert cache.get("a") == {"v": 1} and cache.get("c") == {"v": 3}
+
+    def test_shared_store_across_processes(self, tmp_path):
+        path = str(tmp_path / "cache.sqlite")
+        fn = CountingMetrics()
+        writer = MetricsResultCache(path=path)
+        writer.compute(fn, POSES)
+
+        other = MetricsResultCache(path=path)
+        result, hit = other.compute(fn, POSES)
+        assert hit and fn.calls == 1
+        assert other.stats()["shared_hits"] == 1
+
+        ctx = multiprocessing.get_context("fork")
+        queue = ctx.Queue()
+        child = ctx.Process(target=_lookup_in_child, args=(path, queue))
+        child.start()
+        from_child = queue.get(timeout=30)
+        child.join(timeout=30)
+        assert from_child is not None and from_child["optimal_lambda"] == 1.0
+
+    def test_shared_store_eviction(self, tmp_path):
+        cache = MetricsResultCache(path=str(tmp_path / "cache.sqlite"), max_entries=10,
+                                   memory_entries=1)
+        for i in range(MetricsResultCache.EVICT_INTERVAL):
+            cache.put(f"k{i}", {"v": i})
+        stats = cache.stats()
+        assert stats["shared_entries"] == 10
+        newest = f"k{MetricsResultCache.EVICT_INTERVAL - 1}"
+        assert cache.get(newest) == {"v": MetricsResultCache.EVICT_INTERVAL - 1}
+        assert cache.get("k0") is None
+
+
+class TestCacheFromEnv:
+    """Default shared store location"""
+
+    def test_default_store_in_private_dir(self, tmp_path, monkeypatch):
+        monkeypatch.delenv("SCIENCE_CACHE_PATH", raising=False)
+        monkeypatch.setenv("XDG_CACHE_HOME", str(tmp_path))
+        cache = cache_from_env()
+        assert cache.path == str(tmp_path / "se3_metrics" / "se3_metrics_cache.sqlite")
+        assert os.stat(tmp_path / "se3_metrics").st_mode & 0o777 == 0o700
+
+    def test_shared_dir_not_trusted(self, tmp_path, monkeypatch):
+        monkeypatch.delenv("SCIENCE_CACHE_PATH", raising=False)
+        monkeypatch.setenv("XDG_CACHE_HOME", str(tmp_path))
+        (tmp_path / "se3_metrics").mkdir()
+        os.chmod(tmp_path / "se3_metrics", 0o777)
+        assert cache_from_env().path is None   # In-process tier only
+
+
+class TestCachedMetricsPipeline:
+    """Cache in front of the real metrics computation"""
+
+    def test_hit_matches_computed_metrics(self, tmp_path):
+        cache = MetricsResultCache(path=str(tmp_path / "cache.sqlite"))
+        computed, hit1 = cache.compute(compute_regenerative_metrics, POSES,
+                                       enable_resonance_detection=False)
+        cached, hit2 = cache.compute(compute_regenerative_metrics, POSES,
+                                     enable_resonance_detection=False)
+        assert not hit1 and hit2
+        for field in ("optimal_lambda", "return_error_epsilon", "verification_score",
+                      "confidence"):
+            assert cached[field] == computed[field]
@@ -0,0 +1,164 @@
+"""
+Unit Tests for the Pre-Fork Metrics Worker Pool
+
+PROVENANCE:
+-----------
+Created for: Open Science DLT - Pillar I (Science)
+
+Tests shared-memory packing, result equivalence with the in-process
+pipeline, bounded queueing, error forwarding, worker respawn (also under
+load) and the result timeout.
+"""
+
+import os
+import signal
+import sys
+import threading
+import time
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+# Add src/science to path (package imports)
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from lie_dynamics.metrics_service import compute_regenerative_metrics
+from lie_dynamics.worker_pool import (
+    ComputeTimeoutError,
+    MetricsWorkerPool,
+    PoolBusyError,
+    WorkerCrashedError,
+    pack_trajectory,
+    unpack_trajectory
+)
+
+
+POSES = {
+    "poses": [
+        {"rotation": [0.1, 0, 0], "translation": [0.05, 0, 0]},
+        {"rotation": [0, 0.1, 0], "translation": [0, 0.05, 0]},
+        {"rotation": np.eye(3).tolist(), "translation": [0, 0, 0.05]},
+    ]
+}
+
+# verification_score is excluded: the noise-robustness level draws from np.random
+FIELDS = ("optimal_lambda", "return_error_epsilon", "confidence")
+
+
+def long_trajectory(n=150):
+    rng = np.random.default_rng(5)
+    return {"poses": [{"rotation": (rng.normal(size=3) * 0.05).tolist(),
+                       "translation": (rng.normal(size=3) * 0.02).tolist()} for _ in range(n)]}
+
+
+@pytest.fixture
+def pool():
+    p = MetricsWorkerPool(workers=2, slots=2)
+    yield p
+    p.close()
+
+
+class TestPacking:
+    """Request trajectory <-> shared-memory arrays"""
+
+    def test_uniform_poses_pack_to_arrays(self):
+        kind, arrays = pack_trajectory(POSES["poses"][:2])
+        assert kind == "poses"
+        assert arrays[0].shape == (2, 3) and arrays[1].shape == (2, 3)
+        restored = unpack_trajectory(kind, arrays)
+        assert np.allclose(restored["poses"][1]["rotation"], [0, 0.1, 0])
+
+    def test_ragged_or_malformed_not_packed(self):
+        assert pack_trajectory(POSES) is None   # Rotation vectors mixed with matrices
+        assert pack_trajectory({"poses": [{"rotation": [0.1, 0, 0]}]}) is None
+        assert pack_trajectory({"unknown": []}) is None
+
+
+class TestMetricsWorkerPool:
+    """Pool behaviour"""
+
+    def test_matches_in_process_metrics(self, pool):
+        uniform = {"poses": POSES["poses"][:2]}
+        for data in (uniform, POSES):   # Shared-memory and pickled paths
+            remote = pool.compute_metrics(data, enable_resonance_detection=False)
+            local = compute_regenerative_metrics(data, enable_resonance_detection=False)
+            for field in FIELDS:
+                assert remote[field] == local[field]
+        assert pool.stats()["pickled_fallbacks"] == 1
+
+    def test_bounded_queue_rejects_when_full(self, pool):
+        futures = [pool.submit(long_trajectory()) for _ in range(pool.n_slots)]
+        with pytest.raises(PoolBusyError):
+            pool.submit(POSES, timeout=0.05)
+        assert all(f.result(timeout=120)["optimal_lambda"] > 0 for f in futures)
+        assert pool.stats()["rejected"] == 1 and pool.stats()["slots_free"] == pool.n_slots
+
+    def test_errors_forwarded_per_item(self, pool):
+        with pytest.raises(ValueError):
+            pool.compute_metrics({"poses": [{"rotation": [0.1, 0, 0]}]})
+        results = pool.map_metrics([{"poses": POSES["poses"][:2]},
+                                    {"poses": [{"rotation": [0, 0, 0], "translation": [5, 0, 0]}]}],
+                                   enable_resonance_detection=False)
+        assert "optimal_lambda" in results[0]
+        assert results[1]["trajectory_index"] == 1 and "r_max" in results[1]["error"]
+
+    def test_bad_options_do_not_leak_slots(self):
+        p = MetricsWorkerPool(workers=1, slots=2)
+        try:
+            for _ in range(2):
+                with pytest.raises(ValueError):
+                    p.submit(POSES, timeout=0.05, r_max="x")
+            assert p.stats()["slots_free"] == 2 and p.stats()["rejected"] == 0
+            assert p.compute_metrics({"poses": POSES["poses"][:2]})["optimal_lambda"] > 0
+        finally:
+            p.close()
+
+    def test_dead_worker_respawned(self, pool):
+        future = pool.submit(long_trajectory(300))
+        deadline = time.time() + 10
+        while not pool._running and time.time() < deadline:
+            time.sleep(0.01)
+        wid = next(iter(pool._running))
+        os.kill(pool._procs[wid].pid, signal.SIGKILL)
+        with pytest.raises(WorkerCrashedError):
+            future.result(timeout=30)
+        deadline = time.time() + 10
+        while pool.stats()["workers_alive"] < pool.n_workers and time.time() < deadline:
+            time.sleep(0.05)
+        assert pool.stats()["respawned"] == 1
+        assert pool.compute_metrics({"poses": POSES["poses"][:2]})["optimal_lambda"] > 0
+
+    def test_crash_detected_under_steady_load(self, pool):
+        victim = pool.submit(long_trajectory(300))
+        deadline = time.time() + 10
+        while not pool._running and time.time() < deadline:
+            time.sleep(0.01)
+        wid = next(wid for wid, tid in pool._running.items() if tid == victim.task_id)
+        stop = threading.Event()
+
+        def load():   # Keeps results flowing from the other worker
+            while not stop.is_set():
+                pool.compute_metrics({"poses": POSES["poses"][:2]},
+                                     enable_resonance_detection=False)
+
+        loader = threading.Thread(target=load)
+        loader.start()
+        try:
+            time.sleep(0.2)
+            os.kill(pool._procs[wid].pid, signal.SIGKILL)
+            with pytest.raises(WorkerCrashedError):
+                victim.result(timeout=5)
+        finally:
+            stop.set()
+            loader.join(timeout=30)
+        assert pool.stats()["respawned"] == 1
+
+    def test_result_timeout_frees_slot(self, pool):
+        with pytest.raises(ComputeTimeoutError):
+            pool.wait(pool.submit(long_trajectory(300)), timeout=0.05)
+        deadline = time.time() + 10
+        while pool.stats()["slots_free"] < pool.n_slots and time.time() < deadline:
+            time.sleep(0.05)
+        assert pool.stats()["slots_free"] == pool.n_slots and pool.stats()["timed_out"] == 1
+        assert pool.compute_metrics({"poses": POSES["poses"][:2]})["optimal_lambda"] > 0
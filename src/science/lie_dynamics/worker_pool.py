@@ -0,0 +1,490 @@
+"""
+Pre-Fork Compute Worker Pool for the Metrics Service
+
+PROVENANCE:
+-----------
+Created for: Open Science DLT - Pillar I (Science)
+Purpose: Run the CPU-bound metrics pipeline outside the server process
+
+The metrics pipeline is pure Python/NumPy on 3x3 matrices, so threads in the
+Flask process serialize on the GIL. This pool starts N worker processes
+(default: one per core, forked from a forkserver so the threaded server
+never forks itself) and hands them trajectories through a shared-memory
+arena instead of pickled pose lists:
+
+    arena = SharedMemory(slots × slot_bytes)
+    submit():  claim a free slot → pack float64 arrays into it → send a
+               small task tuple (task id, slot, array shapes, options) to
+               an idle worker's pipe, or hold it until one is idle
+    worker:    view the slot as arrays → compute_regenerative_metrics()
+               → result dict back on its pipe
+    collector: (server thread) waits on every pipe and process sentinel,
+               resolves the request's Future, frees the slot
+
+Slots bound the queue: at most `slots` requests are queued or running, and
+submit() waits up to `timeout` for a slot before raising PoolBusyError
+(the server answers 503). Trajectories larger than a slot, or not packable
+as arrays (ragged / malformed), travel pickled in the task tuple instead.
+
+The server records which worker owns a task when it dispatches it, so a
+worker that dies (even mid-send) is respawned at once and its request
+fails with WorkerCrashedError. wait() bounds every request by
+result_timeout (ComputeTimeoutError; the stuck worker is killed).
+"""
+
+import itertools
+import logging
+import multiprocessing
+import os
+import queue
+import signal
+import threading
+import time
+from collections import deque
+from concurrent.futures import Future, ThreadPoolExecutor
+from concurrent.futures import TimeoutError as FuturesTimeoutError
+from multiprocessing import shared_memory
+from multiprocessing.connection import Connection, wait
+from typing import Any, Deque, Dict, List, Optional, Tuple
+
+import numpy as np
+
+from .metrics_service import compute_regenerative_metrics
+from .result_cache import MetricsResultCache, canonical_options
+
+logger = logging.getLogger(__name__)
+
+# Exceptions re-raised with their own type in the server (others → RuntimeError)
+_FORWARDED_ERRORS = {"ValueError": ValueError, "AssertionError": AssertionError}
+
+
+class PoolBusyError(RuntimeError):
+    """No free slot within the submit timeout (queue full)"""
+
+
+class WorkerCrashedError(RuntimeError):
+    """The worker running the request exited"""
+
+
+class ComputeTimeoutError(RuntimeError):
+    """The request did not finish within result_timeout"""
+
+
+# ----------------------------------------------------------------------
+# Packing: request trajectory <-> float64 arrays
+# ----------------------------------------------------------------------
+
+def pack_trajectory(trajectory_data: Any) -> Optional[Tuple[str, List[np.ndarray]]]:
+    """
+    Convert a request trajectory into (kind, arrays) for shared memory.
+
+    Returns:
+        None if the trajectory is not uniform arrays (sent pickled instead)
+    """
+    try:
+        if isinstance(trajectory_data, list) or \
+                (isinstance(trajectory_data, dict) and "poses" in trajectory_data):
+            poses = trajectory_data if isinstance(trajectory_data, list) else trajectory_data["poses"]
+            rot = np.asarray([p["rotation"] for p in poses], dtype=np.float64)
+            trans = np.asarray([p["translation"] for p in poses], dtype=np.float64)
+            if rot.ndim < 2 or trans.ndim != 2 or len(rot) != len(trans):
+                return None
+            return "poses", [rot, trans]
+        if isinstance(trajectory_data, dict) and "positions" in trajectory_data \
+                and "orientations" in trajectory_data:
+            return "timeseries", [np.asarray(trajectory_data["positions"], dtype=np.float64),
+                                  np.asarray(trajectory_data["orientations"], dtype=np.float64)]
+        if isinstance(trajectory_data, dict) and "state_vectors" in trajectory_data:
+            return "state_vectors", [np.asarray(trajectory_data["state_vectors"],
+                                                dtype=np.float64)]
+    except (KeyError, ValueError, TypeError):
+        pass
+    return None
+
+
+def unpack_trajectory(kind: str, arrays: List[np.ndarray]) -> Any:
+    """Inverse of pack_trajectory(): the request format the encoder expects."""
+    if kind == "poses":
+        rot, trans = arrays
+        return {"poses": [{"rotation": rot[i], "translation": trans[i]} for i in range(len(rot))]}
+    if kind == "timeseries":
+        return {"positions": arrays[0], "orientations": arrays[1]}
+    return {"state_vectors": arrays[0]}
+
+
+# ----------------------------------------------------------------------
+# Worker process
+# ----------------------------------------------------------------------
+
+def _worker_main(wid: int, arena: shared_memory.SharedMemory, slot_bytes: int,
+                 conn: Connection) -> None:
+    signal.signal(signal.SIGINT, signal.SIG_IGN)  # Server owns shutdown
+    while True:
+        try:
+            task = conn.recv()
+        except EOFError:
+            return
+        if task is None:
+            return
+        task_id, slot, kind, layout, payload, options = task
+        try:
+            if layout is not None:
+                base = slot * slot_bytes
+                arrays = []
+                for shape in layout:
+                    n = int(np.prod(shape))
+                    view = np.ndarray(shape, dtype=np.float64, buffer=arena.buf, offset=base)
+                    arrays.append(view.copy())  # Slot is reused once we reply
+                    base += 8 * n
+                trajectory_data = unpack_trajectory(kind, arrays)
+            else:
+                trajectory_data = payload
+            metrics = compute_regenerative_metrics(trajectory_data, **options)
+            conn.send(("done", task_id, metrics))
+        except Exception as e:  # Reported to the waiting request
+            conn.send(("error", task_id, (type(e).__name__, str(e))))
+
+
+# ----------------------------------------------------------------------
+# Pool
+# ----------------------------------------------------------------------
+
+class MetricsWorkerPool:
+    """
+    Fixed pool of metrics workers with a bounded shared-memory queue.
+
+    Args:
+        workers: Worker processes (default: os.cpu_count())
+        slots: Requests queued or running at once (default: 2 × workers)
+        slot_bytes: Shared-memory bytes per slot (larger inputs are pickled)
+    """
+
+    # compute_metrics(): seconds to wait for a slot before PoolBusyError
+    queue_timeout: Optional[float] = 5.0
+
+    # wait(): seconds a request may run before ComputeTimeoutError (None = no limit)
+    result_timeout: Optional[float] = 300.0
+
+    def __init__(self, workers: Optional[int] = None, slots: Optional[int] = None,
+                 slot_bytes: int = 256 * 1024):
+        self.n_workers = workers or os.cpu_count() or 1
+        self.n_slots = slots or 2 * self.n_workers
+        self.slot_bytes = slot_bytes
+        # Workers (and respawns, from the collector thread) fork from a
+        # single-threaded server process, never from this threaded one
+        self._ctx = multiprocessing.get_context("forkserver")
+        self._ctx.set_forkserver_preload([__name__])
+        self._arena = shared_memory.SharedMemory(create=True, size=self.n_slots * slot_bytes)
+        self._free: "queue.Queue[int]" = queue.Queue()
+        for s in range(self.n_slots):
+            self._free.put(s)
+        self._ids = itertools.count()
+        self._pending: Dict[int, Tuple[Future, int, float]] = {}
+        self._waiting: Deque[Tuple] = deque()   # Tasks with a slot, no idle worker yet
+        self._idle: List[int] = []
+        self._running: Dict[int, int] = {}      # worker id → task id (set at dispatch)
+        self._lock = threading.Lock()
+        self._closed = False
+        self.completed = 0
+        self.failed = 0
+        self.rejected = 0
+        self.pickled = 0
+        self.respawned = 0
+        self.timed_out = 0
+        self.service_time = 0.0
+
+        self._procs: List[multiprocessing.Process] = []
+        self._conns: List[Connection] = []
+        for w in range(self.n_workers):
+            p, conn = self._spawn(w)
+            self._procs.append(p)
+            self._conns.append(conn)
+            self._idle.append(w)
+        self._collector = threading.Thread(target=self._collect, name="metrics-pool-collector",
+                                           daemon=True)
+        self._collector.start()
+        logger.info(f"Metrics pool: {self.n_workers} workers, {self.n_slots} slots "
+                    f"of {slot_bytes // 1024} KiB")
+
+    def _spawn(self, wid: int) -> Tuple[multiprocessing.Process, Connection]:
+        """Start worker wid on a fresh pipe (a dead worker's pipe may be mid-message)."""
+        ours, theirs = self._ctx.Pipe()
+        p = self._ctx.Process(target=_worker_main, name=f"metrics-worker-{wid}",
+                              args=(wid, self._arena, self.slot_bytes, theirs), daemon=True)
+        p.start()
+        theirs.close()
+        return p, ours
+
+    # ------------------------------------------------------------------
+    # Dispatch (caller holds self._lock)
+    # ------------------------------------------------------------------
+
+    def _dispatch(self, wid: int, task: Tuple) -> None:
+        """Hand a task to idle worker wid; ownership is recorded before the send."""
+        self._running[wid] = task[0]
+        try:
+            self._conns[wid].send(task)
+        except OSError:
+            pass    # Worker already dead: the collector reaps it and fails the task
+
+    def _worker_idle(self, wid: int) -> None:
+        if self._waiting:
+            self._dispatch(wid, self._waiting.popleft())
+        else:
+            self._idle.append(wid)
+
+    # ------------------------------------------------------------------
+    # Collector thread
+    # ------------------------------------------------------------------
+
+    def _finish(self, task_id: int) -> Optional[Tuple[Future, int, float]]:
+        with self._lock:
+            entry = self._pending.pop(task_id, None)
+        if entry is not None and entry[1] >= 0:
+            self._free.put(entry[1])
+        return entry
+
+    def _collect(self) -> None:
+        """
+        Wait on every worker's pipe and process sentinel at once, so a
+        crash is seen as soon as it happens, however busy the others are.
+        """
+        while not self._closed:
+            with self._lock:
+                conns = {c: wid for wid, c in enumerate(self._conns)}
+                sentinels = {p.sentinel: wid for wid, p in enumerate(self._procs)}
+            try:
+                ready = wait(list(conns) + list(sentinels), timeout=0.5)
+            except OSError:
+                continue    # A connection closed under us (respawn or close)
+            dead = {sentinels[r] for r in ready if r in sentinels}
+            for r in ready:
+                if r in conns and not self._receive(conns[r], r):
+                    dead.add(conns[r])
+            for wid in sorted(dead):
+                if not self._closed:
+                    self._reap(wid)
+
+    def _receive(self, wid: int, conn: Connection) -> bool:
+        """Handle one result from worker wid; False if its pipe is closed."""
+        try:
+            kind, task_id, body = conn.recv()
+        except (EOFError, OSError):
+            return False
+        with self._lock:
+            if self._running.get(wid) == task_id:
+                del self._running[wid]
+                self._worker_idle(wid)
+        entry = self._finish(task_id)
+        if entry is None:
+            return True
+        future, _, t0 = entry
+        self.service_time += time.perf_counter() - t0
+        if kind == "done":
+            self.completed += 1
+            future.set_result(body)
+        else:
+            self.failed += 1
+            name, message = body
+            future.set_exception(_FORWARDED_ERRORS.get(name, RuntimeError)(message))
+        return True
+
+    def _reap(self, wid: int) -> None:
+        """Respawn dead worker wid and fail the request it owned."""
+        old, conn = self._procs[wid], self._conns[wid]
+        while conn.poll() and self._receive(wid, conn):
+            pass    # A result sent just before the exit still counts
+        old.join(timeout=1)
+        logger.error(f"Metrics worker {wid} exited ({old.exitcode}); respawning")
+        p, conn = self._spawn(wid)
+        with self._lock:
+            task_id = self._running.pop(wid, None)
+            self._conns[wid].close()
+            self._procs[wid], self._conns[wid] = p, conn
+            if wid in self._idle:
+                self._idle.remove(wid)
+            self._worker_idle(wid)
+        self.respawned += 1
+        if task_id is not None:
+            entry = self._finish(task_id)
+            if entry is not None:
+                self.failed += 1
+                entry[0].set_exception(WorkerCrashedError(f"worker {wid} exited"))
+
+    # ------------------------------------------------------------------
+    # API
+    # ------------------------------------------------------------------
+
+    def submit(self, trajectory_data: Any, timeout: Optional[float] = None,
+               **options: Any) -> Future:
+        """
+        Queue one metrics computation.
+
+        Args:
+            trajectory_data: Request trajectory (any TrajectoryEncoder format)
+            timeout: Seconds to wait for a free slot (None = wait indefinitely)
+            **options: compute_regenerative_metrics options
+
+        Returns:
+            Future resolving to the metrics dict (see wait())
+
+        Raises:
+            PoolBusyError: every slot stayed busy for `timeout` seconds
+        """
+        if self._closed:
+            raise RuntimeError("metrics pool is closed")
+        opts = canonical_options(**options)
+        packed = pack_trajectory(trajectory_data)
+        try:
+            slot = self._free.get(timeout=timeout)
+        except queue.Empty:
+            self.rejected += 1
+            raise PoolBusyError(f"all {self.n_slots} compute slots busy") from None
+
+        task_id = None
+        try:
+            layout = None
+            payload = None
+            if packed is not None and sum(a.nbytes for a in packed[1]) <= self.slot_bytes:
+                kind, arrays = packed
+                base = slot * self.slot_bytes
+                layout = []
+                for a in arrays:
+                    dst = np.ndarray(a.shape, dtype=np.float64, buffer=self._arena.buf, offset=base)
+                    dst[...] = a
+                    base += a.nbytes
+                    layout.append(a.shape)
+            else:
+                kind, payload = "raw", trajectory_data
+                self.pickled += 1
+
+            task_id = next(self._ids)
+            future: Future = Future()
+            future.task_id = task_id
+            task = (task_id, slot, kind, layout, payload, opts)
+            with self._lock:
+                self._pending[task_id] = (future, slot, time.perf_counter())
+                if self._idle:
+                    self._dispatch(self._idle.pop(), task)
+                else:
+                    self._waiting.append(task)
+        except BaseException:
+            if task_id is not None:
+                with self._lock:
+                    self._pending.pop(task_id, None)
+            self._free.put(slot)   # The slot must not leak on a failed submit
+            raise
+        return future
+
+    def wait(self, future: Future, timeout: Optional[float] = None) -> Dict[str, Any]:
+        """
+        Result of a submit() future, bounded by result_timeout.
+
+        On timeout the request is abandoned: dropped if still queued, or its
+        worker is killed (and respawned) so the slot comes back.
+
+        Raises:
+            ComputeTimeoutError: no result within the timeout
+        """
+        timeout = self.result_timeout if timeout is None else timeout
+        try:
+            return future.result(timeout=timeout)
+        except FuturesTimeoutError:
+            pass
+        task_id = future.task_id
+        victim = None
+        with self._lock:
+            queued = [t for t in self._waiting if t[0] == task_id]
+            for t in queued:
+                self._waiting.remove(t)
+            for wid, tid in self._running.items():
+                if tid == task_id:
+                    victim = self._procs[wid]
+        if queued:
+            self._finish(task_id)
+        elif victim is not None:
+            victim.kill()           # The collector fails the task and respawns
+        self.timed_out += 1
+        raise ComputeTimeoutError(f"metrics computation exceeded {timeout:g} s")
+
+    def compute_metrics(self, trajectory_data: Any, **options: Any) -> Dict[str, Any]:
+        """
+        Drop-in for compute_regenerative_metrics() that runs in a worker.
+
+        Waits up to queue_timeout seconds for a free slot and result_timeout
+        seconds for the result.
+        """
+        return self.wait(self.submit(trajectory_data, timeout=self.queue_timeout, **options))
+
+    def map_metrics(self, trajectories: List[Any], cache: Optional[MetricsResultCache] = None,
+                    **options: Any) -> List[Dict[str, Any]]:
+        """
+        Batch form of compute_metrics (input order, per-item error dicts).
+
+        Items beyond the free slots wait for one instead of being rejected.
+        """
+        def one(item: Tuple[int, Any]) -> Dict[str, Any]:
+            i, trajectory_data = item
+            try:
+                if cache is not None:
+                    fn = lambda t, **o: self.wait(self.submit(t, **o))  # noqa: E731
+                    return cache.compute(fn, trajectory_data, **options)[0]
+                return self.wait(self.submit(trajectory_data, **options))
+            except Exception as e:
+                return {"error": str(e), "trajectory_index": i}
+
+        if not trajectories:
+            return []
+        with ThreadPoolExecutor(max_workers=min(len(trajectories), self.n_slots)) as ex:
+            return list(ex.map(one, enumerate(trajectories)))
+
+    def stats(self) -> Dict[str, Any]:
+        """Pool occupancy and throughput counters."""
+        done = self.completed + self.failed
+        return {
+            "workers": self.n_workers,
+            "workers_alive": sum(p.is_alive() for p in self._procs),
+            "slots": self.n_slots,
+            "slots_free": self._free.qsize(),
+            "in_flight": len(self._pending),
+            "completed": self.completed,
+            "failed": self.failed,
+            "rejected": self.rejected,
+            "pickled_fallbacks": self.pickled,
+            "respawned": self.respawned,
+            "timed_out": self.timed_out,
+            "mean_service_ms": 1e3 * self.service_time / done if done else None,
+        }
+
+    def close(self) -> None:
+        """Stop workers and release the arena (pending futures are cancelled)."""
+        if self._closed:
+            return
+        self._closed = True
+        with self._lock:
+            for conn in self._conns:
+                try:
+                    conn.send(None)
+                except OSError:
+                    pass
+        for p in self._procs:
+            p.join(timeout=5)
+            if p.is_alive():
+                p.terminate()
+        with self._lock:
+            pending = list(self._pending.values())
+            self._pending.clear()
+            self._waiting.clear()
+        for future, _, _ in pending:
+            future.cancel()
+        self._collector.join(timeout=2)
+        for conn in self._conns:
+            conn.close()
+        self._arena.close()
+        self._arena.unlink()
+
+    def __enter__(self) -> "MetricsWorkerPool":
+        return self
+
+    def __exit__(self, *exc: Any) -> None:
+        self.close()
@@ -145,6 +145,112 @@ export interface VersionInfoResponse {
   };
 }
 
+/**
+ * Latency summary for one cache outcome
+ */
+export interface CacheLatencySummary {
+  count: number;
+  mean_us?: number;
+  p50_us?: number;
+  p99_us?: number;
+}
+
+/**
+ * Result cache statistics (for the worker that served the request)
+ */
+export interface CacheStatsResponse {
+  status: 'success' | 'disabled';
+  data?: {
+    pid: number;
+    lookups: number;
+    hit_rate: number;
+    memory_hits: number;
+    shared_hits: number;
+    misses: number;
+    uncacheable: number;
+    memory_entries: number;
+    shared_entries: number | null;
+    max_entries: number;
+    hit_latency: CacheLatencySummary;
+    shared_hit_latency: CacheLatencySummary;
+    miss_latency: CacheLatencySummary;
+  };
+}
+
+/**
+ * Compute worker pool statistics
+ */
+export interface PoolStatsResponse {
+  status: 'success' | 'disabled';
+  data?: {
+    workers: number;
+    workers_alive: number;
+    slots: number;
+    slots_free: number;
+    in_flight: number;
+    completed: number;
+    failed: number;
+    rejected: number;
+    pickled_fallbacks: number;
+    respawned: number;
+    mean_service_ms: number | null;
+  };
+}
+
+/**
+ * Asynchronous job state
+ */
+export type JobState = 'queued' | 'running' | 'done' | 'cancelled' | 'failed';
+
+/**
+ * Job progress (GET /jobs/:id, DELETE /jobs/:id)
+ */
+export interface JobProgress {
+  job_id: string;
+  status: JobState;
+  total: number;
+  completed: number;
+  failed: number;
+  progress: number;
+  elapsed_s: number;
+  items_per_s: number | null;
+  error: string | null;
+}
+
+/**
+ * Job submission response (202)
+ */
+export interface JobSubmitResponse {
+  status: 'accepted' | 'error';
+  data?: {
+    job_id: string;
+    status: JobState;
+    total: number;
+  };
+  error?: string;
+}
+
+export interface JobStatusResponse {
+  status: 'success' | 'not_found';
+  data?: JobProgress;
+  error?: string;
+}
+
+/**
+ * One line of a job's NDJSON result stream (completion order)
+ */
+export type JobResultLine =
+  | { index: number; status: 'success'; data: RegenerativeMetrics }
+  | { index: number; status: 'error'; error: string };
+
+/**
+ * Final line of a job's result stream
+ */
+export interface JobStreamEnd {
+  status: JobState;
+  summary: JobProgress;
+}
+
 /**
  * Service configuration
  */
@@ -0,0 +1,215 @@
+/*
+ * arrow_bench.c - Host Benchmarks for Arrow C Data Interface Export
+ *
+ * Fills all 64 cells to capacity (8,192 poses, 448 KB of slabs) and 4,096
+ * DLT records, and measures:
+ *   1. Packed export: struct<pose: w:56> per cell, export + release
+ *   2. Columnar export: slab → SoA transpose, then export + release
+ *   3. DLT records: w:148 export, transpose to 8 columns, column export
+ *   4. A C consumer summing the imported mmsi column (read path)
+ *   5. Baselines: memcpy of the slabs, and CSV text re-serialization
+ *      (what every analysis hop pays without a shared memory format)
+ *
+ * Zero-copy exports cost the same for any row count (per column, not per
+ * row); GB/s figures are given for the paths that touch every byte.
+ *
+ * Built with (see Makefile):
+ *   gcc -O2 -D_GNU_SOURCE -o arrow_bench arrow_bench.c ../embedded/arrow_export.c \
+ *       ../embedded/t_bsp.c ../embedded/se3_math.c ../embedded/trig_tables.c \
+ *       -I../embedded -lm
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "../embedded/se3_edge.h"
+#include "../embedded/t_bsp.h"
+#include "../embedded/arrow_export.h"
+#include "bench_harness.h"
+
+#define N_RECORDS       4096
+#define ROUNDS          200         /* Passes over all 64 cells */
+#define CSV_ROUNDS      4
+
+static uint16_t cell_ids[MAX_CELLS];
+static int n_cells;
+
+static void fill_grid(t_bsp_t* bsp) {
+    t_bsp_init(bsp, 0, 0);
+    se3_pose_t p;
+    se3_pose_identity(&p);
+    uint32_t rng = 77;
+    for (int lat = 0; lat < 8; lat++) {
+        for (int lon = 0; lon < 8; lon++) {
+            uint16_t cell = t_bsp_latlon_to_cell(bsp, FLOAT_TO_FIXED(0.05f + 0.09f * lat),
+                                                 FLOAT_TO_FIXED(0.05f + 0.09f * lon));
+            for (int i = 0; i < MAX_POSES_PER_CELL; i++) {
+                rng = rng * 1103515245u + 12345u;
+                p.translation[0] = (fixed_t)(rng >> 8);
+                p.translation[1] = (fixed_t)(rng >> 12);
+                p.timestamp = 1700000000u + (uint32_t)i * 10u;
+                p.mmsi = 366000000u + (rng >> 20);
+                t_bsp_insert_pose(bsp, cell, &p);
+            }
+            cell_ids[n_cells++] = cell;
+        }
+    }
+}
+
+/* What a consumer does after import: walk to a column, read its buffer */
+static uint64_t consume_mmsi(const struct ArrowSchema* s, const struct ArrowArray* a) {
+    for (int64_t c = 0; c < s->n_children; c++) {
+        if (strcmp(s->children[c]->name, "mmsi") != 0) continue;
+        const uint32_t* v = (const uint32_t*)a->children[c]->buffers[1];
+        uint64_t sum = 0;
+        for (int64_t i = 0; i < a->length; i++) sum += v[i];
+        return sum;
+    }
+    return 0;
+}
+
+static void print_gbs(const char* what, double bytes, double ns) {
+    printf("  %-44s %12.2f GB/s\n", what, bytes / ns);
+}
+
+int main(void) {
+    printf("======================================================================\n");
+    printf("ARROW C DATA INTERFACE EXPORT BENCHMARKS\n");
+    printf("======================================================================\n");
+    se3_init_tables();
+
+    t_bsp_t* bsp = (t_bsp_t*)bench_alloc_aligned(sizeof(t_bsp_t));
+    static arrow_batch_t b;
+    struct ArrowSchema schema;
+    struct ArrowArray array;
+    if (!bsp) return 1;
+    fill_grid(bsp);
+    arrow_batch_init(&b);
+    const double slab_bytes = (double)n_cells * MAX_POSES_PER_CELL * sizeof(se3_pose_t);
+    printf("%d cells × %d poses (%.0f KB of slabs), %d DLT records (%zu bytes each)\n",
+           n_cells, MAX_POSES_PER_CELL, slab_bytes / 1024.0, N_RECORDS, sizeof(dlt_record_t));
+
+    /* ---------------------------------------------------------------- */
+    bench_section("Sealed cells: packed export (struct<pose: w:56>, zero-copy)");
+    bench_t t;
+    bench_begin(&t, "export + release, per cell");
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int c = 0; c < n_cells; c++) {
+            arrow_export_cell(&b, bsp, cell_ids[c], &schema, &array);
+            bench_sink += (uint64_t)array.length;
+            array.release(&array);
+            schema.release(&schema);
+        }
+    }
+    double ns = bench_end(&t, (uint64_t)ROUNDS * n_cells);
+
+    /* ---------------------------------------------------------------- */
+    bench_section("Sealed cells: columnar export (SoA transpose, then zero-copy)");
+    static fixed_t rot[MAX_POSES_PER_CELL][9], trans[MAX_POSES_PER_CELL][3];
+    static uint32_t ts[MAX_POSES_PER_CELL], mmsi[MAX_POSES_PER_CELL];
+    arrow_pose_columns_t cols = { rot, trans, ts, mmsi, 0, MAX_POSES_PER_CELL };
+    bench_begin(&t, "transpose slab to columns, per cell");
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int c = 0; c < n_cells; c++) {
+            arrow_cell_to_columns(bsp, cell_ids[c], &cols);
+            bench_sink += cols.mmsi[r % MAX_POSES_PER_CELL];
+        }
+    }
+    ns = bench_end(&t, (uint64_t)ROUNDS * n_cells);
+    print_gbs("poses transposed", MAX_POSES_PER_CELL * sizeof(se3_pose_t), ns);
+    bench_begin(&t, "export + release (columns already filled)");
+    for (int r = 0; r < ROUNDS * n_cells; r++) {
+        arrow_export_pose_columns(&b, &cols, bsp, cell_ids[r % n_cells], &schema, &array);
+        bench_sink += (uint64_t)array.length;
+        array.release(&array);
+        schema.release(&schema);
+    }
+    bench_end(&t, (uint64_t)ROUNDS * n_cells);
+    arrow_export_pose_columns(&b, &cols, NULL, 0, &schema, &array);
+    bench_begin(&t, "consumer: sum imported mmsi column, per row");
+    for (int r = 0; r < ROUNDS; r++) bench_sink += consume_mmsi(&schema, &array);
+    bench_end(&t, (uint64_t)ROUNDS * MAX_POSES_PER_CELL);
+    array.release(&array);
+    schema.release(&schema);
+
+    /* ---------------------------------------------------------------- */
+    bench_section("DLT records (4,096)");
+    dlt_record_t* rec = (dlt_record_t*)bench_alloc_aligned(N_RECORDS * sizeof(dlt_record_t));
+    static char ds[N_RECORDS][32];
+    static uint32_t r_mmsi[N_RECORDS], r_ts[N_RECORDS];
+    static uint16_t r_cell[N_RECORDS];
+    static fixed_t r_lambda[N_RECORDS], r_err[N_RECORDS];
+    static uint8_t r_hash[N_RECORDS][32], r_sig[N_RECORDS][64];
+    if (!rec) return 1;
+    memset(rec, 0, N_RECORDS * sizeof(dlt_record_t));
+    for (int i = 0; i < N_RECORDS; i++) {
+        strcpy(rec[i].dataset, "MarineCadastre_AIS");
+        rec[i].mmsi = 366000000u + (uint32_t)i;
+        rec[i].cell_id = cell_ids[i % n_cells];
+        rec[i].lambda_optimal = FLOAT_TO_FIXED(0.9f);
+        rec[i].timestamp = 1700000000u + (uint32_t)i;
+    }
+    const double rec_bytes = (double)N_RECORDS * sizeof(dlt_record_t);
+    bench_begin(&t, "packed export + release (w:148), per batch");
+    for (int r = 0; r < ROUNDS * 10; r++) {
+        arrow_export_dlt(&b, rec, N_RECORDS, &schema, &array);
+        bench_sink += (uint64_t)array.length;
+        array.release(&array);
+        schema.release(&schema);
+    }
+    bench_end(&t, (uint64_t)ROUNDS * 10);
+    arrow_dlt_columns_t dc = { ds, r_mmsi, r_cell, r_lambda, r_err, r_hash, r_ts, r_sig, 0, N_RECORDS };
+    bench_begin(&t, "transpose records to 8 columns, per batch");
+    for (int r = 0; r < ROUNDS / 10; r++) {
+        arrow_dlt_to_columns(rec, N_RECORDS, &dc);
+        bench_sink += r_mmsi[r];
+    }
+    ns = bench_end(&t, ROUNDS / 10);
+    print_gbs("records transposed", rec_bytes, ns);
+    bench_begin(&t, "column export + release, per batch");
+    for (int r = 0; r < ROUNDS * 10; r++) {
+        arrow_export_dlt_columns(&b, &dc, &schema, &array);
+        bench_sink += (uint64_t)array.length;
+        array.release(&array);
+        schema.release(&schema);
+    }
+    bench_end(&t, (uint64_t)ROUNDS * 10);
+
+    /* ---------------------------------------------------------------- */
+    bench_section("Baselines: copying the same poses");
+    se3_pose_t* copy = (se3_pose_t*)bench_alloc_aligned(MAX_POSES_PER_CELL * sizeof(se3_pose_t));
+    if (!copy) return 1;
+    bench_begin(&t, "memcpy slab, per cell");
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int c = 0; c < n_cells; c++) {
+            memcpy(copy, bsp->poses[c], MAX_POSES_PER_CELL * sizeof(se3_pose_t));
+            bench_sink += copy[r % MAX_POSES_PER_CELL].mmsi;
+        }
+    }
+    ns = bench_end(&t, (uint64_t)ROUNDS * n_cells);
+    print_gbs("poses copied", MAX_POSES_PER_CELL * sizeof(se3_pose_t), ns);
+    static char line[256];
+    bench_begin(&t, "CSV text serialization, per cell");
+    for (int r = 0; r < CSV_ROUNDS; r++) {
+        for (int c = 0; c < n_cells; c++) {
+            const se3_pose_t* p = bsp->poses[c];
+            for (int i = 0; i < MAX_POSES_PER_CELL; i++) {
+                int len = snprintf(line, sizeof(line),
+                                   "%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%u,%u\n",
+                                   p[i].rotation[0], p[i].rotation[1], p[i].rotation[2],
+                                   p[i].rotation[3], p[i].rotation[4], p[i].rotation[5],
+                                   p[i].rotation[6], p[i].rotation[7], p[i].rotation[8],
+                                   p[i].translation[0], p[i].translation[1],
+                                   p[i].translation[2], p[i].timestamp, p[i].mmsi);
+                bench_sink += (uint64_t)len;
+            }
+        }
+    }
+    ns = bench_end(&t, (uint64_t)CSV_ROUNDS * n_cells);
+    print_gbs("poses serialized", MAX_POSES_PER_CELL * sizeof(se3_pose_t), ns);
+
+    free(copy);
+    free(rec);
+    free(bsp);
+    return 0;
+}
@@ -0,0 +1,249 @@
+/*
+ * bench_harness.h - Minimal Host Benchmark Harness
+ *
+ * Header-only timing helpers shared by the *_bench.c programs.
+ * Host-only (POSIX clock_gettime); never compiled for the ESP32-S3.
+ *
+ * Usage:
+ *   bench_t b;
+ *   bench_begin(&b, "t_bsp_get_cell (miss)");
+ *   for (...) { ... }
+ *   bench_end(&b, ops);        // prints ns/op and Mops/s
+ *
+ * Hardware counters (Linux, BENCH_COUNTERS=1 or `make bench-counters`):
+ * bench_begin/bench_end also bracket perf_event_open counters (cycles,
+ * instructions, L1d read misses, LLC misses, branch misses) and print a
+ * second row per benchmark with per-op counts and IPC. Counters the kernel
+ * refuses (perf_event_paranoid, containers, VMs without a PMU) print "-";
+ * if none open, a single note is printed and timing works as before.
+ * Counts are user-space only and scaled for multiplexing.
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__linux__) && defined(_GNU_SOURCE)   /* syscall(); BENCH_CFLAGS defines it */
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define BENCH_HAVE_PERF 1
+#else
+#define BENCH_HAVE_PERF 0
+#endif
+
+/* Sink for results so the optimizer cannot drop benchmark loops */
+static volatile uint64_t bench_sink;
+
+/* ========================================================================
+ * HARDWARE COUNTERS
+ * ======================================================================== */
+
+enum {
+    BENCH_CTR_CYCLES,
+    BENCH_CTR_INSTRUCTIONS,
+    BENCH_CTR_L1D_MISSES,
+    BENCH_CTR_LLC_MISSES,
+    BENCH_CTR_BRANCH_MISSES,
+    BENCH_NCOUNTERS
+};
+
+#define BENCH_CTR_NONE UINT64_MAX   /* Counter unavailable */
+
+typedef struct {
+    const char* name;
+    uint64_t start_ns;
+    uint64_t elapsed_ns;
+    uint64_t counters[BENCH_NCOUNTERS];   /* Totals from last bench_end, or BENCH_CTR_NONE */
+} bench_t;
+
+/* -1 = not yet probed, 0 = off/unavailable, 1 = on */
+static int bench_ctr_state = -1;
+static int bench_ctr_fd[BENCH_NCOUNTERS];
+
+#if BENCH_HAVE_PERF
+static inline int bench_perf_open(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+/**
+ * Open counters on first use when BENCH_COUNTERS is set (and not "0").
+ *
+ * @return 1 if at least one counter is live
+ */
+static inline int bench_counters_enabled(void) {
+    if (bench_ctr_state >= 0) return bench_ctr_state;
+    bench_ctr_state = 0;
+    for (int i = 0; i < BENCH_NCOUNTERS; i++) bench_ctr_fd[i] = -1;
+
+    const char* env = getenv("BENCH_COUNTERS");
+    if (!env || !*env || strcmp(env, "0") == 0) return 0;
+#if BENCH_HAVE_PERF
+    static const struct { uint32_t type; uint64_t config; } events[BENCH_NCOUNTERS] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                              (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    };
+    int first_errno = 0;
+    for (int i = 0; i < BENCH_NCOUNTERS; i++) {
+        bench_ctr_fd[i] = bench_perf_open(events[i].type, events[i].config);
+        if (bench_ctr_fd[i] >= 0) bench_ctr_state = 1;
+        else if (!first_errno) first_errno = errno;
+    }
+    if (!bench_ctr_state) {
+        /* ENOENT: no PMU (typical VM); EACCES/EPERM: perf_event_paranoid */
+        printf("[BENCH] hardware counters unavailable (perf_event_open: %s) - timing only\n",
+               strerror(first_errno));
+    }
+#else
+    printf("[BENCH] hardware counters need Linux perf_event_open (-D_GNU_SOURCE) - timing only\n");
+#endif
+    return bench_ctr_state;
+}
+
+static inline void bench_counters_start(void) {
+#if BENCH_HAVE_PERF
+    for (int i = 0; i < BENCH_NCOUNTERS; i++) {
+        if (bench_ctr_fd[i] < 0) continue;
+        ioctl(bench_ctr_fd[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(bench_ctr_fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+static inline void bench_counters_stop(uint64_t* out) {
+    for (int i = 0; i < BENCH_NCOUNTERS; i++) out[i] = BENCH_CTR_NONE;
+#if BENCH_HAVE_PERF
+    for (int i = 0; i < BENCH_NCOUNTERS; i++) {
+        if (bench_ctr_fd[i] >= 0) ioctl(bench_ctr_fd[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int i = 0; i < BENCH_NCOUNTERS; i++) {
+        uint64_t v[3];   /* value, time enabled, time running */
+        if (bench_ctr_fd[i] < 0) continue;
+        if (read(bench_ctr_fd[i], v, sizeof(v)) != (ssize_t)sizeof(v) || v[2] == 0) continue;
+        out[i] = v[2] < v[1] ? (uint64_t)((double)v[0] * (double)v[1] / (double)v[2]) : v[0];
+    }
+#endif
+}
+
+static inline void bench_print_per_op(const char* label, uint64_t total, uint64_t ops) {
+    if (total == BENCH_CTR_NONE || !ops) printf(" %s %8s", label, "-");
+    else printf(" %s %8.2f", label, (double)total / (double)ops);
+}
+
+/* ========================================================================
+ * TIMING
+ * ======================================================================== */
+
+/**
+ * Monotonic timestamp in nanoseconds.
+ */
+static inline uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static inline void bench_begin(bench_t* b, const char* name) {
+    b->name = name;
+    b->elapsed_ns = 0;
+    for (int i = 0; i < BENCH_NCOUNTERS; i++) b->counters[i] = BENCH_CTR_NONE;
+    if (bench_counters_enabled()) bench_counters_start();
+    b->start_ns = bench_now_ns();
+}
+
+/**
+ * Stop timer and print one result row (plus a counter row when enabled).
+ *
+ * @param b Benchmark started with bench_begin()
+ * @param ops Number of operations performed (for per-op figures)
+ * @return Nanoseconds per operation
+ */
+static inline double bench_end(bench_t* b, uint64_t ops) {
+    b->elapsed_ns = bench_now_ns() - b->start_ns;
+    if (bench_ctr_state == 1) bench_counters_stop(b->counters);
+    double ns_per_op = ops ? (double)b->elapsed_ns / (double)ops : 0.0;
+    double mops = b->elapsed_ns ? (double)ops * 1e3 / (double)b->elapsed_ns : 0.0;
+    printf("  %-44s %12.2f ns/op %10.2f Mops/s\n", b->name, ns_per_op, mops);
+    if (bench_ctr_state == 1) {
+        const uint64_t* c = b->counters;
+        printf("  %-44s", "");
+        bench_print_per_op("cyc/op", c[BENCH_CTR_CYCLES], ops);
+        bench_print_per_op("ins/op", c[BENCH_CTR_INSTRUCTIONS], ops);
+        if (c[BENCH_CTR_CYCLES] != BENCH_CTR_NONE && c[BENCH_CTR_INSTRUCTIONS] != BENCH_CTR_NONE &&
+            c[BENCH_CTR_CYCLES] > 0) {
+            printf(" IPC %5.2f", (double)c[BENCH_CTR_INSTRUCTIONS] / (double)c[BENCH_CTR_CYCLES]);
+        } else {
+            printf(" IPC %5s", "-");
+        }
+        bench_print_per_op("L1d-miss/op", c[BENCH_CTR_L1D_MISSES], ops);
+        bench_print_per_op("LLC-miss/op", c[BENCH_CTR_LLC_MISSES], ops);
+        bench_print_per_op("br-miss/op", c[BENCH_CTR_BRANCH_MISSES], ops);
+        printf("\n");
+    }
+    return ns_per_op;
+}
+
+/**
+ * Cache-line aligned allocation for large T-BSP style structures.
+ *
+ * malloc() only guarantees 16-byte alignment; structures declared with
+ * T_BSP_CACHE_ALIGNED members need 64.
+ */
+static inline void* bench_alloc_aligned(size_t size) {
+    void* p = NULL;
+    if (posix_memalign(&p, 64, size) != 0) return NULL;
+    return p;
+}
+
+/**
+ * Evict data caches by streaming over a buffer larger than the LLC.
+ *
+ * Used for cold-cache (cache-miss) measurements. 64 MB covers typical
+ * desktop/server last-level caches.
+ */
+static inline void bench_evict_caches(void) {
+    static uint8_t* evict_buf = NULL;
+    const size_t evict_size = 64u << 20;
+    if (!evict_buf) {
+        evict_buf = (uint8_t*)malloc(evict_size);
+        if (!evict_buf) return;
+        memset(evict_buf, 1, evict_size);
+    }
+    uint64_t acc = 0;
+    for (size_t i = 0; i < evict_size; i += 64) {
+        evict_buf[i]++;
+        acc += evict_buf[i];
+    }
+    bench_sink += acc;
+}
+
+static inline void bench_section(const char* title) {
+    printf("\n[BENCH] %s\n", title);
+}
+
+#endif /* BENCH_HARNESS_H */
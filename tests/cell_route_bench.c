@@ -0,0 +1,216 @@
+/*
+ * cell_route_bench.c - Multi-Node Handoff Forwarding Simulator
+ *
+ * Measures:
+ *   1. cell_route_lookup() latency
+ *   2. Forwarded handoff bytes: broadcast vs. owner routing, for Z-order
+ *      block ranges vs. per-cell hashing (no locality)
+ *   3. Ranges and vessels moved by a node join / leave
+ *
+ * Vessels random-walk over a ±60-cell area with persistent headings;
+ * every cell change emits one handoff packet (100 bytes).
+ *
+ * Compile with:
+ *   gcc -O2 -D_GNU_SOURCE -o cell_route_bench cell_route_bench.c \
+ *       ../embedded/cell_route.c -I../embedded -lm
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "../embedded/se3_edge.h"
+#include "../embedded/cell_route.h"
+#include "bench_harness.h"
+#include <math.h>
+
+#define SIM_VESSELS     2000
+#define SIM_STEPS       2000
+#define SIM_SUBCELL     64          /* Position units per cell */
+#define SIM_EXTENT      60          /* Start area: ±60 cells */
+#define LOOKUP_ITERS    10000000
+
+typedef struct {
+    int32_t lat, lon;               /* 1/SIM_SUBCELL cell units */
+    int32_t dlat, dlon;             /* Velocity per step */
+    uint16_t cell_id;
+} sim_vessel_t;
+
+static uint32_t sim_rng = 12345;
+static inline uint32_t sim_rand(void) {
+    sim_rng ^= sim_rng << 13;
+    sim_rng ^= sim_rng >> 17;
+    sim_rng ^= sim_rng << 5;
+    return sim_rng;
+}
+
+static inline uint16_t sim_cell(int32_t lat, int32_t lon) {
+    int lat_idx = lat >= 0 ? lat / SIM_SUBCELL : -((-lat + SIM_SUBCELL - 1) / SIM_SUBCELL);
+    int lon_idx = lon >= 0 ? lon / SIM_SUBCELL : -((-lon + SIM_SUBCELL - 1) / SIM_SUBCELL);
+    return (uint16_t)(((lat_idx & 0xFF) << 8) | (lon_idx & 0xFF));
+}
+
+static void sim_init(sim_vessel_t* v, int n) {
+    sim_rng = 12345;
+    for (int i = 0; i < n; i++) {
+        v[i].lat = (int32_t)(sim_rand() % (2 * SIM_EXTENT * SIM_SUBCELL)) - SIM_EXTENT * SIM_SUBCELL;
+        v[i].lon = (int32_t)(sim_rand() % (2 * SIM_EXTENT * SIM_SUBCELL)) - SIM_EXTENT * SIM_SUBCELL;
+        double a = (sim_rand() % 3600) * (M_PI / 1800.0);
+        double speed = 2.0 + (sim_rand() % 60) / 10.0;  /* 2-8 units/step */
+        v[i].dlat = (int32_t)lround(speed * sin(a));
+        v[i].dlon = (int32_t)lround(speed * cos(a));
+        v[i].cell_id = sim_cell(v[i].lat, v[i].lon);
+    }
+}
+
+/* Per-cell hashing baseline: same table, range picked by a cell hash */
+static inline uint32_t hashed_lookup(const cell_route_t* rt, uint16_t cell_id) {
+    return rt->node_id[rt->owner[(uint8_t)((cell_id * 0x9E37u) >> 8)]];
+}
+
+typedef struct {
+    uint64_t handoffs;
+    uint64_t fixes;
+    uint64_t routed_zorder;         /* Handoffs crossing owners (Z-order ranges) */
+    uint64_t routed_hashed;         /* Handoffs crossing owners (per-cell hash) */
+} sim_stats_t;
+
+static void sim_run(const cell_route_t* rt, sim_stats_t* st) {
+    static sim_vessel_t v[SIM_VESSELS];
+    sim_init(v, SIM_VESSELS);
+    memset(st, 0, sizeof(*st));
+
+    for (int step = 0; step < SIM_STEPS; step++) {
+        for (int i = 0; i < SIM_VESSELS; i++) {
+            /* Occasional course change */
+            if ((sim_rand() & 63) == 0) {
+                int32_t t = v[i].dlat;
+                v[i].dlat = -v[i].dlon;
+                v[i].dlon = t;
+            }
+            v[i].lat += v[i].dlat;
+            v[i].lon += v[i].dlon;
+            /* Reflect at the area edge */
+            if (v[i].lat > SIM_EXTENT * SIM_SUBCELL || v[i].lat < -SIM_EXTENT * SIM_SUBCELL) {
+                v[i].dlat = -v[i].dlat;
+            }
+            if (v[i].lon > SIM_EXTENT * SIM_SUBCELL || v[i].lon < -SIM_EXTENT * SIM_SUBCELL) {
+                v[i].dlon = -v[i].dlon;
+            }
+            st->fixes++;
+
+            uint16_t cell = sim_cell(v[i].lat, v[i].lon);
+            if (cell == v[i].cell_id) continue;
+
+            st->handoffs++;
+            if (cell_route_lookup(rt, cell) != cell_route_lookup(rt, v[i].cell_id)) {
+                st->routed_zorder++;
+            }
+            if (hashed_lookup(rt, cell) != hashed_lookup(rt, v[i].cell_id)) {
+                st->routed_hashed++;
+            }
+            v[i].cell_id = cell;
+        }
+    }
+}
+
+static void bench_forwarding(void) {
+    static cell_route_t rt;
+    const int node_counts[4] = { 2, 4, 8, 16 };
+    const double pkt = (double)sizeof(handoff_packet_t);
+
+    bench_section("Forwarded handoff bytes (2000 vessels x 2000 fixes)");
+    printf("  %-6s %10s %14s %14s %14s %9s\n", "nodes", "handoffs",
+           "broadcast MB", "per-cell MB", "z-order MB", "vs bcast");
+
+    for (int k = 0; k < 4; k++) {
+        int nodes = node_counts[k];
+        cell_route_init(&rt);
+        for (int n = 0; n < nodes; n++) {
+            cell_route_add_node(&rt, 0x24A10000u + (uint32_t)n, NULL);
+        }
+
+        sim_stats_t st;
+        sim_run(&rt, &st);
+
+        double bcast = (double)st.handoffs * (nodes - 1) * pkt;
+        double hashed = (double)st.routed_hashed * pkt;
+        double zorder = (double)st.routed_zorder * pkt;
+        printf("  %-6d %10llu %14.2f %14.2f %14.2f %8.1f%%\n", nodes,
+               (unsigned long long)st.handoffs, bcast / 1e6, hashed / 1e6, zorder / 1e6,
+               bcast > 0 ? 100.0 * (1.0 - zorder / bcast) : 0.0);
+        if (k == 2) {
+            printf("         (8 nodes: %.3f forwarded bytes/fix z-order, %.3f per-cell, %.3f broadcast)\n",
+                   zorder / st.fixes, hashed / st.fixes, bcast / st.fixes);
+        }
+    }
+}
+
+static void bench_rebalance(void) {
+    static cell_route_t rt;
+    static sim_vessel_t v[SIM_VESSELS];
+    uint8_t moved[CELL_ROUTE_RANGES];
+    uint32_t before[SIM_VESSELS];
+
+    bench_section("Incremental rebalancing (8 → 9 → 8 nodes)");
+    cell_route_init(&rt);
+    for (int n = 0; n < 8; n++) {
+        cell_route_add_node(&rt, 0x24A10000u + (uint32_t)n, NULL);
+    }
+    sim_init(v, SIM_VESSELS);
+    for (int i = 0; i < SIM_VESSELS; i++) before[i] = cell_route_lookup(&rt, v[i].cell_id);
+
+    int n_join = cell_route_add_node(&rt, 0x24A100FFu, moved);
+    int vessels_moved = 0;
+    for (int i = 0; i < SIM_VESSELS; i++) {
+        if (cell_route_lookup(&rt, v[i].cell_id) != before[i]) vessels_moved++;
+    }
+    printf("  join : %3d / %d ranges moved (ideal %d), %4d / %d vessels migrate\n",
+           n_join, CELL_ROUTE_RANGES, CELL_ROUTE_RANGES / 9, vessels_moved, SIM_VESSELS);
+
+    for (int i = 0; i < SIM_VESSELS; i++) before[i] = cell_route_lookup(&rt, v[i].cell_id);
+    int n_leave = cell_route_remove_node(&rt, 0x24A10003u, moved);
+    vessels_moved = 0;
+    for (int i = 0; i < SIM_VESSELS; i++) {
+        if (cell_route_lookup(&rt, v[i].cell_id) != before[i]) vessels_moved++;
+    }
+    printf("  leave: %3d / %d ranges moved (ideal %d), %4d / %d vessels migrate\n",
+           n_leave, CELL_ROUTE_RANGES, CELL_ROUTE_RANGES / 9, vessels_moved, SIM_VESSELS);
+
+    bench_t b;
+    bench_begin(&b, "cell_route_add_node + remove_node (8 nodes)");
+    for (int i = 0; i < 10000; i++) {
+        cell_route_add_node(&rt, 0x24A20000u, NULL);
+        cell_route_remove_node(&rt, 0x24A20000u, NULL);
+    }
+    bench_end(&b, 10000);
+}
+
+static void bench_lookup(void) {
+    static cell_route_t rt;
+    cell_route_init(&rt);
+    for (int n = 0; n < 8; n++) {
+        cell_route_add_node(&rt, 0x24A10000u + (uint32_t)n, NULL);
+    }
+
+    bench_t b;
+    bench_section("Lookup");
+    bench_begin(&b, "cell_route_lookup");
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < LOOKUP_ITERS; i++) {
+        acc += cell_route_lookup(&rt, (uint16_t)(i * 40503u));
+    }
+    bench_sink += acc;
+    bench_end(&b, LOOKUP_ITERS);
+    printf("  table size: %zu bytes\n", sizeof(cell_route_t));
+}
+
+int main(void) {
+    printf("======================================================================\n");
+    printf("CELL OWNERSHIP ROUTING - MULTI-NODE SIMULATOR\n");
+    printf("======================================================================\n");
+
+    bench_lookup();
+    bench_forwarding();
+    bench_rebalance();
+    return 0;
+}
@@ -0,0 +1,207 @@
+/*
+ * cpa_bench.c - Host Benchmarks for CPA/TCPA Screening
+ *
+ * Replays a synthetic dense port: a share of the fleet is packed into a
+ * 4 km basin (manoeuvring, 0.5-4 m/s), the rest transits a 56 × 56 km
+ * approach area (4-10 m/s). Every vessel reports every 10 s for 20 minutes.
+ *
+ * Measures, for fleets of 500 to 4000 vessels:
+ *   1. Candidate pairs per fix: 3×3 cells vs. all pairs, and how many
+ *      survive cpa_may_alert() to the exact kernel
+ *   2. cpa_update() latency (mean, p50, p99)
+ *   3. Brute-force all-pairs latency on the same fixes (same kernel)
+ *
+ * Built with host capacities (see Makefile):
+ *   gcc -O2 -D_GNU_SOURCE -DCPA_MAX_VESSELS=8192 -DCPA_CELL_SLOTS=8192 \
+ *       -o cpa_bench cpa_bench.c ../embedded/cpa.c ../embedded/t_bsp.c \
+ *       ../embedded/se3_math.c ../embedded/trig_tables.c -I../embedded -lm
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "../embedded/se3_edge.h"
+#include "../embedded/t_bsp.h"
+#include "../embedded/cpa.h"
+#include "bench_harness.h"
+#include <math.h>
+
+#define MAX_FLEET       4000
+#define REPLAY_STEPS    120         /* 20 min at 10 s */
+#define REPORT_DT       10
+#define AREA_M          28000.0     /* Approach area ±28 km */
+#define BASIN_M         2000.0      /* Port basin ±2 km */
+#define BASIN_SHARE     0.5
+#define BRUTE_STEPS     20
+#define MAX_ALERTS      256
+#define M_PER_DEG       111320.0
+
+typedef struct {
+    double e, n;                    /* ENU position (m) */
+    double ve, vn;                  /* Velocity (m/s) */
+    double half;                    /* Reflect boundary (m) */
+} sim_vessel_t;
+
+static uint32_t rng = 4242;
+static inline uint32_t xrand(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+static inline double urand(void) { return (xrand() & 0xFFFFFF) / (double)0x1000000; }
+
+static void fleet_init(sim_vessel_t* v, int n) {
+    rng = 4242;
+    for (int i = 0; i < n; i++) {
+        bool basin = urand() < BASIN_SHARE;
+        double half = basin ? BASIN_M : AREA_M;
+        double speed = basin ? 0.5 + 3.5 * urand() : 4.0 + 6.0 * urand();
+        double a = urand() * 2.0 * M_PI;
+        v[i].e = (urand() * 2.0 - 1.0) * half;
+        v[i].n = (urand() * 2.0 - 1.0) * half;
+        v[i].ve = speed * cos(a);
+        v[i].vn = speed * sin(a);
+        v[i].half = half;
+    }
+}
+
+static void fleet_step(sim_vessel_t* v, int i) {
+    v[i].e += v[i].ve * REPORT_DT;
+    v[i].n += v[i].vn * REPORT_DT;
+    if (fabs(v[i].e) > v[i].half) v[i].ve = -v[i].ve;
+    if (fabs(v[i].n) > v[i].half) v[i].vn = -v[i].vn;
+}
+
+static inline uint16_t fix_cell(t_bsp_t* bsp, const sim_vessel_t* v) {
+    return t_bsp_latlon_to_cell(bsp, FLOAT_TO_FIXED(v->n / M_PER_DEG),
+                                FLOAT_TO_FIXED(v->e / M_PER_DEG));
+}
+
+static inline se3_pose_t fix_pose(const sim_vessel_t* v, int i, uint32_t t) {
+    se3_pose_t p;
+    memset(&p, 0, sizeof(p));
+    p.translation[0] = FLOAT_TO_FIXED(v->e);
+    p.translation[1] = FLOAT_TO_FIXED(v->n);
+    p.timestamp = t;
+    p.mmsi = 366000000u + (uint32_t)i;
+    return p;
+}
+
+static int cmp_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* Reference: screen the fix against every tracked vessel (same kernel) */
+static int brute_force(const cpa_engine_t* cpa, const se3_pose_t* pose, uint64_t* pairs) {
+    const cpa_vessel_t* self = NULL;
+    for (int i = 0; i < CPA_MAX_VESSELS && !self; i++) {
+        if (cpa->vessels[i].mmsi == pose->mmsi) self = &cpa->vessels[i];
+    }
+    if (!self || !self->has_vel) return 0;
+    int alerts = 0;
+    for (int i = 0; i < CPA_MAX_VESSELS; i++) {
+        const cpa_vessel_t* o = &cpa->vessels[i];
+        if (o == self || !o->has_vel || o->mmsi == CPA_TOMBSTONE) continue;
+        int64_t age = (int64_t)self->t - o->t;
+        fixed_t po[2] = { (fixed_t)(o->pos[0] + (int64_t)o->vel[0] * age),
+                          (fixed_t)(o->pos[1] + (int64_t)o->vel[1] * age) };
+        (*pairs)++;
+        int64_t r[2] = { (int64_t)po[0] - self->pos[0], (int64_t)po[1] - self->pos[1] };
+        int64_t rv[2] = { (int64_t)o->vel[0] - self->vel[0], (int64_t)o->vel[1] - self->vel[1] };
+        if (!cpa_may_alert(cpa, r, rv)) continue;
+        fixed_t dcpa, tcpa;
+        cpa_compute(self->pos, self->vel, po, o->vel, &dcpa, &tcpa);
+        alerts += dcpa <= cpa->dcpa_threshold && tcpa <= cpa->tcpa_horizon;
+    }
+    return alerts;
+}
+
+static void bench_fleet(int n_fleet) {
+    static sim_vessel_t fleet[MAX_FLEET];
+    static uint64_t samples[MAX_FLEET * REPLAY_STEPS];
+    static cpa_alert_t alerts[MAX_ALERTS];
+    t_bsp_t* bsp = (t_bsp_t*)bench_alloc_aligned(sizeof(t_bsp_t));
+    cpa_engine_t* cpa = (cpa_engine_t*)bench_alloc_aligned(sizeof(cpa_engine_t));
+    if (!bsp || !cpa) {
+        fprintf(stderr, "allocation failed\n");
+        exit(1);
+    }
+
+    /* 0.5 NM, 20 min, 3 min staleness */
+    t_bsp_init(bsp, 0, 0);
+    cpa_init(cpa, INT_TO_FIXED(926), INT_TO_FIXED(1200), 180);
+    fleet_init(fleet, n_fleet);
+
+    uint64_t n_alerts = 0, n_fix = 0;
+    uint64_t total_ns = 0;
+    for (int step = 0; step < REPLAY_STEPS; step++) {
+        uint32_t t = 1700000000u + (uint32_t)(step * REPORT_DT);
+        for (int i = 0; i < n_fleet; i++) {
+            fleet_step(fleet, i);
+            uint16_t cell = fix_cell(bsp, &fleet[i]);
+            se3_pose_t pose = fix_pose(&fleet[i], i, t);
+            uint64_t t0 = bench_now_ns();
+            int a = cpa_update(cpa, bsp, cell, &pose, alerts, MAX_ALERTS);
+            uint64_t dt = bench_now_ns() - t0;
+            samples[n_fix++] = dt;
+            total_ns += dt;
+            n_alerts += (uint64_t)(a > 0 ? a : 0);
+        }
+    }
+    uint64_t grid_pairs = cpa->pairs_evaluated;
+    uint64_t exact_pairs = cpa->pairs_computed;
+
+    /* Brute force over a short window, continuing the same replay */
+    uint64_t brute_pairs = 0, brute_fixes = 0, brute_alerts = 0;
+    uint64_t b0 = bench_now_ns();
+    for (int step = 0; step < BRUTE_STEPS; step++) {
+        uint32_t t = 1700000000u + (uint32_t)((REPLAY_STEPS + step) * REPORT_DT);
+        for (int i = 0; i < n_fleet; i++) {
+            fleet_step(fleet, i);
+            uint16_t cell = fix_cell(bsp, &fleet[i]);
+            se3_pose_t pose = fix_pose(&fleet[i], i, t);
+            cpa_update(cpa, bsp, cell, &pose, alerts, 0);  /* State only */
+            brute_alerts += (uint64_t)brute_force(cpa, &pose, &brute_pairs);
+            brute_fixes++;
+        }
+    }
+    double brute_ns = (double)(bench_now_ns() - b0) / (double)brute_fixes;
+
+    qsort(samples, n_fix, sizeof(uint64_t), cmp_u64);
+    double grid_per_fix = (double)grid_pairs / n_fix;
+    double all_per_fix = (double)brute_pairs / brute_fixes;
+    printf("  %-6d %9.1f %9.1f %8.1f%% %9.1f %9.0f %7llu %7llu %9.0f %10.2f\n", n_fleet,
+           grid_per_fix, all_per_fix, 100.0 * (1.0 - grid_per_fix / all_per_fix),
+           (double)exact_pairs / n_fix,
+           (double)total_ns / n_fix, (unsigned long long)samples[n_fix / 2],
+           (unsigned long long)samples[n_fix * 99 / 100], brute_ns,
+           (double)n_alerts / n_fix);
+    bench_sink += brute_alerts;
+
+    free(cpa);
+    free(bsp);
+}
+
+int main(void) {
+    printf("======================================================================\n");
+    printf("CPA/TCPA SCREENING - DENSE PORT REPLAY\n");
+    printf("======================================================================\n");
+    printf("Fleet: %.0f%% in a ±%.0f km basin, rest over ±%.0f km; fix every %d s for %d s\n",
+           BASIN_SHARE * 100.0, BASIN_M / 1000.0, AREA_M / 1000.0, REPORT_DT,
+           REPLAY_STEPS * REPORT_DT);
+    printf("Alert: DCPA <= 926 m within 1200 s; sizeof(cpa_engine_t): %zu KB\n",
+           sizeof(cpa_engine_t) / 1024);
+
+    se3_init_tables();
+
+    bench_section("Candidate pairs and cpa_update() latency");
+    printf("  %-6s %9s %9s %9s %9s %9s %7s %7s %9s %10s\n", "fleet", "grid/fix", "all/fix",
+           "pruned", "exact/fix", "mean ns", "p50", "p99", "brute ns", "alerts/fix");
+    const int fleets[4] = { 500, 1000, 2000, 4000 };
+    for (int k = 0; k < 4; k++) {
+        bench_fleet(fleets[k]);
+    }
+    return 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * density_bench.c - Host Benchmarks for the Traffic-Density Raster
+ *
+ * Replays 2,000 vessels over a ±0.25° area reporting every
+ * 10 s for one hour (~49 cells), and measures:
+ *   1. Insert overhead: t_bsp_insert_pose() alone vs. with density_add()
+ *   2. Export size vs. raw tiles and vs. exporting every pose
+ *   3. Export and decode time
+ *
+ * Built with host capacities (see Makefile):
+ *   gcc -O2 -D_GNU_SOURCE -DDENSITY_MAX_TILES=256 -DDENSITY_LAYERS=4 \
+ *       -o density_bench density_bench.c ../embedded/density.c \
+ *       ../embedded/t_bsp.c ../embedded/se3_math.c ../embedded/trig_tables.c \
+ *       -I../embedded -lm
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "../embedded/se3_edge.h"
+#include "../embedded/t_bsp.h"
+#include "../embedded/density.h"
+#include "bench_harness.h"
+#include <math.h>
+
+#define N_VESSELS       2000
+#define N_STEPS         360         /* 1 h at 10 s */
+#define N_FIXES         (N_VESSELS * N_STEPS)
+#define AREA_DEG        0.25
+#define EXPORT_CAP      (4u << 20)
+
+typedef struct {
+    fixed_t lat, lon;
+    uint16_t cell_id;
+    uint8_t vclass;
+    uint32_t timestamp;
+    uint32_t mmsi;
+} replay_fix_t;
+
+static uint32_t rng = 777;
+static inline uint32_t xrand(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+static inline double urand(void) { return (xrand() & 0xFFFFFF) / (double)0x1000000; }
+
+/* Lanes: most traffic follows a few straight routes, the rest wanders */
+static void make_replay(t_bsp_t* bsp, replay_fix_t* fixes) {
+    static double lat[N_VESSELS], lon[N_VESSELS], dlat[N_VESSELS], dlon[N_VESSELS];
+    for (int v = 0; v < N_VESSELS; v++) {
+        int lane = (int)(xrand() % 5);
+        double a = lane < 4 ? lane * (M_PI / 4.0) : urand() * 2.0 * M_PI;
+        double speed = 0.0002 + 0.0008 * urand();   /* deg per 10 s (~2-10 m/s) */
+        lat[v] = (urand() * 2.0 - 1.0) * AREA_DEG;
+        lon[v] = lane < 4 ? (urand() * 0.02 - 0.01) : (urand() * 2.0 - 1.0) * AREA_DEG;
+        dlat[v] = speed * sin(a);
+        dlon[v] = speed * cos(a);
+    }
+    for (int i = 0; i < N_FIXES; i++) {
+        int v = i % N_VESSELS;
+        lat[v] += dlat[v];
+        lon[v] += dlon[v];
+        if (fabs(lat[v]) > AREA_DEG) dlat[v] = -dlat[v];
+        if (fabs(lon[v]) > AREA_DEG) dlon[v] = -dlon[v];
+        replay_fix_t* f = &fixes[i];
+        f->lat = FLOAT_TO_FIXED(lat[v]);
+        f->lon = FLOAT_TO_FIXED(lon[v]);
+        f->cell_id = t_bsp_latlon_to_cell(bsp, f->lat, f->lon);
+        f->vclass = (uint8_t)(v % 4);              /* 0 other, 1 cargo, 2 tanker, 3 fishing */
+        f->timestamp = 1700000000u + (uint32_t)(i / N_VESSELS) * 10u;
+        f->mmsi = 367000000u + (uint32_t)v;
+    }
+}
+
+static inline void fill_pose(se3_pose_t* p, const replay_fix_t* f) {
+    p->translation[0] = f->lon;
+    p->translation[1] = f->lat;
+    p->timestamp = f->timestamp;
+    p->mmsi = f->mmsi;
+}
+
+int main(void) {
+    printf("======================================================================\n");
+    printf("TRAFFIC-DENSITY RASTER - HOST BENCHMARKS\n");
+    printf("======================================================================\n");
+
+    se3_init_tables();
+
+    t_bsp_t* bsp = (t_bsp_t*)bench_alloc_aligned(sizeof(t_bsp_t));
+    density_raster_t* dr = (density_raster_t*)bench_alloc_aligned(sizeof(density_raster_t));
+    replay_fix_t* fixes = (replay_fix_t*)malloc(sizeof(replay_fix_t) * N_FIXES);
+    uint8_t* buf = (uint8_t*)malloc(EXPORT_CAP);
+    if (!bsp || !dr || !fixes || !buf) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+
+    t_bsp_init(bsp, 0, 0);
+    make_replay(bsp, fixes);
+    printf("Replay: %d vessels, %d fixes; tile %d×%d px, %d layers, %d tiles max\n",
+           N_VESSELS, N_FIXES, DENSITY_TILE_DIM, DENSITY_TILE_DIM, DENSITY_LAYERS,
+           DENSITY_MAX_TILES);
+    printf("sizeof(density_raster_t): %zu KB (embedded defaults: 32 tiles × 1 layer ≈ 17 KB)\n",
+           sizeof(density_raster_t) / 1024);
+
+    se3_pose_t pose;
+    memset(&pose, 0, sizeof(pose));
+    pose.rotation[0] = pose.rotation[4] = pose.rotation[8] = FRACUNIT;
+
+    bench_t b;
+    bench_section("Insert overhead");
+    bench_begin(&b, "t_bsp_insert_pose");
+    for (int i = 0; i < N_FIXES; i++) {
+        fill_pose(&pose, &fixes[i]);
+        t_bsp_insert_pose(bsp, fixes[i].cell_id, &pose);
+    }
+    double base_ns = bench_end(&b, N_FIXES);
+
+    t_bsp_init(bsp, 0, 0);
+    density_init(dr, DENSITY_MODE_DECAY, 600);
+    bench_begin(&b, "t_bsp_insert_pose + density_add");
+    for (int i = 0; i < N_FIXES; i++) {
+        const replay_fix_t* f = &fixes[i];
+        fill_pose(&pose, f);
+        t_bsp_insert_pose(bsp, f->cell_id, &pose);
+        density_add(dr, bsp, f->cell_id, f->lat, f->lon, f->timestamp, f->vclass);
+    }
+    double both_ns = bench_end(&b, N_FIXES);
+
+    density_init(dr, DENSITY_MODE_WINDOW, 86400);
+    bench_begin(&b, "density_add (24 h window)");
+    for (int i = 0; i < N_FIXES; i++) {
+        const replay_fix_t* f = &fixes[i];
+        density_add(dr, bsp, f->cell_id, f->lat, f->lon, f->timestamp, f->vclass);
+    }
+    bench_end(&b, N_FIXES);
+    printf("  overhead: +%.1f ns/fix (%.0f%% of insert); %u tiles, %u evictions, %u saturated\n",
+           both_ns - base_ns, 100.0 * (both_ns - base_ns) / base_ns, dr->n_tiles,
+           dr->evictions, dr->saturated);
+
+    bench_section("Export (whole replay in one window, all layers)");
+    size_t len = 0;
+    bench_begin(&b, "density_export");
+    for (int r = 0; r < 100; r++) {
+        len = density_export(dr, buf, EXPORT_CAP);
+    }
+    bench_end(&b, 100);
+
+    uint16_t pixels[DENSITY_TILE_PIXELS];
+    uint64_t total = 0;
+    uint16_t n_records = (uint16_t)(buf[6] | (buf[7] << 8));
+    bench_begin(&b, "density_decode_tile (whole export)");
+    for (int r = 0; r < 100; r++) {
+        size_t pos = DENSITY_EXPORT_HEADER;
+        for (uint16_t k = 0; k < n_records; k++) {
+            density_tile_info_t info;
+            size_t n = density_decode_tile(buf + pos, len - pos, &info, pixels);
+            if (n == 0) break;
+            pos += n;
+            if (r == 0 && info.layer == 0) {
+                for (int p = 0; p < DENSITY_TILE_PIXELS; p++) total += pixels[p];
+            }
+        }
+    }
+    bench_end(&b, 100);
+
+    size_t raw = (size_t)dr->n_tiles * DENSITY_LAYERS * DENSITY_TILE_PIXELS * sizeof(uint16_t);
+    size_t poses = (size_t)N_FIXES * sizeof(se3_pose_t);
+    printf("  %u records, %zu bytes (%.2f bytes/record-pixel); layer-0 total %llu of %d fixes\n",
+           n_records, len, (double)len / ((double)n_records * DENSITY_TILE_PIXELS),
+           (unsigned long long)total, N_FIXES);
+    printf("  vs raw tiles: %zu bytes (%.1f× smaller); vs pose export: %.1f MB (%.0f× smaller)\n",
+           raw, (double)raw / len, poses / 1e6, (double)poses / len);
+
+    free(buf);
+    free(fixes);
+    free(dr);
+    free(bsp);
+    return 0;
+}
@@ -0,0 +1,354 @@
+/*
+ * dlt_archive_bench.c - Compact DLT Records and the Columnar Archive vs. Raw Dumps
+ *
+ * Generates a day of published records (2000 vessels, 8 edge nodes of 512
+ * cells each, λ around 0.5, time-ordered, random trajectory hashes; 95% of
+ * records from one dataset) in two variants, signed (ed25519 signature
+ * present) and unsigned (not yet signed), and compares three stored forms:
+ *   raw      dlt_record_t dump, 148 bytes per record, mmap'd
+ *   v2       dlt_record_v2_encode() stream (per-record, interned dataset)
+ *   archive  dlt_archive blocks (one per sealed batch of 65536), mmap'd
+ * and measures:
+ *   1. Encode cost per record (v2 stream; archive blocks including fwrite)
+ *   2. Bytes per record, overall and per archive column
+ *   3. Full decode to dlt_record_t (raw: memcpy from the map)
+ *   4. A column scan: mean λ over a cell range and time window, from the
+ *      raw structs, from archive columns, and from archive columns with
+ *      blocks skipped by their zone map
+ *   5. Round trip: every archive block decodes to the records written,
+ *      and every v2 record decodes to its original
+ *
+ * Files are written to /tmp and read back warm (page cache), so the
+ * throughput figures are decode cost, not disk bandwidth; on cold storage
+ * the archive additionally reads 3-10× fewer bytes.
+ *
+ * Usage: ./dlt_archive_bench [records]    (default 1048576)
+ *
+ * Built with (see Makefile):
+ *   gcc -O2 -D_GNU_SOURCE -DDLT_ARCHIVE_LIBRARY -o dlt_archive_bench \
+ *       dlt_archive_bench.c ../tools/dlt_archive.c ../embedded/dlt_record.c \
+ *       -I../embedded -I../tools -lm
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "../embedded/se3_edge.h"
+#include "../embedded/dlt_record.h"
+#include "../tools/dlt_archive.h"
+#include "bench_harness.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define N_VESSELS     2000
+#define N_NODES       8
+#define NODE_CELLS    512
+#define BATCH         DLT_ARCHIVE_MAX_BATCH
+#define T0            1735689600u        /* 2025-01-01T00:00:00Z */
+#define DAY_S         86400u
+
+#define RAW_PATH      "/tmp/dlt_archive_bench.bin"
+#define ARCHIVE_PATH  "/tmp/dlt_archive_bench.dlta"
+
+/* Scan query: node 4's first quarter of cells, hours 6-9 */
+#define Q_CELL_LO     (4 * NODE_CELLS)
+#define Q_CELL_HI     (4 * NODE_CELLS + NODE_CELLS / 4 - 1)
+#define Q_TIME_LO     (T0 + 6 * 3600u)
+#define Q_TIME_HI     (T0 + 9 * 3600u - 1)
+
+static uint32_t rng_state = 125;
+
+static uint32_t rand32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static const char* column_names[DLT_COLUMNS] = {
+    "dataset", "mmsi", "cell_id", "lambda", "error", "hash", "timestamp", "signature",
+};
+
+/* ========================================================================
+ * DATA
+ * ======================================================================== */
+
+/**
+ * Records in publication order: each sealed batch comes from one edge node
+ * (its own cell range), batches rotate over the nodes, and time advances
+ * through the day.
+ */
+static void generate(dlt_record_t* recs, uint32_t n, bool sign) {
+    static uint32_t mmsi[N_VESSELS];
+    rng_state = 125;
+    for (int v = 0; v < N_VESSELS; v++) mmsi[v] = 200000000u + rand32() % 575000000u;
+
+    for (uint32_t i = 0; i < n; i++) {
+        dlt_record_t* r = &recs[i];
+        memset(r, 0, sizeof(*r));
+        strcpy(r->dataset, (i / 1000) % 20 == 19 ? "NOAA_VMS_2025" : "MarineCadastre_AIS_2025");
+        r->mmsi = mmsi[rand32() % N_VESSELS];
+        uint32_t node = (i / BATCH) % N_NODES;
+        r->cell_id = (uint16_t)(node * NODE_CELLS + rand32() % NODE_CELLS);
+        r->lambda_optimal = FLOAT_TO_FIXED(0.5f) + (fixed_t)(rand32() % 13108) - 6554;
+        r->return_error = (fixed_t)(rand32() % 13108);
+        r->timestamp = T0 + (uint32_t)((uint64_t)i * DAY_S / n);
+        for (int k = 0; k < 32; k += 4) {
+            uint32_t x = rand32();
+            memcpy(r->trajectory_hash + k, &x, 4);
+        }
+        if (sign) {
+            for (int k = 0; k < 64; k += 4) {
+                uint32_t x = rand32();
+                memcpy(r->signature + k, &x, 4);
+            }
+        }
+    }
+}
+
+static bool write_raw(const dlt_record_t* recs, uint32_t n) {
+    FILE* f = fopen(RAW_PATH, "wb");
+    if (!f) return false;
+    bool ok = fwrite(recs, sizeof(*recs), n, f) == n;
+    return fclose(f) == 0 && ok;
+}
+
+static bool write_archive(const dlt_record_t* recs, uint32_t n) {
+    dlt_archive_writer_t w;
+    if (!dlt_archive_create(&w, ARCHIVE_PATH, false)) {
+        fprintf(stderr, "  archive: %s\n", w.error);
+        return false;
+    }
+    for (uint32_t i = 0; i < n; i += BATCH) {
+        dlt_archive_append(&w, recs + i, n - i < BATCH ? n - i : BATCH);
+    }
+    bool ok = dlt_archive_finish(&w);
+    if (!ok) fprintf(stderr, "  archive: %s\n", w.error);
+    return ok;
+}
+
+/* Touch every page so the timed passes measure decoding, not page faults */
+static void prefault(const void* map, size_t size) {
+    const volatile uint8_t* p = (const volatile uint8_t*)map;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < size; i += 4096) sum += p[i];
+    bench_sink += sum;
+}
+
+static const dlt_record_t* map_raw(size_t* size) {
+    int fd = open(RAW_PATH, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) return NULL;
+    void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    *size = (size_t)st.st_size;
+    return p == MAP_FAILED ? NULL : (const dlt_record_t*)p;
+}
+
+/* ========================================================================
+ * SCANS
+ * ======================================================================== */
+
+typedef struct {
+    uint64_t matched;
+    int64_t lambda_sum;
+    uint32_t blocks_read;
+} scan_result_t;
+
+static scan_result_t scan_raw(const dlt_record_t* recs, uint32_t n) {
+    scan_result_t s = { 0, 0, 0 };
+    for (uint32_t i = 0; i < n; i++) {
+        const dlt_record_t* r = &recs[i];
+        if (r->cell_id >= Q_CELL_LO && r->cell_id <= Q_CELL_HI &&
+            r->timestamp >= Q_TIME_LO && r->timestamp <= Q_TIME_HI) {
+            s.matched++;
+            s.lambda_sum += r->lambda_optimal;
+        }
+    }
+    return s;
+}
+
+static scan_result_t scan_archive(const dlt_archive_t* a, arrow_dlt_columns_t* cols,
+                                  bool zone_map) {
+    scan_result_t s = { 0, 0, 0 };
+    unsigned need = DLT_COL_BIT(DLT_COL_CELL) | DLT_COL_BIT(DLT_COL_TIME) |
+                    DLT_COL_BIT(DLT_COL_LAMBDA);
+    for (uint32_t k = 0; k < a->n_blocks; k++) {
+        const dlt_archive_block_t* h = a->blocks[k];
+        if (zone_map && (h->cell_max < Q_CELL_LO || h->cell_min > Q_CELL_HI ||
+                         h->time_max < Q_TIME_LO || h->time_min > Q_TIME_HI)) {
+            continue;
+        }
+        int n = dlt_archive_read(a, k, need, cols);
+        s.blocks_read++;
+        for (int i = 0; i < n; i++) {
+            if (cols->cell_id[i] >= Q_CELL_LO && cols->cell_id[i] <= Q_CELL_HI &&
+                cols->timestamp[i] >= Q_TIME_LO && cols->timestamp[i] <= Q_TIME_HI) {
+                s.matched++;
+                s.lambda_sum += cols->lambda_optimal[i];
+            }
+        }
+    }
+    return s;
+}
+
+/* ========================================================================
+ * ONE VARIANT
+ * ======================================================================== */
+
+/** @return false if any round trip or scan disagrees */
+static bool run_variant(const char* label, dlt_record_t* recs, dlt_record_t* out,
+                        uint8_t* stream, uint32_t n, bool sign) {
+    printf("\n----------------------------------------------------------------------\n");
+    printf("%s (%u records)\n", label, n);
+    printf("----------------------------------------------------------------------\n");
+    generate(recs, n, sign);
+    bool ok = true;
+
+    if (!write_raw(recs, n)) return false;
+
+    bench_section("1. Encode");
+    dlt_dataset_table_t table;
+    dlt_dataset_table_init(&table);
+    bench_t b;
+    bench_begin(&b, "v2 stream: dlt_record_v2_encode");
+    size_t stream_len = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        stream_len += (size_t)dlt_record_v2_encode(&recs[i], &table, stream + stream_len);
+    }
+    bench_end(&b, n);
+    bench_begin(&b, "archive: dlt_archive_append (+ fwrite)");
+    if (!write_archive(recs, n)) return false;
+    bench_end(&b, n);
+
+    size_t raw_size;
+    const dlt_record_t* raw = map_raw(&raw_size);
+    dlt_archive_t a;
+    if (!raw || !dlt_archive_open(&a, ARCHIVE_PATH)) {
+        fprintf(stderr, "  cannot map the files\n");
+        return false;
+    }
+    prefault(raw, raw_size);
+    prefault(a.map, a.size);
+
+    bench_section("2. Bytes per record");
+    printf("  %-10s %10s %8s\n", "form", "bytes/rec", "vs raw");
+    printf("  %-10s %10.1f %7.2fx\n", "raw", (double)raw_size / n, 1.0);
+    printf("  %-10s %10.1f %7.2fx\n", "v2", (double)stream_len / n,
+           (double)raw_size / stream_len);
+    printf("  %-10s %10.1f %7.2fx   (%u blocks, %.1f MB)\n", "archive", (double)a.size / n,
+           (double)raw_size / a.size, a.n_blocks, a.size / 1e6);
+    uint64_t col_bytes[DLT_COLUMNS] = { 0 };
+    for (uint32_t k = 0; k < a.n_blocks; k++) {
+        const dlt_archive_block_t* h = a.blocks[k];
+        for (int c = 0; c < DLT_COLUMNS; c++) {
+            uint32_t end = c + 1 < DLT_COLUMNS ? h->col_off[c + 1] : h->bytes;
+            col_bytes[c] += end - h->col_off[c];
+        }
+    }
+    printf("  archive columns (bytes/record):");
+    for (int c = 0; c < DLT_COLUMNS; c++) {
+        printf("%s %s %.2f", c % 4 == 0 ? "\n   " : "", column_names[c],
+               (double)col_bytes[c] / n);
+    }
+    printf("\n    block headers + file header %.2f\n",
+           (double)(a.n_blocks * sizeof(dlt_archive_block_t) + DLT_ARCHIVE_FILE_HEADER) / n);
+
+    bench_section("3. Full decode to dlt_record_t");
+    bench_begin(&b, "raw: memcpy from the map");
+    memcpy(out, raw, (size_t)n * sizeof(dlt_record_t));
+    bench_sink += out[n - 1].timestamp;
+    double raw_ns = bench_end(&b, n);
+    bench_begin(&b, "v2 stream: dlt_record_v2_decode");
+    size_t off = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        off += (size_t)dlt_record_v2_decode(stream + off, stream_len - off, &table, &out[i]);
+    }
+    double v2_ns = bench_end(&b, n);
+    bool v2_ok = off == stream_len && memcmp(out, recs, (size_t)n * sizeof(dlt_record_t)) == 0;
+    bench_begin(&b, "archive: dlt_archive_read_records");
+    uint32_t got = 0;
+    for (uint32_t k = 0; k < a.n_blocks; k++) {
+        int m = dlt_archive_read_records(&a, k, out + got);
+        if (m > 0) got += (uint32_t)m;
+    }
+    double arc_ns = bench_end(&b, n);
+    printf("  → %.0f / %.0f / %.0f MB/s of records (raw / v2 / archive)\n",
+           sizeof(dlt_record_t) * 1e3 / raw_ns, sizeof(dlt_record_t) * 1e3 / v2_ns,
+           sizeof(dlt_record_t) * 1e3 / arc_ns);
+
+    bench_section("4. Scan: mean λ for cells 2048-2175, 06:00-09:00");
+    arrow_dlt_columns_t cols;
+    memset(&cols, 0, sizeof(cols));
+    cols.cell_id = malloc(BATCH * sizeof(*cols.cell_id));
+    cols.timestamp = malloc(BATCH * sizeof(*cols.timestamp));
+    cols.lambda_optimal = malloc(BATCH * sizeof(*cols.lambda_optimal));
+    cols.capacity = BATCH;
+
+    bench_begin(&b, "raw structs (148 B stride)");
+    scan_result_t s_raw = scan_raw(raw, n);
+    bench_end(&b, n);
+    bench_begin(&b, "archive: cell, time, λ columns");
+    scan_result_t s_col = scan_archive(&a, &cols, false);
+    bench_end(&b, n);
+    bench_begin(&b, "archive: columns + zone map skip");
+    scan_result_t s_zone = scan_archive(&a, &cols, true);
+    bench_end(&b, n);
+    printf("  → %llu matches, mean λ %.4f; zone map read %u of %u blocks\n",
+           (unsigned long long)s_raw.matched,
+           s_raw.matched ? FIXED_TO_FLOAT((fixed_t)(s_raw.lambda_sum / (int64_t)s_raw.matched)) : 0.0,
+           s_zone.blocks_read, a.n_blocks);
+    bool scan_ok = s_raw.matched == s_col.matched && s_raw.lambda_sum == s_col.lambda_sum &&
+                   s_raw.matched == s_zone.matched && s_raw.lambda_sum == s_zone.lambda_sum;
+
+    bench_section("5. Round trip");
+    bool verified = true;
+    for (uint32_t k = 0; k < a.n_blocks; k++) verified = verified && dlt_archive_verify(&a, k);
+    bool arc_ok = got == n && verified &&
+                  memcmp(out, recs, (size_t)n * sizeof(dlt_record_t)) == 0;
+    printf("  archive: %u blocks, checksums %s, %u records %s\n", a.n_blocks,
+           verified ? "ok" : "FAILED", got, arc_ok ? "byte-identical" : "DIFFER");
+    printf("  v2 stream: %s\n", v2_ok ? "byte-identical" : "DIFFERS");
+    printf("  scan results: %s\n", scan_ok ? "identical" : "DIFFER");
+    ok = arc_ok && v2_ok && scan_ok;
+
+    free(cols.cell_id);
+    free(cols.timestamp);
+    free(cols.lambda_optimal);
+    dlt_archive_close(&a);
+    munmap((void*)raw, raw_size);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    uint32_t n = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 1048576u;
+    if (n == 0) n = 1;
+
+    printf("======================================================================\n");
+    printf("COMPACT DLT RECORDS AND COLUMNAR ARCHIVE vs. RAW STRUCT DUMPS\n");
+    printf("======================================================================\n");
+    printf("  %u vessels, %d nodes × %d cells, batches of %d, dataset table %zu B\n",
+           N_VESSELS, N_NODES, NODE_CELLS, BATCH, sizeof(dlt_dataset_table_t));
+
+    dlt_record_t* recs = malloc((size_t)n * sizeof(dlt_record_t));
+    dlt_record_t* out = malloc((size_t)n * sizeof(dlt_record_t));
+    uint8_t* stream = malloc((size_t)n * DLT_V2_MAX_BYTES);
+    if (!recs || !out || !stream) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    memset(out, 0, (size_t)n * sizeof(dlt_record_t));     /* Fault in before timing */
+
+    bool ok = run_variant("SIGNED RECORDS (hash + ed25519 signature)", recs, out, stream, n,
+                          true);
+    ok = run_variant("UNSIGNED RECORDS (hash only)", recs, out, stream, n, false) && ok;
+
+    free(recs);
+    free(out);
+    free(stream);
+    unlink(RAW_PATH);
+    unlink(ARCHIVE_PATH);
+    return ok ? 0 : 1;
+}
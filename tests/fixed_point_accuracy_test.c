@@ -6,19 +6,29 @@
  *   2. Trigonometric LUT accuracy
  *   3. Rotation matrix operations
  *   4. Coordinate transformations
+ *   5. 3D attitude (Euler/quaternion) and renormalization
+ *   6. SE(3) group operations (bit-exact vs. primitive composition)
+ *   7. λ-estimation (SO(3) exp/log, return error, golden search, gather,
+ *      coarse-to-fine pyramid)
+ *   8. Geodesic distance and bearing (vs. double-precision Vincenty)
+ *   9. Streaming JSON pose parser (chunking, number conversion, schema)
  *
  * Compile with:
  *   gcc -o fixed_point_test fixed_point_accuracy_test.c \
  *       ../embedded/se3_math.c ../embedded/trig_tables.c \
- *       -I../embedded -lm -std=c99
+ *       ../embedded/se3_group.c ../embedded/lambda_estimator.c \
+ *       ../embedded/geodesic.c ../embedded/json_parser.c -I../embedded -lm -std=c99
  *
  * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
  * Version: 1.0
  */
 
 #include "../embedded/se3_edge.h"
+#include "../embedded/geodesic.h"
+#include "../embedded/json_parser.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -28,6 +38,8 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+#include "vincenty_ref.h"
+
 /* Test statistics */
 static int tests_passed = 0;
 static int tests_failed = 0;
@@ -312,10 +324,810 @@ void test_se3_poses(void) {
     TEST_ASSERT(pose.timestamp == 1699000000, "se3_pose_from_gps() sets timestamp");
 }
 
+/* ========================================================================
+ * TEST: 3D Attitude (Euler / Quaternion)
+ * ======================================================================== */
+
+static double max_abs_diff_rot(const fixed_t R[9], const double ref[9]) {
+    double max_err = 0.0;
+    for (int i = 0; i < 9; i++) {
+        double err = fabs(FIXED_TO_FLOAT(R[i]) - ref[i]);
+        if (err > max_err) max_err = err;
+    }
+    return max_err;
+}
+
+static void euler_reference(double r, double p, double y, double ref[9]) {
+    double sr = sin(r), cr = cos(r), sp = sin(p), cp = cos(p), sy = sin(y), cy = cos(y);
+    ref[0] = cy * cp; ref[1] = cy * sp * sr - sy * cr; ref[2] = cy * sp * cr + sy * sr;
+    ref[3] = sy * cp; ref[4] = sy * sp * sr + cy * cr; ref[5] = sy * sp * cr - cy * sr;
+    ref[6] = -sp;     ref[7] = cp * sr;                ref[8] = cp * cr;
+}
+
+static double orthogonality_error(const fixed_t R[9]) {
+    double max_err = 0.0;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            double dot = 0.0;
+            for (int k = 0; k < 3; k++) {
+                dot += FIXED_TO_FLOAT(R[i*3 + k]) * FIXED_TO_FLOAT(R[j*3 + k]);
+            }
+            double err = fabs(dot - (i == j ? 1.0 : 0.0));
+            if (err > max_err) max_err = err;
+        }
+    }
+    return max_err;
+}
+
+void test_attitude_rotations(void) {
+    printf("\n[TEST] 3D Attitude (Euler / Quaternion)\n");
+
+    /* Fused sincos matches separate lookups */
+    int sincos_ok = 1;
+    for (uint32_t a = 0; a < 0xFFFF0000u; a += 0x00F00F01u) {
+        fixed_t s, c;
+        SinCos_from_LUT(a, &s, &c);
+        if (s != Sin_from_LUT(a) || c != Cos_from_LUT(a)) sincos_ok = 0;
+    }
+    TEST_ASSERT(sincos_ok, "SinCos_from_LUT() bit-identical to Sin/Cos_from_LUT()");
+
+    /* Zero roll/pitch reproduces the yaw-only path exactly */
+    fixed_t R_yaw[9], R_euler[9];
+    rotation_from_yaw(0x2AAAAAAA, R_yaw);
+    rotation_from_euler(0, 0, 0x2AAAAAAA, R_euler);
+    TEST_ASSERT(memcmp(R_yaw, R_euler, sizeof(R_yaw)) == 0,
+                "rotation_from_euler(0, 0, yaw) == rotation_from_yaw(yaw)");
+
+    se3_pose_t p_gps, p_att;
+    se3_pose_from_gps(FLOAT_TO_FIXED(10.0f), FLOAT_TO_FIXED(20.0f), 0,
+                      FLOAT_TO_FIXED(33.0f), 1699000000, 367123456, &p_gps);
+    se3_pose_from_attitude(FLOAT_TO_FIXED(10.0f), FLOAT_TO_FIXED(20.0f), 0,
+                           0, 0, FLOAT_TO_FIXED(33.0f), 1699000000, 367123456, &p_att);
+    TEST_ASSERT(memcmp(&p_gps, &p_att, sizeof(p_gps)) == 0,
+                "se3_pose_from_attitude() with level attitude == se3_pose_from_gps()");
+
+    /* Random attitudes vs double-precision reference */
+    double max_err = 0.0, max_ortho = 0.0;
+    for (int i = 0; i < 1000; i++) {
+        double r = ((double)rand() / RAND_MAX - 0.5) * 2.0 * M_PI;
+        double p = ((double)rand() / RAND_MAX - 0.5) * M_PI;
+        double y = ((double)rand() / RAND_MAX) * 2.0 * M_PI;
+        fixed_t R[9];
+        double ref[9];
+        rotation_from_euler(degrees_to_angle(FLOAT_TO_FIXED(r * 180.0 / M_PI)),
+                            degrees_to_angle(FLOAT_TO_FIXED(p * 180.0 / M_PI)),
+                            degrees_to_angle(FLOAT_TO_FIXED(y * 180.0 / M_PI)), R);
+        euler_reference(r, p, y, ref);
+        double err = max_abs_diff_rot(R, ref);
+        if (err > max_err) max_err = err;
+        double ortho = orthogonality_error(R);
+        if (ortho > max_ortho) max_ortho = ortho;
+    }
+    printf("    Euler max element error: %.6f, orthogonality error: %.6f\n", max_err, max_ortho);
+    TEST_ASSERT(max_err < 3e-3, "rotation_from_euler() error < 3e-3 (LUT resolution)");
+    TEST_ASSERT(max_ortho < 5e-3, "rotation_from_euler() orthonormal within 5e-3");
+
+    /* Negative angles wrap without loops */
+    TEST_ASSERT(degrees_to_angle(FLOAT_TO_FIXED(-90.0f)) == degrees_to_angle(FLOAT_TO_FIXED(270.0f)),
+                "degrees_to_angle(-90°) == degrees_to_angle(270°)");
+
+    /* Quaternion path agrees with Euler path (yaw 90° about Z) */
+    fixed_t q[4] = { FLOAT_TO_FIXED(0.70710678f), 0, 0, FLOAT_TO_FIXED(0.70710678f) };
+    fixed_t R_q[9];
+    double ref90[9];
+    rotation_from_quaternion(q, R_q);
+    euler_reference(0, 0, M_PI / 2, ref90);
+    TEST_ASSERT(max_abs_diff_rot(R_q, ref90) < 1e-3, "rotation_from_quaternion() 90° yaw");
+
+    /* Non-unit quaternion is implicitly renormalized */
+    fixed_t q_scaled[4] = { FLOAT_TO_FIXED(0.9f * 0.70710678f), 0, 0,
+                            FLOAT_TO_FIXED(0.9f * 0.70710678f) };
+    rotation_from_quaternion(q_scaled, R_q);
+    TEST_ASSERT(max_abs_diff_rot(R_q, ref90) < 1e-3, "Non-unit quaternion yields proper rotation");
+
+    /* Near-zero quaternions: 2/|q|^2 would overflow 16.16 */
+    fixed_t q_tiny[4] = { 300, 0, 0, 300 };                 /* |q|^2 ≈ 2^-14.5 */
+    fixed_t R_ident[9];
+    rotation_identity(R_ident);
+    rotation_from_quaternion(q_tiny, R_q);
+    TEST_ASSERT(memcmp(R_q, R_ident, sizeof(R_q)) == 0, "Near-zero quaternion gives identity");
+    fixed_t q_small[4] = { 400, 0, 0, 400 };                /* Just above the limit */
+    rotation_from_quaternion(q_small, R_q);
+    int bounded = 1;
+    for (int i = 0; i < 9; i++) {
+        if (R_q[i] > 2 * FRACUNIT || R_q[i] < -2 * FRACUNIT) bounded = 0;
+    }
+    TEST_ASSERT(bounded, "Small quaternion above the limit stays bounded");
+
+    /* Batch forms match scalar forms */
+    uint32_t rolls[4] = { 0, 0x10000000, 0x20000000, 0xF0000000 };
+    uint32_t pitches[4] = { 0, 0x08000000, 0xF8000000, 0x04000000 };
+    uint32_t yaws[4] = { 0x40000000, 0x12345678, 0x87654321, 0 };
+    fixed_t batch[4 * 9];
+    rotation_from_euler_batch(rolls, pitches, yaws, 4, batch);
+    int batch_ok = 1;
+    for (int i = 0; i < 4; i++) {
+        fixed_t single[9];
+        rotation_from_euler(rolls[i], pitches[i], yaws[i], single);
+        if (memcmp(single, &batch[i * 9], sizeof(single)) != 0) batch_ok = 0;
+    }
+    TEST_ASSERT(batch_ok, "rotation_from_euler_batch() matches scalar form");
+
+    fixed_t quats[2 * 4] = { FRACUNIT, 0, 0, 0, q[0], q[1], q[2], q[3] };
+    fixed_t qbatch[2 * 9], q_single[9];
+    rotation_from_quaternion_batch(quats, 2, qbatch);
+    rotation_from_quaternion(q, q_single);
+    TEST_ASSERT(qbatch[0] == FRACUNIT && qbatch[4] == FRACUNIT && qbatch[8] == FRACUNIT &&
+                memcmp(&qbatch[9], q_single, sizeof(q_single)) == 0,
+                "rotation_from_quaternion_batch() matches scalar form");
+
+    /* Renormalization bounds drift in long composition chains */
+    fixed_t step[9], chain[9];
+    rotation_from_euler(0x01234567, 0x00ABCDEF, 0x02468ACE, step);
+    rotation_identity(chain);
+    for (int i = 0; i < 500; i++) {
+        rotation_mul(chain, step, chain);
+    }
+    double drift = orthogonality_error(chain);
+    rotation_renormalize(chain);
+    double renorm = orthogonality_error(chain);
+    printf("    500-step chain orthogonality error: %.6f → %.6f after renormalize\n",
+           drift, renorm);
+    TEST_ASSERT(renorm < drift || renorm < 1e-4, "rotation_renormalize() reduces drift");
+    TEST_ASSERT(renorm < 1e-3, "Renormalized chain orthonormal within 1e-3");
+}
+
+/* ========================================================================
+ * TEST: SE(3) Group Operations
+ * ======================================================================== */
+
+/* Reference implementations built only from the existing primitives */
+static void ref_compose(const se3_pose_t* a, const se3_pose_t* b, se3_pose_t* out) {
+    fixed_t t[3];
+    rotation_mul(a->rotation, b->rotation, out->rotation);
+    mat3_mul_vec3(a->rotation, b->translation, t);
+    out->translation[0] = t[0] + a->translation[0];
+    out->translation[1] = t[1] + a->translation[1];
+    out->translation[2] = t[2] + a->translation[2];
+    out->timestamp = b->timestamp;
+    out->mmsi = b->mmsi;
+}
+
+static void ref_transpose(const fixed_t R[9], fixed_t RT[9]) {
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            RT[j*3 + i] = R[i*3 + j];
+}
+
+static void ref_inverse(const se3_pose_t* g, se3_pose_t* out) {
+    fixed_t RT[9], t[3];
+    ref_transpose(g->rotation, RT);
+    mat3_mul_vec3(RT, g->translation, t);
+    memcpy(out->rotation, RT, sizeof(RT));
+    out->translation[0] = -t[0];
+    out->translation[1] = -t[1];
+    out->translation[2] = -t[2];
+    out->timestamp = g->timestamp;
+    out->mmsi = g->mmsi;
+}
+
+static void ref_relative(const se3_pose_t* g1, const se3_pose_t* g2, se3_pose_t* out) {
+    fixed_t R1T[9], d[3];
+    ref_transpose(g1->rotation, R1T);
+    rotation_mul(R1T, g2->rotation, out->rotation);
+    vec3_sub(g2->translation, g1->translation, d);
+    mat3_mul_vec3(R1T, d, out->translation);
+    out->timestamp = g2->timestamp;
+    out->mmsi = g2->mmsi;
+}
+
+static void random_pose(se3_pose_t* p) {
+    rotation_from_euler((uint32_t)rand() * 2654435761u, (uint32_t)rand() * 40503u,
+                        (uint32_t)rand() * 2246822519u, p->rotation);
+    for (int k = 0; k < 3; k++) {
+        p->translation[k] = (fixed_t)((rand() % 20000 - 10000) * (FRACUNIT / 4));
+    }
+    p->timestamp = (uint32_t)rand();
+    p->mmsi = (uint32_t)rand();
+}
+
+void test_se3_group_ops(void) {
+    printf("\n[TEST] SE(3) Group Operations\n");
+
+    enum { N = 500 };
+    static se3_pose_t a[N], b[N], out[N], ref[N];
+    for (int i = 0; i < N; i++) {
+        random_pose(&a[i]);
+        random_pose(&b[i]);
+    }
+
+    int ok = 1;
+    for (int i = 0; i < N; i++) {
+        se3_compose(&a[i], &b[i], &out[i]);
+        ref_compose(&a[i], &b[i], &ref[i]);
+        if (memcmp(&out[i], &ref[i], sizeof(se3_pose_t)) != 0) ok = 0;
+    }
+    TEST_ASSERT(ok, "se3_compose() bit-exact vs. rotation_mul/mat3_mul_vec3");
+
+    ok = 1;
+    for (int i = 0; i < N; i++) {
+        se3_inverse(&a[i], &out[i]);
+        ref_inverse(&a[i], &ref[i]);
+        if (memcmp(&out[i], &ref[i], sizeof(se3_pose_t)) != 0) ok = 0;
+    }
+    TEST_ASSERT(ok, "se3_inverse() bit-exact vs. transpose + mat3_mul_vec3");
+
+    ok = 1;
+    for (int i = 0; i < N; i++) {
+        se3_relative(&a[i], &b[i], &out[i]);
+        ref_relative(&a[i], &b[i], &ref[i]);
+        if (memcmp(&out[i], &ref[i], sizeof(se3_pose_t)) != 0) ok = 0;
+    }
+    TEST_ASSERT(ok, "se3_relative() bit-exact vs. reference");
+
+    /* Aliasing: in-place forms match out-of-place */
+    ok = 1;
+    for (int i = 0; i < N; i++) {
+        se3_pose_t acc = a[i], inv = a[i], expect;
+        se3_compose(&a[i], &b[i], &expect);
+        se3_compose_inplace(&acc, &b[i]);
+        if (memcmp(&acc, &expect, sizeof(acc)) != 0) ok = 0;
+        se3_inverse(&a[i], &expect);
+        se3_inverse_inplace(&inv);
+        if (memcmp(&inv, &expect, sizeof(inv)) != 0) ok = 0;
+    }
+    TEST_ASSERT(ok, "In-place compose/inverse match out-of-place");
+
+    /* Batch forms match scalar forms */
+    se3_compose_batch(a, b, N, out);
+    ok = 1;
+    for (int i = 0; i < N; i++) {
+        ref_compose(&a[i], &b[i], &ref[i]);
+        if (memcmp(&out[i], &ref[i], sizeof(se3_pose_t)) != 0) ok = 0;
+    }
+    TEST_ASSERT(ok, "se3_compose_batch() matches scalar form");
+
+    se3_inverse_batch(a, N, out);
+    ok = 1;
+    for (int i = 0; i < N; i++) {
+        ref_inverse(&a[i], &ref[i]);
+        if (memcmp(&out[i], &ref[i], sizeof(se3_pose_t)) != 0) ok = 0;
+    }
+    TEST_ASSERT(ok, "se3_inverse_batch() matches scalar form");
+
+    se3_relative_batch(a, N, out);
+    ok = 1;
+    for (int i = 0; i + 1 < N; i++) {
+        ref_relative(&a[i], &a[i + 1], &ref[i]);
+        if (memcmp(&out[i], &ref[i], sizeof(se3_pose_t)) != 0) ok = 0;
+    }
+    TEST_ASSERT(ok, "se3_relative_batch() yields consecutive increments");
+
+    /* Trajectory composition matches repeated reference compose */
+    se3_pose_t total, total_ref;
+    se3_compose_trajectory(a, 8, &total);
+    total_ref = a[0];
+    for (int i = 1; i < 8; i++) {
+        se3_pose_t step;
+        ref_compose(&total_ref, &a[i], &step);
+        total_ref = step;
+    }
+    TEST_ASSERT(memcmp(&total, &total_ref, sizeof(total)) == 0,
+                "se3_compose_trajectory() bit-exact vs. reference fold");
+    se3_compose_trajectory(a, 0, &total);
+    TEST_ASSERT(total.rotation[0] == FRACUNIT && total.translation[0] == 0,
+                "Empty trajectory composes to identity");
+
+    /* Group property: g * g^-1 ≈ identity */
+    se3_pose_t inv, id;
+    se3_inverse(&a[0], &inv);
+    se3_compose(&a[0], &inv, &id);
+    float max_err = 0.0f;
+    for (int k = 0; k < 9; k++) {
+        float e = fabsf(FIXED_TO_FLOAT(id.rotation[k]) - ((k % 4 == 0) ? 1.0f : 0.0f));
+        if (e > max_err) max_err = e;
+    }
+    TEST_ASSERT(max_err < 1e-3f, "g * g^-1 rotation ≈ identity");
+    TEST_ASSERT(fabsf(FIXED_TO_FLOAT(id.translation[0])) < 5.0f &&
+                fabsf(FIXED_TO_FLOAT(id.translation[1])) < 5.0f,
+                "g * g^-1 translation ≈ 0 (km-scale pose)");
+
+    /* Point transform agrees with mat3_mul_vec3 + t */
+    fixed_t pts[6] = { FRACUNIT, 0, 0, 0, 2 * FRACUNIT, -FRACUNIT };
+    fixed_t tp[6];
+    se3_transform_points(&a[1], pts, 2, tp);
+    ok = 1;
+    for (int i = 0; i < 2; i++) {
+        fixed_t r[3];
+        mat3_mul_vec3(a[1].rotation, &pts[i * 3], r);
+        for (int k = 0; k < 3; k++) {
+            if (tp[i * 3 + k] != r[k] + a[1].translation[k]) ok = 0;
+        }
+    }
+    TEST_ASSERT(ok, "se3_transform_points() bit-exact vs. mat3_mul_vec3 + t");
+}
+
 /* ========================================================================
  * MAIN TEST RUNNER
  * ======================================================================== */
 
+/* ========================================================================
+ * TEST: λ-Estimation
+ * ======================================================================== */
+
+/* Double-precision Rodrigues reference */
+static void ref_so3_exp(const double w[3], double R[9]) {
+    double th = sqrt(w[0]*w[0] + w[1]*w[1] + w[2]*w[2]);
+    double A = (th < 1e-9) ? 1.0 : sin(th) / th;
+    double B = (th < 1e-9) ? 0.5 : (1.0 - cos(th)) / (th * th);
+    double x = w[0], y = w[1], z = w[2];
+    R[0] = 1 - B*(y*y + z*z); R[1] = -A*z + B*x*y;     R[2] = A*y + B*x*z;
+    R[3] = A*z + B*x*y;       R[4] = 1 - B*(x*x + z*z); R[5] = -A*x + B*y*z;
+    R[6] = -A*y + B*x*z;      R[7] = A*x + B*y*z;       R[8] = 1 - B*(x*x + y*y);
+}
+
+static void ref_so3_log(const double R[9], double w[3]) {
+    double c = (R[0] + R[4] + R[8] - 1.0) / 2.0;
+    if (c > 1.0) c = 1.0;
+    if (c < -1.0) c = -1.0;
+    double th = acos(c);
+    double f = (th < 1e-9) ? 0.5 : th / (2.0 * sin(th));
+    w[0] = (R[7] - R[5]) * f;
+    w[1] = (R[2] - R[6]) * f;
+    w[2] = (R[3] - R[1]) * f;
+}
+
+/* Reference ε(λ): scale each step, compose, double, Frobenius + norm */
+static double ref_return_error(const se3_pose_t* steps, int n, double lambda) {
+    double R[9] = {1,0,0, 0,1,0, 0,0,1}, t[3] = {0, 0, 0};
+    for (int i = 0; i < n; i++) {
+        double Ri[9], wi[3], Rs[9], ts[3], Rn[9];
+        for (int k = 0; k < 9; k++) Ri[k] = FIXED_TO_FLOAT(steps[i].rotation[k]);
+        ref_so3_log(Ri, wi);
+        for (int k = 0; k < 3; k++) wi[k] *= lambda;
+        ref_so3_exp(wi, Rs);
+        for (int k = 0; k < 3; k++) ts[k] = FIXED_TO_FLOAT(steps[i].translation[k]) * lambda;
+        for (int r = 0; r < 3; r++) {
+            t[r] += R[r*3]*ts[0] + R[r*3+1]*ts[1] + R[r*3+2]*ts[2];
+            for (int c = 0; c < 3; c++) {
+                Rn[r*3+c] = R[r*3]*Rs[c] + R[r*3+1]*Rs[3+c] + R[r*3+2]*Rs[6+c];
+            }
+        }
+        memcpy(R, Rn, sizeof(R));
+    }
+    double R2[9], t2[3], rot = 0, tr = 0;
+    for (int r = 0; r < 3; r++) {
+        t2[r] = R[r*3]*t[0] + R[r*3+1]*t[1] + R[r*3+2]*t[2] + t[r];
+        for (int c = 0; c < 3; c++) {
+            R2[r*3+c] = R[r*3]*R[c] + R[r*3+1]*R[3+c] + R[r*3+2]*R[6+c];
+            double d = R2[r*3+c] - (r == c ? 1.0 : 0.0);
+            rot += d * d;
+        }
+        tr += t2[r] * t2[r];
+    }
+    return sqrt(rot) + sqrt(tr);
+}
+
+/* Closed loop: n steps of (yaw 2π/n, forward 'stride' m) returns home */
+static void make_loop_steps(se3_pose_t* steps, int n, double stride) {
+    for (int i = 0; i < n; i++) {
+        double w[3] = {0, 0, 2.0 * M_PI / n}, R[9];
+        ref_so3_exp(w, R);
+        for (int k = 0; k < 9; k++) steps[i].rotation[k] = FLOAT_TO_FIXED(R[k]);
+        steps[i].translation[0] = FLOAT_TO_FIXED(stride);
+        steps[i].translation[1] = 0;
+        steps[i].translation[2] = 0;
+        steps[i].timestamp = 1000 + i;
+        steps[i].mmsi = 367000001;
+    }
+}
+
+void test_lambda_estimation(void) {
+    printf("\n[TEST] λ-Estimation (lambda_estimator.c)\n");
+
+    /* Roots and atan2 */
+    TEST_ASSERT(fixed_sqrt(INT_TO_FIXED(9)) == INT_TO_FIXED(3), "fixed_sqrt(9) = 3 exactly");
+    double max_atan = 0.0;
+    for (int i = 0; i < 1000; i++) {
+        double a = (rand() / (double)RAND_MAX) * 2.0 * M_PI - M_PI;
+        double r = 0.01 + (rand() / (double)RAND_MAX) * 100.0;
+        uint32_t ang = fixed_atan2(FLOAT_TO_FIXED(r * sin(a)), FLOAT_TO_FIXED(r * cos(a)));
+        double got = (int32_t)ang * (M_PI / 2147483648.0);
+        double d = fabs(got - a);
+        if (d > M_PI) d = 2.0 * M_PI - d;
+        if (d > max_atan) max_atan = d;
+    }
+    printf("    fixed_atan2 max error: %.2e rad\n", max_atan);
+    TEST_ASSERT(max_atan < 1e-3, "fixed_atan2 within 1e-3 rad over 1000 random points");
+
+    /* exp vs reference, log(exp(w)) round trip, including near π */
+    double max_exp = 0.0, max_log = 0.0;
+    for (int i = 0; i < 1000; i++) {
+        double w[3], ref[9];
+        double th = (i % 10 == 0) ? 3.10 : (rand() / (double)RAND_MAX) * 3.0;
+        double ax = rand() / (double)RAND_MAX - 0.5, ay = rand() / (double)RAND_MAX - 0.5;
+        double az = rand() / (double)RAND_MAX - 0.5;
+        double an = sqrt(ax*ax + ay*ay + az*az) + 1e-12;
+        w[0] = ax / an * th; w[1] = ay / an * th; w[2] = az / an * th;
+        ref_so3_exp(w, ref);
+
+        fixed_t wf[3] = { FLOAT_TO_FIXED(w[0]), FLOAT_TO_FIXED(w[1]), FLOAT_TO_FIXED(w[2]) };
+        fixed_t R[9], back[3];
+        so3_exp(wf, R);
+        double d = max_abs_diff_rot(R, ref);
+        if (d > max_exp) max_exp = d;
+
+        so3_log(R, back);
+        for (int k = 0; k < 3; k++) {
+            d = fabs(FIXED_TO_FLOAT(back[k]) - w[k]);
+            if (d > max_log) max_log = d;
+        }
+    }
+    printf("    so3_exp max error: %.2e, log(exp(w)) max error: %.2e rad\n", max_exp, max_log);
+    TEST_ASSERT(max_exp < 1e-3, "so3_exp matches double Rodrigues within 1e-3");
+    TEST_ASSERT(max_log < 5e-3, "so3_log(so3_exp(w)) round trip within 5e-3 rad (incl. near π)");
+
+    fixed_t R_id[9], w_id[3];
+    rotation_identity(R_id);
+    so3_log(R_id, w_id);
+    TEST_ASSERT(w_id[0] == 0 && w_id[1] == 0 && w_id[2] == 0, "so3_log(I) = 0");
+
+    /* Return error vs double reference on a perturbed loop */
+    static se3_pose_t steps[64];
+    make_loop_steps(steps, 64, 25.0);
+    for (int i = 0; i < 64; i++) {
+        steps[i].translation[1] = FLOAT_TO_FIXED((rand() % 200 - 100) / 100.0);
+    }
+    double max_rel = 0.0;
+    const double lambdas[4] = { 0.3, 0.8, 1.2, 1.7 };
+    for (int j = 0; j < 4; j++) {
+        double ref = ref_return_error(steps, 64, lambdas[j]);
+        double got = FIXED_TO_FLOAT(compute_return_error(steps, 64, FLOAT_TO_FIXED(lambdas[j])));
+        double rel = fabs(got - ref) / ref;
+        if (rel > max_rel) max_rel = rel;
+    }
+    printf("    compute_return_error max relative error: %.2e\n", max_rel);
+    TEST_ASSERT(max_rel < 0.01, "compute_return_error within 1% of double reference");
+    double at_one = FIXED_TO_FLOAT(compute_return_error(steps, 64, FRACUNIT));
+    printf("    ε(1) = %.3f (reference %.3f) on a 3.2 km doubled path\n",
+           at_one, ref_return_error(steps, 64, 1.0));
+    TEST_ASSERT(fabs(at_one - ref_return_error(steps, 64, 1.0)) < 4.0,
+                "ε(1) within 4 m of reference (128 quantized steps)");
+
+    /* Closed loop: G_λ² = I at λ ∈ {0.5, 1, 1.5} (arc fraction 2λ) */
+    make_loop_steps(steps, 64, 25.0);
+    fixed_t lam = fast_lambda_estimate(steps, 64, LAMBDA_EPSILON, LAMBDA_MAX_ITER);
+    double lam_f = FIXED_TO_FLOAT(lam);
+    printf("    λ* for closed 64-step loop: %.4f\n", lam_f);
+    TEST_ASSERT(fabs(lam_f * 2.0 - floor(lam_f * 2.0 + 0.5)) < 0.02,
+                "fast_lambda_estimate finds a return point (λ ≈ k/2) on closed loop");
+
+    /* Workspace path is bit-identical to the direct path */
+    static lambda_workspace_t ws;
+    lambda_ws_load_steps(&ws, steps, 64);
+    fixed_t err_ws = lambda_ws_return_error(&ws, FLOAT_TO_FIXED(0.8f));
+    fixed_t err_direct = compute_return_error(steps, 64, FLOAT_TO_FIXED(0.8f));
+    TEST_ASSERT(err_ws == err_direct, "lambda_ws_return_error == compute_return_error (bit-exact)");
+    fixed_t err_est;
+    TEST_ASSERT(lambda_ws_estimate(&ws, LAMBDA_EPSILON, LAMBDA_MAX_ITER, &err_est) == lam,
+                "lambda_ws_estimate == fast_lambda_estimate (bit-exact)");
+
+    /* Coarse-to-fine: no coarse level reproduces the full search exactly */
+    static lambda_pyramid_t pyr;
+    uint32_t mults_full, mults_pyr;
+    TEST_ASSERT(lambda_pyramid_build(&pyr, &ws, 0) == 0, "Pyramid with max_levels 0 has no coarse level");
+    TEST_ASSERT(lambda_pyramid_estimate(&pyr, LAMBDA_EPSILON, LAMBDA_MAX_ITER, NULL, &mults_full) == lam,
+                "lambda_pyramid_estimate without coarse level == lambda_ws_estimate (bit-exact)");
+    TEST_ASSERT(mults_full == (LAMBDA_MAX_ITER + 2) * 65,
+                "Full search costs (iterations + 2) × (n + 1) pose multiplies");
+    int levels = lambda_pyramid_build(&pyr, &ws, LAMBDA_PYRAMID_LEVELS);
+    TEST_ASSERT(levels == 3 && pyr.n == 8, "64-step loop coarsens to 8 blocks of 8 steps");
+    fixed_t lam_pyr = lambda_pyramid_estimate(&pyr, LAMBDA_EPSILON, LAMBDA_MAX_ITER, NULL, &mults_pyr);
+    printf("    coarse-to-fine λ* = %.4f (full %.4f), %u vs. %u pose multiplies\n",
+           FIXED_TO_FLOAT(lam_pyr), lam_f, mults_pyr, mults_full);
+    TEST_ASSERT(fabs(FIXED_TO_FLOAT(lam_pyr) - lam_f) < 0.005,
+                "Coarse-to-fine λ* within 0.005 of the full search on closed loop");
+    TEST_ASSERT(mults_pyr * 2 < mults_full, "Coarse-to-fine uses under half the pose multiplies");
+
+    /* Coarsening stops before a block can turn past π/2 or overflow */
+    static se3_pose_t sharp[16];
+    make_loop_steps(sharp, 16, 25.0);
+    lambda_ws_load_steps(&ws, sharp, 16);
+    levels = lambda_pyramid_build(&pyr, &ws, LAMBDA_PYRAMID_LEVELS);
+    TEST_ASSERT(levels == 1, "22.5° steps: pairs (45°) only, quads would pass the turn limit");
+    make_loop_steps(sharp, 16, 25.0);
+    for (int i = 0; i < 16; i++) sharp[i].translation[0] = INT_TO_FIXED(20000);
+    lambda_ws_load_steps(&ws, sharp, 16);
+    TEST_ASSERT(lambda_pyramid_build(&pyr, &ws, LAMBDA_PYRAMID_LEVELS) == 0,
+                "20 km steps: pairs could overflow 16.16, no coarse level");
+
+    /* Track loading: absolute fixes via index list == contiguous fixes */
+    static se3_pose_t fixes[65], shuffled[65];
+    static lambda_workspace_t ws_contig, ws_gather;
+    uint16_t index[65];
+    se3_pose_identity(&fixes[0]);
+    for (int i = 0; i < 64; i++) {
+        se3_compose(&fixes[i], &steps[i], &fixes[i + 1]);
+    }
+    for (int i = 0; i < 65; i++) {
+        int slot = (i * 37) % 65;       /* 37 coprime to 65: a permutation */
+        shuffled[slot] = fixes[i];
+        index[i] = (uint16_t)slot;
+    }
+    int n_contig = lambda_ws_load_track(&ws_contig, fixes, NULL, 65);
+    int n_gather = lambda_ws_load_track(&ws_gather, shuffled, index, 65);
+    TEST_ASSERT(n_contig == 64 && n_gather == 64, "65 fixes load as 64 relative steps");
+    TEST_ASSERT(memcmp(ws_contig.w, ws_gather.w, sizeof(fixed_t) * 3 * 64) == 0 &&
+                memcmp(ws_contig.t, ws_gather.t, sizeof(fixed_t) * 3 * 64) == 0,
+                "Gathered track loads identically to contiguous fixes");
+    fixed_t lam_track = lambda_ws_estimate(&ws_gather, LAMBDA_EPSILON, LAMBDA_MAX_ITER, NULL);
+    TEST_ASSERT(fabs(FIXED_TO_FLOAT(lam_track) - lam_f) < 0.02,
+                "Estimate from absolute fixes matches estimate from steps");
+}
+
+/* ========================================================================
+ * TEST: Geodesic Distance and Bearing
+ * ======================================================================== */
+
+static double bearing_deg(uint32_t angle) {
+    return angle * (360.0 / 4294967296.0);
+}
+
+void test_geodesic(void) {
+    printf("\n[TEST] Geodesic Distance and Bearing (geodesic.c)\n");
+
+    /* Q30 sine/cosine */
+    double max_sc = 0.0;
+    for (uint64_t a = 0; a < ((uint64_t)1 << 32); a += 1000003) {
+        int32_t s, c;
+        geo_sincos_q30((uint32_t)a, &s, &c);
+        double x = a * (2.0 * M_PI / 4294967296.0);
+        double e = fmax(fabs(s / 1073741824.0 - sin(x)), fabs(c / 1073741824.0 - cos(x)));
+        if (e > max_sc) max_sc = e;
+    }
+    printf("    geo_sincos_q30 max error: %.2e\n", max_sc);
+    TEST_ASSERT(max_sc < 4e-9, "geo_sincos_q30 within 4e-9 over the full circle");
+
+    /* Known values: 1° of longitude on the equator, 1° of latitude at 45° */
+    uint32_t brg;
+    uint32_t d = geo_distance(0, 0, 0, INT_TO_FIXED(1), &brg);
+    TEST_ASSERT(d >= 111319 && d <= 111320, "1° of longitude on the equator = 111,319.5 m");
+    TEST_ASSERT(fabs(bearing_deg(brg) - 90.0) < 0.001, "Due east has bearing 90°");
+    d = geo_distance(INT_TO_FIXED(45), INT_TO_FIXED(10), INT_TO_FIXED(46), INT_TO_FIXED(10), &brg);
+    TEST_ASSERT(d >= 111141 && d <= 111142 && brg < 0x10000u,
+                "45°→46° N along a meridian = 111,141.5 m, bearing 0°");
+    TEST_ASSERT(geo_distance(INT_TO_FIXED(60), INT_TO_FIXED(5), INT_TO_FIXED(60), INT_TO_FIXED(5), NULL) == 0,
+                "Coincident points are 0 m apart");
+
+    /* Across the pole: a 2 km hop spanning 180° of longitude */
+    d = geo_distance(FLOAT_TO_FIXED(89.99f), 0, FLOAT_TO_FIXED(89.99f), INT_TO_FIXED(180), NULL);
+    TEST_ASSERT(d >= 2235 && d <= 2237, "89.99°N, 0° → 89.99°N, 180° crosses the pole: 2,236 m");
+
+    /* Dateline: 179.9°E → 179.9°W is 0.2° east, not 359.8° west */
+    d = geo_distance(0, FLOAT_TO_FIXED(179.9f), 0, FLOAT_TO_FIXED(-179.9f), &brg);
+    TEST_ASSERT(d > 22200 && d < 22300 && fabs(bearing_deg(brg) - 90.0) < 0.01,
+                "Dateline crossing takes the short way east");
+
+    /* Random pairs from 100 m to 15,000 km vs. Vincenty */
+    double max_excess = 0.0, max_brg = 0.0, max_short = 0.0;
+    for (int i = 0; i < 3000; i++) {
+        double lat1 = (rand() / (double)RAND_MAX) * 170.0 - 85.0;
+        double lon1 = (rand() / (double)RAND_MAX) * 360.0 - 180.0;
+        double range = pow(10.0, 2.0 + (rand() / (double)RAND_MAX) * 5.17) / 111320.0;
+        double az = (rand() / (double)RAND_MAX) * 2.0 * M_PI;
+        double lat2 = lat1 + range * cos(az);
+        double lon2 = lon1 + range * sin(az) / fmax(cos(lat1 * M_PI / 180.0), 0.05);
+        if (lat2 > 89.0 || lat2 < -89.0) continue;
+        if (lon2 > 180.0) lon2 -= 360.0;
+        if (lon2 < -180.0) lon2 += 360.0;
+        fixed_t a1 = FLOAT_TO_FIXED(lat1), o1 = FLOAT_TO_FIXED(lon1);
+        fixed_t a2 = FLOAT_TO_FIXED(lat2), o2 = FLOAT_TO_FIXED(lon2);
+        double ref, ref_az;
+        if (!vincenty_inverse(a1 / 65536.0, o1 / 65536.0, a2 / 65536.0, o2 / 65536.0, &ref, &ref_az)) {
+            continue;
+        }
+        double got = geo_distance(a1, o1, a2, o2, &brg);
+        double excess = fabs(got - ref) - (2.5 + 5e-6 * ref);   /* Allowed: 2.5 m + 5 ppm */
+        if (excess > max_excess) max_excess = excess;
+        if (ref > 1000.0) {
+            double b = fabs(bearing_deg(brg) - ref_az);
+            if (b > 180.0) b = 360.0 - b;
+            if (b > max_brg) max_brg = b;
+        }
+        if (ref < GEO_SHORT_RANGE_M && fabs(got - ref) > max_short) max_short = fabs(got - ref);
+    }
+    printf("    max bearing error beyond 1 km: %.4f°, max short-range error: %.2f m\n",
+           max_brg, max_short);
+    TEST_ASSERT(max_excess <= 0.0, "Distance within 2.5 m + 5 ppm of Vincenty, 100 m - 15,000 km");
+    TEST_ASSERT(max_short < 2.5, "Equirectangular path within 2.5 m below the crossover");
+    TEST_ASSERT(max_brg < 0.02, "Initial bearing within 0.02° of Vincenty beyond 1 km");
+
+    /* Batch forms are the single call, bit for bit */
+    fixed_t la[8], lo[8], la0[8], lo0[8];
+    uint32_t bd[8], bb[8], fd[8], fb[8];
+    for (int i = 0; i < 8; i++) {
+        la0[i] = FLOAT_TO_FIXED(52.0f);
+        lo0[i] = FLOAT_TO_FIXED(4.0f);
+        la[i] = FLOAT_TO_FIXED(52.0f + 0.01f * i * i * i);     /* 0 m to ~4,000 km */
+        lo[i] = FLOAT_TO_FIXED(4.0f - 0.02f * i * i * i);
+    }
+    geo_distance_batch(la0, lo0, la, lo, 8, bd, bb);
+    geo_distance_from(la0[0], lo0[0], la, lo, 8, fd, fb);
+    bool same = true;
+    for (int i = 0; i < 8; i++) {
+        uint32_t b1;
+        uint32_t d1 = geo_distance(la0[i], lo0[i], la[i], lo[i], &b1);
+        same &= bd[i] == d1 && bb[i] == b1 && fd[i] == d1 && fb[i] == b1;
+    }
+    TEST_ASSERT(same, "geo_distance_batch / geo_distance_from match single calls");
+}
+
+/* ========================================================================
+ * TEST: Streaming JSON Pose Parser
+ * ======================================================================== */
+
+typedef struct {
+    se3_pose_t poses[64];
+    uint32_t traj[64];
+    int n;
+} json_sink_t;
+
+static void json_collect(void* ctx, const se3_pose_t* pose, uint32_t trajectory) {
+    json_sink_t* sink = (json_sink_t*)ctx;
+    if (sink->n < 64) {
+        sink->poses[sink->n] = *pose;
+        sink->traj[sink->n] = trajectory;
+    }
+    sink->n++;
+}
+
+static int json_parse_str(const char* text, json_sink_t* sink) {
+    memset(sink, 0, sizeof(*sink));
+    return json_pose_parse(text, strlen(text), json_collect, sink);
+}
+
+/* Parse in chunks of the given size (0 = random 1-16 bytes) */
+static int json_parse_chunked(const char* text, size_t chunk, json_sink_t* sink) {
+    json_pose_parser_t p;
+    memset(sink, 0, sizeof(*sink));
+    json_pose_init(&p, json_collect, sink);
+    size_t len = strlen(text), off = 0;
+    while (off < len) {
+        size_t n = chunk ? chunk : 1 + (size_t)(rand() % 16);
+        if (n > len - off) n = len - off;
+        int err = json_pose_feed(&p, text + off, n);
+        if (err != JSON_POSE_OK) return err;
+        off += n;
+    }
+    return json_pose_finish(&p);
+}
+
+void test_json_parser(void) {
+    printf("\n[TEST] Streaming JSON Pose Parser\n");
+    json_sink_t a, b;
+
+    /* Metrics request as the science API documents it */
+    const char* request =
+        "{\"trajectory_data\": {\n"
+        "  \"poses\": [\n"
+        "    {\"rotation\": [0.1, 0, 0], \"translation\": [0.5, 0, 0]},\n"
+        "    {\"rotation\": [0, 0.1, 0], \"translation\": [0, 0.5, 0]}\n"
+        "  ]},\n"
+        " \"options\": {\"enable_resonance_detection\": true, \"r_max\": 1.0,\n"
+        "             \"lambda_bounds\": [0.1, 2.0], \"note\": \"a \\\"quoted\\\" \\u00e9\"}}";
+    TEST_ASSERT(json_parse_str(request, &a) == JSON_POSE_OK && a.n == 2,
+                "Metrics request: 2 poses, options skipped");
+    fixed_t w[3] = { 6554, 0, 0 }, R[9];        /* 0.1 rad, rounded */
+    so3_exp(w, R);
+    TEST_ASSERT(memcmp(a.poses[0].rotation, R, sizeof(R)) == 0 &&
+                a.poses[0].translation[0] == FRACUNIT / 2 && a.poses[1].translation[1] == FRACUNIT / 2,
+                "Rotation vector mapped with so3_exp, translation in 16.16 meters");
+
+    /* Every split point gives the same poses as one buffer */
+    bool same = true;
+    for (size_t chunk = 1; chunk <= 7 && same; chunk++) {
+        same = json_parse_chunked(request, chunk, &b) == JSON_POSE_OK && b.n == a.n &&
+               memcmp(a.poses, b.poses, sizeof(se3_pose_t) * (size_t)a.n) == 0;
+    }
+    for (int t = 0; t < 50 && same; t++) {
+        same = json_parse_chunked(request, 0, &b) == JSON_POSE_OK && b.n == a.n &&
+               memcmp(a.poses, b.poses, sizeof(se3_pose_t) * (size_t)a.n) == 0;
+    }
+    TEST_ASSERT(same, "Byte-at-a-time and random chunking resume bit-exact");
+
+    /* Matrix forms, timestamp/mmsi, batch + NDJSON trajectory indices */
+    const char* batch =
+        "{\"trajectories\": [\n"
+        " {\"poses\": [{\"rotation\": [1,0,0, 0,1,0, 0,0,1], \"translation\": [1e3, -2.5E+1, 0.0],\n"
+        "              \"timestamp\": 1700000000, \"mmsi\": 366123456.0}]},\n"
+        " {\"poses\": [{\"mmsi\": 7, \"rotation\": [[0,-1,0],[1,0,0],[0,0,1]],\n"
+        "              \"translation\": [-32768, 32767.5, 1.52587890625e-5]}]}]}\n"
+        "{\"poses\": [{\"rotation\": [0,0,0], \"translation\": [0,0,0]}]}\n";
+    int err = json_parse_str(batch, &a);
+    TEST_ASSERT(err == JSON_POSE_OK && a.n == 3 && a.traj[0] == 0 && a.traj[1] == 1 && a.traj[2] == 2,
+                "Batch and NDJSON: one trajectory index per \"poses\" array");
+    TEST_ASSERT(a.poses[0].rotation[0] == FRACUNIT && a.poses[0].rotation[4] == FRACUNIT &&
+                a.poses[0].translation[0] == INT_TO_FIXED(1000) &&
+                a.poses[0].translation[1] == -INT_TO_FIXED(25) &&
+                a.poses[0].timestamp == 1700000000u && a.poses[0].mmsi == 366123456u,
+                "Flat 3x3 rotation, exponents, integer timestamp/mmsi");
+    TEST_ASSERT(a.poses[1].rotation[1] == -FRACUNIT && a.poses[1].rotation[3] == FRACUNIT &&
+                a.poses[1].translation[0] == INT32_MIN &&
+                a.poses[1].translation[1] == INT_TO_FIXED(32767) + FRACUNIT / 2 &&
+                a.poses[1].translation[2] == 1 && a.poses[1].mmsi == 7,
+                "Nested rows, full 16.16 range, 1 LSB fraction");
+
+    /* Decimal → 16.16 is round-to-nearest against a double reference */
+    int mismatches = 0;
+    char text[512];
+    for (int t = 0; t < 2000; t++) {
+        double v[3];
+        int len = snprintf(text, sizeof(text), "{\"poses\":[{\"rotation\":[0,0,0],\"translation\":[");
+        for (int k = 0; k < 3; k++) {
+            v[k] = ((rand() / (double)RAND_MAX) * 2.0 - 1.0) * pow(10.0, rand() % 9 - 4);
+            len += snprintf(text + len, sizeof(text) - (size_t)len, k ? ",%.*g" : "%.*g",
+                            1 + rand() % 11, v[k]);
+        }
+        snprintf(text + len, sizeof(text) - (size_t)len, "]}]}");
+        if (json_parse_str(text, &a) != JSON_POSE_OK || a.n != 1) {
+            mismatches++;
+            continue;
+        }
+        /* Re-read the printed digits, as the parser saw them */
+        const char* q = strstr(text, "translation\":[") + 14;
+        for (int k = 0; k < 3; k++) {
+            char* next;
+            double d = strtod(q, &next);
+            if (a.poses[0].translation[k] != (fixed_t)llround(d * 65536.0)) mismatches++;
+            q = next + 1;
+        }
+    }
+    TEST_ASSERT(mismatches == 0, "2,000 random decimals convert exactly (round-to-nearest)");
+
+    /* Errors are reported, sticky, and located */
+    TEST_ASSERT(json_parse_str("{\"poses\" [", &a) == JSON_POSE_ERR_SYNTAX, "Missing colon: syntax error");
+    TEST_ASSERT(json_parse_str("{\"poses\":[{\"rotation\":[0,0,0],\"translation\":[1,2]}]}", &a) ==
+                JSON_POSE_ERR_SCHEMA && a.n == 0, "Short translation: schema error, no pose");
+    TEST_ASSERT(json_parse_str("{\"poses\":[{\"rotation\":[0,0,0]}]}", &a) == JSON_POSE_ERR_SCHEMA,
+                "Missing translation: schema error");
+    TEST_ASSERT(json_parse_str("{\"poses\":[{\"rotation\":[[1,0,0],[0,1]],\"translation\":[0,0,0]}]}",
+                               &a) == JSON_POSE_ERR_SCHEMA, "Short rotation row: schema error");
+    TEST_ASSERT(json_parse_str("{\"poses\":[{\"rotation\":[0,0,0],\"translation\":[40000,0,0]}]}",
+                               &a) == JSON_POSE_ERR_RANGE, "Translation beyond 16.16: range error");
+    TEST_ASSERT(json_parse_str("{\"poses\":[{\"rotation\":[0,0,0],\"translation\":[0,0,0],"
+                               "\"mmsi\":4294967296}]}", &a) == JSON_POSE_ERR_RANGE,
+                "MMSI beyond uint32: range error");
+    TEST_ASSERT(json_parse_str("{\"poses\":[{\"rotation\":[0,0,0],\"translation\":[0,0,0],"
+                               "\"timestamp\":18446744074000000000}]}", &a) == JSON_POSE_ERR_RANGE,
+                "Timestamp wrapping 2^64 when scaled: range error");
+    TEST_ASSERT(json_parse_str("{\"poses\":[{\"rotation\":[0,0,0],\"translation\":[0,0,0],"
+                               "\"timestamp\":18446744074e9}]}", &a) == JSON_POSE_ERR_RANGE,
+                "Timestamp with exponent wrapping 2^64: range error");
+    TEST_ASSERT(json_parse_str("{\"poses\":[{\"rotation\":[0,0,0],\"translation\":[01,0,0]}]}",
+                               &a) == JSON_POSE_ERR_SYNTAX, "Leading zero: syntax error");
+    TEST_ASSERT(json_parse_str("{\"poses\":[{\"rotation\":[0,0,0],\"translation\":[0,0,0]}", &a) ==
+                JSON_POSE_ERR_TRUNCATED && a.n == 1,
+                "Truncated stream: poses before the cut delivered, finish() reports it");
+
+    memset(text, '[', 70);
+    memcpy(text + 70, "1", 2);
+    TEST_ASSERT(json_parse_str(text, &a) == JSON_POSE_ERR_DEPTH, "Nesting beyond the limit: depth error");
+
+    json_pose_parser_t p;
+    const char* bad = "{\"poses\": [{\"rotation\": [0,0,0], \"translation\": [0, 0, x]}]}";
+    json_pose_init(&p, json_collect, &a);
+    err = json_pose_feed(&p, bad, 30);
+    err = err == JSON_POSE_OK ? json_pose_feed(&p, bad + 30, strlen(bad) - 30) : err;
+    TEST_ASSERT(err == JSON_POSE_ERR_SYNTAX && p.offset == (uint64_t)(strchr(bad, 'x') - bad) &&
+                json_pose_feed(&p, "{}", 2) == JSON_POSE_ERR_SYNTAX,
+                "Error offset points at the bad byte; the error is sticky");
+
+    TEST_ASSERT(json_parse_str("{\"po\\u0073es\":[1,2], \"poses_x\":[{}], \"x\":{\"poses\":[]}}", &a) ==
+                JSON_POSE_OK && a.n == 0,
+                "Escaped and look-alike keys are not schema keys; empty poses array ok");
+    printf("    sizeof(json_pose_parser_t) = %zu bytes\n", sizeof(json_pose_parser_t));
+}
+
 int main(void) {
     srand(time(NULL));
 
@@ -336,6 +1148,11 @@ int main(void) {
     test_geodetic_utils();
     test_vector_ops();
     test_se3_poses();
+    test_attitude_rotations();
+    test_se3_group_ops();
+    test_lambda_estimation();
+    test_geodesic();
+    test_json_parser();
 
     /* Summary */
     printf("\n======================================================================\n");
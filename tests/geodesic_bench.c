@@ -0,0 +1,194 @@
+/*
+ * geodesic_bench.c - Accuracy and Throughput of the Fixed-Point Geodesic Kernels
+ *
+ * Error vs. double-precision Vincenty (vincenty_ref.h) for random pairs in
+ * range bands from 100 m to 15,000 km, at all latitudes (|φ| < 80°) and at
+ * high latitude (60°-85°), for each kernel on its own and for the
+ * dispatching geo_distance(). Reference coordinates are the quantized
+ * 16.16 inputs, so the tables measure the kernels, not input rounding.
+ *
+ * Then throughput: single calls, pairwise and one-to-many batches, and a
+ * libm double haversine (spherical, no ellipsoid) as the FPU baseline.
+ *
+ * Built with (see Makefile):
+ *   gcc -O2 -D_GNU_SOURCE -o geodesic_bench geodesic_bench.c ../embedded/geodesic.c \
+ *       ../embedded/se3_math.c ../embedded/trig_tables.c -I../embedded -lm
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "../embedded/se3_edge.h"
+#include "../embedded/geodesic.h"
+#include "bench_harness.h"
+#include "vincenty_ref.h"
+
+#define PAIRS_PER_BAND  4000
+#define N_BATCH         4096
+#define ROUNDS          200
+
+typedef uint32_t (*geo_fn)(fixed_t, fixed_t, fixed_t, fixed_t, uint32_t*);
+
+static const struct { double lo_m, hi_m; } bands[] = {
+    { 100, 1000 }, { 1e3, 1e4 }, { 1e4, 2e4 }, { 2e4, 1e5 },
+    { 1e5, 1e6 }, { 1e6, 5e6 }, { 5e6, 1.5e7 },
+};
+#define N_BANDS ((int)(sizeof(bands) / sizeof(bands[0])))
+
+static uint32_t rng_state = 12345;
+
+static double frand(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (rng_state >> 8) / 16777216.0;
+}
+
+static fixed_t to_fixed(double deg) {
+    return (fixed_t)lrint(deg * FRACUNIT);
+}
+
+/* Random target at a distance in [lo, hi) from (p1, l1) (radians), placed
+ * on a sphere; the reference distance is computed from the result */
+static void random_target(double p1, double l1, double lo_m, double hi_m,
+                          fixed_t* lat2, fixed_t* lon2) {
+    double d = exp(log(lo_m) + (log(hi_m) - log(lo_m)) * frand()) / 6371008.8;
+    double az = 2.0 * M_PI * frand();
+    double p2 = asin(sin(p1) * cos(d) + cos(p1) * sin(d) * cos(az));
+    double l2 = l1 + atan2(sin(az) * sin(d) * cos(p1), cos(d) - sin(p1) * sin(p2));
+    if (l2 > M_PI) l2 -= 2.0 * M_PI;
+    if (l2 < -M_PI) l2 += 2.0 * M_PI;
+    *lat2 = to_fixed(p2 * 180.0 / M_PI);
+    *lon2 = to_fixed(l2 * 180.0 / M_PI);
+}
+
+static void random_pair(double lat_lo, double lat_hi, double lo_m, double hi_m,
+                        fixed_t* lat1, fixed_t* lon1, fixed_t* lat2, fixed_t* lon2) {
+    double p1 = (lat_lo + (lat_hi - lat_lo) * frand()) * M_PI / 180.0;
+    double l1 = (-180.0 + 360.0 * frand()) * M_PI / 180.0;
+    if (frand() < 0.5) p1 = -p1;
+    *lat1 = to_fixed(p1 * 180.0 / M_PI);
+    *lon1 = to_fixed(l1 * 180.0 / M_PI);
+    random_target(*lat1 / 65536.0 * M_PI / 180.0, *lon1 / 65536.0 * M_PI / 180.0,
+                  lo_m, hi_m, lat2, lon2);
+}
+
+static void error_table(const char* title, double lat_lo, double lat_hi) {
+    static const struct { const char* name; geo_fn fn; } kernels[] = {
+        { "equirect", geo_distance_equirect },
+        { "haversine", geo_distance_haversine },
+        { "geo_distance", geo_distance },
+    };
+    bench_section(title);
+    printf("  %-16s %-13s %11s %11s %10s %11s\n", "range", "kernel", "max err m",
+           "rms err m", "max rel", "max brg °");
+    for (int bnd = 0; bnd < N_BANDS; bnd++) {
+        double max_e[3] = {0}, sum_sq[3] = {0}, max_rel[3] = {0}, max_b[3] = {0};
+        int n = 0;
+        for (int i = 0; i < PAIRS_PER_BAND; i++) {
+            fixed_t la1, lo1, la2, lo2;
+            random_pair(lat_lo, lat_hi, bands[bnd].lo_m, bands[bnd].hi_m, &la1, &lo1, &la2, &lo2);
+            double ref, ref_az;
+            if (!vincenty_inverse(la1 / 65536.0, lo1 / 65536.0, la2 / 65536.0, lo2 / 65536.0,
+                                  &ref, &ref_az)) continue;
+            n++;
+            for (int k = 0; k < 3; k++) {
+                uint32_t brg;
+                double got = kernels[k].fn(la1, lo1, la2, lo2, &brg);
+                double e = fabs(got - ref);
+                double b = fabs(brg * (360.0 / 4294967296.0) - ref_az);
+                if (b > 180.0) b = 360.0 - b;
+                sum_sq[k] += e * e;
+                if (e > max_e[k]) max_e[k] = e;
+                if (e / ref > max_rel[k]) max_rel[k] = e / ref;
+                if (b > max_b[k]) max_b[k] = b;
+            }
+        }
+        char range[32];
+        snprintf(range, sizeof(range), "%.0f-%.0f km", bands[bnd].lo_m / 1e3, bands[bnd].hi_m / 1e3);
+        if (bands[bnd].hi_m <= 1e3) snprintf(range, sizeof(range), "100 m-1 km");
+        for (int k = 0; k < 3; k++) {
+            printf("  %-16s %-13s %11.2f %11.2f %10.1e %11.4f\n", k == 0 ? range : "",
+                   kernels[k].name, max_e[k], sqrt(sum_sq[k] / n), max_rel[k], max_b[k]);
+        }
+    }
+}
+
+/* FPU baseline: spherical haversine in double */
+static double haversine_double(double lat1, double lon1, double lat2, double lon2) {
+    const double d2r = M_PI / 180.0;
+    double sp = sin((lat2 - lat1) * d2r * 0.5), sl = sin((lon2 - lon1) * d2r * 0.5);
+    double h = sp * sp + cos(lat1 * d2r) * cos(lat2 * d2r) * sl * sl;
+    return 2.0 * 6371008.8 * asin(sqrt(h));
+}
+
+static void throughput(const char* label, double lo_m, double hi_m) {
+    static fixed_t la1[N_BATCH], lo1[N_BATCH], la2[N_BATCH], lo2[N_BATCH];
+    static double dla1[N_BATCH], dlo1[N_BATCH], dla2[N_BATCH], dlo2[N_BATCH];
+    static uint32_t dist[N_BATCH], brg[N_BATCH];
+    for (int i = 0; i < N_BATCH; i++) {
+        random_pair(0, 80, lo_m, hi_m, &la1[i], &lo1[i], &la2[i], &lo2[i]);
+        dla1[i] = la1[i] / 65536.0; dlo1[i] = lo1[i] / 65536.0;
+        dla2[i] = la2[i] / 65536.0; dlo2[i] = lo2[i] / 65536.0;
+    }
+    bench_section(label);
+    bench_t t;
+    bench_begin(&t, "geo_distance, single calls");
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < N_BATCH; i++) bench_sink += geo_distance(la1[i], lo1[i], la2[i], lo2[i], NULL);
+    }
+    bench_end(&t, (uint64_t)ROUNDS * N_BATCH);
+    bench_begin(&t, "geo_distance, single calls + bearing");
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < N_BATCH; i++) {
+            uint32_t b;
+            bench_sink += geo_distance(la1[i], lo1[i], la2[i], lo2[i], &b) + b;
+        }
+    }
+    bench_end(&t, (uint64_t)ROUNDS * N_BATCH);
+    bench_begin(&t, "geo_distance_batch + bearing");
+    for (int r = 0; r < ROUNDS; r++) {
+        geo_distance_batch(la1, lo1, la2, lo2, N_BATCH, dist, brg);
+        bench_sink += dist[r % N_BATCH];
+    }
+    bench_end(&t, (uint64_t)ROUNDS * N_BATCH);
+    /* One-to-many: same range band, all targets around one origin */
+    static fixed_t tla[N_BATCH], tlo[N_BATCH];
+    for (int i = 0; i < N_BATCH; i++) {
+        random_target(dla1[0] * M_PI / 180.0, dlo1[0] * M_PI / 180.0, lo_m, hi_m, &tla[i], &tlo[i]);
+    }
+    bench_begin(&t, "geo_distance_from (one origin) + bearing");
+    for (int r = 0; r < ROUNDS; r++) {
+        geo_distance_from(la1[0], lo1[0], tla, tlo, N_BATCH, dist, brg);
+        bench_sink += dist[r % N_BATCH];
+    }
+    bench_end(&t, (uint64_t)ROUNDS * N_BATCH);
+    bench_begin(&t, "baseline: libm double haversine (sphere)");
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < N_BATCH; i++) {
+            bench_sink += (uint64_t)haversine_double(dla1[i], dlo1[i], dla2[i], dlo2[i]);
+        }
+    }
+    bench_end(&t, (uint64_t)ROUNDS * N_BATCH);
+    bench_begin(&t, "reference: double Vincenty inverse");
+    for (int i = 0; i < N_BATCH; i++) {
+        double d;
+        vincenty_inverse(dla1[i], dlo1[i], dla2[i], dlo2[i], &d, NULL);
+        bench_sink += (uint64_t)d;
+    }
+    bench_end(&t, N_BATCH);
+}
+
+int main(void) {
+    printf("======================================================================\n");
+    printf("FIXED-POINT GEODESIC DISTANCE / BEARING BENCHMARKS\n");
+    printf("======================================================================\n");
+    printf("Crossover GEO_SHORT_RANGE_M = %d m; %d pairs per band\n", GEO_SHORT_RANGE_M,
+           PAIRS_PER_BAND);
+    se3_init_tables();
+
+    error_table("Error vs. Vincenty, |lat| < 80°", 0, 80);
+    error_table("Error vs. Vincenty, high latitude 60°-85°", 60, 85);
+
+    throughput("Throughput, short range (100 m - 10 km)", 100, 1e4);
+    throughput("Throughput, long range (10 - 10,000 km)", 1e4, 1e7);
+    return 0;
+}
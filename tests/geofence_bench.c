@@ -0,0 +1,177 @@
+/*
+ * geofence_bench.c - Host Benchmarks for the Geofence Engine
+ *
+ * Measures, for 10,000 fences and 2,000 vessels:
+ *   1. Bin build time and bin statistics
+ *   2. Fix throughput: binned single/batch evaluation vs. brute force
+ *   3. Polygon tests per fix
+ *
+ * Built with host capacities (see Makefile):
+ *   gcc -O2 -D_GNU_SOURCE -DGEOFENCE_MAX_FENCES=10240 \
+ *       -DGEOFENCE_MAX_VERTICES=163840 -DGEOFENCE_MAX_BIN_ENTRIES=65536 \
+ *       -DGEOFENCE_BIN_SLOTS=65536 -DGEOFENCE_MAX_VESSELS=4096 \
+ *       -o geofence_bench geofence_bench.c ../embedded/geofence.c \
+ *       ../embedded/t_bsp.c ../embedded/se3_math.c ../embedded/trig_tables.c \
+ *       -I../embedded -lm
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "../embedded/se3_edge.h"
+#include "../embedded/t_bsp.h"
+#include "../embedded/geofence.h"
+#include "bench_harness.h"
+#include <math.h>
+
+#define N_FENCES        10000
+#define N_VESSELS       2000
+#define N_FIXES         200000
+#define AREA_DEG        9.0         /* Fences and vessels within ±9° (~±100 cells) */
+#define BRUTE_FIXES     2000
+#define MAX_EVENTS      4096
+
+static uint32_t rng = 2024;
+static inline uint32_t xrand(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+static inline double urand(void) { return (xrand() & 0xFFFFFF) / (double)0x1000000; }
+
+/* Star-shaped (generally concave) polygon around a random center */
+static void load_fences(geofence_set_t* gs) {
+    geofence_vertex_t ring[16];
+    for (int f = 0; f < N_FENCES; f++) {
+        double clat = (urand() * 2.0 - 1.0) * AREA_DEG;
+        double clon = (urand() * 2.0 - 1.0) * AREA_DEG;
+        double radius = 0.01 + urand() * 0.12;          /* ~1-14 km */
+        int n = 8 + (int)(xrand() % 9);
+        for (int k = 0; k < n; k++) {
+            double a = 2.0 * M_PI * k / n;
+            double r = radius * (0.5 + 0.5 * urand());
+            ring[k].lat = FLOAT_TO_FIXED(clat + r * sin(a));
+            ring[k].lon = FLOAT_TO_FIXED(clon + r * cos(a));
+        }
+        geofence_add(gs, (uint32_t)(100000 + f), (uint8_t)(f % 3), ring, (uint32_t)n);
+    }
+}
+
+/* Interleaved fixes: vessels move ~0.005°/fix with persistent headings */
+static void make_fixes(geofence_fix_t* fixes) {
+    static double lat[N_VESSELS], lon[N_VESSELS], dlat[N_VESSELS], dlon[N_VESSELS];
+    for (int v = 0; v < N_VESSELS; v++) {
+        lat[v] = (urand() * 2.0 - 1.0) * AREA_DEG;
+        lon[v] = (urand() * 2.0 - 1.0) * AREA_DEG;
+        double a = urand() * 2.0 * M_PI;
+        dlat[v] = 0.005 * sin(a);
+        dlon[v] = 0.005 * cos(a);
+    }
+    for (int i = 0; i < N_FIXES; i++) {
+        int v = i % N_VESSELS;
+        lat[v] += dlat[v];
+        lon[v] += dlon[v];
+        if (fabs(lat[v]) > AREA_DEG) dlat[v] = -dlat[v];
+        if (fabs(lon[v]) > AREA_DEG) dlon[v] = -dlon[v];
+        fixes[i].lat = FLOAT_TO_FIXED(lat[v]);
+        fixes[i].lon = FLOAT_TO_FIXED(lon[v]);
+        fixes[i].mmsi = 367000000u + (uint32_t)v;
+        fixes[i].timestamp = 1700000000u + (uint32_t)(i / N_VESSELS);
+    }
+}
+
+/* Reference: every fence, bbox + crossing test */
+static int brute_force(const geofence_set_t* gs, const geofence_fix_t* fix) {
+    int inside = 0;
+    for (uint32_t f = 0; f < gs->n_fences; f++) {
+        const geofence_poly_t* p = &gs->fences[f];
+        if (fix->lat < p->lat_min || fix->lat > p->lat_max ||
+            fix->lon < p->lon_min || fix->lon > p->lon_max) {
+            continue;
+        }
+        inside += geofence_point_in_polygon(&gs->vertices[p->first_vertex], p->n_vertices,
+                                            fix->lat, fix->lon);
+    }
+    return inside;
+}
+
+int main(void) {
+    printf("======================================================================\n");
+    printf("GEOFENCE ENGINE - HOST BENCHMARKS\n");
+    printf("======================================================================\n");
+
+    se3_init_tables();
+
+    t_bsp_t* bsp = (t_bsp_t*)bench_alloc_aligned(sizeof(t_bsp_t));
+    geofence_set_t* gs = (geofence_set_t*)bench_alloc_aligned(sizeof(geofence_set_t));
+    geofence_fix_t* fixes = (geofence_fix_t*)malloc(sizeof(geofence_fix_t) * N_FIXES);
+    geofence_event_t* events = (geofence_event_t*)malloc(sizeof(geofence_event_t) * MAX_EVENTS);
+    if (!bsp || !gs || !fixes || !events) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+
+    t_bsp_init(bsp, 0, 0);
+    geofence_init(gs);
+    load_fences(gs);
+    make_fixes(fixes);
+    printf("Fences: %u (%u vertices), vessels: %d, fixes: %d, sizeof(geofence_set_t): %zu KB\n",
+           gs->n_fences, gs->n_vertices, N_VESSELS, N_FIXES, sizeof(geofence_set_t) / 1024);
+
+    bench_t b;
+    bench_section("Build");
+    bench_begin(&b, "geofence_build (10k fences)");
+    bool ok = geofence_build(gs, bsp);
+    bench_end(&b, 1);
+    uint32_t bins = 0, max_bin = 0;
+    for (uint32_t s = 0; s < GEOFENCE_BIN_SLOTS; s++) {
+        if (!gs->bins[s].used) continue;
+        bins++;
+        if (gs->bins[s].count > max_bin) max_bin = gs->bins[s].count;
+    }
+    printf("  build %s: %u bin entries in %u cells (avg %.2f, max %u fences/cell)\n",
+           ok ? "ok" : "FAILED", gs->n_entries, bins, bins ? (double)gs->n_entries / bins : 0.0,
+           max_bin);
+
+    bench_section("Fix evaluation");
+    int brute_hits = 0;
+    bench_begin(&b, "brute force (all fences)");
+    for (int i = 0; i < BRUTE_FIXES; i++) {
+        brute_hits += brute_force(gs, &fixes[i]);
+    }
+    double brute_ns = bench_end(&b, BRUTE_FIXES);
+
+    uint64_t n_events = 0;
+    gs->tests = 0;
+    bench_begin(&b, "geofence_eval (binned)");
+    for (int i = 0; i < N_FIXES; i++) {
+        n_events += (uint64_t)geofence_eval(gs, bsp, &fixes[i], events, MAX_EVENTS);
+    }
+    double single_ns = bench_end(&b, N_FIXES);
+    double tests_per_fix = (double)gs->tests / N_FIXES;
+
+    /* Fresh membership so batch emits the same events */
+    memset(gs->vessels, 0, sizeof(gs->vessels));
+    uint64_t batch_events = 0;
+    bench_begin(&b, "geofence_eval_batch (1000-fix batches)");
+    for (int i = 0; i < N_FIXES; i += 1000) {
+        batch_events += (uint64_t)geofence_eval_batch(gs, bsp, &fixes[i], 1000, events, MAX_EVENTS);
+    }
+    double batch_ns = bench_end(&b, N_FIXES);
+
+    printf("  brute-force hits in first %d fixes: %d\n", BRUTE_FIXES, brute_hits);
+    printf("  polygon tests per fix: %.3f (brute force bbox-checks %u fences)\n",
+           tests_per_fix, gs->n_fences);
+    printf("  events: %llu single, %llu batch\n",
+           (unsigned long long)n_events, (unsigned long long)batch_events);
+    printf("  throughput: %.0f fixes/s binned, %.0f fixes/s batch, %.0f fixes/s brute force\n",
+           1e9 / single_ns, 1e9 / batch_ns, 1e9 / brute_ns);
+    printf("  100k fixes/s target uses %.2f%% of one core (batch)\n", 100e3 * batch_ns / 1e9 * 100.0);
+
+    free(events);
+    free(fixes);
+    free(gs);
+    free(bsp);
+    return 0;
+}
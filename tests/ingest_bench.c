@@ -0,0 +1,330 @@
+/*
+ * ingest_bench.c - Packet Blaster for the Batched Fix Ingest Front End
+ *
+ * A forked receiver runs fix_ingest_poll() into the insert pipeline
+ * (t_bsp_locate + t_bsp_insert_pose); the parent blasts datagrams from 32
+ * stand-in stations (500 vessels over ±0.25°, 8 fixes per datagram) with
+ * sendmmsg() and measures, per transport and receive batch size:
+ *   1. Offered vs. received packets/second at full speed
+ *   2. Drops: sent − received, against the socket's drop counter and the
+ *      per-station sequence gaps (which miss drops no later datagram of
+ *      the same station follows, so they trail off when the blast ends)
+ *   3. Datagrams per receive syscall (batch = 1 is the recvfrom() loop)
+ *      and receiver CPU time per datagram, syscalls and pipeline included
+ *   4. The same at a paced offered load, below saturation, and with a
+ *      receiver that stalls 200 µs after every poll (a pipeline falling
+ *      behind): the batch size decides how much of the queue each wakeup
+ *      drains before the socket buffer overflows
+ *
+ * UDP runs over loopback; the blaster sends non-blocking and counts
+ * EAGAIN / ENOBUFS as a drop ("tx fails": the blaster's own send buffer
+ * is charged until the receiver takes the datagram). AF_UNIX datagram sockets apply backpressure instead
+ * of dropping, so the blaster blocks and tx pps is the sustained rate.
+ * On a single CPU the two processes alternate, so rx pps follows tx pps;
+ * receiver CPU per datagram is the figure that transfers to a dedicated
+ * ingest core.
+ *
+ * Usage: ./ingest_bench [datagrams_per_run]    (default 200000)
+ *
+ * Built with (see Makefile):
+ *   gcc -O2 -D_GNU_SOURCE -DFIX_INGEST_LIBRARY -o ingest_bench ingest_bench.c \
+ *       ../tools/fix_ingest.c ../embedded/t_bsp.c ../embedded/se3_math.c \
+ *       ../embedded/trig_tables.c -I../embedded -I../tools -lm
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "../embedded/se3_edge.h"
+#include "../embedded/t_bsp.h"
+#include "../tools/fix_ingest.h"
+#include "bench_harness.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <math.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define N_VESSELS       500
+#define N_STATIONS      32
+#define FIXES_PER_DGRAM 8
+#define AREA_DEG        0.25
+#define SEND_BATCH      64
+#define IDLE_STOP_MS    300         /* Receiver stops after this long idle */
+
+typedef struct {
+    fix_ingest_stats_t stats;
+    uint64_t inserted;
+    uint64_t first_ns, last_ns;     /* First and last datagram received */
+    uint64_t cpu_ns;                /* Receiver user + system time */
+} rx_report_t;
+
+typedef struct {
+    t_bsp_t* bsp;
+    t_bsp_locator_t* loc;
+    uint64_t inserted;
+    uint64_t first_ns, last_ns;
+} rx_pipeline_t;
+
+static uint32_t rng_state = 4242;
+
+static double frand(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (rng_state >> 8) / 16777216.0;
+}
+
+static void insert_batch(void* ctx, const fix_ingest_datagram_t* dgrams, int n) {
+    rx_pipeline_t* pl = (rx_pipeline_t*)ctx;
+    for (int d = 0; d < n; d++) {
+        for (int i = 0; i < dgrams[d].count; i++) {
+            const fix_ingest_fix_t* f = &dgrams[d].fixes[i];
+            uint16_t cell = t_bsp_locate(pl->bsp, pl->loc, f->pose.mmsi, f->lat, f->lon);
+            pl->inserted += t_bsp_insert_pose(pl->bsp, cell, &f->pose);
+        }
+    }
+    pl->last_ns = bench_now_ns();
+    if (pl->first_ns == 0) pl->first_ns = pl->last_ns;
+}
+
+/* ========================================================================
+ * RECEIVER (child process)
+ * ======================================================================== */
+
+static void run_receiver(const fix_ingest_config_t* cfg, int stall_us, int ready_fd,
+                         int report_fd) {
+    static t_bsp_t bsp;
+    static t_bsp_locator_t loc;
+    t_bsp_init(&bsp, 0, 0);
+    t_bsp_locator_init(&loc);
+    rx_pipeline_t pl = { &bsp, &loc, 0, 0, 0 };
+
+    static fix_ingest_t in;
+    uint16_t port = 0;
+    if (fix_ingest_open(&in, cfg, insert_batch, &pl) && cfg->udp) {
+        struct sockaddr_in addr;
+        socklen_t len = sizeof(addr);
+        getsockname(in.fd, (struct sockaddr*)&addr, &len);
+        port = ntohs(addr.sin_port);
+    }
+    if (in.fd < 0) fprintf(stderr, "  receiver: %s\n", in.error);
+    if (write(ready_fd, &port, sizeof(port)) != sizeof(port) || in.fd < 0) _exit(1);
+
+    /* Wait for the first datagram, then stop once the blast has gone quiet */
+    struct timespec stall = { 0, stall_us * 1000L };
+    while (fix_ingest_poll(&in, pl.first_ns ? IDLE_STOP_MS : 10000) > 0) {
+        if (stall_us) nanosleep(&stall, NULL);     /* A pipeline that falls behind */
+    }
+
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    uint64_t cpu_ns = (uint64_t)(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000000ull +
+                      (uint64_t)(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1000ull;
+    rx_report_t rep = { in.stats, pl.inserted, pl.first_ns, pl.last_ns, cpu_ns };
+    fix_ingest_close(&in);
+    if (write(report_fd, &rep, sizeof(rep)) != sizeof(rep)) _exit(1);
+    _exit(0);
+}
+
+/* ========================================================================
+ * BLASTER (parent process)
+ * ======================================================================== */
+
+static uint8_t* datagrams;          /* n × dgram_len, pre-encoded */
+static size_t dgram_len;
+
+static void encode_datagrams(int n) {
+    static double lat[N_VESSELS], lon[N_VESSELS], dlat[N_VESSELS], dlon[N_VESSELS];
+    for (int v = 0; v < N_VESSELS; v++) {
+        lat[v] = (frand() * 2.0 - 1.0) * AREA_DEG;
+        lon[v] = (frand() * 2.0 - 1.0) * AREA_DEG;
+        double speed = (4.0 + 17.0 * frand()) * 0.514 * 10.0 / 111320.0;  /* 4-21 kn, 10 s */
+        double heading = frand() * 2.0 * M_PI;
+        dlat[v] = speed * cos(heading);
+        dlon[v] = speed * sin(heading);
+    }
+
+    fix_ingest_fix_t fixes[FIXES_PER_DGRAM];
+    uint32_t seq[N_STATIONS] = { 0 };
+    int v = 0;
+    dgram_len = sizeof(fix_ingest_header_t) + FIXES_PER_DGRAM * sizeof(fix_ingest_fix_t);
+    datagrams = malloc((size_t)n * dgram_len);
+    for (int d = 0; d < n; d++) {
+        for (int k = 0; k < FIXES_PER_DGRAM; k++, v = (v + 1) % N_VESSELS) {
+            lat[v] += dlat[v];
+            lon[v] += dlon[v];
+            if (fabs(lat[v]) > AREA_DEG) dlat[v] = -dlat[v];
+            if (fabs(lon[v]) > AREA_DEG) dlon[v] = -dlon[v];
+            fixes[k].lat = (fixed_t)lrint(lat[v] * FRACUNIT);
+            fixes[k].lon = (fixed_t)lrint(lon[v] * FRACUNIT);
+            se3_pose_identity(&fixes[k].pose);
+            fixes[k].pose.timestamp = 1700000000u + (uint32_t)(d / 64);
+            fixes[k].pose.mmsi = 367000000u + (uint32_t)v;
+        }
+        uint16_t station = (uint16_t)(d % N_STATIONS);
+        fix_ingest_encode(datagrams + (size_t)d * dgram_len, station, seq[station]++,
+                          1700000000u, fixes, FIXES_PER_DGRAM);
+    }
+}
+
+/**
+ * Send n datagrams, at most pps per second (0 = unpaced).
+ *
+ * @return Datagrams the kernel accepted
+ */
+static uint64_t blast(int fd, int n, double pps, bool block, uint64_t* elapsed_ns) {
+    struct mmsghdr msgs[SEND_BATCH];
+    struct iovec iov[SEND_BATCH];
+    memset(msgs, 0, sizeof(msgs));
+    uint64_t sent = 0, start = bench_now_ns();
+    for (int d = 0; d < n; d += SEND_BATCH) {
+        int k = n - d < SEND_BATCH ? n - d : SEND_BATCH;
+        if (pps > 0) {
+            uint64_t due = start + (uint64_t)(d / pps * 1e9);
+            uint64_t now = bench_now_ns();
+            if (due > now) {
+                struct timespec ts = { 0, (long)(due - now) };
+                nanosleep(&ts, NULL);
+            }
+        }
+        for (int i = 0; i < k; i++) {
+            iov[i].iov_base = datagrams + (size_t)(d + i) * dgram_len;
+            iov[i].iov_len = dgram_len;
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        int i = 0;
+        while (i < k) {
+            int r = sendmmsg(fd, msgs + i, (unsigned)(k - i), block ? 0 : MSG_DONTWAIT);
+            if (r > 0) {
+                sent += (uint64_t)r;
+                i += r;
+            } else if (errno == EAGAIN || errno == ENOBUFS) {
+                i++;            /* Queue full: this datagram is dropped */
+            } else if (errno != EINTR) {
+                perror("sendmmsg");
+                return sent;
+            }
+        }
+    }
+    *elapsed_ns = bench_now_ns() - start;
+    return sent;
+}
+
+static void run_case(const char* transport, int batch, int n, double pps, int stall_us) {
+    char unix_path[128];
+    snprintf(unix_path, sizeof(unix_path), "/tmp/ingest_bench.%d.sock", (int)getpid());
+    bool udp = strcmp(transport, "udp") == 0;
+
+    fix_ingest_config_t cfg;
+    fix_ingest_default_config(&cfg);
+    cfg.udp = udp ? "127.0.0.1:0" : NULL;
+    cfg.unix_path = udp ? NULL : unix_path;
+    cfg.batch = batch;
+
+    int ready[2], report[2];
+    if (pipe(ready) != 0 || pipe(report) != 0) {
+        perror("pipe");
+        return;
+    }
+    pid_t pid = fork();
+    if (pid == 0) run_receiver(&cfg, stall_us, ready[1], report[1]);
+
+    uint16_t port;
+    if (read(ready[0], &port, sizeof(port)) != sizeof(port)) {
+        printf("  %-5s receiver failed to start\n", transport);
+        waitpid(pid, NULL, 0);
+        return;
+    }
+    int fd;
+    if (udp) {
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = socket(AF_INET, SOCK_DGRAM, 0);
+        connect(fd, (struct sockaddr*)&addr, sizeof(addr));
+    } else {
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strcpy(addr.sun_path, unix_path);
+        fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+        connect(fd, (struct sockaddr*)&addr, sizeof(addr));
+    }
+
+    uint64_t send_ns = 1;
+    uint64_t sent = blast(fd, n, pps, !udp, &send_ns);
+    close(fd);
+
+    rx_report_t rep;
+    memset(&rep, 0, sizeof(rep));
+    if (read(report[0], &rep, sizeof(rep)) != sizeof(rep)) printf("  receiver report missing\n");
+    waitpid(pid, NULL, 0);
+    close(ready[0]);
+    close(ready[1]);
+    close(report[0]);
+    close(report[1]);
+
+    const fix_ingest_stats_t* s = &rep.stats;
+    uint64_t rx_ns = rep.last_ns > rep.first_ns ? rep.last_ns - rep.first_ns : 1;
+    uint64_t dropped = (uint64_t)n - s->datagrams;
+    /* Every sequence gap is a real drop; trailing drops are not gaps */
+    bool consistent = s->seq_lost <= dropped && s->seq_lost <= s->kernel_drops + (n - sent) &&
+                      s->fixes == s->datagrams * FIXES_PER_DGRAM && s->malformed == 0;
+    char offered[16];
+    snprintf(offered, sizeof(offered), pps > 0 ? "%.0fk" : "max", pps / 1e3);
+    printf("  %-5s %5d %7s %9.0f %9.0f %8.1f %8.0f %7.2f%% %8llu %8llu %8llu   %s\n", transport,
+           batch, offered, sent * 1e9 / send_ns, s->datagrams * 1e9 / rx_ns,
+           s->syscalls ? (double)s->datagrams / (double)s->syscalls : 0.0,
+           s->datagrams ? (double)rep.cpu_ns / (double)s->datagrams : 0.0,
+           100.0 * (double)dropped / n, (unsigned long long)(n - sent),
+           (unsigned long long)s->seq_lost,
+           (unsigned long long)s->kernel_drops, consistent ? "ok" : "MISMATCH");
+}
+
+static void print_header(void) {
+    printf("  %-5s %5s %7s %9s %9s %8s %8s %8s %8s %8s %8s   %s\n", "sock", "batch", "offered",
+           "tx pps", "rx pps", "pkt/call", "rx ns/pk", "dropped", "tx fails", "seq gaps", "kdrops", "check");
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 200000;
+    printf("======================================================================\n");
+    printf("FIX INGEST: recvmmsg() BATCHING, UDP LOOPBACK AND AF_UNIX\n");
+    printf("======================================================================\n");
+    signal(SIGPIPE, SIG_IGN);
+
+    encode_datagrams(n);
+    printf("  %d datagrams × %zu B (%d fixes), %d stations, %d vessels\n", n, dgram_len,
+           FIXES_PER_DGRAM, N_STATIONS, N_VESSELS);
+    printf("  receiver: fix_ingest_poll() → t_bsp_locate() → t_bsp_insert_pose()\n");
+
+    bench_section("Blast at full speed (rx pps: first to last datagram received)");
+    print_header();
+    run_case("udp", 1, n, 0, 0);
+    run_case("udp", 16, n, 0, 0);
+    run_case("udp", 64, n, 0, 0);
+    run_case("unix", 1, n, 0, 0);
+    run_case("unix", 64, n, 0, 0);
+
+    bench_section("Paced offered load");
+    print_header();
+    run_case("udp", 1, n / 2, 100e3, 0);
+    run_case("udp", 64, n / 2, 100e3, 0);
+
+    bench_section("Paced, receiver stalls 200 us per poll");
+    print_header();
+    run_case("udp", 1, n / 2, 100e3, 200);
+    run_case("udp", 16, n / 2, 100e3, 200);
+    run_case("udp", 64, n / 2, 100e3, 200);
+
+    free(datagrams);
+    return 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * json_bench.c - Streaming JSON Pose Parser Throughput
+ *
+ * Generates a trajectory payload the way the science API's encoder writes
+ * it (6-decimal rotation vectors and translations, timestamps, MMSIs) and
+ * measures:
+ *   1. Chunk size: the whole buffer vs. TCP segments (1460 B) vs. UART
+ *      reads (256 B, 64 B) - the per-feed cost of resuming a token
+ *   2. Baselines: a memchr() pass over the same bytes (memory bandwidth)
+ *      and a strtod()-per-number scan (what a float parser pays)
+ *   3. Device-class budget: share of one core needed to keep up with a
+ *      921,600 baud UART and a 10 Mbit/s link at the measured rate
+ *
+ * Usage: ./json_bench [payload_MB]    (default 32)
+ *
+ * Built with (see Makefile):
+ *   gcc -O2 -D_GNU_SOURCE -o json_bench json_bench.c ../embedded/json_parser.c \
+ *       ../embedded/se3_math.c ../embedded/trig_tables.c ../embedded/se3_group.c \
+ *       ../embedded/lambda_estimator.c -I../embedded -lm
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "../embedded/se3_edge.h"
+#include "../embedded/json_parser.h"
+#include "bench_harness.h"
+#include <math.h>
+
+static uint32_t rng_state = 2024;
+
+static double frand(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (rng_state >> 8) / 16777216.0;
+}
+
+typedef struct {
+    uint64_t poses;
+    int64_t checksum;
+} pose_count_t;
+
+static void count_pose(void* ctx, const se3_pose_t* pose, uint32_t trajectory) {
+    pose_count_t* c = (pose_count_t*)ctx;
+    (void)trajectory;
+    c->poses++;
+    c->checksum += pose->translation[0] ^ pose->rotation[0];
+}
+
+/* {"trajectory_data": {"poses": [...]}} of about target bytes */
+static char* make_payload(size_t target, size_t* len, uint64_t* n_poses) {
+    char* buf = malloc(target + 512);
+    size_t n = (size_t)sprintf(buf, "{\"trajectory_data\": {\"poses\": [\n");
+    uint32_t ts = 1700000000u;
+    *n_poses = 0;
+    while (n < target) {
+        n += (size_t)sprintf(buf + n,
+                             "%s{\"rotation\": [%.6f, %.6f, %.6f], "
+                             "\"translation\": [%.6f, %.6f, %.6f], "
+                             "\"timestamp\": %u, \"mmsi\": %u}",
+                             *n_poses ? ",\n" : "",
+                             (frand() - 0.5) * 0.2, (frand() - 0.5) * 0.2, (frand() - 0.5) * 6.0,
+                             (frand() - 0.5) * 20000.0, (frand() - 0.5) * 20000.0, frand() * 5.0,
+                             ts, 366000000u + (uint32_t)(frand() * 1000.0));
+        ts += 10;
+        (*n_poses)++;
+    }
+    n += (size_t)sprintf(buf + n, "\n]}}\n");
+    *len = n;
+    return buf;
+}
+
+static double parse_chunked(const char* buf, size_t len, size_t chunk, uint64_t expect) {
+    pose_count_t c = { 0, 0 };
+    json_pose_parser_t p;
+    char label[64];
+    if (chunk == 0) {
+        snprintf(label, sizeof(label), "whole buffer (per byte)");
+    } else {
+        snprintf(label, sizeof(label), "%zu B chunks (per byte)", chunk);
+    }
+    bench_t b;
+    bench_begin(&b, label);
+    json_pose_init(&p, count_pose, &c);
+    size_t step = chunk ? chunk : len;
+    int err = JSON_POSE_OK;
+    for (size_t off = 0; off < len && err == JSON_POSE_OK; off += step) {
+        err = json_pose_feed(&p, buf + off, len - off < step ? len - off : step);
+    }
+    if (err == JSON_POSE_OK) err = json_pose_finish(&p);
+    double ns = bench_end(&b, len);
+    bench_sink += (uint64_t)c.checksum;
+    printf("    %.1f MB/s, %.0f ns/pose%s\n", 1e3 / ns, ns * (double)len / (double)c.poses,
+           err != JSON_POSE_OK || c.poses != expect ? "   FAILED" : "");
+    return 1e3 / ns;
+}
+
+int main(int argc, char** argv) {
+    size_t target_mb = argc > 1 ? strtoul(argv[1], NULL, 10) : 32;
+    printf("======================================================================\n");
+    printf("STREAMING JSON POSE PARSER (SAX, ZERO-ALLOCATION, RESUMABLE)\n");
+    printf("======================================================================\n");
+
+    size_t len;
+    uint64_t n_poses;
+    char* buf = make_payload(target_mb << 20, &len, &n_poses);
+    printf("  payload: %.1f MB, %llu poses (%.0f B/pose), parser state %zu B\n", len / 1e6,
+           (unsigned long long)n_poses, (double)len / (double)n_poses, sizeof(json_pose_parser_t));
+
+    bench_section("1. json_pose_feed() by chunk size");
+    double whole = parse_chunked(buf, len, 0, n_poses);
+    parse_chunked(buf, len, 1460, n_poses);
+    parse_chunked(buf, len, 256, n_poses);
+    double uart = parse_chunked(buf, len, 64, n_poses);
+
+    bench_section("2. Baselines over the same bytes");
+    bench_t b;
+    bench_begin(&b, "memchr('}') scan (per byte)");
+    uint64_t closes = 0;
+    for (const char* s = buf; (s = memchr(s, '}', (size_t)(buf + len - s))) != NULL; s++) closes++;
+    double ns = bench_end(&b, len);
+    bench_sink += closes;
+    printf("    %.1f MB/s (memory bound)\n", 1e3 / ns);
+
+    bench_begin(&b, "strtod() per number (per byte)");
+    double sum = 0.0;
+    for (const char* s = buf; s < buf + len; s++) {
+        if (*s == '-' || (*s >= '0' && *s <= '9')) {
+            char* next;
+            sum += strtod(s, &next);
+            s = next;
+        }
+    }
+    ns = bench_end(&b, len);
+    bench_sink += (uint64_t)(int64_t)sum;
+    printf("    %.1f MB/s (numbers only, no structure, no fixed-point conversion)\n", 1e3 / ns);
+
+    bench_section("3. Device-class budget (one core at the measured rate)");
+    printf("  %-28s %10s %12s\n", "link", "MB/s", "core share");
+    printf("  %-28s %10.3f %11.3f%%\n", "UART 921600 baud (64 B)", 0.0922, 100.0 * 0.0922 / uart);
+    printf("  %-28s %10.3f %11.3f%%\n", "10 Mbit/s link (whole)", 1.25, 100.0 * 1.25 / whole);
+    printf("  An ESP32-S3 core (240 MHz, in-order) runs this loop roughly 10-20x\n"
+           "  slower than the host; scale the share accordingly.\n");
+
+    free(buf);
+    return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * lambda_bench.c - Full-Resolution vs. Coarse-to-Fine λ Search
+ *
+ * Compares lambda_ws_estimate() (golden section on every step) with
+ * lambda_pyramid_estimate() (coarse search on pre-composed blocks, last
+ * LAMBDA_PYRAMID_FINE_ITER iterations at full resolution) on synthetic
+ * vessel tracks of 64 to 1152 steps:
+ *
+ *   loop     closed circle (return points at λ = k/2)
+ *   meander  random heading changes (±3°/step), 8-12 m steps
+ *   zigzag   alternating turns, survey-line style
+ *   orbit    noisy loop with varying turn rate (multi-modal ε)
+ *
+ * Accuracy: |λ_pyr - λ_full| and ε(λ_pyr) - ε(λ_full) per track, and the
+ * share of tracks where both land within 0.01 of each other. Cost: pose
+ * multiplies per estimate (including the pyramid build) and wall time.
+ *
+ * Built with (see Makefile):
+ *   gcc -O2 -D_GNU_SOURCE -o lambda_bench lambda_bench.c ../embedded/lambda_estimator.c \
+ *       ../embedded/se3_math.c ../embedded/trig_tables.c ../embedded/se3_group.c \
+ *       -I../embedded -lm
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "../embedded/se3_edge.h"
+#include "bench_harness.h"
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define TRACKS_PER_CASE  50
+#define TIMING_ROUNDS    40
+
+enum { TRACK_LOOP, TRACK_MEANDER, TRACK_ZIGZAG, TRACK_ORBIT, N_TRACK_KINDS };
+
+static const char* const track_names[N_TRACK_KINDS] = { "loop", "meander", "zigzag", "orbit" };
+static const int track_sizes[] = { 64, 256, 1152 };
+#define N_SIZES ((int)(sizeof(track_sizes) / sizeof(track_sizes[0])))
+
+static se3_pose_t steps[LAMBDA_MAX_STEPS];
+static lambda_workspace_t ws;
+static lambda_pyramid_t pyr, flat;
+
+static uint32_t rng_state = 2024;
+
+static double frand(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (rng_state >> 8) / 16777216.0;
+}
+
+static void make_track(int kind, int n) {
+    for (int i = 0; i < n; i++) {
+        double turn, stride;
+        switch (kind) {
+        case TRACK_LOOP:
+            turn = 2.0 * M_PI / n;
+            stride = 25.0;
+            break;
+        case TRACK_MEANDER:
+            turn = (frand() - 0.5) * 0.1;
+            stride = 8.0 + 4.0 * frand();
+            break;
+        case TRACK_ZIGZAG:
+            turn = ((i / (n / 8)) % 2 ? 0.05 : -0.05) + (frand() - 0.5) * 0.02;
+            stride = 10.0;
+            break;
+        default:
+            turn = 2.0 * M_PI / n * (1.0 + 0.3 * sin(i * 0.1)) + (frand() - 0.5) * 0.05;
+            stride = 15.0 + 5.0 * frand();
+            break;
+        }
+        fixed_t R[9];
+        rotation_from_yaw((uint32_t)(int64_t)llrint(turn / (2.0 * M_PI) * 4294967296.0), R);
+        for (int k = 0; k < 9; k++) steps[i].rotation[k] = R[k];
+        steps[i].translation[0] = FLOAT_TO_FIXED(stride);
+        steps[i].translation[1] = FLOAT_TO_FIXED((frand() - 0.5) * 0.5);
+        steps[i].translation[2] = 0;
+        steps[i].timestamp = 1000 + i;
+        steps[i].mmsi = 367000001;
+    }
+}
+
+static void accuracy_table(void) {
+    bench_section("Accuracy vs. full-resolution search (50 tracks per row)");
+    printf("  %-8s %5s %6s %11s %11s %11s %8s %10s %10s %7s\n", "track", "steps", "levels",
+           "max |Δλ|", "med |Δλ|", "max Δε m", "agree", "mults full", "mults pyr", "ratio");
+    for (int kind = 0; kind < N_TRACK_KINDS; kind++) {
+        for (int s = 0; s < N_SIZES; s++) {
+            int n = track_sizes[s];
+            double d_lambda[TRACKS_PER_CASE], max_de = 0.0;
+            uint64_t mults_full = 0, mults_pyr = 0;
+            int agree = 0, levels = 0;
+            for (int tr = 0; tr < TRACKS_PER_CASE; tr++) {
+                make_track(kind, n);
+                lambda_ws_load_steps(&ws, steps, n);
+                fixed_t err_full, err_pyr;
+                uint32_t m_full, m_pyr;
+                lambda_pyramid_build(&flat, &ws, 0);
+                fixed_t lam_full = lambda_pyramid_estimate(&flat, LAMBDA_EPSILON, LAMBDA_MAX_ITER,
+                                                           &err_full, &m_full);
+                levels = lambda_pyramid_build(&pyr, &ws, LAMBDA_PYRAMID_LEVELS);
+                fixed_t lam_pyr = lambda_pyramid_estimate(&pyr, LAMBDA_EPSILON, LAMBDA_MAX_ITER,
+                                                          &err_pyr, &m_pyr);
+                double d = fabs(FIXED_TO_FLOAT(lam_pyr) - FIXED_TO_FLOAT(lam_full));
+                double de = FIXED_TO_FLOAT(err_pyr) - FIXED_TO_FLOAT(err_full);
+                d_lambda[tr] = d;
+                if (de > max_de) max_de = de;
+                if (d < 0.01) agree++;
+                mults_full += m_full;
+                mults_pyr += m_pyr;
+            }
+            /* Insertion sort for the median */
+            for (int i = 1; i < TRACKS_PER_CASE; i++) {
+                double v = d_lambda[i];
+                int j = i - 1;
+                while (j >= 0 && d_lambda[j] > v) { d_lambda[j + 1] = d_lambda[j]; j--; }
+                d_lambda[j + 1] = v;
+            }
+            printf("  %-8s %5d %6d %11.4f %11.4f %11.2f %5d/%-2d %10llu %10llu %6.2fx\n",
+                   s == 0 ? track_names[kind] : "", n, levels,
+                   d_lambda[TRACKS_PER_CASE - 1], d_lambda[TRACKS_PER_CASE / 2], max_de,
+                   agree, TRACKS_PER_CASE,
+                   (unsigned long long)(mults_full / TRACKS_PER_CASE),
+                   (unsigned long long)(mults_pyr / TRACKS_PER_CASE),
+                   (double)mults_full / (double)mults_pyr);
+        }
+    }
+}
+
+static void timing(int n) {
+    char label[64];
+    snprintf(label, sizeof(label), "Time per estimate, %d-step meander", n);
+    bench_section(label);
+    make_track(TRACK_MEANDER, n);
+    lambda_ws_load_steps(&ws, steps, n);
+
+    bench_t t;
+    bench_begin(&t, "lambda_ws_estimate (full resolution)");
+    for (int r = 0; r < TIMING_ROUNDS; r++) {
+        bench_sink += (uint64_t)lambda_ws_estimate(&ws, LAMBDA_EPSILON, LAMBDA_MAX_ITER, NULL);
+    }
+    bench_end(&t, TIMING_ROUNDS);
+    bench_begin(&t, "lambda_pyramid_build + estimate");
+    for (int r = 0; r < TIMING_ROUNDS; r++) {
+        lambda_pyramid_build(&pyr, &ws, LAMBDA_PYRAMID_LEVELS);
+        bench_sink += (uint64_t)lambda_pyramid_estimate(&pyr, LAMBDA_EPSILON, LAMBDA_MAX_ITER,
+                                                        NULL, NULL);
+    }
+    bench_end(&t, TIMING_ROUNDS);
+    bench_begin(&t, "  of which lambda_pyramid_build");
+    for (int r = 0; r < TIMING_ROUNDS; r++) {
+        bench_sink += (uint64_t)lambda_pyramid_build(&pyr, &ws, LAMBDA_PYRAMID_LEVELS);
+    }
+    bench_end(&t, TIMING_ROUNDS);
+}
+
+int main(void) {
+    printf("======================================================================\n");
+    printf("λ SEARCH: FULL RESOLUTION VS. COARSE-TO-FINE PYRAMID\n");
+    printf("======================================================================\n");
+    printf("LAMBDA_MAX_ITER = %d, LAMBDA_PYRAMID_LEVELS = %d, FINE_ITER = %d, margin ±%.3f\n",
+           LAMBDA_MAX_ITER, LAMBDA_PYRAMID_LEVELS, LAMBDA_PYRAMID_FINE_ITER,
+           FIXED_TO_FLOAT(LAMBDA_PYRAMID_MARGIN));
+    se3_init_tables();
+
+    accuracy_table();
+    timing(256);
+    timing(1152);
+    return 0;
+}
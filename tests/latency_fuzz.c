@@ -0,0 +1,309 @@
+/*
+ * latency_fuzz.c - Latency-Guided Fuzzing for Worst-Case Inputs
+ *
+ * Searches for inputs that maximize the cost of functions whose run time
+ * depends on their input (latency_targets.h): the wrap loops in
+ * normalize_lon() and heading_to_angle(), and the header scans of
+ * t_bsp_insert_pose() under different occupancy and re-centering states.
+ * Feedback is the measured cost, not coverage (PerfFuzz-style).
+ *
+ * Two builds of the same file:
+ *
+ *   Standalone (gcc, default `make latency_fuzz`): a hill climber keeps
+ *   the slowest inputs per target, mutates them, and writes the top
+ *   LT_KEEP per target to fuzz_corpus/ for worst_case_bench.
+ *     ./latency_fuzz [iterations] [corpus_dir]
+ *
+ *   libFuzzer (clang, `make latency_fuzz_libfuzzer`): the cost of each run
+ *   is bucketed logarithmically into __libfuzzer_extra_counters, so every
+ *   new, higher cost bucket counts as new coverage and the input is kept.
+ *     ./latency_fuzz_libfuzzer fuzz_corpus/
+ *
+ * Cost is instructions per call when hardware counters are available,
+ * else minimum ns per call (noisy; candidate maxima are re-measured).
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "latency_targets.h"
+#include <dirent.h>
+#include <math.h>
+
+#define LT_POOL         8       /* Inputs kept per target while searching */
+#define LT_KEEP         4       /* Inputs written to the corpus per target */
+#define LT_REPS         7       /* Repetitions per measurement (min kept) */
+#define LT_BUCKETS      64      /* Cost buckets per target (libFuzzer) */
+
+static t_bsp_t* lt_bsp;
+static t_bsp_t* lt_snapshot;
+static int lt_use_counters = -1;
+
+static void lt_setup(void) {
+    if (lt_bsp) return;
+    se3_init_tables();
+    lt_bsp = (t_bsp_t*)bench_alloc_aligned(sizeof(t_bsp_t));
+    lt_snapshot = (t_bsp_t*)bench_alloc_aligned(sizeof(t_bsp_t));
+    if (!lt_bsp || !lt_snapshot) abort();
+    lt_use_counters = lt_counters_available();
+}
+
+/** Decode and measure one input; returns its cost. */
+static double lt_cost(const uint8_t* data, size_t size, int* target, int reps) {
+    lt_case_t c = { .bsp = lt_bsp, .snapshot = lt_snapshot };
+    lt_prepare(&c, data, size);
+    *target = c.target;
+    return lt_measure(&c, reps, lt_use_counters);
+}
+
+#ifdef LATENCY_FUZZ_LIBFUZZER
+
+/* ========================================================================
+ * libFuzzer ENTRY: cost buckets as extra coverage
+ * ======================================================================== */
+
+__attribute__((used, section("__libfuzzer_extra_counters")))
+static uint8_t lt_cost_counters[LT_TARGETS][LT_BUCKETS];
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    int target;
+    lt_setup();
+    double cost = lt_cost(data, size, &target, 3);
+    int bucket = (int)(8.0 * log2(1.0 + cost));   /* 8 buckets per doubling */
+    if (bucket >= LT_BUCKETS) bucket = LT_BUCKETS - 1;
+    lt_cost_counters[target][bucket] = 1;
+    return 0;
+}
+
+#else
+
+/* ========================================================================
+ * STANDALONE HILL CLIMBER
+ * ======================================================================== */
+
+typedef struct {
+    uint8_t data[LT_MAX_INPUT];
+    size_t size;
+    double cost;
+} lt_entry_t;
+
+static lt_entry_t pool[LT_TARGETS][LT_POOL];
+static int pool_n[LT_TARGETS];
+static uint32_t rng = 0x5eed;
+
+static uint32_t rnd(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+/* Values that tend to sit on loop and range boundaries */
+static const int32_t interesting32[] = {
+    0, 1, -1, INT32_MAX, INT32_MIN, INT32_MAX - 1, INT32_MIN + 1,
+    FLOAT_TO_FIXED(180.0f), -FLOAT_TO_FIXED(180.0f), FLOAT_TO_FIXED(360.0f),
+    -FLOAT_TO_FIXED(360.0f), FLOAT_TO_FIXED(270.0f), -FLOAT_TO_FIXED(90.0f)
+};
+
+static void mutate(lt_entry_t* e, int target) {
+    int rounds = 1 + (int)(rnd() % 4);
+    e->data[0] = (uint8_t)target;
+    if (target != LT_INSERT && e->size < 5) e->size = 5;
+    for (int r = 0; r < rounds; r++) {
+        size_t body = e->size > 1 ? e->size - 1 : 1;
+        size_t at = 1 + rnd() % body;
+        switch (rnd() % 8) {
+        case 0:     /* Bit flip */
+            e->data[at] ^= (uint8_t)(1u << (rnd() % 8));
+            break;
+        case 1:     /* Random byte */
+            e->data[at] = (uint8_t)rnd();
+            break;
+        case 2:     /* Small add to a 32-bit field */
+        case 3: {   /* Interesting 32-bit value */
+            if (target == LT_INSERT) {
+                e->data[at] = (uint8_t)(e->data[at] + (rnd() % 16) - 8);
+                break;
+            }
+            int32_t v = lt_le32(e->data + 1);
+            v = (rnd() & 1) ? (int32_t)((uint32_t)v + (rnd() % 0x20000) - 0x10000)
+                            : interesting32[rnd() % (sizeof(interesting32) / sizeof(int32_t))];
+            for (int k = 0; k < 4; k++) e->data[1 + k] = (uint8_t)((uint32_t)v >> (8 * k));
+            break;
+        }
+        case 4:     /* Append 1-8 cell IDs (grow occupancy) */
+        case 5:
+            if (target == LT_INSERT) {
+                int add = 1 + (int)(rnd() % 8);
+                if (e->size < 4) e->size = 4;
+                for (int k = 0; k < add && e->size + 2 <= sizeof(e->data); k++) {
+                    uint16_t id = (uint16_t)rnd();
+                    e->data[e->size++] = (uint8_t)id;
+                    e->data[e->size++] = (uint8_t)(id >> 8);
+                }
+            }
+            break;
+        case 6:     /* Drop the last cell ID */
+            if (target == LT_INSERT && e->size >= 6) e->size -= 2;
+            break;
+        default:    /* Toggle re-centering */
+            if (target == LT_INSERT) {
+                if (e->size < 4) e->size = 4;
+                e->data[1] ^= 1;
+                e->data[2] = (uint8_t)(rnd() % 7 - 3);
+                e->data[3] = (uint8_t)(rnd() % 7 - 3);
+            }
+            break;
+        }
+    }
+}
+
+/* Keep the LT_POOL most expensive inputs per target (unique contents) */
+static void pool_offer(int target, const lt_entry_t* e) {
+    lt_entry_t* p = pool[target];
+    int n = pool_n[target];
+    for (int i = 0; i < n; i++) {
+        if (p[i].size == e->size && memcmp(p[i].data, e->data, e->size) == 0) {
+            if (e->cost > p[i].cost) p[i].cost = e->cost;
+            return;
+        }
+    }
+    int slot = n;
+    if (n == LT_POOL) {
+        slot = 0;
+        for (int i = 1; i < n; i++) if (p[i].cost < p[slot].cost) slot = i;
+        if (e->cost <= p[slot].cost) return;
+    } else {
+        pool_n[target]++;
+    }
+    p[slot] = *e;
+}
+
+static int by_cost_desc(const void* a, const void* b) {
+    double d = ((const lt_entry_t*)b)->cost - ((const lt_entry_t*)a)->cost;
+    return (d > 0) - (d < 0);
+}
+
+static void load_corpus(const char* dir) {
+    DIR* d = opendir(dir);
+    struct dirent* ent;
+    if (!d) return;
+    while ((ent = readdir(d)) != NULL) {
+        char path[512];
+        if (ent->d_name[0] == '.') continue;
+        snprintf(path, sizeof(path), "%s/%s", dir, ent->d_name);
+        FILE* f = fopen(path, "rb");
+        if (!f) continue;
+        lt_entry_t e;
+        e.size = fread(e.data, 1, sizeof(e.data), f);
+        fclose(f);
+        int target;
+        e.cost = lt_cost(e.data, e.size, &target, LT_REPS);
+        pool_offer(target, &e);
+    }
+    closedir(d);
+}
+
+static void save_corpus(const char* dir) {
+    for (int t = 0; t < LT_TARGETS; t++) {
+        qsort(pool[t], (size_t)pool_n[t], sizeof(lt_entry_t), by_cost_desc);
+        for (int i = 0; i < pool_n[t] && i < LT_KEEP; i++) {
+            char path[512];
+            snprintf(path, sizeof(path), "%s/%s-%d.bin", dir, lt_target_names[t], i);
+            FILE* f = fopen(path, "wb");
+            if (!f) {
+                printf("  cannot write %s\n", path);
+                continue;
+            }
+            fwrite(pool[t][i].data, 1, pool[t][i].size, f);
+            fclose(f);
+        }
+    }
+}
+
+/* Typical cost: in-range arguments, or random IDs into a partly filled grid */
+static double typical_cost(int target) {
+    double sum = 0.0;
+    const int samples = 200;
+    for (int s = 0; s < samples; s++) {
+        lt_entry_t e;
+        lt_typical_input(e.data, &e.size, target, rnd);
+        int t;
+        sum += lt_cost(e.data, e.size, &t, 3);
+    }
+    return sum / samples;
+}
+
+static void describe(int target, const lt_entry_t* e) {
+    if (target != LT_INSERT) {
+        printf("arg=%d (%.1f deg)", lt_le32(e->data + 1), FIXED_TO_FLOAT(lt_le32(e->data + 1)));
+        return;
+    }
+    lt_case_t c = { .bsp = lt_bsp, .snapshot = lt_snapshot };
+    lt_prepare(&c, e->data, e->size);
+    printf("%d active cells, %s, id 0x%04x %s", c.bsp->active_count,
+           c.bsp->recentering ? "re-centering" : "steady",
+           c.measured_id, t_bsp_get_cell(c.bsp, c.measured_id) ? "(hit)" : "(miss)");
+}
+
+int main(int argc, char** argv) {
+    long iterations = argc > 1 ? atol(argv[1]) : 300000;
+    const char* dir = argc > 2 ? argv[2] : "fuzz_corpus";
+
+    printf("======================================================================\n");
+    printf("LATENCY-GUIDED FUZZING (worst-case inputs)\n");
+    printf("======================================================================\n");
+    lt_setup();
+    printf("Cost unit: %s; %ld iterations; corpus: %s/\n",
+           lt_use_counters ? "instructions/call" : "min ns/call (no hardware counters)",
+           iterations, dir);
+
+    load_corpus(dir);
+    for (int t = 0; t < LT_TARGETS; t++) {
+        lt_entry_t seed = { .size = t == LT_INSERT ? 6 : 5 };
+        seed.data[0] = (uint8_t)t;
+        int tt;
+        seed.cost = lt_cost(seed.data, seed.size, &tt, LT_REPS);
+        pool_offer(t, &seed);
+    }
+
+    uint64_t t0 = bench_now_ns();
+    for (long it = 0; it < iterations; it++) {
+        int target = (int)(it % LT_TARGETS);
+        lt_entry_t e = pool[target][rnd() % (uint32_t)pool_n[target]];
+        mutate(&e, target);
+        int t;
+        e.cost = lt_cost(e.data, e.size, &t, 3);
+
+        double best = 0.0;
+        for (int i = 0; i < pool_n[target]; i++) if (pool[target][i].cost > best) best = pool[target][i].cost;
+        if (e.cost > best && !lt_use_counters) {
+            e.cost = lt_cost(e.data, e.size, &t, LT_REPS * 3);   /* Confirm: not a timer blip */
+        }
+        pool_offer(target, &e);
+    }
+    double secs = (double)(bench_now_ns() - t0) / 1e9;
+    printf("Search: %.1f s (%.0f execs/s)\n", secs, iterations / secs);
+
+    /* Re-measure the survivors carefully before reporting and saving */
+    for (int t = 0; t < LT_TARGETS; t++) {
+        for (int i = 0; i < pool_n[t]; i++) {
+            int tt;
+            pool[t][i].cost = lt_cost(pool[t][i].data, pool[t][i].size, &tt, LT_REPS * 5);
+        }
+    }
+    save_corpus(dir);
+
+    printf("\n  %-20s %12s %12s %8s  worst input\n", "target", "typical", "worst", "ratio");
+    for (int t = 0; t < LT_TARGETS; t++) {
+        double typ = typical_cost(t);
+        const lt_entry_t* w = &pool[t][0];
+        printf("  %-20s %12.1f %12.1f %7.1fx  ", lt_target_names[t], typ, w->cost,
+               typ > 0 ? w->cost / typ : 0.0);
+        describe(t, w);
+        printf("\n");
+    }
+    return 0;
+}
+
+#endif /* LATENCY_FUZZ_LIBFUZZER */
@@ -0,0 +1,199 @@
+/*
+ * latency_targets.h - Input-Dependent-Cost Targets for Latency Fuzzing
+ *
+ * Shared by latency_fuzz.c (finds slow inputs) and worst_case_bench.c
+ * (replays them), so a corpus file means the same thing to both.
+ *
+ * Input format (corpus files, libFuzzer inputs):
+ *   byte 0        target selector (mod LT_TARGETS)
+ *   LT_NORMALIZE_LON   bytes 1..4   int32 LE longitude (16.16 degrees)
+ *   LT_HEADING         bytes 1..4   int32 LE heading (16.16 degrees)
+ *   LT_INSERT          byte 1       flags: bit 0 = begin re-center before
+ *                                   the measured insert
+ *                      bytes 2..3   int8 re-center shift (lat, lon cells)
+ *                      bytes 4..    uint16 LE cell IDs: all but the last
+ *                                   are inserted to set occupancy, the
+ *                                   last is the measured insert
+ * Short inputs are zero-padded.
+ *
+ * Cost = user-space instructions per call when hardware counters are
+ * available (bench_harness.h), else the minimum ns/call over repetitions
+ * (for inserts, net of the header restore that makes them repeatable).
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#ifndef LATENCY_TARGETS_H
+#define LATENCY_TARGETS_H
+
+#include "../embedded/se3_edge.h"
+#include "../embedded/t_bsp.h"
+#include "bench_harness.h"
+#include <stddef.h>
+
+#define LT_TARGETS          3
+#define LT_NORMALIZE_LON    0
+#define LT_HEADING          1
+#define LT_INSERT           2
+
+#define LT_MAX_PREFIX       (2 * MAX_CELLS)     /* Occupancy-setting inserts */
+#define LT_MAX_INPUT        (4 + 2 * (LT_MAX_PREFIX + 1))
+
+static const char* const lt_target_names[LT_TARGETS] = {
+    "normalize_lon", "heading_to_angle", "t_bsp_insert_pose"
+};
+
+/* One decoded input, ready to run repeatedly */
+typedef struct {
+    int target;
+    int32_t arg;                    /* normalize_lon / heading_to_angle */
+    uint16_t measured_id;           /* LT_INSERT: the timed insert */
+    t_bsp_t* bsp;                   /* LT_INSERT: state before the timed insert */
+    t_bsp_t* snapshot;              /* LT_INSERT: header copy for lt_reset() */
+} lt_case_t;
+
+/* Header region of t_bsp_t: everything an insert can change except the slab */
+#define LT_BSP_HEADER_BYTES   offsetof(t_bsp_t, poses)
+
+static inline int32_t lt_le32(const uint8_t* p) {
+    return (int32_t)((uint32_t)p[0] | (uint32_t)p[1] << 8 |
+                     (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24);
+}
+
+/**
+ * Decode an input (state for LT_INSERT is built in c->bsp).
+ *
+ * @param c Case; c->bsp and c->snapshot must point at two t_bsp_t
+ * @param data Input bytes
+ * @param size Input length (may be 0)
+ */
+static inline void lt_prepare(lt_case_t* c, const uint8_t* data, size_t size) {
+    uint8_t buf[LT_MAX_INPUT];
+    size_t n = size < sizeof(buf) ? size : sizeof(buf);
+    memset(buf, 0, sizeof(buf));
+    if (n) memcpy(buf, data, n);
+
+    c->target = buf[0] % LT_TARGETS;
+    c->arg = lt_le32(buf + 1);
+    if (c->target != LT_INSERT) return;
+
+    t_bsp_init(c->bsp, 0, 0);
+    se3_pose_t pose;
+    se3_pose_identity(&pose);
+    int ids = n > 4 ? (int)(n - 4) / 2 : 0;
+    if (ids > LT_MAX_PREFIX + 1) ids = LT_MAX_PREFIX + 1;
+    for (int i = 0; i + 1 < ids; i++) {
+        t_bsp_insert_pose(c->bsp, (uint16_t)(buf[4 + 2 * i] | buf[5 + 2 * i] << 8), &pose);
+    }
+    c->measured_id = ids ? (uint16_t)(buf[4 + 2 * (ids - 1)] | buf[5 + 2 * (ids - 1)] << 8) : 0;
+    if (buf[1] & 1) {
+        /* Shift the window center by whole cells (0.09° ≈ one 10 km cell) */
+        t_bsp_recenter_begin(c->bsp, (int8_t)buf[2] * FLOAT_TO_FIXED(0.09f),
+                             (int8_t)buf[3] * FLOAT_TO_FIXED(0.09f));
+    }
+    memcpy(c->snapshot, c->bsp, LT_BSP_HEADER_BYTES);
+}
+
+/** Undo the measured call's side effects (LT_INSERT only). */
+static inline void lt_reset(lt_case_t* c) {
+    if (c->target == LT_INSERT) memcpy(c->bsp, c->snapshot, LT_BSP_HEADER_BYTES);
+}
+
+/** Run the measured call once. */
+static inline void lt_run(lt_case_t* c) {
+    static se3_pose_t pose;
+    switch (c->target) {
+    case LT_NORMALIZE_LON:
+        bench_sink += (uint64_t)normalize_lon(c->arg);
+        break;
+    case LT_HEADING:
+        bench_sink += heading_to_angle(c->arg);
+        break;
+    default:
+        bench_sink += t_bsp_insert_pose(c->bsp, c->measured_id, &pose);
+        break;
+    }
+}
+
+/**
+ * Measure one case.
+ *
+ * @param c Prepared case
+ * @param reps Repetitions; the minimum is kept (noise only adds time)
+ * @param use_counters Count instructions instead of nanoseconds
+ * @return Instructions or ns per call
+ */
+static inline double lt_measure(lt_case_t* c, int reps, int use_counters) {
+    /* Timed in blocks to rise above clock resolution; inserts need a
+     * header restore per call, timed separately and subtracted */
+    enum { BLOCK = 32 };
+    double best = 0.0, best_reset = 0.0;
+    for (int r = 0; r < reps; r++) {
+        double cost;
+        if (use_counters) {
+            uint64_t ctr[BENCH_NCOUNTERS];
+            lt_reset(c);
+            bench_counters_start();
+            lt_run(c);
+            bench_counters_stop(ctr);
+            cost = (double)ctr[BENCH_CTR_INSTRUCTIONS];
+        } else {
+            uint64_t t0 = bench_now_ns();
+            for (int k = 0; k < BLOCK; k++) {
+                lt_reset(c);
+                lt_run(c);
+            }
+            cost = (double)(bench_now_ns() - t0) / BLOCK;
+            if (c->target == LT_INSERT) {
+                t0 = bench_now_ns();
+                for (int k = 0; k < BLOCK; k++) {
+                    lt_reset(c);
+                    bench_sink += c->bsp->active_count;
+                }
+                double reset = (double)(bench_now_ns() - t0) / BLOCK;
+                if (r == 0 || reset < best_reset) best_reset = reset;
+            }
+        }
+        if (r == 0 || cost < best) best = cost;
+    }
+    return best > best_reset ? best - best_reset : 0.0;
+}
+
+/**
+ * Build a typical (non-adversarial) input: an argument within ±360°, or
+ * 1-32 random cell IDs with no re-centering.
+ *
+ * @param data Output buffer (LT_MAX_INPUT bytes)
+ * @param size Output length
+ * @param target Target selector
+ * @param rnd Random source
+ */
+static inline void lt_typical_input(uint8_t* data, size_t* size, int target,
+                                    uint32_t (*rnd)(void)) {
+    memset(data, 0, LT_MAX_INPUT);
+    data[0] = (uint8_t)target;
+    if (target != LT_INSERT) {
+        int32_t v = (int32_t)(rnd() % (2u * (uint32_t)FIXED_360_DEG)) - FIXED_360_DEG;
+        for (int k = 0; k < 4; k++) data[1 + k] = (uint8_t)((uint32_t)v >> (8 * k));
+        *size = 5;
+        return;
+    }
+    int ids = 1 + (int)(rnd() % 32);
+    for (int i = 0; i < ids; i++) {
+        uint16_t id = (uint16_t)rnd();
+        data[4 + 2 * i] = (uint8_t)id;
+        data[5 + 2 * i] = (uint8_t)(id >> 8);
+    }
+    *size = 4 + 2 * (size_t)ids;
+}
+
+/**
+ * Whether instruction counting works (opens counters on first call).
+ */
+static inline int lt_counters_available(void) {
+    setenv("BENCH_COUNTERS", "1", 0);
+    return bench_counters_enabled() && bench_ctr_fd[BENCH_CTR_INSTRUCTIONS] >= 0;
+}
+
+#endif /* LATENCY_TARGETS_H */
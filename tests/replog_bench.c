@@ -0,0 +1,269 @@
+/*
+ * replog_bench.c - Two-Process Primary/Standby Replication Benchmark
+ *
+ * Replays 500 vessels over a ±0.3° area reporting every 10 s for one
+ * hour, and measures:
+ *   1. Primary overhead: t_bsp_insert_pose() alone vs. replog_insert()
+ *   2. Log size: bytes per fix batched vs. one frame per fix vs. raw poses
+ *   3. Primary → standby over an AF_UNIX SOCK_SEQPACKET pair (fork()):
+ *      send and apply throughput, digest check, snapshot size
+ *   4. Failover: standby sees the primary's socket close and promotes
+ *      (pending seals ready, digest verified)
+ *
+ * Built with (see Makefile):
+ *   gcc -O2 -D_GNU_SOURCE -o replog_bench replog_bench.c ../embedded/replog.c \
+ *       ../embedded/t_bsp.c ../embedded/se3_math.c ../embedded/trig_tables.c \
+ *       -I../embedded -lm
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "../embedded/se3_edge.h"
+#include "../embedded/t_bsp.h"
+#include "../embedded/replog.h"
+#include "bench_harness.h"
+#include <math.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define N_VESSELS       500
+#define N_STEPS         360         /* 1 h at 10 s */
+#define N_FIXES         (N_VESSELS * N_STEPS)
+#define AREA_DEG        0.3
+#define SEAL_EVERY      30          /* Steps between seal rounds */
+
+typedef struct {
+    se3_pose_t pose;
+    uint16_t cell_id;
+} replay_fix_t;
+
+static uint32_t rng = 4242;
+static inline uint32_t xrand(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+static inline double urand(void) { return (xrand() & 0xFFFFFF) / (double)0x1000000; }
+
+/* Constant-course vessels; heading (rotation) changes only on bounces */
+static void make_replay(t_bsp_t* bsp, replay_fix_t* fixes) {
+    static double lat[N_VESSELS], lon[N_VESSELS], dlat[N_VESSELS], dlon[N_VESSELS];
+    for (int v = 0; v < N_VESSELS; v++) {
+        double a = urand() * 2.0 * M_PI;
+        double speed = 0.0002 + 0.0008 * urand();
+        lat[v] = (urand() * 2.0 - 1.0) * AREA_DEG;
+        lon[v] = (urand() * 2.0 - 1.0) * AREA_DEG;
+        dlat[v] = speed * sin(a);
+        dlon[v] = speed * cos(a);
+    }
+    for (int i = 0; i < N_FIXES; i++) {
+        int v = i % N_VESSELS;
+        lat[v] += dlat[v];
+        lon[v] += dlon[v];
+        if (fabs(lat[v]) > AREA_DEG) dlat[v] = -dlat[v];
+        if (fabs(lon[v]) > AREA_DEG) dlon[v] = -dlon[v];
+
+        se3_pose_t* p = &fixes[i].pose;
+        memset(p, 0, sizeof(*p));
+        fixed_t heading = FLOAT_TO_FIXED(atan2(dlat[v], dlon[v]));
+        fixed_t c = FLOAT_TO_FIXED(cos(FIXED_TO_FLOAT(heading)));
+        fixed_t s = FLOAT_TO_FIXED(sin(FIXED_TO_FLOAT(heading)));
+        p->rotation[0] = c;  p->rotation[1] = -s;
+        p->rotation[3] = s;  p->rotation[4] = c;
+        p->rotation[8] = FRACUNIT;
+        p->translation[0] = FLOAT_TO_FIXED(lon[v]);
+        p->translation[1] = FLOAT_TO_FIXED(lat[v]);
+        p->timestamp = 1700000000u + (uint32_t)(i / N_VESSELS) * 10u;
+        p->mmsi = 367000000u + (uint32_t)v;
+        fixes[i].cell_id = t_bsp_latlon_to_cell(bsp, p->translation[1], p->translation[0]);
+    }
+}
+
+/* Seal round: hand the fullest cells to λ-estimation, publish the previous round */
+static void seal_round(replog_writer_t* w, t_bsp_t* bsp) {
+    while (w->n_pending > 0) replog_seal_done(w, w->pending[0].cell_id);
+    for (int i = 0; i < MAX_CELLS && w->n_pending < REPLOG_MAX_PENDING / 2; i++) {
+        const t_bsp_cell_t* c = &bsp->cells[i];
+        if (c->active && c->pose_count >= MAX_POSES_PER_CELL / 2) {
+            replog_seal(w, c->cell_id, c->pose_count);
+        }
+    }
+}
+
+static void replay(replog_writer_t* w, t_bsp_t* bsp, const replay_fix_t* fixes, bool flush_each) {
+    for (int i = 0; i < N_FIXES; i++) {
+        replog_insert(w, bsp, fixes[i].cell_id, &fixes[i].pose);
+        if (flush_each) replog_flush(w);
+        if ((i + 1) % N_VESSELS == 0) {
+            replog_flush(w);  /* Bound lag to one report interval */
+            if ((i / N_VESSELS) % SEAL_EVERY == SEAL_EVERY - 1) seal_round(w, bsp);
+        }
+    }
+    replog_flush(w);
+}
+
+static void socket_sink(void* ctx, const uint8_t* frame, size_t len) {
+    int fd = *(int*)ctx;
+    if (send(fd, frame, len, 0) != (ssize_t)len) {
+        perror("send");
+        exit(1);
+    }
+}
+
+/* ========================================================================
+ * STANDBY PROCESS
+ * ======================================================================== */
+
+static int standby_main(int fd) {
+    t_bsp_t* bsp = (t_bsp_t*)bench_alloc_aligned(sizeof(t_bsp_t));
+    static replog_mirror_t m;
+    t_bsp_init(bsp, 0, 0);
+    replog_mirror_init(&m, bsp);
+
+    uint8_t frame[REPLOG_FRAME_MAX];
+    uint32_t primary_digest = 0;
+    uint64_t apply_ns = 0, bytes = 0;
+    int errors = 0;
+    uint64_t t_eof = 0;
+    for (;;) {
+        ssize_t n = recv(fd, frame, sizeof(frame), 0);
+        if (n <= 0) {
+            t_eof = bench_now_ns();  /* Primary gone: promote */
+            break;
+        }
+        if (n == sizeof(uint32_t)) {
+            memcpy(&primary_digest, frame, sizeof(uint32_t));
+            continue;
+        }
+        uint64_t t0 = bench_now_ns();
+        errors += replog_apply(&m, frame, (size_t)n) != REPLOG_OK;
+        apply_ns += bench_now_ns() - t0;
+        bytes += (uint64_t)n;
+    }
+
+    replog_seal_t pending[REPLOG_MAX_PENDING];
+    int n_pending = replog_mirror_pending(&m, pending, REPLOG_MAX_PENDING);
+    uint64_t promote_ns = bench_now_ns() - t_eof;
+    uint32_t digest = replog_digest(bsp);
+    uint64_t verify_ns = bench_now_ns() - t_eof - promote_ns;
+
+    printf("  [standby] %u frames (%.2f MB), %d errors; apply %.1f ns/record, %.0f MB/s\n",
+           m.frames_applied, bytes / 1e6, errors, (double)apply_ns / m.records_applied,
+           bytes / (apply_ns / 1e9) / 1e6);
+    printf("  [standby] digest %08x vs primary %08x: %s\n", digest, primary_digest,
+           digest == primary_digest ? "MATCH" : "MISMATCH");
+    printf("  [standby] promote after EOF: %.1f us (%d pending seals to re-run); "
+           "digest check %.0f us\n", promote_ns / 1e3, n_pending, verify_ns / 1e3);
+    fflush(stdout);
+    free(bsp);
+    return digest == primary_digest && errors == 0 ? 0 : 1;
+}
+
+/* ========================================================================
+ * MAIN (PRIMARY)
+ * ======================================================================== */
+
+static void count_sink(void* ctx, const uint8_t* frame, size_t len) {
+    (void)frame;
+    (void)len;
+    (*(uint32_t*)ctx)++;
+}
+
+int main(void) {
+    printf("======================================================================\n");
+    printf("PRIMARY/STANDBY REPLICATION - HOST BENCHMARKS\n");
+    printf("======================================================================\n");
+
+    se3_init_tables();
+
+    t_bsp_t* bsp = (t_bsp_t*)bench_alloc_aligned(sizeof(t_bsp_t));
+    replay_fix_t* fixes = (replay_fix_t*)malloc(sizeof(replay_fix_t) * N_FIXES);
+    static replog_writer_t w;
+    if (!bsp || !fixes) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+    t_bsp_init(bsp, 0, 0);
+    make_replay(bsp, fixes);
+    printf("Replay: %d vessels, %d fixes, seal round every %d reports; frame %d bytes\n",
+           N_VESSELS, N_FIXES, SEAL_EVERY, REPLOG_FRAME_MAX);
+
+    bench_t b;
+    uint32_t frames = 0;
+    bench_section("Primary overhead (no transport)");
+    bench_begin(&b, "t_bsp_insert_pose");
+    for (int i = 0; i < N_FIXES; i++) {
+        t_bsp_insert_pose(bsp, fixes[i].cell_id, &fixes[i].pose);
+    }
+    double base_ns = bench_end(&b, N_FIXES);
+
+    t_bsp_init(bsp, 0, 0);
+    replog_writer_init(&w, count_sink, &frames);
+    bench_begin(&b, "replog_insert (batched)");
+    replay(&w, bsp, fixes, false);
+    double log_ns = bench_end(&b, N_FIXES);
+    double batched = (double)w.bytes_sent / N_FIXES;
+    printf("  overhead: +%.1f ns/fix; %u frames\n", log_ns - base_ns, frames);
+
+    t_bsp_init(bsp, 0, 0);
+    replog_writer_init(&w, count_sink, &frames);
+    replay(&w, bsp, fixes, true);
+    double unbatched = (double)w.bytes_sent / N_FIXES;
+
+    bench_section("Log size per fix");
+    printf("  raw se3_pose_t + cell ID: %zu bytes\n", sizeof(se3_pose_t) + sizeof(uint16_t));
+    printf("  one frame per fix:        %.1f bytes\n", unbatched);
+    printf("  batched (%d-byte frames): %.1f bytes (%.1f× smaller than raw)\n", REPLOG_FRAME_MAX,
+           batched, (sizeof(se3_pose_t) + sizeof(uint16_t)) / batched);
+    printf("  bandwidth at %d vessels / 10 s: %.0f B/s\n", N_VESSELS,
+           batched * N_VESSELS / 10.0);
+
+    /* Two processes: fork a standby on a SOCK_SEQPACKET pair */
+    bench_section("Primary → standby (fork, AF_UNIX SOCK_SEQPACKET)");
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv) != 0) {
+        perror("socketpair");
+        return 1;
+    }
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return 1;
+    }
+    if (pid == 0) {
+        close(sv[0]);
+        _exit(standby_main(sv[1]));
+    }
+    close(sv[1]);
+
+    t_bsp_init(bsp, 0, 0);
+    replog_writer_init(&w, socket_sink, &sv[0]);
+    replog_snapshot(&w, bsp);
+    bench_begin(&b, "primary: replog_insert + send");
+    replay(&w, bsp, fixes, false);
+    bench_end(&b, N_FIXES);
+
+    uint64_t before = w.bytes_sent;
+    uint32_t frames_before = w.frames_sent;
+    replog_snapshot(&w, bsp);  /* Mid-stream resync cost, full grid */
+    printf("  snapshot of %u cells: %.1f KB in %u frames\n", bsp->active_count,
+           (w.bytes_sent - before) / 1024.0, w.frames_sent - frames_before);
+
+    uint32_t digest = replog_digest(bsp);
+    send(sv[0], &digest, sizeof(digest), 0);
+    fflush(stdout);
+    close(sv[0]);  /* Simulated primary failure */
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    int ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    printf("  standby %s\n", ok ? "in sync" : "FAILED");
+
+    free(fixes);
+    free(bsp);
+    return ok ? 0 : 1;
+}
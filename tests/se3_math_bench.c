@@ -0,0 +1,193 @@
+/*
+ * se3_math_bench.c - Host Benchmarks for SE(3) Fixed-Point Math
+ *
+ * Measures:
+ *   1. Pose construction: yaw-only vs. full 3D attitude (Euler, quaternion)
+ *   2. Batch rotation construction
+ *   3. SE(3) group operations per pose (native vs. primitive composition)
+ *
+ * Compile with:
+ *   gcc -O2 -D_GNU_SOURCE -o se3_math_bench se3_math_bench.c \
+ *       ../embedded/se3_math.c ../embedded/trig_tables.c \
+ *       ../embedded/se3_group.c -I../embedded -lm
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "../embedded/se3_edge.h"
+#include "bench_harness.h"
+
+#define N_FIXES   4096
+#define ROUNDS    256
+
+static fixed_t headings[N_FIXES], rolls[N_FIXES], pitches[N_FIXES];
+static uint32_t roll_angles[N_FIXES], pitch_angles[N_FIXES], yaw_angles[N_FIXES];
+static fixed_t quats[N_FIXES * 4];
+static fixed_t rot_out[N_FIXES * 9];
+static se3_pose_t poses[N_FIXES];
+
+static void init_inputs(void) {
+    srand(12345);
+    for (int i = 0; i < N_FIXES; i++) {
+        headings[i] = (fixed_t)(rand() % (360 * FRACUNIT));
+        rolls[i] = (fixed_t)(rand() % (60 * FRACUNIT)) - 30 * FRACUNIT;
+        pitches[i] = (fixed_t)(rand() % (40 * FRACUNIT)) - 20 * FRACUNIT;
+        roll_angles[i] = degrees_to_angle(rolls[i]);
+        pitch_angles[i] = degrees_to_angle(pitches[i]);
+        yaw_angles[i] = heading_to_angle(headings[i]);
+        /* Half-angle quaternion about a tilted axis, roughly unit norm */
+        quats[i * 4 + 0] = Cos_from_LUT(yaw_angles[i] >> 1);
+        quats[i * 4 + 1] = FixedMul(Sin_from_LUT(yaw_angles[i] >> 1), FLOAT_TO_FIXED(0.1f));
+        quats[i * 4 + 2] = FixedMul(Sin_from_LUT(yaw_angles[i] >> 1), FLOAT_TO_FIXED(0.1f));
+        quats[i * 4 + 3] = FixedMul(Sin_from_LUT(yaw_angles[i] >> 1), FLOAT_TO_FIXED(0.99f));
+    }
+}
+
+static void bench_pose_construction(void) {
+    bench_t b;
+    const uint64_t ops = (uint64_t)N_FIXES * ROUNDS;
+    bench_section("Pose construction (yaw-only vs. 3D attitude)");
+
+    bench_begin(&b, "se3_pose_from_gps (yaw only)");
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < N_FIXES; i++) {
+            se3_pose_from_gps(i, i, 0, headings[i], 0, 1, &poses[i]);
+        }
+        bench_sink += (uint64_t)poses[r].rotation[0];
+    }
+    double yaw_ns = bench_end(&b, ops);
+
+    bench_begin(&b, "se3_pose_from_attitude (roll/pitch/yaw)");
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < N_FIXES; i++) {
+            se3_pose_from_attitude(i, i, 0, rolls[i], pitches[i], headings[i], 0, 1, &poses[i]);
+        }
+        bench_sink += (uint64_t)poses[r].rotation[0];
+    }
+    double att_ns = bench_end(&b, ops);
+    printf("  %-44s %12.2fx (target <= 2x)\n", "attitude / yaw-only ratio", att_ns / yaw_ns);
+
+    bench_begin(&b, "rotation_from_yaw");
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < N_FIXES; i++) {
+            rotation_from_yaw(yaw_angles[i], &rot_out[i * 9]);
+        }
+        bench_sink += (uint64_t)rot_out[r];
+    }
+    bench_end(&b, ops);
+
+    bench_begin(&b, "rotation_from_euler_batch");
+    for (int r = 0; r < ROUNDS; r++) {
+        rotation_from_euler_batch(roll_angles, pitch_angles, yaw_angles, N_FIXES, rot_out);
+        bench_sink += (uint64_t)rot_out[r];
+    }
+    bench_end(&b, ops);
+
+    bench_begin(&b, "rotation_from_quaternion_batch");
+    for (int r = 0; r < ROUNDS; r++) {
+        rotation_from_quaternion_batch(quats, N_FIXES, rot_out);
+        bench_sink += (uint64_t)rot_out[r];
+    }
+    bench_end(&b, ops);
+
+    bench_begin(&b, "rotation_renormalize");
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < N_FIXES; i++) {
+            rotation_renormalize(&rot_out[i * 9]);
+        }
+        bench_sink += (uint64_t)rot_out[r];
+    }
+    bench_end(&b, ops);
+}
+
+/* Composition built from the pre-existing primitives (baseline) */
+static void naive_compose(const se3_pose_t* a, const se3_pose_t* b, se3_pose_t* out) {
+    fixed_t R[9], t[3];
+    rotation_mul(a->rotation, b->rotation, R);
+    mat3_mul_vec3(a->rotation, b->translation, t);
+    memcpy(out->rotation, R, sizeof(R));
+    out->translation[0] = t[0] + a->translation[0];
+    out->translation[1] = t[1] + a->translation[1];
+    out->translation[2] = t[2] + a->translation[2];
+    out->timestamp = b->timestamp;
+    out->mmsi = b->mmsi;
+}
+
+static se3_pose_t group_a[N_FIXES], group_b[N_FIXES], group_out[N_FIXES];
+static fixed_t points[N_FIXES * 3], points_out[N_FIXES * 3];
+
+static void bench_group_ops(void) {
+    bench_t b;
+    const uint64_t ops = (uint64_t)N_FIXES * ROUNDS;
+    bench_section("SE(3) group operations (per pose)");
+
+    for (int i = 0; i < N_FIXES; i++) {
+        se3_pose_from_attitude(i * 16, i * 8, 0, rolls[i], pitches[i], headings[i],
+                               (uint32_t)i, 1, &group_a[i]);
+        se3_pose_from_attitude(-i * 8, i * 4, 0, pitches[i], rolls[i], headings[N_FIXES - 1 - i],
+                               (uint32_t)i, 1, &group_b[i]);
+        points[i * 3 + 0] = i * FRACUNIT;
+        points[i * 3 + 1] = -i * FRACUNIT;
+        points[i * 3 + 2] = FRACUNIT;
+    }
+
+    bench_begin(&b, "compose (rotation_mul + mat3_mul_vec3)");
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < N_FIXES; i++) naive_compose(&group_a[i], &group_b[i], &group_out[i]);
+        bench_sink += (uint64_t)group_out[r].translation[0];
+    }
+    bench_end(&b, ops);
+
+    bench_begin(&b, "se3_compose");
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < N_FIXES; i++) se3_compose(&group_a[i], &group_b[i], &group_out[i]);
+        bench_sink += (uint64_t)group_out[r].translation[0];
+    }
+    bench_end(&b, ops);
+
+    bench_begin(&b, "se3_compose_batch");
+    for (int r = 0; r < ROUNDS; r++) {
+        se3_compose_batch(group_a, group_b, N_FIXES, group_out);
+        bench_sink += (uint64_t)group_out[r].translation[0];
+    }
+    bench_end(&b, ops);
+
+    bench_begin(&b, "se3_inverse_batch");
+    for (int r = 0; r < ROUNDS; r++) {
+        se3_inverse_batch(group_a, N_FIXES, group_out);
+        bench_sink += (uint64_t)group_out[r].translation[0];
+    }
+    bench_end(&b, ops);
+
+    bench_begin(&b, "se3_relative_batch");
+    for (int r = 0; r < ROUNDS; r++) {
+        se3_relative_batch(group_a, N_FIXES, group_out);
+        bench_sink += (uint64_t)group_out[r].translation[0];
+    }
+    bench_end(&b, ops);
+
+    bench_begin(&b, "se3_transform_points (per point)");
+    for (int r = 0; r < ROUNDS; r++) {
+        se3_transform_points(&group_a[r], points, N_FIXES, points_out);
+        bench_sink += (uint64_t)points_out[r];
+    }
+    bench_end(&b, ops);
+}
+
+/* ========================================================================
+ * MAIN
+ * ======================================================================== */
+
+int main(void) {
+    printf("======================================================================\n");
+    printf("SE(3) FIXED-POINT MATHEMATICS - HOST BENCHMARKS\n");
+    printf("======================================================================\n");
+
+    se3_init_tables();
+    init_inputs();
+
+    bench_pose_construction();
+    bench_group_ops();
+    return 0;
+}
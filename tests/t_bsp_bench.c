@@ -0,0 +1,525 @@
+/*
+ * t_bsp_bench.c - Host Benchmarks for T-BSP Spatial Partitioning
+ *
+ * Measures:
+ *   1. Cell scans (lookup miss, sweep) with warm and cold caches
+ *   2. Hot/cold split header array vs. legacy inline-pose cell layout
+ *   3. Pose insertion throughput
+ *   4. Multi-cell λ-estimation: gather view vs. per-fragment copy+estimate
+ *   5. Insert latency while the grid is re-centered online
+ *   6. Same-cell fast path on fix replays: hit rate and classify/insert
+ *      throughput, t_bsp_locate() vs. t_bsp_latlon_to_cell()
+ *
+ * Compile with:
+ *   gcc -O2 -D_GNU_SOURCE -o t_bsp_bench t_bsp_bench.c \
+ *       ../embedded/se3_math.c ../embedded/trig_tables.c \
+ *       ../embedded/se3_group.c ../embedded/lambda_estimator.c \
+ *       ../embedded/t_bsp.c ../embedded/handoff.c -I../embedded -lm
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "../embedded/se3_edge.h"
+#include "../embedded/t_bsp.h"
+#include "bench_harness.h"
+#include <math.h>
+
+#define COLD_TRIALS   200
+#define WARM_ITERS    200000
+#define TRACK_ITERS   200
+
+/* ========================================================================
+ * LEGACY LAYOUT (pre hot/cold split) - reference for comparison only
+ * ======================================================================== */
+
+typedef struct {
+    fixed_t lat_min, lat_max;
+    fixed_t lon_min, lon_max;
+    uint16_t cell_id;
+    uint16_t pose_count;
+    bool active;
+    uint8_t _padding[3];
+    se3_pose_t poses[MAX_POSES_PER_CELL];
+} legacy_cell_t;
+
+typedef struct {
+    legacy_cell_t cells[MAX_CELLS];
+    uint16_t active_count;
+} legacy_bsp_t;
+
+static legacy_cell_t* legacy_get_cell(legacy_bsp_t* bsp, uint16_t cell_id) {
+    for (int i = 0; i < MAX_CELLS; i++) {
+        if (bsp->cells[i].active && bsp->cells[i].cell_id == cell_id) {
+            return &bsp->cells[i];
+        }
+    }
+    return NULL;
+}
+
+static uint32_t legacy_sweep(const legacy_bsp_t* bsp) {
+    uint32_t total = 0;
+    for (int i = 0; i < MAX_CELLS; i++) {
+        if (bsp->cells[i].active) total += bsp->cells[i].pose_count;
+    }
+    return total;
+}
+
+static uint32_t split_sweep(const t_bsp_t* bsp) {
+    uint32_t total = 0;
+    for (int i = 0; i < MAX_CELLS; i++) {
+        if (bsp->cells[i].active) total += bsp->cells[i].pose_count;
+    }
+    return total;
+}
+
+/* ========================================================================
+ * BENCHMARKS
+ * ======================================================================== */
+
+static void fill_all_cells(t_bsp_t* bsp, legacy_bsp_t* legacy) {
+    se3_pose_t pose;
+    se3_pose_identity(&pose);
+    memset(legacy, 0, sizeof(*legacy));
+    for (int i = 0; i < MAX_CELLS; i++) {
+        uint16_t id = (uint16_t)(i + 1);
+        t_bsp_insert_pose(bsp, id, &pose);
+        legacy->cells[i].cell_id = id;
+        legacy->cells[i].active = true;
+        legacy->cells[i].pose_count = 1;
+        legacy->cells[i].poses[0] = pose;
+    }
+    legacy->active_count = MAX_CELLS;
+}
+
+static void bench_cold_scans(t_bsp_t* bsp, legacy_bsp_t* legacy) {
+    bench_section("Cold-cache cell scans (caches evicted before each scan)");
+    printf("  header array: %zu bytes, legacy stride: %zu bytes\n",
+           sizeof(bsp->cells), sizeof(legacy_cell_t));
+
+    uint64_t split_ns = 0, legacy_ns = 0;
+    for (int t = 0; t < COLD_TRIALS; t++) {
+        bench_evict_caches();
+        uint64_t t0 = bench_now_ns();
+        bench_sink += (uintptr_t)t_bsp_get_cell(bsp, 0xBEEF);
+        split_ns += bench_now_ns() - t0;
+
+        bench_evict_caches();
+        t0 = bench_now_ns();
+        bench_sink += (uintptr_t)legacy_get_cell(legacy, 0xBEEF);
+        legacy_ns += bench_now_ns() - t0;
+    }
+    printf("  %-44s %12.2f ns/scan\n", "t_bsp_get_cell miss (split headers)",
+           (double)split_ns / COLD_TRIALS);
+    printf("  %-44s %12.2f ns/scan\n", "t_bsp_get_cell miss (legacy inline poses)",
+           (double)legacy_ns / COLD_TRIALS);
+
+    split_ns = legacy_ns = 0;
+    for (int t = 0; t < COLD_TRIALS; t++) {
+        bench_evict_caches();
+        uint64_t t0 = bench_now_ns();
+        bench_sink += split_sweep(bsp);
+        split_ns += bench_now_ns() - t0;
+
+        bench_evict_caches();
+        t0 = bench_now_ns();
+        bench_sink += legacy_sweep(legacy);
+        legacy_ns += bench_now_ns() - t0;
+    }
+    printf("  %-44s %12.2f ns/scan\n", "pose_count sweep (split headers)",
+           (double)split_ns / COLD_TRIALS);
+    printf("  %-44s %12.2f ns/scan\n", "pose_count sweep (legacy inline poses)",
+           (double)legacy_ns / COLD_TRIALS);
+}
+
+static void bench_warm_scans(t_bsp_t* bsp, legacy_bsp_t* legacy) {
+    bench_t b;
+    bench_section("Warm-cache cell scans");
+
+    bench_begin(&b, "t_bsp_get_cell miss (split headers)");
+    for (int i = 0; i < WARM_ITERS; i++) {
+        bench_sink += (uintptr_t)t_bsp_get_cell(bsp, (uint16_t)(0x8000 | (i & 0xFF)));
+    }
+    bench_end(&b, WARM_ITERS);
+
+    bench_begin(&b, "t_bsp_get_cell miss (legacy inline poses)");
+    for (int i = 0; i < WARM_ITERS; i++) {
+        bench_sink += (uintptr_t)legacy_get_cell(legacy, (uint16_t)(0x8000 | (i & 0xFF)));
+    }
+    bench_end(&b, WARM_ITERS);
+}
+
+static void bench_insert(t_bsp_t* bsp) {
+    bench_t b;
+    bench_section("Pose insertion");
+
+    se3_pose_t pose;
+    se3_pose_identity(&pose);
+    t_bsp_init(bsp, 0, 0);
+
+    bench_begin(&b, "t_bsp_insert_pose (16 active cells)");
+    for (int i = 0; i < WARM_ITERS; i++) {
+        t_bsp_insert_pose(bsp, (uint16_t)(i & 15), &pose);
+    }
+    bench_end(&b, WARM_ITERS);
+
+    bench_begin(&b, "t_bsp_insert_pose (64 active cells)");
+    for (int i = 0; i < WARM_ITERS; i++) {
+        t_bsp_insert_pose(bsp, (uint16_t)(i & 63), &pose);
+    }
+    bench_end(&b, WARM_ITERS);
+}
+
+/* ========================================================================
+ * MULTI-CELL λ-ESTIMATION
+ * ======================================================================== */
+
+#define TRACK_MMSI    367000001u
+
+/*
+ * One vessel crossing W → C → E (30 fixes per cell, 2° turn per fix),
+ * interleaved with 3 other vessels in the same cells (120 poses/cell).
+ */
+static void fill_crossing(t_bsp_t* bsp) {
+    const uint16_t cells[3] = { 0x00FF, 0x0000, 0x0001 };
+    t_bsp_init(bsp, 0, 0);
+    se3_pose_t pose, step, next;
+    se3_pose_identity(&pose);
+    se3_pose_from_gps(FLOAT_TO_FIXED(30.0f), 0, 0, FLOAT_TO_FIXED(272.0f), 0, 0, &step);
+    for (uint32_t i = 0; i < 90; i++) {
+        pose.timestamp = 1000 + i;
+        pose.mmsi = TRACK_MMSI;
+        t_bsp_insert_pose(bsp, cells[i / 30], &pose);
+        for (uint32_t other = 1; other <= 3; other++) {
+            se3_pose_t o = pose;
+            o.mmsi = TRACK_MMSI + other;
+            t_bsp_insert_pose(bsp, cells[i / 30], &o);
+        }
+        se3_compose(&pose, &step, &next);
+        pose = next;
+    }
+}
+
+/* Baseline: copy this vessel's fixes out of one cell (contiguous buffer) */
+static int copy_fragment(t_bsp_t* bsp, uint16_t cell_id, se3_pose_t* out) {
+    t_bsp_cell_t* cell = t_bsp_get_cell(bsp, cell_id);
+    if (!cell) return 0;
+    const se3_pose_t* slab = t_bsp_cell_poses(bsp, cell);
+    int n = 0;
+    for (int i = 0; i < cell->pose_count; i++) {
+        if (slab[i].mmsi == TRACK_MMSI) out[n++] = slab[i];
+    }
+    return n;
+}
+
+static void bench_multicell_lambda(t_bsp_t* bsp) {
+    bench_t b;
+    bench_section("Multi-cell λ-estimation (90 fixes over 3 cells, 4 vessels)");
+
+    static t_bsp_track_t track;
+    static lambda_workspace_t ws;
+    static se3_pose_t copy_buf[T_BSP_TRACK_MAX];
+    const uint16_t cells[3] = { 0x00FF, 0x0000, 0x0001 };
+    fill_crossing(bsp);
+
+    fixed_t frag_lambda[3], frag_err[3], track_err = 0;
+    fixed_t track_lambda = 0;
+
+    bench_begin(&b, "per-fragment: copy + estimate x3");
+    for (int it = 0; it < TRACK_ITERS; it++) {
+        for (int c = 0; c < 3; c++) {
+            int n = copy_fragment(bsp, cells[c], copy_buf);
+            lambda_ws_load_track(&ws, copy_buf, NULL, n);
+            frag_lambda[c] = lambda_ws_estimate(&ws, LAMBDA_EPSILON, LAMBDA_MAX_ITER, &frag_err[c]);
+        }
+        bench_sink += (uint64_t)frag_lambda[0];
+    }
+    bench_end(&b, TRACK_ITERS);
+
+    bench_begin(&b, "stitched: copy + concat + single estimate");
+    for (int it = 0; it < TRACK_ITERS; it++) {
+        int n = 0;
+        for (int c = 0; c < 3; c++) {
+            n += copy_fragment(bsp, cells[c], copy_buf + n);  /* cells already in time order */
+        }
+        lambda_ws_load_track(&ws, copy_buf, NULL, n);
+        track_lambda = lambda_ws_estimate(&ws, LAMBDA_EPSILON, LAMBDA_MAX_ITER, &track_err);
+        bench_sink += (uint64_t)track_lambda;
+    }
+    bench_end(&b, TRACK_ITERS);
+
+    bench_begin(&b, "stitched: gather view + single estimate");
+    for (int it = 0; it < TRACK_ITERS; it++) {
+        int n = t_bsp_gather_track(bsp, 0x0000, TRACK_MMSI, &track);
+        lambda_ws_load_track(&ws, &bsp->poses[0][0], track.index, n);
+        track_lambda = lambda_ws_estimate(&ws, LAMBDA_EPSILON, LAMBDA_MAX_ITER, &track_err);
+        bench_sink += (uint64_t)track_lambda;
+    }
+    bench_end(&b, TRACK_ITERS);
+
+    bench_begin(&b, "t_bsp_gather_track only");
+    for (int it = 0; it < TRACK_ITERS * 100; it++) {
+        bench_sink += (uint64_t)t_bsp_gather_track(bsp, 0x0000, TRACK_MMSI, &track);
+    }
+    bench_end(&b, TRACK_ITERS * 100);
+
+    printf("  gather: %u fixes from %u cells, %zu index bytes vs %zu copied pose bytes\n",
+           track.count, track.cells_spanned, track.count * sizeof(uint16_t),
+           track.count * sizeof(se3_pose_t));
+    printf("  per-fragment λ: %.4f %.4f %.4f (ε %.1f %.1f %.1f m)\n",
+           FIXED_TO_FLOAT(frag_lambda[0]), FIXED_TO_FLOAT(frag_lambda[1]),
+           FIXED_TO_FLOAT(frag_lambda[2]), FIXED_TO_FLOAT(frag_err[0]),
+           FIXED_TO_FLOAT(frag_err[1]), FIXED_TO_FLOAT(frag_err[2]));
+    printf("  stitched λ:     %.4f (ε %.1f m)\n",
+           FIXED_TO_FLOAT(track_lambda), FIXED_TO_FLOAT(track_err));
+}
+
+/* ========================================================================
+ * ONLINE RE-CENTERING
+ * ======================================================================== */
+
+#define RECENTER_CELLS   48
+#define RECENTER_SAMPLES 20000
+
+static int cmp_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* Time single inserts; ids[] must match the current window */
+static void sample_inserts(t_bsp_t* bsp, const uint16_t* ids, int step_every,
+                           uint64_t* samples, const char* label) {
+    se3_pose_t pose;
+    se3_pose_identity(&pose);
+    for (int i = 0; i < RECENTER_SAMPLES; i++) {
+        uint64_t t0 = bench_now_ns();
+        t_bsp_insert_pose(bsp, ids[i % RECENTER_CELLS], &pose);
+        if (step_every && (i % step_every) == 0) {
+            t_bsp_recenter_step(bsp, 1);
+        }
+        samples[i] = bench_now_ns() - t0;
+    }
+    qsort(samples, RECENTER_SAMPLES, sizeof(uint64_t), cmp_u64);
+    printf("  %-44s p50 %6llu ns  p99 %6llu ns  max %7llu ns\n", label,
+           (unsigned long long)samples[RECENTER_SAMPLES / 2],
+           (unsigned long long)samples[RECENTER_SAMPLES * 99 / 100],
+           (unsigned long long)samples[RECENTER_SAMPLES - 1]);
+}
+
+static void fill_recenter(t_bsp_t* bsp, uint16_t* old_ids, uint16_t* new_ids, int shift) {
+    se3_pose_t pose;
+    se3_pose_identity(&pose);
+    t_bsp_init(bsp, 0, 0);
+    for (int i = 0; i < RECENTER_CELLS; i++) {
+        int lat = i / 8, lon = i % 8;
+        old_ids[i] = (uint16_t)(((lat & 0xFF) << 8) | (lon & 0xFF));
+        new_ids[i] = (uint16_t)((((lat - shift) & 0xFF) << 8) | (lon & 0xFF));
+        for (int k = 0; k < 64; k++) {
+            t_bsp_insert_pose(bsp, old_ids[i], &pose);
+        }
+    }
+}
+
+static void bench_recenter(t_bsp_t* bsp) {
+    bench_section("Online re-centering (48 active cells, 64 poses each)");
+
+    uint16_t old_ids[RECENTER_CELLS], new_ids[RECENTER_CELLS];
+    static uint64_t samples[RECENTER_SAMPLES];
+    const int shift = 20;
+    /* Position of grid row 'shift' (cell size in degrees = 10 / 111.32) */
+    fixed_t center_lat = FLOAT_TO_FIXED((shift + 0.5f) * 10.0f / 111.32f);
+    fixed_t center_lon = FLOAT_TO_FIXED(0.5f * 10.0f / 111.32f);
+
+    fill_recenter(bsp, old_ids, new_ids, shift);
+    sample_inserts(bsp, old_ids, 0, samples, "insert, steady state");
+
+    fill_recenter(bsp, old_ids, new_ids, shift);
+    t_bsp_recenter_begin(bsp, center_lat, center_lon);
+    sample_inserts(bsp, new_ids, 0, samples, "insert, all cells double-mapped");
+    t_bsp_recenter_step(bsp, MAX_CELLS);
+    sample_inserts(bsp, new_ids, 0, samples, "insert, after re-key");
+
+    fill_recenter(bsp, old_ids, new_ids, shift);
+    t_bsp_recenter_begin(bsp, center_lat, center_lon);
+    sample_inserts(bsp, new_ids, 64, samples, "insert + step(1) every 64 inserts");
+
+    /* One-shot cost of the whole re-key vs. stop-the-world rebuild */
+    bench_t b;
+    uint64_t total_ns = 0;
+    for (int t = 0; t < 100; t++) {
+        fill_recenter(bsp, old_ids, new_ids, shift);
+        uint64_t t0 = bench_now_ns();
+        t_bsp_recenter_begin(bsp, center_lat, center_lon);
+        t_bsp_recenter_step(bsp, MAX_CELLS);
+        total_ns += bench_now_ns() - t0;
+    }
+    printf("  %-44s %12.2f ns\n", "begin + full re-key (in place)", total_ns / 100.0);
+
+    static se3_pose_t saved[RECENTER_CELLS][64];
+    fill_recenter(bsp, old_ids, new_ids, shift);
+    bench_begin(&b, "stop-the-world: copy out + init + re-insert");
+    for (int t = 0; t < 100; t++) {
+        for (int i = 0; i < RECENTER_CELLS; i++) {
+            t_bsp_cell_t* c = t_bsp_get_cell(bsp, (t & 1) ? new_ids[i] : old_ids[i]);
+            memcpy(saved[i], t_bsp_cell_poses(bsp, c), sizeof(saved[i]));
+        }
+        t_bsp_init(bsp, 0, 0);
+        for (int i = 0; i < RECENTER_CELLS; i++) {
+            for (int k = 0; k < 64; k++) {
+                t_bsp_insert_pose(bsp, (t & 1) ? old_ids[i] : new_ids[i], &saved[i][k]);
+            }
+        }
+    }
+    bench_end(&b, 100);
+}
+
+/* ========================================================================
+ * SAME-CELL FAST PATH (FIX REPLAY)
+ * ======================================================================== */
+
+#define REPLAY_VESSELS   500
+#define REPLAY_STEPS     360         /* 1 h at 10 s */
+#define REPLAY_FIXES     (REPLAY_VESSELS * REPLAY_STEPS)
+#define REPLAY_AREA_DEG  0.25
+
+typedef struct {
+    fixed_t lat, lon;
+    uint32_t mmsi;
+} replay_fix_t;
+
+static uint32_t replay_rng = 4242;
+static double replay_urand(void) {
+    replay_rng ^= replay_rng << 13;
+    replay_rng ^= replay_rng >> 17;
+    replay_rng ^= replay_rng << 5;
+    return (replay_rng & 0xFFFFFF) / (double)0x1000000;
+}
+
+/*
+ * Constant-course vessels bouncing inside ±0.25° (49 cells), one
+ * report per vessel per step, interleaved as a receiver would see them.
+ * speed_scale 1 = 4-21 kn at 10 s reports.
+ */
+static void make_fix_replay(replay_fix_t* fixes, double speed_scale) {
+    static double lat[REPLAY_VESSELS], lon[REPLAY_VESSELS];
+    static double dlat[REPLAY_VESSELS], dlon[REPLAY_VESSELS];
+    for (int v = 0; v < REPLAY_VESSELS; v++) {
+        double a = replay_urand() * 2.0 * M_PI;
+        double speed = (0.0002 + 0.0008 * replay_urand()) * speed_scale;
+        lat[v] = (replay_urand() * 2.0 - 1.0) * REPLAY_AREA_DEG;
+        lon[v] = (replay_urand() * 2.0 - 1.0) * REPLAY_AREA_DEG;
+        dlat[v] = speed * sin(a);
+        dlon[v] = speed * cos(a);
+    }
+    for (int i = 0; i < REPLAY_FIXES; i++) {
+        int v = i % REPLAY_VESSELS;
+        lat[v] += dlat[v];
+        lon[v] += dlon[v];
+        if (fabs(lat[v]) > REPLAY_AREA_DEG) dlat[v] = -dlat[v];
+        if (fabs(lon[v]) > REPLAY_AREA_DEG) dlon[v] = -dlon[v];
+        fixes[i].lat = FLOAT_TO_FIXED(lat[v]);
+        fixes[i].lon = FLOAT_TO_FIXED(lon[v]);
+        fixes[i].mmsi = 367000000u + (uint32_t)v;
+    }
+}
+
+static void bench_locate_replay(t_bsp_t* bsp, const replay_fix_t* fixes, const char* title) {
+    static t_bsp_locator_t loc;
+    se3_pose_t pose;
+    se3_pose_identity(&pose);
+    bench_t b;
+    bench_section(title);
+
+    /* Warm-up pass populates the cells the timed passes reuse */
+    t_bsp_init(bsp, 0, 0);
+    t_bsp_locator_init(&loc);
+    uint32_t mismatches = 0;
+    for (int i = 0; i < REPLAY_FIXES; i++) {
+        uint16_t id = t_bsp_locate(bsp, &loc, fixes[i].mmsi, fixes[i].lat, fixes[i].lon);
+        if (id != t_bsp_latlon_to_cell(bsp, fixes[i].lat, fixes[i].lon)) mismatches++;
+        t_bsp_insert_pose(bsp, id, &pose);
+    }
+    printf("  %u fixes, %u cells, hit rate %.2f%% (%u hits, %u misses), %u mismatches\n",
+           REPLAY_FIXES, t_bsp_get_active_count(bsp),
+           100.0 * loc.hits / (loc.hits + loc.misses), loc.hits, loc.misses, mismatches);
+    printf("  64-bit divides skipped: %u of %u (software __divdi3 on the ESP32-S3)\n",
+           2 * loc.hits, 2 * REPLAY_FIXES);
+
+    bench_begin(&b, "t_bsp_latlon_to_cell (every fix)");
+    for (int i = 0; i < REPLAY_FIXES; i++) {
+        bench_sink += t_bsp_latlon_to_cell(bsp, fixes[i].lat, fixes[i].lon);
+    }
+    double full_ns = bench_end(&b, REPLAY_FIXES);
+
+    t_bsp_locator_init(&loc);
+    bench_begin(&b, "t_bsp_locate (last-cell fast path)");
+    for (int i = 0; i < REPLAY_FIXES; i++) {
+        bench_sink += t_bsp_locate(bsp, &loc, fixes[i].mmsi, fixes[i].lat, fixes[i].lon);
+    }
+    double fast_ns = bench_end(&b, REPLAY_FIXES);
+
+    bench_begin(&b, "t_bsp_latlon_to_cell + t_bsp_insert_pose");
+    for (int i = 0; i < REPLAY_FIXES; i++) {
+        pose.mmsi = fixes[i].mmsi;
+        t_bsp_insert_pose(bsp, t_bsp_latlon_to_cell(bsp, fixes[i].lat, fixes[i].lon), &pose);
+    }
+    double full_ins_ns = bench_end(&b, REPLAY_FIXES);
+
+    t_bsp_locator_init(&loc);
+    bench_begin(&b, "t_bsp_locate + t_bsp_insert_pose");
+    for (int i = 0; i < REPLAY_FIXES; i++) {
+        pose.mmsi = fixes[i].mmsi;
+        t_bsp_insert_pose(bsp, t_bsp_locate(bsp, &loc, fixes[i].mmsi, fixes[i].lat,
+                                             fixes[i].lon), &pose);
+    }
+    double fast_ins_ns = bench_end(&b, REPLAY_FIXES);
+
+    printf("  classify speedup %.2fx, classify+insert speedup %.2fx (%.2f vs %.2f Mfix/s)\n",
+           full_ns / fast_ns, full_ins_ns / fast_ins_ns,
+           1e3 / full_ins_ns, 1e3 / fast_ins_ns);
+}
+
+/* ========================================================================
+ * MAIN
+ * ======================================================================== */
+
+int main(void) {
+    printf("======================================================================\n");
+    printf("T-BSP SPATIAL PARTITIONING - HOST BENCHMARKS\n");
+    printf("======================================================================\n");
+    printf("Max cells: %d, Max poses/cell: %d, sizeof(t_bsp_t): %zu bytes\n",
+           MAX_CELLS, MAX_POSES_PER_CELL, sizeof(t_bsp_t));
+
+    se3_init_tables();
+
+    t_bsp_t* bsp = (t_bsp_t*)bench_alloc_aligned(sizeof(t_bsp_t));
+    legacy_bsp_t* legacy = (legacy_bsp_t*)bench_alloc_aligned(sizeof(legacy_bsp_t));
+    if (!bsp || !legacy) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+
+    t_bsp_init(bsp, 0, 0);
+    fill_all_cells(bsp, legacy);
+
+    bench_cold_scans(bsp, legacy);
+    bench_warm_scans(bsp, legacy);
+    bench_insert(bsp);
+    bench_multicell_lambda(bsp);
+    bench_recenter(bsp);
+
+    replay_fix_t* fixes = (replay_fix_t*)malloc(REPLAY_FIXES * sizeof(replay_fix_t));
+    if (!fixes) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+    make_fix_replay(fixes, 1.0);
+    bench_locate_replay(bsp, fixes, "Same-cell fast path: 500 vessels, 10 s reports, 4-21 kn");
+    make_fix_replay(fixes, 5.0);
+    bench_locate_replay(bsp, fixes, "Same-cell fast path: 500 vessels, 10 s reports, 20-100 kn");
+    free(fixes);
+
+    free(legacy);
+    free(bsp);
+    return 0;
+}
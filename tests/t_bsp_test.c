@@ -9,12 +9,28 @@
  *   5. Polar region handling (near ±90° latitude)
  *   6. Cell handoff protocol
  *   7. Adjacent cell calculation (8-connectivity)
+ *   8. Hot/cold cell layout (header array vs. pose slabs)
+ *   9. Multi-cell track gather (time-ordered index view)
+ *  10. Cell ownership routing (Z-order ranges, rendezvous hashing)
+ *  11. Online grid re-centering (double-mapped re-key)
+ *  12. Geofence engine (cell bins, crossing number, enter/exit events)
+ *  13. CPA/TCPA screening (kernel, 3×3 candidates, alerts, expiry)
+ *  14. Traffic-density raster (cell-aligned tiles, windows, decay, export)
+ *  15. Primary/standby replication (change log, mirror, gap + snapshot)
+ *  16. Arrow C Data Interface export (zero-copy cells and DLT records)
+ *  17. Same-cell fast path (populated cell bounds, per-vessel locator)
+ *  18. Transmit scheduler (duty-cycle budget, priority, coalescing, expiry)
+ *  19. Compact DLT record v2 (interned datasets, varint fields, round trip)
+ *  20. Columnar DLT archive (round trip, torn tail, append after a torn tail)
  *
  * Compile with:
  *   gcc -o t_bsp_test t_bsp_test.c \
  *       ../embedded/se3_math.c ../embedded/trig_tables.c \
- *       ../embedded/t_bsp.c ../embedded/handoff.c \
- *       -I../embedded -lm -std=c99
+ *       ../embedded/t_bsp.c ../embedded/handoff.c ../embedded/cell_route.c \
+ *       ../embedded/geofence.c ../embedded/cpa.c ../embedded/density.c \
+ *       ../embedded/replog.c ../embedded/arrow_export.c ../embedded/tx_sched.c \
+ *       ../embedded/dlt_record.c ../tools/dlt_archive.c \
+ *       -D_GNU_SOURCE -DDLT_ARCHIVE_LIBRARY -I../embedded -I../tools -lm -std=c99
  *
  * Author: ClaudeCode (based on Grok's T-BSP design)
  * Version: 1.0
@@ -22,10 +38,21 @@
 
 #include "../embedded/se3_edge.h"
 #include "../embedded/t_bsp.h"
+#include "../embedded/cell_route.h"
+#include "../embedded/geofence.h"
+#include "../embedded/cpa.h"
+#include "../embedded/density.h"
+#include "../embedded/replog.h"
+#include "../embedded/arrow_export.h"
+#include "../embedded/tx_sched.h"
+#include "../embedded/dlt_record.h"
+#include "../tools/dlt_archive.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <time.h>
+#include <unistd.h>
 
 /* Test statistics */
 static int tests_passed = 0;
@@ -452,10 +479,1453 @@ void test_cell_bounds(void) {
     TEST_ASSERT(fabs(lat_span - 0.09f) < 0.02f, "Cell latitude span ~0.09°");
 }
 
+/* ========================================================================
+ * TEST: Hot/Cold Cell Layout
+ * ======================================================================== */
+
+void test_cell_layout(void) {
+    printf("\n[TEST] Hot/Cold Cell Layout\n");
+
+    static t_bsp_t bsp;
+    t_bsp_init(&bsp, 0, 0);
+
+    TEST_ASSERT(sizeof(t_bsp_cell_t) == 24, "Cell header is 24 bytes");
+    TEST_ASSERT(((uintptr_t)bsp.cells % T_BSP_CACHE_LINE) == 0,
+                "Header array is cache-line aligned");
+    TEST_ASSERT(((uintptr_t)bsp.poses % T_BSP_CACHE_LINE) == 0,
+                "Pose region is cache-line aligned");
+    TEST_ASSERT(sizeof(bsp.cells) <= 24 * T_BSP_CACHE_LINE,
+                "All headers fit in 24 cache lines");
+
+    se3_pose_t pose;
+    se3_pose_identity(&pose);
+    pose.mmsi = 111;
+    t_bsp_insert_pose(&bsp, 0x0101, &pose);
+    pose.mmsi = 222;
+    t_bsp_insert_pose(&bsp, 0x0202, &pose);
+    pose.mmsi = 223;
+    t_bsp_insert_pose(&bsp, 0x0202, &pose);
+
+    t_bsp_cell_t* a = t_bsp_get_cell(&bsp, 0x0101);
+    t_bsp_cell_t* b = t_bsp_get_cell(&bsp, 0x0202);
+    TEST_ASSERT(a != NULL && b != NULL, "Both cells allocated");
+    TEST_ASSERT(t_bsp_cell_poses(&bsp, a)[0].mmsi == 111, "Cell A slab holds its pose");
+    TEST_ASSERT(t_bsp_cell_poses(&bsp, b)[0].mmsi == 222 &&
+                t_bsp_cell_poses(&bsp, b)[1].mmsi == 223,
+                "Cell B slab holds its poses in order");
+    TEST_ASSERT(t_bsp_cell_poses(&bsp, b) == bsp.poses[b - bsp.cells],
+                "Slab index matches header index");
+}
+
 /* ========================================================================
  * MAIN TEST RUNNER
  * ======================================================================== */
 
+void test_gather_track(void) {
+    printf("\n[TEST] Multi-Cell Track Gather\n");
+
+    static t_bsp_t bsp;
+    static t_bsp_track_t track;
+    t_bsp_init(&bsp, 0, 0);
+
+    /* Vessel 42 crosses W → C → E, interleaved with vessel 7 */
+    const uint16_t west = 0x00FF, center = 0x0000, east = 0x0001, far = 0x0005;
+    se3_pose_t pose;
+    se3_pose_identity(&pose);
+    for (uint32_t ts = 100; ts < 130; ts++) {
+        uint16_t cell = (ts < 110) ? west : (ts < 120) ? center : east;
+        pose.mmsi = 42;
+        pose.timestamp = ts;
+        t_bsp_insert_pose(&bsp, cell, &pose);
+        pose.mmsi = 7;
+        t_bsp_insert_pose(&bsp, cell, &pose);
+    }
+    /* Fix outside the 3x3 neighbourhood must not be gathered */
+    pose.mmsi = 42;
+    pose.timestamp = 200;
+    t_bsp_insert_pose(&bsp, far, &pose);
+
+    int n = t_bsp_gather_track(&bsp, center, 42, &track);
+    TEST_ASSERT(n == 30 && track.count == 30, "Gathers 30 fixes from W, C, E");
+    TEST_ASSERT(track.cells_spanned == 3, "Track spans 3 cells");
+
+    bool ordered = true, same_vessel = true;
+    for (int i = 0; i < n; i++) {
+        const se3_pose_t* p = t_bsp_track_pose(&bsp, &track, i);
+        if (p->mmsi != 42) same_vessel = false;
+        if (p->timestamp != (uint32_t)(100 + i)) ordered = false;
+    }
+    TEST_ASSERT(same_vessel, "Only the requested vessel is gathered");
+    TEST_ASSERT(ordered, "Fixes are merged in timestamp order");
+
+    t_bsp_cell_t* c = t_bsp_get_cell(&bsp, center);
+    TEST_ASSERT(t_bsp_track_pose(&bsp, &track, 10) == &t_bsp_cell_poses(&bsp, c)[0],
+                "Track indexes pose storage in place (no copy)");
+
+    TEST_ASSERT(t_bsp_gather_track(&bsp, center, 99, &track) == 0 && track.cells_spanned == 0,
+                "Unknown vessel gathers nothing");
+}
+
+void test_cell_routing(void) {
+    printf("\n[TEST] Cell Ownership Routing\n");
+
+    static cell_route_t rt, rt_other;
+    cell_route_init(&rt);
+    TEST_ASSERT(cell_route_lookup(&rt, 0x1234) == CELL_ROUTE_NO_NODE,
+                "Empty table routes to no node");
+
+    /* Z-order key is a bijection and ranges are 16x16 cell blocks */
+    static uint8_t seen[65536 / 8];
+    memset(seen, 0, sizeof(seen));
+    bool bijective = true;
+    for (uint32_t id = 0; id < 65536; id++) {
+        uint16_t key = cell_route_key((uint16_t)id);
+        if (seen[key >> 3] & (1u << (key & 7))) bijective = false;
+        seen[key >> 3] |= (uint8_t)(1u << (key & 7));
+    }
+    TEST_ASSERT(bijective, "Morton key is a bijection over all cell IDs");
+
+    bool blocks = true;
+    for (int lat = -128; lat < 128; lat++) {
+        for (int lon = -128; lon < 128; lon++) {
+            uint16_t id = (uint16_t)(((lat & 0xFF) << 8) | (lon & 0xFF));
+            /* Range index is the Morton interleave of the block coordinates */
+            uint16_t block_key = (uint16_t)((cell_route_spread8((uint16_t)((lat + 128) >> 4)) << 1) |
+                                            cell_route_spread8((uint16_t)((lon + 128) >> 4)));
+            if (cell_route_range(id) != block_key) blocks = false;
+        }
+    }
+    TEST_ASSERT(blocks, "Each range is one aligned 16x16 cell block");
+    TEST_ASSERT(cell_route_range(0x0000) == cell_route_range(0x0F0F) &&
+                cell_route_range(0x0000) != cell_route_range(0x1000),
+                "Cells (0,0) and (15,15) share a range, (16,0) does not");
+
+    /* First node owns everything */
+    TEST_ASSERT(cell_route_add_node(&rt, 101, NULL) == CELL_ROUTE_RANGES,
+                "First node takes all ranges");
+    TEST_ASSERT(cell_route_add_node(&rt, 101, NULL) == -1, "Duplicate node rejected");
+    TEST_ASSERT(cell_route_add_node(&rt, CELL_ROUTE_NO_NODE, NULL) == -1, "Node ID 0 rejected");
+
+    for (uint32_t n = 102; n <= 108; n++) {
+        cell_route_add_node(&rt, n, NULL);
+    }
+    TEST_ASSERT(cell_route_node_count(&rt) == 8, "8 nodes in table");
+
+    int min_load = CELL_ROUTE_RANGES, max_load = 0, total = 0;
+    for (uint32_t n = 101; n <= 108; n++) {
+        int load = cell_route_node_ranges(&rt, n);
+        if (load < min_load) min_load = load;
+        if (load > max_load) max_load = load;
+        total += load;
+    }
+    printf("    8-node load: min %d, max %d ranges (ideal 32)\n", min_load, max_load);
+    TEST_ASSERT(total == CELL_ROUTE_RANGES, "Every range has exactly one owner");
+    TEST_ASSERT(min_load >= 12 && max_load <= 56, "Load within rendezvous-hash spread");
+
+    /* Join moves only ranges won by the newcomer */
+    uint32_t before[CELL_ROUTE_RANGES];
+    uint8_t moved[CELL_ROUTE_RANGES];
+    for (int r = 0; r < CELL_ROUTE_RANGES; r++) before[r] = rt.node_id[rt.owner[r]];
+    int n_moved = cell_route_add_node(&rt, 109, moved);
+    bool only_new = true;
+    int changed = 0;
+    for (int r = 0; r < CELL_ROUTE_RANGES; r++) {
+        uint32_t now = rt.node_id[rt.owner[r]];
+        if (now != before[r]) {
+            changed++;
+            if (now != 109) only_new = false;
+        }
+    }
+    printf("    join moved %d ranges (ideal %d)\n", n_moved, CELL_ROUTE_RANGES / 9);
+    TEST_ASSERT(only_new && changed == n_moved &&
+                n_moved == cell_route_node_ranges(&rt, 109),
+                "Join moves only ranges the new node wins");
+
+    /* Leave moves only the leaving node's ranges */
+    int owned = cell_route_node_ranges(&rt, 104);
+    for (int r = 0; r < CELL_ROUTE_RANGES; r++) before[r] = rt.node_id[rt.owner[r]];
+    n_moved = cell_route_remove_node(&rt, 104, moved);
+    bool only_leaver = true;
+    for (int r = 0; r < CELL_ROUTE_RANGES; r++) {
+        uint32_t now = rt.node_id[rt.owner[r]];
+        if (now != before[r] && before[r] != 104) only_leaver = false;
+        if (now == 104 || now == CELL_ROUTE_NO_NODE) only_leaver = false;
+    }
+    TEST_ASSERT(n_moved == owned && only_leaver, "Leave moves only the leaving node's ranges");
+    TEST_ASSERT(cell_route_remove_node(&rt, 104, NULL) == -1, "Removing absent node fails");
+
+    /* Same membership, different join order → same table */
+    cell_route_init(&rt_other);
+    const uint32_t order[8] = { 109, 103, 108, 101, 107, 105, 102, 106 };
+    for (int i = 0; i < 8; i++) cell_route_add_node(&rt_other, order[i], NULL);
+    bool same = true;
+    for (int r = 0; r < CELL_ROUTE_RANGES; r++) {
+        if (rt.node_id[rt.owner[r]] != rt_other.node_id[rt_other.owner[r]]) same = false;
+    }
+    TEST_ASSERT(same, "Table is independent of join order");
+
+    /* Handoff forwarding */
+    handoff_packet_t pkt;
+    se3_pose_t pose;
+    se3_pose_identity(&pose);
+    create_handoff_packet(367000001, &pose, 0x0000, 0x0001, 0, &pkt);
+    uint32_t owner = cell_route_lookup(&rt, 0x0001);
+    TEST_ASSERT(cell_route_handoff_target(&rt, &pkt, owner) == CELL_ROUTE_NO_NODE,
+                "Handoff into a locally owned cell is not forwarded");
+    TEST_ASSERT(cell_route_handoff_target(&rt, &pkt, owner + 1000) == owner,
+                "Handoff into a remote cell goes to its owner");
+
+    /* Last node leaving empties the table */
+    cell_route_init(&rt_other);
+    cell_route_add_node(&rt_other, 7, NULL);
+    cell_route_remove_node(&rt_other, 7, NULL);
+    TEST_ASSERT(cell_route_lookup(&rt_other, 0x0101) == CELL_ROUTE_NO_NODE &&
+                cell_route_node_count(&rt_other) == 0,
+                "Removing the last node empties the table");
+}
+
+void test_online_recenter(void) {
+    printf("\n[TEST] Online Grid Re-Centering\n");
+
+    static t_bsp_t bsp;
+    t_bsp_init(&bsp, 0, 0);
+
+    /* 20 vessels spread over 10 rows of cells north of the origin */
+    se3_pose_t pose;
+    se3_pose_identity(&pose);
+    fixed_t lats[20], lons[20];
+    uint16_t slot_before[20];
+    for (int v = 0; v < 20; v++) {
+        lats[v] = FLOAT_TO_FIXED(0.05f + 0.09f * (v % 10));
+        lons[v] = FLOAT_TO_FIXED(0.05f + 0.45f * (v / 10));
+        pose.mmsi = 1000 + v;
+        uint16_t id = t_bsp_latlon_to_cell(&bsp, lats[v], lons[v]);
+        t_bsp_insert_pose(&bsp, id, &pose);
+        slot_before[v] = (uint16_t)(t_bsp_get_cell(&bsp, id) - bsp.cells);
+    }
+    uint16_t active_before = t_bsp_get_active_count(&bsp);
+
+    fixed_t b_lat_min, b_lat_max, b_lon_min, b_lon_max;
+    uint16_t id5 = t_bsp_latlon_to_cell(&bsp, lats[5], lons[5]);
+    t_bsp_get_cell_bounds(&bsp, id5, &b_lat_min, &b_lat_max, &b_lon_min, &b_lon_max);
+
+    TEST_ASSERT(!t_bsp_recenter_needed(0x0000) && t_bsp_recenter_needed(0x6000) &&
+                t_bsp_recenter_needed(0x00A0),
+                "Re-center due only near the window edge");
+
+    /* Move the window 5 cells north (all cells stay representable) */
+    fixed_t c_lat = FLOAT_TO_FIXED(0.45f), c_lon = FLOAT_TO_FIXED(0.05f);
+    int dropping = t_bsp_recenter_begin(&bsp, c_lat, c_lon);
+    TEST_ASSERT(dropping == 0, "No cells fall outside the new window");
+    TEST_ASSERT(t_bsp_latlon_to_cell(&bsp, c_lat, c_lon) == 0x0000,
+                "New center position maps to cell (0, 0)");
+
+    /* Partially migrate, then insert into every vessel's cell (new IDs) */
+    t_bsp_recenter_step(&bsp, 3);
+    TEST_ASSERT(bsp.recentering, "Re-key still in progress after a partial step");
+    bool same_slots = true;
+    for (int v = 0; v < 20; v++) {
+        pose.mmsi = 1000 + v;
+        uint16_t id = t_bsp_latlon_to_cell(&bsp, lats[v], lons[v]);
+        t_bsp_insert_pose(&bsp, id, &pose);
+        t_bsp_cell_t* c = t_bsp_get_cell(&bsp, id);
+        if (!c || (uint16_t)(c - bsp.cells) != slot_before[v]) same_slots = false;
+    }
+    TEST_ASSERT(same_slots, "Inserts during migration reach the same cells (double mapping)");
+    TEST_ASSERT(t_bsp_get_active_count(&bsp) == active_before,
+                "No duplicate cells allocated during migration");
+
+    TEST_ASSERT(t_bsp_recenter_step(&bsp, MAX_CELLS) == 0 && !bsp.recentering,
+                "Migration completes");
+    bool keyed = true;
+    int total = 0;
+    for (int v = 0; v < 20; v++) {
+        uint16_t id = t_bsp_latlon_to_cell(&bsp, lats[v], lons[v]);
+        t_bsp_cell_t* c = t_bsp_get_cell(&bsp, id);
+        if (!c || c->cell_id != id || (uint16_t)(c - bsp.cells) != slot_before[v]) keyed = false;
+    }
+    for (int i = 0; i < MAX_CELLS; i++) {
+        if (bsp.cells[i].active) total += bsp.cells[i].pose_count;
+    }
+    TEST_ASSERT(keyed, "All cells re-keyed in place to new-window IDs");
+    TEST_ASSERT(total == 40, "All 40 poses retained");
+
+    fixed_t a_lat_min, a_lat_max, a_lon_min, a_lon_max;
+    id5 = t_bsp_latlon_to_cell(&bsp, lats[5], lons[5]);
+    t_bsp_get_cell_bounds(&bsp, id5, &a_lat_min, &a_lat_max, &a_lon_min, &a_lon_max);
+    TEST_ASSERT(a_lat_min == b_lat_min && a_lon_min == b_lon_min,
+                "Cell bounds unchanged by re-centering");
+
+    /* Jump 200 cells away: old cells can no longer be keyed and are dropped */
+    fixed_t far_lat = FLOAT_TO_FIXED(0.05f + 200 * 0.0899f);
+    dropping = t_bsp_recenter_begin(&bsp, far_lat, c_lon);
+    t_bsp_recenter_step(&bsp, MAX_CELLS);
+    TEST_ASSERT(dropping == (int)active_before && bsp.recenter_dropped == active_before &&
+                t_bsp_get_active_count(&bsp) == 0,
+                "Cells beyond the new window are dropped and counted");
+}
+
+static bool ref_point_in_polygon(const geofence_vertex_t* v, int n, double lat, double lon) {
+    bool inside = false;
+    for (int i = 0, j = n - 1; i < n; j = i++) {
+        double yi = FIXED_TO_FLOAT(v[i].lat), yj = FIXED_TO_FLOAT(v[j].lat);
+        double xi = FIXED_TO_FLOAT(v[i].lon), xj = FIXED_TO_FLOAT(v[j].lon);
+        if ((yi > lat) != (yj > lat) && lon < (xj - xi) * (lat - yi) / (yj - yi) + xi) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+void test_geofence(void) {
+    printf("\n[TEST] Geofence Engine\n");
+
+    static t_bsp_t bsp;
+    static geofence_set_t gs;
+    t_bsp_init(&bsp, 0, 0);
+    geofence_init(&gs);
+
+    /* L-shaped (concave) port spanning several cells: 0.0-0.3° square
+     * minus the upper-right 0.15-0.3° quadrant */
+    const geofence_vertex_t port[6] = {
+        { FLOAT_TO_FIXED(0.0f),  FLOAT_TO_FIXED(0.0f)  },
+        { FLOAT_TO_FIXED(0.3f),  FLOAT_TO_FIXED(0.0f)  },
+        { FLOAT_TO_FIXED(0.3f),  FLOAT_TO_FIXED(0.15f) },
+        { FLOAT_TO_FIXED(0.15f), FLOAT_TO_FIXED(0.15f) },
+        { FLOAT_TO_FIXED(0.15f), FLOAT_TO_FIXED(0.3f)  },
+        { FLOAT_TO_FIXED(0.0f),  FLOAT_TO_FIXED(0.3f)  },
+    };
+    /* Small MPA nested inside the port */
+    const geofence_vertex_t mpa[4] = {
+        { FLOAT_TO_FIXED(0.02f), FLOAT_TO_FIXED(0.02f) },
+        { FLOAT_TO_FIXED(0.06f), FLOAT_TO_FIXED(0.02f) },
+        { FLOAT_TO_FIXED(0.06f), FLOAT_TO_FIXED(0.06f) },
+        { FLOAT_TO_FIXED(0.02f), FLOAT_TO_FIXED(0.06f) },
+    };
+    TEST_ASSERT(geofence_add(&gs, 501, GEOFENCE_KIND_PORT, port, 6) == 0 &&
+                geofence_add(&gs, 777, GEOFENCE_KIND_MPA, mpa, 4) == 1,
+                "Fences loaded");
+    TEST_ASSERT(geofence_add(&gs, 1, GEOFENCE_KIND_PORT, port, 2) == -1,
+                "Degenerate polygon rejected");
+    TEST_ASSERT(geofence_build(&gs, &bsp), "Fences binned into cells");
+    printf("    %u bin entries for 2 fences\n", gs.n_entries);
+    TEST_ASSERT(gs.n_entries > 2, "Multi-cell fence binned into every overlapped cell");
+
+    /* Crossing-number test vs. double reference on random points */
+    int mismatches = 0;
+    srand(7);
+    for (int i = 0; i < 20000; i++) {
+        double lat = (rand() / (double)RAND_MAX) * 0.4 - 0.05;
+        double lon = (rand() / (double)RAND_MAX) * 0.4 - 0.05;
+        bool got = geofence_point_in_polygon(port, 6, FLOAT_TO_FIXED(lat), FLOAT_TO_FIXED(lon));
+        bool ref = ref_point_in_polygon(port, 6, FIXED_TO_FLOAT(FLOAT_TO_FIXED(lat)),
+                                        FIXED_TO_FLOAT(FLOAT_TO_FIXED(lon)));
+        if (got != ref) mismatches++;
+    }
+    printf("    crossing-number mismatches vs reference: %d\n", mismatches);
+    TEST_ASSERT(mismatches == 0, "Crossing-number test matches reference (20k points, concave)");
+
+    /* Track: outside → port → MPA → notch (outside) → port → outside */
+    const float track[7][2] = {   /* lat, lon */
+        { -0.05f, 0.10f }, { 0.10f, 0.10f }, { 0.04f, 0.04f }, { 0.04f, 0.045f },
+        { 0.25f, 0.25f }, { 0.25f, 0.05f }, { 0.40f, 0.05f },
+    };
+    const int expect_events[7] = { 0, 1, 1, 0, 2, 1, 1 };
+    geofence_event_t ev[8];
+    bool counts_ok = true, first_enter_ok = false, exit_ok = false;
+    for (int i = 0; i < 7; i++) {
+        geofence_fix_t fix = { FLOAT_TO_FIXED(track[i][0]), FLOAT_TO_FIXED(track[i][1]),
+                               367000001u, 1000u + (uint32_t)i };
+        int n = geofence_eval(&gs, &bsp, &fix, ev, 8);
+        if (n != expect_events[i]) counts_ok = false;
+        if (i == 1 && n == 1 && ev[0].type == GEOFENCE_EVENT_ENTER && ev[0].fence_id == 501 &&
+            ev[0].timestamp == 1001) {
+            first_enter_ok = true;
+        }
+        if (i == 4 && n == 2) {
+            /* Leaving the MPA and the port together at the notch */
+            exit_ok = ev[0].type == GEOFENCE_EVENT_EXIT && ev[1].type == GEOFENCE_EVENT_EXIT;
+        }
+    }
+    TEST_ASSERT(counts_ok, "Enter/exit event counts along the track");
+    TEST_ASSERT(first_enter_ok, "Port entry reported with fence id and timestamp");
+    TEST_ASSERT(exit_ok, "Nested fences both exit at the concave notch");
+
+    /* Batch == one-by-one */
+    static geofence_set_t gs_batch;
+    geofence_init(&gs_batch);
+    geofence_add(&gs_batch, 501, GEOFENCE_KIND_PORT, port, 6);
+    geofence_add(&gs_batch, 777, GEOFENCE_KIND_MPA, mpa, 4);
+    geofence_fix_t fixes[7];
+    for (int i = 0; i < 7; i++) {
+        fixes[i].lat = FLOAT_TO_FIXED(track[i][0]);
+        fixes[i].lon = FLOAT_TO_FIXED(track[i][1]);
+        fixes[i].mmsi = 367000002u;
+        fixes[i].timestamp = 1000u + (uint32_t)i;
+    }
+    geofence_event_t batch_ev[16];
+    TEST_ASSERT(geofence_eval_batch(&gs_batch, &bsp, fixes, 7, batch_ev, 16) == 6,
+                "Batch evaluation emits the same 6 events");
+
+    /* Overflow: a transition that does not fit is kept for a later fix */
+    static geofence_set_t gs_full;
+    geofence_init(&gs_full);
+    geofence_add(&gs_full, 501, GEOFENCE_KIND_PORT, port, 6);
+    geofence_add(&gs_full, 777, GEOFENCE_KIND_MPA, mpa, 4);
+    geofence_fix_t in_mpa = { FLOAT_TO_FIXED(0.04f), FLOAT_TO_FIXED(0.04f), 367000004u, 3000u };
+    geofence_fix_t away = { FLOAT_TO_FIXED(0.40f), FLOAT_TO_FIXED(0.40f), 367000004u, 3001u };
+    int n1 = geofence_eval(&gs_full, &bsp, &in_mpa, ev, 1);
+    int n2 = geofence_eval(&gs_full, &bsp, &in_mpa, ev, 8);
+    int n3 = geofence_eval(&gs_full, &bsp, &in_mpa, ev, 8);
+    TEST_ASSERT(n1 == 1 && gs_full.dropped == 1 && n2 == 1 && ev[0].type == GEOFENCE_EVENT_ENTER &&
+                n3 == 0, "Entry beyond the event buffer is reported by the next fix");
+    n1 = geofence_eval(&gs_full, &bsp, &away, ev, 1);
+    n2 = geofence_eval(&gs_full, &bsp, &away, ev, 8);
+    n3 = geofence_eval(&gs_full, &bsp, &away, ev, 8);
+    TEST_ASSERT(n1 == 1 && gs_full.dropped == 2 && n2 == 1 && ev[0].type == GEOFENCE_EVENT_EXIT &&
+                n3 == 0, "Exit beyond the event buffer is reported by the next fix");
+
+    /* More fences than GEOFENCE_MAX_INSIDE: tracked ones are never displaced */
+    const geofence_vertex_t outer[4] = {
+        { FLOAT_TO_FIXED(0.0f), FLOAT_TO_FIXED(0.0f) }, { FLOAT_TO_FIXED(0.2f), FLOAT_TO_FIXED(0.0f) },
+        { FLOAT_TO_FIXED(0.2f), FLOAT_TO_FIXED(0.2f) }, { FLOAT_TO_FIXED(0.0f), FLOAT_TO_FIXED(0.2f) },
+    };
+    const geofence_vertex_t corner[4] = {
+        { FLOAT_TO_FIXED(0.1f), FLOAT_TO_FIXED(0.1f) }, { FLOAT_TO_FIXED(0.2f), FLOAT_TO_FIXED(0.1f) },
+        { FLOAT_TO_FIXED(0.2f), FLOAT_TO_FIXED(0.2f) }, { FLOAT_TO_FIXED(0.1f), FLOAT_TO_FIXED(0.2f) },
+    };
+    geofence_init(&gs_full);
+    geofence_add(&gs_full, 100, GEOFENCE_KIND_EXCLUSION, corner, 4);     /* First in every bin */
+    for (int i = 1; i <= GEOFENCE_MAX_INSIDE; i++) {
+        geofence_add(&gs_full, 100u + (uint32_t)i, GEOFENCE_KIND_PORT, outer, 4);
+    }
+    geofence_fix_t p_outer = { FLOAT_TO_FIXED(0.05f), FLOAT_TO_FIXED(0.05f), 367000005u, 4000u };
+    geofence_fix_t p_all = { FLOAT_TO_FIXED(0.15f), FLOAT_TO_FIXED(0.15f), 367000005u, 4001u };
+    n1 = geofence_eval(&gs_full, &bsp, &p_outer, ev, 8);
+    n2 = geofence_eval(&gs_full, &bsp, &p_all, ev, 8);
+    TEST_ASSERT(n1 == GEOFENCE_MAX_INSIDE && n2 == 0 && gs_full.dropped == 1,
+                "Entry past GEOFENCE_MAX_INSIDE counted, no spurious exit");
+    away.mmsi = 367000005u;
+    n3 = geofence_eval(&gs_full, &bsp, &away, ev, 8);
+    TEST_ASSERT(n3 == GEOFENCE_MAX_INSIDE, "Every tracked fence exits once");
+
+    /* Re-centering re-keys cells; bins rebuild on the next evaluation */
+    t_bsp_recenter_begin(&bsp, FLOAT_TO_FIXED(0.5f), FLOAT_TO_FIXED(0.5f));
+    t_bsp_recenter_step(&bsp, MAX_CELLS);
+    geofence_fix_t fix = { FLOAT_TO_FIXED(0.10f), FLOAT_TO_FIXED(0.10f), 367000003u, 2000u };
+    int n = geofence_eval(&gs, &bsp, &fix, ev, 8);
+    TEST_ASSERT(n == 1 && ev[0].fence_id == 501 && gs.built_epoch == bsp.grid_epoch,
+                "Bins rebuilt after grid re-center");
+
+    /* Over bin capacity: an error, latched until the fences change */
+    const geofence_vertex_t huge[4] = {
+        { FLOAT_TO_FIXED(-5.0f), FLOAT_TO_FIXED(-5.0f) }, { FLOAT_TO_FIXED(5.0f), FLOAT_TO_FIXED(-5.0f) },
+        { FLOAT_TO_FIXED(5.0f), FLOAT_TO_FIXED(5.0f) }, { FLOAT_TO_FIXED(-5.0f), FLOAT_TO_FIXED(5.0f) },
+    };
+    geofence_init(&gs_full);
+    geofence_add(&gs_full, 900, GEOFENCE_KIND_MPA, huge, 4);
+    bool built = geofence_build(&gs_full, &bsp);
+    n1 = geofence_eval(&gs_full, &bsp, &fix, ev, 8);
+    gs_full.n_fences = 0;    /* A rebuild would now succeed: only the latch keeps the error */
+    n2 = geofence_eval_batch(&gs_full, &bsp, &fix, 1, ev, 8);
+    TEST_ASSERT(!built && n1 == GEOFENCE_ERR_BINS && n2 == GEOFENCE_ERR_BINS,
+                "Bin overflow reported by build and eval, not retried per fix");
+    geofence_add(&gs_full, 501, GEOFENCE_KIND_PORT, port, 6);
+    n3 = geofence_eval(&gs_full, &bsp, &fix, ev, 8);
+    TEST_ASSERT(n3 == 1 && ev[0].fence_id == 501, "Adding a fence clears the latch");
+}
+
+/* ========================================================================
+ * TEST: CPA/TCPA Screening
+ * ======================================================================== */
+
+static se3_pose_t cpa_fix(uint32_t mmsi, uint32_t t, float east, float north) {
+    se3_pose_t p;
+    memset(&p, 0, sizeof(p));
+    p.translation[0] = FLOAT_TO_FIXED(east);
+    p.translation[1] = FLOAT_TO_FIXED(north);
+    p.timestamp = t;
+    p.mmsi = mmsi;
+    return p;
+}
+
+void test_cpa(void) {
+    printf("\n[TEST] CPA/TCPA Screening\n");
+
+    /* Kernel: head-on with 100 m lateral offset, closing at 10 m/s */
+    fixed_t pa[2] = { 0, 0 }, va[2] = { INT_TO_FIXED(5), 0 };
+    fixed_t pb[2] = { INT_TO_FIXED(1000), INT_TO_FIXED(100) }, vb[2] = { -INT_TO_FIXED(5), 0 };
+    fixed_t dcpa, tcpa;
+    cpa_compute(pa, va, pb, vb, &dcpa, &tcpa);
+    TEST_ASSERT(abs(tcpa - INT_TO_FIXED(100)) < FRACUNIT / 100 &&
+                abs(dcpa - INT_TO_FIXED(100)) < FRACUNIT / 100,
+                "Head-on: TCPA = 100 s, DCPA = 100 m");
+
+    /* Diverging and parallel tracks: closest point is now */
+    fixed_t vb_away[2] = { INT_TO_FIXED(8), 0 };
+    cpa_compute(pa, va, pb, vb_away, &dcpa, &tcpa);
+    TEST_ASSERT(tcpa == 0 && abs(dcpa - INT_TO_FIXED(1005)) < FRACUNIT,
+                "Diverging: TCPA = 0, DCPA = current range");
+    cpa_compute(pa, va, pb, va, &dcpa, &tcpa);
+    TEST_ASSERT(tcpa == 0 && abs(dcpa - INT_TO_FIXED(1005)) < FRACUNIT,
+                "Parallel (no relative motion): TCPA = 0");
+
+    /* Saturation far outside the 16.16 range */
+    fixed_t vfast[2] = { -INT_TO_FIXED(20000), INT_TO_FIXED(30000) };
+    fixed_t pfar[2] = { INT_TO_FIXED(30000), -INT_TO_FIXED(30000) };
+    fixed_t vslow[2] = { 0, FRACUNIT / 1000 };
+    cpa_compute(pa, vslow, pfar, vfast, &dcpa, &tcpa);
+    TEST_ASSERT(dcpa >= 0 && tcpa >= 0, "Extreme inputs stay non-negative");
+
+    static t_bsp_t bsp;
+    static cpa_engine_t cpa;
+    t_bsp_init(&bsp, 0, 0);
+    cpa_init(&cpa, INT_TO_FIXED(200), INT_TO_FIXED(600), 300);
+
+    uint16_t cell_a = t_bsp_latlon_to_cell(&bsp, FLOAT_TO_FIXED(0.05f), FLOAT_TO_FIXED(0.05f));
+    uint16_t cell_b = t_bsp_latlon_to_cell(&bsp, FLOAT_TO_FIXED(0.05f), FLOAT_TO_FIXED(0.15f));
+    uint16_t cell_far = t_bsp_latlon_to_cell(&bsp, FLOAT_TO_FIXED(0.05f), FLOAT_TO_FIXED(0.55f));
+    cpa_alert_t alerts[8];
+
+    /* Same head-on encounter from fixes; B sits in the adjacent cell */
+    se3_pose_t f;
+    f = cpa_fix(1001, 0, 0.0f, 0.0f);
+    int n0 = cpa_update(&cpa, &bsp, cell_a, &f, alerts, 8);
+    f = cpa_fix(1002, 0, 1000.0f, 100.0f);
+    n0 += cpa_update(&cpa, &bsp, cell_b, &f, alerts, 8);
+    f = cpa_fix(1001, 10, 50.0f, 0.0f);
+    n0 += cpa_update(&cpa, &bsp, cell_a, &f, alerts, 8);
+    TEST_ASSERT(n0 == 0 && cpa.pairs_evaluated == 0,
+                "No CPA until both vessels have a velocity");
+
+    f = cpa_fix(1002, 10, 950.0f, 100.0f);
+    int n = cpa_update(&cpa, &bsp, cell_b, &f, alerts, 8);
+    TEST_ASSERT(n == 1 && alerts[0].mmsi_a == 1002 && alerts[0].mmsi_b == 1001 &&
+                abs(alerts[0].tcpa - INT_TO_FIXED(90)) < FRACUNIT / 10 &&
+                abs(alerts[0].dcpa - INT_TO_FIXED(100)) < FRACUNIT / 10,
+                "Adjacent-cell encounter alerts (TCPA 90 s, DCPA 100 m)");
+
+    /* Partner extrapolated to the fix time: A reports 5 s later */
+    f = cpa_fix(1001, 15, 75.0f, 0.0f);
+    n = cpa_update(&cpa, &bsp, cell_a, &f, alerts, 8);
+    TEST_ASSERT(n == 1 && abs(alerts[0].tcpa - INT_TO_FIXED(85)) < FRACUNIT / 10,
+                "Partner dead-reckoned to the fix timestamp");
+
+    /* Tight threshold: no alert */
+    cpa.dcpa_threshold = INT_TO_FIXED(50);
+    f = cpa_fix(1002, 20, 900.0f, 100.0f);
+    n = cpa_update(&cpa, &bsp, cell_b, &f, alerts, 8);
+    TEST_ASSERT(n == 0, "DCPA above threshold: no alert");
+    cpa.dcpa_threshold = INT_TO_FIXED(200);
+
+    /* Vessels outside the 3×3 neighbourhood are never paired */
+    uint64_t pairs = cpa.pairs_evaluated;
+    f = cpa_fix(1003, 0, 60.0f, 0.0f);
+    cpa_update(&cpa, &bsp, cell_far, &f, alerts, 8);
+    f = cpa_fix(1003, 10, 40.0f, 0.0f);
+    n = cpa_update(&cpa, &bsp, cell_far, &f, alerts, 8);
+    TEST_ASSERT(n == 0 && cpa.pairs_evaluated == pairs,
+                "Non-adjacent cell is not screened");
+
+    /* Cell change relinks: A moves next to the far vessel */
+    f = cpa_fix(1001, 20, 100.0f, 0.0f);
+    cpa_update(&cpa, &bsp, cell_far, &f, alerts, 8);
+    f = cpa_fix(1003, 20, 110.0f, 0.0f);
+    n = cpa_update(&cpa, &bsp, cell_far, &f, alerts, 8);
+    TEST_ASSERT(n == 1 && alerts[0].mmsi_b == 1001, "Relinked vessel screened in its new cell");
+    f = cpa_fix(1002, 30, 850.0f, 100.0f);
+    n = cpa_update(&cpa, &bsp, cell_b, &f, alerts, 8);
+    TEST_ASSERT(n == 0, "Relinked vessel left the old neighbourhood");
+
+    /* Out-of-order fix is ignored */
+    f = cpa_fix(1001, 5, -5000.0f, 0.0f);
+    n = cpa_update(&cpa, &bsp, cell_a, &f, alerts, 8);
+    TEST_ASSERT(n == 0 && cpa.n_vessels == 3, "Out-of-order fix ignored");
+
+    /* Expiry removes stale vessels; slots are reusable */
+    int removed = cpa_expire(&cpa, 1000);
+    TEST_ASSERT(removed == 3 && cpa.n_vessels == 0, "Stale vessels expired");
+    f = cpa_fix(1001, 1000, 0.0f, 0.0f);
+    n = cpa_update(&cpa, &bsp, cell_a, &f, alerts, 8);
+    TEST_ASSERT(n == 0 && cpa.n_vessels == 1, "Expired vessel re-tracked as new");
+
+    /* Re-centers between updates: links are re-keyed into the new window */
+    cpa_init(&cpa, INT_TO_FIXED(200), INT_TO_FIXED(600), 300);
+    f = cpa_fix(1001, 0, 0.0f, 0.0f);
+    cpa_update(&cpa, &bsp, cell_a, &f, alerts, 8);
+    f = cpa_fix(1002, 0, 1000.0f, 100.0f);
+    cpa_update(&cpa, &bsp, cell_b, &f, alerts, 8);
+    f = cpa_fix(1001, 10, 50.0f, 0.0f);
+    cpa_update(&cpa, &bsp, cell_a, &f, alerts, 8);
+    f = cpa_fix(1002, 10, 950.0f, 100.0f);
+    cpa_update(&cpa, &bsp, cell_b, &f, alerts, 8);
+    t_bsp_recenter_begin(&bsp, FLOAT_TO_FIXED(0.5f), FLOAT_TO_FIXED(0.5f));
+    t_bsp_recenter_step(&bsp, MAX_CELLS);
+    t_bsp_recenter_begin(&bsp, FLOAT_TO_FIXED(-0.3f), FLOAT_TO_FIXED(0.8f));
+    t_bsp_recenter_step(&bsp, MAX_CELLS);
+    uint16_t cell_a2 = t_bsp_latlon_to_cell(&bsp, FLOAT_TO_FIXED(0.05f), FLOAT_TO_FIXED(0.05f));
+    f = cpa_fix(1001, 15, 75.0f, 0.0f);
+    n = cpa_update(&cpa, &bsp, cell_a2, &f, alerts, 8);
+    TEST_ASSERT(cell_a2 != cell_a && n == 1 && alerts[0].mmsi_b == 1002 &&
+                cpa.grid_epoch == bsp.grid_epoch,
+                "Encounter still screened after two re-centers between updates");
+}
+
+/* ========================================================================
+ * TEST: Traffic-Density Raster
+ * ======================================================================== */
+
+static int density_fix(density_raster_t* dr, t_bsp_t* bsp, float lat, float lon,
+                       uint32_t t, uint8_t vclass) {
+    fixed_t flat = FLOAT_TO_FIXED(lat), flon = FLOAT_TO_FIXED(lon);
+    return density_add(dr, bsp, t_bsp_latlon_to_cell(bsp, flat, flon), flat, flon, t, vclass);
+}
+
+void test_density(void) {
+    printf("\n[TEST] Traffic-Density Raster\n");
+
+    static t_bsp_t bsp;
+    static density_raster_t dr;
+    t_bsp_init(&bsp, 0, 0);
+    density_init(&dr, DENSITY_MODE_WINDOW, 600);
+
+    /* Cell (0,0) spans 0-0.0898°: corners land in opposite pixels */
+    uint16_t cell = t_bsp_latlon_to_cell(&bsp, FLOAT_TO_FIXED(0.05f), FLOAT_TO_FIXED(0.05f));
+    density_fix(&dr, &bsp, 0.001f, 0.001f, 100, 0);
+    density_fix(&dr, &bsp, 0.001f, 0.001f, 110, 0);
+    density_fix(&dr, &bsp, 0.0895f, 0.0895f, 120, 0);
+    density_fix(&dr, &bsp, 0.045f, 0.001f, 130, 0);
+    TEST_ASSERT(dr.n_tiles == 1 && density_get(&dr, cell, 0, 0, 0) == 2 &&
+                density_get(&dr, cell, 0, DENSITY_TILE_DIM - 1, DENSITY_TILE_DIM - 1) == 1 &&
+                density_get(&dr, cell, 0, DENSITY_TILE_DIM / 2, 0) == 1,
+                "Fixes binned into the cell's tile (row = south→north)");
+
+    /* Class beyond the configured layers counts in the total only */
+    density_fix(&dr, &bsp, 0.001f, 0.001f, 140, DENSITY_LAYERS);
+    TEST_ASSERT(density_get(&dr, cell, 0, 0, 0) == 3, "Unlayered class counts in layer 0");
+#if DENSITY_LAYERS > 1
+    density_fix(&dr, &bsp, 0.001f, 0.001f, 150, 1);
+    TEST_ASSERT(density_get(&dr, cell, 1, 0, 0) == 1 && density_get(&dr, cell, 0, 0, 0) == 4,
+                "Class layer counts alongside the total");
+#endif
+
+    /* Tumbling window: next window starts empty; late fixes rejected */
+    density_fix(&dr, &bsp, 0.0895f, 0.0895f, 700, 0);
+    TEST_ASSERT(density_get(&dr, cell, 0, 0, 0) == 0 &&
+                density_get(&dr, cell, 0, DENSITY_TILE_DIM - 1, DENSITY_TILE_DIM - 1) == 1,
+                "New window clears the tile");
+    TEST_ASSERT(density_fix(&dr, &bsp, 0.001f, 0.001f, 500, 0) == -1,
+                "Fix from a closed window rejected");
+
+    /* Exponential decay: halve per elapsed window */
+    density_init(&dr, DENSITY_MODE_DECAY, 600);
+    for (int k = 0; k < 8; k++) density_fix(&dr, &bsp, 0.001f, 0.001f, 10u + k, 0);
+    density_advance(&dr, 600);
+    uint16_t one = density_get(&dr, cell, 0, 0, 0);
+    density_advance(&dr, 1200);
+    uint16_t two = density_get(&dr, cell, 0, 0, 0);
+    TEST_ASSERT(one == 4 && two == 2, "Decay halves counts per window (8 → 4 → 2)");
+
+    /* Export round trip */
+    density_init(&dr, DENSITY_MODE_WINDOW, 3600);
+    uint32_t n_fixes = 0;
+    for (int k = 0; k < 500; k++) {
+        float lat = -0.15f + 0.3f * (float)((k * 37) % 101) / 100.0f;
+        float lon = -0.15f + 0.3f * (float)((k * 53) % 97) / 96.0f;
+        n_fixes += density_fix(&dr, &bsp, lat, lon, 100u + (uint32_t)k, 0) >= 0;
+    }
+    static uint8_t buf[32768];
+    size_t len = density_export(&dr, buf, sizeof(buf));
+    int header_ok = len > DENSITY_EXPORT_HEADER && (buf[0] | (buf[1] << 8)) == DENSITY_EXPORT_MAGIC &&
+                    buf[3] == DENSITY_TILE_DIM;
+    uint16_t n_records = (uint16_t)(buf[6] | (buf[7] << 8));
+    size_t pos = DENSITY_EXPORT_HEADER;
+    uint32_t total = 0;
+    int match = 1;
+    uint16_t pixels[DENSITY_TILE_PIXELS];
+    for (uint16_t r = 0; r < n_records; r++) {
+        density_tile_info_t info;
+        size_t n = density_decode_tile(buf + pos, len - pos, &info, pixels);
+        if (n == 0) { match = 0; break; }
+        pos += n;
+        for (int k = 0; k < DENSITY_TILE_PIXELS; k++) {
+            total += pixels[k];
+            match &= pixels[k] == density_get(&dr, info.cell_id, info.layer,
+                                              k / DENSITY_TILE_DIM, k % DENSITY_TILE_DIM);
+        }
+    }
+    printf("    %u fixes → %u tiles, %zu export bytes (raw %zu)\n", n_fixes, dr.n_tiles, len,
+           (size_t)dr.n_tiles * DENSITY_TILE_PIXELS * sizeof(uint16_t));
+    TEST_ASSERT(header_ok && match && pos == len && total == n_fixes && n_records == dr.n_tiles,
+                "Export decodes to the raster (all fixes accounted)");
+    TEST_ASSERT(density_export(&dr, buf, 20) == 0, "Export into a short buffer fails cleanly");
+
+    /* South of the origin: tiles follow the classifier's edges, not the
+     * nominal grid (cell -1 is ~1 km tall, cell -2 starts 9 km north) */
+    static const uint16_t south[2] = { 0xff00, 0xfe00 };
+    for (int c = 0; c < 2; c++) {
+        density_init(&dr, DENSITY_MODE_WINDOW, 3600);
+        fixed_t lat_min, lat_max, lon_min, lon_max;
+        t_bsp_get_cell_edges(&bsp, south[c], &lat_min, &lat_max, &lon_min, &lon_max);
+        int in_cell = 1, rows_hit = 0;
+        uint32_t row_max = 0;
+        for (int k = 0; k < 1000; k++) {
+            fixed_t lat = lat_min + (fixed_t)(((int64_t)(lat_max - lat_min) * (2 * k + 1)) / 2000);
+            fixed_t lon = lon_min + (fixed_t)(((int64_t)(lon_max - lon_min) * ((k * 7) % 1000)) / 1000);
+            uint16_t id = t_bsp_latlon_to_cell(&bsp, lat, lon);
+            in_cell &= id == south[c];
+            density_add(&dr, &bsp, id, lat, lon, 100u + (uint32_t)k, 0);
+        }
+        for (int row = 0; row < DENSITY_TILE_DIM; row++) {
+            uint32_t n = 0;
+            for (int col = 0; col < DENSITY_TILE_DIM; col++) {
+                n += density_get(&dr, south[c], 0, row, col);
+            }
+            rows_hit += n > 0;
+            if (n > row_max) row_max = n;
+        }
+        len = density_export(&dr, buf, sizeof(buf));
+        density_tile_info_t info;
+        int bounds_ok = density_decode_tile(buf + DENSITY_EXPORT_HEADER,
+                                            len - DENSITY_EXPORT_HEADER, &info, pixels) > 0 &&
+                        info.lat_min == lat_min && info.lat_max == lat_max &&
+                        info.lon_min == lon_min && info.lon_max == lon_max;
+        printf("    cell 0x%04x: %.2f km tall, %d rows hit, busiest row %u\n", south[c],
+               FIXED_TO_FLOAT(lat_max - lat_min) * 111.32f, rows_hit, row_max);
+        TEST_ASSERT(in_cell && rows_hit == DENSITY_TILE_DIM &&
+                    row_max <= 2 * 1000 / DENSITY_TILE_DIM && bounds_ok,
+                    c == 0 ? "Cell -1 fixes spread over every tile row"
+                           : "Cell -2 fixes spread over every tile row");
+    }
+
+    /* Pool full: least recently touched tile is recycled */
+    density_init(&dr, DENSITY_MODE_WINDOW, 60);
+    for (int k = 0; k < DENSITY_MAX_TILES; k++) {
+        density_fix(&dr, &bsp, 0.05f, 0.05f + 0.1f * (float)k, (uint32_t)(k * 60), 0);
+    }
+    density_fix(&dr, &bsp, 0.25f, 0.05f, (uint32_t)(DENSITY_MAX_TILES * 60), 0);
+    TEST_ASSERT(dr.n_tiles == DENSITY_MAX_TILES && dr.evictions == 1 &&
+                density_get(&dr, cell, 0, 8, 8) == 0,
+                "Oldest tile evicted when the pool is full");
+
+    /* Grid re-center re-keys tiles to the same physical cells */
+    density_init(&dr, DENSITY_MODE_WINDOW, 3600);
+    density_fix(&dr, &bsp, 0.05f, 0.05f, 100, 0);
+    t_bsp_recenter_begin(&bsp, FLOAT_TO_FIXED(0.5f), FLOAT_TO_FIXED(0.5f));
+    t_bsp_recenter_step(&bsp, MAX_CELLS);
+    density_fix(&dr, &bsp, 0.05f, 0.05f, 110, 0);
+    uint16_t moved = t_bsp_latlon_to_cell(&bsp, FLOAT_TO_FIXED(0.05f), FLOAT_TO_FIXED(0.05f));
+    TEST_ASSERT(dr.n_tiles == 1 && moved != cell && density_get(&dr, moved, 0, 8, 8) == 2,
+                "Tiles re-keyed after grid re-center");
+}
+
+/* In-memory link for the replication test: sink queues frames */
+typedef struct {
+    uint8_t frames[64][REPLOG_FRAME_MAX];
+    uint16_t lens[64];
+    int n;
+} frame_queue_t;
+
+static void queue_sink(void* ctx, const uint8_t* frame, size_t len) {
+    frame_queue_t* q = (frame_queue_t*)ctx;
+    if (q->n < 64) {
+        memcpy(q->frames[q->n], frame, len);
+        q->lens[q->n++] = (uint16_t)len;
+    }
+}
+
+/* Apply every queued frame; returns the first error (REPLOG_OK if none) */
+static int queue_drain(frame_queue_t* q, replog_mirror_t* m) {
+    int err = REPLOG_OK;
+    for (int i = 0; i < q->n; i++) {
+        int r = replog_apply(m, q->frames[i], q->lens[i]);
+        if (err == REPLOG_OK) err = r;
+    }
+    q->n = 0;
+    return err;
+}
+
+static void replog_fix(replog_writer_t* w, t_bsp_t* bsp, uint32_t mmsi, float lat, float lon,
+                       uint32_t t) {
+    se3_pose_t p;
+    memset(&p, 0, sizeof(p));
+    p.rotation[0] = p.rotation[4] = p.rotation[8] = FRACUNIT;
+    p.translation[0] = FLOAT_TO_FIXED(lon);
+    p.translation[1] = FLOAT_TO_FIXED(lat);
+    p.timestamp = t;
+    p.mmsi = mmsi;
+    uint16_t cell = t_bsp_latlon_to_cell(bsp, p.translation[1], p.translation[0]);
+    replog_insert(w, bsp, cell, &p);
+}
+
+void test_replog(void) {
+    printf("\n[TEST] Primary/Standby Replication\n");
+
+    static t_bsp_t primary, standby;
+    static frame_queue_t q;
+    static replog_writer_t w;
+    static replog_mirror_t m;
+    t_bsp_init(&primary, 0, 0);
+    t_bsp_init(&standby, 0, 0);
+    replog_writer_init(&w, queue_sink, &q);
+    replog_mirror_init(&m, &standby);
+
+    /* Frames before the first snapshot are refused */
+    replog_fix(&w, &primary, 1, 0.01f, 0.01f, 100);
+    replog_flush(&w);
+    TEST_ASSERT(queue_drain(&q, &m) == REPLOG_ERR_UNSYNCED && !m.synced,
+                "Mirror waits for a snapshot");
+
+    replog_snapshot(&w, &primary);
+    TEST_ASSERT(queue_drain(&q, &m) == REPLOG_OK && m.synced &&
+                replog_digest(&standby) == replog_digest(&primary),
+                "Snapshot brings the mirror in sync");
+
+    /* Steady state: 8 vessels × 40 fixes across a few cells */
+    for (int t = 0; t < 40; t++) {
+        for (uint32_t v = 0; v < 8; v++) {
+            replog_fix(&w, &primary, 367000000u + v, 0.01f * (float)v + 0.002f * (float)t,
+                       0.05f + 0.001f * (float)t, 200u + (uint32_t)t * 10u);
+        }
+    }
+    replog_flush(&w);
+    uint64_t bytes = w.bytes_sent;
+    TEST_ASSERT(queue_drain(&q, &m) == REPLOG_OK &&
+                replog_digest(&standby) == replog_digest(&primary) && primary.active_count > 1,
+                "Delta-encoded inserts reproduce the grid bit-exactly");
+    printf("    %u inserts in %u frames, %.1f bytes/fix (raw pose %zu)\n", w.inserts,
+           w.frames_sent, (double)bytes / w.inserts, sizeof(se3_pose_t));
+    TEST_ASSERT((double)bytes / w.inserts < 16.0, "Log well below raw pose size");
+
+    /* Seals, reset, re-center */
+    uint16_t cell = t_bsp_latlon_to_cell(&primary, FLOAT_TO_FIXED(0.01f), FLOAT_TO_FIXED(0.05f));
+    uint16_t other = t_bsp_latlon_to_cell(&primary, FLOAT_TO_FIXED(0.12f), FLOAT_TO_FIXED(0.05f));
+    replog_seal(&w, cell, 12);
+    replog_seal(&w, other, 7);
+    replog_seal_done(&w, other);
+    replog_reset_cell(&w, &primary, other);
+    replog_recenter_begin(&w, &primary, FLOAT_TO_FIXED(0.5f), FLOAT_TO_FIXED(0.5f));
+    t_bsp_recenter_step(&primary, MAX_CELLS);
+    replog_fix(&w, &primary, 367000001u, 0.02f, 0.09f, 900);
+    replog_flush(&w);
+    replog_seal_t pending[REPLOG_MAX_PENDING];
+    uint16_t moved = t_bsp_latlon_to_cell(&primary, FLOAT_TO_FIXED(0.01f), FLOAT_TO_FIXED(0.05f));
+    TEST_ASSERT(queue_drain(&q, &m) == REPLOG_OK &&
+                replog_digest(&standby) == replog_digest(&primary) &&
+                standby.center_lat_idx == primary.center_lat_idx,
+                "Reset and re-center replicate");
+    int n = replog_mirror_pending(&m, pending, REPLOG_MAX_PENDING);
+    TEST_ASSERT(n == 1 && pending[0].cell_id == moved && pending[0].pose_count == 12,
+                "Pending seal survives re-center under its new cell ID");
+
+    /* Corrupted frame rejected without touching the mirror */
+    replog_fix(&w, &primary, 367000002u, 0.03f, 0.09f, 910);
+    replog_flush(&w);
+    q.frames[0][REPLOG_FRAME_HEADER + 3] ^= 0x10;
+    uint32_t before = replog_digest(&standby);
+    TEST_ASSERT(replog_apply(&m, q.frames[0], q.lens[0]) == REPLOG_ERR_CHECKSUM &&
+                replog_digest(&standby) == before, "Checksum mismatch rejected");
+    q.n = 0;
+
+    /* Next frame reveals the gap; a snapshot resynchronizes */
+    replog_fix(&w, &primary, 367000003u, 0.04f, 0.09f, 920);
+    replog_flush(&w);
+    TEST_ASSERT(queue_drain(&q, &m) == REPLOG_ERR_GAP && !m.synced, "Sequence gap detected");
+    replog_snapshot(&w, &primary);
+    TEST_ASSERT(queue_drain(&q, &m) == REPLOG_OK &&
+                replog_digest(&standby) == replog_digest(&primary) &&
+                replog_mirror_pending(&m, pending, REPLOG_MAX_PENDING) == 1,
+                "Snapshot after a gap restores the mirror and pending seals");
+}
+
+/* ========================================================================
+ * TEST: Arrow C Data Interface Export
+ * ======================================================================== */
+
+/* Look up a schema metadata value (Arrow key/value encoding) */
+static bool arrow_metadata_get(const char* md, const char* key, char* out, size_t cap) {
+    int32_t pairs, klen, vlen;
+    if (!md) return false;
+    memcpy(&pairs, md, 4);
+    md += 4;
+    for (int32_t i = 0; i < pairs; i++) {
+        memcpy(&klen, md, 4);
+        const char* k = md + 4;
+        memcpy(&vlen, k + klen, 4);
+        const char* v = k + klen + 4;
+        if ((size_t)klen == strlen(key) && memcmp(k, key, (size_t)klen) == 0 && (size_t)vlen < cap) {
+            memcpy(out, v, (size_t)vlen);
+            out[vlen] = '\0';
+            return true;
+        }
+        md = v + vlen;
+    }
+    return false;
+}
+
+void test_arrow_export(void) {
+    printf("\n[TEST] Arrow C Data Interface Export\n");
+
+    static t_bsp_t bsp;
+    static arrow_batch_t b;
+    struct ArrowSchema schema;
+    struct ArrowArray array;
+    t_bsp_init(&bsp, 0, 0);
+    arrow_batch_init(&b);
+
+    uint16_t cell = t_bsp_latlon_to_cell(&bsp, FLOAT_TO_FIXED(0.01f), FLOAT_TO_FIXED(0.01f));
+    se3_pose_t p;
+    se3_pose_identity(&p);
+    for (int i = 0; i < 10; i++) {
+        p.translation[0] = INT_TO_FIXED(i);
+        p.timestamp = 1000u + (uint32_t)i;
+        p.mmsi = 366000000u + (uint32_t)i;
+        t_bsp_insert_pose(&bsp, cell, &p);
+    }
+
+    /* Packed: one fixed_size_binary(56) column over the slab itself */
+    t_bsp_cell_t* c = t_bsp_get_cell(&bsp, cell);
+    TEST_ASSERT(arrow_export_cell(&b, &bsp, cell, &schema, &array) == ARROW_EXPORT_OK &&
+                strcmp(schema.format, "+s") == 0 && schema.n_children == 1 &&
+                strcmp(schema.children[0]->format, "w:56") == 0 &&
+                strcmp(schema.children[0]->name, "pose") == 0 && array.length == 10,
+                "Cell exports as struct<pose: w:56> with pose_count rows");
+    TEST_ASSERT(array.children[0]->buffers[1] == (const void*)t_bsp_cell_poses(&bsp, c) &&
+                array.children[0]->buffers[0] == NULL && array.null_count == 0,
+                "Pose column points at the cell slab (zero-copy, no validity)");
+    char value[32];
+    char expect[8];
+    snprintf(expect, sizeof(expect), "%u", cell);
+    TEST_ASSERT(arrow_metadata_get(schema.metadata, "cell_id", value, sizeof(value)) &&
+                strcmp(value, expect) == 0 &&
+                arrow_metadata_get(schema.metadata, "lat_max", value, sizeof(value)) &&
+                strcmp(value, "0.089828") == 0,
+                "Cell ID and bounds carried as schema metadata");
+    TEST_ASSERT(arrow_export_cell(&b, &bsp, cell, &schema, &array) == ARROW_EXPORT_ERR_BUSY,
+                "Second export refused until the consumer releases");
+    schema.release(&schema);
+    TEST_ASSERT(arrow_batch_busy(&b) && schema.release == NULL, "Schema released alone");
+    array.release(&array);
+    TEST_ASSERT(!arrow_batch_busy(&b) && array.release == NULL, "Array release frees the batch");
+    TEST_ASSERT(arrow_export_cell(&b, &bsp, 0x7F7F, &schema, &array) == ARROW_EXPORT_ERR_NO_CELL,
+                "Inactive cell refused");
+
+    /* Columnar: transpose once, export fixed-size lists over SoA arrays */
+    static fixed_t rot[MAX_POSES_PER_CELL][9], trans[MAX_POSES_PER_CELL][3];
+    static uint32_t ts[MAX_POSES_PER_CELL], mmsi[MAX_POSES_PER_CELL];
+    arrow_pose_columns_t cols = { rot, trans, ts, mmsi, 0, MAX_POSES_PER_CELL };
+    TEST_ASSERT(arrow_cell_to_columns(&bsp, cell, &cols) == ARROW_EXPORT_OK && cols.count == 10 &&
+                trans[7][0] == INT_TO_FIXED(7) && rot[7][4] == FRACUNIT && mmsi[3] == 366000003u,
+                "Slab transposed into pose columns");
+    arrow_export_pose_columns(&b, &cols, &bsp, cell, &schema, &array);
+    struct ArrowArray* tr = array.children[1];
+    TEST_ASSERT(schema.n_children == 4 && strcmp(schema.children[1]->format, "+w:3") == 0 &&
+                strcmp(schema.children[1]->children[0]->format, "i") == 0 &&
+                tr->n_buffers == 1 && tr->children[0]->length == 30 &&
+                tr->children[0]->buffers[1] == (const void*)trans &&
+                array.children[3]->buffers[1] == (const void*)mmsi,
+                "Pose columns export as fixed_size_list<int32> and uint32 over SoA arrays");
+    array.release(&array);
+    schema.release(&schema);
+
+    /* DLT records: packed w:148 and one column per field */
+    static dlt_record_t rec[4];
+    static char ds[4][32];
+    static uint32_t r_mmsi[4], r_ts[4];
+    static uint16_t r_cell[4];
+    static fixed_t r_lambda[4], r_err[4];
+    static uint8_t r_hash[4][32], r_sig[4][64];
+    memset(rec, 0, sizeof(rec));
+    for (int i = 0; i < 4; i++) {
+        strcpy(rec[i].dataset, "MarineCadastre_AIS");
+        rec[i].mmsi = 367000000u + (uint32_t)i;
+        rec[i].cell_id = (uint16_t)i;
+        rec[i].lambda_optimal = FLOAT_TO_FIXED(0.9f);
+        rec[i].signature[63] = (uint8_t)i;
+    }
+    TEST_ASSERT(arrow_export_dlt(&b, rec, 4, &schema, &array) == ARROW_EXPORT_OK &&
+                strcmp(schema.children[0]->format, "w:148") == 0 &&
+                array.children[0]->buffers[1] == (const void*)rec && array.length == 4,
+                "DLT records export as w:148 over the record array");
+    array.release(&array);
+    schema.release(&schema);
+    arrow_dlt_columns_t dc = { ds, r_mmsi, r_cell, r_lambda, r_err, r_hash, r_ts, r_sig, 0, 4 };
+    TEST_ASSERT(arrow_dlt_to_columns(rec, 4, &dc) == ARROW_EXPORT_OK &&
+                arrow_export_dlt_columns(&b, &dc, &schema, &array) == ARROW_EXPORT_OK &&
+                schema.n_children == 8 && strcmp(schema.children[2]->format, "S") == 0 &&
+                r_mmsi[2] == 367000002u && r_sig[3][63] == 3 &&
+                array.children[7]->buffers[1] == (const void*)r_sig,
+                "DLT columns export one Arrow column per record field");
+    array.release(&array);
+    schema.release(&schema);
+    TEST_ASSERT(arrow_dlt_to_columns(rec, 5, &dc) == ARROW_EXPORT_ERR_CAPACITY,
+                "Column capacity enforced");
+}
+
+/* ========================================================================
+ * TEST: Same-Cell Fast Path
+ * ======================================================================== */
+
+/* Header bounds are exactly the region t_bsp_latlon_to_cell() maps to it */
+static bool bounds_exact(t_bsp_t* bsp, const t_bsp_cell_t* c) {
+    fixed_t lat_in = c->lat_min + (c->lat_max - c->lat_min) / 2;
+    fixed_t lon_in = c->lon_min + (c->lon_max - c->lon_min) / 2;
+    uint16_t id = c->cell_id;
+    return t_bsp_latlon_to_cell(bsp, c->lat_min, lon_in) == id &&
+           t_bsp_latlon_to_cell(bsp, c->lat_min - 1, lon_in) != id &&
+           t_bsp_latlon_to_cell(bsp, c->lat_max - 1, lon_in) == id &&
+           t_bsp_latlon_to_cell(bsp, c->lat_max, lon_in) != id &&
+           t_bsp_latlon_to_cell(bsp, lat_in, c->lon_min) == id &&
+           t_bsp_latlon_to_cell(bsp, lat_in, c->lon_min - 1) != id &&
+           t_bsp_latlon_to_cell(bsp, lat_in, c->lon_max - 1) == id &&
+           t_bsp_latlon_to_cell(bsp, lat_in, c->lon_max) != id;
+}
+
+/* Random walk of n vessels; counts locate/classify disagreements */
+static int locator_walk(t_bsp_t* bsp, t_bsp_locator_t* loc, int n, int steps,
+                        float lat0, float lon0, float area, bool recenter) {
+    float lat[64], lon[64], dlat[64], dlon[64];
+    for (int v = 0; v < n; v++) {
+        lat[v] = lat0 + area * (2.0f * rand() / RAND_MAX - 1.0f);
+        lon[v] = lon0 + area * (2.0f * rand() / RAND_MAX - 1.0f);
+        dlat[v] = 0.001f * (2.0f * rand() / RAND_MAX - 1.0f);
+        dlon[v] = 0.001f * (2.0f * rand() / RAND_MAX - 1.0f);
+    }
+    se3_pose_t pose;
+    se3_pose_identity(&pose);
+    int mismatches = 0;
+    for (int k = 0; k < steps; k++) {
+        if (recenter && k == steps / 2) {
+            t_bsp_recenter_begin(bsp, FLOAT_TO_FIXED(lat0 + 0.3f), FLOAT_TO_FIXED(lon0));
+        }
+        if (recenter && k > steps / 2) t_bsp_recenter_step(bsp, 1);
+        for (int v = 0; v < n; v++) {
+            lat[v] += dlat[v];
+            lon[v] += dlon[v];
+            if (fabsf(lat[v] - lat0) > area) dlat[v] = -dlat[v];
+            if (fabsf(lon[v] - lon0) > area) dlon[v] = -dlon[v];
+            fixed_t flat = FLOAT_TO_FIXED(lat[v]), flon = FLOAT_TO_FIXED(lon[v]);
+            uint16_t id = t_bsp_locate(bsp, loc, 9000 + v, flat, flon);
+            if (id != t_bsp_latlon_to_cell(bsp, flat, flon)) mismatches++;
+            pose.mmsi = 9000 + v;
+            t_bsp_insert_pose(bsp, id, &pose);
+            t_bsp_cell_t* c = t_bsp_get_cell(bsp, id);
+            if (c && c->pose_count == MAX_POSES_PER_CELL) t_bsp_reset_cell(bsp, id);
+        }
+    }
+    return mismatches;
+}
+
+void test_cell_locator(void) {
+    printf("\n[TEST] Same-Cell Fast Path (populated bounds, locator)\n");
+
+    static t_bsp_t bsp;
+    static t_bsp_locator_t loc;
+    fixed_t lat0 = FLOAT_TO_FIXED(47.0f);
+    fixed_t lon0 = FLOAT_TO_FIXED(-122.0f);
+    t_bsp_init(&bsp, lat0, lon0);
+
+    se3_pose_t pose;
+    se3_pose_identity(&pose);
+    uint16_t id = t_bsp_latlon_to_cell(&bsp, lat0, lon0);
+    t_bsp_insert_pose(&bsp, id, &pose);
+    const t_bsp_cell_t* c = t_bsp_get_cell(&bsp, id);
+
+    fixed_t lat_min, lat_max, lon_min, lon_max;
+    t_bsp_get_cell_bounds(&bsp, id, &lat_min, &lat_max, &lon_min, &lon_max);
+    TEST_ASSERT(c->lat_min <= lat0 && lat0 < c->lat_max && c->lon_min <= lon0 && lon0 < c->lon_max,
+                "Allocated header bounds contain the fix");
+    TEST_ASSERT(abs(c->lat_min - lat_min) < 16 && abs(c->lat_max - lat_max) < 16 &&
+                abs(c->lon_min - lon_min) < 16 && abs(c->lon_max - lon_max) < 16,
+                "North/east of origin, header bounds match t_bsp_get_cell_bounds()");
+    TEST_ASSERT(bounds_exact(&bsp, c), "Origin cell bounds are the classifier's exact edges");
+
+    /* South-west cells: classifier rounding moves edges off the nominal grid */
+    bool exact = true;
+    for (int k = 1; k <= 12; k++) {
+        fixed_t lat = lat0 - FLOAT_TO_FIXED(0.031f * k);
+        fixed_t lon = lon0 - FLOAT_TO_FIXED(0.047f * k);
+        uint16_t sw = t_bsp_latlon_to_cell(&bsp, lat, lon);
+        t_bsp_insert_pose(&bsp, sw, &pose);
+        if (!bounds_exact(&bsp, t_bsp_get_cell(&bsp, sw))) exact = false;
+    }
+    TEST_ASSERT(exact, "South-west cell bounds are exact despite negative rounding");
+
+    /* Dateline: a cell reaching past ±180° must never pass the bounds test */
+    t_bsp_init(&bsp, 0, FLOAT_TO_FIXED(179.95f));
+    id = t_bsp_latlon_to_cell(&bsp, 0, FLOAT_TO_FIXED(179.99f));
+    t_bsp_insert_pose(&bsp, id, &pose);
+    c = t_bsp_get_cell(&bsp, id);
+    TEST_ASSERT(c->lon_min >= c->lon_max, "Cell across the dateline has an empty longitude range");
+
+    /* Stream equivalence: every fix classified exactly as the full path */
+    t_bsp_init(&bsp, lat0, lon0);
+    t_bsp_locator_init(&loc);
+    int bad = locator_walk(&bsp, &loc, 40, 300, 47.0f, -122.0f, 0.3f, false);
+    TEST_ASSERT(bad == 0, "Locator agrees with t_bsp_latlon_to_cell (12,000 fixes)");
+    TEST_ASSERT(loc.hits + loc.misses == 12000, "Every fix counted as hit or miss");
+    printf("    hit rate %.1f%%\n", 100.0 * loc.hits / (loc.hits + loc.misses));
+    TEST_ASSERT(loc.hits > 9 * loc.misses, "Slow vessels hit the last cell > 90% of the time");
+
+    t_bsp_init(&bsp, 0, FLOAT_TO_FIXED(179.9f));
+    t_bsp_locator_init(&loc);
+    bad = locator_walk(&bsp, &loc, 20, 300, 0.0f, 179.9f, 0.2f, false);
+    TEST_ASSERT(bad == 0 && loc.hits > 0, "Locator exact around the dateline");
+
+    t_bsp_init(&bsp, lat0, lon0);
+    t_bsp_locator_init(&loc);
+    bad = locator_walk(&bsp, &loc, 40, 300, 47.0f, -122.0f, 0.3f, true);
+    TEST_ASSERT(bad == 0, "Locator exact while the grid is re-centered");
+
+    /* Resetting the vessel's cell invalidates its entry */
+    t_bsp_init(&bsp, lat0, lon0);
+    t_bsp_locator_init(&loc);
+    id = t_bsp_locate(&bsp, &loc, 4242, lat0, lon0);
+    t_bsp_insert_pose(&bsp, id, &pose);
+    t_bsp_locate(&bsp, &loc, 4242, lat0, lon0);
+    TEST_ASSERT(loc.misses == 2 && loc.hits == 0,
+                "First fix in a new cell misses until the header exists");
+    t_bsp_locate(&bsp, &loc, 4242, lat0, lon0);
+    TEST_ASSERT(loc.hits == 1, "Next fix in the same cell hits");
+    t_bsp_reset_cell(&bsp, id);
+    TEST_ASSERT(t_bsp_locate(&bsp, &loc, 4242, lat0, lon0) == id && loc.misses == 3,
+                "Reset cell forces a miss (entry validated against the header)");
+}
+
+/* ========================================================================
+ * TEST: Transmit Scheduler
+ * ======================================================================== */
+
+/* Radio stand-in: keeps the last frame and its messages */
+typedef struct {
+    int frames;
+    uint16_t peer;
+    uint8_t frame[TX_FRAME_MAX];
+    size_t len;
+    int cls[TX_FRAME_MAX];
+    uint8_t tag[TX_FRAME_MAX];
+    int n;
+} tx_radio_t;
+
+static void tx_radio_msg(void* ctx, uint16_t src, int cls, const uint8_t* data, size_t len) {
+    tx_radio_t* r = (tx_radio_t*)ctx;
+    (void)src;
+    (void)len;
+    r->cls[r->n] = cls;
+    r->tag[r->n++] = data[0];
+}
+
+static void tx_radio_send(void* ctx, uint16_t peer, const uint8_t* frame, size_t len,
+                          uint32_t airtime_us) {
+    tx_radio_t* r = (tx_radio_t*)ctx;
+    (void)airtime_us;
+    r->frames++;
+    r->peer = peer;
+    memcpy(r->frame, frame, len);
+    r->len = len;
+    r->n = 0;
+    tx_frame_parse(frame, len, tx_radio_msg, r);
+}
+
+static int tx_put(tx_sched_t* s, int cls, uint16_t peer, uint8_t tag, size_t len, uint32_t now) {
+    uint8_t buf[TX_MSG_MAX];
+    memset(buf, tag, sizeof(buf));
+    return tx_sched_enqueue(s, cls, peer, buf, len, now, 0);
+}
+
+void test_tx_sched(void) {
+    printf("\n[TEST] Transmit Scheduler (duty cycle, priority, coalescing)\n");
+
+    static tx_sched_t s;
+    static tx_radio_t r;
+    tx_link_t link;
+    tx_link_default(&link);
+    tx_sched_init(&s, &link, 42, 1000);
+    memset(&r, 0, sizeof(r));
+
+    /* Priority and coalescing: handoffs first, everything for the peer in one frame */
+    tx_put(&s, TX_CLASS_BULK, 7, 'B', 40, 1000);
+    tx_put(&s, TX_CLASS_HANDOFF, 5, '1', sizeof(handoff_packet_t), 1000);
+    tx_put(&s, TX_CLASS_HANDOFF, 7, '2', sizeof(handoff_packet_t), 1000);
+    tx_put(&s, TX_CLASS_RECORD, 7, 'R', 30, 1000);
+    tx_put(&s, TX_CLASS_HANDOFF, 5, '3', sizeof(handoff_packet_t), 1000);
+    TEST_ASSERT(tx_sched_poll(&s, 1000, tx_radio_send, &r) == 2 && r.peer == 5 &&
+                r.n == 2 && r.tag[0] == '1' && r.tag[1] == '3',
+                "Oldest handoff picks the peer; its other handoff rides along");
+    TEST_ASSERT(r.frame[2] == 42 && r.frame[3] == 0 && r.frame[0] == 5,
+                "Frame carries src and dst");
+    TEST_ASSERT(tx_sched_poll(&s, 1001, tx_radio_send, &r) == 0 && r.frames == 1,
+                "No frame while the previous one is on air");
+    uint32_t wait = tx_sched_wait_ms(&s, 1001);
+    TEST_ASSERT(wait >= s.busy_until_ms - 1001 &&
+                tx_sched_poll(&s, 1000 + wait, tx_radio_send, &r) == 0,
+                "Wait hint covers the busy time and any budget shortfall");
+    TEST_ASSERT(tx_sched_poll(&s, 1001 + wait, tx_radio_send, &r) == 3 && r.peer == 7 &&
+                r.cls[0] == TX_CLASS_HANDOFF && r.cls[1] == TX_CLASS_RECORD &&
+                r.cls[2] == TX_CLASS_BULK,
+                "Handoff, record and bulk for one peer coalesced in class order");
+    TEST_ASSERT(s.queued == 0 && s.stats[TX_CLASS_HANDOFF].sent == 3 &&
+                tx_sched_wait_ms(&s, 5000) == UINT32_MAX, "Queue drained");
+
+    /* Budget: a full bucket holds one maximum frame, not two */
+    tx_sched_init(&s, &link, 42, 0);
+    tx_put(&s, TX_CLASS_BULK, 1, 'a', TX_MSG_MAX, 0);
+    tx_put(&s, TX_CLASS_BULK, 2, 'b', TX_MSG_MAX, 0);
+    uint32_t air = tx_airtime_us(&link, TX_FRAME_MAX);
+    TEST_ASSERT(tx_sched_poll(&s, 0, tx_radio_send, &r) == 1 && s.airtime_us == air,
+                "Maximum frame charged its airtime");
+    wait = tx_sched_wait_ms(&s, 0);
+    printf("    255-byte frame: %.0f ms on air, next in %u ms\n", air / 1000.0, wait);
+    TEST_ASSERT(tx_sched_poll(&s, wait - 1, tx_radio_send, &r) == 0 && s.queued == 1,
+                "Blocked until the bucket refills");
+    TEST_ASSERT(tx_sched_poll(&s, wait, tx_radio_send, &r) == 1 && r.peer == 2,
+                "Sent as soon as the wait hint says");
+
+    /* Long saturation stays inside the duty cycle */
+    tx_sched_init(&s, &link, 42, 0);
+    for (uint32_t t = 0; t <= 3600000; t += 100) {
+        while (s.queued < 4) tx_put(&s, TX_CLASS_BULK, 3, 'x', 120, t);
+        tx_sched_poll(&s, t, tx_radio_send, &r);
+    }
+    double budget = link.duty_permille * (3600000.0 + link.burst_ms);
+    printf("    1 h saturated: %.1f s airtime (budget %.1f s), %u frames\n",
+           s.airtime_us / 1e6, budget / 1e6, s.frames);
+    TEST_ASSERT(s.airtime_us <= budget && s.airtime_us > 0.95 * budget,
+                "Saturated link uses the duty cycle, never more");
+
+    /* Expiry */
+    tx_sched_init(&s, &link, 42, 0);
+    tx_sched_enqueue(&s, TX_CLASS_HANDOFF, 9, "h", 1, 0, 100);
+    TEST_ASSERT(tx_sched_poll(&s, 100, tx_radio_send, &r) == 0 && s.queued == 0 &&
+                s.stats[TX_CLASS_HANDOFF].expired == 1, "Stale message dropped, not sent");
+
+    /* Full queue: evict downwards (or the oldest of the same class), never upwards */
+    tx_sched_init(&s, &link, 42, 0);
+    for (int i = 0; i < TX_QUEUE_SLOTS - 1; i++) tx_put(&s, TX_CLASS_HANDOFF, 1, 'h', 8, 0);
+    tx_put(&s, TX_CLASS_BULK, 1, 'b', 8, 0);
+    TEST_ASSERT(tx_put(&s, TX_CLASS_HANDOFF, 1, 'n', 8, 1) == TX_OK &&
+                s.stats[TX_CLASS_BULK].evicted == 1, "Handoff evicts queued bulk");
+    TEST_ASSERT(tx_put(&s, TX_CLASS_BULK, 1, 'b', 8, 2) == TX_ERR_FULL &&
+                s.stats[TX_CLASS_BULK].rejected == 1, "Bulk rejected by a queue of handoffs");
+    TEST_ASSERT(tx_put(&s, TX_CLASS_HANDOFF, 1, 'm', 8, 3) == TX_OK &&
+                s.stats[TX_CLASS_HANDOFF].evicted == 1 && s.queued == TX_QUEUE_SLOTS,
+                "Handoff replaces the oldest handoff");
+
+    /* Argument and frame validation */
+    TEST_ASSERT(tx_put(&s, TX_CLASS_BULK, 1, 'x', 0, 4) == TX_ERR_SIZE &&
+                tx_put(&s, TX_CLASS_BULK, 1, 'x', TX_MSG_MAX + 1, 4) == TX_ERR_SIZE &&
+                tx_put(&s, TX_CLASSES, 1, 'x', 8, 4) == TX_ERR_CLASS, "Bad size and class rejected");
+    r.n = 0;
+    TEST_ASSERT(tx_frame_parse(r.frame, r.len - 1, tx_radio_msg, &r) == -1 && r.n == 0 &&
+                tx_frame_parse(r.frame, 3, tx_radio_msg, &r) == -1,
+                "Truncated frame rejected without delivering messages");
+}
+
+/* ========================================================================
+ * TEST: Compact DLT Record v2
+ * ======================================================================== */
+
+static void make_record(dlt_record_t* r, const char* dataset, uint32_t k, bool sign) {
+    memset(r, 0, sizeof(*r));
+    strncpy(r->dataset, dataset, sizeof(r->dataset) - 1);
+    r->mmsi = 367000000u + k * 7919u;
+    r->cell_id = (uint16_t)(k * 37u);
+    r->lambda_optimal = FLOAT_TO_FIXED(0.5f) - (fixed_t)(k * 97u);
+    r->return_error = (fixed_t)(k * 13u);
+    r->timestamp = 1735689600u + k * 60u;
+    for (int i = 0; i < 32; i++) r->trajectory_hash[i] = (uint8_t)(k * 31u + (uint32_t)i);
+    if (sign) {
+        for (int i = 0; i < 64; i++) r->signature[i] = (uint8_t)(k + (uint32_t)i * 3u + 1u);
+    }
+}
+
+void test_dlt_record_v2(void) {
+    printf("\n[TEST] Compact DLT Record v2 (interned dataset, varint fields)\n");
+
+    dlt_dataset_table_t tx, rx;
+    dlt_dataset_table_init(&tx);
+    dlt_dataset_table_init(&rx);
+    static const char* datasets[3] = { "MarineCadastre_AIS", "NOAA_VMS", "Synthetic" };
+
+    /* A stream of records over three datasets, half of them signed */
+    static uint8_t stream[64 * DLT_V2_MAX_BYTES];
+    static dlt_record_t in[64], out[64];
+    size_t len = 0, unsigned_max = 0, signed_max = 0;
+    bool encoded = true;
+    for (uint32_t k = 0; k < 64; k++) {
+        make_record(&in[k], datasets[k % 3], k, k & 1);
+        int n = dlt_record_v2_encode(&in[k], &tx, stream + len);
+        if (n <= 0 || n > DLT_V2_MAX_BYTES) encoded = false;
+        if (n > 0) len += (size_t)n;
+        if (k & 1) {
+            if ((size_t)n > signed_max) signed_max = (size_t)n;
+        } else if ((size_t)n > unsigned_max) {
+            unsigned_max = (size_t)n;
+        }
+    }
+    TEST_ASSERT(encoded && tx.count == 3, "64 records encode; 3 datasets interned");
+    printf("    v2: %zu bytes unsigned, %zu signed (v1 %zu)\n", unsigned_max, signed_max,
+           sizeof(dlt_record_t));
+    TEST_ASSERT(unsigned_max <= 52 && signed_max <= 116, "v2 at most 52 / 116 bytes vs 148");
+
+    /* Reader builds its table from the same announcement */
+    for (int i = 0; i < 3; i++) {
+        char name[DLT_DATASET_LEN] = { 0 };
+        strncpy(name, datasets[i], sizeof(name) - 1);
+        dlt_dataset_intern(&rx, name);
+    }
+    size_t off = 0;
+    int decoded = 0;
+    while (off < len && decoded < 64) {
+        int n = dlt_record_v2_decode(stream + off, len - off, &rx, &out[decoded]);
+        if (n <= 0) break;
+        off += (size_t)n;
+        decoded++;
+    }
+    TEST_ASSERT(decoded == 64 && off == len && memcmp(in, out, sizeof(in)) == 0,
+                "Stream decodes back byte for byte");
+
+    /* Field extremes */
+    dlt_record_t r, back;
+    memset(&r, 0, sizeof(r));
+    memcpy(r.dataset, tx.names[1], DLT_DATASET_LEN);
+    r.mmsi = UINT32_MAX;
+    r.cell_id = UINT16_MAX;
+    r.lambda_optimal = INT32_MIN;
+    r.return_error = INT32_MAX;
+    r.timestamp = UINT32_MAX;
+    uint8_t buf[DLT_V2_MAX_BYTES];
+    int n = dlt_record_v2_encode(&r, &tx, buf);
+    TEST_ASSERT(n > 0 && dlt_record_v2_decode(buf, (size_t)n, &rx, &back) == n &&
+                memcmp(&r, &back, sizeof(r)) == 0, "Extreme field values round-trip");
+    r.timestamp = 0;
+    n = dlt_record_v2_encode(&r, &tx, buf);
+    TEST_ASSERT(n > 0 && dlt_record_v2_decode(buf, (size_t)n, &rx, &back) == n &&
+                back.timestamp == 0, "Timestamp before the v2 epoch round-trips");
+
+    /* Malformed input */
+    make_record(&r, datasets[0], 5, true);
+    n = dlt_record_v2_encode(&r, &tx, buf);
+    bool truncated = true;
+    for (int cut = 0; cut < n; cut++) {
+        if (dlt_record_v2_decode(buf, (size_t)cut, &rx, &back) != DLT_ERR_FORMAT) truncated = false;
+    }
+    TEST_ASSERT(truncated, "Every truncation is a format error");
+    buf[0] = (uint8_t)((1 << 4) | (buf[0] & 0x0F));
+    TEST_ASSERT(dlt_record_v2_decode(buf, (size_t)n, &rx, &back) == DLT_ERR_VERSION,
+                "Wrong version rejected");
+
+    /* Unknown and overflowing dataset IDs */
+    dlt_dataset_table_t small;
+    dlt_dataset_table_init(&small);
+    make_record(&r, datasets[2], 1, false);
+    n = dlt_record_v2_encode(&r, &tx, buf);
+    TEST_ASSERT(dlt_record_v2_decode(buf, (size_t)n, &small, &back) == DLT_ERR_DATASET,
+                "Unknown dataset ID rejected, not guessed");
+    bool full = true;
+    for (int i = 0; i < DLT_MAX_DATASETS; i++) {
+        char name[DLT_DATASET_LEN] = { 0 };
+        snprintf(name, sizeof(name), "set-%d", i);
+        if (dlt_dataset_intern(&small, name) != i) full = false;
+    }
+    TEST_ASSERT(full && dlt_record_v2_encode(&r, &small, buf) == DLT_ERR_DATASET &&
+                dlt_dataset_intern(&small, small.names[3]) == 3,
+                "Full table: new names refused, known names still resolve");
+}
+
+/* ========================================================================
+ * TEST: Columnar DLT Archive
+ * ======================================================================== */
+
+/* Write blocks of n records each (record k of the whole file is make_record(k)) */
+static bool archive_write(const char* path, bool append, uint32_t first, int blocks, uint32_t n,
+                          uint64_t* dropped) {
+    static dlt_record_t rec[16];
+    static const char* datasets[2] = { "MarineCadastre_AIS", "NOAA_VMS" };
+    dlt_archive_writer_t w;
+    if (!dlt_archive_create(&w, path, append)) return false;
+    if (dropped) *dropped = w.dropped;
+    bool ok = true;
+    for (int b = 0; b < blocks; b++) {
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t k = first + (uint32_t)b * n + i;
+            make_record(&rec[i], datasets[k % 2], k, k & 1);
+        }
+        ok &= dlt_archive_append(&w, rec, n);
+    }
+    return dlt_archive_finish(&w) && ok;
+}
+
+/* Every record of every block decodes to make_record(k), k = 0, 1, ... */
+static bool archive_matches(const dlt_archive_t* a) {
+    static dlt_record_t out[16];
+    dlt_record_t want;
+    uint32_t k = 0;
+    for (uint32_t b = 0; b < a->n_blocks; b++) {
+        int n = dlt_archive_read_records(a, b, out);
+        if (n < 0 || !dlt_archive_verify(a, b)) return false;
+        for (int i = 0; i < n; i++, k++) {
+            make_record(&want, k % 2 ? "NOAA_VMS" : "MarineCadastre_AIS", k, k & 1);
+            if (memcmp(&want, &out[i], sizeof(want)) != 0) return false;
+        }
+    }
+    return k == a->records;
+}
+
+void test_dlt_archive(void) {
+    printf("\n[TEST] Columnar DLT Archive (blocks, torn tail, append)\n");
+
+    char path[] = "/tmp/t_bsp_test_XXXXXX";
+    int fd = mkstemp(path);
+    TEST_ASSERT(fd >= 0, "Temporary archive created");
+    if (fd < 0) return;
+    close(fd);
+
+    /* Round trip: create, then append to the whole archive */
+    dlt_archive_t a;
+    uint64_t dropped = 1;
+    bool written = archive_write(path, false, 0, 2, 10, NULL) &&
+                   archive_write(path, true, 20, 1, 10, &dropped);
+    bool opened = written && dlt_archive_open(&a, path);
+    TEST_ASSERT(opened && dropped == 0 && a.n_blocks == 3 && a.records == 30 &&
+                a.tail_bytes == 0 && archive_matches(&a),
+                "Blocks read back byte for byte; append keeps the file whole");
+    size_t whole = opened ? a.size : 0;
+    size_t last_block = opened ? a.blocks[2]->bytes : 0;
+    if (opened) dlt_archive_close(&a);
+
+    /* Torn tail: the reader indexes the whole blocks only */
+    bool torn = truncate(path, (off_t)(whole - last_block / 2)) == 0;
+    opened = torn && dlt_archive_open(&a, path);
+    TEST_ASSERT(opened && a.n_blocks == 2 && a.records == 20 &&
+                a.tail_bytes == last_block - last_block / 2 && archive_matches(&a),
+                "Torn tail block skipped by the reader");
+    if (opened) dlt_archive_close(&a);
+
+    /* Append after a torn tail: the tail is cut, the new block is readable */
+    written = torn && archive_write(path, true, 20, 1, 10, &dropped);
+    opened = written && dlt_archive_open(&a, path);
+    printf("    append after torn tail: cut %llu bytes, %u blocks, %llu records, tail %llu\n",
+           (unsigned long long)dropped, opened ? a.n_blocks : 0,
+           opened ? (unsigned long long)a.records : 0ull,
+           opened ? (unsigned long long)a.tail_bytes : 0ull);
+    TEST_ASSERT(opened && dropped == last_block - last_block / 2 && a.n_blocks == 3 &&
+                a.records == 30 && a.tail_bytes == 0 && a.size == whole && archive_matches(&a),
+                "Append after a torn tail cuts it and stays readable");
+    if (opened) dlt_archive_close(&a);
+
+    /* Append to something that is not an archive is refused */
+    FILE* f = fopen(path, "wb");
+    if (f) {
+        fputs("not an archive", f);
+        fclose(f);
+    }
+    dlt_archive_writer_t w;
+    TEST_ASSERT(f && !dlt_archive_create(&w, path, true) && w.error[0] != 0,
+                "Append to a foreign file refused");
+    remove(path);
+}
+
 int main(void) {
     srand(time(NULL));
 
@@ -484,6 +1954,19 @@ int main(void) {
     test_cell_near_full();
     test_multiple_cells();
     test_cell_bounds();
+    test_cell_layout();
+    test_gather_track();
+    test_cell_routing();
+    test_online_recenter();
+    test_geofence();
+    test_cpa();
+    test_density();
+    test_replog();
+    test_arrow_export();
+    test_cell_locator();
+    test_tx_sched();
+    test_dlt_record_v2();
+    test_dlt_archive();
 
     /* Summary */
     printf("\n======================================================================\n");
@@ -0,0 +1,259 @@
+/*
+ * tx_sched_bench.c - Host Link Model for the Duty-Cycle Transmit Scheduler
+ *
+ * Simulates one edge node on the default LoRa link (~5.5 kbit/s, 1% duty)
+ * for two hours in 10 ms steps. The same Poisson traffic is offered to
+ * three queueing policies:
+ *
+ *   fifo       one queue, one message per frame, oldest dropped when full
+ *   priority   handoffs > records > bulk, one message per frame
+ *   scheduler  priority + same-peer coalescing (tx_sched as shipped)
+ *
+ * Offered load (the bulk stream alone exceeds the duty cycle):
+ *   handoffs   100 B to 4 neighbours, 1 per min
+ *   records    148 B DLT records to the gateway, 1 per min
+ *   bulk       120 B replication frames to the gateway, 1 per s
+ *
+ * A second run drops a burst of handoffs (a cluster of vessels crossing
+ * into two neighbours' cells) onto the saturated link at a random phase
+ * of the bulk stream, 200 times, and reports how fast the burst clears.
+ *
+ * The baselines run on the same scheduler: "fifo" enqueues everything in
+ * one class, and both baselines give each message its own peer address so
+ * nothing coalesces. Every message carries its real class and enqueue time;
+ * the radio callback parses each frame with tx_frame_parse() and measures
+ * latency from enqueue to start of transmission.
+ *
+ * Built with (see Makefile):
+ *   gcc -O2 -o tx_sched_bench tx_sched_bench.c ../embedded/tx_sched.c \
+ *       -I../embedded -lm
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "../embedded/se3_edge.h"
+#include "../embedded/tx_sched.h"
+#include "bench_harness.h"
+#include <math.h>
+
+#define SIM_MS          (2u * 3600u * 1000u)
+#define STEP_MS         10u
+#define BURST_HANDOFFS  4
+#define BURST_TRIALS    200
+#define N_NEIGHBOURS    4
+#define GATEWAY         1
+#define MAX_LATENCIES   16384
+
+enum { MODE_FIFO, MODE_PRIORITY, MODE_SCHED, MODES };
+static const char* mode_names[MODES] = { "fifo", "priority", "scheduler" };
+static const char* class_names[TX_CLASSES] = { "handoff", "record", "bulk" };
+
+static const struct {
+    size_t len;
+    double per_s;
+} traffic[TX_CLASSES] = {
+    { sizeof(handoff_packet_t), 1.0 / 60.0 },
+    { sizeof(dlt_record_t), 1.0 / 60.0 },
+    { 120, 1.0 },
+};
+
+/* Message tag: real class, burst flag, enqueue time */
+typedef struct {
+    uint8_t cls;
+    uint8_t burst;
+    uint32_t enqueued_ms;
+} msg_tag_t;
+
+typedef struct {
+    uint32_t now_ms;
+    uint32_t offered[TX_CLASSES];
+    uint32_t latency[TX_CLASSES][MAX_LATENCIES];
+    uint32_t delivered[TX_CLASSES];
+    uint32_t burst_last_ms;          /* Latest delivery of a burst handoff */
+    uint32_t burst_delivered;
+    uint32_t frames;
+    uint32_t msgs;
+} link_model_t;
+
+static uint32_t rng = 124;
+static inline uint32_t xrand(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+static inline double urand(void) { return (xrand() & 0xFFFFFF) / (double)0x1000000; }
+
+static void on_msg(void* ctx, uint16_t src, int cls, const uint8_t* data, size_t len) {
+    link_model_t* lm = (link_model_t*)ctx;
+    msg_tag_t tag;
+    (void)src;
+    (void)cls;
+    (void)len;
+    memcpy(&tag, data, sizeof(tag));
+    uint32_t* n = &lm->delivered[tag.cls];
+    if (*n < MAX_LATENCIES) lm->latency[tag.cls][*n] = lm->now_ms - tag.enqueued_ms;
+    (*n)++;
+    if (tag.burst) {
+        lm->burst_delivered++;
+        lm->burst_last_ms = lm->now_ms;
+    }
+    lm->msgs++;
+}
+
+static void on_send(void* ctx, uint16_t peer, const uint8_t* frame, size_t len,
+                    uint32_t airtime_us) {
+    link_model_t* lm = (link_model_t*)ctx;
+    (void)peer;
+    (void)airtime_us;
+    lm->frames++;
+    if (tx_frame_parse(frame, len, on_msg, lm) < 0) {
+        fprintf(stderr, "malformed frame\n");
+        exit(1);
+    }
+}
+
+static void offer(tx_sched_t* s, link_model_t* lm, int mode, int cls, uint16_t peer,
+                  bool burst, uint16_t* uniq) {
+    uint8_t msg[TX_MSG_MAX];
+    msg_tag_t tag = { (uint8_t)cls, burst, lm->now_ms };
+    memset(msg, 0xA5, sizeof(msg));
+    memcpy(msg, &tag, sizeof(tag));
+    int q_cls = mode == MODE_FIFO ? TX_CLASS_BULK : cls;
+    uint16_t q_peer = mode == MODE_SCHED ? peer : (uint16_t)(1000 + (*uniq)++ % 60000);
+    lm->offered[cls]++;
+    tx_sched_enqueue(s, q_cls, q_peer, msg, traffic[cls].len, lm->now_ms, s->link.ttl_ms[cls]);
+}
+
+static int cmp_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+static double pct_s(const uint32_t* v, uint32_t n, double p) {
+    if (n == 0) return NAN;
+    uint32_t i = (uint32_t)(p * (n - 1) + 0.5);
+    return v[i] / 1000.0;
+}
+
+/* Offer the traffic mix for sim_ms; a burst of handoffs at burst_at_ms (0 = none) */
+static void simulate(tx_sched_t* s, int mode, const tx_link_t* link, link_model_t* lm,
+                     uint32_t sim_ms, uint32_t burst_at_ms) {
+    memset(lm, 0, sizeof(*lm));
+    tx_sched_init(s, link, 10, 0);
+    uint16_t uniq = 0;
+
+    for (uint32_t t = 0; t < sim_ms; t += STEP_MS) {
+        lm->now_ms = t;
+        for (int c = 0; c < TX_CLASSES; c++) {
+            if (urand() < traffic[c].per_s * STEP_MS / 1000.0) {
+                uint16_t peer = c == TX_CLASS_HANDOFF ? (uint16_t)(2 + xrand() % N_NEIGHBOURS)
+                                                      : GATEWAY;
+                offer(s, lm, mode, c, peer, false, &uniq);
+            }
+        }
+        if (burst_at_ms && t == burst_at_ms) {
+            for (int k = 0; k < BURST_HANDOFFS; k++) {
+                offer(s, lm, mode, TX_CLASS_HANDOFF, (uint16_t)(2 + k % 2), true, &uniq);
+            }
+        }
+        tx_sched_poll(s, t, on_send, lm);
+    }
+}
+
+static void run_saturated(int mode, const tx_link_t* link) {
+    static tx_sched_t s;
+    static link_model_t lm;
+    rng = 124;
+    simulate(&s, mode, link, &lm, SIM_MS, 0);
+
+    double budget_us = link->duty_permille * ((double)SIM_MS + link->burst_ms);
+    for (int c = 0; c < TX_CLASSES; c++) {
+        uint32_t n = lm.delivered[c] < MAX_LATENCIES ? lm.delivered[c] : MAX_LATENCIES;
+        qsort(lm.latency[c], n, sizeof(uint32_t), cmp_u32);
+        printf("  %-10s %-8s %8u %7.1f%% %8.1f %8.1f %8.1f\n", c == 0 ? mode_names[mode] : "",
+               class_names[c], lm.offered[c], 100.0 * lm.delivered[c] / lm.offered[c],
+               pct_s(lm.latency[c], n, 0.5), pct_s(lm.latency[c], n, 0.99),
+               pct_s(lm.latency[c], n, 1.0));
+    }
+    printf("  %-10s %u frames, %.2f msgs/frame, airtime %.1f s of %.1f s budget (%.1f%%)\n", "",
+           lm.frames, (double)lm.msgs / lm.frames, s.airtime_us / 1e6, budget_us / 1e6,
+           100.0 * s.airtime_us / budget_us);
+}
+
+static void run_bursts(int mode, const tx_link_t* link) {
+    static tx_sched_t s;
+    static link_model_t lm;
+    static uint32_t clear_ms[BURST_TRIALS];
+    uint32_t delivered = 0, cleared = 0;
+    rng = 7;
+    for (int k = 0; k < BURST_TRIALS; k++) {
+        /* 5 min to reach steady state, then a random phase of the bulk stream */
+        uint32_t at = 300000u + (xrand() % 6000u) * STEP_MS;
+        simulate(&s, mode, link, &lm, at + link->ttl_ms[TX_CLASS_HANDOFF], at);
+        delivered += lm.burst_delivered;
+        if (lm.burst_delivered == BURST_HANDOFFS) clear_ms[cleared++] = lm.burst_last_ms - at;
+    }
+    qsort(clear_ms, cleared, sizeof(uint32_t), cmp_u32);
+    printf("  %-10s %9.1f%% %9.1f%% %8.1f %8.1f %8.1f\n", mode_names[mode],
+           100.0 * delivered / (BURST_TRIALS * BURST_HANDOFFS), 100.0 * cleared / BURST_TRIALS,
+           pct_s(clear_ms, cleared, 0.5), pct_s(clear_ms, cleared, 0.99),
+           pct_s(clear_ms, cleared, 1.0));
+}
+
+/* Host CPU cost of one enqueue + poll cycle with a busy queue */
+static void bench_cpu(const tx_link_t* link) {
+    static tx_sched_t s;
+    static link_model_t lm;
+    tx_link_t fast = *link;
+    fast.duty_permille = 1000;               /* Never budget-blocked: every poll sends */
+    fast.frame_overhead_us = 0;
+    fast.bitrate_bps = 1000000000u;
+    tx_sched_init(&s, &fast, 10, 0);
+    uint8_t msg[64] = { 0 };
+    const uint32_t n = 2000000;
+    bench_t b;
+    bench_begin(&b, "enqueue x2 + poll (16 queued, 2 peers)");
+    for (uint32_t i = 0; i < n; i++) {
+        lm.now_ms = i;
+        while (s.queued < 16) {
+            tx_sched_enqueue(&s, (int)(xrand() % TX_CLASSES), (uint16_t)(xrand() & 1), msg,
+                             sizeof(msg), i, 0);
+        }
+        tx_sched_poll(&s, i, on_send, &lm);
+    }
+    bench_end(&b, n);
+    bench_sink += lm.msgs;
+}
+
+int main(void) {
+    printf("======================================================================\n");
+    printf("DUTY-CYCLE TRANSMIT SCHEDULER (LORA LINK MODEL, 2 h)\n");
+    printf("======================================================================\n");
+
+    tx_link_t link;
+    tx_link_default(&link);
+    printf("  link: %u bit/s, %.1f ms frame overhead, %.1f%% duty, %u s burst\n",
+           link.bitrate_bps, link.frame_overhead_us / 1000.0, link.duty_permille / 10.0,
+           link.burst_ms / 1000);
+    printf("  airtime: handoff frame %.0f ms, record frame %.0f ms, 255 B frame %.0f ms\n",
+           tx_airtime_us(&link, TX_FRAME_HEADER + TX_MSG_HEADER + sizeof(handoff_packet_t)) / 1e3,
+           tx_airtime_us(&link, TX_FRAME_HEADER + TX_MSG_HEADER + sizeof(dlt_record_t)) / 1e3,
+           tx_airtime_us(&link, TX_FRAME_MAX) / 1e3);
+    printf("  scheduler state: %zu B\n", sizeof(tx_sched_t));
+
+    bench_section("1. Latency by class under saturation (enqueue → on air, seconds)");
+    printf("  %-10s %-8s %8s %8s %8s %8s %8s\n", "policy", "class", "offered", "sent", "p50",
+           "p99", "max");
+    for (int m = 0; m < MODES; m++) run_saturated(m, &link);
+
+    bench_section("2. Burst of 4 handoffs behind saturating bulk (200 trials, seconds)");
+    printf("  %-10s %10s %10s %8s %8s %8s\n", "policy", "sent", "all sent", "p50", "p99",
+           "max");
+    for (int m = 0; m < MODES; m++) run_bursts(m, &link);
+
+    bench_section("3. Host CPU cost");
+    bench_cpu(&link);
+    return 0;
+}
@@ -0,0 +1,76 @@
+/*
+ * vincenty_ref.h - Double-Precision Vincenty Inverse (WGS84) Reference
+ *
+ * Ground truth for the fixed-point geodesic kernels: used by the accuracy
+ * tests and geodesic_bench.c. Iterates λ to 1e-12 rad (sub-millimeter);
+ * reports non-convergence for nearly antipodal pairs.
+ *
+ * Reference: T. Vincenty, "Direct and Inverse Solutions of Geodesics on
+ *            the Ellipsoid with Application of Nested Equations",
+ *            Survey Review 23 (176), 1975
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#ifndef VINCENTY_REF_H
+#define VINCENTY_REF_H
+
+#include <math.h>
+#include <stdbool.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/**
+ * Geodesic distance and initial azimuth between two points (degrees).
+ *
+ * @param dist_m Output: distance in meters
+ * @param az_deg Output: initial azimuth at point 1, [0, 360), or NULL
+ * @return true if the iteration converged
+ */
+static inline bool vincenty_inverse(double lat1, double lon1, double lat2, double lon2,
+                                    double* dist_m, double* az_deg) {
+    const double a = 6378137.0, f = 1.0 / 298.257223563, b = a * (1.0 - f);
+    const double d2r = M_PI / 180.0;
+    double L = (lon2 - lon1) * d2r;
+    while (L > M_PI) L -= 2.0 * M_PI;
+    while (L < -M_PI) L += 2.0 * M_PI;
+    double U1 = atan((1.0 - f) * tan(lat1 * d2r)), U2 = atan((1.0 - f) * tan(lat2 * d2r));
+    double sU1 = sin(U1), cU1 = cos(U1), sU2 = sin(U2), cU2 = cos(U2);
+    double lambda = L, prev, sin_s, cos_s, sigma, sin_a, cos2_a, cos_2sm, C;
+    int iter = 0;
+    do {
+        double sl = sin(lambda), cl = cos(lambda);
+        sin_s = sqrt((cU2 * sl) * (cU2 * sl) + (cU1 * sU2 - sU1 * cU2 * cl) * (cU1 * sU2 - sU1 * cU2 * cl));
+        if (sin_s == 0.0) {
+            *dist_m = 0.0;
+            if (az_deg) *az_deg = 0.0;
+            return true;
+        }
+        cos_s = sU1 * sU2 + cU1 * cU2 * cl;
+        sigma = atan2(sin_s, cos_s);
+        sin_a = cU1 * cU2 * sl / sin_s;
+        cos2_a = 1.0 - sin_a * sin_a;
+        cos_2sm = cos2_a != 0.0 ? cos_s - 2.0 * sU1 * sU2 / cos2_a : 0.0;
+        C = f / 16.0 * cos2_a * (4.0 + f * (4.0 - 3.0 * cos2_a));
+        prev = lambda;
+        lambda = L + (1.0 - C) * f * sin_a *
+                 (sigma + C * sin_s * (cos_2sm + C * cos_s * (-1.0 + 2.0 * cos_2sm * cos_2sm)));
+    } while (fabs(lambda - prev) > 1e-12 && ++iter < 200);
+
+    double u2 = cos2_a * (a * a - b * b) / (b * b);
+    double A = 1.0 + u2 / 16384.0 * (4096.0 + u2 * (-768.0 + u2 * (320.0 - 175.0 * u2)));
+    double B = u2 / 1024.0 * (256.0 + u2 * (-128.0 + u2 * (74.0 - 47.0 * u2)));
+    double ds = B * sin_s * (cos_2sm + B / 4.0 * (cos_s * (-1.0 + 2.0 * cos_2sm * cos_2sm) -
+                B / 6.0 * cos_2sm * (-3.0 + 4.0 * sin_s * sin_s) * (-3.0 + 4.0 * cos_2sm * cos_2sm)));
+    *dist_m = b * A * (sigma - ds);
+    if (az_deg) {
+        double sl = sin(lambda), cl = cos(lambda);
+        double az = atan2(cU2 * sl, cU1 * sU2 - sU1 * cU2 * cl) / d2r;
+        *az_deg = az < 0.0 ? az + 360.0 : az;
+    }
+    return iter < 200;
+}
+
+#endif /* VINCENTY_REF_H */
@@ -0,0 +1,228 @@
+/*
+ * voyage_merge_bench.c - Voyage Reconstruction Throughput (External Merge)
+ *
+ * Writes a synthetic archive: vessels moving across an 8×8 cell grid,
+ * one fix every 10 s, one segment file per cell per hour (raw se3_pose_t,
+ * vessels interleaved). At each cell change the fix is archived by both
+ * cells, as around a handoff, so the merge has byte-identical duplicates
+ * to drop. Then voyage_merge() runs with several thread counts and memory
+ * budgets (the smallest forces an intermediate merge pass) and every run
+ * is verified: one file per vessel, strictly increasing timestamps, no
+ * fix lost, exactly the handoff duplicates dropped.
+ *
+ * Usage: ./voyage_merge_bench [archive_MB]    (default 512)
+ *
+ * Built with (see Makefile):
+ *   gcc -O2 -D_GNU_SOURCE -pthread -DVOYAGE_MERGE_LIBRARY -o voyage_merge_bench \
+ *       voyage_merge_bench.c ../tools/voyage_merge.c -I../embedded -I../tools -lm
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "../embedded/se3_edge.h"
+#include "../tools/voyage_merge.h"
+#include "bench_harness.h"
+#include <dirent.h>
+#include <math.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define GRID            8
+#define STEP_S          10
+#define WINDOW_S        3600
+#define N_VESSELS       2000
+#define MMSI_BASE       366000000u
+
+typedef struct {
+    double x, y, vx, vy;     /* Cell units, cells per step */
+    int cell;
+} vessel_t;
+
+static uint32_t rng_state = 777;
+
+static double frand(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (rng_state >> 8) / 16777216.0;
+}
+
+static char** segment_paths;
+static int n_segments;
+static uint64_t n_fixes, n_handoff_dups;
+
+static void make_pose(const vessel_t* v, uint32_t mmsi, uint32_t ts, se3_pose_t* p) {
+    double yaw = atan2(v->vy, v->vx), c = cos(yaw), s = sin(yaw);
+    memset(p, 0, sizeof(*p));
+    p->rotation[0] = (fixed_t)lrint(c * FRACUNIT);
+    p->rotation[1] = (fixed_t)lrint(-s * FRACUNIT);
+    p->rotation[3] = (fixed_t)lrint(s * FRACUNIT);
+    p->rotation[4] = (fixed_t)lrint(c * FRACUNIT);
+    p->rotation[8] = FRACUNIT;
+    p->translation[0] = (fixed_t)lrint(fmod(v->x, 1.0) * 10000.0 * FRACUNIT / 4.0);
+    p->translation[1] = (fixed_t)lrint(fmod(v->y, 1.0) * 10000.0 * FRACUNIT / 4.0);
+    p->timestamp = ts;
+    p->mmsi = mmsi;
+}
+
+/* Archive of about target_bytes; returns false on I/O errors */
+static bool write_archive(const char* dir, uint64_t target_bytes) {
+    static vessel_t vessels[N_VESSELS];
+    for (int i = 0; i < N_VESSELS; i++) {
+        vessels[i].x = frand() * GRID;
+        vessels[i].y = frand() * GRID;
+        double speed = (0.5 + 2.0 * frand()) * STEP_S / 10000.0;   /* 0.5-2.5 m/s */
+        double dir_rad = frand() * 2.0 * M_PI;
+        vessels[i].vx = speed * cos(dir_rad);
+        vessels[i].vy = speed * sin(dir_rad);
+        vessels[i].cell = (int)vessels[i].y * GRID + (int)vessels[i].x;
+    }
+    uint64_t per_window = (uint64_t)N_VESSELS * (WINDOW_S / STEP_S) * sizeof(se3_pose_t);
+    int windows = (int)((target_bytes + per_window - 1) / per_window);
+    segment_paths = calloc((size_t)windows * GRID * GRID, sizeof(char*));
+    n_segments = 0;
+    uint32_t t = 1700000000u;
+
+    for (int w = 0; w < windows; w++) {
+        FILE* seg[GRID * GRID];
+        for (int c = 0; c < GRID * GRID; c++) {
+            char path[1024];
+            snprintf(path, sizeof(path), "%s/seg-c%02d-w%03d.pose", dir, c, w);
+            seg[c] = fopen(path, "wb");
+            if (!seg[c]) return false;
+            segment_paths[n_segments++] = strdup(path);
+        }
+        for (int step = 0; step < WINDOW_S / STEP_S; step++, t += STEP_S) {
+            for (int i = 0; i < N_VESSELS; i++) {
+                vessel_t* v = &vessels[i];
+                v->x += v->vx;
+                v->y += v->vy;
+                if (v->x < 0 || v->x >= GRID) { v->vx = -v->vx; v->x += 2 * v->vx; }
+                if (v->y < 0 || v->y >= GRID) { v->vy = -v->vy; v->y += 2 * v->vy; }
+                int cell = (int)v->y * GRID + (int)v->x;
+                se3_pose_t p;
+                make_pose(v, MMSI_BASE + (uint32_t)i * 37u, t, &p);
+                fwrite(&p, sizeof(p), 1, seg[cell]);
+                n_fixes++;
+                if (cell != v->cell) {
+                    fwrite(&p, sizeof(p), 1, seg[v->cell]);    /* handoff copy */
+                    n_handoff_dups++;
+                    v->cell = cell;
+                }
+            }
+        }
+        for (int c = 0; c < GRID * GRID; c++) {
+            if (fclose(seg[c]) != 0) return false;
+        }
+    }
+    return true;
+}
+
+static void remove_dir(const char* dir) {
+    DIR* d = opendir(dir);
+    if (!d) return;
+    struct dirent* e;
+    char path[1024];
+    while ((e = readdir(d)) != NULL) {
+        if (e->d_name[0] == '.') continue;
+        snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+        unlink(path);
+    }
+    closedir(d);
+    rmdir(dir);
+}
+
+/* One file per vessel, strictly increasing timestamps, every fix present */
+static bool verify_voyages(const char* dir, uint64_t* records) {
+    static se3_pose_t buf[4096];
+    DIR* d = opendir(dir);
+    if (!d) return false;
+    struct dirent* e;
+    int files = 0;
+    bool ok = true;
+    *records = 0;
+    while ((e = readdir(d)) != NULL && ok) {
+        if (e->d_name[0] == '.') continue;
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+        FILE* f = fopen(path, "rb");
+        if (!f) return false;
+        uint32_t mmsi = (uint32_t)strtoul(e->d_name, NULL, 10);
+        uint32_t last_ts = 0;
+        size_t got;
+        while ((got = fread(buf, sizeof(se3_pose_t), 4096, f)) > 0) {
+            for (size_t i = 0; i < got; i++) {
+                if (buf[i].mmsi != mmsi || buf[i].timestamp <= last_ts) ok = false;
+                last_ts = buf[i].timestamp;
+            }
+            *records += got;
+        }
+        fclose(f);
+        files++;
+    }
+    closedir(d);
+    return ok && files == N_VESSELS;
+}
+
+static void run_case(const char* base, int threads, size_t memory_mb, uint64_t archive_bytes) {
+    char out_dir[600];
+    snprintf(out_dir, sizeof(out_dir), "%s/voyages", base);
+    voyage_merge_config_t cfg;
+    voyage_merge_default_config(&cfg, out_dir);
+    cfg.threads = threads;
+    cfg.memory_bytes = memory_mb << 20;
+
+    voyage_merge_stats_t st;
+    bool ok = voyage_merge((const char* const*)segment_paths, n_segments, &cfg, &st);
+    uint64_t verified = 0;
+    bool valid = ok && verify_voyages(out_dir, &verified) && verified == n_fixes &&
+                 st.duplicates == n_handoff_dups && st.bytes_in == archive_bytes;
+    printf("  %7d %6zu MB %6u %6u %8.2f %8.2f %9.2f   %s\n", threads, memory_mb, st.runs,
+           st.merge_passes, st.run_seconds, st.merge_seconds, st.gb_per_min,
+           !ok ? st.error : valid ? "ok" : "MISMATCH");
+    remove_dir(out_dir);
+}
+
+int main(int argc, char** argv) {
+    uint64_t target_mb = argc > 1 ? strtoull(argv[1], NULL, 10) : 512;
+    printf("======================================================================\n");
+    printf("VOYAGE RECONSTRUCTION: EXTERNAL K-WAY MERGE OF ARCHIVED SEGMENTS\n");
+    printf("======================================================================\n");
+
+    const char* tmp = getenv("TMPDIR");
+    char base[512];
+    snprintf(base, sizeof(base), "%s/voyage_bench.XXXXXX", tmp ? tmp : "/tmp");
+    if (!mkdtemp(base)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    char seg_dir[600];
+    snprintf(seg_dir, sizeof(seg_dir), "%s/segments", base);
+    mkdir(seg_dir, 0755);
+
+    bench_t t;
+    bench_begin(&t, "write synthetic archive (per fix)");
+    if (!write_archive(seg_dir, target_mb << 20)) {
+        perror("archive");
+        return 1;
+    }
+    bench_end(&t, n_fixes + n_handoff_dups);
+    sync();     /* Archive writeback must not land in the first timed merge */
+    uint64_t archive_bytes = (n_fixes + n_handoff_dups) * sizeof(se3_pose_t);
+    printf("  %d segments, %.2f GB, %d vessels, %llu fixes + %llu handoff copies\n",
+           n_segments, archive_bytes / 1e9, N_VESSELS, (unsigned long long)n_fixes,
+           (unsigned long long)n_handoff_dups);
+
+    bench_section("voyage_merge (read, sort, merge, write; page cache warm)");
+    printf("  %7s %9s %6s %6s %8s %8s %9s   %s\n", "threads", "memory", "runs", "passes",
+           "runs s", "merge s", "GB/min", "verify");
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    run_case(base, 1, 256, archive_bytes);
+    run_case(base, 2, 256, archive_bytes);
+    if (cpus >= 4) run_case(base, 4, 256, archive_bytes);
+    run_case(base, 1, 64, archive_bytes);
+    run_case(base, 1, 4, archive_bytes);      /* fan-in limited: extra pass */
+
+    remove_dir(seg_dir);
+    rmdir(base);
+    return 0;
+}
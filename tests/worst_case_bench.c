@@ -0,0 +1,156 @@
+/*
+ * worst_case_bench.c - Host Benchmarks for Worst-Case Inputs
+ *
+ * Replays the pathological inputs latency_fuzz wrote to fuzz_corpus/
+ * (format in latency_targets.h) next to typical inputs for the same
+ * functions, so worst-case latency is tracked alongside the average.
+ *
+ * Measures, per target (normalize_lon, heading_to_angle, t_bsp_insert_pose):
+ *   1. Typical inputs: arguments within ±360°, or random IDs into a grid
+ *      holding 1-32 cells, no re-centering
+ *   2. Each corpus input for that target
+ *   3. Inserts only: the header restore that makes an insert repeatable,
+ *      timed alone; it is subtracted in the worst/typical summary
+ *
+ * Build and run:
+ *   gcc -O2 -D_GNU_SOURCE -o worst_case_bench worst_case_bench.c \
+ *       ../embedded/se3_math.c ../embedded/trig_tables.c ../embedded/t_bsp.c \
+ *       -I../embedded -lm
+ *   ./worst_case_bench [corpus_dir]
+ *
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "latency_targets.h"
+#include <dirent.h>
+
+#define MAX_CORPUS      64
+#define TYPICAL_CASES   16          /* Typical inputs per target (own T-BSP each) */
+#define ITERATIONS      200000
+
+typedef struct {
+    char name[64];
+    uint8_t data[LT_MAX_INPUT];
+    size_t size;
+} corpus_entry_t;
+
+static corpus_entry_t corpus[MAX_CORPUS];
+static int corpus_n;
+
+static uint32_t rng = 0xbe7c;
+static uint32_t xrand(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static int by_name(const void* a, const void* b) {
+    return strcmp(((const corpus_entry_t*)a)->name, ((const corpus_entry_t*)b)->name);
+}
+
+static void load_corpus(const char* dir) {
+    DIR* d = opendir(dir);
+    struct dirent* ent;
+    if (!d) return;
+    while ((ent = readdir(d)) != NULL && corpus_n < MAX_CORPUS) {
+        char path[512];
+        if (ent->d_name[0] == '.') continue;
+        snprintf(path, sizeof(path), "%s/%s", dir, ent->d_name);
+        FILE* f = fopen(path, "rb");
+        if (!f) continue;
+        corpus_entry_t* e = &corpus[corpus_n];
+        e->size = fread(e->data, 1, sizeof(e->data), f);
+        fclose(f);
+        snprintf(e->name, sizeof(e->name), "%.63s", ent->d_name);
+        corpus_n++;
+    }
+    closedir(d);
+    qsort(corpus, (size_t)corpus_n, sizeof(corpus_entry_t), by_name);
+}
+
+/* Prepared cases; each insert case owns a T-BSP and its header snapshot */
+static lt_case_t* make_case(const uint8_t* data, size_t size) {
+    lt_case_t* c = (lt_case_t*)calloc(1, sizeof(lt_case_t));
+    c->bsp = (t_bsp_t*)bench_alloc_aligned(sizeof(t_bsp_t));
+    c->snapshot = (t_bsp_t*)bench_alloc_aligned(sizeof(t_bsp_t));
+    if (!c->bsp || !c->snapshot) {
+        printf("allocation failed\n");
+        exit(1);
+    }
+    lt_prepare(c, data, size);
+    return c;
+}
+
+static void free_case(lt_case_t* c) {
+    free(c->bsp);
+    free(c->snapshot);
+    free(c);
+}
+
+/** Run the cases round-robin for ITERATIONS calls; returns ns/call. */
+static double run_cases(const char* name, lt_case_t** cases, int n, int restore_only) {
+    bench_t b;
+    bench_begin(&b, name);
+    for (int i = 0; i < ITERATIONS; i++) {
+        lt_case_t* c = cases[i % n];
+        lt_reset(c);
+        if (restore_only) bench_sink += c->bsp->active_count;
+        else lt_run(c);
+    }
+    return bench_end(&b, ITERATIONS);
+}
+
+int main(int argc, char** argv) {
+    const char* dir = argc > 1 ? argv[1] : "fuzz_corpus";
+
+    printf("======================================================================\n");
+    printf("WORST-CASE INPUT BENCHMARKS (latency_fuzz corpus)\n");
+    printf("======================================================================\n");
+    se3_init_tables();
+    load_corpus(dir);
+    printf("Corpus: %d inputs from %s/ (regenerate with ./latency_fuzz)\n", corpus_n, dir);
+
+    double typical[LT_TARGETS], worst[LT_TARGETS], restore = 0.0;
+    for (int t = 0; t < LT_TARGETS; t++) {
+        char title[96];
+        snprintf(title, sizeof(title), "%s: typical vs. corpus inputs", lt_target_names[t]);
+        bench_section(title);
+
+        lt_case_t* cases[TYPICAL_CASES];
+        for (int i = 0; i < TYPICAL_CASES; i++) {
+            uint8_t data[LT_MAX_INPUT];
+            size_t size;
+            lt_typical_input(data, &size, t, xrand);
+            cases[i] = make_case(data, size);
+        }
+        typical[t] = run_cases("typical inputs", cases, TYPICAL_CASES, 0);
+        if (t == LT_INSERT) restore = run_cases("header restore only", cases, TYPICAL_CASES, 1);
+        for (int i = 0; i < TYPICAL_CASES; i++) free_case(cases[i]);
+
+        worst[t] = 0.0;
+        for (int i = 0; i < corpus_n; i++) {
+            lt_case_t* c = make_case(corpus[i].data, corpus[i].size);
+            if (c->target == t) {
+                double ns = run_cases(corpus[i].name, &c, 1, 0);
+                if (ns > worst[t]) worst[t] = ns;
+            }
+            free_case(c);
+        }
+    }
+
+    bench_section("Worst / typical (inserts net of header restore)");
+    printf("  %-20s %12s %12s %8s\n", "target", "typical ns", "worst ns", "ratio");
+    for (int t = 0; t < LT_TARGETS; t++) {
+        double base = t == LT_INSERT ? restore : 0.0;
+        double typ = typical[t] - base, wst = worst[t] - base;
+        if (worst[t] == 0.0) {
+            printf("  %-20s %12.2f %12s %8s\n", lt_target_names[t], typ, "-", "-");
+            continue;
+        }
+        printf("  %-20s %12.2f %12.2f %7.1fx\n", lt_target_names[t], typ, wst,
+               typ > 0.0 ? wst / typ : 0.0);
+    }
+    return 0;
+}
@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""
+Check Zero-Copy Arrow Import of Exported Cells and DLT Records
+
+Builds embedded/arrow_export.c (with the T-BSP sources) as a shared
+library, fills a cell and a DLT record array, and imports every export
+form with pyarrow through the Arrow C Data Interface. Checks that values
+round-trip, that each imported column's data buffer is the C buffer
+itself (no copy), and that release callbacks free the batch. Reports
+import throughput, and polars import when polars is installed.
+
+Usage:
+    python3 tools/arrow_import_check.py
+
+Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+Version: 1.0
+"""
+
+import ctypes
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+
+try:
+    import pyarrow as pa
+except ImportError:
+    print("pyarrow not installed; nothing to check")
+    sys.exit(0)
+
+FRACUNIT = 1 << 16
+EMBEDDED = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "embedded")
+SOURCES = ["arrow_export.c", "t_bsp.c", "se3_math.c", "trig_tables.c"]
+
+# Sizes and the slab address come from the C side, not re-declared here
+SHIM = """
+#include "arrow_export.h"
+size_t shim_bsp_size(void) { return sizeof(t_bsp_t); }
+size_t shim_batch_size(void) { return sizeof(arrow_batch_t); }
+size_t shim_schema_size(void) { return sizeof(struct ArrowSchema); }
+size_t shim_array_size(void) { return sizeof(struct ArrowArray); }
+const void* shim_cell_slab(t_bsp_t* bsp, uint16_t id) {
+    t_bsp_cell_t* c = t_bsp_get_cell(bsp, id);
+    return c ? (const void*)t_bsp_cell_poses(bsp, c) : NULL;
+}
+int shim_busy(const arrow_batch_t* b) { return arrow_batch_busy(b); }
+"""
+
+POSE = struct.Struct("<9i3iII")              # se3_pose_t, packed (56 bytes)
+DLT = struct.Struct("<32sIHHii32sI64s")      # dlt_record_t (148 bytes)
+
+
+def build(tmp):
+    shim = os.path.join(tmp, "shim.c")
+    with open(shim, "w") as f:
+        f.write(SHIM)
+    lib = os.path.join(tmp, "libse3arrow.so")
+    cc = os.environ.get("CC", "cc")
+    subprocess.run([cc, "-O2", "-std=c99", "-fPIC", "-shared", "-I", EMBEDDED, "-o", lib, shim]
+                   + [os.path.join(EMBEDDED, s) for s in SOURCES] + ["-lm"], check=True)
+    c = ctypes.CDLL(lib)
+    for name in ("shim_bsp_size", "shim_batch_size", "shim_schema_size", "shim_array_size"):
+        getattr(c, name).restype = ctypes.c_size_t
+    c.shim_cell_slab.restype = ctypes.c_void_p
+    c.t_bsp_latlon_to_cell.restype = ctypes.c_uint16
+    return c
+
+
+def import_batch(c, export, *args):
+    """Run one export and import it as a pyarrow RecordBatch"""
+    schema = ctypes.create_string_buffer(c.shim_schema_size())
+    array = ctypes.create_string_buffer(c.shim_array_size())
+    rc = export(*args, schema, array)
+    assert rc == 0, f"export failed: {rc}"
+    return pa.RecordBatch._import_from_c(ctypes.addressof(array), ctypes.addressof(schema))
+
+
+def data_address(column):
+    return column.buffers()[-1].address
+
+
+def main():
+    print("=" * 70)
+    print("ARROW C DATA INTERFACE - ZERO-COPY IMPORT CHECK")
+    print("=" * 70)
+    with tempfile.TemporaryDirectory() as tmp:
+        c = build(tmp)
+
+    bsp = ctypes.create_string_buffer(c.shim_bsp_size())
+    batch_store = ctypes.create_string_buffer(c.shim_batch_size())
+    c.t_bsp_init(bsp, 0, 0)
+    c.arrow_batch_init(batch_store)
+    cell = c.t_bsp_latlon_to_cell(bsp, FRACUNIT // 100, FRACUNIT // 100)
+    n = 100
+    for i in range(n):
+        pose = POSE.pack(FRACUNIT, 0, 0, 0, FRACUNIT, 0, 0, 0, FRACUNIT,
+                         i * FRACUNIT, -i * FRACUNIT, 7 * FRACUNIT, 1000 + i, 366000000 + i % 5)
+        assert c.t_bsp_insert_pose(bsp, ctypes.c_uint16(cell), pose)
+
+    # Packed cell: one w:56 column over the slab
+    rb = import_batch(c, c.arrow_export_cell, batch_store, bsp, ctypes.c_uint16(cell))
+    slab = c.shim_cell_slab(bsp, ctypes.c_uint16(cell))
+    col = rb.column("pose")
+    ok = (rb.num_rows == n and col.type == pa.binary(56) and data_address(col) == slab
+          and POSE.unpack(col[3].as_py())[9] == 3 * FRACUNIT
+          and rb.schema.metadata[b"cell_id"] == str(cell).encode())
+    print(f"  packed cell     rows={rb.num_rows} zero-copy={data_address(col) == slab} "
+          f"metadata={dict((k.decode(), v.decode()) for k, v in rb.schema.metadata.items() if not k.startswith(b'se3'))}")
+    del rb, col
+
+    # Columnar cell: transpose once, export fixed_size_list / uint32 columns
+    rot = (ctypes.c_int32 * (9 * 128))()
+    trans = (ctypes.c_int32 * (3 * 128))()
+    ts = (ctypes.c_uint32 * 128)()
+    mmsi = (ctypes.c_uint32 * 128)()
+
+    class PoseColumns(ctypes.Structure):
+        _fields_ = [("rotation", ctypes.c_void_p), ("translation", ctypes.c_void_p),
+                    ("timestamp", ctypes.c_void_p), ("mmsi", ctypes.c_void_p),
+                    ("count", ctypes.c_uint32), ("capacity", ctypes.c_uint32)]
+    cols = PoseColumns(ctypes.addressof(rot), ctypes.addressof(trans), ctypes.addressof(ts),
+                       ctypes.addressof(mmsi), 0, 128)
+    assert c.arrow_cell_to_columns(bsp, ctypes.c_uint16(cell), ctypes.byref(cols)) == 0
+    rb = import_batch(c, c.arrow_export_pose_columns, batch_store, ctypes.byref(cols), bsp,
+                      ctypes.c_uint16(cell))
+    tr = rb.column("translation")
+    zero_copy = (tr.values.buffers()[1].address == ctypes.addressof(trans)
+                 and data_address(rb.column("mmsi")) == ctypes.addressof(mmsi))
+    ok &= (zero_copy and tr.type.list_size == 3 and tr.type.value_type == pa.int32()
+           and tr[5].as_py() == [5 * FRACUNIT, -5 * FRACUNIT, 7 * FRACUNIT]
+           and rb.column("timestamp")[99].as_py() == 1099)
+    print(f"  columnar cell   rows={rb.num_rows} zero-copy={zero_copy} "
+          f"types={[str(t) for t in rb.schema.types]}")
+    del rb, tr
+
+    # DLT records, packed and columnar
+    m = 1000
+    records = ctypes.create_string_buffer(DLT.size * m)
+    for i in range(m):
+        DLT.pack_into(records, i * DLT.size, b"MarineCadastre_AIS", 367000000 + i, i % 64, 0,
+                      int(0.9 * FRACUNIT), i, bytes(32), 1700000000 + i, bytes(64))
+    rb = import_batch(c, c.arrow_export_dlt, batch_store, records, m)
+    rec = rb.column("record")
+    ok &= data_address(rec) == ctypes.addressof(records) and DLT.unpack(rec[7].as_py())[1] == 367000007
+    print(f"  packed DLT      rows={rb.num_rows} zero-copy={data_address(rec) == ctypes.addressof(records)}")
+    del rb, rec
+
+    fields = [("dataset", 32), ("mmsi", 4), ("cell_id", 2), ("lambda_optimal", 4),
+              ("return_error", 4), ("trajectory_hash", 32), ("timestamp", 4), ("signature", 64)]
+    buffers = [ctypes.create_string_buffer(w * m) for _, w in fields]
+
+    class DltColumns(ctypes.Structure):
+        _fields_ = [(name, ctypes.c_void_p) for name, _ in fields] + \
+                   [("count", ctypes.c_uint32), ("capacity", ctypes.c_uint32)]
+    dcols = DltColumns(*[ctypes.addressof(b) for b in buffers], 0, m)
+    assert c.arrow_dlt_to_columns(records, m, ctypes.byref(dcols)) == 0
+    rb = import_batch(c, c.arrow_export_dlt_columns, batch_store, ctypes.byref(dcols))
+    zero_copy = all(data_address(rb.column(i)) == ctypes.addressof(b) for i, b in enumerate(buffers))
+    ok &= (zero_copy and rb.column("cell_id").type == pa.uint16()
+           and rb.column("mmsi")[999].as_py() == 367000999
+           and rb.column("dataset")[0].as_py().rstrip(b"\0") == b"MarineCadastre_AIS")
+    print(f"  columnar DLT    rows={rb.num_rows} zero-copy={zero_copy} columns={rb.num_columns}")
+    busy = c.shim_busy(batch_store)
+    del rb
+    released = not c.shim_busy(batch_store)
+    ok &= bool(busy) and released
+    print(f"  release         busy while imported={bool(busy)}, freed after del={released}")
+
+    # Throughput: export + import + release per batch
+    reps = 20000
+    t0 = time.perf_counter()
+    for _ in range(reps):
+        rb = import_batch(c, c.arrow_export_dlt_columns, batch_store, ctypes.byref(dcols))
+        del rb
+    dt = (time.perf_counter() - t0) / reps
+    print(f"\n  export+import+release, 1000 DLT records x 8 columns: {1e6 * dt:.1f} us/batch "
+          f"({DLT.size * m / dt / 1e9:.1f} GB/s of records exposed)")
+    try:
+        import polars as pl
+        rb = import_batch(c, c.arrow_export_dlt_columns, batch_store, ctypes.byref(dcols))
+        df = pl.from_arrow(rb)
+        print(f"  polars: {df.shape} frame from the same buffers")
+        del df, rb
+    except ImportError:
+        pass
+
+    print(f"\n{'✓ ALL CHECKS PASSED' if ok else '✗ CHECK FAILED'}")
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,680 @@
+/*
+ * dlt_archive.c - Columnar Archive of Sealed DLT Record Batches
+ *
+ * The writer encodes a batch into one buffer sized for the worst case
+ * and writes it with a single fwrite(), so a crash leaves at most one
+ * torn block at the tail. Column decoders write through a (base, stride)
+ * destination: the same code fills SoA arrays (arrow_dlt_columns_t) and
+ * AoS records.
+ *
+ * Also a command-line tool unless built with -DDLT_ARCHIVE_LIBRARY:
+ *
+ *   dlt_archive pack [-a] [-b batch] -o archive.dlta records.bin ...
+ *   dlt_archive unpack -o records.bin archive.dlta
+ *   dlt_archive stat archive.dlta
+ *
+ * Built with (see tests/Makefile):
+ *   gcc -O2 -o dlt_archive ../tools/dlt_archive.c -I../embedded
+ *
+ * Reference: mmap(2); FNV-1a (Fowler/Noll/Vo)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "dlt_archive.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Worst-case block: every varint at full width, every hash and signature */
+#define BLOCK_MAX(n)  (sizeof(dlt_archive_block_t) + DLT_ARCHIVE_MAX_DATASETS * 32u + \
+                       (size_t)(n) * 136u + 16u)
+
+/* ========================================================================
+ * ENCODING HELPERS
+ * ======================================================================== */
+
+static inline uint64_t zigzag(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static inline int64_t unzigzag(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+static inline uint8_t* put_varint(uint8_t* p, uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+/** Bounded reader over one column */
+typedef struct {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool ok;
+} reader_t;
+
+static inline uint64_t get_varint(reader_t* r) {
+    if (r->p < r->end && *r->p < 0x80) return *r->p++;   /* One-byte fast path */
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (r->p >= r->end) break;
+        uint8_t b = *r->p++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    r->ok = false;
+    return 0;
+}
+
+static uint32_t fnv1a(const uint8_t* p, size_t n) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static bool all_zero(const uint8_t* p, size_t n) {
+    uint8_t acc = 0;
+    for (size_t i = 0; i < n; i++) acc |= p[i];
+    return acc == 0;
+}
+
+static int cmp_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* ========================================================================
+ * WRITER
+ * ======================================================================== */
+
+static bool wr_fail(dlt_archive_writer_t* w, const char* what) {
+    if (!w->error[0]) snprintf(w->error, sizeof(w->error), "%s: %s", what, strerror(errno));
+    return false;
+}
+
+bool dlt_archive_create(dlt_archive_writer_t* w, const char* path, bool append) {
+    memset(w, 0, sizeof(*w));
+
+    /* Appending: index the blocks as a reader would and cut a torn tail,
+     * so the next block starts where the last whole one ends */
+    struct stat st;
+    bool existing = append && stat(path, &st) == 0 && st.st_size > 0;
+    if (existing) {
+        dlt_archive_t a;
+        if (!dlt_archive_open(&a, path)) {
+            memcpy(w->error, a.error, sizeof(w->error));
+            return false;
+        }
+        off_t end = (off_t)(a.size - a.tail_bytes);
+        w->dropped = a.tail_bytes;
+        dlt_archive_close(&a);
+        if (w->dropped > 0 && truncate(path, end) != 0) return wr_fail(w, path);
+    }
+
+    w->f = fopen(path, existing ? "ab" : "wb");
+    if (!w->f) return wr_fail(w, path);
+    if (!existing) {
+        uint8_t head[DLT_ARCHIVE_FILE_HEADER];
+        uint32_t magic = DLT_ARCHIVE_MAGIC;
+        uint16_t version = DLT_ARCHIVE_VERSION, reserved = 0;
+        memcpy(head, &magic, 4);
+        memcpy(head + 4, &version, 2);
+        memcpy(head + 6, &reserved, 2);
+        if (fwrite(head, 1, sizeof(head), w->f) != sizeof(head)) return wr_fail(w, path);
+    }
+
+    w->buf = malloc(BLOCK_MAX(DLT_ARCHIVE_MAX_BATCH));
+    w->dict = malloc(DLT_ARCHIVE_MAX_BATCH * sizeof(uint32_t));
+    w->names = malloc(DLT_ARCHIVE_MAX_DATASETS * sizeof(*w->names));
+    if (!w->buf || !w->dict || !w->names) {
+        errno = ENOMEM;
+        return wr_fail(w, "block buffer");
+    }
+    return true;
+}
+
+/* Interned names of the batch; last-ID cache for runs of one dataset */
+typedef struct {
+    char (*names)[32];
+    int count;
+    int last;
+} dataset_dict_t;
+
+static int dataset_id(dataset_dict_t* d, const char* name) {
+    if (d->last >= 0 && memcmp(d->names[d->last], name, 32) == 0) return d->last;
+    for (int i = 0; i < d->count; i++) {
+        if (memcmp(d->names[i], name, 32) == 0) return d->last = i;
+    }
+    if (d->count == DLT_ARCHIVE_MAX_DATASETS) return -1;
+    memcpy(d->names[d->count], name, 32);
+    return d->last = d->count++;
+}
+
+/* Presence bitmap + the non-zero fixed-width values */
+static uint8_t* put_optional(uint8_t* p, const dlt_record_t* rec, uint32_t n, size_t field,
+                             size_t width) {
+    uint8_t* bitmap = p;
+    memset(bitmap, 0, (n + 7) / 8);
+    p += (n + 7) / 8;
+    for (uint32_t i = 0; i < n; i++) {
+        const uint8_t* v = (const uint8_t*)&rec[i] + field;
+        if (all_zero(v, width)) continue;
+        bitmap[i >> 3] |= (uint8_t)(1u << (i & 7));
+        memcpy(p, v, width);
+        p += width;
+    }
+    return p;
+}
+
+bool dlt_archive_append(dlt_archive_writer_t* w, const dlt_record_t* rec, uint32_t n) {
+    if (!w->f || w->error[0]) return false;
+    if (n == 0 || n > DLT_ARCHIVE_MAX_BATCH) {
+        snprintf(w->error, sizeof(w->error), "batch of %u records (1 to %d)", n,
+                 DLT_ARCHIVE_MAX_BATCH);
+        return false;
+    }
+
+    dlt_archive_block_t h;
+    memset(&h, 0, sizeof(h));
+    h.magic = DLT_ARCHIVE_BLOCK_MAGIC;
+    h.count = n;
+    h.time_min = h.time_max = rec[0].timestamp;
+    h.cell_min = h.cell_max = rec[0].cell_id;
+    for (uint32_t i = 1; i < n; i++) {
+        if (rec[i].timestamp < h.time_min) h.time_min = rec[i].timestamp;
+        if (rec[i].timestamp > h.time_max) h.time_max = rec[i].timestamp;
+        if (rec[i].cell_id < h.cell_min) h.cell_min = rec[i].cell_id;
+        if (rec[i].cell_id > h.cell_max) h.cell_max = rec[i].cell_id;
+    }
+
+    uint8_t* base = w->buf;
+    uint8_t* p = base + sizeof(h);
+
+    /* Dataset: names, then (run length, ID) runs */
+    dataset_dict_t dd = { w->names, 0, -1 };
+    for (uint32_t i = 0; i < n; i++) {
+        if (dataset_id(&dd, rec[i].dataset) < 0) {
+            snprintf(w->error, sizeof(w->error), "more than %d datasets in one batch",
+                     DLT_ARCHIVE_MAX_DATASETS);
+            return false;
+        }
+    }
+    h.col_off[DLT_COL_DATASET] = (uint32_t)(p - base);
+    h.datasets = (uint16_t)dd.count;
+    memcpy(p, dd.names, (size_t)dd.count * 32);
+    p += (size_t)dd.count * 32;
+    for (uint32_t i = 0; i < n;) {
+        int id = dataset_id(&dd, rec[i].dataset);
+        uint32_t run = 1;
+        while (i + run < n && memcmp(rec[i + run].dataset, rec[i].dataset, 32) == 0) run++;
+        p = put_varint(p, run);
+        p = put_varint(p, (uint64_t)id);
+        i += run;
+    }
+
+    /* MMSI: sorted distinct values (u32, read in place), then an index each */
+    for (uint32_t i = 0; i < n; i++) w->dict[i] = rec[i].mmsi;
+    qsort(w->dict, n, sizeof(uint32_t), cmp_u32);
+    uint32_t d = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (d == 0 || w->dict[d - 1] != w->dict[i]) w->dict[d++] = w->dict[i];
+    }
+    h.col_off[DLT_COL_MMSI] = (uint32_t)(p - base);
+    p = put_varint(p, d);
+    memcpy(p, w->dict, (size_t)d * sizeof(uint32_t));
+    p += (size_t)d * sizeof(uint32_t);
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t lo = 0, hi = d;
+        while (hi - lo > 1) {
+            uint32_t mid = (lo + hi) / 2;
+            if (w->dict[mid] <= rec[i].mmsi) lo = mid; else hi = mid;
+        }
+        p = put_varint(p, lo);
+    }
+
+    h.col_off[DLT_COL_CELL] = (uint32_t)(p - base);
+    int64_t prev = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        p = put_varint(p, zigzag((int64_t)rec[i].cell_id - prev));
+        prev = rec[i].cell_id;
+    }
+
+    h.col_off[DLT_COL_LAMBDA] = (uint32_t)(p - base);
+    for (uint32_t i = 0; i < n; i++) p = put_varint(p, zigzag(rec[i].lambda_optimal));
+
+    h.col_off[DLT_COL_ERROR] = (uint32_t)(p - base);
+    for (uint32_t i = 0; i < n; i++) p = put_varint(p, zigzag(rec[i].return_error));
+
+    h.col_off[DLT_COL_HASH] = (uint32_t)(p - base);
+    p = put_optional(p, rec, n, offsetof(dlt_record_t, trajectory_hash), 32);
+
+    h.col_off[DLT_COL_TIME] = (uint32_t)(p - base);
+    prev = h.time_min;
+    for (uint32_t i = 0; i < n; i++) {
+        p = put_varint(p, zigzag((int64_t)rec[i].timestamp - prev));
+        prev = rec[i].timestamp;
+    }
+
+    h.col_off[DLT_COL_SIGNATURE] = (uint32_t)(p - base);
+    p = put_optional(p, rec, n, offsetof(dlt_record_t, signature), 64);
+
+    h.bytes = (uint32_t)(p - base);
+    h.checksum = fnv1a(base + sizeof(h), h.bytes - sizeof(h));
+    memcpy(base, &h, sizeof(h));
+    if (fwrite(base, 1, h.bytes, w->f) != h.bytes) return wr_fail(w, "write");
+    w->blocks++;
+    w->records += n;
+    w->bytes += h.bytes;
+    return true;
+}
+
+bool dlt_archive_finish(dlt_archive_writer_t* w) {
+    bool ok = w->f && !w->error[0];
+    if (w->f) {
+        if (fclose(w->f) != 0) ok = wr_fail(w, "close");
+        w->f = NULL;
+    }
+    free(w->buf);
+    free(w->dict);
+    free(w->names);
+    w->buf = NULL;
+    w->dict = NULL;
+    w->names = NULL;
+    return ok;
+}
+
+/* ========================================================================
+ * READER
+ * ======================================================================== */
+
+bool dlt_archive_open(dlt_archive_t* a, const char* path) {
+    memset(a, 0, sizeof(*a));
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        snprintf(a->error, sizeof(a->error), "%s: %s", path, strerror(errno));
+        if (fd >= 0) close(fd);
+        return false;
+    }
+    a->size = (size_t)st.st_size;
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    if (a->size >= DLT_ARCHIVE_FILE_HEADER) {
+        a->map = mmap(NULL, a->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (a->map == MAP_FAILED) {
+            snprintf(a->error, sizeof(a->error), "%s: mmap: %s", path, strerror(errno));
+            a->map = NULL;
+            close(fd);
+            return false;
+        }
+        memcpy(&magic, a->map, 4);
+        memcpy(&version, a->map + 4, 2);
+    }
+    close(fd);
+    if (magic != DLT_ARCHIVE_MAGIC || version != DLT_ARCHIVE_VERSION) {
+        snprintf(a->error, sizeof(a->error), "%s: not a version %d DLT archive", path,
+                 DLT_ARCHIVE_VERSION);
+        dlt_archive_close(a);
+        return false;
+    }
+    madvise((void*)a->map, a->size, MADV_SEQUENTIAL);
+
+    /* Index whole blocks; stop at the first header that does not fit */
+    size_t off = DLT_ARCHIVE_FILE_HEADER;
+    uint32_t cap = 0;
+    while (a->size - off >= sizeof(dlt_archive_block_t)) {
+        const dlt_archive_block_t* h = (const dlt_archive_block_t*)(a->map + off);
+        bool sane = h->magic == DLT_ARCHIVE_BLOCK_MAGIC && h->bytes <= a->size - off &&
+                    h->count >= 1 && h->count <= DLT_ARCHIVE_MAX_BATCH &&
+                    h->datasets <= DLT_ARCHIVE_MAX_DATASETS &&
+                    h->col_off[0] == sizeof(dlt_archive_block_t);
+        for (int c = 1; sane && c < DLT_COLUMNS; c++) sane = h->col_off[c] >= h->col_off[c - 1];
+        if (!sane || h->col_off[DLT_COLUMNS - 1] > h->bytes) break;
+        if (a->n_blocks == cap) {
+            cap = cap ? cap * 2 : 256;
+            const dlt_archive_block_t** grown = realloc(a->blocks, cap * sizeof(*grown));
+            if (!grown) {
+                snprintf(a->error, sizeof(a->error), "block index: out of memory");
+                dlt_archive_close(a);
+                return false;
+            }
+            a->blocks = grown;
+        }
+        a->blocks[a->n_blocks++] = h;
+        a->records += h->count;
+        off += h->bytes;
+    }
+    a->tail_bytes = a->size - off;
+    return true;
+}
+
+void dlt_archive_close(dlt_archive_t* a) {
+    if (a->map) munmap((void*)a->map, a->size);
+    free(a->blocks);
+    a->map = NULL;
+    a->blocks = NULL;
+    a->n_blocks = 0;
+}
+
+bool dlt_archive_verify(const dlt_archive_t* a, uint32_t block) {
+    if (block >= a->n_blocks) return false;
+    const dlt_archive_block_t* h = a->blocks[block];
+    const uint8_t* base = (const uint8_t*)h;
+    return fnv1a(base + sizeof(*h), h->bytes - sizeof(*h)) == h->checksum;
+}
+
+/* Column c of block h as a bounded reader */
+static reader_t column(const dlt_archive_block_t* h, int c) {
+    const uint8_t* base = (const uint8_t*)h;
+    uint32_t end = c + 1 < DLT_COLUMNS ? h->col_off[c + 1] : h->bytes;
+    reader_t r = { base + h->col_off[c], base + end, true };
+    return r;
+}
+
+/**
+ * Decode column c of block h to dst + i × stride (width bytes per value).
+ *
+ * @return true if the column is well-formed and consumed exactly
+ */
+static bool decode_column(const dlt_archive_block_t* h, int c, uint8_t* dst, size_t stride) {
+    reader_t r = column(h, c);
+    uint32_t n = h->count;
+
+    switch (c) {
+    case DLT_COL_DATASET: {
+        const uint8_t* names = r.p;
+        if ((size_t)(r.end - r.p) < (size_t)h->datasets * 32) return false;
+        r.p += (size_t)h->datasets * 32;
+        for (uint32_t i = 0; i < n && r.ok;) {
+            uint64_t run = get_varint(&r);
+            uint64_t id = get_varint(&r);
+            if (run == 0 || run > n - i || id >= h->datasets) return false;
+            for (uint64_t k = 0; k < run; k++, i++) memcpy(dst + i * stride, names + id * 32, 32);
+        }
+        break;
+    }
+    case DLT_COL_MMSI: {
+        uint64_t d = get_varint(&r);
+        if (!r.ok || d == 0 || d > n || (uint64_t)(r.end - r.p) < d * 4) return false;
+        const uint8_t* dict = r.p;
+        r.p += d * 4;
+        for (uint32_t i = 0; i < n; i++) {
+            uint64_t k = get_varint(&r);
+            if (k >= d) return false;
+            memcpy(dst + i * stride, dict + k * 4, 4);
+        }
+        break;
+    }
+    case DLT_COL_CELL: {
+        int64_t v = 0;
+        for (uint32_t i = 0; i < n; i++) {
+            v += unzigzag(get_varint(&r));
+            uint16_t cell = (uint16_t)v;
+            memcpy(dst + i * stride, &cell, 2);
+        }
+        break;
+    }
+    case DLT_COL_LAMBDA:
+    case DLT_COL_ERROR:
+        for (uint32_t i = 0; i < n; i++) {
+            int32_t v = (int32_t)unzigzag(get_varint(&r));
+            memcpy(dst + i * stride, &v, 4);
+        }
+        break;
+    case DLT_COL_TIME: {
+        int64_t v = h->time_min;
+        for (uint32_t i = 0; i < n; i++) {
+            v += unzigzag(get_varint(&r));
+            uint32_t t = (uint32_t)v;
+            memcpy(dst + i * stride, &t, 4);
+        }
+        break;
+    }
+    case DLT_COL_HASH:
+    case DLT_COL_SIGNATURE: {
+        size_t width = c == DLT_COL_HASH ? 32 : 64;
+        const uint8_t* bitmap = r.p;
+        if ((size_t)(r.end - r.p) < (n + 7) / 8) return false;
+        r.p += (n + 7) / 8;
+        for (uint32_t i = 0; i < n; i++) {
+            if (bitmap[i >> 3] & (1u << (i & 7))) {
+                if ((size_t)(r.end - r.p) < width) return false;
+                memcpy(dst + i * stride, r.p, width);
+                r.p += width;
+            } else {
+                memset(dst + i * stride, 0, width);
+            }
+        }
+        break;
+    }
+    default:
+        return false;
+    }
+    return r.ok && r.p == r.end;
+}
+
+int dlt_archive_read(const dlt_archive_t* a, uint32_t block, unsigned columns,
+                     arrow_dlt_columns_t* cols) {
+    if (block >= a->n_blocks) return -1;
+    const dlt_archive_block_t* h = a->blocks[block];
+    if (h->count > cols->capacity) return -1;
+
+    uint8_t* dst[DLT_COLUMNS] = {
+        (uint8_t*)cols->dataset, (uint8_t*)cols->mmsi, (uint8_t*)cols->cell_id,
+        (uint8_t*)cols->lambda_optimal, (uint8_t*)cols->return_error,
+        (uint8_t*)cols->trajectory_hash, (uint8_t*)cols->timestamp, (uint8_t*)cols->signature,
+    };
+    static const size_t width[DLT_COLUMNS] = { 32, 4, 2, 4, 4, 32, 4, 64 };
+    for (int c = 0; c < DLT_COLUMNS; c++) {
+        if (!(columns & DLT_COL_BIT(c))) continue;
+        if (!dst[c] || !decode_column(h, c, dst[c], width[c])) return -1;
+    }
+    cols->count = h->count;
+    return (int)h->count;
+}
+
+int dlt_archive_read_records(const dlt_archive_t* a, uint32_t block, dlt_record_t* out) {
+    if (block >= a->n_blocks) return -1;
+    const dlt_archive_block_t* h = a->blocks[block];
+    static const size_t field[DLT_COLUMNS] = {
+        offsetof(dlt_record_t, dataset), offsetof(dlt_record_t, mmsi),
+        offsetof(dlt_record_t, cell_id), offsetof(dlt_record_t, lambda_optimal),
+        offsetof(dlt_record_t, return_error), offsetof(dlt_record_t, trajectory_hash),
+        offsetof(dlt_record_t, timestamp), offsetof(dlt_record_t, signature),
+    };
+    for (uint32_t i = 0; i < h->count; i++) out[i]._padding = 0;
+    for (int c = 0; c < DLT_COLUMNS; c++) {
+        if (!decode_column(h, c, (uint8_t*)out + field[c], sizeof(dlt_record_t))) return -1;
+    }
+    return (int)h->count;
+}
+
+/* ========================================================================
+ * COMMAND-LINE TOOL
+ * ======================================================================== */
+
+#ifndef DLT_ARCHIVE_LIBRARY
+
+static void usage(void) {
+    fprintf(stderr,
+            "usage: dlt_archive pack [-a] [-b batch] -o archive.dlta records.bin ...\n"
+            "       dlt_archive unpack -o records.bin archive.dlta\n"
+            "       dlt_archive stat archive.dlta\n"
+            "  records.bin holds raw dlt_record_t (148 bytes, little-endian).\n"
+            "  pack seals every `batch` records (default 4096) as one block;\n"
+            "  -a appends to an existing archive.\n");
+}
+
+static int cmd_pack(int argc, char** argv) {
+    const char* out = NULL;
+    bool append = false;
+    long batch = 4096;
+    int opt;
+    while ((opt = getopt(argc, argv, "ab:o:")) != -1) {
+        switch (opt) {
+        case 'a': append = true; break;
+        case 'b': batch = strtol(optarg, NULL, 10); break;
+        case 'o': out = optarg; break;
+        default: usage(); return 2;
+        }
+    }
+    if (!out || optind >= argc || batch < 1 || batch > DLT_ARCHIVE_MAX_BATCH) {
+        usage();
+        return 2;
+    }
+
+    dlt_archive_writer_t w;
+    dlt_record_t* rec = malloc((size_t)batch * sizeof(dlt_record_t));
+    if (!rec || !dlt_archive_create(&w, out, append)) {
+        fprintf(stderr, "dlt_archive: %s\n", rec ? w.error : "out of memory");
+        free(rec);
+        return 1;
+    }
+    if (w.dropped) {
+        fprintf(stderr, "dlt_archive: %s: cut %llu bytes of a torn block before appending\n",
+                out, (unsigned long long)w.dropped);
+    }
+    uint64_t truncated = 0;
+    for (int k = optind; k < argc; k++) {
+        FILE* f = fopen(argv[k], "rb");
+        if (!f) {
+            perror(argv[k]);
+            continue;
+        }
+        size_t n;
+        while ((n = fread(rec, sizeof(dlt_record_t), (size_t)batch, f)) > 0) {
+            if (!dlt_archive_append(&w, rec, (uint32_t)n)) break;
+        }
+        long pos = ftell(f);
+        fseek(f, 0, SEEK_END);
+        truncated += (uint64_t)(ftell(f) - pos);
+        fclose(f);
+    }
+    uint64_t blocks = w.blocks, records = w.records, bytes = w.bytes;
+    bool ok = dlt_archive_finish(&w);
+    free(rec);
+    if (!ok) {
+        fprintf(stderr, "dlt_archive: %s\n", w.error);
+        return 1;
+    }
+    printf("%llu records in %llu blocks: %.1f MB raw -> %.1f MB (%.1f bytes/record, %.2fx)\n",
+           (unsigned long long)records, (unsigned long long)blocks,
+           records * sizeof(dlt_record_t) / 1e6, bytes / 1e6,
+           records ? (double)bytes / records : 0.0,
+           bytes ? (double)(records * sizeof(dlt_record_t)) / bytes : 0.0);
+    if (truncated) printf("%llu trailing bytes ignored (not a whole record)\n",
+                          (unsigned long long)truncated);
+    return 0;
+}
+
+static int cmd_unpack(int argc, char** argv) {
+    const char* out = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "o:")) != -1) {
+        if (opt != 'o') {
+            usage();
+            return 2;
+        }
+        out = optarg;
+    }
+    if (!out || optind + 1 != argc) {
+        usage();
+        return 2;
+    }
+
+    dlt_archive_t a;
+    if (!dlt_archive_open(&a, argv[optind])) {
+        fprintf(stderr, "dlt_archive: %s\n", a.error);
+        return 1;
+    }
+    FILE* f = fopen(out, "wb");
+    dlt_record_t* rec = malloc(DLT_ARCHIVE_MAX_BATCH * sizeof(dlt_record_t));
+    int rc = 0;
+    if (!f || !rec) {
+        perror(out);
+        rc = 1;
+    }
+    for (uint32_t k = 0; rc == 0 && k < a.n_blocks; k++) {
+        int n = dlt_archive_verify(&a, k) ? dlt_archive_read_records(&a, k, rec) : -1;
+        if (n < 0) {
+            fprintf(stderr, "dlt_archive: block %u is corrupt\n", k);
+            rc = 1;
+        } else if (fwrite(rec, sizeof(dlt_record_t), (size_t)n, f) != (size_t)n) {
+            perror(out);
+            rc = 1;
+        }
+    }
+    if (f && fclose(f) != 0) rc = 1;
+    free(rec);
+    dlt_archive_close(&a);
+    return rc;
+}
+
+static int cmd_stat(int argc, char** argv) {
+    if (argc != 2) {
+        usage();
+        return 2;
+    }
+    dlt_archive_t a;
+    if (!dlt_archive_open(&a, argv[1])) {
+        fprintf(stderr, "dlt_archive: %s\n", a.error);
+        return 1;
+    }
+    static const char* names[DLT_COLUMNS] = {
+        "dataset", "mmsi", "cell_id", "lambda", "error", "hash", "timestamp", "signature",
+    };
+    uint64_t col_bytes[DLT_COLUMNS] = { 0 };
+    uint32_t bad = 0, time_min = UINT32_MAX, time_max = 0;
+    for (uint32_t k = 0; k < a.n_blocks; k++) {
+        const dlt_archive_block_t* h = a.blocks[k];
+        for (int c = 0; c < DLT_COLUMNS; c++) {
+            uint32_t end = c + 1 < DLT_COLUMNS ? h->col_off[c + 1] : h->bytes;
+            col_bytes[c] += end - h->col_off[c];
+        }
+        if (h->time_min < time_min) time_min = h->time_min;
+        if (h->time_max > time_max) time_max = h->time_max;
+        if (!dlt_archive_verify(&a, k)) bad++;
+    }
+    size_t whole = a.size - (size_t)a.tail_bytes;
+    printf("%s: %u blocks, %llu records, %.1f MB (%.1f bytes/record vs %zu raw)\n", argv[1],
+           a.n_blocks, (unsigned long long)a.records, whole / 1e6,
+           a.records ? (double)whole / a.records : 0.0, sizeof(dlt_record_t));
+    if (a.n_blocks) printf("time %u .. %u\n", time_min, time_max);
+    for (int c = 0; c < DLT_COLUMNS; c++) {
+        printf("  %-10s %8.2f bytes/record\n", names[c],
+               a.records ? (double)col_bytes[c] / a.records : 0.0);
+    }
+    if (a.tail_bytes) printf("%llu trailing bytes are not a whole block (torn append)\n",
+                             (unsigned long long)a.tail_bytes);
+    printf("checksums: %s\n", bad ? "FAILED" : "ok");
+    if (bad) printf("%u corrupt blocks\n", bad);
+    dlt_archive_close(&a);
+    return bad ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage();
+        return 2;
+    }
+    if (strcmp(argv[1], "pack") == 0) return cmd_pack(argc - 1, argv + 1);
+    if (strcmp(argv[1], "unpack") == 0) return cmd_unpack(argc - 1, argv + 1);
+    if (strcmp(argv[1], "stat") == 0) return cmd_stat(argc - 1, argv + 1);
+    usage();
+    return 2;
+}
+
+#endif /* DLT_ARCHIVE_LIBRARY */
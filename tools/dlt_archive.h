@@ -0,0 +1,207 @@
+/*
+ * dlt_archive.h - Columnar Archive of Sealed DLT Record Batches
+ *
+ * Raw archives are dumps of dlt_record_t: 148 bytes per record, of which
+ * the dataset name, the padding, and most bits of the MMSI, cell, λ and
+ * timestamp fields repeat from record to record. dlt_archive stores each
+ * sealed batch as one block with one column per field, each column in
+ * the encoding that suits it:
+ *
+ *   dataset    interned names + runs (varint length, varint ID)
+ *   mmsi       sorted dictionary (u32, read in place) + varint index per record
+ *   cell_id    zigzag varint delta from the previous record
+ *   lambda     zigzag varint
+ *   error      zigzag varint
+ *   hash       presence bitmap + 32 bytes per non-zero hash
+ *   timestamp  zigzag varint delta (first record: from time_min)
+ *   signature  presence bitmap + 64 bytes per non-zero signature
+ *
+ * Hashes and signatures are random bytes and are stored as they are; every
+ * other column shrinks to a byte or two per record.
+ *
+ * File (little-endian): "DLTA" u32, version u16, reserved u16, then blocks.
+ * A block is a 64-byte header (zone map: record count, time and cell
+ * ranges, column offsets, FNV-1a checksum of the columns) followed by the
+ * columns. Blocks are only ever appended. Readers mmap the file, walk the
+ * block headers once, skip blocks by zone map and decode only the columns
+ * a query needs, straight into arrow_dlt_columns_t (zero-copy Arrow export
+ * from there). A torn append at the tail is ignored and reported.
+ *
+ * Doom Lineage:
+ *   - Doom's WAD (header, then lumps located through a directory of
+ *     offsets and sizes, each lump read on demand by W_CacheLumpNum) →
+ *     blocks located through their headers, columns read on demand
+ *
+ * Hardware Target: host (POSIX mmap); records published by ESP32-S3
+ *                  edge nodes
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#ifndef DLT_ARCHIVE_H
+#define DLT_ARCHIVE_H
+
+#include "se3_edge.h"
+#include "arrow_export.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * CONFIGURATION CONSTANTS
+ * ======================================================================== */
+
+#define DLT_ARCHIVE_MAGIC        0x41544C44u  /* "DLTA" */
+#define DLT_ARCHIVE_BLOCK_MAGIC  0x42544C44u  /* "DLTB" */
+#define DLT_ARCHIVE_VERSION      1
+#define DLT_ARCHIVE_FILE_HEADER  8
+
+#ifndef DLT_ARCHIVE_MAX_BATCH
+#define DLT_ARCHIVE_MAX_BATCH    65536        /* Records per block */
+#endif
+
+#define DLT_ARCHIVE_MAX_DATASETS 255          /* Distinct names per block */
+
+/* Columns, in dlt_record_t / arrow_export_dlt_columns() order */
+#define DLT_COL_DATASET          0
+#define DLT_COL_MMSI             1
+#define DLT_COL_CELL             2
+#define DLT_COL_LAMBDA           3
+#define DLT_COL_ERROR            4
+#define DLT_COL_HASH             5
+#define DLT_COL_TIME             6
+#define DLT_COL_SIGNATURE        7
+#define DLT_COLUMNS              8
+#define DLT_COL_ALL              ((1u << DLT_COLUMNS) - 1)
+#define DLT_COL_BIT(c)           (1u << (c))
+
+/* ========================================================================
+ * FILE FORMAT
+ * ======================================================================== */
+
+#pragma pack(push, 1)
+typedef struct {
+    uint32_t magic;                   /* DLT_ARCHIVE_BLOCK_MAGIC */
+    uint32_t bytes;                   /* Whole block, header included */
+    uint32_t count;                   /* Records (1 to DLT_ARCHIVE_MAX_BATCH) */
+    uint32_t checksum;                /* FNV-1a over the column bytes */
+    uint32_t time_min, time_max;      /* Zone map */
+    uint16_t cell_min, cell_max;
+    uint16_t datasets;                /* Names in the dataset column */
+    uint16_t _reserved;
+    uint32_t col_off[DLT_COLUMNS];    /* Column starts, from the block start */
+} dlt_archive_block_t;                /* Total: 64 bytes */
+#pragma pack(pop)
+
+_Static_assert(sizeof(dlt_archive_block_t) == 64, "block header is 64 bytes");
+
+/* ========================================================================
+ * TYPES
+ * ======================================================================== */
+
+/** Appending writer */
+typedef struct {
+    FILE* f;
+    uint8_t* buf;             /* Block being encoded (worst case for MAX_BATCH) */
+    uint32_t* dict;           /* MMSI dictionary scratch */
+    char (*names)[32];        /* Dataset names of the batch being encoded */
+    uint64_t blocks;          /* Written by this writer */
+    uint64_t records;
+    uint64_t bytes;           /* Block bytes written */
+    uint64_t dropped;         /* Torn-tail bytes cut when opened for append */
+    char error[160];          /* First error, empty if none */
+} dlt_archive_writer_t;
+
+/** mmap'd reader */
+typedef struct {
+    const uint8_t* map;
+    size_t size;
+    const dlt_archive_block_t** blocks;   /* Header of each whole block */
+    uint32_t n_blocks;
+    uint64_t records;
+    uint64_t tail_bytes;      /* Trailing bytes that are not a whole block */
+    char error[160];
+} dlt_archive_t;
+
+/* ========================================================================
+ * API FUNCTIONS
+ * ======================================================================== */
+
+/**
+ * Open an archive for writing.
+ *
+ * @param w Writer (caller-allocated)
+ * @param path Archive file
+ * @param append Keep existing blocks (the file header is checked and a
+ *               torn tail block is cut, see w->dropped); false truncates
+ * @return true on success; w->error says why not
+ */
+bool dlt_archive_create(dlt_archive_writer_t* w, const char* path, bool append);
+
+/**
+ * Encode and append one sealed batch as a block.
+ *
+ * @param w Writer
+ * @param records Records, in the order they should read back
+ * @param n 1 to DLT_ARCHIVE_MAX_BATCH
+ * @return true on success
+ */
+bool dlt_archive_append(dlt_archive_writer_t* w, const dlt_record_t* records, uint32_t n);
+
+/**
+ * Flush, close the file and free the buffers.
+ *
+ * @return true if every write succeeded
+ */
+bool dlt_archive_finish(dlt_archive_writer_t* w);
+
+/**
+ * Map an archive and index its blocks (headers only; columns are not
+ * touched until read).
+ *
+ * @return true on success; a->error says why not
+ */
+bool dlt_archive_open(dlt_archive_t* a, const char* path);
+
+/**
+ * Unmap and free the index.
+ */
+void dlt_archive_close(dlt_archive_t* a);
+
+/**
+ * Check one block's checksum.
+ */
+bool dlt_archive_verify(const dlt_archive_t* a, uint32_t block);
+
+/**
+ * Decode selected columns of one block. Columns not in the mask are left
+ * untouched (their pointers may be NULL).
+ *
+ * @param a Archive
+ * @param block Block index
+ * @param columns DLT_COL_BIT() mask
+ * @param cols Output columns; count is set, capacity must cover the block
+ * @return Records in the block, or -1 if malformed or over capacity
+ */
+int dlt_archive_read(const dlt_archive_t* a, uint32_t block, unsigned columns,
+                     arrow_dlt_columns_t* cols);
+
+/**
+ * Decode one block back into records (byte-identical to what was appended,
+ * padding zeroed).
+ *
+ * @param out At least the block's count records
+ * @return Records decoded, or -1 if malformed
+ */
+int dlt_archive_read_records(const dlt_archive_t* a, uint32_t block, dlt_record_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DLT_ARCHIVE_H */
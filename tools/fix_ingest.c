@@ -0,0 +1,440 @@
+/*
+ * fix_ingest.c - Batched UDP / Unix-Socket Ingest of Receiver-Station Fixes
+ *
+ * Each receive slot is one FIX_INGEST_MAX_DATAGRAM buffer with its own
+ * mmsghdr, iovec and control buffer, set up once at open; a recvmmsg()
+ * call fills up to `batch` slots and only the fields the kernel writes
+ * back (length, control length) are reset afterwards. The socket is
+ * drained non-blocking first and poll() is only entered when it is
+ * empty, so under load a batch costs one syscall. Kernel drops come from
+ * the SO_RXQ_OVFL stamp on each datagram while busy and from SO_MEMINFO
+ * when idle.
+ *
+ * Also a command-line tool unless built with -DFIX_INGEST_LIBRARY: fixes
+ * go to t_bsp_locate() + t_bsp_insert_pose(), with counters every second.
+ *
+ *   fix_ingest (-u [host:]port | -x socket_path) [-b batch] [-r rcvbuf_KB]
+ *              [-t seconds]
+ *
+ * Built with (see tests/Makefile):
+ *   gcc -O2 -D_GNU_SOURCE -o fix_ingest ../tools/fix_ingest.c ../embedded/t_bsp.c \
+ *       ../embedded/se3_math.c ../embedded/trig_tables.c -I../embedded -lm
+ *
+ * Reference: recvmmsg(2), socket(7) SO_RXQ_OVFL, unix(7)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "fix_ingest.h"
+
+#include <errno.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef SO_RXQ_OVFL
+#define SO_RXQ_OVFL 40
+#endif
+
+#ifndef SO_MEMINFO
+#define SO_MEMINFO 55
+#endif
+#define FI_MEMINFO_VARS   9         /* SK_MEMINFO_VARS (linux/sock_diag.h) */
+#define FI_MEMINFO_DROPS  8         /* SK_MEMINFO_DROPS */
+
+/* SO_RXQ_OVFL control data of one receive slot */
+typedef union {
+    char buf[CMSG_SPACE(sizeof(uint32_t))];
+    struct cmsghdr align;
+} fi_ctrl_t;
+
+/* ========================================================================
+ * SOCKET SETUP
+ * ======================================================================== */
+
+static bool fi_fail(fix_ingest_t* in, const char* what) {
+    snprintf(in->error, sizeof(in->error), "%s: %s", what, strerror(errno));
+    return false;
+}
+
+/* "[host:]port" → bound UDP socket (IPv4 or IPv6) */
+static int bind_udp(fix_ingest_t* in, const char* spec) {
+    char host[256] = "";
+    const char* port = spec;
+    const char* colon = strrchr(spec, ':');
+    if (colon) {
+        size_t n = (size_t)(colon - spec);
+        if (n >= sizeof(host)) n = sizeof(host) - 1;
+        memcpy(host, spec, n);
+        host[n] = '\0';
+        port = colon + 1;
+    }
+
+    struct addrinfo hints, *res;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    hints.ai_flags = AI_PASSIVE;
+    int rc = getaddrinfo(host[0] ? host : NULL, port, &hints, &res);
+    if (rc != 0) {
+        snprintf(in->error, sizeof(in->error), "%s: %s", spec, gai_strerror(rc));
+        return -1;
+    }
+    int fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (fd < 0) {
+        fi_fail(in, "socket");
+    } else if (bind(fd, res->ai_addr, res->ai_addrlen) != 0) {
+        fi_fail(in, spec);
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    return fd;
+}
+
+static int bind_unix(fix_ingest_t* in, const char* path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        snprintf(in->error, sizeof(in->error), "%s: socket path too long", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        fi_fail(in, "socket");
+        return -1;
+    }
+    unlink(path);
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        fi_fail(in, path);
+        close(fd);
+        return -1;
+    }
+    strcpy(in->unix_path, path);
+    return fd;
+}
+
+/* ========================================================================
+ * API
+ * ======================================================================== */
+
+void fix_ingest_default_config(fix_ingest_config_t* cfg) {
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->batch = 64;
+    cfg->rcvbuf_bytes = 4 << 20;
+}
+
+bool fix_ingest_open(fix_ingest_t* in, const fix_ingest_config_t* cfg,
+                     fix_ingest_fn on_batch, void* ctx) {
+    memset(in, 0, sizeof(*in));
+    in->fd = -1;
+    in->on_batch = on_batch;
+    in->ctx = ctx;
+    if ((cfg->udp == NULL) == (cfg->unix_path == NULL)) {
+        snprintf(in->error, sizeof(in->error), "set exactly one of udp and unix_path");
+        return false;
+    }
+    in->batch = cfg->batch < 1 ? 1 : cfg->batch > FIX_INGEST_MAX_BATCH ? FIX_INGEST_MAX_BATCH
+                                                                       : cfg->batch;
+
+    in->fd = cfg->udp ? bind_udp(in, cfg->udp) : bind_unix(in, cfg->unix_path);
+    if (in->fd < 0) return false;
+    if (cfg->rcvbuf_bytes > 0) {
+        /* Best effort: the kernel caps it at net.core.rmem_max */
+        setsockopt(in->fd, SOL_SOCKET, SO_RCVBUF, &cfg->rcvbuf_bytes, sizeof(cfg->rcvbuf_bytes));
+    }
+    if (cfg->udp) {
+        int on = 1;
+        setsockopt(in->fd, SOL_SOCKET, SO_RXQ_OVFL, &on, sizeof(on));
+    }
+
+    in->slots = malloc((size_t)in->batch * FIX_INGEST_MAX_DATAGRAM);
+    in->msgs = calloc((size_t)in->batch,
+                      sizeof(struct mmsghdr) + sizeof(struct iovec) + sizeof(fi_ctrl_t));
+    in->views = calloc((size_t)in->batch, sizeof(fix_ingest_datagram_t));
+    in->next_seq = calloc(FIX_INGEST_STATIONS, sizeof(uint32_t));
+    in->heard = calloc(FIX_INGEST_STATIONS / 8, 1);
+    if (!in->slots || !in->msgs || !in->views || !in->next_seq || !in->heard) {
+        fi_fail(in, "allocating receive ring");
+        fix_ingest_close(in);
+        return false;
+    }
+
+    /* One block: mmsghdr[batch] (contiguous, as recvmmsg() wants), then
+     * iovec[batch], then control buffers[batch] */
+    struct mmsghdr* hdrs = (struct mmsghdr*)in->msgs;
+    struct iovec* iov = (struct iovec*)(hdrs + in->batch);
+    fi_ctrl_t* ctrl = (fi_ctrl_t*)(iov + in->batch);
+    for (int i = 0; i < in->batch; i++) {
+        iov[i].iov_base = in->slots + (size_t)i * FIX_INGEST_MAX_DATAGRAM;
+        iov[i].iov_len = FIX_INGEST_MAX_DATAGRAM;
+        hdrs[i].msg_hdr.msg_iov = &iov[i];
+        hdrs[i].msg_hdr.msg_iovlen = 1;
+        hdrs[i].msg_hdr.msg_control = ctrl[i].buf;
+        hdrs[i].msg_hdr.msg_controllen = sizeof(ctrl[i].buf);
+    }
+    return true;
+}
+
+/**
+ * Validate one datagram in place and track its station's sequence.
+ *
+ * @return true if the datagram is well formed
+ */
+static bool check_datagram(fix_ingest_t* in, const uint8_t* buf, size_t len,
+                           fix_ingest_datagram_t* view) {
+    fix_ingest_header_t h;
+    if (len < sizeof(h)) return false;
+    memcpy(&h, buf, sizeof(h));
+    if (h.magic != FIX_INGEST_MAGIC || h.version != FIX_INGEST_VERSION ||
+        h.count == 0 || h.count > FIX_INGEST_MAX_FIXES ||
+        len != sizeof(h) + (size_t)h.count * sizeof(fix_ingest_fix_t)) {
+        return false;
+    }
+
+    uint8_t bit = (uint8_t)(1u << (h.station & 7));
+    if (!(in->heard[h.station >> 3] & bit)) {
+        in->heard[h.station >> 3] |= bit;
+        in->stats.stations++;
+        in->next_seq[h.station] = h.seq + 1;
+    } else {
+        int32_t ahead = (int32_t)(h.seq - in->next_seq[h.station]);
+        if (ahead >= 0) {
+            in->stats.seq_lost += (uint64_t)ahead;
+            in->next_seq[h.station] = h.seq + 1;
+        } else {
+            in->stats.seq_late++;
+        }
+    }
+
+    view->fixes = (const fix_ingest_fix_t*)(buf + sizeof(h));
+    view->count = h.count;
+    view->station = h.station;
+    view->seq = h.seq;
+    return true;
+}
+
+/**
+ * Read the socket's drop counter directly. SO_RXQ_OVFL stamps the count
+ * on each datagram as it is queued, so drops after the last queued
+ * datagram only show up here.
+ */
+static void refresh_drops(fix_ingest_t* in) {
+    uint32_t info[FI_MEMINFO_VARS];
+    socklen_t len = sizeof(info);
+    if (getsockopt(in->fd, SOL_SOCKET, SO_MEMINFO, info, &len) == 0 &&
+        len > FI_MEMINFO_DROPS * sizeof(uint32_t) && info[FI_MEMINFO_DROPS] > in->stats.kernel_drops) {
+        in->stats.kernel_drops = info[FI_MEMINFO_DROPS];
+    }
+}
+
+int fix_ingest_poll(fix_ingest_t* in, int timeout_ms) {
+    struct mmsghdr* hdrs = (struct mmsghdr*)in->msgs;
+
+    int n = recvmmsg(in->fd, hdrs, (unsigned)in->batch, MSG_DONTWAIT, NULL);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && timeout_ms != 0) {
+        struct pollfd pfd = { in->fd, POLLIN, 0 };
+        int ready = poll(&pfd, 1, timeout_ms);
+        if (ready < 0 && errno != EINTR) {
+            fi_fail(in, "poll");
+            return -1;
+        }
+        if (ready <= 0) {
+            refresh_drops(in);      /* Idle: the counter is worth a syscall */
+            return 0;
+        }
+        n = recvmmsg(in->fd, hdrs, (unsigned)in->batch, MSG_DONTWAIT, NULL);
+    }
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            refresh_drops(in);
+            return 0;
+        }
+        fi_fail(in, "recvmmsg");
+        return -1;
+    }
+    in->stats.syscalls++;
+
+    int valid = 0;
+    for (int i = 0; i < n; i++) {
+        const uint8_t* buf = in->slots + (size_t)i * FIX_INGEST_MAX_DATAGRAM;
+        struct msghdr* mh = &hdrs[i].msg_hdr;
+        for (struct cmsghdr* c = CMSG_FIRSTHDR(mh); c != NULL; c = CMSG_NXTHDR(mh, c)) {
+            if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SO_RXQ_OVFL) {
+                uint32_t drops;
+                memcpy(&drops, CMSG_DATA(c), sizeof(drops));
+                if (drops > in->stats.kernel_drops) in->stats.kernel_drops = drops;
+            }
+        }
+        mh->msg_controllen = sizeof(fi_ctrl_t);    /* Rewritten by the kernel */
+        if ((mh->msg_flags & MSG_TRUNC) ||
+            !check_datagram(in, buf, hdrs[i].msg_len, &in->views[valid])) {
+            in->stats.malformed++;
+            continue;
+        }
+        in->stats.fixes += in->views[valid].count;
+        in->stats.bytes += hdrs[i].msg_len;
+        valid++;
+    }
+    in->stats.datagrams += (uint64_t)valid;
+    if (valid > 0) in->on_batch(in->ctx, in->views, valid);
+    return n;
+}
+
+void fix_ingest_close(fix_ingest_t* in) {
+    if (in->fd >= 0) close(in->fd);
+    in->fd = -1;
+    if (in->unix_path[0]) unlink(in->unix_path);
+    in->unix_path[0] = '\0';
+    free(in->slots);
+    free(in->msgs);
+    free(in->views);
+    free(in->next_seq);
+    free(in->heard);
+    in->slots = NULL;
+    in->msgs = NULL;
+    in->views = NULL;
+    in->next_seq = NULL;
+    in->heard = NULL;
+}
+
+size_t fix_ingest_encode(uint8_t* buf, uint16_t station, uint32_t seq, uint32_t sent_time,
+                         const fix_ingest_fix_t* fixes, int n) {
+    if (n < 1 || n > FIX_INGEST_MAX_FIXES) return 0;
+    fix_ingest_header_t h = { FIX_INGEST_MAGIC, FIX_INGEST_VERSION, (uint8_t)n, station, 0,
+                              seq, sent_time };
+    memcpy(buf, &h, sizeof(h));
+    memcpy(buf + sizeof(h), fixes, (size_t)n * sizeof(fix_ingest_fix_t));
+    return sizeof(h) + (size_t)n * sizeof(fix_ingest_fix_t);
+}
+
+/* ========================================================================
+ * COMMAND-LINE TOOL
+ * ======================================================================== */
+
+#ifndef FIX_INGEST_LIBRARY
+
+#include "t_bsp.h"
+#include <signal.h>
+#include <time.h>
+
+static volatile sig_atomic_t stop_requested;
+
+static void on_signal(int sig) {
+    (void)sig;
+    stop_requested = 1;
+}
+
+typedef struct {
+    t_bsp_t* bsp;
+    t_bsp_locator_t* loc;
+    uint64_t inserted, no_cell;
+} pipeline_t;
+
+static void insert_batch(void* ctx, const fix_ingest_datagram_t* dgrams, int n) {
+    pipeline_t* pl = (pipeline_t*)ctx;
+    for (int d = 0; d < n; d++) {
+        for (int i = 0; i < dgrams[d].count; i++) {
+            const fix_ingest_fix_t* f = &dgrams[d].fixes[i];
+            uint16_t cell = t_bsp_locate(pl->bsp, pl->loc, f->pose.mmsi, f->lat, f->lon);
+            if (t_bsp_insert_pose(pl->bsp, cell, &f->pose)) {
+                pl->inserted++;
+            } else {
+                pl->no_cell++;      /* MAX_CELLS active: needs re-centering */
+            }
+        }
+    }
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void usage(void) {
+    fprintf(stderr,
+            "usage: fix_ingest (-u [host:]port | -x socket_path) [-b batch] [-r rcvbuf_KB]\n"
+            "                  [-t seconds]\n"
+            "  -u   UDP address to bind            -x   AF_UNIX datagram socket\n"
+            "  -b   datagrams per recvmmsg (64)    -r   receive buffer (4096 KB)\n"
+            "  -t   stop after seconds (0 = until SIGINT)\n");
+}
+
+int main(int argc, char** argv) {
+    fix_ingest_config_t cfg;
+    fix_ingest_default_config(&cfg);
+    double seconds = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "u:x:b:r:t:h")) != -1) {
+        switch (opt) {
+        case 'u': cfg.udp = optarg; break;
+        case 'x': cfg.unix_path = optarg; break;
+        case 'b': cfg.batch = atoi(optarg); break;
+        case 'r': cfg.rcvbuf_bytes = atoi(optarg) * 1024; break;
+        case 't': seconds = atof(optarg); break;
+        default: usage(); return 2;
+        }
+    }
+
+    static t_bsp_t bsp;
+    static t_bsp_locator_t loc;
+    t_bsp_init(&bsp, 0, 0);
+    t_bsp_locator_init(&loc);
+    pipeline_t pl = { &bsp, &loc, 0, 0 };
+
+    static fix_ingest_t in;
+    if (!fix_ingest_open(&in, &cfg, insert_batch, &pl)) {
+        fprintf(stderr, "fix_ingest: %s\n", in.error);
+        if (!cfg.udp && !cfg.unix_path) usage();
+        return 1;
+    }
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    double start = now_seconds(), last = start;
+    fix_ingest_stats_t prev = in.stats;
+    printf("%8s %10s %10s %8s %8s %8s %6s\n", "t (s)", "pkts/s", "fixes/s", "pkt/call",
+           "lost", "kdrops", "cells");
+    while (!stop_requested) {
+        if (fix_ingest_poll(&in, 100) < 0) {
+            fprintf(stderr, "fix_ingest: %s\n", in.error);
+            break;
+        }
+        double now = now_seconds();
+        if (now - last >= 1.0) {
+            const fix_ingest_stats_t* s = &in.stats;
+            uint64_t calls = s->syscalls - prev.syscalls;
+            printf("%8.0f %10.0f %10.0f %8.1f %8llu %8llu %6u\n", now - start,
+                   (s->datagrams - prev.datagrams) / (now - last),
+                   (s->fixes - prev.fixes) / (now - last),
+                   calls ? (double)(s->datagrams - prev.datagrams) / (double)calls : 0.0,
+                   (unsigned long long)s->seq_lost, (unsigned long long)s->kernel_drops,
+                   t_bsp_get_active_count(&bsp));
+            fflush(stdout);
+            prev = *s;
+            last = now;
+        }
+        if (seconds > 0 && now - start >= seconds) break;
+    }
+
+    const fix_ingest_stats_t* s = &in.stats;
+    printf("datagrams %llu, fixes %llu (%llu inserted, %llu without a cell), %u stations\n"
+           "lost %llu, late %llu, malformed %llu, kernel drops %llu\n",
+           (unsigned long long)s->datagrams, (unsigned long long)s->fixes,
+           (unsigned long long)pl.inserted, (unsigned long long)pl.no_cell, s->stations,
+           (unsigned long long)s->seq_lost, (unsigned long long)s->seq_late,
+           (unsigned long long)s->malformed, (unsigned long long)s->kernel_drops);
+    fix_ingest_close(&in);
+    return 0;
+}
+
+#endif /* FIX_INGEST_LIBRARY */
@@ -0,0 +1,210 @@
+/*
+ * fix_ingest.h - Batched UDP / Unix-Socket Ingest of Receiver-Station Fixes
+ *
+ * The shore aggregator receives fixes from dozens of receiver stations as
+ * datagrams. One recvfrom() per datagram spends most of its time in the
+ * syscall, not in the fix. fix_ingest_poll() receives up to `batch`
+ * datagrams per recvmmsg() call into a ring of fixed receive slots,
+ * validates each one in place and hands the batch to a callback as views
+ * into those slots: the fixes reach the insert pipeline without a copy.
+ *
+ * Datagram format (little-endian, packed, like the archived se3_pose_t):
+ *
+ *   fix_ingest_header_t   16 bytes: magic, version, count, station, seq
+ *   fix_ingest_fix_t[n]   64 bytes each: lat, lon (16.16 degrees) + pose
+ *
+ * n ≤ FIX_INGEST_MAX_FIXES keeps a datagram inside a 1500-byte Ethernet
+ * MTU (no IP fragmentation). Stations number their datagrams; gaps in the
+ * per-station sequence are counted as lost, whatever dropped them (the
+ * network, the socket buffer, the station). Kernel receive-queue drops
+ * are read from the socket itself (SO_RXQ_OVFL, SO_MEMINFO).
+ *
+ * An AF_UNIX SOCK_DGRAM path takes the same datagrams from local stand-ins
+ * (replay tools, simulators). Unix datagram sockets do not drop: a full
+ * queue blocks the sender, or fails its send with EAGAIN.
+ *
+ * Doom Lineage:
+ *   - Doom's net_loop (NetUpdate → HGetPacket drained every pending
+ *     doomdata_t per tic, each checked by NetbufferChecksum and sequence
+ *     before its ticcmds were used in place) → every pending datagram per
+ *     call, checked by magic, length and per-station sequence
+ *
+ * Hardware Target: host (Linux recvmmsg); fixes from ESP32-S3 receiver
+ *                  stations and edge nodes
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#ifndef FIX_INGEST_H
+#define FIX_INGEST_H
+
+#include "se3_edge.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * CONFIGURATION CONSTANTS
+ * ======================================================================== */
+
+#define FIX_INGEST_MAGIC       0x5846u      /* "FX" */
+#define FIX_INGEST_VERSION     1
+
+/* 1500 MTU - 20 IPv4 - 8 UDP = 1472 payload bytes */
+#define FIX_INGEST_MAX_DATAGRAM 1472
+#define FIX_INGEST_MAX_FIXES   ((FIX_INGEST_MAX_DATAGRAM - 16) / 64)    /* 22 */
+
+#ifndef FIX_INGEST_MAX_BATCH
+#define FIX_INGEST_MAX_BATCH   256          /* Datagrams per recvmmsg() */
+#endif
+
+#define FIX_INGEST_STATIONS    65536        /* Station IDs are uint16_t */
+
+/* ========================================================================
+ * WIRE FORMAT
+ * ======================================================================== */
+
+#pragma pack(push, 1)
+typedef struct {
+    uint16_t magic;           /* FIX_INGEST_MAGIC */
+    uint8_t version;          /* FIX_INGEST_VERSION */
+    uint8_t count;            /* Fixes that follow (1 to FIX_INGEST_MAX_FIXES) */
+    uint16_t station;         /* Receiver station ID */
+    uint16_t _reserved;       /* Zero */
+    uint32_t seq;             /* Per-station datagram sequence */
+    uint32_t sent_time;       /* Station clock, Unix seconds (informational) */
+} fix_ingest_header_t;        /* Total: 16 bytes */
+
+typedef struct {
+    fixed_t lat;              /* WGS84 degrees (16.16), selects the T-BSP cell */
+    fixed_t lon;
+    se3_pose_t pose;          /* 56 bytes; pose.mmsi identifies the vessel */
+} fix_ingest_fix_t;           /* Total: 64 bytes */
+#pragma pack(pop)
+
+_Static_assert(sizeof(fix_ingest_header_t) == 16, "wire header is 16 bytes");
+_Static_assert(sizeof(fix_ingest_fix_t) == 64, "wire fix is 64 bytes");
+_Static_assert(16 + FIX_INGEST_MAX_FIXES * 64 <= FIX_INGEST_MAX_DATAGRAM,
+               "a full datagram must fit the MTU");
+
+/* ========================================================================
+ * TYPES
+ * ======================================================================== */
+
+/**
+ * One validated datagram, viewed in place in its receive slot.
+ * Valid until the callback returns.
+ */
+typedef struct {
+    const fix_ingest_fix_t* fixes;
+    uint16_t count;
+    uint16_t station;
+    uint32_t seq;
+} fix_ingest_datagram_t;
+
+/**
+ * Batch callback: the valid datagrams of one recvmmsg() call, in arrival
+ * order.
+ *
+ * @param ctx Caller context
+ * @param dgrams Datagram views
+ * @param n Number of datagrams (≥ 1)
+ */
+typedef void (*fix_ingest_fn)(void* ctx, const fix_ingest_datagram_t* dgrams, int n);
+
+typedef struct {
+    const char* udp;          /* "[host:]port" to bind, or NULL */
+    const char* unix_path;    /* AF_UNIX datagram socket path, or NULL */
+    int batch;                /* Datagrams per recvmmsg(); 1 = per-packet */
+    int rcvbuf_bytes;         /* SO_RCVBUF request; 0 = system default */
+} fix_ingest_config_t;
+
+typedef struct {
+    uint64_t syscalls;        /* recvmmsg() calls that returned data */
+    uint64_t datagrams;       /* Valid datagrams delivered */
+    uint64_t fixes;
+    uint64_t bytes;           /* Valid datagram bytes */
+    uint64_t malformed;       /* Bad magic / version / count / length */
+    uint64_t seq_lost;        /* Sequence gaps, summed over stations */
+    uint64_t seq_late;        /* Behind the station's sequence (reordered or repeated) */
+    uint64_t kernel_drops;    /* Socket receive-queue drops (SO_RXQ_OVFL, SO_MEMINFO) */
+    uint32_t stations;        /* Stations heard from */
+} fix_ingest_stats_t;
+
+typedef struct {
+    int fd;
+    int batch;
+    fix_ingest_fn on_batch;
+    void* ctx;
+    uint8_t* slots;           /* batch × FIX_INGEST_MAX_DATAGRAM receive ring */
+    void* msgs;               /* mmsghdr[batch], iovec[batch], control[batch] */
+    fix_ingest_datagram_t* views;
+    uint32_t* next_seq;       /* [FIX_INGEST_STATIONS]: expected seq */
+    uint8_t* heard;           /* [FIX_INGEST_STATIONS / 8]: seq known */
+    char unix_path[108];      /* Unlinked on close */
+    fix_ingest_stats_t stats;
+    char error[160];          /* Last error, empty if none */
+} fix_ingest_t;
+
+/* ========================================================================
+ * API FUNCTIONS
+ * ======================================================================== */
+
+/**
+ * Defaults: no socket, batch 64, 4 MB receive buffer.
+ */
+void fix_ingest_default_config(fix_ingest_config_t* cfg);
+
+/**
+ * Bind the socket and allocate the receive ring.
+ *
+ * Exactly one of cfg->udp and cfg->unix_path must be set. An existing
+ * Unix socket file at unix_path is replaced.
+ *
+ * @param in Ingest state (caller-allocated)
+ * @param cfg Socket and batch configuration
+ * @param on_batch Called with each batch of valid datagrams
+ * @param ctx Passed to on_batch
+ * @return true on success; in->error says why not
+ */
+bool fix_ingest_open(fix_ingest_t* in, const fix_ingest_config_t* cfg,
+                     fix_ingest_fn on_batch, void* ctx);
+
+/**
+ * Receive one batch (blocking up to timeout_ms for the first datagram,
+ * then taking whatever else is queued, up to cfg->batch).
+ *
+ * @param in Ingest state
+ * @param timeout_ms Wait for the first datagram; -1 = forever, 0 = poll
+ * @return Datagrams received (valid or not), 0 on timeout, -1 on error
+ */
+int fix_ingest_poll(fix_ingest_t* in, int timeout_ms);
+
+/**
+ * Close the socket, remove the Unix socket file, free the ring.
+ */
+void fix_ingest_close(fix_ingest_t* in);
+
+/**
+ * Encode one datagram (stations, stand-ins, the packet blaster).
+ *
+ * @param buf Output, at least FIX_INGEST_MAX_DATAGRAM bytes
+ * @param station Station ID
+ * @param seq Station's datagram sequence number
+ * @param sent_time Station clock (Unix seconds)
+ * @param fixes Fixes to send
+ * @param n Number of fixes (1 to FIX_INGEST_MAX_FIXES)
+ * @return Datagram length in bytes, 0 if n is out of range
+ */
+size_t fix_ingest_encode(uint8_t* buf, uint16_t station, uint32_t seq, uint32_t sent_time,
+                         const fix_ingest_fix_t* fixes, int n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FIX_INGEST_H */
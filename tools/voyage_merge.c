@@ -0,0 +1,913 @@
+/*
+ * voyage_merge.c - External K-Way Merge of Archived Segments into Voyages
+ *
+ * Phase 1 sorts each buffer-full of records with an LSD radix sort on the
+ * 64-bit key (mmsi << 32 | timestamp); byte digits that are constant over
+ * the buffer (the MMSI's top byte, the timestamp's high bytes within an
+ * archive window) are skipped. Phase 2 merges with a binary heap of
+ * buffered pread() cursors; run files are shared by all workers (pread
+ * carries its own offset), so fan-in, not threads × fan-in, bounds the
+ * open descriptors.
+ *
+ * Also a command-line tool unless built with -DVOYAGE_MERGE_LIBRARY:
+ *
+ *   voyage_merge [-j threads] [-m MB] [-p partitions] [-t tmp_dir] [-k]
+ *                -o out_dir (segment ... | -l list_file)
+ *
+ * Built with (see tests/Makefile):
+ *   gcc -O2 -D_GNU_SOURCE -pthread -o voyage_merge ../tools/voyage_merge.c -I../embedded
+ *
+ * Reference: D. Knuth, TAOCP Vol. 3, 5.4.1 (multiway merging, replacement
+ *            selection) and 5.2.5 (radix sorting)
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#include "voyage_merge.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MMSI_OFFSET  offsetof(se3_pose_t, mmsi)
+
+/* ========================================================================
+ * SHARED STATE
+ * ======================================================================== */
+
+typedef struct {
+    char* path;
+    uint64_t n;              /* Records */
+} vm_run_t;
+
+typedef struct {
+    uint32_t mmsi;
+    double weight;           /* Records this sample stands for */
+} vm_sample_t;
+
+typedef struct {
+    const voyage_merge_config_t* cfg;
+    voyage_merge_stats_t* stats;
+    const char* tmp_dir;
+    size_t worker_bytes;     /* Budget per worker */
+    pthread_mutex_t lock;
+    bool failed;
+
+    /* Phase 1 */
+    const char* const* segments;
+    int n_segments;
+    int next_segment;
+    uint32_t run_seq;
+    vm_run_t* runs;
+    int n_runs, cap_runs;
+    vm_sample_t* samples;
+    int n_samples, cap_samples;
+
+    /* Intermediate passes: groups of fan-in runs */
+    vm_run_t* groups_in;
+    int group_size, n_groups, next_group;
+    vm_run_t* groups_out;
+
+    /* Phase 2 */
+    uint64_t* cuts;          /* Partition p: mmsi in [cuts[p], cuts[p+1]) */
+    int n_parts, next_part;
+    int* run_fds;
+} vm_ctx_t;
+
+static void vm_fail(vm_ctx_t* ctx, const char* fmt, ...) {
+    pthread_mutex_lock(&ctx->lock);
+    if (!ctx->failed) {
+        va_list ap;
+        va_start(ap, fmt);
+        vsnprintf(ctx->stats->error, sizeof(ctx->stats->error), fmt, ap);
+        va_end(ap);
+        ctx->failed = true;
+    }
+    pthread_mutex_unlock(&ctx->lock);
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static inline uint64_t record_key(const uint8_t* rec) {
+    const se3_pose_t* p = (const se3_pose_t*)rec;
+    return ((uint64_t)p->mmsi << 32) | p->timestamp;
+}
+
+/* Total order: key, then record bytes (scheduling-independent ties) */
+static inline int record_cmp(const uint8_t* a, const uint8_t* b) {
+    uint64_t ka = record_key(a), kb = record_key(b);
+    if (ka != kb) return ka < kb ? -1 : 1;
+    return memcmp(a, b, VM_RECORD_SIZE);
+}
+
+static bool write_all(int fd, const uint8_t* buf, size_t len) {
+    while (len > 0) {
+        ssize_t w = write(fd, buf, len);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        buf += w;
+        len -= (size_t)w;
+    }
+    return true;
+}
+
+static bool pread_all(int fd, uint8_t* buf, size_t len, uint64_t off) {
+    while (len > 0) {
+        ssize_t r = pread(fd, buf, len, (off_t)off);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        buf += r;
+        len -= (size_t)r;
+        off += (uint64_t)r;
+    }
+    return true;
+}
+
+static bool add_run(vm_ctx_t* ctx, vm_run_t** runs, int* n, int* cap, char* path, uint64_t records) {
+    if (*n == *cap) {
+        int new_cap = *cap ? *cap * 2 : 64;
+        vm_run_t* grown = realloc(*runs, (size_t)new_cap * sizeof(vm_run_t));
+        if (!grown) {
+            vm_fail(ctx, "out of memory (run list)");
+            return false;
+        }
+        *runs = grown;
+        *cap = new_cap;
+    }
+    (*runs)[*n].path = path;
+    (*runs)[*n].n = records;
+    (*n)++;
+    return true;
+}
+
+static char* new_run_path(vm_ctx_t* ctx) {
+    pthread_mutex_lock(&ctx->lock);
+    uint32_t seq = ctx->run_seq++;
+    pthread_mutex_unlock(&ctx->lock);
+    size_t len = strlen(ctx->tmp_dir) + 48;
+    char* path = malloc(len);
+    if (path) snprintf(path, len, "%s/vm-run-%ld-%u.tmp", ctx->tmp_dir, (long)getpid(), seq);
+    return path;
+}
+
+/* ========================================================================
+ * BUFFERED OUTPUT (run files and voyage files)
+ * ======================================================================== */
+
+typedef struct {
+    int fd;
+    uint8_t* buf;
+    size_t used;
+} vm_writer_t;
+
+static bool writer_flush(vm_writer_t* w) {
+    bool ok = write_all(w->fd, w->buf, w->used);
+    w->used = 0;
+    return ok;
+}
+
+static inline bool writer_put(vm_writer_t* w, const uint8_t* rec) {
+    if (w->used + VM_RECORD_SIZE > VM_WRITE_BUFFER && !writer_flush(w)) return false;
+    memcpy(w->buf + w->used, rec, VM_RECORD_SIZE);
+    w->used += VM_RECORD_SIZE;
+    return true;
+}
+
+/* ========================================================================
+ * PHASE 1: RUN GENERATION
+ * ======================================================================== */
+
+typedef struct {
+    uint64_t key;
+    uint32_t idx;
+} vm_key_t;
+
+/**
+ * Stable LSD radix sort of keys by 8-bit digits, skipping digits that are
+ * the same for every key. Result ends up in keys (tmp is scratch).
+ */
+static void radix_sort_keys(vm_key_t* keys, vm_key_t* tmp, size_t n) {
+    static const int DIGITS = 8;
+    size_t (*count)[256] = calloc((size_t)DIGITS, sizeof(*count));
+    if (!count) {
+        /* Fall back to insertion sort on a tiny allocation failure path */
+        for (size_t i = 1; i < n; i++) {
+            vm_key_t v = keys[i];
+            size_t j = i;
+            while (j > 0 && keys[j - 1].key > v.key) { keys[j] = keys[j - 1]; j--; }
+            keys[j] = v;
+        }
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        uint64_t k = keys[i].key;
+        for (int d = 0; d < DIGITS; d++) count[d][(k >> (8 * d)) & 0xFF]++;
+    }
+    vm_key_t* src = keys;
+    vm_key_t* dst = tmp;
+    for (int d = 0; d < DIGITS; d++) {
+        if (count[d][(src[0].key >> (8 * d)) & 0xFF] == n) continue;   /* constant digit */
+        size_t offset = 0;
+        for (int v = 0; v < 256; v++) {
+            size_t c = count[d][v];
+            count[d][v] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; i++) {
+            dst[count[d][(src[i].key >> (8 * d)) & 0xFF]++] = src[i];
+        }
+        vm_key_t* t = src;
+        src = dst;
+        dst = t;
+    }
+    if (src != keys) memcpy(keys, src, n * sizeof(vm_key_t));
+    free(count);
+}
+
+static void flush_run(vm_ctx_t* ctx, const uint8_t* buf, vm_key_t* keys, vm_key_t* tmp,
+                      size_t n, vm_writer_t* w) {
+    for (size_t i = 0; i < n; i++) {
+        keys[i].key = record_key(buf + i * VM_RECORD_SIZE);
+        keys[i].idx = (uint32_t)i;
+    }
+    radix_sort_keys(keys, tmp, n);
+
+    /* Equal keys (rare): order by record bytes */
+    for (size_t i = 1; i < n; i++) {
+        if (keys[i].key != keys[i - 1].key) continue;
+        vm_key_t v = keys[i];
+        size_t j = i;
+        while (j > 0 && keys[j - 1].key == v.key &&
+               memcmp(buf + (size_t)keys[j - 1].idx * VM_RECORD_SIZE,
+                      buf + (size_t)v.idx * VM_RECORD_SIZE, VM_RECORD_SIZE) > 0) {
+            keys[j] = keys[j - 1];
+            j--;
+        }
+        keys[j] = v;
+    }
+
+    char* path = new_run_path(ctx);
+    if (!path) {
+        vm_fail(ctx, "out of memory (run path)");
+        return;
+    }
+    w->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    w->used = 0;
+    if (w->fd < 0) {
+        vm_fail(ctx, "%s: %s", path, strerror(errno));
+        free(path);
+        return;
+    }
+    bool ok = true;
+    for (size_t i = 0; i < n && ok; i++) {
+        ok = writer_put(w, buf + (size_t)keys[i].idx * VM_RECORD_SIZE);
+    }
+    ok = ok && writer_flush(w);
+    close(w->fd);
+    if (!ok) {
+        vm_fail(ctx, "%s: write failed: %s", path, strerror(errno));
+        unlink(path);
+        free(path);
+        return;
+    }
+
+    int n_samples = n < VM_SAMPLES_PER_RUN ? (int)n : VM_SAMPLES_PER_RUN;
+    pthread_mutex_lock(&ctx->lock);
+    if (!add_run(ctx, &ctx->runs, &ctx->n_runs, &ctx->cap_runs, path, n)) {
+        pthread_mutex_unlock(&ctx->lock);
+        unlink(path);
+        free(path);
+        return;
+    }
+    if (ctx->n_samples + n_samples > ctx->cap_samples) {
+        int new_cap = (ctx->cap_samples + n_samples) * 2;
+        vm_sample_t* grown = realloc(ctx->samples, (size_t)new_cap * sizeof(vm_sample_t));
+        if (grown) {
+            ctx->samples = grown;
+            ctx->cap_samples = new_cap;
+        } else {
+            n_samples = 0;      /* Cuts get coarser, output stays correct */
+        }
+    }
+    for (int s = 0; s < n_samples; s++) {
+        size_t at = ((size_t)(2 * s + 1) * n) / (size_t)(2 * n_samples);
+        ctx->samples[ctx->n_samples].mmsi = (uint32_t)(keys[at].key >> 32);
+        ctx->samples[ctx->n_samples].weight = (double)n / n_samples;
+        ctx->n_samples++;
+    }
+    pthread_mutex_unlock(&ctx->lock);
+}
+
+static void* run_worker(void* arg) {
+    vm_ctx_t* ctx = (vm_ctx_t*)arg;
+    size_t budget = ctx->worker_bytes > VM_WRITE_BUFFER ? ctx->worker_bytes - VM_WRITE_BUFFER : 0;
+    size_t cap = budget / (VM_RECORD_SIZE + 2 * sizeof(vm_key_t));
+    if (cap < 1024) cap = 1024;
+    uint8_t* buf = malloc(cap * VM_RECORD_SIZE);
+    vm_key_t* keys = malloc(cap * sizeof(vm_key_t));
+    vm_key_t* tmp = malloc(cap * sizeof(vm_key_t));
+    vm_writer_t w = { -1, malloc(VM_WRITE_BUFFER), 0 };
+    uint64_t bytes = 0, truncated = 0;
+    size_t used = 0;
+    const size_t full = cap * VM_RECORD_SIZE;
+
+    if (!buf || !keys || !tmp || !w.buf) {
+        vm_fail(ctx, "out of memory (run buffer, %zu records)", cap);
+        goto done;
+    }
+    for (;;) {
+        pthread_mutex_lock(&ctx->lock);
+        int i = ctx->failed ? ctx->n_segments : ctx->next_segment++;
+        pthread_mutex_unlock(&ctx->lock);
+        if (i >= ctx->n_segments) break;
+
+        int fd = open(ctx->segments[i], O_RDONLY);
+        if (fd < 0) {
+            vm_fail(ctx, "%s: %s", ctx->segments[i], strerror(errno));
+            break;
+        }
+        for (;;) {
+            ssize_t r = read(fd, buf + used, full - used);
+            if (r < 0 && errno == EINTR) continue;
+            if (r < 0) {
+                vm_fail(ctx, "%s: %s", ctx->segments[i], strerror(errno));
+                break;
+            }
+            if (r == 0) {
+                /* A segment starts on a record boundary (flushes happen
+                 * only when the buffer is full), so the remainder is its
+                 * own truncated tail */
+                size_t tail = used % VM_RECORD_SIZE;
+                used -= tail;
+                truncated += tail;
+                break;
+            }
+            bytes += (uint64_t)r;
+            used += (size_t)r;
+            if (used == full) {
+                flush_run(ctx, buf, keys, tmp, cap, &w);
+                used = 0;
+            }
+        }
+        close(fd);
+    }
+    if (used > 0 && !ctx->failed) {
+        flush_run(ctx, buf, keys, tmp, used / VM_RECORD_SIZE, &w);
+    }
+
+done:
+    pthread_mutex_lock(&ctx->lock);
+    ctx->stats->bytes_in += bytes;
+    ctx->stats->truncated_bytes += truncated;
+    pthread_mutex_unlock(&ctx->lock);
+    free(buf);
+    free(keys);
+    free(tmp);
+    free(w.buf);
+    return NULL;
+}
+
+/* ========================================================================
+ * K-WAY MERGE
+ * ======================================================================== */
+
+typedef struct {
+    int fd;
+    uint64_t pos, end;       /* Next record to read, one past the last */
+    uint8_t* buf;
+    uint32_t cap, n, i;      /* Buffered records, consumed */
+} vm_cursor_t;
+
+static bool cursor_fill(vm_cursor_t* c, bool* io_error) {
+    uint64_t left = c->end - c->pos;
+    if (left == 0) return false;
+    uint32_t n = left < c->cap ? (uint32_t)left : c->cap;
+    if (!pread_all(c->fd, c->buf, (size_t)n * VM_RECORD_SIZE, c->pos * VM_RECORD_SIZE)) {
+        *io_error = true;
+        return false;
+    }
+    c->pos += n;
+    c->n = n;
+    c->i = 0;
+    return true;
+}
+
+static inline const uint8_t* cursor_head(const vm_cursor_t* c) {
+    return c->buf + (size_t)c->i * VM_RECORD_SIZE;
+}
+
+typedef bool (*vm_emit_fn)(void* ctx, const uint8_t* rec);
+
+static void sift_down(vm_cursor_t** heap, int n, int i) {
+    for (;;) {
+        int l = 2 * i + 1, m = i;
+        if (l < n && record_cmp(cursor_head(heap[l]), cursor_head(heap[m])) < 0) m = l;
+        if (l + 1 < n && record_cmp(cursor_head(heap[l + 1]), cursor_head(heap[m])) < 0) m = l + 1;
+        if (m == i) return;
+        vm_cursor_t* t = heap[i];
+        heap[i] = heap[m];
+        heap[m] = t;
+        i = m;
+    }
+}
+
+/**
+ * Merge k cursors in (key, bytes) order into emit; drops byte-identical
+ * neighbours unless keep_duplicates. Returns false on I/O or emit error.
+ */
+static bool merge_cursors(vm_cursor_t* cursors, int k, vm_cursor_t** heap, bool keep_duplicates,
+                          vm_emit_fn emit, void* emit_ctx, uint64_t* out, uint64_t* dups) {
+    bool io_error = false;
+    int n = 0;
+    for (int j = 0; j < k; j++) {
+        cursors[j].n = cursors[j].i = 0;
+        if (cursor_fill(&cursors[j], &io_error)) heap[n++] = &cursors[j];
+    }
+    for (int i = n / 2 - 1; i >= 0; i--) sift_down(heap, n, i);
+
+    uint8_t last[sizeof(se3_pose_t)];
+    bool have_last = false;
+    while (n > 0 && !io_error) {
+        vm_cursor_t* c = heap[0];
+        const uint8_t* rec = cursor_head(c);
+        if (!keep_duplicates && have_last && memcmp(rec, last, VM_RECORD_SIZE) == 0) {
+            (*dups)++;
+        } else {
+            if (!emit(emit_ctx, rec)) return false;
+            memcpy(last, rec, VM_RECORD_SIZE);
+            have_last = true;
+            (*out)++;
+        }
+        if (++c->i == c->n && !cursor_fill(c, &io_error)) {
+            heap[0] = heap[--n];
+        }
+        sift_down(heap, n, 0);
+    }
+    return !io_error;
+}
+
+typedef struct {
+    vm_cursor_t* cursors;
+    vm_cursor_t** heap;
+    uint32_t per_cursor;     /* Records per cursor buffer */
+    uint8_t* slab;
+} vm_merger_t;
+
+static bool merger_init(vm_merger_t* m, vm_ctx_t* ctx, int k) {
+    size_t budget = ctx->worker_bytes > VM_WRITE_BUFFER ? ctx->worker_bytes - VM_WRITE_BUFFER : 0;
+    size_t per = budget / (size_t)(k > 0 ? k : 1) / VM_RECORD_SIZE;
+    if (per > VM_READ_BUFFER_MAX / VM_RECORD_SIZE) per = VM_READ_BUFFER_MAX / VM_RECORD_SIZE;
+    if (per < VM_READ_BUFFER_MIN / VM_RECORD_SIZE) per = VM_READ_BUFFER_MIN / VM_RECORD_SIZE;
+    m->per_cursor = (uint32_t)per;
+    m->cursors = calloc((size_t)k, sizeof(vm_cursor_t));
+    m->heap = calloc((size_t)k, sizeof(vm_cursor_t*));
+    m->slab = malloc((size_t)k * per * VM_RECORD_SIZE);
+    if (!m->cursors || !m->heap || !m->slab) {
+        vm_fail(ctx, "out of memory (%d merge cursors)", k);
+        return false;
+    }
+    for (int j = 0; j < k; j++) {
+        m->cursors[j].buf = m->slab + (size_t)j * per * VM_RECORD_SIZE;
+        m->cursors[j].cap = (uint32_t)per;
+        m->cursors[j].fd = -1;
+    }
+    return true;
+}
+
+static void merger_free(vm_merger_t* m) {
+    free(m->cursors);
+    free(m->heap);
+    free(m->slab);
+}
+
+/* ========================================================================
+ * INTERMEDIATE PASSES (more runs than the fan-in)
+ * ======================================================================== */
+
+static bool emit_run(void* w, const uint8_t* rec) {
+    return writer_put((vm_writer_t*)w, rec);
+}
+
+static void* pass_worker(void* arg) {
+    vm_ctx_t* ctx = (vm_ctx_t*)arg;
+    vm_merger_t m;
+    vm_writer_t w = { -1, malloc(VM_WRITE_BUFFER), 0 };
+    uint64_t dups = 0;
+
+    if (!w.buf) {
+        vm_fail(ctx, "out of memory (write buffer)");
+        return NULL;
+    }
+    if (!merger_init(&m, ctx, ctx->group_size)) {
+        merger_free(&m);
+        free(w.buf);
+        return NULL;
+    }
+    for (;;) {
+        pthread_mutex_lock(&ctx->lock);
+        int g = ctx->failed ? ctx->n_groups : ctx->next_group++;
+        pthread_mutex_unlock(&ctx->lock);
+        if (g >= ctx->n_groups) break;
+
+        int first = g * ctx->group_size;
+        int k = ctx->n_runs - first < ctx->group_size ? ctx->n_runs - first : ctx->group_size;
+        bool ok = true;
+        for (int j = 0; j < k; j++) {
+            m.cursors[j].fd = open(ctx->groups_in[first + j].path, O_RDONLY);
+            m.cursors[j].pos = 0;
+            m.cursors[j].end = ctx->groups_in[first + j].n;
+            if (m.cursors[j].fd < 0) ok = false;
+        }
+        char* path = ok ? new_run_path(ctx) : NULL;
+        w.fd = path ? open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644) : -1;
+        w.used = 0;
+        uint64_t out = 0;
+        ok = ok && w.fd >= 0 &&
+             merge_cursors(m.cursors, k, m.heap, ctx->cfg->keep_duplicates, emit_run, &w,
+                           &out, &dups) &&
+             writer_flush(&w);
+        if (w.fd >= 0) close(w.fd);
+        for (int j = 0; j < k; j++) {
+            if (m.cursors[j].fd >= 0) close(m.cursors[j].fd);
+            m.cursors[j].fd = -1;
+            unlink(ctx->groups_in[first + j].path);
+        }
+        if (!ok) {
+            vm_fail(ctx, "merge pass, group %d: %s", g, strerror(errno));
+            if (path) unlink(path);
+            free(path);
+            break;
+        }
+        ctx->groups_out[g].path = path;
+        ctx->groups_out[g].n = out;
+    }
+    pthread_mutex_lock(&ctx->lock);
+    ctx->stats->duplicates += dups;
+    pthread_mutex_unlock(&ctx->lock);
+    merger_free(&m);
+    free(w.buf);
+    return NULL;
+}
+
+/* ========================================================================
+ * PHASE 2: PARTITIONED MERGE INTO VOYAGE FILES
+ * ======================================================================== */
+
+/* First record index in a sorted run with mmsi ≥ bound */
+static bool run_lower_bound(int fd, uint64_t n, uint64_t bound, uint64_t* out) {
+    uint64_t lo = 0, hi = n;
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        uint32_t mmsi;
+        if (!pread_all(fd, (uint8_t*)&mmsi, sizeof(mmsi), mid * VM_RECORD_SIZE + MMSI_OFFSET)) {
+            return false;
+        }
+        if ((uint64_t)mmsi < bound) lo = mid + 1;
+        else hi = mid;
+    }
+    *out = lo;
+    return true;
+}
+
+typedef struct {
+    const char* out_dir;
+    vm_writer_t w;
+    uint32_t mmsi;
+    uint32_t vessels;
+} vm_voyage_out_t;
+
+static bool voyage_close(vm_voyage_out_t* v) {
+    if (v->w.fd < 0) return true;
+    bool ok = writer_flush(&v->w);
+    ok = (close(v->w.fd) == 0) && ok;
+    v->w.fd = -1;
+    return ok;
+}
+
+static bool emit_voyage(void* arg, const uint8_t* rec) {
+    vm_voyage_out_t* v = (vm_voyage_out_t*)arg;
+    uint32_t mmsi = ((const se3_pose_t*)rec)->mmsi;
+    if (v->w.fd < 0 || mmsi != v->mmsi) {
+        if (!voyage_close(v)) return false;
+        char path[PATH_MAX];
+        snprintf(path, sizeof(path), "%s/%09u.pose", v->out_dir, mmsi);
+        v->w.fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (v->w.fd < 0) return false;
+        v->mmsi = mmsi;
+        v->vessels++;
+    }
+    return writer_put(&v->w, rec);
+}
+
+static void* partition_worker(void* arg) {
+    vm_ctx_t* ctx = (vm_ctx_t*)arg;
+    vm_merger_t m;
+    vm_voyage_out_t v = { ctx->cfg->out_dir, { -1, malloc(VM_WRITE_BUFFER), 0 }, 0, 0 };
+    uint64_t out = 0, dups = 0;
+    uint32_t parts = 0;
+
+    if (!v.w.buf) {
+        vm_fail(ctx, "out of memory (write buffer)");
+        return NULL;
+    }
+    if (!merger_init(&m, ctx, ctx->n_runs)) {
+        merger_free(&m);
+        free(v.w.buf);
+        return NULL;
+    }
+    for (int j = 0; j < ctx->n_runs; j++) m.cursors[j].fd = ctx->run_fds[j];
+
+    for (;;) {
+        pthread_mutex_lock(&ctx->lock);
+        int p = ctx->failed ? ctx->n_parts : ctx->next_part++;
+        pthread_mutex_unlock(&ctx->lock);
+        if (p >= ctx->n_parts) break;
+
+        bool ok = true;
+        for (int j = 0; j < ctx->n_runs && ok; j++) {
+            ok = run_lower_bound(ctx->run_fds[j], ctx->runs[j].n, ctx->cuts[p], &m.cursors[j].pos) &&
+                 run_lower_bound(ctx->run_fds[j], ctx->runs[j].n, ctx->cuts[p + 1], &m.cursors[j].end);
+        }
+        ok = ok && merge_cursors(m.cursors, ctx->n_runs, m.heap, ctx->cfg->keep_duplicates,
+                                 emit_voyage, &v, &out, &dups);
+        ok = voyage_close(&v) && ok;
+        if (!ok) {
+            vm_fail(ctx, "partition %d: %s", p, strerror(errno));
+            break;
+        }
+        parts++;
+    }
+    pthread_mutex_lock(&ctx->lock);
+    ctx->stats->records_out += out;
+    ctx->stats->duplicates += dups;
+    ctx->stats->vessels += v.vessels;
+    ctx->stats->partitions += parts;
+    pthread_mutex_unlock(&ctx->lock);
+    merger_free(&m);
+    free(v.w.buf);
+    return NULL;
+}
+
+/* ========================================================================
+ * DRIVER
+ * ======================================================================== */
+
+static void run_workers(vm_ctx_t* ctx, void* (*fn)(void*)) {
+    int threads = ctx->cfg->threads > 1 ? ctx->cfg->threads : 1;
+    pthread_t tid[256];
+    int started = 0;
+    if (threads > 256) threads = 256;
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&tid[started], NULL, fn, ctx) == 0) started++;
+    }
+    fn(ctx);
+    for (int t = 0; t < started; t++) pthread_join(tid[t], NULL);
+}
+
+static int cmp_sample(const void* a, const void* b) {
+    uint32_t x = ((const vm_sample_t*)a)->mmsi, y = ((const vm_sample_t*)b)->mmsi;
+    return (x > y) - (x < y);
+}
+
+/* MMSI range cuts at weighted sample quantiles; a vessel never straddles */
+static bool make_cuts(vm_ctx_t* ctx, int parts) {
+    ctx->cuts = malloc((size_t)(parts + 1) * sizeof(uint64_t));
+    if (!ctx->cuts) return false;
+    qsort(ctx->samples, (size_t)ctx->n_samples, sizeof(vm_sample_t), cmp_sample);
+    double total = 0.0;
+    for (int s = 0; s < ctx->n_samples; s++) total += ctx->samples[s].weight;
+
+    int n = 0;
+    ctx->cuts[n++] = 0;
+    double acc = 0.0;
+    int s = 0;
+    for (int p = 1; p < parts; p++) {
+        double target = total * p / parts;
+        while (s < ctx->n_samples && acc + ctx->samples[s].weight <= target) {
+            acc += ctx->samples[s++].weight;
+        }
+        if (s >= ctx->n_samples) break;
+        uint64_t cut = ctx->samples[s].mmsi;
+        if (cut > ctx->cuts[n - 1]) ctx->cuts[n++] = cut;
+    }
+    ctx->cuts[n] = (uint64_t)1 << 32;
+    ctx->n_parts = n;
+    return true;
+}
+
+void voyage_merge_default_config(voyage_merge_config_t* cfg, const char* out_dir) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    cfg->out_dir = out_dir;
+    cfg->tmp_dir = NULL;
+    cfg->memory_bytes = (size_t)256 << 20;
+    cfg->threads = cpus > 0 ? (int)cpus : 1;
+    cfg->partitions = 0;
+    cfg->keep_duplicates = false;
+}
+
+static bool make_dir(const char* path) {
+    return mkdir(path, 0755) == 0 || errno == EEXIST;
+}
+
+bool voyage_merge(const char* const* segments, int n_segments,
+                  const voyage_merge_config_t* cfg, voyage_merge_stats_t* stats) {
+    vm_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    memset(stats, 0, sizeof(*stats));
+    ctx.cfg = cfg;
+    ctx.stats = stats;
+    ctx.tmp_dir = cfg->tmp_dir ? cfg->tmp_dir : cfg->out_dir;
+    ctx.segments = segments;
+    ctx.n_segments = n_segments;
+    int threads = cfg->threads > 1 ? cfg->threads : 1;
+    ctx.worker_bytes = cfg->memory_bytes / (size_t)threads;
+    pthread_mutex_init(&ctx.lock, NULL);
+
+    double t0 = now_seconds();
+    if (!make_dir(cfg->out_dir) || !make_dir(ctx.tmp_dir)) {
+        vm_fail(&ctx, "mkdir: %s", strerror(errno));
+        goto cleanup;
+    }
+
+    /* Phase 1: sorted runs */
+    run_workers(&ctx, run_worker);
+    stats->runs = (uint32_t)ctx.n_runs;
+    stats->records_in = 0;
+    for (int j = 0; j < ctx.n_runs; j++) stats->records_in += ctx.runs[j].n;
+    double t1 = now_seconds();
+    stats->run_seconds = t1 - t0;
+    if (ctx.failed) goto cleanup;
+
+    /* Fan-in: cursor buffers of at least VM_READ_BUFFER_MIN per worker */
+    size_t budget = ctx.worker_bytes > VM_WRITE_BUFFER ? ctx.worker_bytes - VM_WRITE_BUFFER : 0;
+    int fanin = (int)(budget / VM_READ_BUFFER_MIN);
+    if (fanin > VM_MAX_FANIN) fanin = VM_MAX_FANIN;
+    if (fanin < 2) fanin = 2;
+    while (ctx.n_runs > fanin) {
+        ctx.group_size = fanin;
+        ctx.n_groups = (ctx.n_runs + fanin - 1) / fanin;
+        ctx.next_group = 0;
+        ctx.groups_in = ctx.runs;
+        ctx.groups_out = calloc((size_t)ctx.n_groups, sizeof(vm_run_t));
+        if (!ctx.groups_out) {
+            vm_fail(&ctx, "out of memory (merge pass)");
+            goto cleanup;
+        }
+        run_workers(&ctx, pass_worker);
+        for (int j = 0; j < ctx.n_runs; j++) free(ctx.runs[j].path);
+        free(ctx.runs);
+        ctx.runs = ctx.groups_out;
+        ctx.n_runs = ctx.cap_runs = ctx.n_groups;
+        ctx.groups_out = NULL;
+        stats->merge_passes++;
+        if (ctx.failed) goto cleanup;
+    }
+
+    /* Phase 2: MMSI ranges, merged in parallel into voyage files */
+    int parts = cfg->partitions > 0 ? cfg->partitions : 4 * threads;
+    ctx.run_fds = malloc((size_t)(ctx.n_runs > 0 ? ctx.n_runs : 1) * sizeof(int));
+    if (!ctx.run_fds || !make_cuts(&ctx, parts)) {
+        vm_fail(&ctx, "out of memory (partitions)");
+        goto cleanup;
+    }
+    for (int j = 0; j < ctx.n_runs; j++) ctx.run_fds[j] = -1;
+    for (int j = 0; j < ctx.n_runs; j++) {
+        ctx.run_fds[j] = open(ctx.runs[j].path, O_RDONLY);
+        if (ctx.run_fds[j] < 0) {
+            vm_fail(&ctx, "%s: %s", ctx.runs[j].path, strerror(errno));
+            goto cleanup;
+        }
+    }
+    if (ctx.n_runs > 0) run_workers(&ctx, partition_worker);
+
+cleanup:
+    if (ctx.run_fds) {
+        for (int j = 0; j < ctx.n_runs; j++) {
+            if (ctx.run_fds[j] >= 0) close(ctx.run_fds[j]);
+        }
+    }
+    for (int j = 0; j < ctx.n_runs; j++) {
+        if (ctx.runs[j].path) {
+            unlink(ctx.runs[j].path);
+            free(ctx.runs[j].path);
+        }
+    }
+    double t2 = now_seconds();
+    stats->merge_seconds = t2 - t0 - stats->run_seconds;
+    if (t2 > t0) stats->gb_per_min = (double)stats->bytes_in / 1e9 / ((t2 - t0) / 60.0);
+    free(ctx.runs);
+    free(ctx.samples);
+    free(ctx.cuts);
+    free(ctx.run_fds);
+    pthread_mutex_destroy(&ctx.lock);
+    return !ctx.failed;
+}
+
+/* ========================================================================
+ * COMMAND LINE
+ * ======================================================================== */
+
+#ifndef VOYAGE_MERGE_LIBRARY
+
+static void usage(void) {
+    fprintf(stderr,
+            "usage: voyage_merge [-j threads] [-m MB] [-p partitions] [-t tmp_dir] [-k]\n"
+            "                    -o out_dir (segment ... | -l list_file)\n"
+            "  Segments hold raw se3_pose_t records (56 bytes, little-endian).\n"
+            "  Writes out_dir/<mmsi>.pose per vessel, time ordered.\n"
+            "  -k keeps byte-identical duplicate records.\n");
+}
+
+/* One path per line */
+static char** read_list(const char* file, int* n_out) {
+    FILE* f = fopen(file, "r");
+    if (!f) return NULL;
+    char** list = NULL;
+    int n = 0, cap = 0;
+    char line[PATH_MAX];
+    while (fgets(line, sizeof(line), f)) {
+        size_t len = strcspn(line, "\r\n");
+        if (len == 0) continue;
+        line[len] = '\0';
+        if (n == cap) {
+            cap = cap ? cap * 2 : 256;
+            char** grown = realloc(list, (size_t)cap * sizeof(char*));
+            if (!grown) break;
+            list = grown;
+        }
+        list[n] = strdup(line);
+        if (list[n]) n++;
+    }
+    fclose(f);
+    *n_out = n;
+    return list;
+}
+
+int main(int argc, char** argv) {
+    voyage_merge_config_t cfg;
+    voyage_merge_default_config(&cfg, NULL);
+    const char* list_file = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "j:m:p:t:o:l:kh")) != -1) {
+        switch (opt) {
+        case 'j': cfg.threads = atoi(optarg); break;
+        case 'm': cfg.memory_bytes = (size_t)strtoull(optarg, NULL, 10) << 20; break;
+        case 'p': cfg.partitions = atoi(optarg); break;
+        case 't': cfg.tmp_dir = optarg; break;
+        case 'o': cfg.out_dir = optarg; break;
+        case 'l': list_file = optarg; break;
+        case 'k': cfg.keep_duplicates = true; break;
+        default: usage(); return 2;
+        }
+    }
+    if (!cfg.out_dir || (optind >= argc && !list_file)) {
+        usage();
+        return 2;
+    }
+
+    const char* const* segments = (const char* const*)&argv[optind];
+    int n_segments = argc - optind;
+    if (list_file) {
+        char** list = read_list(list_file, &n_segments);
+        if (!list) {
+            perror(list_file);
+            return 1;
+        }
+        segments = (const char* const*)list;
+    }
+
+    voyage_merge_stats_t st;
+    bool ok = voyage_merge(segments, n_segments, &cfg, &st);
+    if (!ok) {
+        fprintf(stderr, "voyage_merge: %s\n", st.error);
+        return 1;
+    }
+    printf("%d segments, %.2f GB, %llu records -> %u voyages (%llu records, %llu duplicates dropped)\n",
+           n_segments, st.bytes_in / 1e9, (unsigned long long)st.records_in, st.vessels,
+           (unsigned long long)st.records_out, (unsigned long long)st.duplicates);
+    printf("%u runs, %u extra merge passes, %u MMSI ranges, %d threads, %zu MB\n",
+           st.runs, st.merge_passes, st.partitions, cfg.threads, cfg.memory_bytes >> 20);
+    printf("run generation %.2f s, merge %.2f s: %.2f GB/min\n",
+           st.run_seconds, st.merge_seconds, st.gb_per_min);
+    if (st.truncated_bytes) {
+        printf("warning: %llu bytes of truncated records skipped\n",
+               (unsigned long long)st.truncated_bytes);
+    }
+    return 0;
+}
+
+#endif /* VOYAGE_MERGE_LIBRARY */
@@ -0,0 +1,126 @@
+/*
+ * voyage_merge.h - External K-Way Merge of Archived Segments into Voyages
+ *
+ * Archived segments hold raw se3_pose_t records (the 56-byte packed
+ * binary pose format) for one cell and one time window each, with many
+ * vessels interleaved. Voyage-level analysis needs each MMSI's fixes in
+ * time order across thousands of segments. voyage_merge() rebuilds them
+ * with bounded memory, in two phases:
+ *
+ *   1. Run generation: worker threads take segments from a shared queue,
+ *      fill a private buffer, sort it by (mmsi, timestamp) and spill it
+ *      as a sorted run file. MMSIs are sampled from every run.
+ *   2. Merge: the MMSI space is cut into ranges at sample quantiles; each
+ *      worker takes a range, binary-searches its slice of every run and
+ *      k-way merges the slices through a heap, writing one voyage file
+ *      <out_dir>/<mmsi>.pose per vessel (se3_pose_t, time order).
+ *
+ * Runs are never read whole: each merge cursor owns a fixed read buffer,
+ * so memory is memory_bytes regardless of archive size. If there are more
+ * runs than buffers fit, intermediate passes merge groups of runs first.
+ * Ties on (mmsi, timestamp) are ordered by record bytes, so output does
+ * not depend on thread scheduling; byte-identical records (the same fix
+ * archived by two cells around a handoff) are written once.
+ *
+ * Doom Lineage:
+ *   - Doom's WAD lump directory (W_AddFile: the IWAD and every PWAD
+ *     merged into one lump table) → thousands of segments merged into
+ *     one (mmsi, timestamp)-ordered stream
+ *
+ * Hardware Target: host (POSIX files, pthreads); archives offloaded from
+ *                  ESP32-S3 edge nodes
+ * Author: ClaudeCode (Doom→SE(3) λ-Estimation Service)
+ * Version: 1.0
+ */
+
+#ifndef VOYAGE_MERGE_H
+#define VOYAGE_MERGE_H
+
+#include "se3_edge.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================
+ * CONFIGURATION CONSTANTS
+ * ======================================================================== */
+
+#define VM_RECORD_SIZE        ((int)sizeof(se3_pose_t))
+
+#ifndef VM_READ_BUFFER_MIN
+#define VM_READ_BUFFER_MIN    (64 * 1024)    /* Smallest merge cursor buffer */
+#endif
+
+#ifndef VM_READ_BUFFER_MAX
+#define VM_READ_BUFFER_MAX    (1024 * 1024)  /* Larger buffers only add page faults */
+#endif
+
+#ifndef VM_WRITE_BUFFER
+#define VM_WRITE_BUFFER       (256 * 1024)   /* Per-worker output buffer */
+#endif
+
+#ifndef VM_MAX_FANIN
+#define VM_MAX_FANIN          512            /* Runs open at once (fd limit) */
+#endif
+
+#define VM_SAMPLES_PER_RUN    256            /* MMSI samples for range cuts */
+
+/* ========================================================================
+ * TYPES
+ * ======================================================================== */
+
+typedef struct {
+    const char* out_dir;      /* Voyage files (created if missing) */
+    const char* tmp_dir;      /* Sorted runs; NULL = out_dir */
+    size_t memory_bytes;      /* Total buffer budget, all workers */
+    int threads;              /* Workers for both phases */
+    int partitions;           /* MMSI ranges; 0 = 4 per thread */
+    bool keep_duplicates;     /* Keep byte-identical records */
+} voyage_merge_config_t;
+
+typedef struct {
+    uint64_t bytes_in;        /* Segment bytes read */
+    uint64_t records_in;
+    uint64_t records_out;
+    uint64_t duplicates;      /* Byte-identical records dropped */
+    uint64_t truncated_bytes; /* Segment tails shorter than a record */
+    uint32_t vessels;         /* Voyage files written */
+    uint32_t runs;            /* Sorted runs from phase 1 */
+    uint32_t merge_passes;    /* Intermediate passes (fan-in limited) */
+    uint32_t partitions;      /* MMSI ranges actually merged */
+    double run_seconds;       /* Phase 1 wall time */
+    double merge_seconds;     /* Phase 2 wall time (incl. passes) */
+    double gb_per_min;        /* bytes_in / total wall time */
+    char error[192];          /* First error, empty on success */
+} voyage_merge_stats_t;
+
+/* ========================================================================
+ * API FUNCTIONS
+ * ======================================================================== */
+
+/**
+ * Defaults: 256 MB, one thread per online CPU, tmp_dir = out_dir.
+ */
+void voyage_merge_default_config(voyage_merge_config_t* cfg, const char* out_dir);
+
+/**
+ * Merge segment files into per-vessel voyage files.
+ *
+ * @param segments Segment paths (raw se3_pose_t records)
+ * @param n_segments Number of segments
+ * @param cfg Configuration
+ * @param stats Output: counts, timings, throughput, error text
+ * @return true on success (run files are removed either way)
+ */
+bool voyage_merge(const char* const* segments, int n_segments,
+                  const voyage_merge_config_t* cfg, voyage_merge_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VOYAGE_MERGE_H */